@@ -0,0 +1,33 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Timing helper for the benchmarks: runs a body repeatedly and reports the
+ * best time per iteration, which is the least disturbed by other load.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+// Best of repeats runs of body, in seconds
+template <typename Body>
+double Best(int repeats, Body body) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) best = seconds;
+    }
+    return best;
+}
+
+inline void Report(const char* name, double seconds, double items, const char* unit) {
+    std::printf("%-40s %10.3f ms %12.1f %s/s\n", name, seconds * 1e3, items / seconds, unit);
+}
+
+} // namespace bench
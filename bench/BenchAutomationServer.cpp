@@ -0,0 +1,133 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Load generator for the automation server: keep-alive connections on
+ * their own threads send single-value queries, one at a time and then
+ * pipelined, and the requests per second and p99 latency are reported.
+ *
+ *   BenchAutomationServer [connections]
+ */
+
+#include "Bench.h"
+#include "HttpClient.h"
+
+#include "AutomationServer.h"
+#include "MemoryBackend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int KEY_COUNT = 1000;
+constexpr int REQUESTS_PER_CONNECTION = 4800;    // A multiple of the pipeline depth
+
+struct Result {
+    double seconds = 0;
+    std::vector<double> latencies;      // Per request, or per pipelined round
+    bool ok = true;
+};
+
+// Every connection sends its requests in rounds of depth, waiting for each
+// round's responses before the next
+Result Run(core::AutomationServer& server, unsigned connections, int depth) {
+    std::string host = "127.0.0.1:" + std::to_string(server.Port());
+    std::string token = server.Token();
+    std::vector<Result> results(connections);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (unsigned c = 0; c < connections; c++) {
+        threads.emplace_back([&, c] {
+            Result& result = results[c];
+            test::HttpClient client;
+            if (!client.Connect(server.Port())) {
+                result.ok = false;
+                return;
+            }
+            result.latencies.reserve(REQUESTS_PER_CONNECTION / depth);
+            while (!go.load()) std::this_thread::yield();
+            test::HttpResponse response;
+            std::string round;
+            for (int sent = 0; sent < REQUESTS_PER_CONNECTION && result.ok; sent += depth) {
+                round.clear();
+                for (int i = 0; i < depth; i++) {
+                    int key = (sent + i) * 7919 % KEY_COUNT;
+                    round += test::HttpRequest("GET", "/v1/query?path=Key" + std::to_string(key) + "&name=Value1", host,
+                                               token);
+                }
+                auto start = std::chrono::steady_clock::now();
+                result.ok = client.Send(round);
+                for (int i = 0; i < depth && result.ok; i++) {
+                    result.ok = client.Receive(response) && response.status == 200 &&
+                                response.body.find("\"error\"") == std::string::npos;
+                }
+                result.latencies.push_back(
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (std::thread& thread : threads) thread.join();
+
+    Result total;
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (Result& result : results) {
+        total.ok = total.ok && result.ok;
+        total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+    std::sort(total.latencies.begin(), total.latencies.end());
+    return total;
+}
+
+bool Report(const char* name, const Result& result, unsigned connections, const char* per) {
+    if (!result.ok || result.latencies.empty()) {
+        std::printf("%s: requests failed\n", name);
+        return false;
+    }
+    const std::vector<double>& latencies = result.latencies;
+    bench::Report(name, result.seconds, double(connections) * REQUESTS_PER_CONNECTION, "req");
+    std::printf("  per %s: p50 %.1f us, p99 %.1f us, max %.1f us\n", per, latencies[latencies.size() / 2] * 1e6,
+                latencies[latencies.size() * 99 / 100] * 1e6, latencies.back() * 1e6);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned connections = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 4;
+    if (connections == 0) connections = 1;
+
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    for (int i = 0; i < KEY_COUNT; i++) {
+        core::KeyPtr key = root->CreateSubKey(L"Key" + std::to_wstring(i));
+        if (!key) return 1;
+        for (int v = 0; v < 8; v++) {
+            key->SetValue({ L"Value" + std::to_wstring(v), core::VALUE_SZ,
+                            core::EncodeString(L"Data " + std::to_wstring(i * 8 + v)) });
+        }
+    }
+
+    core::AutomationServer server(backend);
+    if (!server.Start()) {
+        std::printf("Cannot start the server\n");
+        return 1;
+    }
+    std::printf("%u connections, %d requests each\n", connections, REQUESTS_PER_CONNECTION);
+    bool ok = Report("Query, one at a time", Run(server, connections, 1), connections, "request");
+    ok = Report("Query, pipelined 16 deep", Run(server, connections, 16), connections, "round of 16") && ok;
+
+    core::AutomationServerStats stats = server.GetStats();
+    std::printf("Server: %llu connections, %llu requests, %.1f MB sent\n",
+                static_cast<unsigned long long>(stats.connections), static_cast<unsigned long long>(stats.requests),
+                stats.bytesSent / 1e6);
+    server.Stop();
+    return !ok;
+}
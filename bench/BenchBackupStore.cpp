@@ -0,0 +1,89 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Thirty incremental backups of a synthetic tree, each after a handful of
+ * small edits, as a day of scheduled backups would see it. Reports the time
+ * per backup and how well the store deduplicates.
+ */
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "BackupStore.h"
+#include "MemoryBackend.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+constexpr int BACKUP_COUNT = 30;
+constexpr int EDITS_PER_BACKUP = 20;
+
+} // namespace
+
+int main() {
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 8, 5, 6) + 1;
+    std::printf("%llu keys\n", static_cast<unsigned long long>(keys));
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "RegStudioBenchBackupStore";
+    std::filesystem::remove_all(directory);
+    core::BackupStore store;
+    if (!store.Open(directory)) return 1;
+
+    core::BackupSource source{ L"HKEY_CURRENT_USER", root.get() };
+    core::BackupOptions options;
+    core::BackupInfo info;
+    core::BackupStats stats;
+    options.created = 1;
+    auto start = std::chrono::steady_clock::now();
+    if (!store.CreateBackup({ &source, 1 }, options, info, stats)) return 1;
+    bench::Report("Full backup", stats.seconds, double(stats.keys), "keys");
+
+    // Edits spread over the tree: a changed DWORD, a grown string
+    uint32_t serial = 1;
+    double total = 0;
+    double slowest = 0;
+    uint64_t logical = stats.logicalBytes;
+    uint64_t written = stats.writtenBytes;
+    bool reused = true;
+    for (int backup = 1; backup <= BACKUP_COUNT; backup++) {
+        for (int edit = 0; edit < EDITS_PER_BACKUP; edit++) {
+            serial = serial * 1103515245u + 12345u;
+            std::wstring path = L"Key" + std::to_wstring(serial % 8) + L"\\Key" + std::to_wstring((serial >> 8) % 8) +
+                                L"\\Key" + std::to_wstring((serial >> 16) % 8);
+            core::KeyPtr key = root->OpenSubKey(path);
+            if (!key) return 1;
+            key->SetValue({ L"Counter", core::VALUE_DWORD,
+                            { uint8_t(serial), uint8_t(backup), 0, 0 } });
+            key->SetValue({ L"Value0", core::VALUE_SZ, core::EncodeString(L"Edited " + std::to_wstring(serial)) });
+        }
+        options.created = backup + 1;
+        if (!store.CreateBackup({ &source, 1 }, options, info, stats)) return 1;
+        total += stats.seconds;
+        if (stats.seconds > slowest) slowest = stats.seconds;
+        logical += stats.logicalBytes;
+        written += stats.writtenBytes;
+        reused = reused && stats.reusedKeys + EDITS_PER_BACKUP >= stats.keys;
+        if (backup % 10 == 0) {
+            std::printf("backup %2d: %.3f ms, %llu new objects, DedupeRatio %.1f\n", backup, stats.seconds * 1e3,
+                        static_cast<unsigned long long>(stats.newObjects), stats.DedupeRatio());
+        }
+    }
+    bench::Report("Incremental backup (mean)", total / BACKUP_COUNT, double(keys), "keys");
+    std::printf("Slowest incremental backup %.3f ms\n", slowest * 1e3);
+    std::printf("DedupeRatio over all %d backups %.1f\n", BACKUP_COUNT + 1,
+                written ? double(logical) / written : 0.0);
+
+    core::StoreStats storeStats = store.GetStats();
+    std::printf("Store: %u backups, %llu objects, %.1f MB in %u packs, %.1f s in total\n", storeStats.backups,
+                static_cast<unsigned long long>(storeStats.objects), storeStats.bytes / 1e6, storeStats.packs,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    store.Close();
+    std::filesystem::remove_all(directory);
+    return !reused;
+}
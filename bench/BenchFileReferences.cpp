@@ -0,0 +1,73 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * File reference scan over a synthetic services and classes tree checked
+ * against a MemoryFileSystem, so the figure is the engine's, not the disk's.
+ */
+
+#include "Bench.h"
+
+#include "FileReferences.h"
+#include "MemoryBackend.h"
+
+#include <string>
+
+namespace {
+
+constexpr int KEY_COUNT = 100000;
+
+core::RegValue Text(const wchar_t* name, uint32_t type, const std::wstring& text) {
+    return { name, type, core::EncodeString(text) };
+}
+
+} // namespace
+
+int main() {
+    core::MemoryFileSystem fileSystem;
+    fileSystem.SetEnvironment(L"SystemRoot", L"C:\\Windows");
+    fileSystem.SetEnvironment(L"ProgramFiles", L"C:\\Program Files");
+
+    // Three references per key over 100 directories; one file in four is missing
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    for (int i = 0; i < KEY_COUNT; i++) {
+        std::wstring n = std::to_wstring(i);
+        std::wstring directory = std::to_wstring(i % 100);
+        if (i % 4) {
+            fileSystem.AddPath(L"C:\\Windows\\System32\\drivers\\d" + directory + L"\\drv" + n + L".sys");
+            fileSystem.AddPath(L"C:\\Program Files\\App" + directory + L"\\app" + n + L".exe");
+        }
+        fileSystem.AddPath(L"C:\\Windows\\System32\\res" + directory + L".dll");
+
+        core::KeyPtr key = root->CreateSubKey(L"Key" + std::to_wstring(i / 1000) + L"\\Item" + n);
+        if (!key) continue;
+        key->SetValue(Text(L"ImagePath", core::VALUE_EXPAND_SZ,
+                           L"\\SystemRoot\\System32\\drivers\\d" + directory + L"\\drv" + n + L".sys"));
+        key->SetValue(Text(L"Description", core::VALUE_SZ,
+                           L"@%SystemRoot%\\system32\\res" + directory + L".dll,-" + n));
+        key->SetValue(Text(L"", core::VALUE_SZ,
+                           L"\"%ProgramFiles%\\App" + directory + L"\\app" + n + L".exe\" /run \"%1\""));
+    }
+
+    core::FileReferenceFinder finder(fileSystem);
+    core::FileReferenceReport report;
+    double seconds = bench::Best(3, [&] {
+        finder.ClearCache();
+        finder.Scan(*root, report);
+    });
+    const core::FileReferenceStats& stats = report.stats;
+    std::printf("%llu keys, %llu references, %llu unique paths, %llu missing, %llu directories\n",
+                static_cast<unsigned long long>(stats.keys), static_cast<unsigned long long>(stats.references),
+                static_cast<unsigned long long>(stats.uniquePaths), static_cast<unsigned long long>(stats.missingReferences),
+                static_cast<unsigned long long>(stats.directories));
+    bench::Report("Scan", seconds, double(stats.references), "refs");
+    std::printf("ReferencesPerSecond %.0f (walk %.1f ms, check %.1f ms)\n",
+                stats.ReferencesPerSecond(), stats.walkSeconds * 1e3, stats.checkSeconds * 1e3);
+
+    // Again with the listings cached
+    double cached = bench::Best(3, [&] { finder.Scan(*root, report); });
+    bench::Report("Scan, directories cached", cached, double(report.stats.references), "refs");
+    std::printf("ReferencesPerSecond %.0f\n", report.stats.ReferencesPerSecond());
+    return stats.missingReferences != KEY_COUNT / 4 * 2;
+}
@@ -0,0 +1,57 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * HexDocument edits, undo and visible-page formatting on a 16 MB value.
+ */
+
+#include "Bench.h"
+
+#include "HexDocument.h"
+
+#include <random>
+#include <string>
+
+using namespace core;
+
+int main() {
+    std::vector<uint8_t> data(16u << 20);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 131);
+    constexpr int EDITS = 100000;
+
+    HexDocument document;
+    std::mt19937 random(1);
+    double seconds = bench::Best(3, [&] {
+        document.Reset(data);
+        for (int i = 0; i < EDITS; i++) {
+            uint8_t byte = static_cast<uint8_t>(random());
+            size_t pos = random() % document.Size();
+            if (i % 3 == 0) document.Insert(pos, { &byte, 1 });
+            else if (i % 3 == 1) document.Overwrite(pos, { &byte, 1 });
+            else document.Erase(pos, 1);
+        }
+    });
+    bench::Report("Random edits", seconds, EDITS, "edits");
+
+    seconds = bench::Best(1, [&] { while (document.Undo()) {} });
+    bench::Report("Undo all", seconds, EDITS, "steps");
+    while (document.Redo()) {}
+
+    std::string rows;
+    size_t total = 0;
+    seconds = bench::Best(3, [&] {
+        for (int i = 0; i < EDITS; i++) {
+            rows.clear();
+            document.FormatRows(random() % (document.Size() / 16), 64, {}, rows);
+            total += rows.size();
+        }
+    });
+    bench::Report("Visible page (64 rows) after edits", seconds, EDITS, "pages");
+
+    seconds = bench::Best(3, [&] {
+        rows.clear();
+        FormatHexRows(data.data(), data.size(), 0, {}, rows);
+    });
+    bench::Report("Format 16 MB", seconds, data.size() / 1e6, "MB");
+    return total == 0;
+}
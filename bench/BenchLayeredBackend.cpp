@@ -0,0 +1,99 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Cost of looking through the sandbox layers: every key of a synthetic
+ * tree is opened by full path and one value read, on the base backend
+ * itself and then through a growing stack of layers with scattered edits.
+ */
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "LayeredBackend.h"
+#include "MemoryBackend.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+void CollectPaths(const core::RegistryKey& key, const std::wstring& path, std::vector<std::wstring>& paths) {
+    std::vector<std::wstring> names;
+    key.GetSubKeyNames(names);
+    for (const std::wstring& name : names) {
+        std::wstring child = path.empty() ? name : path + L"\\" + name;
+        paths.push_back(child);
+        core::KeyPtr sub = key.OpenSubKey(name);
+        if (sub) CollectPaths(*sub, child, paths);
+    }
+}
+
+// Open each path from the root and read one value; returns how many were found
+size_t Lookups(core::RegistryBackend& backend, const std::vector<std::wstring>& paths) {
+    core::KeyPtr root = backend.OpenRoot();
+    core::RegValue value;
+    size_t found = 0;
+    for (const std::wstring& path : paths) {
+        core::KeyPtr key = root->OpenSubKey(path);
+        if (key && key->GetValue(L"Value1", value)) found++;
+    }
+    return found;
+}
+
+// Every key and value, as a tree view or an export would read them
+size_t Walk(const core::RegistryKey& key) {
+    std::vector<std::wstring> names;
+    std::vector<core::RegValue> values;
+    key.GetSubKeyNames(names);
+    key.GetValues(values);
+    size_t count = values.size();
+    for (const std::wstring& name : names) {
+        core::KeyPtr sub = key.OpenSubKey(name);
+        if (sub) count += 1 + Walk(*sub);
+    }
+    return count;
+}
+
+// Set a value in one key in hundred, spread over the tree
+void EditLayer(core::RegistryBackend& backend, const std::vector<std::wstring>& paths, uint32_t layer) {
+    core::KeyPtr root = backend.OpenRoot();
+    for (size_t i = layer; i < paths.size(); i += 100) {
+        core::KeyPtr key = root->OpenSubKey(paths[i]);
+        if (key) key->SetValue({ L"Value1", core::VALUE_DWORD, { uint8_t(layer), 0, 0, 0 } });
+    }
+}
+
+} // namespace
+
+int main() {
+    core::MemoryBackend base;
+    test::FillTree(*base.OpenRoot(), 10, 4, 4);
+    std::vector<std::wstring> paths;
+    CollectPaths(*base.OpenRoot(), L"", paths);
+    std::printf("%zu keys\n", paths.size());
+
+    size_t found = 0;
+    double baseLookup = bench::Best(5, [&] { found = Lookups(base, paths); });
+    size_t items = 0;
+    double baseWalk = bench::Best(5, [&] { items = Walk(*base.OpenRoot()); });
+    bench::Report("Base: open by path + GetValue", baseLookup, double(paths.size()), "keys");
+    bench::Report("Base: walk", baseWalk, double(items), "items");
+    bool ok = found == paths.size();
+
+    core::LayeredBackend layered(base);
+    for (uint32_t layers = 1; layers <= 4; layers++) {
+        layered.PushLayer();
+        EditLayer(layered, paths, layers);
+
+        double lookup = bench::Best(5, [&] { found = Lookups(layered, paths); });
+        size_t walked = 0;
+        double walk = bench::Best(5, [&] { walked = Walk(*layered.OpenRoot()); });
+        std::string name = std::to_string(layers) + (layers == 1 ? " layer" : " layers");
+        bench::Report((name + ": open by path + GetValue").c_str(), lookup, double(paths.size()), "keys");
+        bench::Report((name + ": walk").c_str(), walk, double(walked), "items");
+        std::printf("  overhead over the base: lookup %.2fx, walk %.2fx\n", lookup / baseLookup, walk / baseWalk);
+        ok = ok && found == paths.size() && walked == items;
+    }
+    return !ok;
+}
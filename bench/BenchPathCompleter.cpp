@@ -0,0 +1,89 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Address bar completion in a key with 300,000 subkeys: the background read
+ * of the key, then the cost of each keystroke on the calling (UI) thread.
+ */
+
+#include "Bench.h"
+
+#include "MemoryBackend.h"
+#include "PathCompleter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cwchar>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int CHILD_COUNT = 300000;
+constexpr double KEYSTROKE_BUDGET = 1e-3;
+
+double Since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    core::KeyPtr wide = root->CreateSubKey(L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Wide");
+    wchar_t name[32];
+    for (int i = 0; wide && i < CHILD_COUNT; i++) {
+        std::swprintf(name, 32, L"Item%06d", (i * 7919) % CHILD_COUNT);
+        wide->CreateSubKey(name);
+    }
+    root->CreateSubKey(L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Other\\Child");
+    std::printf("%d subkeys\n", CHILD_COUNT);
+
+    core::PathCompleter completer(backend);
+    core::PathCompletion completion;
+    auto start = std::chrono::steady_clock::now();
+    double firstCall = 0;
+    while (!completer.Complete(L"HKLM\\SOFTWARE\\Wide\\Item", 1, completion)) {
+        if (firstCall == 0) firstCall = Since(start);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    bench::Report("Background read of the key", Since(start), CHILD_COUNT, "names");
+    bench::Report("First keystroke (cache miss)", firstCall, 1, "keystrokes");
+
+    // Type a name one character at a time, then erase it again
+    const std::wstring typed = L"HKLM\\SOFTWARE\\Wide\\Item123456";
+    const size_t parentLength = std::wstring_view(L"HKLM\\SOFTWARE\\Wide\\").size();
+    std::vector<double> strokes;
+    double seconds = bench::Best(5, [&] {
+        for (int round = 0; round < 100; round++) {
+            for (size_t length = parentLength + 1; length <= typed.size(); length++) {
+                auto stroke = std::chrono::steady_clock::now();
+                completer.Complete(std::wstring_view(typed).substr(0, length), 1, completion);
+                strokes.push_back(Since(stroke));
+            }
+        }
+    });
+    size_t perRun = 100 * (typed.size() - parentLength);
+    bench::Report("Keystroke in a cached key", seconds / perRun, 1, "keystrokes");
+
+    // Alternate with another key: each switch only queues a last-write check
+    while (!completer.Complete(L"HKLM\\SOFTWARE\\Other\\C", 1, completion)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double switching = bench::Best(5, [&] {
+        for (int round = 0; round < 100; round++) {
+            completer.Complete(L"HKLM\\SOFTWARE\\Other\\C", 1, completion);
+            completer.Complete(L"HKLM\\SOFTWARE\\Wide\\Item1", 1, completion);
+        }
+    });
+    bench::Report("Keystroke switching keys", switching / 200, 1, "keystrokes");
+
+    // The slowest few are scheduler noise on a loaded machine; p99 is judged
+    std::sort(strokes.begin(), strokes.end());
+    double p99 = strokes[strokes.size() * 99 / 100];
+    std::printf("Keystroke p99 %.4f ms, slowest %.4f ms over %zu (budget %.1f ms)\n",
+                p99 * 1e3, strokes.back() * 1e3, strokes.size(), KEYSTROKE_BUDGET * 1e3);
+    return p99 > KEYSTROKE_BUDGET;
+}
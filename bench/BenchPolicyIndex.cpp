@@ -0,0 +1,100 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Group Policy indexing over a generated SYSVOL-like corpus: 5000 GPOs,
+ * each with a Machine and a User Registry.pol of a few dozen settings
+ * under shared policy keys, so later GPOs override earlier ones.
+ *
+ *   BenchPolicyIndex [threads]
+ */
+
+#include "Bench.h"
+#include "PolicyFixtures.h"
+
+#include "PolicyIndex.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t GPO_COUNT = 5000;
+
+// Settings spread over 50 products so about a third of the values are set by more than one GPO
+uint64_t WriteCorpus(const fs::path& root) {
+    uint64_t bytes = 0;
+    uint32_t serial = 1;
+    for (uint32_t gpo = 0; gpo < GPO_COUNT; gpo++) {
+        fs::path directory = root / ("{GPO" + std::to_string(gpo) + "}");
+        for (const char* scope : { "Machine", "User" }) {
+            test::PolicyFileWriter writer;
+            uint32_t entries = 20 + gpo % 30;
+            for (uint32_t i = 0; i < entries; i++) {
+                serial = serial * 1103515245u + 12345u;
+                std::wstring key = L"Software\\Policies\\Vendor" + std::to_wstring((serial >> 8) % 5) + L"\\Product" +
+                                   std::to_wstring((serial >> 12) % 50);
+                std::wstring name = L"Setting" + std::to_wstring((serial >> 18) % 16);
+                switch ((serial >> 24) % 8) {
+                case 0:
+                    writer.Text(key, L"**del." + name, L" ");
+                    break;
+                case 1:
+                    writer.Text(key, name, L"C:\\Program Files\\Vendor\\Product");
+                    break;
+                case 2:
+                    writer.Dword(key, L"**soft." + name, serial & 0xFF);
+                    break;
+                default:
+                    writer.Dword(key, name, (serial >> 4) & 3);
+                    break;
+                }
+            }
+            writer.Save(directory / scope / "Registry.pol");
+            bytes += writer.Size();
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+    fs::path root = fs::temp_directory_path() / "RegStudioBenchPolicies";
+    fs::remove_all(root);
+    uint64_t bytes = WriteCorpus(root);
+
+    std::vector<fs::path> files;
+    double find = bench::Best(3, [&] {
+        files.clear();
+        core::FindPolicyFiles(root, files);
+    });
+    bench::Report("FindPolicyFiles", find, double(files.size()), "files");
+
+    core::PolicyIndexOptions options;
+    options.threadCount = threads;
+    core::PolicyIndex index;
+    core::PolicyIndexStats stats;
+    std::wstring error;
+    bool ok = files.size() == 2 * GPO_COUNT;
+    double build = bench::Best(3, [&] {
+        std::vector<core::PolicySource> sources;
+        sources.reserve(files.size());
+        for (const fs::path& file : files) sources.push_back({ file });
+        ok = core::PolicyIndex::Build(std::move(sources), options, index, stats, error) && ok;
+    });
+    bench::Report("PolicyIndex::Build", build, double(stats.files), "files");
+    bench::Report("PolicyIndex::Build", build, stats.bytes / 1e6, "MB");
+    std::printf("  %llu entries, %zu keys, %zu values, %zu conflicts\n",
+                static_cast<unsigned long long>(stats.entries), index.Keys().size(), index.Values().size(),
+                index.Conflicts().size());
+
+    ok = ok && stats.bytes == bytes && stats.failedFiles == 0 && !index.Conflicts().empty();
+    fs::remove_all(root);
+    return !ok;
+}
@@ -0,0 +1,33 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Throughput of comparing an in-memory tree against its own .reg export.
+ */
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "MemoryBackend.h"
+#include "RegFileCompare.h"
+
+#include <sstream>
+
+int main() {
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 40, 3, 6) + 1;
+    std::string file = test::ExportRegFile(*root, L"HKEY_LOCAL_MACHINE\\SOFTWARE");
+    std::printf("%llu keys, %.1f MB of .reg text\n", static_cast<unsigned long long>(keys), file.size() / 1e6);
+
+    core::RegCompareOptions options;
+    options.rootPrefix = L"HKEY_LOCAL_MACHINE\\SOFTWARE";
+    uint64_t differences = 0;
+    double seconds = bench::Best(3, [&] {
+        std::istringstream input(file);
+        differences += core::CompareWithRegFile(input, backend, nullptr, options).differences;
+    });
+    bench::Report("CompareWithRegFile", seconds, file.size() / 1e6, "MB");
+    bench::Report("CompareWithRegFile keys", seconds, double(keys), "keys");
+    return differences != 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Process Monitor trace ingestion over a generated install trace, written
+ * once as CSV and once as XML: a few processes, mostly reads over a few
+ * thousand keys, one row in ten a file event that is skipped.
+ *
+ *   BenchRegistryTrace [threads]
+ */
+
+#include "Bench.h"
+#include "TraceFixtures.h"
+
+#include "RegistryTrace.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t EVENT_COUNT = 300000;
+
+std::vector<test::TraceEvent> InstallTrace() {
+    const char* processes[] = { "msiexec.exe", "setup.exe", "explorer.exe", "svchost.exe" };
+    const char* roots[] = { "HKLM\\SOFTWARE\\", "\\REGISTRY\\MACHINE\\SOFTWARE\\", "HKCU\\Software\\",
+                            "HKLM\\SOFTWARE\\Classes\\" };
+    std::vector<test::TraceEvent> events;
+    events.reserve(EVENT_COUNT);
+    uint32_t serial = 1;
+    for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+        serial = serial * 1103515245u + 12345u;
+        test::TraceEvent event;
+        event.process = processes[(i / 64) % 4];
+        event.pid = 1000 + 4 * ((i / 64) % 4);
+        std::string key = std::string(roots[serial % 4]) + "Vendor" + std::to_string((serial >> 8) % 20) + "\\Product" +
+                          std::to_string((serial >> 13) % 200) + "\\Setting";
+        switch ((serial >> 20) % 10) {
+        case 0:
+            event.operation = "CreateFile";
+            event.path = "C:\\Program Files\\Vendor\\file" + std::to_string(serial % 1000) + ".dll";
+            event.detail = "Desired Access: Generic Read, Disposition: Open";
+            break;
+        case 1:
+            event.operation = "RegSetValue";
+            event.path = key + "\\Value" + std::to_string((serial >> 4) % 8);
+            event.detail = "Type: REG_SZ, Length: 42, Data: C:\\Program Files\\Vendor";
+            break;
+        case 2:
+            event.operation = "RegCreateKey";
+            event.path = key;
+            event.detail = "Desired Access: All Access, Disposition: REG_CREATED_NEW_KEY";
+            break;
+        case 3:
+        case 4:
+            event.operation = "RegQueryValue";
+            event.path = key + "\\Value" + std::to_string((serial >> 4) % 8);
+            event.result = serial % 3 ? "SUCCESS" : "NAME NOT FOUND";
+            event.detail = "Length: 144";
+            break;
+        case 5:
+            event.operation = "RegCloseKey";
+            event.path = key;
+            break;
+        default:
+            event.operation = "RegOpenKey";
+            event.path = key;
+            event.detail = "Desired Access: Read";
+            break;
+        }
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+bool Run(const char* name, const std::filesystem::path& path, unsigned threads, uint64_t& registryEvents) {
+    core::TraceOptions options;
+    options.threadCount = threads;
+    core::TraceProfile profile;
+    core::TraceStats stats;
+    std::wstring error;
+    bool ok = true;
+    double seconds = bench::Best(3, [&] { ok = ok && core::LoadRegistryTrace(path, options, profile, stats, error); });
+    if (!ok) return false;
+    bench::Report(name, seconds, stats.bytes / 1e6, "MB");
+    std::printf("  %llu events, %llu counted, %zu nodes, %u chunks, MegabytesPerSecond %.1f\n",
+                static_cast<unsigned long long>(stats.events), static_cast<unsigned long long>(stats.registryEvents),
+                profile.nodes.size(), stats.chunks, stats.MegabytesPerSecond());
+    if (registryEvents && registryEvents != stats.registryEvents) return false;
+    registryEvents = stats.registryEvents;
+    return stats.events == EVENT_COUNT && stats.malformedEvents == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+    std::vector<test::TraceEvent> events = InstallTrace();
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::filesystem::path csv = directory / "RegStudioBenchTrace.csv";
+    std::filesystem::path xml = directory / "RegStudioBenchTrace.xml";
+    std::ofstream(csv, std::ios::binary | std::ios::trunc) << test::CsvTrace(events);
+    std::ofstream(xml, std::ios::binary | std::ios::trunc) << test::XmlTrace(events);
+
+    uint64_t registryEvents = 0;
+    bool ok = Run("Procmon CSV", csv, threads, registryEvents);
+    ok = Run("Procmon XML", xml, threads, registryEvents) && ok;
+    std::filesystem::remove(csv);
+    std::filesystem::remove(xml);
+    return !ok;
+}
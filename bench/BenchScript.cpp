@@ -0,0 +1,84 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Script VM over a generated in-memory tree, against the same update
+ * written directly in C++.
+ */
+
+#include "Bench.h"
+
+#include "MemoryBackend.h"
+#include "RegistryTypes.h"
+#include "Script.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+using namespace core;
+
+namespace {
+
+constexpr int KEYS = 100000;
+
+void BuildTree(MemoryBackend& backend) {
+    KeyPtr software = backend.OpenRoot()->CreateSubKey(L"SOFTWARE");
+    for (int i = 0; i < KEYS; i++) {
+        KeyPtr key = software->CreateSubKey(L"Vendor" + std::to_wstring(i % 37) + L"\\Product" +
+                                            std::to_wstring(i % 211) + L"\\Sub" + std::to_wstring(i));
+        uint32_t count = (i * 7919) % 200;
+        key->SetValue(RegValue{ L"Path", VALUE_SZ, EncodeString(L"C:\\Program Files\\Vendor\\App\\bin\\app.exe") });
+        key->SetValue(RegValue{ L"Count", VALUE_DWORD, { static_cast<uint8_t>(count), 0, 0, 0 } });
+    }
+}
+
+} // namespace
+
+int main() {
+    Script script;
+    if (!script.Compile(LR"(
+for key k in open('SOFTWARE') recursive {
+    let v = getvalue(k, "Count")
+    if v != null and v.type == REG_DWORD and v.data > 100 {
+        setdword(k, "Count", v.data + 1)
+    }
+}
+)")) {
+        std::printf("compile error: %ls\n", script.Error().c_str());
+        return 1;
+    }
+
+    double scriptSeconds = 1e30;
+    double nativeSeconds = 1e30;
+    for (int repeat = 0; repeat < 3; repeat++) {
+        MemoryBackend scripted;
+        BuildTree(scripted);
+        ScriptStats stats;
+        script.Run(scripted, stats);
+        if (stats.seconds < scriptSeconds) scriptSeconds = stats.seconds;
+
+        MemoryBackend native;
+        BuildTree(native);
+        KeyPtr software = native.OpenKey(L"SOFTWARE");
+        std::function<void(RegistryKey&)> walk = [&walk](RegistryKey& key) {
+            std::vector<std::wstring> names;
+            key.GetSubKeyNames(names);
+            for (const std::wstring& name : names) {
+                KeyPtr child = key.OpenSubKey(name);
+                if (!child) continue;
+                RegValue value;
+                if (child->GetValue(L"Count", value) && value.type == VALUE_DWORD && value.data.size() == 4 &&
+                    value.data[0] > 100) {
+                    value.data[0]++;
+                    child->SetValue(value);
+                }
+                walk(*child);
+            }
+        };
+        nativeSeconds = std::min(nativeSeconds, bench::Best(1, [&] { walk(*software); }));
+    }
+    bench::Report("Script recursive update", scriptSeconds, KEYS, "keys");
+    bench::Report("Same update in C++", nativeSeconds, KEYS, "keys");
+    return 0;
+}
@@ -0,0 +1,30 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Sha256 throughput on large buffers and on value-sized objects.
+ */
+
+#include "Bench.h"
+
+#include "Sha256.h"
+
+#include <vector>
+
+int main() {
+    std::vector<uint8_t> data(64u << 20);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<uint8_t>(i * 131);
+
+    uint8_t sink = 0;
+    double seconds = bench::Best(5, [&] { sink ^= core::Sha256::Hash(data.data(), data.size())[0]; });
+    bench::Report("Sha256 64 MB", seconds, data.size() / 1e6, "MB");
+
+    // Backup objects are mostly small
+    seconds = bench::Best(5, [&] {
+        for (size_t offset = 0; offset + 64 <= data.size(); offset += 64) {
+            sink ^= core::Sha256::Hash(data.data() + offset, 64)[0];
+        }
+    });
+    bench::Report("Sha256 64-byte objects", seconds, data.size() / 64.0, "hashes");
+    return sink == 0xFFFF;
+}
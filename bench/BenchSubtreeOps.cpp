@@ -0,0 +1,59 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Subtree copy and delete of about a million in-memory keys at 1..N threads.
+ * Usage: BenchSubtreeOps [max threads], default one per hardware thread.
+ */
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "MemoryBackend.h"
+#include "SubtreeOps.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+
+double Since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    core::MemoryBackend source;
+    core::KeyPtr sourceRoot = source.OpenRoot();
+    uint64_t keys = test::FillTree(*sourceRoot, 100, 3, 2) + 1;
+    std::printf("%llu keys, 2 values each\n", static_cast<unsigned long long>(keys));
+
+    unsigned maxThreads = argc > 1 ? unsigned(std::stoul(argv[1])) : std::thread::hardware_concurrency();
+    for (unsigned threads = 1; threads <= std::max(maxThreads, 1u); threads *= 2) {
+        double copyBest = 1e30;
+        double deleteBest = 1e30;
+        for (int repeat = 0; repeat < 3; repeat++) {
+            core::MemoryBackend destination;
+            core::KeyPtr destinationRoot = destination.OpenRoot();
+            core::KeyPtr target = destinationRoot->CreateSubKey(L"Copy");
+            core::SubtreeOptions options;
+            options.threadCount = threads;
+
+            auto start = std::chrono::steady_clock::now();
+            core::CopySubtree(*sourceRoot, *target, options);
+            copyBest = std::min(copyBest, Since(start));
+            target.reset();
+
+            start = std::chrono::steady_clock::now();
+            core::DeleteSubtree(*destinationRoot, L"Copy", options);
+            deleteBest = std::min(deleteBest, Since(start));
+        }
+        std::string suffix = " (" + std::to_string(threads) + " threads)";
+        bench::Report(("CopySubtree" + suffix).c_str(), copyBest, double(keys), "keys");
+        bench::Report(("DeleteSubtree" + suffix).c_str(), deleteBest, double(keys), "keys");
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * XML and JSON export of about 170,000 in-memory keys at 1..N threads.
+ * Usage: BenchTreeExport [max threads], default one per hardware thread.
+ */
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "MemoryBackend.h"
+#include "TreeExport.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+
+int main(int argc, char** argv) {
+    core::MemoryBackend backend;
+    core::KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 20, 4, 4) + 1;
+    std::printf("%llu keys, 4 values each\n", static_cast<unsigned long long>(keys));
+
+    unsigned maxThreads = argc > 1 ? unsigned(std::stoul(argv[1])) : std::thread::hardware_concurrency();
+    bool identical = true;
+    for (core::TreeExportFormat format : { core::TreeExportFormat::Xml, core::TreeExportFormat::Json }) {
+        const char* formatName = format == core::TreeExportFormat::Xml ? "XML" : "JSON";
+        std::string reference;
+        for (unsigned threads = 1; threads <= std::max(maxThreads, 1u); threads *= 2) {
+            core::TreeExportOptions options;
+            options.format = format;
+            options.threadCount = threads;
+            core::TreeExportStats stats;
+            std::string output;
+            double seconds = bench::Best(3, [&] {
+                std::ostringstream stream;
+                std::wstring error;
+                core::ExportTree(*root, L"HKEY_LOCAL_MACHINE\\SOFTWARE", stream, options, stats, error);
+                output = std::move(stream).str();
+            });
+            if (reference.empty()) reference = output;
+            identical = identical && output == reference;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "%s, %u thread%s", formatName, threads, threads == 1 ? "" : "s");
+            bench::Report(name, seconds, output.size() / 1e6, "MB");
+        }
+    }
+    std::printf("Output %s across thread counts\n", identical ? "identical" : "DIFFERS");
+    return !identical;
+}
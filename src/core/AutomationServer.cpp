@@ -0,0 +1,1967 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Automation server: socket event loop, HTTP/1.1 framing, worker pool and
+ * the NDJSON operations.
+ */
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <bcrypt.h>
+#include <sddl.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+#include "AutomationServer.h"
+#include "RegistryTypes.h"
+#include "SubtreeOps.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+namespace {
+
+#ifdef _WIN32
+using Socket = SOCKET;
+constexpr Socket NO_SOCKET = INVALID_SOCKET;
+constexpr int SEND_FLAGS = 0;
+
+void CloseSocket(Socket socket) { closesocket(socket); }
+bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+bool SetNonBlocking(Socket socket) {
+    u_long on = 1;
+    return ioctlsocket(socket, FIONBIO, &on) == 0;
+}
+#else
+using Socket = int;
+constexpr Socket NO_SOCKET = -1;
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;    // A closed peer is an error, not a signal
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+void CloseSocket(Socket socket) { close(socket); }
+bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+bool SetNonBlocking(Socket socket) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+constexpr uint64_t LISTEN_ID = 0;
+constexpr uint64_t WAKE_ID = 1;
+constexpr uint64_t FIRST_CONNECTION_ID = 2;
+
+constexpr size_t HEADER_LIMIT = 64 * 1024;
+constexpr size_t READ_SIZE = 64 * 1024;
+constexpr size_t CHUNK_SIZE = 16 * 1024;        // Result bytes per HTTP chunk
+constexpr size_t PIPELINE_LIMIT = 64;           // Queued requests per connection before reading pauses
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// Operations reachable as GET /v1/<op>; writes only go through batches
+constexpr std::string_view GET_OPERATIONS[] = { "query", "enum", "search", "diff", "ping" };
+
+struct PollEvent {
+    uint64_t id;
+    bool readable;
+    bool writable;
+};
+
+// Readiness notification for the loop thread. Add/Modify/Remove/Wait are
+// called from the loop only; Wake from any thread.
+class Poller {
+public:
+    ~Poller() { Close(); }
+
+#ifdef __linux__
+    bool Open() {
+        m_epoll = epoll_create1(EPOLL_CLOEXEC);
+        m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_epoll < 0 || m_wake < 0) return false;
+        return Control(EPOLL_CTL_ADD, m_wake, WAKE_ID, true, false);
+    }
+
+    void Close() {
+        if (m_epoll >= 0) close(m_epoll);
+        if (m_wake >= 0) close(m_wake);
+        m_epoll = m_wake = -1;
+    }
+
+    bool Add(Socket socket, uint64_t id, bool read, bool write) { return Control(EPOLL_CTL_ADD, socket, id, read, write); }
+    bool Modify(Socket socket, uint64_t id, bool read, bool write) { return Control(EPOLL_CTL_MOD, socket, id, read, write); }
+    void Remove(Socket socket) { epoll_ctl(m_epoll, EPOLL_CTL_DEL, socket, nullptr); }
+
+    void Wait(std::vector<PollEvent>& events) {
+        events.clear();
+        epoll_event ready[256];
+        int count = epoll_wait(m_epoll, ready, 256, -1);
+        for (int i = 0; i < count; i++) {
+            uint64_t id = ready[i].data.u64;
+            if (id == WAKE_ID) {
+                uint64_t value;
+                while (read(m_wake, &value, sizeof(value)) == sizeof(value)) {}
+            }
+            // Errors and hang-ups surface as readable: the next recv reports them
+            bool readable = ready[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLRDHUP);
+            events.push_back({ id, readable, (ready[i].events & EPOLLOUT) != 0 });
+        }
+    }
+
+    void Wake() {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(m_wake, &one, sizeof(one));
+    }
+
+private:
+    bool Control(int operation, int fd, uint64_t id, bool read, bool write) {
+        epoll_event event{};
+        event.events = (read ? uint32_t{EPOLLIN | EPOLLRDHUP} : 0u) | (write ? uint32_t{EPOLLOUT} : 0u);
+        event.data.u64 = id;
+        return epoll_ctl(m_epoll, operation, fd, &event) == 0;
+    }
+
+    int m_epoll = -1;
+    int m_wake = -1;
+#else
+    bool Open() {
+        if (!MakeWakePair()) return false;
+        SetNonBlocking(m_wakeRead);
+        SetNonBlocking(m_wakeWrite);
+        return Add(m_wakeRead, WAKE_ID, true, false);
+    }
+
+    void Close() {
+        if (m_wakeRead != NO_SOCKET) CloseSocket(m_wakeRead);
+        if (m_wakeWrite != NO_SOCKET) CloseSocket(m_wakeWrite);
+        m_wakeRead = m_wakeWrite = NO_SOCKET;
+        m_fds.clear();
+        m_ids.clear();
+    }
+
+    bool Add(Socket socket, uint64_t id, bool read, bool write) {
+        pollfd entry{};
+        entry.fd = socket;
+        entry.events = static_cast<short>((read ? POLLIN : 0) | (write ? POLLOUT : 0));
+        m_fds.push_back(entry);
+        m_ids.push_back(id);
+        return true;
+    }
+
+    bool Modify(Socket socket, uint64_t, bool read, bool write) {
+        size_t i = Find(socket);
+        if (i == m_fds.size()) return false;
+        m_fds[i].events = static_cast<short>((read ? POLLIN : 0) | (write ? POLLOUT : 0));
+        return true;
+    }
+
+    void Remove(Socket socket) {
+        size_t i = Find(socket);
+        if (i == m_fds.size()) return;
+        m_fds[i] = m_fds.back();
+        m_ids[i] = m_ids.back();
+        m_fds.pop_back();
+        m_ids.pop_back();
+    }
+
+    void Wait(std::vector<PollEvent>& events) {
+        events.clear();
+#ifdef _WIN32
+        int count = WSAPoll(m_fds.data(), static_cast<ULONG>(m_fds.size()), -1);
+#else
+        int count = poll(m_fds.data(), m_fds.size(), -1);
+#endif
+        for (size_t i = 0; count > 0 && i < m_fds.size(); i++) {
+            short revents = m_fds[i].revents;
+            if (!revents) continue;
+            count--;
+            if (m_ids[i] == WAKE_ID) {
+                char drain[64];
+                while (recv(m_wakeRead, drain, sizeof(drain), 0) > 0) {}
+            }
+            events.push_back({ m_ids[i], (revents & (POLLIN | POLLERR | POLLHUP)) != 0, (revents & POLLOUT) != 0 });
+        }
+    }
+
+    void Wake() {
+        char one = 1;
+        send(m_wakeWrite, &one, 1, SEND_FLAGS);
+    }
+
+private:
+    size_t Find(Socket socket) const {
+        for (size_t i = 0; i < m_fds.size(); i++) {
+            if (m_fds[i].fd == socket) return i;
+        }
+        return m_fds.size();
+    }
+
+#ifdef _WIN32
+    // No socketpair on Windows: connect two loopback sockets
+    bool MakeWakePair() {
+        Socket listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listener == NO_SOCKET) return false;
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int length = sizeof(address);
+        bool ok = bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                  listen(listener, 1) == 0 &&
+                  getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+        if (ok) {
+            m_wakeWrite = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            ok = m_wakeWrite != NO_SOCKET &&
+                 connect(m_wakeWrite, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        }
+        if (ok) {
+            m_wakeRead = accept(listener, nullptr, nullptr);
+            ok = m_wakeRead != NO_SOCKET;
+        }
+        CloseSocket(listener);
+        return ok;
+    }
+#else
+    bool MakeWakePair() {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) return false;
+        m_wakeRead = pair[0];
+        m_wakeWrite = pair[1];
+        return true;
+    }
+#endif
+
+    std::vector<pollfd> m_fds;
+    std::vector<uint64_t> m_ids;
+    Socket m_wakeRead = NO_SOCKET;
+    Socket m_wakeWrite = NO_SOCKET;
+#endif
+};
+
+// UTF-8 to UTF-16 units; false on malformed input
+bool DecodeUtf8(std::string_view text, std::wstring& out) {
+    out.clear();
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size();) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        uint32_t c;
+        size_t length;
+        if (lead < 0x80) { c = lead; length = 1; }
+        else if ((lead & 0xE0) == 0xC0) { c = lead & 0x1F; length = 2; }
+        else if ((lead & 0xF0) == 0xE0) { c = lead & 0x0F; length = 3; }
+        else if ((lead & 0xF8) == 0xF0) { c = lead & 0x07; length = 4; }
+        else return false;
+        if (text.size() - i < length) return false;
+        for (size_t k = 1; k < length; k++) {
+            uint8_t next = static_cast<uint8_t>(text[i + k]);
+            if ((next & 0xC0) != 0x80) return false;
+            c = (c << 6) | (next & 0x3F);
+        }
+        i += length;
+        if (c >= 0x10000) {
+            if (c > 0x10FFFF) return false;
+            out.push_back(static_cast<wchar_t>(0xD800 + ((c - 0x10000) >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + ((c - 0x10000) & 0x3FF)));
+        } else {
+            out.push_back(static_cast<wchar_t>(c));
+        }
+    }
+    return true;
+}
+
+void AppendUtf8(std::string& out, uint32_t c) {
+    if (c < 0x80) {
+        out.push_back(static_cast<char>(c));
+    } else if (c < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else if (c < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+}
+
+// Quoted JSON string; unpaired surrogates are written as \u escapes
+void AppendJsonString(std::string& out, std::wstring_view text) {
+    out.push_back('"');
+    for (size_t i = 0; i < text.size(); i++) {
+        uint32_t c = static_cast<uint16_t>(text[i]);
+        if (c >= 0x20 && c < 0x7F) {
+            if (c == '"' || c == '\\') out.push_back('\\');
+            out.push_back(static_cast<char>(c));
+            continue;
+        }
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size()) {
+            uint32_t low = static_cast<uint16_t>(text[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                AppendUtf8(out, 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00));
+                i++;
+                continue;
+            }
+        }
+        if (c < 0x20 || (c >= 0xD800 && c <= 0xDFFF) || c == 0x7F) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+            continue;
+        }
+        AppendUtf8(out, c);
+    }
+    out.push_back('"');
+}
+
+void AppendHex(std::string& out, const uint8_t* data, size_t size) {
+    size_t start = out.size();
+    out.resize(start + size * 2);
+    char* p = out.data() + start;
+    for (size_t i = 0; i < size; i++) {
+        *p++ = HEX_DIGITS[data[i] >> 4];
+        *p++ = HEX_DIGITS[data[i] & 0x0F];
+    }
+}
+
+bool ParseHex(std::wstring_view text, std::vector<uint8_t>& bytes) {
+    bytes.clear();
+    auto digit = [](wchar_t c) -> int {
+        if (c >= L'0' && c <= L'9') return c - L'0';
+        if (c >= L'a' && c <= L'f') return c - L'a' + 10;
+        if (c >= L'A' && c <= L'F') return c - L'A' + 10;
+        return -1;
+    };
+    if (text.size() % 2) return false;
+    for (size_t i = 0; i < text.size(); i += 2) {
+        int high = digit(text[i]);
+        int low = digit(text[i + 1]);
+        if (high < 0 || low < 0) return false;
+        bytes.push_back(static_cast<uint8_t>(high * 16 + low));
+    }
+    return true;
+}
+
+struct TypeEntry {
+    uint32_t type;
+    const char* name;
+};
+
+constexpr TypeEntry TYPE_NAMES[] = {
+    { VALUE_NONE, "REG_NONE" },
+    { VALUE_SZ, "REG_SZ" },
+    { VALUE_EXPAND_SZ, "REG_EXPAND_SZ" },
+    { VALUE_BINARY, "REG_BINARY" },
+    { VALUE_DWORD, "REG_DWORD" },
+    { VALUE_DWORD_BIG_ENDIAN, "REG_DWORD_BIG_ENDIAN" },
+    { VALUE_LINK, "REG_LINK" },
+    { VALUE_MULTI_SZ, "REG_MULTI_SZ" },
+    { VALUE_RESOURCE_LIST, "REG_RESOURCE_LIST" },
+    { VALUE_FULL_RESOURCE_DESCRIPTOR, "REG_FULL_RESOURCE_DESCRIPTOR" },
+    { VALUE_RESOURCE_REQUIREMENTS_LIST, "REG_RESOURCE_REQUIREMENTS_LIST" },
+    { VALUE_QWORD, "REG_QWORD" },
+};
+
+bool IsStringType(uint32_t type) {
+    return type == VALUE_SZ || type == VALUE_EXPAND_SZ || type == VALUE_LINK;
+}
+
+// A well-formed REG_SZ: even size, at most one trailing NUL and none inside
+bool AsString(const std::vector<uint8_t>& data, std::wstring& text) {
+    if (data.size() % 2) return false;
+    size_t units = data.size() / 2;
+    if (units > 0 && data[units * 2 - 2] == 0 && data[units * 2 - 1] == 0) units--;
+    text.resize(units);
+    for (size_t i = 0; i < units; i++) {
+        text[i] = static_cast<wchar_t>(data[i * 2] | (data[i * 2 + 1] << 8));
+        if (text[i] == 0) return false;
+    }
+    return true;
+}
+
+void AppendValue(std::string& out, const RegValue& value) {
+    out += "{\"name\":";
+    AppendJsonString(out, value.name);
+    out += ",\"type\":";
+    auto entry = std::find_if(std::begin(TYPE_NAMES), std::end(TYPE_NAMES),
+                              [&value](const TypeEntry& e) { return e.type == value.type; });
+    if (entry != std::end(TYPE_NAMES)) {
+        out += '"';
+        out += entry->name;
+        out += '"';
+    } else {
+        out += std::to_string(value.type);
+    }
+
+    std::wstring text;
+    if (IsStringType(value.type) && AsString(value.data, text)) {
+        out += ",\"data\":";
+        AppendJsonString(out, text);
+    } else if (value.type == VALUE_DWORD && value.data.size() == 4) {
+        uint32_t number;
+        std::memcpy(&number, value.data.data(), 4);
+        out += ",\"data\":" + std::to_string(number);
+    } else if (value.type == VALUE_QWORD && value.data.size() == 8) {
+        uint64_t number;
+        std::memcpy(&number, value.data.data(), 8);
+        out += ",\"data\":" + std::to_string(number);
+    } else if (value.type == VALUE_MULTI_SZ && value.data.size() % 2 == 0) {
+        out += ",\"data\":[";
+        std::wstring all(value.data.size() / 2, L'\0');
+        for (size_t i = 0; i < all.size(); i++) all[i] = static_cast<wchar_t>(value.data[i * 2] | (value.data[i * 2 + 1] << 8));
+        size_t start = 0;
+        bool first = true;
+        for (size_t i = 0; i < all.size(); i++) {
+            if (all[i] != 0) continue;
+            if (i == start) break;      // Empty string ends the list
+            if (!first) out += ',';
+            AppendJsonString(out, std::wstring_view(all).substr(start, i - start));
+            first = false;
+            start = i + 1;
+        }
+        if (start < all.size() && all.back() != 0) {
+            if (!first) out += ',';
+            AppendJsonString(out, std::wstring_view(all).substr(start));
+        }
+        out += ']';
+    } else {
+        out += ",\"hex\":\"";
+        AppendHex(out, value.data.data(), value.data.size());
+        out += '"';
+    }
+    out += '}';
+}
+
+// One flat JSON object: strings, numbers, booleans, null and arrays of strings
+struct JsonField {
+    enum class Kind { Null, String, Number, Bool, Array };
+    Kind kind = Kind::Null;
+    std::wstring text;                  // String, or the number as written
+    std::vector<std::wstring> items;    // Array elements
+    bool flag = false;
+};
+
+class Fields {
+public:
+    void Clear() { m_fields.clear(); }
+    JsonField& Add(std::string name) { return m_fields.emplace_back(std::move(name), JsonField{}).second; }
+
+    const JsonField* Find(std::string_view name) const {
+        for (const auto& [key, field] : m_fields) {
+            if (key == name) return &field;
+        }
+        return nullptr;
+    }
+
+    bool GetString(std::string_view name, std::wstring& value) const {
+        const JsonField* field = Find(name);
+        if (!field || (field->kind != JsonField::Kind::String && field->kind != JsonField::Kind::Number)) return false;
+        value = field->text;
+        return true;
+    }
+
+    // Booleans may also come from a query string as "1"/"true"
+    bool GetBool(std::string_view name, bool fallback) const {
+        const JsonField* field = Find(name);
+        if (!field) return fallback;
+        if (field->kind == JsonField::Kind::Bool) return field->flag;
+        return field->text == L"1" || field->text == L"true";
+    }
+
+    bool GetNumber(std::string_view name, uint64_t& value) const {
+        std::wstring text;
+        if (!GetString(name, text) || text.empty()) return false;
+        wchar_t* end = nullptr;
+        value = std::wcstoull(text.c_str(), &end, 0);
+        return end && *end == 0;
+    }
+
+private:
+    std::vector<std::pair<std::string, JsonField>> m_fields;
+};
+
+class JsonParser {
+public:
+    bool Parse(std::string_view text, Fields& fields, std::string& error) {
+        m_text = text;
+        m_pos = 0;
+        fields.Clear();
+        if (!Expect('{')) return Fail(error, "expected an object");
+        SkipSpace();
+        if (Peek() == '}') {
+            m_pos++;
+            return AtEnd() || Fail(error, "trailing characters");
+        }
+        while (true) {
+            std::wstring wideName;
+            SkipSpace();
+            if (!ParseString(wideName)) return Fail(error, "expected a field name");
+            std::string name;
+            for (wchar_t c : wideName) name.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+            if (!Expect(':')) return Fail(error, "expected ':'");
+            if (!ParseValue(fields.Add(std::move(name)))) return Fail(error, "unsupported or malformed value");
+            SkipSpace();
+            if (Peek() == ',') {
+                m_pos++;
+                continue;
+            }
+            if (!Expect('}')) return Fail(error, "expected ',' or '}'");
+            return AtEnd() || Fail(error, "trailing characters");
+        }
+    }
+
+private:
+    static bool Fail(std::string& error, const char* message) {
+        error = message;
+        return false;
+    }
+
+    char Peek() const { return m_pos < m_text.size() ? m_text[m_pos] : '\0'; }
+
+    void SkipSpace() {
+        while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+                                         m_text[m_pos] == '\r' || m_text[m_pos] == '\n')) {
+            m_pos++;
+        }
+    }
+
+    bool Expect(char c) {
+        SkipSpace();
+        if (Peek() != c) return false;
+        m_pos++;
+        return true;
+    }
+
+    bool AtEnd() {
+        SkipSpace();
+        return m_pos == m_text.size();
+    }
+
+    bool ParseValue(JsonField& field) {
+        SkipSpace();
+        char c = Peek();
+        if (c == '"') {
+            field.kind = JsonField::Kind::String;
+            return ParseString(field.text);
+        }
+        if (c == '[') {
+            field.kind = JsonField::Kind::Array;
+            m_pos++;
+            SkipSpace();
+            if (Peek() == ']') {
+                m_pos++;
+                return true;
+            }
+            while (true) {
+                SkipSpace();
+                if (!ParseString(field.items.emplace_back())) return false;
+                SkipSpace();
+                if (Peek() == ']') {
+                    m_pos++;
+                    return true;
+                }
+                if (Peek() != ',') return false;
+                m_pos++;
+            }
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            field.kind = JsonField::Kind::Number;
+            size_t start = m_pos;
+            while (m_pos < m_text.size() && std::strchr("+-.eE0123456789", m_text[m_pos])) m_pos++;
+            for (size_t i = start; i < m_pos; i++) field.text.push_back(static_cast<wchar_t>(m_text[i]));
+            return true;
+        }
+        for (auto [word, kind, flag] : { std::tuple{ "true", JsonField::Kind::Bool, true },
+                                         std::tuple{ "false", JsonField::Kind::Bool, false },
+                                         std::tuple{ "null", JsonField::Kind::Null, false } }) {
+            if (m_text.substr(m_pos).starts_with(word)) {
+                m_pos += std::strlen(word);
+                field.kind = kind;
+                field.flag = flag;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ParseString(std::wstring& out) {
+        if (Peek() != '"') return false;
+        m_pos++;
+        out.clear();
+        size_t runStart = m_pos;
+        std::wstring run;
+        auto flushRun = [&]() {
+            if (m_pos == runStart) return true;
+            if (!DecodeUtf8(m_text.substr(runStart, m_pos - runStart), run)) return false;
+            out += run;
+            return true;
+        };
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c == '"') {
+                if (!flushRun()) return false;
+                m_pos++;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) return false;
+            if (c != '\\') {
+                m_pos++;
+                continue;
+            }
+            if (!flushRun()) return false;
+            if (++m_pos >= m_text.size()) return false;
+            switch (m_text[m_pos++]) {
+                case '"': out.push_back(L'"'); break;
+                case '\\': out.push_back(L'\\'); break;
+                case '/': out.push_back(L'/'); break;
+                case 'b': out.push_back(L'\b'); break;
+                case 'f': out.push_back(L'\f'); break;
+                case 'n': out.push_back(L'\n'); break;
+                case 'r': out.push_back(L'\r'); break;
+                case 't': out.push_back(L'\t'); break;
+                case 'u': {
+                    if (m_text.size() - m_pos < 4) return false;
+                    std::vector<uint8_t> bytes;
+                    std::wstring digits(m_text.begin() + m_pos, m_text.begin() + m_pos + 4);
+                    if (!ParseHex(digits, bytes)) return false;
+                    out.push_back(static_cast<wchar_t>((bytes[0] << 8) | bytes[1]));  // Surrogates kept as units
+                    m_pos += 4;
+                    break;
+                }
+                default: return false;
+            }
+            runStart = m_pos;
+        }
+        return false;
+    }
+
+    std::string_view m_text;
+    size_t m_pos = 0;
+};
+
+// "a=1&b=x%20y" into string fields
+bool ParseQuery(std::string_view query, Fields& fields) {
+    while (!query.empty()) {
+        size_t end = query.find('&');
+        std::string_view pair = query.substr(0, end);
+        query = end == std::string_view::npos ? std::string_view() : query.substr(end + 1);
+        if (pair.empty()) continue;
+
+        size_t equals = pair.find('=');
+        std::string parts[2];
+        for (int part = 0; part < 2; part++) {
+            std::string_view raw = part == 0 ? pair.substr(0, equals)
+                                             : (equals == std::string_view::npos ? std::string_view() : pair.substr(equals + 1));
+            for (size_t i = 0; i < raw.size(); i++) {
+                if (raw[i] == '+') {
+                    parts[part].push_back(' ');
+                } else if (raw[i] == '%' && i + 2 < raw.size() && std::isxdigit(static_cast<unsigned char>(raw[i + 1])) &&
+                           std::isxdigit(static_cast<unsigned char>(raw[i + 2]))) {
+                    parts[part].push_back(static_cast<char>(std::strtoul(std::string(raw.substr(i + 1, 2)).c_str(), nullptr, 16)));
+                    i += 2;
+                } else {
+                    parts[part].push_back(raw[i]);
+                }
+            }
+        }
+        JsonField& field = fields.Add(parts[0]);
+        field.kind = JsonField::Kind::String;
+        if (!DecodeUtf8(parts[1], field.text)) return false;
+    }
+    return true;
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+std::string_view Trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+std::string SimpleResponse(int status, const char* reason, const char* message, bool keepAlive) {
+    std::string body = "{\"error\":\"";
+    body += message;
+    body += "\"}\n";
+    std::string response = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    if (!keepAlive) response += "Connection: close\r\n";
+    return response + "\r\n" + body;
+}
+
+// Bearer token: 32 random bytes as hex
+bool MakeToken(std::string& token) {
+    uint8_t bytes[32];
+#ifdef _WIN32
+    if (BCryptGenRandom(nullptr, bytes, sizeof(bytes), BCRYPT_USE_SYSTEM_PREFERRED_RNG) != 0) return false;
+#else
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    bool ok = read(fd, bytes, sizeof(bytes)) == static_cast<ssize_t>(sizeof(bytes));
+    close(fd);
+    if (!ok) return false;
+#endif
+    token.clear();
+    AppendHex(token, bytes, sizeof(bytes));
+    return true;
+}
+
+// Create the token file readable by the current user only. Any old file is
+// removed first, as it would keep its own permissions.
+bool WriteTokenFile(const std::filesystem::path& path, const std::string& token) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+#ifdef _WIN32
+    HANDLE process = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &process)) return false;
+    DWORD size = 0;
+    GetTokenInformation(process, TokenUser, nullptr, 0, &size);
+    std::vector<uint8_t> user(size);
+    bool ok = size && GetTokenInformation(process, TokenUser, user.data(), size, &size);
+    CloseHandle(process);
+    wchar_t* sid = nullptr;
+    if (!ok || !ConvertSidToStringSidW(reinterpret_cast<TOKEN_USER*>(user.data())->User.Sid, &sid)) return false;
+    // Protected DACL with full access for the user and nobody else
+    std::wstring sddl = L"D:P(A;;FA;;;" + std::wstring(sid) + L")";
+    LocalFree(sid);
+    PSECURITY_DESCRIPTOR descriptor = nullptr;
+    if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(sddl.c_str(), SDDL_REVISION_1, &descriptor, nullptr)) {
+        return false;
+    }
+    SECURITY_ATTRIBUTES attributes{ sizeof(attributes), descriptor, FALSE };
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, &attributes, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LocalFree(descriptor);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    ok = WriteFile(file, token.data(), static_cast<DWORD>(token.size()), &written, nullptr) && written == token.size();
+    return CloseHandle(file) && ok;
+#else
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+    bool ok = write(fd, token.data(), token.size()) == static_cast<ssize_t>(token.size());
+    return close(fd) == 0 && ok;
+#endif
+}
+
+// Compare without an early exit, so timing does not reveal the token
+bool SameSecret(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); i++) difference |= static_cast<unsigned char>(a[i] ^ b[i]);
+    return difference == 0;
+}
+
+// Host header naming the loopback interface and our port. A browser led
+// here by DNS rebinding still sends the attacker's host name.
+bool IsLoopbackHost(std::string_view host, std::string_view address, uint16_t port) {
+    size_t colon = host.rfind(':');
+    std::string_view name = host.substr(0, colon);
+    std::string_view number = colon == std::string_view::npos ? std::string_view("80") : host.substr(colon + 1);
+    if (number != std::to_string(port)) return false;
+    return EqualsIgnoreCase(name, "localhost") || name == "127.0.0.1" || name == address;
+}
+
+// application/json, with or without parameters
+bool IsJsonContentType(std::string_view value) {
+    return EqualsIgnoreCase(Trim(value.substr(0, value.find(';'))), "application/json");
+}
+
+int64_t NowMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// One response. Workers append to buffer; the loop moves it to the socket.
+struct Stream {
+    std::mutex mutex;
+    std::condition_variable_any drained;
+    std::string buffer;
+    bool done = false;
+    bool abandoned = false;             // Connection closed; stop producing
+    bool signalled = false;             // The loop has been told there is output
+    bool write = false;                 // The request may modify the registry
+    uint64_t connection = 0;
+    std::shared_ptr<std::atomic<int64_t>> blockedSince;    // The connection's, see Connection
+};
+
+// Where workers hand their output
+class StreamSink {
+public:
+    virtual ~StreamSink() = default;
+
+    // False once the connection is gone
+    virtual bool Deliver(Stream& stream, std::string_view data, bool done) = 0;
+};
+
+// A batch line, parsed when the request arrives
+struct BatchLine {
+    Fields fields;
+    std::string error;                  // Set if the line is not a valid object
+};
+
+struct Request {
+    std::string method;
+    std::string path;
+    std::string query;
+    std::vector<BatchLine> batch;
+    bool keepAlive = true;
+    bool write = false;
+    std::string immediate;              // Prepared response (errors), no worker needed
+};
+
+// Parse the non-empty lines of a batch body; true if any of them writes.
+// Classifying the decoded op means escapes cannot hide a write.
+bool ParseBatch(std::string_view body, std::vector<BatchLine>& lines) {
+    JsonParser parser;
+    bool write = false;
+    while (!body.empty()) {
+        size_t end = body.find('\n');
+        std::string_view line = Trim(body.substr(0, end));
+        body = end == std::string_view::npos ? std::string_view() : body.substr(end + 1);
+        if (line.empty()) continue;
+
+        BatchLine& entry = lines.emplace_back();
+        if (!parser.Parse(line, entry.fields, entry.error)) {
+            if (entry.error.empty()) entry.error = "malformed line";
+            continue;
+        }
+        std::wstring op;
+        entry.fields.GetString("op", op);
+        if (op == L"write" || op == L"delete") write = true;
+    }
+    return write;
+}
+
+} // namespace
+
+class AutomationServer::Loop : public StreamSink {
+public:
+    Loop(RegistryBackend& backend, const AutomationServerOptions& options) : m_backend(backend), m_options(options) {}
+
+    ~Loop() override { Stop(); }
+
+    bool Start(std::wstring& error);
+    void Stop();
+    bool IsRunning() const { return m_thread.joinable(); }
+    uint16_t Port() const { return m_port; }
+    const std::string& Token() const { return m_token; }
+
+    AutomationServerStats GetStats() const {
+        AutomationServerStats stats;
+        stats.connections = m_acceptedConnections.load();
+        stats.requests = m_requests.load();
+        stats.operations = m_operations.load();
+        stats.bytesSent = m_bytesSent.load();
+        return stats;
+    }
+
+    // Blocks while the response has more than streamBufferLimit bytes unsent.
+    // Fails, closing the connection, once the client has taken no output for
+    // sendTimeoutMs.
+    bool Deliver(Stream& stream, std::string_view data, bool done) override;
+
+private:
+    struct Connection {
+        uint64_t id = 0;
+        Socket socket = NO_SOCKET;
+        std::string input;
+        std::string output;
+        size_t outputOffset = 0;
+        std::deque<Request> pending;                    // Parsed, waiting to run
+        std::deque<std::shared_ptr<Stream>> streams;    // Running or finished, in response order
+        uint32_t running = 0;
+        bool writeRunning = false;
+        bool closeAfter = false;        // No more requests: Connection: close or a framing error
+        bool readClosed = false;
+        bool reading = true;            // Current poller interest
+        bool writing = false;
+        // When the client last left output unsent without taking any of it;
+        // 0 while nothing is waiting on the client
+        std::shared_ptr<std::atomic<int64_t>> blockedSince = std::make_shared<std::atomic<int64_t>>(0);
+    };
+
+    struct Task {
+        std::shared_ptr<Stream> stream;
+        Request request;
+    };
+
+    struct Event {
+        uint64_t connection;
+        std::shared_ptr<Stream> finished;   // Set when a request completed
+        bool close = false;                 // The client stopped reading
+    };
+
+    void Run(std::stop_token stopToken);
+    void Accept();
+    void Read(Connection& connection);
+    bool ParseRequest(Connection& connection);
+    void Dispatch(Connection& connection);
+    void Flush(Connection& connection);
+    void UpdateInterest(Connection& connection);
+    void CloseConnection(Connection& connection);
+    void HandleEvents();
+
+    void Post(uint64_t connection, std::shared_ptr<Stream> finished, bool close = false);
+    void WorkerLoop(std::stop_token stopToken);
+    void Execute(Task& task);
+
+    RegistryBackend& m_backend;
+    AutomationServerOptions m_options;
+    Socket m_listen = NO_SOCKET;
+    uint16_t m_port = 0;
+    std::string m_token;
+    bool m_tokenWritten = false;
+    Poller m_poller;
+    std::jthread m_thread;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> m_connections;
+    uint64_t m_nextId = FIRST_CONNECTION_ID;
+#ifdef _WIN32
+    bool m_winsock = false;
+#endif
+
+    std::mutex m_taskMutex;
+    std::condition_variable_any m_taskReady;
+    std::deque<Task> m_tasks;
+    std::vector<std::jthread> m_workers;
+
+    std::mutex m_eventMutex;
+    std::vector<Event> m_events;
+
+    std::atomic<uint64_t> m_acceptedConnections{0};
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_operations{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+};
+
+namespace {
+
+// Collects NDJSON lines and hands them over as HTTP chunks
+class ResponseWriter {
+public:
+    ResponseWriter(StreamSink& sink, Stream& stream, bool keepAlive) : m_sink(sink), m_stream(stream) {
+        m_header = "HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/x-ndjson\r\n"
+                   "Transfer-Encoding: chunked\r\n";
+        if (!keepAlive) m_header += "Connection: close\r\n";
+        m_header += "\r\n";
+    }
+
+    bool Ok() const { return m_ok; }
+
+    // Start a result line: {"id":<id>
+    std::string& Begin(const std::string& id) {
+        m_line += "{\"id\":";
+        m_line += id;
+        return m_line;
+    }
+
+    void End() {
+        m_line += "}\n";
+        if (m_line.size() >= CHUNK_SIZE) Flush(false);
+    }
+
+    void Error(const std::string& id, const char* message) {
+        Begin(id) += ",\"error\":\"";
+        m_line += message;
+        m_line += '"';
+        End();
+    }
+
+    void Finish() { Flush(true); }
+
+private:
+    void Flush(bool last) {
+        if (!m_ok) return;
+        std::string frame = std::move(m_header);
+        m_header.clear();
+        if (!m_line.empty()) {
+            char size[20];
+            std::snprintf(size, sizeof(size), "%zx\r\n", m_line.size());
+            frame += size;
+            frame += m_line;
+            frame += "\r\n";
+            m_line.clear();
+        }
+        if (last) frame += "0\r\n\r\n";
+        m_ok = m_sink.Deliver(m_stream, frame, last);
+    }
+
+    StreamSink& m_sink;
+    Stream& m_stream;
+    std::string m_header;
+    std::string m_line;
+    bool m_ok = true;
+};
+
+// Runs single operations against the backend
+class Operations {
+public:
+    Operations(RegistryBackend& backend, bool allowWrites, ResponseWriter& out)
+        : m_backend(backend), m_allowWrites(allowWrites), m_out(out) {}
+
+    void Run(const Fields& fields, const std::string& id) {
+        std::wstring op;
+        fields.GetString("op", op);
+        if (op == L"query") Query(fields, id);
+        else if (op == L"enum") Enumerate(fields, id);
+        else if (op == L"search") Search(fields, id);
+        else if (op == L"diff") Diff(fields, id);
+        else if (op == L"write") Write(fields, id);
+        else if (op == L"delete") Delete(fields, id);
+        else if (op == L"ping") {
+            m_out.Begin(id) += ",\"ok\":true";
+            m_out.End();
+        } else {
+            m_out.Error(id, "unknown op");
+        }
+    }
+
+private:
+    struct Frame {
+        KeyPtr key;
+        std::wstring path;              // Relative to the operation's key
+        std::vector<std::wstring> names;
+        size_t next = 0;
+    };
+
+    KeyPtr Open(const Fields& fields, const char* name, const std::string& id) {
+        std::wstring path;
+        fields.GetString(name, path);
+        KeyPtr key = m_backend.OpenKey(path);
+        if (!key) m_out.Error(id, "key not found");
+        return key;
+    }
+
+    static std::wstring Join(const std::wstring& path, std::wstring_view name) {
+        return path.empty() ? std::wstring(name) : path + L'\\' + std::wstring(name);
+    }
+
+    void Done(const std::string& id, uint64_t count) {
+        m_out.Begin(id) += ",\"done\":true,\"count\":" + std::to_string(count);
+        m_out.End();
+    }
+
+    void Query(const Fields& fields, const std::string& id) {
+        KeyPtr key = Open(fields, "path", id);
+        if (!key) return;
+        std::wstring name;
+        if (fields.GetString("name", name)) {
+            RegValue value;
+            if (!key->GetValue(name, value)) return m_out.Error(id, "value not found");
+            std::string& line = m_out.Begin(id);
+            line += ",\"value\":";
+            AppendValue(line, value);
+            return m_out.End();
+        }
+
+        thread_local std::vector<RegValue> values;
+        key->GetValues(values);
+        std::string& line = m_out.Begin(id);
+        line += ",\"values\":[";
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i) line += ',';
+            AppendValue(line, values[i]);
+        }
+        line += ']';
+        m_out.End();
+    }
+
+    void Enumerate(const Fields& fields, const std::string& id) {
+        KeyPtr root = Open(fields, "path", id);
+        if (!root) return;
+        bool recursive = fields.GetBool("recursive", false);
+        bool withValues = fields.GetBool("values", false);
+
+        uint64_t count = 0;
+        std::vector<Frame> stack;
+        stack.push_back({ std::move(root), {}, {}, 0 });
+        stack.back().key->GetSubKeyNames(stack.back().names);
+        std::vector<RegValue> values;
+        while (!stack.empty() && m_out.Ok()) {
+            Frame& top = stack.back();
+            if (top.next == top.names.size()) {
+                stack.pop_back();
+                continue;
+            }
+            std::wstring path = Join(top.path, top.names[top.next]);
+            KeyPtr key = top.key->OpenSubKey(top.names[top.next++]);
+            KeyInfo info{};
+            if (!key || !key->QueryInfo(info)) continue;
+
+            std::string& line = m_out.Begin(id);
+            line += ",\"path\":";
+            AppendJsonString(line, path);
+            line += ",\"subkeys\":" + std::to_string(info.subKeyCount) +
+                    ",\"valueCount\":" + std::to_string(info.valueCount) +
+                    ",\"lastWriteTime\":" + std::to_string(info.lastWriteTime);
+            if (withValues) {
+                key->GetValues(values);
+                line += ",\"values\":[";
+                for (size_t i = 0; i < values.size(); i++) {
+                    if (i) line += ',';
+                    AppendValue(line, values[i]);
+                }
+                line += ']';
+            }
+            m_out.End();
+            count++;
+
+            if (recursive && info.subKeyCount) {
+                Frame child{ std::move(key), std::move(path), {}, 0 };
+                child.key->GetSubKeyNames(child.names);
+                stack.push_back(std::move(child));
+            }
+        }
+        Done(id, count);
+    }
+
+    void Search(const Fields& fields, const std::string& id) {
+        KeyPtr root = Open(fields, "path", id);
+        if (!root) return;
+        std::wstring text;
+        if (!fields.GetString("text", text) || text.empty()) return m_out.Error(id, "text is required");
+        std::wstring needle = FoldName(text);
+        bool keys = fields.GetBool("keys", true);
+        bool valueNames = fields.GetBool("values", true);
+        bool data = fields.GetBool("data", true);
+        uint64_t limit = 0;
+        fields.GetNumber("limit", limit);
+
+        uint64_t count = 0;
+        auto match = [&](const std::wstring& path, const std::wstring* name, const char* kind) {
+            std::string& line = m_out.Begin(id);
+            line += ",\"path\":";
+            AppendJsonString(line, path);
+            if (name) {
+                line += ",\"name\":";
+                AppendJsonString(line, *name);
+            }
+            line += ",\"match\":\"";
+            line += kind;
+            line += '"';
+            m_out.End();
+            count++;
+        };
+        auto limited = [&] { return limit && count >= limit; };
+
+        std::vector<Frame> stack;
+        stack.push_back({ std::move(root), {}, {}, 0 });
+        std::vector<RegValue> values;
+        std::wstring decoded;
+        bool fresh = true;              // Top frame's own values not searched yet
+        while (!stack.empty() && m_out.Ok() && !limited()) {
+            Frame& top = stack.back();
+            if (fresh) {
+                fresh = false;
+                top.key->GetSubKeyNames(top.names);
+                if (valueNames || data) {
+                    top.key->GetValues(values);
+                    for (const RegValue& value : values) {
+                        if (limited()) break;
+                        if (valueNames && FoldName(value.name).find(needle) != std::wstring::npos) {
+                            match(top.path, &value.name, "value");
+                            continue;
+                        }
+                        if (!data || (!IsStringType(value.type) && value.type != VALUE_MULTI_SZ)) continue;
+                        decoded.resize(value.data.size() / 2);
+                        for (size_t i = 0; i < decoded.size(); i++) {
+                            decoded[i] = static_cast<wchar_t>(value.data[i * 2] | (value.data[i * 2 + 1] << 8));
+                        }
+                        if (FoldName(decoded).find(needle) != std::wstring::npos) match(top.path, &value.name, "data");
+                    }
+                }
+            }
+            if (top.next == top.names.size()) {
+                stack.pop_back();
+                continue;
+            }
+            const std::wstring& name = top.names[top.next++];
+            std::wstring path = Join(top.path, name);
+            if (keys && FoldName(name).find(needle) != std::wstring::npos) match(path, nullptr, "key");
+            KeyPtr key = top.key->OpenSubKey(name);
+            if (!key) continue;
+            stack.push_back({ std::move(key), std::move(path), {}, 0 });
+            fresh = true;
+        }
+        Done(id, count);
+    }
+
+    void Diff(const Fields& fields, const std::string& id) {
+        KeyPtr from = Open(fields, "path", id);
+        if (!from) return;
+        KeyPtr to = Open(fields, "other", id);
+        if (!to) return;
+
+        uint64_t count = 0;
+        auto change = [&](const char* kind, const std::wstring& path, const std::wstring* name) {
+            std::string& line = m_out.Begin(id);
+            line += ",\"change\":\"";
+            line += kind;
+            line += "\",\"path\":";
+            AppendJsonString(line, path);
+            if (name) {
+                line += ",\"name\":";
+                AppendJsonString(line, *name);
+            }
+            m_out.End();
+            count++;
+        };
+        auto byName = [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; };
+        auto valueByName = [](const RegValue& a, const RegValue& b) { return CompareNames(a.name, b.name) < 0; };
+
+        struct Pair {
+            KeyPtr from;
+            KeyPtr to;
+            std::wstring path;
+        };
+        std::vector<Pair> stack;
+        stack.push_back({ std::move(from), std::move(to), {} });
+        std::vector<RegValue> a, b;
+        std::vector<std::wstring> namesA, namesB;
+        while (!stack.empty() && m_out.Ok()) {
+            Pair pair = std::move(stack.back());
+            stack.pop_back();
+
+            pair.from->GetValues(a);
+            pair.to->GetValues(b);
+            std::sort(a.begin(), a.end(), valueByName);
+            std::sort(b.begin(), b.end(), valueByName);
+            size_t i = 0, j = 0;
+            while (i < a.size() || j < b.size()) {
+                int order = i == a.size() ? 1 : j == b.size() ? -1 : CompareNames(a[i].name, b[j].name);
+                if (order < 0) {
+                    change("removed", pair.path, &a[i++].name);
+                } else if (order > 0) {
+                    change("added", pair.path, &b[j++].name);
+                } else {
+                    if (a[i].type != b[j].type || a[i].data != b[j].data) change("changed", pair.path, &a[i].name);
+                    i++;
+                    j++;
+                }
+            }
+
+            pair.from->GetSubKeyNames(namesA);
+            pair.to->GetSubKeyNames(namesB);
+            std::sort(namesA.begin(), namesA.end(), byName);
+            std::sort(namesB.begin(), namesB.end(), byName);
+            i = j = 0;
+            while (i < namesA.size() || j < namesB.size()) {
+                int order = i == namesA.size() ? 1 : j == namesB.size() ? -1 : CompareNames(namesA[i], namesB[j]);
+                if (order < 0) {
+                    change("removed", Join(pair.path, namesA[i++]), nullptr);
+                } else if (order > 0) {
+                    change("added", Join(pair.path, namesB[j++]), nullptr);
+                } else {
+                    KeyPtr childFrom = pair.from->OpenSubKey(namesA[i]);
+                    KeyPtr childTo = pair.to->OpenSubKey(namesB[j]);
+                    if (childFrom && childTo) stack.push_back({ std::move(childFrom), std::move(childTo), Join(pair.path, namesA[i]) });
+                    i++;
+                    j++;
+                }
+            }
+        }
+        Done(id, count);
+    }
+
+    bool ParseValue(const Fields& fields, RegValue& value, const char*& error) {
+        fields.GetString("name", value.name);
+        std::wstring type;
+        if (!fields.GetString("type", type)) {
+            error = "type is required";
+            return false;
+        }
+        value.type = UINT32_MAX;
+        for (const TypeEntry& entry : TYPE_NAMES) {
+            std::wstring name(entry.name, entry.name + std::strlen(entry.name));
+            if (NamesEqual(name, type)) value.type = entry.type;
+        }
+        uint64_t number = 0;
+        if (value.type == UINT32_MAX) {
+            if (!fields.GetNumber("type", number) || number > UINT32_MAX) {
+                error = "unknown type";
+                return false;
+            }
+            value.type = static_cast<uint32_t>(number);
+        }
+
+        std::wstring hex;
+        if (fields.GetString("hex", hex)) {
+            if (ParseHex(hex, value.data)) return true;
+            error = "malformed hex";
+            return false;
+        }
+        const JsonField* data = fields.Find("data");
+        if (!data) {
+            error = "data or hex is required";
+            return false;
+        }
+        if (IsStringType(value.type) && data->kind == JsonField::Kind::String) {
+            value.data = EncodeString(data->text);
+            return true;
+        }
+        if (value.type == VALUE_MULTI_SZ && data->kind == JsonField::Kind::Array) {
+            std::wstring joined;
+            for (const std::wstring& item : data->items) {
+                joined += item;
+                joined.push_back(L'\0');
+            }
+            value.data = EncodeString(joined);
+            return true;
+        }
+        if ((value.type == VALUE_DWORD || value.type == VALUE_QWORD) && fields.GetNumber("data", number)) {
+            size_t size = value.type == VALUE_DWORD ? 4 : 8;
+            if (size == 4 && number > UINT32_MAX) {
+                error = "number out of range";
+                return false;
+            }
+            value.data.resize(size);
+            std::memcpy(value.data.data(), &number, size);  // Little-endian hosts only, like the registry
+            return true;
+        }
+        error = "data does not match the type";
+        return false;
+    }
+
+    void Write(const Fields& fields, const std::string& id) {
+        if (!m_allowWrites) return m_out.Error(id, "writes are disabled");
+        RegValue value;
+        const char* error = nullptr;
+        if (!ParseValue(fields, value, error)) return m_out.Error(id, error);
+
+        std::wstring path;
+        fields.GetString("path", path);
+        KeyPtr key = m_backend.OpenRoot();
+        if (key && !SplitPath(path).empty()) key = key->CreateSubKey(path);
+        if (!key) return m_out.Error(id, "cannot create key");
+        if (!key->SetValue(value)) return m_out.Error(id, "cannot set value");
+        m_out.Begin(id) += ",\"ok\":true";
+        m_out.End();
+    }
+
+    void Delete(const Fields& fields, const std::string& id) {
+        if (!m_allowWrites) return m_out.Error(id, "writes are disabled");
+        std::wstring path;
+        fields.GetString("path", path);
+        std::wstring name;
+        bool ok;
+        if (fields.GetString("name", name)) {
+            KeyPtr key = m_backend.OpenKey(path);
+            if (!key) return m_out.Error(id, "key not found");
+            ok = key->DeleteValue(name);
+        } else {
+            std::vector<std::wstring_view> parts = SplitPath(path);
+            if (parts.empty()) return m_out.Error(id, "cannot delete the root");
+            std::wstring_view leaf = parts.back();
+            std::wstring parentPath(path.data(), leaf.data() - path.data());
+            KeyPtr parent = m_backend.OpenKey(parentPath);
+            if (!parent) return m_out.Error(id, "key not found");
+            if (fields.GetBool("recursive", false)) {
+                SubtreeStats stats = DeleteSubtree(*parent, leaf);
+                ok = stats.errors == 0;
+            } else {
+                ok = parent->DeleteSubKey(leaf);
+            }
+        }
+        if (!ok) return m_out.Error(id, "cannot delete");
+        m_out.Begin(id) += ",\"ok\":true";
+        m_out.End();
+    }
+
+    RegistryBackend& m_backend;
+    bool m_allowWrites;
+    ResponseWriter& m_out;
+};
+
+} // namespace
+
+bool AutomationServer::Loop::Start(std::wstring& error) {
+#ifdef _WIN32
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        error = L"Cannot initialize Winsock";
+        return false;
+    }
+    m_winsock = true;
+#endif
+    auto fail = [&](const wchar_t* message) {
+        error = message;
+        Stop();
+        return false;
+    };
+
+    if (!m_options.unixSocket.empty()) {
+#ifdef _WIN32
+        return fail(L"Unix sockets are not supported on this platform");
+#else
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (m_options.unixSocket.size() >= sizeof(address.sun_path)) return fail(L"Socket path is too long");
+        std::memcpy(address.sun_path, m_options.unixSocket.c_str(), m_options.unixSocket.size() + 1);
+        m_listen = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_listen == NO_SOCKET) return fail(L"Cannot create socket");
+        unlink(m_options.unixSocket.c_str());   // A stale socket from an earlier run
+        if (bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return fail(L"Cannot bind the socket path");
+        }
+#endif
+    } else {
+        // Loopback only, on top of the token
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(m_options.port);
+        std::string host = m_options.address == "localhost" ? "127.0.0.1" : m_options.address;
+        if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) return fail(L"Invalid address");
+        if ((ntohl(address.sin_addr.s_addr) >> 24) != 127) return fail(L"Only loopback addresses are allowed");
+
+        m_listen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (m_listen == NO_SOCKET) return fail(L"Cannot create socket");
+        int on = 1;
+        setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+        if (bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            return fail(L"Cannot bind the port");
+        }
+        socklen_t length = sizeof(address);
+        getsockname(m_listen, reinterpret_cast<sockaddr*>(&address), &length);
+        m_port = ntohs(address.sin_port);
+    }
+
+    if (listen(m_listen, SOMAXCONN) != 0 || !SetNonBlocking(m_listen)) return fail(L"Cannot listen");
+    if (!MakeToken(m_token)) return fail(L"Cannot generate the access token");
+    if (!m_options.tokenFile.empty()) {
+        if (!WriteTokenFile(m_options.tokenFile, m_token)) return fail(L"Cannot write the token file");
+        m_tokenWritten = true;
+    }
+    if (!m_poller.Open() || !m_poller.Add(m_listen, LISTEN_ID, true, false)) return fail(L"Cannot create the event loop");
+
+    unsigned workers = m_options.workerCount ? m_options.workerCount : std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    for (unsigned i = 0; i < workers; i++) {
+        m_workers.emplace_back([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+    }
+    m_thread = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+    return true;
+}
+
+void AutomationServer::Loop::Stop() {
+    if (m_thread.joinable()) {
+        m_thread.request_stop();
+        m_poller.Wake();
+        m_thread.join();
+    }
+
+    // Unblock workers waiting on a full response, then let them finish
+    for (auto& [id, connection] : m_connections) CloseConnection(*connection);
+    m_connections.clear();
+    for (std::jthread& worker : m_workers) worker.request_stop();
+    m_workers.clear();
+    m_tasks.clear();
+    m_events.clear();
+
+    m_poller.Close();
+    if (m_listen != NO_SOCKET) {
+        CloseSocket(m_listen);
+        m_listen = NO_SOCKET;
+#ifndef _WIN32
+        if (!m_options.unixSocket.empty()) unlink(m_options.unixSocket.c_str());
+#endif
+    }
+    if (m_tokenWritten) {
+        std::error_code ec;
+        std::filesystem::remove(m_options.tokenFile, ec);
+        m_tokenWritten = false;
+    }
+#ifdef _WIN32
+    if (m_winsock) WSACleanup();
+    m_winsock = false;
+#endif
+}
+
+void AutomationServer::Loop::Run(std::stop_token stopToken) {
+    std::vector<PollEvent> events;
+    while (!stopToken.stop_requested()) {
+        m_poller.Wait(events);
+        for (const PollEvent& event : events) {
+            if (event.id == LISTEN_ID) {
+                Accept();
+            } else if (event.id == WAKE_ID) {
+                HandleEvents();
+            } else {
+                auto it = m_connections.find(event.id);
+                if (it == m_connections.end()) continue;
+                Connection& connection = *it->second;
+                if (event.readable) Read(connection);
+                // Read may have closed the connection
+                if (event.writable) Flush(connection);
+            }
+        }
+    }
+}
+
+void AutomationServer::Loop::Accept() {
+    while (true) {
+        Socket socket = accept(m_listen, nullptr, nullptr);
+        if (socket == NO_SOCKET) return;
+        if (!SetNonBlocking(socket)) {
+            CloseSocket(socket);
+            continue;
+        }
+        int on = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+
+        auto connection = std::make_unique<Connection>();
+        connection->id = m_nextId++;
+        connection->socket = socket;
+        if (!m_poller.Add(socket, connection->id, true, false)) {
+            CloseSocket(socket);
+            continue;
+        }
+        m_connections.emplace(connection->id, std::move(connection));
+        m_acceptedConnections.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AutomationServer::Loop::Read(Connection& connection) {
+    if (connection.socket == NO_SOCKET) return;
+    char buffer[READ_SIZE];
+    while (true) {
+        auto received = recv(connection.socket, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            if (!connection.closeAfter) connection.input.append(buffer, static_cast<size_t>(received));
+            if (static_cast<size_t>(received) < sizeof(buffer)) break;
+            continue;
+        }
+        if (received < 0 && WouldBlock()) break;
+        if (received < 0) return CloseConnection(connection);
+        connection.readClosed = true;   // Finish what was asked, then close
+        break;
+    }
+
+    while (!connection.closeAfter && connection.pending.size() < PIPELINE_LIMIT && ParseRequest(connection)) {}
+    Dispatch(connection);
+    Flush(connection);
+}
+
+// Take one complete request off the input; false if there is none yet
+bool AutomationServer::Loop::ParseRequest(Connection& connection) {
+    std::string& input = connection.input;
+    size_t headerEnd = input.find("\r\n\r\n");
+    auto reject = [&](int status, const char* reason, const char* message) {
+        Request request;
+        request.immediate = SimpleResponse(status, reason, message, false);
+        connection.pending.push_back(std::move(request));
+        connection.closeAfter = true;
+        input.clear();
+        return false;
+    };
+    if (headerEnd == std::string::npos) {
+        if (input.size() > HEADER_LIMIT) return reject(431, "Request Header Fields Too Large", "headers too large");
+        return false;
+    }
+
+    Request request;
+    std::string_view head(input.data(), headerEnd);
+    size_t lineEnd = head.find("\r\n");
+    std::string_view requestLine = head.substr(0, lineEnd);
+    size_t space1 = requestLine.find(' ');
+    size_t space2 = requestLine.rfind(' ');
+    if (space1 == std::string_view::npos || space2 == space1) return reject(400, "Bad Request", "malformed request line");
+    request.method = requestLine.substr(0, space1);
+    std::string_view target = requestLine.substr(space1 + 1, space2 - space1 - 1);
+    std::string_view version = requestLine.substr(space2 + 1);
+    if (!version.starts_with("HTTP/1.")) return reject(505, "HTTP Version Not Supported", "HTTP/1.x only");
+    request.keepAlive = version != "HTTP/1.0";
+
+    size_t contentLength = 0;
+    bool expectContinue = false;
+    bool hostValid = false;
+    bool origin = false;
+    bool authorized = false;
+    bool json = false;
+    std::string_view headers = lineEnd == std::string_view::npos ? std::string_view() : head.substr(lineEnd + 2);
+    while (!headers.empty()) {
+        size_t end = headers.find("\r\n");
+        std::string_view line = headers.substr(0, end);
+        headers = end == std::string_view::npos ? std::string_view() : headers.substr(end + 2);
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string_view name = Trim(line.substr(0, colon));
+        std::string_view value = Trim(line.substr(colon + 1));
+        if (EqualsIgnoreCase(name, "Content-Length")) {
+            char* endPtr = nullptr;
+            std::string number(value);
+            contentLength = std::strtoull(number.c_str(), &endPtr, 10);
+            if (number.empty() || *endPtr) return reject(400, "Bad Request", "malformed Content-Length");
+        } else if (EqualsIgnoreCase(name, "Transfer-Encoding")) {
+            return reject(501, "Not Implemented", "chunked requests are not supported");
+        } else if (EqualsIgnoreCase(name, "Connection")) {
+            if (EqualsIgnoreCase(value, "close")) request.keepAlive = false;
+            else if (EqualsIgnoreCase(value, "keep-alive")) request.keepAlive = true;
+        } else if (EqualsIgnoreCase(name, "Expect")) {
+            expectContinue = EqualsIgnoreCase(value, "100-continue");
+        } else if (EqualsIgnoreCase(name, "Host")) {
+            hostValid = IsLoopbackHost(value, m_options.address, m_port);
+        } else if (EqualsIgnoreCase(name, "Origin")) {
+            origin = true;
+        } else if (EqualsIgnoreCase(name, "Authorization")) {
+            constexpr std::string_view scheme = "Bearer ";
+            authorized = value.size() > scheme.size() && EqualsIgnoreCase(value.substr(0, scheme.size()), scheme) &&
+                         SameSecret(Trim(value.substr(scheme.size())), m_token);
+        } else if (EqualsIgnoreCase(name, "Content-Type")) {
+            json = IsJsonContentType(value);
+        }
+    }
+    // Browsers always send Origin on cross-origin requests, and the Host
+    // check catches DNS rebinding; a Unix socket is not reachable from one
+    if (origin) return reject(403, "Forbidden", "cross-origin requests are not allowed");
+    if (m_options.unixSocket.empty() && !hostValid) return reject(403, "Forbidden", "Host must name the loopback interface");
+    if (!authorized) return reject(401, "Unauthorized", "missing or wrong bearer token");
+    if (contentLength > m_options.maxRequestBytes) return reject(413, "Content Too Large", "request too large");
+
+    size_t total = headerEnd + 4 + contentLength;
+    if (input.size() < total) {
+        // Only safe to answer early when nothing else is queued ahead of it
+        if (expectContinue && connection.streams.empty() && connection.pending.empty() &&
+            input.size() == headerEnd + 4) {
+            connection.output += "HTTP/1.1 100 Continue\r\n\r\n";
+        }
+        return false;
+    }
+
+    size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    if (question != std::string_view::npos) request.query = target.substr(question + 1);
+    std::string_view body(input.data() + headerEnd + 4, contentLength);
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+
+    if (request.path == "/v1/batch") {
+        if (request.method != "POST") {
+            request.immediate = SimpleResponse(405, "Method Not Allowed", "use POST", request.keepAlive);
+        } else if (!json) {
+            request.immediate = SimpleResponse(415, "Unsupported Media Type", "use application/json", request.keepAlive);
+        } else {
+            request.write = ParseBatch(body, request.batch);
+        }
+    } else if (request.path.starts_with("/v1/") &&
+               std::ranges::find(GET_OPERATIONS, std::string_view(request.path).substr(4)) != std::end(GET_OPERATIONS)) {
+        if (request.method != "GET") {
+            request.immediate = SimpleResponse(405, "Method Not Allowed", "use GET", request.keepAlive);
+        }
+    } else {
+        request.immediate = SimpleResponse(404, "Not Found", "unknown path or operation", request.keepAlive);
+    }
+    input.erase(0, total);
+    if (!request.keepAlive) connection.closeAfter = true;
+    connection.pending.push_back(std::move(request));
+    return true;
+}
+
+// Start queued requests that may run now, keeping response order
+void AutomationServer::Loop::Dispatch(Connection& connection) {
+    while (!connection.pending.empty()) {
+        Request& request = connection.pending.front();
+        bool immediate = !request.immediate.empty();
+        if (!immediate && (request.write ? connection.running > 0 : connection.writeRunning)) break;
+
+        auto stream = std::make_shared<Stream>();
+        stream->connection = connection.id;
+        stream->blockedSince = connection.blockedSince;
+        if (immediate) {
+            stream->buffer = std::move(request.immediate);
+            stream->done = true;
+            connection.streams.push_back(std::move(stream));
+            connection.pending.pop_front();
+            continue;
+        }
+
+        stream->write = request.write;
+        connection.running++;
+        if (request.write) connection.writeRunning = true;
+        connection.streams.push_back(stream);
+        {
+            std::lock_guard lock(m_taskMutex);
+            m_tasks.push_back({ std::move(stream), std::move(request) });
+        }
+        m_taskReady.notify_one();
+        connection.pending.pop_front();
+    }
+}
+
+void AutomationServer::Loop::Flush(Connection& connection) {
+    if (connection.socket == NO_SOCKET) return;
+    // Move finished output in response order, without racing ahead of a slow client
+    while (!connection.streams.empty() &&
+           connection.output.size() - connection.outputOffset < m_options.streamBufferLimit) {
+        Stream& stream = *connection.streams.front();
+        bool done;
+        {
+            std::lock_guard lock(stream.mutex);
+            connection.output += stream.buffer;
+            stream.buffer.clear();
+            stream.signalled = false;
+            done = stream.done;
+        }
+        stream.drained.notify_all();
+        if (!done) break;
+        connection.streams.pop_front();
+    }
+
+    bool progressed = false;
+    while (connection.outputOffset < connection.output.size()) {
+        size_t remaining = connection.output.size() - connection.outputOffset;
+        auto sent = send(connection.socket, connection.output.data() + connection.outputOffset,
+                         static_cast<int>(remaining < (1u << 30) ? remaining : (1u << 30)), SEND_FLAGS);
+        if (sent > 0) {
+            connection.outputOffset += static_cast<size_t>(sent);
+            m_bytesSent.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+            progressed = true;
+            continue;
+        }
+        if (sent < 0 && WouldBlock()) break;
+        return CloseConnection(connection);
+    }
+    if (connection.outputOffset == connection.output.size()) connection.blockedSince->store(0);
+    else if (progressed || connection.blockedSince->load() == 0) connection.blockedSince->store(NowMilliseconds());
+    if (connection.outputOffset == connection.output.size()) {
+        connection.output.clear();
+        connection.outputOffset = 0;
+    } else if (connection.outputOffset > (1u << 20)) {
+        connection.output.erase(0, connection.outputOffset);
+        connection.outputOffset = 0;
+    }
+
+    bool idle = connection.output.empty() && connection.streams.empty() && connection.pending.empty();
+    if (idle && (connection.closeAfter || connection.readClosed)) return CloseConnection(connection);
+    UpdateInterest(connection);
+}
+
+void AutomationServer::Loop::UpdateInterest(Connection& connection) {
+    bool reading = !connection.readClosed && !connection.closeAfter && connection.pending.size() < PIPELINE_LIMIT;
+    bool writing = connection.outputOffset < connection.output.size();
+    if (reading == connection.reading && writing == connection.writing) return;
+    connection.reading = reading;
+    connection.writing = writing;
+    m_poller.Modify(connection.socket, connection.id, reading, writing);
+}
+
+void AutomationServer::Loop::CloseConnection(Connection& connection) {
+    if (connection.socket == NO_SOCKET) return;
+    m_poller.Remove(connection.socket);
+    CloseSocket(connection.socket);
+    connection.socket = NO_SOCKET;
+    for (const std::shared_ptr<Stream>& stream : connection.streams) {
+        {
+            std::lock_guard lock(stream->mutex);
+            stream->abandoned = true;
+        }
+        stream->drained.notify_all();
+    }
+    // Deferred: callers may still hold the reference
+    Post(connection.id, nullptr);
+}
+
+void AutomationServer::Loop::Post(uint64_t connection, std::shared_ptr<Stream> finished, bool close) {
+    bool wake;
+    {
+        std::lock_guard lock(m_eventMutex);
+        wake = m_events.empty();
+        m_events.push_back({ connection, std::move(finished), close });
+    }
+    if (wake) m_poller.Wake();
+}
+
+void AutomationServer::Loop::HandleEvents() {
+    std::vector<Event> events;
+    {
+        std::lock_guard lock(m_eventMutex);
+        events.swap(m_events);
+    }
+    for (Event& event : events) {
+        auto it = m_connections.find(event.connection);
+        if (it == m_connections.end()) continue;
+        Connection& connection = *it->second;
+        if (connection.socket == NO_SOCKET) {
+            m_connections.erase(it);
+            continue;
+        }
+        if (event.close) {
+            CloseConnection(connection);
+            continue;
+        }
+        if (event.finished) {
+            connection.running--;
+            if (event.finished->write) connection.writeRunning = false;
+            // A paused connection may have complete requests buffered
+            while (!connection.closeAfter && connection.pending.size() < PIPELINE_LIMIT && ParseRequest(connection)) {}
+            Dispatch(connection);
+        }
+        Flush(connection);
+    }
+}
+
+bool AutomationServer::Loop::Deliver(Stream& stream, std::string_view data, bool done) {
+    bool signal;
+    bool stalled = false;
+    {
+        std::unique_lock lock(stream.mutex);
+        auto timeout = std::chrono::milliseconds(m_options.sendTimeoutMs);
+        while (!stream.drained.wait_for(lock, timeout, [&] {
+            return stream.abandoned || stream.buffer.size() < m_options.streamBufferLimit;
+        })) {
+            // A response queued behind a slow one may wait longer, as long
+            // as the client keeps reading
+            int64_t since = stream.blockedSince->load();
+            if (since != 0 && NowMilliseconds() - since >= static_cast<int64_t>(m_options.sendTimeoutMs)) {
+                stream.abandoned = true;
+                stalled = true;
+                break;
+            }
+        }
+        if (stream.abandoned) {
+            lock.unlock();
+            if (stalled) Post(stream.connection, nullptr, true);
+            return false;
+        }
+        stream.buffer.append(data);
+        if (done) stream.done = true;
+        signal = !stream.signalled && !done;
+        stream.signalled = true;
+    }
+    if (signal) Post(stream.connection, nullptr);
+    return true;
+}
+
+void AutomationServer::Loop::WorkerLoop(std::stop_token stopToken) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(m_taskMutex);
+            if (!m_taskReady.wait(lock, stopToken, [this] { return !m_tasks.empty(); })) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        Execute(task);
+        Post(task.stream->connection, task.stream);
+    }
+}
+
+void AutomationServer::Loop::Execute(Task& task) {
+    Request& request = task.request;
+    ResponseWriter out(*this, *task.stream, request.keepAlive);
+    Operations operations(m_backend, m_options.allowWrites, out);
+
+    if (request.path == "/v1/batch") {
+        uint64_t index = 0;
+        for (const BatchLine& line : request.batch) {
+            if (!out.Ok()) break;
+            std::string id = std::to_string(index++);
+            if (!line.error.empty()) {
+                out.Error(id, line.error.c_str());
+                continue;
+            }
+            const Fields& fields = line.fields;
+            if (const JsonField* given = fields.Find("id")) {
+                id.clear();
+                if (given->kind == JsonField::Kind::String) AppendJsonString(id, given->text);
+                else if (given->kind == JsonField::Kind::Number) id.assign(given->text.begin(), given->text.end());
+                else id = "null";
+            }
+            operations.Run(fields, id);
+            m_operations.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        // The op comes from the path. It is added first, so it shadows any
+        // "op" in the query string.
+        Fields fields;
+        std::wstring op;
+        bool parsed = DecodeUtf8(std::string_view(request.path).substr(4), op);
+        JsonField& field = fields.Add("op");
+        field.kind = JsonField::Kind::String;
+        field.text = op;
+        if (!parsed || !ParseQuery(request.query, fields)) {
+            out.Error("0", "malformed query string");
+        } else {
+            operations.Run(fields, "0");
+            m_operations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    out.Finish();
+}
+
+AutomationServer::AutomationServer(RegistryBackend& backend) : m_backend(backend) {}
+
+AutomationServer::~AutomationServer() {
+    Stop();
+}
+
+bool AutomationServer::Start(const AutomationServerOptions& options) {
+    Stop();
+    m_error.clear();
+    m_loop = std::make_unique<Loop>(m_backend, options);
+    if (!m_loop->Start(m_error)) {
+        m_loop.reset();
+        return false;
+    }
+    return true;
+}
+
+void AutomationServer::Stop() {
+    m_loop.reset();
+}
+
+bool AutomationServer::IsRunning() const {
+    return m_loop && m_loop->IsRunning();
+}
+
+uint16_t AutomationServer::Port() const {
+    return m_loop ? m_loop->Port() : 0;
+}
+
+std::string AutomationServer::Token() const {
+    return m_loop ? m_loop->Token() : std::string();
+}
+
+AutomationServerStats AutomationServer::GetStats() const {
+    return m_loop ? m_loop->GetStats() : AutomationServerStats{};
+}
+
+} // namespace core
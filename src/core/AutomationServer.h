@@ -0,0 +1,96 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Local automation server for scripts and CI. Speaks HTTP/1.1 with
+ * keep-alive and pipelining on a loopback TCP port (or a Unix socket on
+ * POSIX). One I/O thread runs the event loop (epoll on Linux, poll
+ * elsewhere); registry work runs on a worker pool. Results are streamed
+ * as chunked NDJSON, so large enumerations never sit in memory whole.
+ *
+ * Requests:
+ *   GET  /v1/<op>?path=...&name=...    One read-only operation
+ *   POST /v1/batch                      NDJSON body, one operation per line
+ *
+ * Operations ("op" field, other fields as named):
+ *   query   path [name]                 One value, or all values of the key
+ *   enum    path [recursive] [values]   One line per subkey (values inline if asked)
+ *   search  path text [keys] [values] [data] [limit]
+ *   diff    path other                  Changes from path to other, one line each
+ *   write   path name type data|hex     Creates the key if needed (allowWrites only)
+ *   delete  path [name] [recursive]     A value, or a key (allowWrites only)
+ *   ping
+ *
+ * Every result line carries the operation's "id" (the request's own id if
+ * given, else its index in the batch). Operations that produce many lines
+ * end with {"id":..,"done":true,"count":N}; failures are {"id":..,"error":".."}.
+ * Requests on one connection that contain writes run alone and in order;
+ * read-only requests may run concurrently, with responses still in order.
+ *
+ * Every request needs "Authorization: Bearer <token>", with the random
+ * token Start generates (see Token() and tokenFile). Requests with an
+ * Origin header, or over TCP with a Host other than 127.0.0.1:<port> or
+ * localhost:<port>, are refused, so web pages cannot reach the server
+ * through a browser; batches must be sent as application/json.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace core {
+
+struct AutomationServerOptions {
+    std::string address = "127.0.0.1";     // Must be a loopback address
+    uint16_t port = 0;                      // 0 = any free port, see Port()
+    std::string unixSocket;                 // POSIX only: listen on this path instead
+    unsigned workerCount = 0;               // 0 = one per hardware thread
+    bool allowWrites = false;               // Accept write and delete operations
+    size_t maxRequestBytes = 16u << 20;     // Body of one request; headers have a fixed 64 KB limit
+    size_t streamBufferLimit = 1u << 20;    // Unsent bytes per response before its worker waits
+    uint32_t sendTimeoutMs = 30000;         // Close a connection whose client takes no output this long
+    std::filesystem::path tokenFile;        // Written with the token, readable by the user only; removed on Stop
+};
+
+struct AutomationServerStats {
+    uint64_t connections = 0;
+    uint64_t requests = 0;
+    uint64_t operations = 0;
+    uint64_t bytesSent = 0;
+};
+
+class AutomationServer {
+public:
+    explicit AutomationServer(RegistryBackend& backend);
+    ~AutomationServer();
+
+    AutomationServer(const AutomationServer&) = delete;
+    AutomationServer& operator=(const AutomationServer&) = delete;
+
+    // Bind and start the I/O thread and workers
+    bool Start(const AutomationServerOptions& options = {});
+
+    // Close all connections and wait for the workers
+    void Stop();
+
+    bool IsRunning() const;
+    uint16_t Port() const;                  // Bound TCP port
+    std::string Token() const;              // Bearer token of this run
+    AutomationServerStats GetStats() const;
+    const std::wstring& Error() const { return m_error; }
+
+private:
+    class Loop;
+
+    RegistryBackend& m_backend;
+    std::unique_ptr<Loop> m_loop;
+    std::wstring m_error;
+};
+
+} // namespace core
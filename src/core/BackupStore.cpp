@@ -0,0 +1,1028 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Content-addressed backup store: Merkle tree build over a parallel key
+ * walk, pack files, manifests, streaming restore and garbage collection.
+ */
+
+#include "BackupStore.h"
+#include "HiveFormat.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+#include <unordered_set>
+
+namespace core {
+
+using hive::ReadU16;
+using hive::ReadU32;
+using hive::ReadU64;
+using hive::WriteU16;
+using hive::WriteU32;
+using hive::WriteU64;
+
+namespace {
+
+constexpr uint32_t PACK_MAGIC = 0x4B505352;         // "RSPK"
+constexpr uint32_t INDEX_MAGIC = 0x58505352;        // "RSPX"
+constexpr uint32_t MANIFEST_MAGIC = 0x4D425352;     // "RSBM"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+constexpr size_t PACK_HEADER_SIZE = 8;              // Magic, version
+constexpr size_t RECORD_HEADER_SIZE = 36;           // Hash, size
+constexpr size_t INDEX_HEADER_SIZE = 20;            // Magic, version, count, pack size
+constexpr size_t INDEX_ENTRY_SIZE = 40;             // Hash, offset, size
+constexpr uint64_t PACK_LIMIT = 64ull << 20;        // Start a new pack beyond this
+
+// Objects. A key lists its subkeys as name + hash pairs, so its hash
+// covers the whole subtree; its values live in a separate object so an
+// unchanged value set is shared even when the subkeys change.
+//   Key:    kind, pad[3], lastWriteTime, valueCount, childCount, valuesHash,
+//           { u16 nameLength, name (UTF-16LE), hash } per subkey
+//   Values: kind, pad[3], count, { u16 nameLength, type, size, name, data } per value
+constexpr uint8_t OBJECT_KEY = 1;
+constexpr uint8_t OBJECT_VALUES = 2;
+constexpr size_t KEY_HEADER_SIZE = 52;
+constexpr size_t VALUES_HEADER_SIZE = 8;
+
+constexpr double GARBAGE_REWRITE_RATIO = 0.25;      // Rewrite packs at least this dead
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::wstring PackName(uint32_t number, const wchar_t* extension) {
+    std::wstring name(8, L'0');
+    for (int i = 7; i >= 0; i--, number /= 10) name[i] = static_cast<wchar_t>(L'0' + number % 10);
+    return name + extension;
+}
+
+bool ParsePackName(const std::filesystem::path& path, uint32_t& number) {
+    std::wstring stem = path.stem().wstring();
+    if (stem.size() != 8) return false;
+    number = 0;
+    for (wchar_t c : stem) {
+        if (c < L'0' || c > L'9') return false;
+        number = number * 10 + (c - L'0');
+    }
+    return number != 0;
+}
+
+std::wstring BackupId(uint64_t created) {
+    static constexpr wchar_t DIGITS[] = L"0123456789ABCDEF";
+    std::wstring id(16, L'0');
+    for (int i = 15; i >= 0; i--, created >>= 4) id[i] = DIGITS[created & 0xF];
+    return id;
+}
+
+void AppendName(std::vector<uint8_t>& out, std::wstring_view name) {
+    size_t offset = out.size();
+    out.resize(offset + 2 + name.size() * 2);
+    WriteU16(out.data() + offset, static_cast<uint16_t>(name.size()));
+    for (size_t i = 0; i < name.size(); i++) WriteU16(out.data() + offset + 2 + i * 2, static_cast<uint16_t>(name[i]));
+}
+
+// Name stored as UTF-16LE at p (not necessarily aligned)
+void ReadName(const uint8_t* p, size_t length, std::wstring& name) {
+    name.resize(length);
+    for (size_t i = 0; i < length; i++) name[i] = static_cast<wchar_t>(ReadU16(p + i * 2));
+}
+
+bool IsZero(const ObjectHash& hash) {
+    return std::all_of(hash.begin(), hash.end(), [](uint8_t b) { return b == 0; });
+}
+
+// Bounds-checked view of a key object
+struct KeyObject {
+    uint64_t lastWriteTime = 0;
+    uint32_t valueCount = 0;
+    uint32_t childCount = 0;
+    ObjectHash values{};
+    std::span<const uint8_t> children;      // Encoded subkey entries
+
+    bool Parse(std::span<const uint8_t> object) {
+        if (object.size() < KEY_HEADER_SIZE || object[0] != OBJECT_KEY) return false;
+        lastWriteTime = ReadU64(object.data() + 4);
+        valueCount = ReadU32(object.data() + 12);
+        childCount = ReadU32(object.data() + 16);
+        std::memcpy(values.data(), object.data() + 20, values.size());
+        children = object.subspan(KEY_HEADER_SIZE);
+        return true;
+    }
+};
+
+// Whether a values object holds exactly these names, types and sizes.
+// Reads only the entry headers and names, never the data.
+bool SameValueSummaries(std::span<const uint8_t> object, std::vector<ValueSummary>& summaries) {
+    if (object.size() < VALUES_HEADER_SIZE || object[0] != OBJECT_VALUES ||
+        ReadU32(object.data() + 4) != summaries.size()) {
+        return false;
+    }
+    std::sort(summaries.begin(), summaries.end(),
+              [](const ValueSummary& a, const ValueSummary& b) { return CompareNames(a.name, b.name) < 0; });
+
+    size_t offset = VALUES_HEADER_SIZE;
+    for (const ValueSummary& summary : summaries) {
+        if (object.size() - offset < 10) return false;
+        const uint8_t* p = object.data() + offset;
+        size_t length = ReadU16(p);
+        uint32_t size = ReadU32(p + 6);
+        if (length != summary.name.size() || ReadU32(p + 2) != summary.type || size != summary.dataSize) return false;
+        if (object.size() - offset - 10 < length * 2 + size) return false;
+        for (size_t i = 0; i < length; i++) {
+            if (ReadU16(p + 10 + i * 2) != static_cast<uint16_t>(summary.name[i])) return false;
+        }
+        offset += 10 + length * 2 + size;
+    }
+    return true;
+}
+
+// Steps through the subkey entries of a key object
+class ChildCursor {
+public:
+    explicit ChildCursor(const KeyObject& key) : m_data(key.children), m_remaining(key.childCount) {}
+
+    // False at the end or on a malformed entry
+    bool Next(std::wstring& name, ObjectHash& hash) {
+        if (m_remaining == 0 || m_data.size() - m_offset < 2) return false;
+        size_t length = ReadU16(m_data.data() + m_offset);
+        size_t size = 2 + length * 2 + hash.size();
+        if (m_data.size() - m_offset < size) return false;
+        ReadName(m_data.data() + m_offset + 2, length, name);
+        std::memcpy(hash.data(), m_data.data() + m_offset + 2 + length * 2, hash.size());
+        m_offset += size;
+        m_remaining--;
+        return true;
+    }
+
+private:
+    std::span<const uint8_t> m_data;
+    size_t m_offset = 0;
+    uint32_t m_remaining;
+};
+
+bool DecodeValues(std::span<const uint8_t> object, std::vector<RegValue>& values) {
+    values.clear();
+    if (object.size() < VALUES_HEADER_SIZE || object[0] != OBJECT_VALUES) return false;
+    uint32_t count = ReadU32(object.data() + 4);
+    size_t offset = VALUES_HEADER_SIZE;
+    for (uint32_t i = 0; i < count; i++) {
+        if (object.size() - offset < 10) return false;
+        size_t length = ReadU16(object.data() + offset);
+        uint32_t type = ReadU32(object.data() + offset + 2);
+        uint32_t size = ReadU32(object.data() + offset + 6);
+        offset += 10;
+        if (object.size() - offset < length * 2 + size) return false;
+
+        RegValue& value = values.emplace_back();
+        ReadName(object.data() + offset, length, value.name);
+        value.type = type;
+        value.data.assign(object.data() + offset + length * 2, object.data() + offset + length * 2 + size);
+        offset += length * 2 + size;
+    }
+    return offset == object.size();
+}
+
+// A key whose subkeys are still being hashed. Each subkey fills its slot;
+// whoever completes the last one (or the key itself) writes the key object.
+struct PendingKey {
+    struct Child {
+        std::wstring name;
+        ObjectHash hash{};
+        bool present = false;           // False if the subkey could not be read
+    };
+
+    std::shared_ptr<PendingKey> parent;
+    uint32_t slot = 0;
+    uint32_t root = 0;                  // Source index
+    uint64_t lastWriteTime = 0;
+    uint32_t valueCount = 0;
+    ObjectHash values{};
+    std::vector<Child> children;
+    std::atomic<uint32_t> remaining{1};
+};
+
+struct BackupItem {
+    std::shared_ptr<const RegistryKey> parentKey;
+    std::shared_ptr<const RegistryKey> key;         // Set for roots only
+    std::shared_ptr<PendingKey> parent;
+    uint32_t slot = 0;
+    uint32_t root = 0;
+    ObjectHash previous{};                          // Same key in the previous backup
+    bool hasPrevious = false;
+};
+
+} // namespace
+
+// Builds the object tree of one backup
+class BackupWriter {
+public:
+    BackupWriter(BackupStore& store, const BackupOptions& options, size_t rootCount, unsigned shardCount)
+        : m_store(store), m_options(options), m_roots(rootCount), m_shards(shardCount) {}
+
+    void Process(BackupItem& item, std::vector<BackupItem>& out, unsigned worker) {
+        BackupStats& stats = m_shards[worker].stats;
+        std::shared_ptr<const RegistryKey> key = item.key;
+        if (!key) key = item.parentKey->OpenSubKey(item.parent->children[item.slot].name);
+        KeyInfo info;
+        if (!key || !key->QueryInfo(info)) {
+            stats.errors++;
+            if (item.parent) Complete(item.parent, worker);
+            return;
+        }
+        stats.keys++;
+        m_shards[worker].rootKeys[item.root]++;
+
+        auto pending = std::make_shared<PendingKey>();
+        pending->parent = item.parent;
+        pending->slot = item.slot;
+        pending->root = item.root;
+        pending->lastWriteTime = info.lastWriteTime;
+
+        KeyObject previous;
+        bool hasPrevious = item.hasPrevious && ReadKey(item.previous, previous);
+
+        // Values: reuse the previous set if the key has not been written
+        // since and its value names, types and sizes still match. Not every
+        // backend moves the last-write time on each change (memory and
+        // layered keys may not within one clock tick), and the check reads
+        // no data.
+        bool reuse = m_options.incremental && hasPrevious && previous.lastWriteTime == info.lastWriteTime &&
+                     previous.valueCount == info.valueCount;
+        std::span<const uint8_t> previousValues;
+        if (reuse && previous.valueCount) {
+            if (!m_store.Get(previous.values, previousValues)) return Abort(L"Missing object in the previous backup");
+            thread_local std::vector<ValueSummary> summaries;
+            key->GetValueSummaries(summaries);
+            reuse = SameValueSummaries(previousValues, summaries);
+        }
+        if (reuse) {
+            pending->valueCount = previous.valueCount;
+            pending->values = previous.values;
+            if (previous.valueCount) Count(stats, previousValues.size(), false);
+            stats.values += previous.valueCount;
+            m_shards[worker].rootValues[item.root] += previous.valueCount;
+            stats.reusedKeys++;
+        } else {
+            thread_local std::vector<RegValue> values;
+            key->GetValues(values);
+            pending->valueCount = static_cast<uint32_t>(values.size());
+            if (!values.empty() && !StoreValues(values, pending->values, stats)) return;
+            stats.values += values.size();
+            m_shards[worker].rootValues[item.root] += values.size();
+        }
+
+        // Subkeys, matched by name against the previous key's (both sorted)
+        thread_local std::vector<std::wstring> names;
+        key->GetSubKeyNames(names);
+        std::sort(names.begin(), names.end(),
+                  [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; });
+        pending->children.resize(names.size());
+        pending->remaining.store(static_cast<uint32_t>(names.size()) + 1, std::memory_order_relaxed);
+
+        ChildCursor cursor(previous);
+        thread_local std::wstring previousName;
+        ObjectHash previousHash{};
+        bool cursorValid = hasPrevious && cursor.Next(previousName, previousHash);
+        for (uint32_t i = 0; i < names.size(); i++) {
+            BackupItem child;
+            child.parentKey = key;
+            child.parent = pending;
+            child.slot = i;
+            child.root = item.root;
+            while (cursorValid && CompareNames(previousName, names[i]) < 0) {
+                cursorValid = cursor.Next(previousName, previousHash);
+            }
+            if (cursorValid && NamesEqual(previousName, names[i])) {
+                child.previous = previousHash;
+                child.hasPrevious = true;
+            }
+            pending->children[i].name = std::move(names[i]);
+            out.push_back(std::move(child));
+        }
+        Complete(pending, worker);
+    }
+
+    const std::vector<ObjectHash>& Roots() const { return m_roots; }
+    bool Failed() const { return m_failed.load(); }
+    std::stop_token Token() const { return m_abort.get_token(); }
+    std::stop_source& AbortSource() { return m_abort; }
+
+    void Merge(BackupStats& stats, std::vector<BackupRoot>& roots) const {
+        for (const Shard& shard : m_shards) {
+            stats.keys += shard.stats.keys;
+            stats.values += shard.stats.values;
+            stats.reusedKeys += shard.stats.reusedKeys;
+            stats.objects += shard.stats.objects;
+            stats.newObjects += shard.stats.newObjects;
+            stats.logicalBytes += shard.stats.logicalBytes;
+            stats.writtenBytes += shard.stats.writtenBytes;
+            stats.errors += shard.stats.errors;
+            for (size_t r = 0; r < roots.size(); r++) {
+                roots[r].keys += shard.rootKeys[r];
+                roots[r].values += shard.rootValues[r];
+            }
+        }
+    }
+
+    void PrepareShards() {
+        for (Shard& shard : m_shards) {
+            shard.rootKeys.assign(m_roots.size(), 0);
+            shard.rootValues.assign(m_roots.size(), 0);
+        }
+    }
+
+    std::wstring Error() const {
+        std::lock_guard lock(m_errorMutex);
+        return m_error;
+    }
+
+private:
+    struct Shard {
+        BackupStats stats;
+        std::vector<uint64_t> rootKeys;
+        std::vector<uint64_t> rootValues;
+    };
+
+    bool ReadKey(const ObjectHash& hash, KeyObject& key) {
+        std::span<const uint8_t> object;
+        return m_store.Get(hash, object) && key.Parse(object);
+    }
+
+    void Count(BackupStats& stats, size_t size, bool added) {
+        stats.objects++;
+        stats.logicalBytes += size;
+        if (added) {
+            stats.newObjects++;
+            stats.writtenBytes += RECORD_HEADER_SIZE + size;
+        }
+    }
+
+    bool StoreValues(std::vector<RegValue>& values, ObjectHash& hash, BackupStats& stats) {
+        std::sort(values.begin(), values.end(),
+                  [](const RegValue& a, const RegValue& b) { return CompareNames(a.name, b.name) < 0; });
+
+        thread_local std::vector<uint8_t> object;
+        object.assign(VALUES_HEADER_SIZE, 0);
+        object[0] = OBJECT_VALUES;
+        WriteU32(object.data() + 4, static_cast<uint32_t>(values.size()));
+        for (const RegValue& value : values) {
+            size_t offset = object.size();
+            object.resize(offset + 10 + value.name.size() * 2 + value.data.size());
+            uint8_t* p = object.data() + offset;
+            WriteU16(p, static_cast<uint16_t>(value.name.size()));
+            WriteU32(p + 2, value.type);
+            WriteU32(p + 6, static_cast<uint32_t>(value.data.size()));
+            for (size_t i = 0; i < value.name.size(); i++) WriteU16(p + 10 + i * 2, static_cast<uint16_t>(value.name[i]));
+            if (!value.data.empty()) std::memcpy(p + 10 + value.name.size() * 2, value.data.data(), value.data.size());
+        }
+        return Store(object, hash, stats);
+    }
+
+    bool Store(std::span<const uint8_t> object, ObjectHash& hash, BackupStats& stats) {
+        hash = Sha256::Hash(object.data(), object.size());
+        bool added = false;
+        if (!m_store.Put(hash, object, added)) {
+            Abort(m_store.Error());
+            return false;
+        }
+        Count(stats, object.size(), added);
+        return true;
+    }
+
+    // One fewer outstanding part of key; the last one writes the key object
+    // and moves on to the parent
+    void Complete(std::shared_ptr<PendingKey> key, unsigned worker) {
+        while (key && key->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            thread_local std::vector<uint8_t> object;
+            object.assign(KEY_HEADER_SIZE, 0);
+            object[0] = OBJECT_KEY;
+            WriteU64(object.data() + 4, key->lastWriteTime);
+            WriteU32(object.data() + 12, key->valueCount);
+            std::memcpy(object.data() + 20, key->values.data(), key->values.size());
+            uint32_t childCount = 0;
+            for (const PendingKey::Child& child : key->children) {
+                if (!child.present) continue;
+                AppendName(object, child.name);
+                object.insert(object.end(), child.hash.begin(), child.hash.end());
+                childCount++;
+            }
+            WriteU32(object.data() + 16, childCount);
+
+            ObjectHash hash;
+            if (!Store(object, hash, m_shards[worker].stats)) return;
+            if (!key->parent) {
+                m_roots[key->root] = hash;
+                return;
+            }
+            PendingKey::Child& slot = key->parent->children[key->slot];
+            slot.hash = hash;
+            slot.present = true;
+            key = key->parent;
+        }
+    }
+
+    void Abort(std::wstring message) {
+        {
+            std::lock_guard lock(m_errorMutex);
+            if (m_error.empty()) m_error = std::move(message);
+        }
+        m_failed.store(true);
+        m_abort.request_stop();
+    }
+
+    BackupStore& m_store;
+    const BackupOptions& m_options;
+    std::vector<ObjectHash> m_roots;
+    std::vector<Shard> m_shards;
+    std::stop_source m_abort;
+    std::atomic<bool> m_failed{false};
+    mutable std::mutex m_errorMutex;
+    std::wstring m_error;
+};
+
+BackupStore::~BackupStore() {
+    Close();
+}
+
+bool BackupStore::Fail(std::wstring message) {
+    m_error = std::move(message);
+    return false;
+}
+
+bool BackupStore::Open(const std::filesystem::path& directory) {
+    Close();
+    std::error_code error;
+    std::filesystem::create_directories(directory / L"packs", error);
+    if (error) return Fail(L"Cannot create the backup store directory");
+    std::filesystem::create_directories(directory / L"backups", error);
+    if (error) return Fail(L"Cannot create the backup store directory");
+    m_directory = directory;
+
+    std::vector<uint32_t> numbers;
+    for (const auto& entry : std::filesystem::directory_iterator(directory / L"packs", error)) {
+        uint32_t number;
+        if (entry.path().extension() == L".pack" && ParsePackName(entry.path(), number)) numbers.push_back(number);
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    for (uint32_t number : numbers) {
+        if (!LoadPack(number) && !ReindexPack(number)) {
+            Close();
+            return false;
+        }
+        m_nextPack = number + 1;
+    }
+    return true;
+}
+
+void BackupStore::Close() {
+    if (m_active.is_open()) SealPack();
+    m_index.clear();
+    m_packs.clear();
+    m_nextPack = 1;
+    m_directory.clear();
+}
+
+bool BackupStore::LoadPack(uint32_t number) {
+    std::filesystem::path packs = m_directory / L"packs";
+    MappedFile index;
+    if (!index.Open(packs / PackName(number, L".idx"))) return false;
+    const uint8_t* data = index.Data();
+    if (index.Size() < INDEX_HEADER_SIZE || ReadU32(data) != INDEX_MAGIC || ReadU32(data + 4) != FORMAT_VERSION) {
+        return false;
+    }
+    uint32_t count = ReadU32(data + 8);
+    uint64_t packSize = ReadU64(data + 12);
+    std::error_code error;
+    if (index.Size() != INDEX_HEADER_SIZE + uint64_t{count} * INDEX_ENTRY_SIZE ||
+        std::filesystem::file_size(packs / PackName(number, L".pack"), error) != packSize) {
+        return false;
+    }
+
+    m_index.reserve(m_index.size() + count);
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* entry = data + INDEX_HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        ObjectHash hash;
+        std::memcpy(hash.data(), entry, hash.size());
+        m_index.try_emplace(hash, Location{ number, ReadU32(entry + 32), ReadU32(entry + 36) });
+    }
+    m_packs.push_back({ number, packSize, nullptr });
+    return true;
+}
+
+bool BackupStore::ReindexPack(uint32_t number) {
+    std::filesystem::path path = m_directory / L"packs" / PackName(number, L".pack");
+    std::vector<std::pair<ObjectHash, Location>> entries;
+    uint64_t valid = 0;
+    {
+        MappedFile pack;
+        if (!pack.Open(path)) return Fail(L"Cannot read pack " + path.filename().wstring());
+        const uint8_t* data = pack.Data();
+        size_t size = pack.Size();
+        if (size < PACK_HEADER_SIZE || ReadU32(data) != PACK_MAGIC || ReadU32(data + 4) != FORMAT_VERSION) {
+            return Fail(L"Invalid pack " + path.filename().wstring());
+        }
+
+        // Keep every complete record whose contents match its hash; a torn
+        // write can only affect the tail
+        size_t offset = PACK_HEADER_SIZE;
+        valid = offset;
+        while (size - offset >= RECORD_HEADER_SIZE) {
+            uint32_t objectSize = ReadU32(data + offset + 32);
+            if (size - offset - RECORD_HEADER_SIZE < objectSize) break;
+            ObjectHash hash;
+            std::memcpy(hash.data(), data + offset, hash.size());
+            if (Sha256::Hash(data + offset + RECORD_HEADER_SIZE, objectSize) != hash) break;
+            entries.push_back({ hash, Location{ number, static_cast<uint32_t>(offset + RECORD_HEADER_SIZE), objectSize } });
+            offset += RECORD_HEADER_SIZE + objectSize;
+            valid = offset;
+        }
+    }
+
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) != valid) std::filesystem::resize_file(path, valid, error);
+    if (error) return Fail(L"Cannot repair pack " + path.filename().wstring());
+    if (!WriteIndex(number, entries)) return false;
+    for (const auto& [hash, location] : entries) m_index.try_emplace(hash, location);
+    m_packs.push_back({ number, valid, nullptr });
+    return true;
+}
+
+bool BackupStore::WriteIndex(uint32_t number, std::vector<std::pair<ObjectHash, Location>>& entries) {
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::filesystem::path packs = m_directory / L"packs";
+    std::error_code error;
+    uint64_t packSize = std::filesystem::file_size(packs / PackName(number, L".pack"), error);
+    if (error) return Fail(L"Cannot read pack " + PackName(number, L".pack"));
+
+    std::vector<uint8_t> image(INDEX_HEADER_SIZE + entries.size() * INDEX_ENTRY_SIZE);
+    WriteU32(image.data(), INDEX_MAGIC);
+    WriteU32(image.data() + 4, FORMAT_VERSION);
+    WriteU32(image.data() + 8, static_cast<uint32_t>(entries.size()));
+    WriteU64(image.data() + 12, packSize);
+    for (size_t i = 0; i < entries.size(); i++) {
+        uint8_t* entry = image.data() + INDEX_HEADER_SIZE + i * INDEX_ENTRY_SIZE;
+        std::memcpy(entry, entries[i].first.data(), entries[i].first.size());
+        WriteU32(entry + 32, entries[i].second.offset);
+        WriteU32(entry + 36, entries[i].second.size);
+    }
+
+    // The index only appears once complete; until then Open() reindexes the pack
+    std::filesystem::path path = packs / PackName(number, L".idx");
+    std::filesystem::path temporary = path;
+    temporary += L".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file) return Fail(L"Cannot write pack index");
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) return Fail(L"Cannot write pack index");
+    return true;
+}
+
+bool BackupStore::BeginPack() {
+    m_activeNumber = m_nextPack++;
+    m_activeSize = PACK_HEADER_SIZE;
+    m_activeEntries.clear();
+    m_active.open(m_directory / L"packs" / PackName(m_activeNumber, L".pack"), std::ios::binary | std::ios::trunc);
+    uint8_t header[PACK_HEADER_SIZE];
+    WriteU32(header, PACK_MAGIC);
+    WriteU32(header + 4, FORMAT_VERSION);
+    m_active.write(reinterpret_cast<const char*>(header), sizeof(header));
+    if (!m_active) {
+        m_active.close();
+        return Fail(L"Cannot create pack " + PackName(m_activeNumber, L".pack"));
+    }
+    return true;
+}
+
+bool BackupStore::SealPack() {
+    m_active.flush();
+    bool written = static_cast<bool>(m_active);
+    m_active.close();
+    if (!written) return Fail(L"Cannot write pack " + PackName(m_activeNumber, L".pack"));
+    if (!WriteIndex(m_activeNumber, m_activeEntries)) return false;
+    m_packs.push_back({ m_activeNumber, m_activeSize, nullptr });
+    m_activeEntries.clear();
+    return true;
+}
+
+bool BackupStore::Put(const ObjectHash& hash, std::span<const uint8_t> object, bool& added) {
+    added = false;
+    std::lock_guard lock(m_mutex);
+    if (m_index.contains(hash)) return true;
+    if (object.size() > UINT32_MAX - PACK_LIMIT) return Fail(L"Object too large");
+
+    if (m_active.is_open() && m_activeSize + RECORD_HEADER_SIZE + object.size() > PACK_LIMIT &&
+        m_activeSize > PACK_HEADER_SIZE && !SealPack()) {
+        return false;
+    }
+    if (!m_active.is_open() && !BeginPack()) return false;
+
+    uint8_t size[4];
+    WriteU32(size, static_cast<uint32_t>(object.size()));
+    m_active.write(reinterpret_cast<const char*>(hash.data()), static_cast<std::streamsize>(hash.size()));
+    m_active.write(reinterpret_cast<const char*>(size), sizeof(size));
+    m_active.write(reinterpret_cast<const char*>(object.data()), static_cast<std::streamsize>(object.size()));
+    if (!m_active) return Fail(L"Cannot write pack " + PackName(m_activeNumber, L".pack"));
+
+    Location location{ m_activeNumber, static_cast<uint32_t>(m_activeSize + RECORD_HEADER_SIZE),
+                       static_cast<uint32_t>(object.size()) };
+    m_activeSize += RECORD_HEADER_SIZE + object.size();
+    m_activeEntries.push_back({ hash, location });
+    m_index.emplace(hash, location);
+    added = true;
+    return true;
+}
+
+bool BackupStore::Get(const ObjectHash& hash, std::span<const uint8_t>& object) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_index.find(hash);
+    if (it == m_index.end()) return false;
+    const Location& location = it->second;
+
+    auto pack = std::lower_bound(m_packs.begin(), m_packs.end(), location.pack,
+                                 [](const Pack& p, uint32_t number) { return p.number < number; });
+    if (pack == m_packs.end() || pack->number != location.pack) return false;  // Still being written
+    if (!pack->map) {
+        auto map = std::make_unique<MappedFile>();
+        if (!map->Open(m_directory / L"packs" / PackName(pack->number, L".pack"))) return false;
+        pack->map = std::move(map);
+    }
+    if (uint64_t{location.offset} + location.size > pack->map->Size()) return false;
+    object = { pack->map->Data() + location.offset, location.size };
+    return true;
+}
+
+bool BackupStore::ReadManifest(const std::filesystem::path& path, BackupInfo& info) const {
+    MappedFile file;
+    if (!file.Open(path)) return false;
+    std::span<const uint8_t> data(file.Data(), file.Size());
+    size_t offset = 0;
+    auto take = [&](size_t size) -> const uint8_t* {
+        if (data.size() - offset < size) return nullptr;
+        const uint8_t* p = data.data() + offset;
+        offset += size;
+        return p;
+    };
+    auto takeName = [&](std::wstring& name) {
+        const uint8_t* length = take(2);
+        const uint8_t* text = length ? take(ReadU16(length) * size_t{2}) : nullptr;
+        if (text) ReadName(text, ReadU16(length), name);
+        return text != nullptr;
+    };
+
+    const uint8_t* header = take(20);
+    if (!header || ReadU32(header) != MANIFEST_MAGIC || ReadU32(header + 4) != FORMAT_VERSION) return false;
+    info.id = path.stem().wstring();
+    info.created = ReadU64(header + 8);
+    uint32_t rootCount = ReadU32(header + 16);
+    if (!takeName(info.label)) return false;
+
+    info.roots.clear();
+    for (uint32_t i = 0; i < rootCount; i++) {
+        BackupRoot& root = info.roots.emplace_back();
+        const uint8_t* fixed = nullptr;
+        if (!takeName(root.path) || !(fixed = take(48))) return false;
+        std::memcpy(root.hash.data(), fixed, root.hash.size());
+        root.keys = ReadU64(fixed + 32);
+        root.values = ReadU64(fixed + 40);
+    }
+    return offset == data.size();
+}
+
+bool BackupStore::WriteManifest(const BackupInfo& info) {
+    std::vector<uint8_t> image(20);
+    WriteU32(image.data(), MANIFEST_MAGIC);
+    WriteU32(image.data() + 4, FORMAT_VERSION);
+    WriteU64(image.data() + 8, info.created);
+    WriteU32(image.data() + 16, static_cast<uint32_t>(info.roots.size()));
+    AppendName(image, std::wstring_view(info.label).substr(0, UINT16_MAX));
+    for (const BackupRoot& root : info.roots) {
+        AppendName(image, std::wstring_view(root.path).substr(0, UINT16_MAX));
+        size_t offset = image.size();
+        image.resize(offset + 48);
+        std::memcpy(image.data() + offset, root.hash.data(), root.hash.size());
+        WriteU64(image.data() + offset + 32, root.keys);
+        WriteU64(image.data() + offset + 40, root.values);
+    }
+
+    std::filesystem::path path = m_directory / L"backups" / (info.id + L".backup");
+    std::filesystem::path temporary = path;
+    temporary += L".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!file) return Fail(L"Cannot write the backup manifest");
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) return Fail(L"Cannot write the backup manifest");
+    return true;
+}
+
+bool BackupStore::ListBackups(std::vector<BackupInfo>& backups) const {
+    backups.clear();
+    if (!IsOpen()) return false;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory / L"backups", error)) {
+        if (entry.path().extension() != L".backup") continue;
+        BackupInfo info;
+        if (ReadManifest(entry.path(), info)) backups.push_back(std::move(info));
+    }
+    std::sort(backups.begin(), backups.end(), [](const BackupInfo& a, const BackupInfo& b) { return a.id < b.id; });
+    return !error;
+}
+
+bool BackupStore::CreateBackup(std::span<const BackupSource> sources, const BackupOptions& options,
+                               BackupInfo& info, BackupStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = {};
+    if (!IsOpen()) return Fail(L"The backup store is not open");
+
+    info = {};
+    info.label = options.label;
+    info.created = options.created ? options.created : CurrentFileTime();
+    while (std::filesystem::exists(m_directory / L"backups" / (BackupId(info.created) + L".backup"))) info.created++;
+    info.id = BackupId(info.created);
+
+    // The newest backup of each path seeds the incremental comparison
+    std::vector<BackupInfo> existing;
+    ListBackups(existing);
+
+    unsigned threadCount = options.threadCount ? options.threadCount : WorkQueue<BackupItem>::DefaultThreadCount();
+    BackupWriter writer(*this, options, sources.size(), threadCount);
+    writer.PrepareShards();
+    std::stop_callback forward(options.stopToken, [&writer] { writer.AbortSource().request_stop(); });
+    WorkQueue<BackupItem> queue(threadCount, writer.Token());
+
+    info.roots.resize(sources.size());
+    for (uint32_t r = 0; r < sources.size(); r++) {
+        if (!sources[r].key) return Fail(L"No key given for " + sources[r].path);
+        info.roots[r].path = sources[r].path;
+
+        BackupItem item;
+        item.key = std::shared_ptr<const RegistryKey>(sources[r].key, [](const RegistryKey*) {});
+        item.root = r;
+        for (auto backup = existing.rbegin(); backup != existing.rend() && !item.hasPrevious; ++backup) {
+            for (const BackupRoot& root : backup->roots) {
+                if (!NamesEqual(root.path, sources[r].path)) continue;
+                item.previous = root.hash;
+                item.hasPrevious = true;
+                break;
+            }
+        }
+        queue.Push(std::move(item));
+    }
+
+    queue.Run([&writer](BackupItem& item, std::vector<BackupItem>& out, unsigned worker) {
+        writer.Process(item, out, worker);
+    });
+    writer.Merge(stats, info.roots);
+
+    // Whatever was written stays in the store; unreferenced objects go at
+    // the next garbage collection
+    bool sealed = !m_active.is_open() || SealPack();
+    stats.seconds = SecondsSince(start);
+    if (writer.Failed()) {
+        std::wstring message = writer.Error();
+        if (!message.empty()) m_error = std::move(message);
+        return false;
+    }
+    if (!sealed) return false;
+    if (options.stopToken.stop_requested()) {
+        stats.cancelled = true;
+        return Fail(L"Backup cancelled");
+    }
+
+    for (uint32_t r = 0; r < sources.size(); r++) {
+        if (IsZero(writer.Roots()[r])) return Fail(L"Cannot read " + sources[r].path);
+        info.roots[r].hash = writer.Roots()[r];
+    }
+    if (!WriteManifest(info)) return false;
+    stats.seconds = SecondsSince(start);
+    return true;
+}
+
+bool BackupStore::Restore(const std::wstring& id, size_t rootIndex, RegistryKey& target,
+                          RestoreStats& stats, std::stop_token stopToken) {
+    auto start = std::chrono::steady_clock::now();
+    stats = {};
+    if (!IsOpen()) return Fail(L"The backup store is not open");
+    BackupInfo info;
+    if (!ReadManifest(m_directory / L"backups" / (id + L".backup"), info)) return Fail(L"Backup " + id + L" not found");
+    if (rootIndex >= info.roots.size()) return Fail(L"Backup " + id + L" has no such root");
+
+    // Objects are checked against their hash before anything is written
+    auto read = [this](const ObjectHash& hash, std::span<const uint8_t>& object) {
+        return Get(hash, object) && Sha256::Hash(object.data(), object.size()) == hash;
+    };
+    std::vector<RegValue> values;
+    auto apply = [&](const ObjectHash& hash, RegistryKey& key, KeyObject& object) {
+        std::span<const uint8_t> bytes;
+        if (!read(hash, bytes) || !object.Parse(bytes)) return false;
+        if (object.valueCount) {
+            if (!read(object.values, bytes) || !DecodeValues(bytes, values)) return false;
+            for (const RegValue& value : values) {
+                if (key.SetValue(value)) stats.values++;
+                else stats.errors++;
+            }
+        }
+        stats.keys++;
+        return true;
+    };
+
+    // Depth-first with an explicit stack: one key object per level in memory
+    struct Frame {
+        KeyObject object;
+        ChildCursor cursor;
+        KeyPtr key;                     // Null for the target itself
+        RegistryKey* target;
+    };
+    std::vector<Frame> stack;
+    KeyObject rootObject;
+    if (!apply(info.roots[rootIndex].hash, target, rootObject)) return Fail(L"Backup " + id + L" is damaged");
+    stack.push_back({ rootObject, ChildCursor(rootObject), nullptr, &target });
+
+    std::wstring name;
+    ObjectHash hash;
+    while (!stack.empty()) {
+        if (stopToken.stop_requested()) {
+            stats.cancelled = true;
+            stats.seconds = SecondsSince(start);
+            return Fail(L"Restore cancelled");
+        }
+        Frame& top = stack.back();
+        if (!top.cursor.Next(name, hash)) {
+            stack.pop_back();
+            continue;
+        }
+        KeyPtr child = top.target->CreateSubKey(name);
+        if (!child) {
+            stats.errors++;
+            continue;
+        }
+        KeyObject object;
+        if (!apply(hash, *child, object)) return Fail(L"Backup " + id + L" is damaged");
+        RegistryKey* childTarget = child.get();
+        stack.push_back({ object, ChildCursor(object), std::move(child), childTarget });
+    }
+    stats.seconds = SecondsSince(start);
+    return true;
+}
+
+bool BackupStore::DeleteBackup(const std::wstring& id) {
+    if (!IsOpen()) return Fail(L"The backup store is not open");
+    std::error_code error;
+    if (!std::filesystem::remove(m_directory / L"backups" / (id + L".backup"), error)) {
+        return Fail(L"Backup " + id + L" not found");
+    }
+    return true;
+}
+
+size_t BackupStore::ExpireBackups(uint64_t olderThan, size_t keepAtLeast) {
+    std::vector<BackupInfo> backups;
+    if (!ListBackups(backups)) return 0;
+    size_t removed = 0;
+    for (const BackupInfo& backup : backups) {
+        if (backups.size() - removed <= keepAtLeast || backup.created >= olderThan) break;
+        if (DeleteBackup(backup.id)) removed++;
+    }
+    return removed;
+}
+
+bool BackupStore::CollectGarbage(GarbageStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = {};
+    if (!IsOpen()) return Fail(L"The backup store is not open");
+    if (m_active.is_open() && !SealPack()) return false;
+
+    // Mark everything reachable from a manifest; shared subtrees are walked once
+    std::vector<BackupInfo> backups;
+    if (!ListBackups(backups)) return Fail(L"Cannot list backups");
+    std::unordered_set<ObjectHash, ObjectHashHasher> live;
+    std::vector<ObjectHash> pending;
+    for (const BackupInfo& backup : backups) {
+        for (const BackupRoot& root : backup.roots) pending.push_back(root.hash);
+        std::wstring name;
+        while (!pending.empty()) {
+            ObjectHash hash = pending.back();
+            pending.pop_back();
+            if (!live.insert(hash).second) continue;
+
+            std::span<const uint8_t> object;
+            KeyObject key;
+            if (!Get(hash, object) || !key.Parse(object)) {
+                return Fail(L"Backup " + backup.id + L" references a missing object");
+            }
+            if (key.valueCount) live.insert(key.values);
+            ChildCursor cursor(key);
+            ObjectHash child;
+            while (cursor.Next(name, child)) pending.push_back(child);
+        }
+    }
+
+    // Live bytes per pack
+    std::unordered_map<uint32_t, uint64_t> liveBytes;
+    for (const auto& [hash, location] : m_index) {
+        if (live.contains(hash)) {
+            liveBytes[location.pack] += RECORD_HEADER_SIZE + location.size;
+            stats.liveObjects++;
+        } else {
+            stats.deadObjects++;
+        }
+    }
+    std::unordered_set<uint32_t> retired;
+    for (const Pack& pack : m_packs) {
+        uint64_t used = liveBytes[pack.number];
+        uint64_t records = pack.size - PACK_HEADER_SIZE;
+        if (used == 0) {
+            retired.insert(pack.number);
+            stats.deletedPacks++;
+        } else if (records - used >= records * GARBAGE_REWRITE_RATIO) {
+            retired.insert(pack.number);
+            stats.rewrittenPacks++;
+        }
+    }
+    if (retired.empty()) {
+        stats.seconds = SecondsSince(start);
+        return true;
+    }
+
+    // Copy the live objects of retired packs into a new pack. The old packs
+    // stay mapped (and on disk) until the new one is sealed.
+    std::vector<std::pair<ObjectHash, std::span<const uint8_t>>> moved;
+    for (auto it = m_index.begin(); it != m_index.end();) {
+        if (!retired.contains(it->second.pack)) {
+            ++it;
+            continue;
+        }
+        std::span<const uint8_t> object;
+        if (live.contains(it->first)) {
+            if (!Get(it->first, object)) return Fail(L"Cannot read pack " + PackName(it->second.pack, L".pack"));
+            moved.push_back({ it->first, object });
+        }
+        it = m_index.erase(it);
+    }
+    std::sort(moved.begin(), moved.end(), [](const auto& a, const auto& b) { return a.second.data() < b.second.data(); });
+
+    uint64_t before = 0;
+    for (const Pack& pack : m_packs) before += pack.size;
+    bool copied = true;
+    for (const auto& [hash, object] : moved) {
+        bool added;
+        if (!Put(hash, object, added)) {
+            copied = false;
+            break;
+        }
+    }
+    if (copied && m_active.is_open()) copied = SealPack();
+    if (!copied) {
+        // Nothing was removed yet; reload the store as it is on disk
+        std::wstring message = m_error;
+        std::filesystem::path directory = m_directory;
+        Open(directory);
+        return Fail(message);
+    }
+
+    std::filesystem::path packs = m_directory / L"packs";
+    std::error_code error;
+    for (auto it = m_packs.begin(); it != m_packs.end();) {
+        if (!retired.contains(it->number)) {
+            ++it;
+            continue;
+        }
+        std::wstring number = PackName(it->number, L"");
+        it = m_packs.erase(it);         // Unmaps the pack before it is removed
+        std::filesystem::remove(packs / (number + L".idx"), error);
+        std::filesystem::remove(packs / (number + L".pack"), error);
+    }
+    uint64_t after = 0;
+    for (const Pack& pack : m_packs) after += pack.size;
+    stats.freedBytes = before - after;
+    stats.seconds = SecondsSince(start);
+    return true;
+}
+
+StoreStats BackupStore::GetStats() const {
+    StoreStats stats;
+    std::lock_guard lock(m_mutex);
+    stats.packs = static_cast<uint32_t>(m_packs.size());
+    stats.objects = m_index.size();
+    for (const Pack& pack : m_packs) stats.bytes += pack.size;
+    if (!IsOpen()) return stats;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory / L"backups", error)) {
+        if (entry.path().extension() == L".backup") stats.backups++;
+    }
+    return stats;
+}
+
+} // namespace core
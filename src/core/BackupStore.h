@@ -0,0 +1,209 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Content-addressed, deduplicating backup store. Every key is serialized
+ * canonically (values sorted by name, subkeys as name + hash pairs) and
+ * stored once under the SHA-256 of its bytes, so a key's hash covers its
+ * whole subtree and unchanged subtrees are shared between backups. Objects
+ * are appended to pack files; a backup is a small manifest of root hashes.
+ *
+ * Layout of the store directory:
+ *   packs\NNNNNNNN.pack     Records: hash, size, object bytes
+ *   packs\NNNNNNNN.idx      Sorted hash -> offset table, written when the pack is sealed
+ *   backups\<id>.backup     Manifest: creation time, label, roots
+ *
+ * A store is used by one process at a time; its methods must not be called
+ * concurrently.
+ */
+
+#pragma once
+
+#include "MappedFile.h"
+#include "RegistryBackend.h"
+#include "Sha256.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+using ObjectHash = Sha256Digest;
+
+struct ObjectHashHasher {
+    size_t operator()(const ObjectHash& hash) const {
+        size_t value;
+        std::memcpy(&value, hash.data(), sizeof(value));  // Already uniformly distributed
+        return value;
+    }
+};
+
+// A key tree to back up. path is only recorded (e.g. "HKEY_CURRENT_USER").
+struct BackupSource {
+    std::wstring path;
+    const RegistryKey* key = nullptr;
+};
+
+struct BackupRoot {
+    std::wstring path;
+    ObjectHash hash{};
+    uint64_t keys = 0;
+    uint64_t values = 0;
+};
+
+struct BackupInfo {
+    std::wstring id;                    // Sortable by creation time
+    uint64_t created = 0;               // FILETIME
+    std::wstring label;
+    std::vector<BackupRoot> roots;
+};
+
+struct BackupOptions {
+    std::wstring label;
+    uint64_t created = 0;               // FILETIME; 0 = now
+    unsigned threadCount = 0;           // 0 = one per hardware thread
+    std::stop_token stopToken;
+
+    // Reuse the value sets of keys whose last-write time, value names,
+    // types and sizes match the newest backup of the same path, without
+    // reading their data
+    bool incremental = true;
+};
+
+struct BackupStats {
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    uint64_t reusedKeys = 0;            // Values taken from the previous backup
+    uint64_t objects = 0;               // Objects referenced by the backup
+    uint64_t newObjects = 0;            // Objects actually written
+    uint64_t logicalBytes = 0;          // Size of all referenced objects
+    uint64_t writtenBytes = 0;          // Size of the written records
+    uint64_t errors = 0;                // Keys that could not be opened
+    double seconds = 0;
+    bool cancelled = false;
+
+    // Serialized size over stored size
+    double DedupeRatio() const { return writtenBytes ? static_cast<double>(logicalBytes) / writtenBytes : 0.0; }
+};
+
+struct RestoreStats {
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    uint64_t errors = 0;                // Keys or values that could not be written
+    double seconds = 0;
+    bool cancelled = false;
+};
+
+struct GarbageStats {
+    uint64_t liveObjects = 0;
+    uint64_t deadObjects = 0;
+    uint64_t freedBytes = 0;
+    uint32_t deletedPacks = 0;
+    uint32_t rewrittenPacks = 0;
+    double seconds = 0;
+};
+
+struct StoreStats {
+    uint32_t backups = 0;
+    uint32_t packs = 0;
+    uint64_t objects = 0;
+    uint64_t bytes = 0;                 // Pack file bytes
+};
+
+class BackupStore {
+public:
+    BackupStore() = default;
+    ~BackupStore();
+
+    BackupStore(const BackupStore&) = delete;
+    BackupStore& operator=(const BackupStore&) = delete;
+
+    // Open a store directory, creating it if needed. Packs left without an
+    // index by an interrupted backup are reindexed.
+    bool Open(const std::filesystem::path& directory);
+    void Close();
+    bool IsOpen() const { return !m_directory.empty(); }
+
+    // Write a backup of the sources. Only objects not already in the store
+    // are written; the manifest is written last, so an interrupted backup
+    // leaves no trace beyond unreferenced objects.
+    bool CreateBackup(std::span<const BackupSource> sources, const BackupOptions& options,
+                      BackupInfo& info, BackupStats& stats);
+
+    // All backups, oldest first
+    bool ListBackups(std::vector<BackupInfo>& backups) const;
+
+    // Write root number rootIndex of a backup into target (which must
+    // exist). Keys and values are merged into what target already holds;
+    // clear it first (DeleteSubtree) for an exact restore. Objects are read
+    // straight from the mapped packs, one key at a time.
+    bool Restore(const std::wstring& id, size_t rootIndex, RegistryKey& target,
+                 RestoreStats& stats, std::stop_token stopToken = {});
+
+    // Remove manifests. Their objects stay until CollectGarbage().
+    bool DeleteBackup(const std::wstring& id);
+    size_t ExpireBackups(uint64_t olderThan, size_t keepAtLeast = 1);
+
+    // Drop objects no manifest references. Packs with no live objects are
+    // deleted; packs that are at least a quarter dead are rewritten.
+    bool CollectGarbage(GarbageStats& stats);
+
+    StoreStats GetStats() const;
+    const std::wstring& Error() const { return m_error; }
+
+private:
+    struct Location {
+        uint32_t pack;
+        uint32_t offset;                // Of the object bytes
+        uint32_t size;
+    };
+
+    struct Pack {
+        uint32_t number;
+        uint64_t size = 0;
+        std::unique_ptr<MappedFile> map;    // Opened on first read
+    };
+
+    friend class BackupWriter;
+
+    bool LoadPack(uint32_t number);
+    bool ReindexPack(uint32_t number);
+    bool WriteIndex(uint32_t number, std::vector<std::pair<ObjectHash, Location>>& entries);
+
+    // Store object bytes under their hash unless already present. Thread-safe.
+    bool Put(const ObjectHash& hash, std::span<const uint8_t> object, bool& added);
+    bool BeginPack();
+    bool SealPack();
+
+    // Object bytes, valid while the store is open. Thread-safe.
+    bool Get(const ObjectHash& hash, std::span<const uint8_t>& object);
+
+    bool ReadManifest(const std::filesystem::path& path, BackupInfo& info) const;
+    bool WriteManifest(const BackupInfo& info);
+    bool Fail(std::wstring message);
+
+    std::filesystem::path m_directory;
+    std::wstring m_error;
+
+    mutable std::mutex m_mutex;     // Guards everything below during a backup
+    std::unordered_map<ObjectHash, Location, ObjectHashHasher> m_index;
+    std::vector<Pack> m_packs;      // Sorted by number
+    uint32_t m_nextPack = 1;
+
+    // Pack being written (its objects are in m_index but not yet readable)
+    std::ofstream m_active;
+    uint32_t m_activeNumber = 0;
+    uint64_t m_activeSize = 0;
+    std::vector<std::pair<ObjectHash, Location>> m_activeEntries;
+};
+
+} // namespace core
@@ -0,0 +1,461 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Prebuilt COM registration index.
+ */
+
+#include "ComIndex.h"
+#include "HiveFormat.h"
+#include "RegistryTypes.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cwchar>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace core {
+
+using hive::ReadU32;
+using hive::ReadU64;
+using hive::WriteU32;
+using hive::WriteU64;
+
+namespace {
+
+// Image layout: header, GUID slots, ProgID slots, string pool
+constexpr uint32_t INDEX_MAGIC = 0x49435352;        // "RSCI"
+constexpr uint32_t INDEX_VERSION = 1;
+constexpr uint32_t HEADER_SIZE = 64;
+constexpr uint32_t HEADER_MAGIC = 0;
+constexpr uint32_t HEADER_VERSION = 4;
+constexpr uint32_t HEADER_SLOT_COUNT = 8;
+constexpr uint32_t HEADER_ENTRY_COUNT = 12;
+constexpr uint32_t HEADER_PROGID_SLOT_COUNT = 16;
+constexpr uint32_t HEADER_POOL_SIZE = 20;
+constexpr uint32_t HEADER_STAMPS = 24;              // One last-write time per parent key
+
+// GUID slot: hi, lo, name, server, progId, kinds (kinds == 0 means empty)
+constexpr uint32_t SLOT_SIZE = 32;
+constexpr uint32_t SLOT_HI = 0;
+constexpr uint32_t SLOT_LO = 8;
+constexpr uint32_t SLOT_NAME = 16;
+constexpr uint32_t SLOT_SERVER = 20;
+constexpr uint32_t SLOT_PROGID = 24;
+constexpr uint32_t SLOT_KINDS = 28;
+
+// ProgID slot: folded-name hash, pool offset of the name, GUID slot + 1 (0 = empty)
+constexpr uint32_t PROGID_SLOT_SIZE = 12;
+constexpr uint32_t PROGID_HASH = 0;
+constexpr uint32_t PROGID_NAME = 4;
+constexpr uint32_t PROGID_TARGET = 8;
+
+constexpr uint32_t NO_STRING = 0xFFFFFFFF;
+
+struct ParentKey {
+    const wchar_t* name;
+    ComKind kind;
+};
+
+constexpr ParentKey PARENT_KEYS[] = {
+    { L"CLSID", COM_CLASS },
+    { L"Interface", COM_INTERFACE },
+    { L"TypeLib", COM_TYPELIB }
+};
+constexpr size_t PARENT_COUNT = std::size(PARENT_KEYS);
+
+struct RawEntry {
+    Guid guid;
+    std::wstring name;
+    std::wstring server;
+    std::wstring progId;
+    std::wstring versionIndependentProgId;
+};
+
+struct WorkItem {
+    uint32_t parent;
+    uint32_t index;
+};
+
+uint32_t HashProgId(std::wstring_view name) {
+    uint32_t hash = 0x811C9DC5;
+    for (wchar_t c : name) {
+        hash ^= static_cast<uint16_t>(FoldChar(c));
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+// Default value of key (or of its subkey) as a string
+bool ReadDefault(const RegistryKey& key, std::wstring_view subKey, std::wstring& text) {
+    KeyPtr child;
+    const RegistryKey* target = &key;
+    if (!subKey.empty()) {
+        child = key.OpenSubKey(subKey);
+        if (!child) return false;
+        target = child.get();
+    }
+
+    RegValue value;
+    if (!target->GetValue(L"", value)) return false;
+    if (value.type != VALUE_SZ && value.type != VALUE_EXPAND_SZ) return false;
+    text = DecodeString(value.data.data(), value.data.size());
+    return !text.empty();
+}
+
+// Type library versions are "major.minor" in hex
+std::pair<unsigned long, unsigned long> ParseVersion(const std::wstring& text) {
+    wchar_t* end = nullptr;
+    unsigned long major = std::wcstoul(text.c_str(), &end, 16);
+    unsigned long minor = (end && *end == L'.') ? std::wcstoul(end + 1, nullptr, 16) : 0;
+    return { major, minor };
+}
+
+void ReadClass(const RegistryKey& key, RawEntry& entry) {
+    ReadDefault(key, L"", entry.name);
+    if (!ReadDefault(key, L"InprocServer32", entry.server)) ReadDefault(key, L"LocalServer32", entry.server);
+    ReadDefault(key, L"ProgID", entry.progId);
+    ReadDefault(key, L"VersionIndependentProgID", entry.versionIndependentProgId);
+}
+
+// Name and file of the newest registered version
+void ReadTypeLib(const RegistryKey& key, RawEntry& entry) {
+    std::vector<std::wstring> versions;
+    key.GetSubKeyNames(versions);
+    if (versions.empty()) return;
+    auto newest = std::max_element(versions.begin(), versions.end(),
+        [](const std::wstring& a, const std::wstring& b) { return ParseVersion(a) < ParseVersion(b); });
+
+    KeyPtr version = key.OpenSubKey(*newest);
+    if (!version) return;
+    ReadDefault(*version, L"", entry.name);
+
+    std::vector<std::wstring> locales;
+    version->GetSubKeyNames(locales);
+    for (const std::wstring& locale : locales) {
+        if (NamesEqual(locale, L"FLAGS") || NamesEqual(locale, L"HELPDIR")) continue;
+        if (ReadDefault(*version, locale + L"\\win64", entry.server) ||
+            ReadDefault(*version, locale + L"\\win32", entry.server)) {
+            break;
+        }
+    }
+}
+
+class ImageBuilder {
+public:
+    explicit ImageBuilder(size_t entryCount, size_t progIdCount) {
+        m_slotCount = std::bit_ceil(std::max<size_t>(16, entryCount * 2));
+        m_progIdSlotCount = std::bit_ceil(std::max<size_t>(16, progIdCount * 2));
+        m_tables.assign(HEADER_SIZE + m_slotCount * SLOT_SIZE + m_progIdSlotCount * PROGID_SLOT_SIZE, 0);
+    }
+
+    // Later kinds only fill in fields that are still empty
+    void Add(const RawEntry& entry, ComKind kind) {
+        uint8_t* slot = GuidSlot(entry.guid);
+        if (ReadU32(slot + SLOT_KINDS) == 0) {
+            WriteU64(slot + SLOT_HI, entry.guid.hi);
+            WriteU64(slot + SLOT_LO, entry.guid.lo);
+            WriteU32(slot + SLOT_NAME, NO_STRING);
+            WriteU32(slot + SLOT_SERVER, NO_STRING);
+            WriteU32(slot + SLOT_PROGID, NO_STRING);
+            m_entryCount++;
+        }
+        WriteU32(slot + SLOT_KINDS, ReadU32(slot + SLOT_KINDS) | kind);
+        Fill(slot + SLOT_NAME, entry.name);
+        Fill(slot + SLOT_SERVER, entry.server);
+        Fill(slot + SLOT_PROGID, entry.progId.empty() ? entry.versionIndependentProgId : entry.progId);
+
+        uint32_t slotIndex = static_cast<uint32_t>((slot - m_tables.data() - HEADER_SIZE) / SLOT_SIZE);
+        AddProgId(entry.progId, slotIndex);
+        AddProgId(entry.versionIndependentProgId, slotIndex);
+    }
+
+    std::vector<uint8_t> Finish(const uint64_t (&stamps)[PARENT_COUNT]) {
+        uint8_t* header = m_tables.data();
+        WriteU32(header + HEADER_MAGIC, INDEX_MAGIC);
+        WriteU32(header + HEADER_VERSION, INDEX_VERSION);
+        WriteU32(header + HEADER_SLOT_COUNT, static_cast<uint32_t>(m_slotCount));
+        WriteU32(header + HEADER_ENTRY_COUNT, m_entryCount);
+        WriteU32(header + HEADER_PROGID_SLOT_COUNT, static_cast<uint32_t>(m_progIdSlotCount));
+        WriteU32(header + HEADER_POOL_SIZE, static_cast<uint32_t>(m_pool.size()));
+        for (size_t i = 0; i < PARENT_COUNT; i++) WriteU64(header + HEADER_STAMPS + i * 8, stamps[i]);
+
+        std::vector<uint8_t> image = std::move(m_tables);
+        image.insert(image.end(), m_pool.begin(), m_pool.end());
+        return image;
+    }
+
+private:
+    uint8_t* GuidSlot(const Guid& guid) {
+        size_t mask = m_slotCount - 1;
+        for (size_t i = HashGuid(guid) & mask;; i = (i + 1) & mask) {
+            uint8_t* slot = m_tables.data() + HEADER_SIZE + i * SLOT_SIZE;
+            if (ReadU32(slot + SLOT_KINDS) == 0) return slot;
+            if (ReadU64(slot + SLOT_HI) == guid.hi && ReadU64(slot + SLOT_LO) == guid.lo) return slot;
+        }
+    }
+
+    void Fill(uint8_t* field, const std::wstring& text) {
+        if (ReadU32(field) == NO_STRING && !text.empty()) WriteU32(field, Intern(text));
+    }
+
+    // First registration of a ProgID wins
+    void AddProgId(const std::wstring& progId, uint32_t slotIndex) {
+        if (progId.empty() || !m_progIds.insert(FoldName(progId)).second) return;
+        uint32_t hash = HashProgId(progId);
+        size_t mask = m_progIdSlotCount - 1;
+        uint8_t* base = m_tables.data() + HEADER_SIZE + m_slotCount * SLOT_SIZE;
+        size_t i = hash & mask;
+        while (ReadU32(base + i * PROGID_SLOT_SIZE + PROGID_TARGET) != 0) i = (i + 1) & mask;
+
+        uint8_t* slot = base + i * PROGID_SLOT_SIZE;
+        WriteU32(slot + PROGID_HASH, hash);
+        WriteU32(slot + PROGID_NAME, Intern(progId));
+        WriteU32(slot + PROGID_TARGET, slotIndex + 1);
+    }
+
+    uint32_t Intern(const std::wstring& text) {
+        auto [it, inserted] = m_strings.try_emplace(text, static_cast<uint32_t>(m_pool.size()));
+        if (!inserted) return it->second;
+
+        std::vector<uint8_t> units = EncodeString(text, false);
+        uint8_t length[4];
+        WriteU32(length, static_cast<uint32_t>(text.size()));
+        m_pool.insert(m_pool.end(), length, length + 4);
+        m_pool.insert(m_pool.end(), units.begin(), units.end());
+        return it->second;
+    }
+
+    size_t m_slotCount;
+    size_t m_progIdSlotCount;
+    uint32_t m_entryCount = 0;
+    std::vector<uint8_t> m_tables;
+    std::vector<uint8_t> m_pool;
+    std::unordered_map<std::wstring, uint32_t> m_strings;
+    std::unordered_set<std::wstring> m_progIds;
+};
+
+} // namespace
+
+bool ComIndex::Build(const RegistryKey& classesRoot, ComIndex& index, const ComIndexOptions& options) {
+    KeyPtr parents[PARENT_COUNT];
+    std::vector<std::wstring> names[PARENT_COUNT];
+    uint64_t stamps[PARENT_COUNT] = {};
+
+    WorkQueue<WorkItem> queue(options.threadCount, options.stopToken);
+    for (uint32_t p = 0; p < PARENT_COUNT; p++) {
+        parents[p] = classesRoot.OpenSubKey(PARENT_KEYS[p].name);
+        if (!parents[p]) continue;
+        KeyInfo info;
+        if (parents[p]->QueryInfo(info)) stamps[p] = info.lastWriteTime;
+        parents[p]->GetSubKeyNames(names[p]);
+        for (uint32_t i = 0; i < names[p].size(); i++) queue.Push({ p, i });
+    }
+
+    // results[worker][parent]
+    std::vector<std::array<std::vector<RawEntry>, PARENT_COUNT>> results(queue.ThreadCount());
+    queue.Run([&](WorkItem& item, std::vector<WorkItem>&, unsigned worker) {
+        RawEntry entry;
+        const std::wstring& name = names[item.parent][item.index];
+        if (!ParseGuid(name, entry.guid)) return;
+        KeyPtr key = parents[item.parent]->OpenSubKey(name);
+        if (!key) return;
+
+        switch (PARENT_KEYS[item.parent].kind) {
+            case COM_CLASS: ReadClass(*key, entry); break;
+            case COM_INTERFACE: ReadDefault(*key, L"", entry.name); break;
+            case COM_TYPELIB: ReadTypeLib(*key, entry); break;
+        }
+        results[worker][item.parent].push_back(std::move(entry));
+    });
+    if (queue.Cancelled()) return false;
+
+    size_t entryCount = 0;
+    size_t progIdCount = 0;
+    for (const auto& perParent : results) {
+        for (const auto& entries : perParent) {
+            entryCount += entries.size();
+            for (const RawEntry& entry : entries) {
+                progIdCount += !entry.progId.empty() + !entry.versionIndependentProgId.empty();
+            }
+        }
+    }
+
+    // Classes first so their names win over interface and type library names;
+    // sorting keeps the image identical across runs
+    ImageBuilder builder(entryCount, progIdCount);
+    for (size_t p = 0; p < PARENT_COUNT; p++) {
+        std::vector<RawEntry> merged;
+        for (auto& perParent : results) {
+            std::move(perParent[p].begin(), perParent[p].end(), std::back_inserter(merged));
+        }
+        std::sort(merged.begin(), merged.end(), [](const RawEntry& a, const RawEntry& b) {
+            return a.guid.hi != b.guid.hi ? a.guid.hi < b.guid.hi : a.guid.lo < b.guid.lo;
+        });
+        for (const RawEntry& entry : merged) builder.Add(entry, PARENT_KEYS[p].kind);
+    }
+
+    ComIndex built;
+    built.m_image = builder.Finish(stamps);
+    if (!built.Attach(built.m_image.data(), built.m_image.size())) return false;
+    index = std::move(built);
+    return true;
+}
+
+bool ComIndex::LoadOrBuild(const RegistryKey& classesRoot, const std::filesystem::path& cachePath,
+                           ComIndex& index, const ComIndexOptions& options) {
+    {
+        ComIndex cached;
+        if (cached.Open(cachePath) && cached.IsCurrent(classesRoot)) {
+            index = std::move(cached);
+            return true;
+        }
+    }
+
+    // The stale image is unmapped and closed by now; Windows cannot rename
+    // over a file that is still mapped. The same goes for a previous image
+    // index may hold, which Build replaces before Save runs.
+    if (!Build(classesRoot, index, options)) return false;
+    index.Save(cachePath);  // A missing cache only costs a rebuild next time
+    return true;
+}
+
+bool ComIndex::Open(const std::filesystem::path& path) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->Open(path) || !Attach(file->Data(), file->Size())) {
+        m_data = nullptr;
+        m_size = 0;
+        return false;
+    }
+    m_image.clear();
+    m_file = std::move(file);
+    return true;
+}
+
+bool ComIndex::Attach(const uint8_t* data, size_t size) {
+    if (!data || size < HEADER_SIZE) return false;
+    if (ReadU32(data + HEADER_MAGIC) != INDEX_MAGIC || ReadU32(data + HEADER_VERSION) != INDEX_VERSION) return false;
+
+    uint64_t slotCount = ReadU32(data + HEADER_SLOT_COUNT);
+    uint64_t progIdSlotCount = ReadU32(data + HEADER_PROGID_SLOT_COUNT);
+    if (!std::has_single_bit(slotCount) || !std::has_single_bit(progIdSlotCount)) return false;
+
+    // Probing stops at an empty slot, so the load factor must stay below 1;
+    // the probe loops are also bounded by the slot count in case a file lies
+    if (ReadU32(data + HEADER_ENTRY_COUNT) >= slotCount) return false;
+    uint64_t expected = HEADER_SIZE + slotCount * SLOT_SIZE + progIdSlotCount * PROGID_SLOT_SIZE +
+                        ReadU32(data + HEADER_POOL_SIZE);
+    if (expected != size) return false;
+
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+bool ComIndex::Save(const std::filesystem::path& path) const {
+    if (!m_data) return false;
+    std::error_code error;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+    // Write next to the target and rename, so readers never map a partial file
+    std::filesystem::path temporary = path;
+    temporary += L".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(m_data), static_cast<std::streamsize>(m_size));
+        if (!file) return false;
+    }
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+bool ComIndex::IsCurrent(const RegistryKey& classesRoot) const {
+    if (!m_data) return false;
+    for (size_t p = 0; p < PARENT_COUNT; p++) {
+        KeyInfo info{};
+        KeyPtr parent = classesRoot.OpenSubKey(PARENT_KEYS[p].name);
+        uint64_t stamp = (parent && parent->QueryInfo(info)) ? info.lastWriteTime : 0;
+        if (stamp != ReadU64(m_data + HEADER_STAMPS + p * 8)) return false;
+    }
+    return true;
+}
+
+size_t ComIndex::Size() const {
+    return m_data ? ReadU32(m_data + HEADER_ENTRY_COUNT) : 0;
+}
+
+uint32_t ComIndex::FindSlot(const Guid& guid) const {
+    if (!m_data) return NO_STRING;
+    uint32_t slotCount = ReadU32(m_data + HEADER_SLOT_COUNT);
+    uint32_t mask = slotCount - 1;
+    uint32_t i = static_cast<uint32_t>(HashGuid(guid)) & mask;
+    for (uint32_t probe = 0; probe < slotCount; probe++, i = (i + 1) & mask) {
+        const uint8_t* slot = m_data + HEADER_SIZE + static_cast<size_t>(i) * SLOT_SIZE;
+        if (ReadU32(slot + SLOT_KINDS) == 0) return NO_STRING;
+        if (ReadU64(slot + SLOT_HI) == guid.hi && ReadU64(slot + SLOT_LO) == guid.lo) return i;
+    }
+    return NO_STRING;
+}
+
+std::wstring ComIndex::String(uint32_t offset) const {
+    if (offset == NO_STRING) return {};
+    size_t poolSize = ReadU32(m_data + HEADER_POOL_SIZE);
+    if (poolSize < 4 || offset > poolSize - 4) return {};
+    size_t start = m_size - poolSize + offset;
+    size_t length = ReadU32(m_data + start);
+    if (length > (m_size - start - 4) / 2) return {};
+
+    std::wstring text(length, L'\0');
+    const uint8_t* units = m_data + start + 4;
+    for (size_t i = 0; i < length; i++) text[i] = static_cast<wchar_t>(units[i * 2] | (units[i * 2 + 1] << 8));
+    return text;
+}
+
+bool ComIndex::Find(const Guid& guid, ComEntry& entry) const {
+    uint32_t index = FindSlot(guid);
+    if (index == NO_STRING) return false;
+    const uint8_t* slot = m_data + HEADER_SIZE + static_cast<size_t>(index) * SLOT_SIZE;
+    entry.kinds = ReadU32(slot + SLOT_KINDS);
+    entry.name = String(ReadU32(slot + SLOT_NAME));
+    entry.server = String(ReadU32(slot + SLOT_SERVER));
+    entry.progId = String(ReadU32(slot + SLOT_PROGID));
+    return true;
+}
+
+bool ComIndex::FindName(const Guid& guid, std::wstring& name) const {
+    uint32_t index = FindSlot(guid);
+    if (index == NO_STRING) return false;
+    name = String(ReadU32(m_data + HEADER_SIZE + static_cast<size_t>(index) * SLOT_SIZE + SLOT_NAME));
+    return !name.empty();
+}
+
+bool ComIndex::FindProgId(std::wstring_view progId, Guid& guid) const {
+    if (!m_data || progId.empty()) return false;
+    uint32_t slotCount = ReadU32(m_data + HEADER_SLOT_COUNT);
+    uint32_t progIdSlotCount = ReadU32(m_data + HEADER_PROGID_SLOT_COUNT);
+    uint32_t mask = progIdSlotCount - 1;
+    const uint8_t* base = m_data + HEADER_SIZE + static_cast<size_t>(slotCount) * SLOT_SIZE;
+
+    uint32_t hash = HashProgId(progId);
+    uint32_t i = hash & mask;
+    for (uint32_t probe = 0; probe < progIdSlotCount; probe++, i = (i + 1) & mask) {
+        const uint8_t* slot = base + static_cast<size_t>(i) * PROGID_SLOT_SIZE;
+        uint32_t target = ReadU32(slot + PROGID_TARGET);
+        if (target == 0 || target > slotCount) return false;
+        if (ReadU32(slot + PROGID_HASH) != hash || !NamesEqual(String(ReadU32(slot + PROGID_NAME)), progId)) continue;
+
+        const uint8_t* guidSlot = m_data + HEADER_SIZE + static_cast<size_t>(target - 1) * SLOT_SIZE;
+        guid.hi = ReadU64(guidSlot + SLOT_HI);
+        guid.lo = ReadU64(guidSlot + SLOT_LO);
+        return true;
+    }
+    return false;
+}
+
+} // namespace core
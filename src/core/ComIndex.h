@@ -0,0 +1,83 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Prebuilt COM registration index: GUIDs from HKCR\CLSID, HKCR\Interface
+ * and HKCR\TypeLib mapped to their friendly name, server path and ProgID.
+ * The index is a flat image (open-addressing tables plus an interned
+ * string pool) that is saved to disk and memory-mapped on later runs, and
+ * rebuilt when the last-write time of one of the three parent keys moves.
+ */
+
+#pragma once
+
+#include "Guid.h"
+#include "MappedFile.h"
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+enum ComKind : uint32_t {
+    COM_CLASS = 1,          // HKCR\CLSID
+    COM_INTERFACE = 2,      // HKCR\Interface
+    COM_TYPELIB = 4         // HKCR\TypeLib
+};
+
+struct ComEntry {
+    uint32_t kinds = 0;     // ComKind bits the GUID is registered under
+    std::wstring name;      // Class, interface or type library name
+    std::wstring server;    // InprocServer32 / LocalServer32, or the type library file
+    std::wstring progId;
+};
+
+struct ComIndexOptions {
+    unsigned threadCount = 0;   // 0 = one per hardware thread
+    std::stop_token stopToken;
+};
+
+class ComIndex {
+public:
+    ComIndex() = default;
+    ComIndex(ComIndex&&) = default;
+    ComIndex& operator=(ComIndex&&) = default;
+
+    // Walk the three parent keys under classesRoot and build an in-memory image
+    static bool Build(const RegistryKey& classesRoot, ComIndex& index, const ComIndexOptions& options = {});
+
+    // Map a saved image, or rebuild and save it when missing or stale
+    static bool LoadOrBuild(const RegistryKey& classesRoot, const std::filesystem::path& cachePath,
+                            ComIndex& index, const ComIndexOptions& options = {});
+
+    bool Open(const std::filesystem::path& path);
+    bool Save(const std::filesystem::path& path) const;
+
+    // True if the parent keys have not been written since the image was built
+    bool IsCurrent(const RegistryKey& classesRoot) const;
+
+    bool IsLoaded() const { return m_data != nullptr; }
+    size_t Size() const;
+
+    bool Find(const Guid& guid, ComEntry& entry) const;
+    bool FindName(const Guid& guid, std::wstring& name) const;
+    bool FindProgId(std::wstring_view progId, Guid& guid) const;
+
+private:
+    bool Attach(const uint8_t* data, size_t size);
+    uint32_t FindSlot(const Guid& guid) const;
+    std::wstring String(uint32_t offset) const;
+
+    std::vector<uint8_t> m_image;           // Freshly built image
+    std::unique_ptr<MappedFile> m_file;     // Or a mapped one
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace core
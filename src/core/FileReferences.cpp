@@ -0,0 +1,435 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * File reference finder.
+ */
+
+#include "FileReferences.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace core {
+
+namespace {
+
+// Extensions that end an unquoted path inside a command line
+constexpr std::wstring_view FILE_EXTENSIONS[] = {
+    L".exe", L".dll", L".sys", L".ocx", L".cpl", L".drv", L".scr", L".com", L".bat", L".cmd",
+    L".ps1", L".vbs", L".js", L".msc", L".msi", L".lnk", L".tlb", L".olb", L".ax", L".ico",
+    L".mui", L".inf", L".ini", L".chm", L".hlp", L".ttf", L".efi"
+};
+
+constexpr std::wstring_view SYSTEM_ROOT_PREFIX = L"\\SystemRoot\\";
+constexpr std::wstring_view NT_PREFIX = L"\\??\\";
+constexpr std::wstring_view LONG_PREFIX = L"\\\\?\\";
+
+bool IsLetter(wchar_t c) {
+    return (c >= L'A' && c <= L'Z') || (c >= L'a' && c <= L'z');
+}
+
+bool IsSlash(wchar_t c) {
+    return c == L'\\' || c == L'/';
+}
+
+bool StartsWithFolded(std::wstring_view text, size_t pos, std::wstring_view prefix) {
+    if (text.size() - pos < prefix.size()) return false;
+    return NamesEqual(text.substr(pos, prefix.size()), prefix);
+}
+
+bool IsDrivePath(std::wstring_view text, size_t pos) {
+    return pos + 2 < text.size() && IsLetter(text[pos]) && text[pos + 1] == L':' && IsSlash(text[pos + 2]);
+}
+
+// Length of a path root at pos ("C:\", "%VAR%\", "\SystemRoot\", "\??\C:\"), 0 if none
+size_t RootLength(std::wstring_view text, size_t pos) {
+    if (IsDrivePath(text, pos)) return 3;
+    if (text[pos] == L'%') {
+        size_t close = text.find(L'%', pos + 1);
+        if (close == std::wstring_view::npos || close == pos + 1 || close + 1 >= text.size()) return 0;
+        for (size_t i = pos + 1; i < close; i++) {
+            wchar_t c = text[i];
+            if (c == L' ' || c == L'\\' || c == L'"') return 0;
+        }
+        return IsSlash(text[close + 1]) ? close + 2 - pos : 0;
+    }
+    if (StartsWithFolded(text, pos, SYSTEM_ROOT_PREFIX)) return SYSTEM_ROOT_PREFIX.size();
+    for (std::wstring_view prefix : { NT_PREFIX, LONG_PREFIX }) {
+        if (text.substr(pos, prefix.size()) == prefix && IsDrivePath(text, pos + prefix.size())) {
+            return prefix.size() + 3;
+        }
+    }
+    return 0;
+}
+
+// Paths start at the beginning of the text or after a delimiter
+bool IsBoundary(std::wstring_view text, size_t pos) {
+    if (pos == 0) return true;
+    wchar_t c = text[pos - 1];
+    return c == L' ' || c == L'\t' || c == L'@' || c == L'=' || c == L',' || c == L';' || c == L'(';
+}
+
+bool IsStopChar(wchar_t c) {
+    return c == L'"' || c == L';' || c == L'|' || c == L'<' || c == L'>' || c == L'*' || c == L'?';
+}
+
+// End of an unquoted path that begins at start. A known extension followed by
+// a delimiter ends it; otherwise a value that is only a path runs to the end
+// and a path inside a command line stops at the first blank or comma.
+size_t FindPathEnd(std::wstring_view text, size_t start, size_t rootLength) {
+    size_t limit = start + rootLength;
+    while (limit < text.size() && !IsStopChar(text[limit])) limit++;
+
+    for (size_t i = start + rootLength; i < limit; i++) {
+        if (text[i] != L'.') continue;
+        for (std::wstring_view extension : FILE_EXTENSIONS) {
+            size_t end = i + extension.size();
+            if (end > limit || !StartsWithFolded(text, i, extension)) continue;
+            if (end == limit || text[end] == L' ' || text[end] == L',' || text[end] == L'\t' || text[end] == L')') {
+                return end;
+            }
+        }
+    }
+
+    if (start == 0) {
+        while (limit > start && (text[limit - 1] == L' ' || text[limit - 1] == L'\t')) limit--;
+        return limit;
+    }
+    size_t end = start + rootLength;
+    while (end < limit && text[end] != L' ' && text[end] != L'\t' && text[end] != L',') end++;
+    return end;
+}
+
+// A bare root ("C:\") or an empty variable path says nothing about a file
+void AddCandidate(std::wstring_view path, size_t rootLength, std::vector<std::wstring_view>& paths) {
+    if (path.size() > rootLength) paths.push_back(path);
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct WalkItem {
+    std::shared_ptr<const RegistryKey> parentKey;
+    std::shared_ptr<const RegistryKey> key;     // Set for the scan root only
+    std::wstring name;
+    std::wstring path;
+};
+
+// References found by one worker; path indices point into texts
+struct Shard {
+    std::vector<std::wstring> keys;
+    std::vector<FileReference> references;
+    std::vector<std::wstring> texts;
+    std::unordered_map<std::wstring, uint32_t> textIds;
+    uint64_t keysVisited = 0;
+    uint64_t stringValues = 0;
+    uint64_t errors = 0;
+};
+
+void AddStrings(const RegValue& value, std::vector<std::wstring>& strings) {
+    strings.clear();
+    if (value.type == VALUE_SZ || value.type == VALUE_EXPAND_SZ) {
+        strings.push_back(DecodeString(value.data.data(), value.data.size()));
+        return;
+    }
+
+    // REG_MULTI_SZ: NUL-separated, empty string terminates
+    std::wstring current;
+    for (size_t i = 0; i + 1 < value.data.size(); i += 2) {
+        wchar_t c = static_cast<wchar_t>(value.data[i] | (value.data[i + 1] << 8));
+        if (c != L'\0') {
+            current.push_back(c);
+        } else if (current.empty()) {
+            break;
+        } else {
+            strings.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) strings.push_back(std::move(current));
+}
+
+void ProcessKey(WalkItem& item, std::vector<WalkItem>& out, Shard& shard) {
+    std::shared_ptr<const RegistryKey> key = item.key;
+    if (!key) key = item.parentKey->OpenSubKey(item.name);
+    if (!key) {
+        shard.errors++;
+        return;
+    }
+    shard.keysVisited++;
+
+    thread_local std::vector<RegValue> values;
+    thread_local std::vector<std::wstring> strings;
+    thread_local std::vector<std::wstring_view> candidates;
+    key->GetValues(values);
+
+    uint32_t keyIndex = UINT32_MAX;
+    for (const RegValue& value : values) {
+        if (value.type != VALUE_SZ && value.type != VALUE_EXPAND_SZ && value.type != VALUE_MULTI_SZ) continue;
+        shard.stringValues++;
+        AddStrings(value, strings);
+        for (const std::wstring& text : strings) {
+            candidates.clear();
+            ExtractFilePaths(text, candidates);
+            for (std::wstring_view candidate : candidates) {
+                if (keyIndex == UINT32_MAX) {
+                    keyIndex = static_cast<uint32_t>(shard.keys.size());
+                    shard.keys.push_back(item.path);
+                }
+                auto [it, inserted] = shard.textIds.try_emplace(std::wstring(candidate),
+                                                                static_cast<uint32_t>(shard.texts.size()));
+                if (inserted) shard.texts.push_back(it->first);
+                shard.references.push_back({ keyIndex, value.name, it->first, it->second });
+            }
+        }
+    }
+
+    thread_local std::vector<std::wstring> names;
+    key->GetSubKeyNames(names);
+    for (std::wstring& name : names) {
+        WalkItem child;
+        child.parentKey = key;
+        child.path = item.path.empty() ? name : item.path + L'\\' + name;
+        child.name = std::move(name);
+        out.push_back(std::move(child));
+    }
+}
+
+struct DirectoryGroup {
+    std::wstring directory;
+    std::vector<uint32_t> paths;
+};
+
+} // namespace
+
+void ExtractFilePaths(std::wstring_view text, std::vector<std::wstring_view>& paths) {
+    size_t i = 0;
+    while (i < text.size()) {
+        // Quoted: the whole quoted text, spaces included
+        if (text[i] == L'"') {
+            size_t close = text.find(L'"', i + 1);
+            if (close == std::wstring_view::npos) close = text.size();
+            std::wstring_view quoted = text.substr(i + 1, close - i - 1);
+            if (!quoted.empty()) {
+                size_t rootLength = RootLength(quoted, 0);
+                if (rootLength) AddCandidate(quoted, rootLength, paths);
+            }
+            i = close + 1;
+            continue;
+        }
+
+        size_t rootLength = IsBoundary(text, i) ? RootLength(text, i) : 0;
+        if (rootLength) {
+            size_t end = FindPathEnd(text, i, rootLength);
+            AddCandidate(text.substr(i, end - i), rootLength, paths);
+            i = end;
+            continue;
+        }
+        i++;
+    }
+}
+
+std::wstring NormalizeFilePath(std::wstring_view text) {
+    if (text.substr(0, NT_PREFIX.size()) == NT_PREFIX || text.substr(0, LONG_PREFIX.size()) == LONG_PREFIX) {
+        text.remove_prefix(NT_PREFIX.size());
+    }
+    if (!IsDrivePath(text, 0)) return {};
+
+    std::wstring result;
+    result.reserve(text.size());
+    result.push_back(FoldChar(text[0]));
+    result += L":";
+
+    // Resolve components in place; result always starts with "X:"
+    size_t pos = 3;
+    while (pos <= text.size()) {
+        size_t end = pos;
+        while (end < text.size() && !IsSlash(text[end])) end++;
+        std::wstring_view part = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (part.empty() || part == L".") continue;
+        if (part == L"..") {
+            size_t separator = result.rfind(L'\\');
+            if (separator != std::wstring::npos) result.resize(separator);
+            continue;
+        }
+        // Win32 drops trailing dots and blanks from file names
+        while (!part.empty() && (part.back() == L'.' || part.back() == L' ')) part.remove_suffix(1);
+        if (part.empty()) continue;
+        result += L'\\';
+        result += part;
+    }
+    if (result.size() == 2) result += L'\\';
+    return result;
+}
+
+bool ExpandFilePath(std::wstring_view text, FileSystem& fileSystem, std::wstring& expanded) {
+    expanded.clear();
+    if (StartsWithFolded(text, 0, SYSTEM_ROOT_PREFIX)) {
+        if (!fileSystem.GetEnvironment(L"SystemRoot", expanded)) return false;
+        text.remove_prefix(SYSTEM_ROOT_PREFIX.size() - 1);
+    }
+
+    std::wstring value;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t open = text.find(L'%', pos);
+        size_t close = open == std::wstring_view::npos ? open : text.find(L'%', open + 1);
+        if (close == std::wstring_view::npos) {
+            expanded.append(text.substr(pos));
+            break;
+        }
+        expanded.append(text.substr(pos, open - pos));
+        if (!fileSystem.GetEnvironment(text.substr(open + 1, close - open - 1), value)) return false;
+        expanded += value;
+        pos = close + 1;
+    }
+    return true;
+}
+
+bool FileReferenceFinder::Scan(const RegistryKey& root, FileReferenceReport& report, const FileReferenceOptions& options) {
+    report = {};
+    FileReferenceStats& stats = report.stats;
+
+    // Stage 1: walk the registry and extract path text, deduplicated per worker
+    auto walkStart = std::chrono::steady_clock::now();
+    WorkQueue<WalkItem> queue(options.threadCount, options.stopToken);
+    std::vector<Shard> shards(queue.ThreadCount());
+
+    WalkItem rootItem;
+    rootItem.key = std::shared_ptr<const RegistryKey>(&root, [](const RegistryKey*) {});
+    queue.Push(std::move(rootItem));
+    queue.Run([&shards](WalkItem& item, std::vector<WalkItem>& out, unsigned worker) {
+        ProcessKey(item, out, shards[worker]);
+    });
+    stats.walkSeconds = SecondsSince(walkStart);
+    if (queue.Cancelled()) {
+        stats.cancelled = true;
+        return false;
+    }
+
+    // Stage 2: expand and normalize each distinct text once, then merge by folded path
+    auto checkStart = std::chrono::steady_clock::now();
+    std::unordered_map<std::wstring, uint32_t> pathIds;
+    std::wstring expanded;
+    for (Shard& shard : shards) {
+        stats.keys += shard.keysVisited;
+        stats.stringValues += shard.stringValues;
+        stats.errors += shard.errors;
+
+        std::vector<uint32_t> remap(shard.texts.size());
+        for (size_t t = 0; t < shard.texts.size(); t++) {
+            std::wstring normalized;
+            if (ExpandFilePath(shard.texts[t], m_fileSystem, expanded)) normalized = NormalizeFilePath(expanded);
+            FileStatus status = normalized.empty() ? FileStatus::Unresolved : FileStatus::Exists;
+            if (normalized.empty()) normalized = shard.texts[t];
+
+            auto [it, inserted] = pathIds.try_emplace(FoldName(normalized), static_cast<uint32_t>(report.paths.size()));
+            if (inserted) {
+                report.paths.push_back(std::move(normalized));
+                report.status.push_back(status);
+            }
+            remap[t] = it->second;
+        }
+
+        uint32_t keyBase = static_cast<uint32_t>(report.keys.size());
+        std::move(shard.keys.begin(), shard.keys.end(), std::back_inserter(report.keys));
+        for (FileReference& reference : shard.references) {
+            reference.key += keyBase;
+            reference.path = remap[reference.path];
+            report.references.push_back(std::move(reference));
+        }
+        shard = {};
+    }
+    stats.references = report.references.size();
+    stats.uniquePaths = report.paths.size();
+
+    // Stage 3: group the paths by directory so each listing serves all of its files
+    std::vector<DirectoryGroup> groups;
+    std::unordered_map<std::wstring, uint32_t> groupIds;
+    for (uint32_t p = 0; p < report.paths.size(); p++) {
+        if (report.status[p] == FileStatus::Unresolved) continue;
+        const std::wstring& path = report.paths[p];
+        std::wstring directory = path.size() == 3 ? path : path.substr(0, path.rfind(L'\\'));
+        if (directory.size() == 2) directory += L'\\';
+
+        auto [it, inserted] = groupIds.try_emplace(FoldName(directory), static_cast<uint32_t>(groups.size()));
+        if (inserted) groups.push_back({ std::move(directory), {} });
+        groups[it->second].paths.push_back(p);
+    }
+    stats.directories = groups.size();
+
+    std::atomic<size_t> nextGroup{0};
+    std::atomic<uint64_t> reads{0};
+    auto checkGroups = [&] {
+        uint64_t localReads = 0;
+        for (size_t g; (g = nextGroup.fetch_add(1, std::memory_order_relaxed)) < groups.size();) {
+            if (options.stopToken.stop_requested()) break;
+            const DirectoryGroup& group = groups[g];
+            Listing listing = GetListing(group.directory, localReads);
+            for (uint32_t p : group.paths) {
+                const std::wstring& path = report.paths[p];
+                bool exists = listing != nullptr;
+                if (exists && path.size() > 3) {
+                    std::wstring leaf = FoldName(std::wstring_view(path).substr(path.rfind(L'\\') + 1));
+                    exists = std::binary_search(listing->begin(), listing->end(), leaf);
+                }
+                report.status[p] = exists ? FileStatus::Exists : FileStatus::Missing;
+            }
+        }
+        reads.fetch_add(localReads, std::memory_order_relaxed);
+    };
+
+    unsigned ioThreads = static_cast<unsigned>(std::clamp<size_t>(options.ioThreadCount, 1, std::max<size_t>(groups.size(), 1)));
+    {
+        std::vector<std::jthread> pool;
+        for (unsigned i = 1; i < ioThreads; i++) pool.emplace_back(checkGroups);
+        checkGroups();
+    }
+    stats.directoryReads = reads.load();
+    stats.checkSeconds = SecondsSince(checkStart);
+    if (options.stopToken.stop_requested()) {
+        stats.cancelled = true;
+        return false;
+    }
+
+    for (const FileReference& reference : report.references) {
+        if (report.IsBroken(reference)) stats.missingReferences++;
+    }
+    return true;
+}
+
+FileReferenceFinder::Listing FileReferenceFinder::GetListing(const std::wstring& directory, uint64_t& reads) {
+    std::wstring key = FoldName(directory);
+    {
+        std::lock_guard lock(m_cacheMutex);
+        auto it = m_cache.find(key);
+        if (it != m_cache.end()) return it->second;
+    }
+
+    // Read outside the lock; directories are grouped, so no two workers want the same one
+    Listing listing;
+    std::vector<std::wstring> names;
+    reads++;
+    if (m_fileSystem.ListDirectory(directory, names)) {
+        for (std::wstring& name : names) name = FoldName(name);
+        std::sort(names.begin(), names.end());
+        listing = std::make_shared<const std::vector<std::wstring>>(std::move(names));
+    }
+
+    std::lock_guard lock(m_cacheMutex);
+    return m_cache.try_emplace(std::move(key), std::move(listing)).first->second;
+}
+
+void FileReferenceFinder::ClearCache() {
+    std::lock_guard lock(m_cacheMutex);
+    m_cache.clear();
+}
+
+} // namespace core
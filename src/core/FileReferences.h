@@ -0,0 +1,109 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * File reference finder: collects file paths mentioned in string values
+ * (including quoted command lines and "@file.dll,-123" resource strings),
+ * expands environment variables, deduplicates the paths and checks them
+ * against a FileSystem. Checks are grouped by directory and run on a small
+ * I/O pool, so every directory is listed once per cache lifetime however
+ * many references point into it.
+ */
+
+#pragma once
+
+#include "FileSystem.h"
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+enum class FileStatus : uint8_t {
+    Exists,
+    Missing,
+    Unresolved      // Unknown environment variable or not an absolute path after expansion
+};
+
+struct FileReference {
+    uint32_t key;               // Index into FileReferenceReport::keys
+    std::wstring valueName;
+    std::wstring text;          // The path as written in the value
+    uint32_t path;              // Index into FileReferenceReport::paths
+};
+
+struct FileReferenceStats {
+    uint64_t keys = 0;
+    uint64_t stringValues = 0;
+    uint64_t references = 0;
+    uint64_t uniquePaths = 0;
+    uint64_t directories = 0;           // Distinct directories checked
+    uint64_t directoryReads = 0;        // Listings not served by the cache
+    uint64_t missingReferences = 0;
+    uint64_t errors = 0;                // Keys that could not be opened
+    double walkSeconds = 0;             // Registry walk and extraction
+    double checkSeconds = 0;            // Expansion, deduplication and existence checks
+    bool cancelled = false;
+
+    double ReferencesPerSecond() const {
+        double seconds = walkSeconds + checkSeconds;
+        return seconds > 0 ? references / seconds : 0.0;
+    }
+};
+
+struct FileReferenceReport {
+    std::vector<std::wstring> keys;         // Key paths relative to the scan root
+    std::vector<std::wstring> paths;        // Expanded, normalized, unique paths
+    std::vector<FileStatus> status;         // Parallel to paths
+    std::vector<FileReference> references;  // Unordered
+    FileReferenceStats stats;
+
+    bool IsBroken(const FileReference& reference) const { return status[reference.path] == FileStatus::Missing; }
+};
+
+struct FileReferenceOptions {
+    unsigned threadCount = 0;       // Registry walk; 0 = one per hardware thread
+    unsigned ioThreadCount = 8;     // Existence checks are latency bound, not CPU bound
+    std::stop_token stopToken;
+};
+
+// Path-like substrings of a string value, in order of appearance
+void ExtractFilePaths(std::wstring_view text, std::vector<std::wstring_view>& paths);
+
+// "X:\..." with forward slashes, doubled separators, "." and ".." resolved
+// and any "\\?\" or "\??\" prefix removed. Empty if text is not an
+// absolute drive path.
+std::wstring NormalizeFilePath(std::wstring_view text);
+
+// Expand %NAME% references (and the kernel's "\SystemRoot\" prefix).
+// False if a variable is not defined.
+bool ExpandFilePath(std::wstring_view text, FileSystem& fileSystem, std::wstring& expanded);
+
+class FileReferenceFinder {
+public:
+    explicit FileReferenceFinder(FileSystem& fileSystem) : m_fileSystem(fileSystem) {}
+
+    bool Scan(const RegistryKey& root, FileReferenceReport& report, const FileReferenceOptions& options = {});
+
+    // Forget cached directory listings, e.g. after files were installed or removed
+    void ClearCache();
+
+private:
+    // Folded entry names, sorted; null if the directory does not exist
+    using Listing = std::shared_ptr<const std::vector<std::wstring>>;
+
+    Listing GetListing(const std::wstring& directory, uint64_t& reads);
+
+    FileSystem& m_fileSystem;
+    std::mutex m_cacheMutex;
+    std::unordered_map<std::wstring, Listing> m_cache;    // Folded directory -> listing
+};
+
+} // namespace core
@@ -0,0 +1,129 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Native and in-memory filesystems.
+ */
+
+#include "FileSystem.h"
+#include "RegistryTypes.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+#endif
+
+namespace core {
+
+#ifdef _WIN32
+
+bool NativeFileSystem::ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) {
+    names.clear();
+    std::wstring pattern = directory;
+    if (!pattern.empty() && pattern.back() != L'\\') pattern += L'\\';
+    pattern += L'*';
+
+    // Basic info skips the 8.3 names; large fetch cuts round trips on big directories
+    WIN32_FIND_DATAW data;
+    HANDLE hFind = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                                    nullptr, FIND_FIRST_EX_LARGE_FETCH);
+    if (hFind == INVALID_HANDLE_VALUE) return false;
+
+    do {
+        std::wstring_view name = data.cFileName;
+        if (name == L"." || name == L"..") continue;
+        names.emplace_back(name);
+    } while (FindNextFileW(hFind, &data));
+
+    FindClose(hFind);
+    return true;
+}
+
+bool NativeFileSystem::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    std::wstring key(name);
+    DWORD size = GetEnvironmentVariableW(key.c_str(), nullptr, 0);
+    if (size == 0) return false;
+
+    value.resize(size);
+    DWORD length = GetEnvironmentVariableW(key.c_str(), value.data(), size);
+    if (length == 0 || length >= size) return false;
+    value.resize(length);
+    return true;
+}
+
+#else
+
+bool NativeFileSystem::ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) {
+    names.clear();
+    std::wstring local = directory;
+    if (local.size() >= 2 && local[1] == L':') local.erase(0, 2);
+    for (wchar_t& c : local) {
+        if (c == L'\\') c = L'/';
+    }
+    if (local.empty()) local = L"/";
+
+    std::error_code error;
+    std::filesystem::directory_iterator it(std::filesystem::path(local), error);
+    if (error) return false;
+    for (; it != std::filesystem::directory_iterator(); it.increment(error)) {
+        names.push_back(it->path().filename().wstring());
+    }
+    return !error;
+}
+
+bool NativeFileSystem::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    std::string key = std::filesystem::path(std::wstring(name)).string();
+    const char* text = std::getenv(key.c_str());
+    if (!text) return false;
+    value = std::filesystem::path(text).wstring();
+    return true;
+}
+
+#endif
+
+void MemoryFileSystem::AddPath(std::wstring_view path) {
+    std::lock_guard lock(m_mutex);
+    size_t end = path.size();
+    if (end > 0 && path[end - 1] == L'\\') {
+        end--;
+        m_directories[FoldName(path.substr(0, end))];
+    }
+
+    // Register each component in its parent, walking up from the leaf
+    while (true) {
+        size_t separator = path.rfind(L'\\', end - 1);
+        if (separator == std::wstring_view::npos || separator == 0) break;
+        std::wstring_view parent = path.substr(0, separator);
+        m_directories[FoldName(parent)].emplace(path.substr(separator + 1, end - separator - 1));
+        end = separator;
+    }
+}
+
+void MemoryFileSystem::SetEnvironment(std::wstring_view name, std::wstring_view value) {
+    std::lock_guard lock(m_mutex);
+    m_environment[FoldName(name)] = std::wstring(value);
+}
+
+bool MemoryFileSystem::ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) {
+    std::lock_guard lock(m_mutex);
+    names.clear();
+    std::wstring_view key = directory;
+    if (!key.empty() && key.back() == L'\\') key.remove_suffix(1);
+    auto it = m_directories.find(FoldName(key));
+    if (it == m_directories.end()) return false;
+    names.assign(it->second.begin(), it->second.end());
+    return true;
+}
+
+bool MemoryFileSystem::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_environment.find(FoldName(name));
+    if (it == m_environment.end()) return false;
+    value = it->second;
+    return true;
+}
+
+} // namespace core
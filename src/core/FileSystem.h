@@ -0,0 +1,57 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Minimal filesystem interface for engines that check what registry data
+ * points at. Paths use Windows syntax ("C:\dir\file") on every platform.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+class FileSystem {
+public:
+    virtual ~FileSystem() = default;
+
+    // Names of the files and directories in a directory, without "." and
+    // "..". False if the directory does not exist or cannot be read.
+    virtual bool ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) = 0;
+
+    // Environment variable used to expand %NAME% references
+    virtual bool GetEnvironment(std::wstring_view name, std::wstring& value) = 0;
+};
+
+// The machine's own filesystem and environment. Off Windows, "X:\a\b" is
+// read as "/a/b".
+class NativeFileSystem : public FileSystem {
+public:
+    bool ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) override;
+    bool GetEnvironment(std::wstring_view name, std::wstring& value) override;
+};
+
+// Fake tree for running file checks without touching the disk. Names are
+// matched case-insensitively, like NTFS.
+class MemoryFileSystem : public FileSystem {
+public:
+    // Add a file (or an empty directory with a trailing backslash) and its parents
+    void AddPath(std::wstring_view path);
+    void SetEnvironment(std::wstring_view name, std::wstring_view value);
+
+    bool ListDirectory(const std::wstring& directory, std::vector<std::wstring>& names) override;
+    bool GetEnvironment(std::wstring_view name, std::wstring& value) override;
+
+private:
+    std::mutex m_mutex;
+    std::map<std::wstring, std::set<std::wstring>> m_directories;   // Folded path -> entry names
+    std::map<std::wstring, std::wstring> m_environment;             // Folded name -> value
+};
+
+} // namespace core
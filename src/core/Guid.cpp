@@ -0,0 +1,119 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * GUID parsing and formatting.
+ */
+
+#include "Guid.h"
+
+#ifdef REGSTUDIO_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+constexpr size_t GUID_TEXT_LENGTH = 36;            // Without braces
+constexpr size_t DASH_POSITIONS[] = { 8, 13, 18, 23 };
+
+uint64_t LoadBigEndian(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value = value << 8 | bytes[i];
+    return value;
+}
+
+} // namespace
+
+bool HexToBytesScalar(const uint8_t* digits, uint8_t* bytes) {
+    for (int i = 0; i < 8; i++) {
+        uint8_t value = 0;
+        for (int j = 0; j < 2; j++) {
+            uint8_t c = digits[i * 2 + j];
+            uint8_t nibble;
+            if (c >= '0' && c <= '9') nibble = c - '0';
+            else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') nibble = (c | 0x20) - 'a' + 10;
+            else return false;
+            value = static_cast<uint8_t>(value << 4 | nibble);
+        }
+        bytes[i] = value;
+    }
+    return true;
+}
+
+#ifdef REGSTUDIO_HAVE_SSE2
+bool HexToBytesSse2(const uint8_t* digits, uint8_t* bytes) {
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+
+    // '0'..'9' -> 0..9
+    __m128i numeric = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                    _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    // 'a'..'f' (after folding to lower case) -> 10..15
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i alpha = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+    __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                    _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) != 0xFFFF) return false;
+
+    __m128i nibbles = _mm_or_si128(_mm_and_si128(isDigit, numeric), _mm_and_si128(isAlpha, alpha));
+    // Each 16-bit lane holds (high nibble, low nibble); combine and pack
+    __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    __m128i low = _mm_srli_epi16(nibbles, 8);
+    __m128i packed = _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(bytes), packed);
+    return true;
+}
+#endif
+
+bool ParseGuid(std::wstring_view text, Guid& guid) {
+    if (text.size() == GUID_TEXT_LENGTH + 2) {
+        if (text.front() != L'{' || text.back() != L'}') return false;
+        text = text.substr(1, GUID_TEXT_LENGTH);
+    }
+    if (text.size() != GUID_TEXT_LENGTH) return false;
+    for (size_t dash : DASH_POSITIONS) {
+        if (text[dash] != L'-') return false;
+    }
+
+    // Narrow the 32 digits to bytes; anything outside ASCII fails below
+    uint8_t digits[32];
+    size_t count = 0;
+    for (size_t i = 0; i < GUID_TEXT_LENGTH; i++) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) continue;
+        digits[count++] = (text[i] < 0x80) ? static_cast<uint8_t>(text[i]) : 0;
+    }
+
+    uint8_t bytes[16];
+#ifdef REGSTUDIO_HAVE_SSE2
+    if (!HexToBytesSse2(digits, bytes) || !HexToBytesSse2(digits + 16, bytes + 8)) return false;
+#else
+    if (!HexToBytesScalar(digits, bytes) || !HexToBytesScalar(digits + 16, bytes + 8)) return false;
+#endif
+    guid.hi = LoadBigEndian(bytes);
+    guid.lo = LoadBigEndian(bytes + 8);
+    return true;
+}
+
+size_t FindGuid(std::wstring_view text, Guid& guid) {
+    for (size_t pos = text.find(L'{'); pos != std::wstring_view::npos; pos = text.find(L'{', pos + 1)) {
+        if (pos + GUID_TEXT_LENGTH + 2 > text.size()) break;
+        if (ParseGuid(text.substr(pos, GUID_TEXT_LENGTH + 2), guid)) return pos;
+    }
+    return std::wstring_view::npos;
+}
+
+std::wstring FormatGuid(const Guid& guid) {
+    static constexpr wchar_t HEX[] = L"0123456789ABCDEF";
+    std::wstring text = L"{";
+    for (int i = 0; i < 32; i++) {
+        uint64_t half = (i < 16) ? guid.hi : guid.lo;
+        text += HEX[(half >> (60 - (i % 16) * 4)) & 0xF];
+        if (i == 7 || i == 11 || i == 15 || i == 19) text += L'-';
+    }
+    text += L'}';
+    return text;
+}
+
+} // namespace core
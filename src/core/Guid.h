@@ -0,0 +1,59 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * 128-bit GUID keys parsed from registry text such as
+ * "{00021401-0000-0000-C000-000000000046}".
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REGSTUDIO_HAVE_SSE2 1
+#endif
+
+namespace core {
+
+// The 32 hex digits in textual order: hi holds the first 16, lo the rest
+struct Guid {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    bool operator==(const Guid&) const = default;
+    bool IsNull() const { return hi == 0 && lo == 0; }
+};
+
+// Parse a braced or bare GUID (case-insensitive). Surrounding text is not
+// allowed; use FindGuid to locate one inside a longer string.
+bool ParseGuid(std::wstring_view text, Guid& guid);
+
+// Locate the first braced GUID in text. Returns its position or npos.
+size_t FindGuid(std::wstring_view text, Guid& guid);
+
+// Upper-case braced form, as used in registry key names
+std::wstring FormatGuid(const Guid& guid);
+
+// ParseGuid's digit kernels: 16 ASCII hex digits to 8 bytes, false if any
+// is not a hex digit. The SSE2 one is used where the target has it; the
+// scalar one is kept for the others and as its reference.
+bool HexToBytesScalar(const uint8_t* digits, uint8_t* bytes);
+#ifdef REGSTUDIO_HAVE_SSE2
+bool HexToBytesSse2(const uint8_t* digits, uint8_t* bytes);
+#endif
+
+// Well-mixed hash for open-addressing tables
+inline uint64_t HashGuid(const Guid& guid) {
+    uint64_t x = guid.hi ^ (guid.lo * 0x9E3779B97F4A7C15ull);
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace core
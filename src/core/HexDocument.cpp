@@ -0,0 +1,401 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Piece-table hex document and row formatter.
+ */
+
+#include "HexDocument.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REGSTUDIO_HAVE_SSE2 1
+#endif
+
+namespace core {
+
+namespace {
+
+constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+constexpr size_t OFFSET_DIGITS = 8;                 // Registry values stay below 4 GiB
+constexpr size_t BLOCK = 16;                        // Bytes per vector step
+
+// 16 bytes -> 32 hex digits, two per byte, in order
+void HexBlock(const uint8_t* data, char* digits) {
+#ifdef REGSTUDIO_HAVE_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i low = _mm_and_si128(bytes, mask);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+
+    // n + '0', plus 7 more for 'A'..'F'
+    auto toDigit = [](__m128i nibble) {
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(nibble, _mm_set1_epi8(9)), _mm_set1_epi8(7));
+        return _mm_add_epi8(_mm_add_epi8(nibble, _mm_set1_epi8('0')), letter);
+    };
+    __m128i highDigits = toDigit(high);
+    __m128i lowDigits = toDigit(low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digits), _mm_unpacklo_epi8(highDigits, lowDigits));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digits + 16), _mm_unpackhi_epi8(highDigits, lowDigits));
+#else
+    for (size_t i = 0; i < BLOCK; i++) {
+        digits[i * 2] = HEX_DIGITS[data[i] >> 4];
+        digits[i * 2 + 1] = HEX_DIGITS[data[i] & 0x0F];
+    }
+#endif
+}
+
+// 16 bytes -> printable ASCII, '.' for everything else
+void AsciiBlock(const uint8_t* data, char* text) {
+#ifdef REGSTUDIO_HAVE_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    // Signed compare: 0x80..0xFF are negative and fall out with the controls
+    __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x1F)),
+                                      _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x7F)));
+    __m128i result = _mm_or_si128(_mm_and_si128(printable, bytes),
+                                  _mm_andnot_si128(printable, _mm_set1_epi8('.')));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(text), result);
+#else
+    for (size_t i = 0; i < BLOCK; i++) {
+        text[i] = (data[i] >= 0x20 && data[i] < 0x7F) ? static_cast<char>(data[i]) : '.';
+    }
+#endif
+}
+
+// Write size bytes as "XX" pairs; byte i goes to out + position(i)
+template <typename Position>
+void PlaceHex(const uint8_t* data, size_t size, char* out, Position position) {
+    char digits[BLOCK * 2];
+    size_t i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        HexBlock(data + i, digits);
+        for (size_t j = 0; j < BLOCK; j++) std::memcpy(out + position(i + j), digits + j * 2, 2);
+    }
+    for (; i < size; i++) {
+        char* p = out + position(i);
+        p[0] = HEX_DIGITS[data[i] >> 4];
+        p[1] = HEX_DIGITS[data[i] & 0x0F];
+    }
+}
+
+void PlaceAscii(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) AsciiBlock(data + i, out + i);
+    for (; i < size; i++) out[i] = (data[i] >= 0x20 && data[i] < 0x7F) ? static_cast<char>(data[i]) : '.';
+}
+
+size_t HexColumnWidth(const HexLayout& layout) {
+    if (layout.bytesPerRow == 0) return 0;
+    size_t groups = layout.groupSize ? (layout.bytesPerRow - 1) / layout.groupSize : 0;
+    return layout.bytesPerRow * 3 - 1 + groups;
+}
+
+uint32_t NextPriority(uint64_t& seed) {
+    // splitmix64
+    uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+}
+
+} // namespace
+
+size_t HexRowWidth(const HexLayout& layout) {
+    size_t width = OFFSET_DIGITS + 2 + HexColumnWidth(layout);
+    if (layout.ascii) width += 3 + layout.bytesPerRow + 1;         // "  |" ... "|"
+    return width;
+}
+
+void FormatHexRows(const uint8_t* data, size_t size, uint64_t offset,
+                   const HexLayout& layout, std::string& out) {
+    size_t perRow = layout.bytesPerRow;
+    if (perRow == 0 || size == 0) return;
+
+    size_t width = HexRowWidth(layout);
+    size_t rows = (size + perRow - 1) / perRow;
+    size_t start = out.size();
+    out.resize(start + rows * (width + 1), ' ');
+
+    size_t group = layout.groupSize ? layout.groupSize : perRow;
+    auto position = [group](size_t i) { return i * 3 + i / group; };
+    size_t hexStart = OFFSET_DIGITS + 2;
+    size_t asciiStart = hexStart + HexColumnWidth(layout) + 2;
+
+    char* row = out.data() + start;
+    for (size_t r = 0; r < rows; r++, row += width + 1, offset += perRow) {
+        const uint8_t* bytes = data + r * perRow;
+        size_t count = std::min(perRow, size - r * perRow);
+
+        for (size_t d = 0; d < OFFSET_DIGITS; d++) {
+            row[d] = HEX_DIGITS[(offset >> ((OFFSET_DIGITS - 1 - d) * 4)) & 0x0F];
+        }
+        PlaceHex(bytes, count, row + hexStart, position);
+        if (layout.ascii) {
+            row[asciiStart] = '|';
+            PlaceAscii(bytes, count, row + asciiStart + 1);
+            row[asciiStart + 1 + perRow] = '|';
+        }
+        row[width] = '\n';
+    }
+}
+
+void FormatHexBytes(const uint8_t* data, size_t size, std::string& out) {
+    if (size == 0) return;
+    size_t start = out.size();
+    out.resize(start + size * 3 - 1, ' ');
+    PlaceHex(data, size, out.data() + start, [](size_t i) { return i * 3; });
+}
+
+HexDocument::HexDocument() {
+    Reset({});
+}
+
+HexDocument::HexDocument(std::vector<uint8_t> original) {
+    Reset(std::move(original));
+}
+
+void HexDocument::Reset(std::vector<uint8_t> original) {
+    m_original = std::move(original);
+    m_added.clear();
+    m_nodes.assign(1, Node{});
+    m_free.clear();
+    m_edits.clear();
+    m_current = 0;
+    m_seed = 0;
+
+    m_root = NIL;
+    if (!m_original.empty()) m_root = NewNode(Piece{false, 0, m_original.size()});
+}
+
+size_t HexDocument::Size() const {
+    return m_nodes[m_root].length;
+}
+
+size_t HexDocument::PieceCount() const {
+    return m_nodes[m_root].count;
+}
+
+HexDocument::Ref HexDocument::NewNode(const Piece& piece) {
+    Node node;
+    node.piece = piece;
+    node.priority = NextPriority(m_seed);
+    node.length = piece.length;
+    node.count = 1;
+
+    if (!m_free.empty()) {
+        Ref ref = m_free.back();
+        m_free.pop_back();
+        m_nodes[ref] = node;
+        return ref;
+    }
+    m_nodes.push_back(node);
+    return static_cast<Ref>(m_nodes.size() - 1);
+}
+
+void HexDocument::FreeTree(Ref ref, std::vector<Piece>* pieces) {
+    if (ref == NIL) return;
+    FreeTree(m_nodes[ref].left, pieces);
+    if (pieces) pieces->push_back(m_nodes[ref].piece);
+    FreeTree(m_nodes[ref].right, pieces);
+    m_free.push_back(ref);
+}
+
+void HexDocument::Update(Ref ref) {
+    Node& node = m_nodes[ref];
+    node.length = m_nodes[node.left].length + node.piece.length + m_nodes[node.right].length;
+    node.count = m_nodes[node.left].count + 1 + m_nodes[node.right].count;
+}
+
+std::pair<HexDocument::Ref, HexDocument::Ref> HexDocument::Split(Ref ref, size_t pos) {
+    if (pos == 0) return { NIL, ref };
+    if (pos >= m_nodes[ref].length) return { ref, NIL };
+
+    size_t leftLength = m_nodes[m_nodes[ref].left].length;
+    size_t pieceLength = m_nodes[ref].piece.length;
+
+    if (pos <= leftLength) {
+        auto [first, second] = Split(m_nodes[ref].left, pos);
+        m_nodes[ref].left = second;
+        Update(ref);
+        return { first, ref };
+    }
+    if (pos >= leftLength + pieceLength) {
+        auto [first, second] = Split(m_nodes[ref].right, pos - leftLength - pieceLength);
+        m_nodes[ref].right = first;
+        Update(ref);
+        return { ref, second };
+    }
+
+    // Cut the piece itself. The second half gets its own priority (halves
+    // sharing one would chain up over repeated cuts) and is merged with the
+    // right subtree.
+    size_t cut = pos - leftLength;
+    Piece piece = m_nodes[ref].piece;
+    Ref right = m_nodes[ref].right;
+    m_nodes[ref].piece.length = cut;
+    m_nodes[ref].right = NIL;
+    Update(ref);
+
+    Ref second = NewNode(Piece{piece.added, piece.offset + cut, piece.length - cut});
+    return { ref, Merge(second, right) };
+}
+
+HexDocument::Ref HexDocument::Merge(Ref left, Ref right) {
+    if (left == NIL) return right;
+    if (right == NIL) return left;
+
+    if (m_nodes[left].priority > m_nodes[right].priority) {
+        Ref merged = Merge(m_nodes[left].right, right);
+        m_nodes[left].right = merged;
+        Update(left);
+        return left;
+    }
+    Ref merged = Merge(left, m_nodes[right].left);
+    m_nodes[right].left = merged;
+    Update(right);
+    return right;
+}
+
+bool HexDocument::ExtendLast(Ref ref, const Piece& piece) {
+    if (ref == NIL) return false;
+    Node& node = m_nodes[ref];
+    if (node.right != NIL) {
+        if (!ExtendLast(node.right, piece)) return false;
+    } else {
+        // Only a piece that ends where this one starts in the same buffer
+        if (node.piece.added != piece.added || node.piece.offset + node.piece.length != piece.offset) return false;
+        node.piece.length += piece.length;
+    }
+    Update(ref);
+    return true;
+}
+
+void HexDocument::Copy(Ref ref, size_t pos, size_t count, uint8_t*& out) const {
+    if (ref == NIL || count == 0) return;
+    const Node& node = m_nodes[ref];
+    size_t leftLength = m_nodes[node.left].length;
+
+    if (pos < leftLength) {
+        size_t take = std::min(count, leftLength - pos);
+        Copy(node.left, pos, take, out);
+        pos += take;
+        count -= take;
+    }
+    if (count == 0) return;
+
+    size_t inPiece = pos - leftLength;
+    if (inPiece < node.piece.length) {
+        size_t take = std::min(count, node.piece.length - inPiece);
+        const uint8_t* source = node.piece.added ? m_added.data() : m_original.data();
+        std::memcpy(out, source + node.piece.offset + inPiece, take);
+        out += take;
+        inPiece += take;
+        count -= take;
+    }
+    if (count == 0) return;
+
+    Copy(node.right, inPiece - node.piece.length, count, out);
+}
+
+size_t HexDocument::Read(size_t pos, size_t count, uint8_t* out) const {
+    size_t size = Size();
+    if (pos >= size) return 0;
+    count = std::min(count, size - pos);
+    Copy(m_root, pos, count, out);
+    return count;
+}
+
+std::vector<uint8_t> HexDocument::Bytes() const {
+    std::vector<uint8_t> bytes(Size());
+    Read(0, bytes.size(), bytes.data());
+    return bytes;
+}
+
+void HexDocument::Replace(size_t pos, size_t eraseLength, const std::vector<Piece>& pieces,
+                          std::vector<Piece>* erased) {
+    auto [left, rest] = Split(m_root, pos);
+    auto [middle, right] = Split(rest, eraseLength);
+    FreeTree(middle, erased);
+
+    // A piece that continues the one before it (typing straight on from the
+    // previous edit, or halves of a cut put back by undo) grows that piece
+    for (const Piece& piece : pieces) {
+        if (!ExtendLast(left, piece)) left = Merge(left, NewNode(piece));
+    }
+
+    // Likewise where the inserted pieces meet the rest
+    if (left != NIL && right != NIL) {
+        Ref first = right;
+        while (m_nodes[first].left != NIL) first = m_nodes[first].left;
+        Piece piece = m_nodes[first].piece;
+        if (ExtendLast(left, piece)) {
+            auto [head, tail] = Split(right, piece.length);
+            FreeTree(head, nullptr);
+            right = tail;
+        }
+    }
+    m_root = Merge(left, right);
+}
+
+void HexDocument::Record(size_t pos, size_t eraseLength, std::span<const uint8_t> bytes) {
+    Edit edit;
+    edit.pos = pos;
+    edit.removedLength = eraseLength;
+    edit.insertedLength = bytes.size();
+    if (!bytes.empty()) {
+        edit.inserted.push_back(Piece{true, m_added.size(), bytes.size()});
+        m_added.insert(m_added.end(), bytes.begin(), bytes.end());
+    }
+    Replace(pos, eraseLength, edit.inserted, &edit.removed);
+
+    m_edits.resize(m_current);
+    m_edits.push_back(std::move(edit));
+    m_current++;
+}
+
+bool HexDocument::Insert(size_t pos, std::span<const uint8_t> bytes) {
+    if (pos > Size()) return false;
+    if (!bytes.empty()) Record(pos, 0, bytes);
+    return true;
+}
+
+bool HexDocument::Erase(size_t pos, size_t count) {
+    size_t size = Size();
+    if (pos > size || count > size - pos) return false;
+    if (count > 0) Record(pos, count, {});
+    return true;
+}
+
+bool HexDocument::Overwrite(size_t pos, std::span<const uint8_t> bytes) {
+    size_t size = Size();
+    if (pos > size) return false;
+    if (!bytes.empty()) Record(pos, std::min(bytes.size(), size - pos), bytes);
+    return true;
+}
+
+bool HexDocument::Undo() {
+    if (!CanUndo()) return false;
+    const Edit& edit = m_edits[--m_current];
+    Replace(edit.pos, edit.insertedLength, edit.removed, nullptr);
+    return true;
+}
+
+bool HexDocument::Redo() {
+    if (!CanRedo()) return false;
+    const Edit& edit = m_edits[m_current++];
+    Replace(edit.pos, edit.removedLength, edit.inserted, nullptr);
+    return true;
+}
+
+void HexDocument::FormatRows(size_t firstRow, size_t rowCount, const HexLayout& layout, std::string& out) const {
+    if (layout.bytesPerRow == 0) return;
+    size_t pos = firstRow * layout.bytesPerRow;
+    std::vector<uint8_t> bytes(rowCount * layout.bytesPerRow);
+    size_t count = Read(pos, bytes.size(), bytes.data());
+    FormatHexRows(bytes.data(), count, pos, layout, out);
+}
+
+} // namespace core
@@ -0,0 +1,125 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Editing model for binary value data. The original bytes are never
+ * modified: typed bytes go to an append-only buffer and the document is a
+ * sequence of pieces of either buffer, kept in a balanced tree (a treap
+ * ordered by position and summed by length). Insert, erase and overwrite
+ * split and join the tree in O(log pieces). Each edit records the pieces
+ * it removed and added, so undo and redo are edits of their own and the
+ * history costs a few pieces per step, not a copy of the data.
+ *
+ * Views read and format only the rows on screen; see FormatHexRows.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace core {
+
+struct HexLayout {
+    size_t bytesPerRow = 16;
+    size_t groupSize = 8;           // Extra space after this many bytes; 0 = none
+    bool ascii = true;              // Printable-ASCII column after the hex
+};
+
+// Characters in one formatted row, without the line break
+size_t HexRowWidth(const HexLayout& layout);
+
+// Append rows of "OOOOOOOO  XX XX ...  |ascii|\n" for data, which starts
+// at offset. Every row is HexRowWidth() characters plus '\n'; a short last
+// row is padded with spaces so rows can be addressed by index.
+void FormatHexRows(const uint8_t* data, size_t size, uint64_t offset,
+                   const HexLayout& layout, std::string& out);
+
+// Append "XX XX XX" (upper case, single spaces)
+void FormatHexBytes(const uint8_t* data, size_t size, std::string& out);
+
+class HexDocument {
+public:
+    HexDocument();
+    explicit HexDocument(std::vector<uint8_t> original);
+
+    // Start over on new data; clears the history
+    void Reset(std::vector<uint8_t> original);
+
+    size_t Size() const;
+    size_t PieceCount() const;
+    bool IsModified() const { return m_current != 0; }
+
+    // Copy up to count bytes from pos; returns the number copied
+    size_t Read(size_t pos, size_t count, uint8_t* out) const;
+    std::vector<uint8_t> Bytes() const;
+
+    // Each successful edit is one undo step. Positions past the end fail;
+    // Overwrite may run past the end and extends the data.
+    bool Insert(size_t pos, std::span<const uint8_t> bytes);
+    bool Erase(size_t pos, size_t count);
+    bool Overwrite(size_t pos, std::span<const uint8_t> bytes);
+
+    bool CanUndo() const { return m_current > 0; }
+    bool CanRedo() const { return m_current < m_edits.size(); }
+    bool Undo();
+    bool Redo();
+
+    // Format rowCount rows starting at row firstRow (see FormatHexRows)
+    void FormatRows(size_t firstRow, size_t rowCount, const HexLayout& layout, std::string& out) const;
+
+private:
+    using Ref = uint32_t;
+    static constexpr Ref NIL = 0;
+
+    struct Piece {
+        bool added = false;         // From m_added rather than m_original
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    struct Node {
+        Piece piece;
+        Ref left = NIL;
+        Ref right = NIL;
+        uint32_t priority = 0;
+        size_t length = 0;          // Bytes in this subtree
+        uint32_t count = 0;         // Pieces in this subtree
+    };
+
+    // One undo step: at pos, removed was replaced by inserted
+    struct Edit {
+        size_t pos = 0;
+        size_t removedLength = 0;
+        size_t insertedLength = 0;
+        std::vector<Piece> removed;
+        std::vector<Piece> inserted;
+    };
+
+    Ref NewNode(const Piece& piece);
+    void FreeTree(Ref ref, std::vector<Piece>* pieces);
+    void Update(Ref ref);
+
+    std::pair<Ref, Ref> Split(Ref ref, size_t pos);
+    Ref Merge(Ref left, Ref right);
+    bool ExtendLast(Ref ref, const Piece& piece);
+    void Copy(Ref ref, size_t pos, size_t count, uint8_t*& out) const;
+
+    // Replace eraseLength bytes at pos with pieces; the erased pieces go to erased
+    void Replace(size_t pos, size_t eraseLength, const std::vector<Piece>& pieces, std::vector<Piece>* erased);
+    void Record(size_t pos, size_t eraseLength, std::span<const uint8_t> bytes);
+
+    std::vector<uint8_t> m_original;
+    std::vector<uint8_t> m_added;           // Append-only; undone edits still point into it
+    std::vector<Node> m_nodes;              // m_nodes[NIL] is an empty sentinel
+    std::vector<Ref> m_free;                // Nodes released by erases
+    Ref m_root = NIL;
+    std::vector<Edit> m_edits;
+    size_t m_current = 0;                   // Edits applied; the rest can be redone
+    uint64_t m_seed = 0;
+};
+
+} // namespace core
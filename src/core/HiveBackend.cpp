@@ -0,0 +1,203 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Read-only backend over an offline regf hive file.
+ */
+
+#include "HiveBackend.h"
+
+#include <memory>
+#include <mutex>
+
+namespace core {
+
+namespace {
+
+// Compare a raw hive name against a string, case-insensitively
+int CompareRawName(const uint8_t* name, size_t length, bool compressed, std::wstring_view other) {
+    size_t count = compressed ? length : length / 2;
+    size_t common = (count < other.size()) ? count : other.size();
+    for (size_t i = 0; i < common; i++) {
+        wchar_t c = compressed ? static_cast<wchar_t>(name[i])
+                               : static_cast<wchar_t>(name[i * 2] | (name[i * 2 + 1] << 8));
+        wchar_t a = FoldChar(c);
+        wchar_t b = FoldChar(other[i]);
+        if (a != b) return (a < b) ? -1 : 1;
+    }
+    if (count == other.size()) return 0;
+    return (count < other.size()) ? -1 : 1;
+}
+
+// The nk cells from the opened root down to a key. A subkey list that
+// points back at one of them would make the tree endless, so such a child
+// is refused, as is any key deeper than the registry allows.
+struct KeyPath {
+    uint32_t cell;
+    size_t depth;
+    std::shared_ptr<const KeyPath> parent;
+};
+
+using KeyPathPtr = std::shared_ptr<const KeyPath>;
+
+KeyPathPtr ExtendPath(const KeyPathPtr& path, uint32_t cell) {
+    if (path && path->depth >= MAX_KEY_DEPTH) return nullptr;
+    for (const KeyPath* step = path.get(); step; step = step->parent.get()) {
+        if (step->cell == cell) return nullptr;
+    }
+    return std::make_shared<const KeyPath>(KeyPath{ cell, path ? path->depth + 1 : 0, path });
+}
+
+class HiveKey : public RegistryKey {
+public:
+    HiveKey(const HiveReader& reader, const HiveKeyNode& node, KeyPathPtr path)
+        : m_reader(reader), m_node(node), m_path(std::move(path)) {}
+
+    bool QueryInfo(KeyInfo& info) const override {
+        info.subKeyCount = m_node.subKeyCount;
+        info.valueCount = m_node.valueCount;
+        info.lastWriteTime = m_node.lastWriteTime;
+        return true;
+    }
+
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override {
+        const std::vector<uint32_t>& cells = SubKeyCells();
+        HiveKeyNode child;
+        if (index >= cells.size() || !m_reader.ReadKeyNode(cells[index], child)) return false;
+        name = HiveReader::DecodeName(child.name, child.nameLength, child.compressedName);
+        return true;
+    }
+
+    bool EnumValue(uint32_t index, RegValue& value) const override {
+        const std::vector<uint32_t>& cells = ValueCells();
+        HiveValueNode node;
+        if (index >= cells.size() || !m_reader.ReadValueNode(cells[index], node)) return false;
+        value.name = HiveReader::DecodeName(node.name, node.nameLength, node.compressedName);
+        value.type = node.type;
+        return m_reader.ReadValueData(node, value.data);
+    }
+
+    bool GetValue(std::wstring_view name, RegValue& value) const override {
+        HiveValueNode node;
+        for (uint32_t cell : ValueCells()) {
+            if (!m_reader.ReadValueNode(cell, node)) continue;
+            if (CompareRawName(node.name, node.nameLength, node.compressedName, name) != 0) continue;
+            value.name.assign(name);
+            value.type = node.type;
+            return m_reader.ReadValueData(node, value.data);
+        }
+        return false;
+    }
+
+    // The first component is looked up in this key's cached list, so
+    // opening each child of a key in turn reads the list only once
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        HiveKeyNode node = m_node;
+        KeyPathPtr keyPath = m_path;
+        std::vector<uint32_t> cells;
+        bool first = true;
+        for (std::wstring_view part : SplitPath(path)) {
+            if (first) {
+                if (!FindChild(SubKeyCells(), part, node)) return nullptr;
+                first = false;
+            } else if (!m_reader.GetSubKeyCells(node, cells) || !FindChild(cells, part, node)) {
+                return nullptr;
+            }
+            keyPath = ExtendPath(keyPath, node.offset);
+            if (!keyPath) return nullptr;
+        }
+        return std::make_unique<HiveKey>(m_reader, node, std::move(keyPath));
+    }
+
+    void GetSubKeyNames(std::vector<std::wstring>& names) const override {
+        names.clear();
+        HiveKeyNode child;
+        for (uint32_t cell : SubKeyCells()) {
+            if (m_reader.ReadKeyNode(cell, child)) {
+                names.push_back(HiveReader::DecodeName(child.name, child.nameLength, child.compressedName));
+            }
+        }
+    }
+
+    void GetValueSummaries(std::vector<ValueSummary>& values) const override {
+        values.clear();
+        HiveValueNode node;
+        for (uint32_t cell : ValueCells()) {
+            if (m_reader.ReadValueNode(cell, node)) {
+                values.push_back({ HiveReader::DecodeName(node.name, node.nameLength, node.compressedName),
+                                   node.type, node.dataSize });
+            }
+        }
+    }
+
+private:
+    // Subkey lists are sorted by upper-case name, so lookups binary search
+    bool FindChild(const std::vector<uint32_t>& cells, std::wstring_view name, HiveKeyNode& found) const {
+        size_t low = 0;
+        size_t high = cells.size();
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            HiveKeyNode child;
+            if (!m_reader.ReadKeyNode(cells[mid], child)) return false;
+            int order = CompareRawName(child.name, child.nameLength, child.compressedName, name);
+            if (order == 0) {
+                found = child;
+                return true;
+            }
+            if (order < 0) low = mid + 1;
+            else high = mid;
+        }
+        return false;
+    }
+
+    const std::vector<uint32_t>& SubKeyCells() const {
+        std::call_once(m_subKeysLoaded, [this] { m_reader.GetSubKeyCells(m_node, m_subKeys); });
+        return m_subKeys;
+    }
+
+    const std::vector<uint32_t>& ValueCells() const {
+        std::call_once(m_valuesLoaded, [this] { m_reader.GetValueCells(m_node, m_values); });
+        return m_values;
+    }
+
+    const HiveReader& m_reader;
+    HiveKeyNode m_node;
+    KeyPathPtr m_path;
+    mutable std::once_flag m_subKeysLoaded;
+    mutable std::once_flag m_valuesLoaded;
+    mutable std::vector<uint32_t> m_subKeys;
+    mutable std::vector<uint32_t> m_values;
+};
+
+} // namespace
+
+bool HiveBackend::Open(const std::filesystem::path& path) {
+    if (!m_file.Open(path)) return false;
+    return m_reader.Open(m_file.Data(), m_file.Size());
+}
+
+bool HiveBackend::OpenRecovered(const std::filesystem::path& path, HiveRecoveryStats& stats, std::wstring& error) {
+    if (!RecoverHive(path, FindHiveLogs(path), m_file, stats, error)) return false;
+    if (!m_reader.Open(m_file.Data(), m_file.Size())) {
+        error = L"Not a valid hive: " + path.wstring();
+        return false;
+    }
+    return true;
+}
+
+bool HiveBackend::Attach(const uint8_t* data, size_t size) {
+    m_file.Close();
+    return m_reader.Open(data, size);
+}
+
+KeyPtr HiveBackend::OpenRoot() {
+    return OpenCell(m_reader.RootCell());
+}
+
+KeyPtr HiveBackend::OpenCell(uint32_t offset) const {
+    HiveKeyNode node;
+    if (!m_reader.Data() || !m_reader.ReadKeyNode(offset, node)) return nullptr;
+    return std::make_unique<HiveKey>(m_reader, node, ExtendPath(nullptr, offset));
+}
+
+} // namespace core
@@ -0,0 +1,46 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Read-only backend over an offline regf hive file (memory-mapped).
+ */
+
+#pragma once
+
+#include "HiveReader.h"
+#include "HiveRecovery.h"
+#include "MappedFile.h"
+#include "RegistryBackend.h"
+
+#include <filesystem>
+#include <string>
+
+namespace core {
+
+class HiveBackend : public RegistryBackend {
+public:
+    HiveBackend() = default;
+
+    // Memory-map and validate a hive file
+    bool Open(const std::filesystem::path& path);
+
+    // Like Open, but a dirty hive is brought up to date from the .LOG1/.LOG2
+    // files next to it, in a private view; the files are not written
+    bool OpenRecovered(const std::filesystem::path& path, HiveRecoveryStats& stats, std::wstring& error);
+
+    // Use a hive image owned by the caller (must outlive the backend)
+    bool Attach(const uint8_t* data, size_t size);
+
+    KeyPtr OpenRoot() override;
+
+    // Open a key directly by its nk cell offset
+    KeyPtr OpenCell(uint32_t offset) const;
+
+    const HiveReader& Reader() const { return m_reader; }
+
+private:
+    MappedFile m_file;
+    HiveReader m_reader;
+};
+
+} // namespace core
@@ -0,0 +1,474 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Raw hive cell scanner.
+ */
+
+#include "HiveCellScanner.h"
+#include "RegistryTypes.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REGSTUDIO_HAVE_SSE2 1
+#endif
+
+namespace core {
+
+using namespace hive;
+
+namespace {
+
+constexpr uint32_t MAX_PATH_DEPTH = 512;           // Guards against parent cycles
+constexpr uint32_t MAX_PLAUSIBLE_DATA = 1u << 30;
+
+// One bit per 8-byte cell slot across all hbins
+class SlotBitmap {
+public:
+    explicit SlotBitmap(uint32_t hbinsSize) : m_words((hbinsSize / CELL_ALIGNMENT + 63) / 64) {}
+
+    // Bins never share a word (4 KB alignment), so per-bin writers need no atomics
+    void Set(uint32_t offset) {
+        uint32_t slot = offset / CELL_ALIGNMENT;
+        m_words[slot / 64] |= uint64_t{1} << (slot % 64);
+    }
+
+    // Returns true if the bit was newly set
+    bool SetAtomic(uint32_t offset) {
+        uint32_t slot = offset / CELL_ALIGNMENT;
+        if (slot / 64 >= m_words.size()) return false;
+        uint64_t bit = uint64_t{1} << (slot % 64);
+        return (std::atomic_ref<uint64_t>(m_words[slot / 64]).fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+
+    bool Test(uint32_t offset) const {
+        uint32_t slot = offset / CELL_ALIGNMENT;
+        if (slot / 64 >= m_words.size()) return false;
+        return (m_words[slot / 64] >> (slot % 64)) & 1;
+    }
+
+    size_t WordCount() const { return m_words.size(); }
+    uint64_t Word(size_t index) const { return m_words[index]; }
+
+private:
+    std::vector<uint64_t> m_words;
+};
+
+struct Bin {
+    uint32_t offset;
+    uint32_t size;
+};
+
+enum class NameIssue { None, EmbeddedNul, InvalidUtf16 };
+
+NameIssue CheckName(const uint8_t* name, size_t length, bool compressed) {
+    if (compressed) {
+        return std::find(name, name + length, 0) != name + length ? NameIssue::EmbeddedNul : NameIssue::None;
+    }
+    if (length % 2 != 0) return NameIssue::InvalidUtf16;
+
+    NameIssue issue = NameIssue::None;
+    for (size_t i = 0; i < length; i += 2) {
+        uint16_t unit = static_cast<uint16_t>(name[i] | (name[i + 1] << 8));
+        if (unit == 0) {
+            issue = NameIssue::EmbeddedNul;
+        } else if (unit >= 0xD800 && unit <= 0xDBFF) {
+            uint16_t next = (i + 3 < length) ? static_cast<uint16_t>(name[i + 2] | (name[i + 3] << 8)) : 0;
+            if (next < 0xDC00 || next > 0xDFFF) return NameIssue::InvalidUtf16;
+            i += 2;
+        } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+            return NameIssue::InvalidUtf16;
+        }
+    }
+    return issue;
+}
+
+bool IsSignature(uint8_t first) {
+    return first == 'n' || first == 'v' || first == 's';
+}
+
+// Find positions of nk/vk/sk signatures in [begin, end) of the image. A
+// record header sits on an 8-byte boundary, so its signature's 'k' is always
+// at an offset of 5 mod 8; hits are reported as record (header) offsets.
+void FindSignatures(const uint8_t* image, size_t begin, size_t end, std::vector<size_t>& hits) {
+    size_t i = begin & ~size_t{7};
+#ifdef REGSTUDIO_HAVE_SSE2
+    const __m128i letterK = _mm_set1_epi8('k');
+    for (; i + 16 <= end; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(image + i));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, letterK))) & 0x2020u;
+        while (mask) {
+            unsigned bit = static_cast<unsigned>(std::countr_zero(mask));
+            size_t record = i + bit - 5;
+            if (record >= begin && IsSignature(image[i + bit - 1])) hits.push_back(record);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i + 6 <= end; i += 8) {
+        if (image[i + 5] == 'k' && IsSignature(image[i + 4]) && i >= begin) hits.push_back(i);
+    }
+}
+
+class CellScanner {
+public:
+    CellScanner(const HiveReader& reader, const CellScanOptions& options)
+        : m_reader(reader), m_options(options), m_allocated(reader.HbinsSize()), m_referenced(reader.HbinsSize()),
+          m_threadCount(options.threadCount ? options.threadCount : WorkQueue<int>::DefaultThreadCount()) {}
+
+    CellScanStats Run(std::vector<CellFinding>& findings) {
+        CellScanStats stats;
+        std::vector<CellFinding> corruptBins;
+        FindBins(corruptBins);
+        stats.bins = m_bins.size();
+
+        std::vector<std::vector<CellFinding>> perThread(m_threadCount);
+        std::vector<CellScanStats> binStats(m_threadCount);
+        ParallelOverBins([&](size_t first, size_t last, unsigned worker) {
+            for (size_t i = first; i < last && !m_options.stopToken.stop_requested(); i++) {
+                WalkBin(m_bins[i], perThread[worker], binStats[worker]);
+            }
+        });
+        for (const CellScanStats& partial : binStats) {
+            stats.allocatedCells += partial.allocatedCells;
+            stats.freeCells += partial.freeCells;
+            stats.freeBytes += partial.freeBytes;
+            stats.signatureHits += partial.signatureHits;
+        }
+
+        if (m_options.findOrphans || m_options.checkNames) MarkReachable(perThread);
+
+        // After an interrupted walk every cell not yet marked would look
+        // orphaned, so a cancelled scan reports nothing
+        stats.cancelled = m_options.stopToken.stop_requested();
+        if (stats.cancelled) return stats;
+        if (m_options.findOrphans) FindOrphans(perThread);
+
+        for (CellFinding& finding : corruptBins) findings.push_back(std::move(finding));
+        for (auto& partial : perThread) {
+            for (CellFinding& finding : partial) findings.push_back(std::move(finding));
+        }
+        ResolveDeletedValues(findings);
+        std::sort(findings.begin(), findings.end(),
+            [](const CellFinding& a, const CellFinding& b) { return a.offset < b.offset; });
+        return stats;
+    }
+
+private:
+    const uint8_t* BinData() const { return m_reader.Data() + BASE_BLOCK_SIZE; }
+
+    void FindBins(std::vector<CellFinding>& findings) {
+        uint32_t offset = 0;
+        uint32_t total = m_reader.HbinsSize();
+        while (offset + HBIN_HEADER_SIZE <= total) {
+            const uint8_t* bin = BinData() + offset;
+            uint32_t size = ReadU32(bin + HBIN_SIZE);
+            bool valid = ReadU32(bin) == HBIN_SIGNATURE && ReadU32(bin + HBIN_OFFSET) == offset &&
+                         size >= HBIN_ALIGNMENT && size % HBIN_ALIGNMENT == 0 && size <= total - offset;
+            if (valid) {
+                m_bins.push_back({ offset, size });
+                offset += size;
+                continue;
+            }
+            // Resynchronise on the next 4 KB boundary
+            CellFinding finding;
+            finding.kind = CellFindingKind::CorruptBin;
+            finding.offset = offset;
+            findings.push_back(std::move(finding));
+            offset = (offset / HBIN_ALIGNMENT + 1) * HBIN_ALIGNMENT;
+        }
+    }
+
+    // Split bins into contiguous ranges of roughly equal byte size
+    template <typename Fn>
+    void ParallelOverBins(Fn fn) {
+        std::vector<size_t> bounds{ 0 };
+        uint64_t target = static_cast<uint64_t>(m_reader.HbinsSize()) / m_threadCount + 1;
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < m_bins.size(); i++) {
+            accumulated += m_bins[i].size;
+            if (accumulated >= target * bounds.size() && bounds.size() < m_threadCount) bounds.push_back(i + 1);
+        }
+        while (bounds.size() <= m_threadCount) bounds.push_back(m_bins.size());
+
+        std::vector<std::jthread> threads;
+        for (unsigned worker = 1; worker < m_threadCount; worker++) {
+            threads.emplace_back([&fn, &bounds, worker] { fn(bounds[worker], bounds[worker + 1], worker); });
+        }
+        fn(bounds[0], bounds[1], 0);
+    }
+
+    void WalkBin(const Bin& bin, std::vector<CellFinding>& findings, CellScanStats& stats) {
+        uint32_t offset = bin.offset + HBIN_HEADER_SIZE;
+        uint32_t end = bin.offset + bin.size;
+        std::vector<size_t> hits;
+
+        while (offset + CELL_HEADER_SIZE <= end) {
+            int32_t rawSize = static_cast<int32_t>(ReadU32(BinData() + offset));
+            uint32_t size = (rawSize < 0) ? static_cast<uint32_t>(-static_cast<int64_t>(rawSize)) : static_cast<uint32_t>(rawSize);
+            if (size < CELL_ALIGNMENT || size % CELL_ALIGNMENT != 0 || size > end - offset) {
+                CellFinding finding;
+                finding.kind = CellFindingKind::CorruptBin;
+                finding.offset = offset;
+                findings.push_back(std::move(finding));
+                return;
+            }
+
+            if (rawSize < 0) {
+                m_allocated.Set(offset);
+                stats.allocatedCells++;
+            } else {
+                stats.freeCells++;
+                stats.freeBytes += size;
+                if (m_options.scanFreeCells) {
+                    size_t begin = BASE_BLOCK_SIZE + static_cast<size_t>(offset);
+                    hits.clear();
+                    FindSignatures(m_reader.Data(), begin, begin + size, hits);
+                    stats.signatureHits += hits.size();
+                    for (size_t hit : hits) {
+                        ValidateDeleted(static_cast<uint32_t>(hit - BASE_BLOCK_SIZE), offset + size, findings);
+                    }
+                }
+            }
+            offset += size;
+        }
+    }
+
+    // Check a candidate record inside free space [record, limit)
+    void ValidateDeleted(uint32_t record, uint32_t limit, std::vector<CellFinding>& findings) {
+        const uint8_t* cell = BinData() + record;
+        uint32_t available = limit - record;
+
+        // A record that was coalesced into a larger free cell keeps its old
+        // (negative) size, which bounds it more tightly
+        int32_t oldSize = static_cast<int32_t>(ReadU32(cell));
+        if (oldSize < 0 && static_cast<uint32_t>(-static_cast<int64_t>(oldSize)) <= available) {
+            available = static_cast<uint32_t>(-static_cast<int64_t>(oldSize));
+        }
+        if (available <= CELL_HEADER_SIZE) return;
+        const uint8_t* payload = cell + CELL_HEADER_SIZE;
+        uint32_t payloadSize = available - CELL_HEADER_SIZE;
+        uint16_t signature = ReadU16(payload);
+
+        CellFinding finding;
+        finding.kind = CellFindingKind::DeletedKey;
+        finding.offset = record;
+
+        if (signature == SIG_NK) {
+            if (payloadSize < NK_NAME) return;
+            uint16_t nameLength = ReadU16(payload + NK_NAME_LENGTH);
+            uint16_t flags = ReadU16(payload + NK_FLAGS);
+            if (nameLength == 0 || NK_NAME + static_cast<uint32_t>(nameLength) > payloadSize || flags >= 0x1000) return;
+            finding.name = HiveReader::DecodeName(payload + NK_NAME, nameLength, (flags & KEY_COMP_NAME) != 0);
+            finding.lastWriteTime = ReadU64(payload + NK_TIMESTAMP);
+            std::wstring parentPath = HiveCellPath(m_reader, ReadU32(payload + NK_PARENT));
+            finding.path = parentPath.empty() ? finding.name : parentPath + L"\\" + finding.name;
+        } else if (signature == SIG_VK) {
+            if (payloadSize < VK_NAME) return;
+            uint16_t nameLength = ReadU16(payload + VK_NAME_LENGTH);
+            uint32_t dataSize = ReadU32(payload + VK_DATA_SIZE) & ~DATA_RESIDENT;
+            if (VK_NAME + static_cast<uint32_t>(nameLength) > payloadSize || dataSize > MAX_PLAUSIBLE_DATA) return;
+            bool compressed = (ReadU16(payload + VK_FLAGS) & VALUE_COMP_NAME) != 0;
+            finding.kind = CellFindingKind::DeletedValue;
+            finding.name = HiveReader::DecodeName(payload + VK_NAME, nameLength, compressed);
+            finding.valueType = ReadU32(payload + VK_TYPE);
+            finding.dataSize = dataSize;
+        } else if (signature == SIG_SK) {
+            if (payloadSize < SK_DESCRIPTOR) return;
+            uint32_t descriptorSize = ReadU32(payload + SK_DESCRIPTOR_SIZE);
+            if (descriptorSize < 20 || SK_DESCRIPTOR + static_cast<uint64_t>(descriptorSize) > payloadSize) return;
+            if (payload[SK_DESCRIPTOR] != 1) return;  // Security descriptor revision
+            finding.kind = CellFindingKind::DeletedSecurity;
+            finding.dataSize = descriptorSize;
+        } else {
+            return;
+        }
+        findings.push_back(std::move(finding));
+    }
+
+    // Mark every cell reachable from the root and check live names
+    void MarkReachable(std::vector<std::vector<CellFinding>>& perThread) {
+        WorkQueue<uint32_t> queue(m_threadCount, m_options.stopToken);
+        queue.Push(m_reader.RootCell());
+
+        queue.Run([&](uint32_t& offset, std::vector<uint32_t>& out, unsigned worker) {
+            HiveKeyNode node;
+            if (!m_referenced.SetAtomic(offset) || !m_reader.ReadKeyNode(offset, node)) return;
+            std::vector<CellFinding>& findings = perThread[worker];
+
+            if (m_options.checkNames) CheckLiveName(node.name, node.nameLength, node.compressedName, offset, offset, findings);
+            Mark(node.className);
+            Mark(node.security);
+
+            thread_local std::vector<uint32_t> cells;
+            if (node.subKeyCount) MarkSubKeyLists(node.subKeyList);
+            if (m_reader.GetSubKeyCells(node, cells)) {
+                out.insert(out.end(), cells.begin(), cells.end());
+            }
+
+            Mark(node.valueList);
+            if (m_reader.GetValueCells(node, cells)) {
+                for (uint32_t cell : cells) MarkValue(cell, offset, findings);
+            }
+        });
+    }
+
+    void Mark(uint32_t offset) {
+        if (offset != INVALID_CELL) m_referenced.SetAtomic(offset);
+    }
+
+    void MarkSubKeyLists(uint32_t listOffset) {
+        uint32_t size = 0;
+        const uint8_t* list = m_reader.Cell(listOffset, &size);
+        if (!list) return;
+        Mark(listOffset);
+        if (size < LIST_ENTRIES || ReadU16(list) != SIG_RI) return;
+        uint32_t count = ReadU16(list + LIST_COUNT);
+        for (uint32_t i = 0; i < count && LIST_ENTRIES + (i + 1) * 4 <= size; i++) {
+            Mark(ReadU32(list + LIST_ENTRIES + i * 4));
+        }
+    }
+
+    void MarkValue(uint32_t offset, uint32_t keyOffset, std::vector<CellFinding>& findings) {
+        HiveValueNode value;
+        if (!m_reader.ReadValueNode(offset, value)) return;
+        Mark(offset);
+        if (m_options.checkNames) CheckLiveName(value.name, value.nameLength, value.compressedName, offset, keyOffset, findings);
+        if (value.resident || value.dataSize == 0) return;
+
+        uint32_t size = 0;
+        const uint8_t* data = m_reader.Cell(value.dataOffset, &size);
+        if (!data) return;
+        Mark(value.dataOffset);
+
+        bool bigData = m_reader.MinorVersion() >= BIG_DATA_MIN_VERSION && value.dataSize > BIG_DATA_SEGMENT_SIZE &&
+                       size >= 8 && ReadU16(data) == SIG_DB;
+        if (!bigData) return;
+        uint32_t listOffset = ReadU32(data + DB_SEGMENT_LIST);
+        uint32_t listSize = 0;
+        const uint8_t* segments = m_reader.Cell(listOffset, &listSize);
+        if (!segments) return;
+        Mark(listOffset);
+        uint32_t count = ReadU16(data + DB_SEGMENT_COUNT);
+        for (uint32_t i = 0; i < count && (i + 1) * 4 <= listSize; i++) {
+            Mark(ReadU32(segments + i * 4));
+        }
+    }
+
+    void CheckLiveName(const uint8_t* name, size_t length, bool compressed, uint32_t offset,
+                       uint32_t keyOffset, std::vector<CellFinding>& findings) {
+        NameIssue issue = CheckName(name, length, compressed);
+        if (issue == NameIssue::None) return;
+        CellFinding finding;
+        finding.kind = issue == NameIssue::EmbeddedNul ? CellFindingKind::NameWithNul : CellFindingKind::InvalidUtf16Name;
+        finding.offset = offset;
+        finding.name = HiveReader::DecodeName(name, length, compressed);
+        finding.path = HiveCellPath(m_reader, keyOffset);
+        findings.push_back(std::move(finding));
+    }
+
+    // Allocated cells that were never marked
+    void FindOrphans(std::vector<std::vector<CellFinding>>& perThread) {
+        size_t words = m_allocated.WordCount();
+        size_t perWorker = words / m_threadCount + 1;
+
+        std::vector<std::jthread> threads;
+        auto scan = [&](unsigned worker) {
+            size_t first = std::min(words, worker * perWorker);
+            size_t last = std::min(words, first + perWorker);
+            for (size_t w = first; w < last; w++) {
+                uint64_t orphans = m_allocated.Word(w) & ~m_referenced.Word(w);
+                while (orphans) {
+                    uint32_t slot = static_cast<uint32_t>(w * 64 + std::countr_zero(orphans));
+                    orphans &= orphans - 1;
+                    ReportOrphan(slot * CELL_ALIGNMENT, perThread[worker]);
+                }
+            }
+        };
+        for (unsigned worker = 1; worker < m_threadCount; worker++) threads.emplace_back(scan, worker);
+        scan(0);
+    }
+
+    void ReportOrphan(uint32_t offset, std::vector<CellFinding>& findings) {
+        uint32_t size = 0;
+        const uint8_t* cell = m_reader.Cell(offset, &size);
+        if (!cell) return;
+
+        CellFinding finding;
+        finding.kind = CellFindingKind::OrphanedCell;
+        finding.offset = offset;
+        finding.dataSize = size;
+        uint16_t signature = (size >= 2) ? ReadU16(cell) : 0;
+
+        HiveKeyNode key;
+        HiveValueNode value;
+        if (signature == SIG_NK && m_reader.ReadKeyNode(offset, key)) {
+            finding.kind = CellFindingKind::OrphanedKey;
+            finding.name = HiveReader::DecodeName(key.name, key.nameLength, key.compressedName);
+            finding.lastWriteTime = key.lastWriteTime;
+            finding.path = HiveCellPath(m_reader, offset);
+        } else if (signature == SIG_VK && m_reader.ReadValueNode(offset, value)) {
+            finding.kind = CellFindingKind::OrphanedValue;
+            finding.name = HiveReader::DecodeName(value.name, value.nameLength, value.compressedName);
+            finding.valueType = value.type;
+            finding.dataSize = value.dataSize;
+        }
+        findings.push_back(std::move(finding));
+    }
+
+    // A deleted value's data is recoverable while its cell has not been reallocated
+    void ResolveDeletedValues(std::vector<CellFinding>& findings) {
+        for (CellFinding& finding : findings) {
+            if (finding.kind == CellFindingKind::DeletedValue) {
+                const uint8_t* payload = BinData() + finding.offset + CELL_HEADER_SIZE;
+                bool resident = (ReadU32(payload + VK_DATA_SIZE) & DATA_RESIDENT) != 0;
+                uint32_t dataOffset = ReadU32(payload + VK_DATA_OFFSET);
+                finding.dataRecoverable = resident || finding.dataSize == 0 ||
+                    (m_reader.Cell(dataOffset) != nullptr && !m_allocated.Test(dataOffset));
+            }
+        }
+    }
+
+    const HiveReader& m_reader;
+    const CellScanOptions& m_options;
+    SlotBitmap m_allocated;     // Start of every allocated cell
+    SlotBitmap m_referenced;    // Cells reachable from the root
+    unsigned m_threadCount;
+    std::vector<Bin> m_bins;
+};
+
+} // namespace
+
+std::wstring HiveCellPath(const HiveReader& reader, uint32_t keyOffset) {
+    std::vector<std::wstring> parts;
+    HiveKeyNode node;
+    uint32_t offset = keyOffset;
+    for (uint32_t depth = 0; depth < MAX_PATH_DEPTH && reader.ReadKeyNode(offset, node); depth++) {
+        if (node.flags & KEY_HIVE_ENTRY) break;  // The root itself is not part of paths
+        parts.push_back(HiveReader::DecodeName(node.name, node.nameLength, node.compressedName));
+        offset = node.parent;
+    }
+
+    std::wstring path;
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+        if (!path.empty()) path += L'\\';
+        path += *it;
+    }
+    return path;
+}
+
+CellScanStats ScanHiveCells(const HiveReader& reader, std::vector<CellFinding>& findings,
+                            const CellScanOptions& options) {
+    findings.clear();
+    if (!reader.Data()) return {};
+    CellScanner scanner(reader, options);
+    return scanner.Run(findings);
+}
+
+} // namespace core
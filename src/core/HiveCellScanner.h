@@ -0,0 +1,71 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Raw hive cell scanner. Walks every hbin of a regf image (the "real"
+ * registry view, below the Win32 API) to recover deleted keys, values and
+ * security cells from free space, report allocated cells that nothing
+ * references, and flag names the Win32 API cannot show (embedded NULs,
+ * invalid UTF-16).
+ */
+
+#pragma once
+
+#include "HiveReader.h"
+
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class CellFindingKind {
+    DeletedKey,         // nk record in free space
+    DeletedValue,       // vk record in free space
+    DeletedSecurity,    // sk record in free space
+    OrphanedKey,        // Allocated nk not reachable from the root
+    OrphanedValue,      // Allocated vk not reachable from the root
+    OrphanedCell,       // Other allocated cell not reachable from the root
+    NameWithNul,        // Live key or value name containing a NUL
+    InvalidUtf16Name,   // Live key or value name with unpaired surrogates
+    CorruptBin          // hbin header missing or inconsistent
+};
+
+struct CellFinding {
+    CellFindingKind kind = CellFindingKind::DeletedKey;
+    uint32_t offset = 0;            // Cell offset relative to the first hbin
+    std::wstring name;              // Key or value name exactly as stored
+    std::wstring path;              // Best-effort path of the key (or of the key holding the value)
+    uint64_t lastWriteTime = 0;     // Key records
+    uint32_t valueType = 0;         // Value records
+    uint32_t dataSize = 0;
+    bool dataRecoverable = false;   // Deleted value whose data has not been reused
+};
+
+struct CellScanOptions {
+    unsigned threadCount = 0;       // 0 = one per hardware thread
+    std::stop_token stopToken;
+    bool scanFreeCells = true;      // Deleted records
+    bool findOrphans = true;        // Unreferenced allocated cells
+    bool checkNames = true;         // Hidden names on live keys and values
+};
+
+struct CellScanStats {
+    uint64_t bins = 0;
+    uint64_t allocatedCells = 0;
+    uint64_t freeCells = 0;
+    uint64_t freeBytes = 0;
+    uint64_t signatureHits = 0;     // Candidate records before validation
+    bool cancelled = false;
+};
+
+// Findings are returned sorted by offset. A cancelled scan adds none, as
+// its partial walk cannot tell orphaned cells from unvisited ones.
+CellScanStats ScanHiveCells(const HiveReader& reader, std::vector<CellFinding>& findings,
+                            const CellScanOptions& options = {});
+
+// Best-effort path of a key cell, following parent links up to the root
+std::wstring HiveCellPath(const HiveReader& reader, uint32_t keyOffset);
+
+} // namespace core
@@ -0,0 +1,271 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Hive compaction and binary export.
+ */
+
+#include "HiveCompact.h"
+#include "MappedFile.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+using namespace hive;
+
+namespace {
+
+using NamedCell = std::pair<std::wstring, uint32_t>;
+
+struct SourceFrame {
+    uint32_t cell = INVALID_CELL;
+    std::vector<NamedCell> children;
+    size_t next = 0;
+};
+
+struct ExportFrame {
+    KeyPtr key;
+    std::vector<std::wstring> children;
+    size_t next = 0;
+};
+
+bool ByName(const NamedCell& a, const NamedCell& b) {
+    return CompareNames(a.first, b.first) < 0;
+}
+
+// Begin a source key, copy its values and collect its subkeys in order
+bool CopySourceKey(const HiveReader& source, uint32_t cell, HiveWriter& writer, SourceFrame& frame,
+                   std::vector<uint32_t>& cells, std::vector<uint8_t>& data) {
+    HiveKeyNode node;
+    if (!source.ReadKeyNode(cell, node)) return false;
+
+    std::wstring name = HiveReader::DecodeName(node.name, node.nameLength, node.compressedName);
+    std::wstring className;
+    uint32_t classSize = 0;
+    if (node.classNameLength) {
+        if (const uint8_t* text = source.Cell(node.className, &classSize)) {
+            className = HiveReader::DecodeName(text, std::min<uint32_t>(node.classNameLength, classSize), false);
+        }
+    }
+
+    HiveKeyRecord record;
+    record.name = name;
+    record.lastWriteTime = node.lastWriteTime;
+    record.className = className;
+    record.flags = node.flags;
+    const uint8_t* descriptor = nullptr;
+    uint32_t descriptorSize = 0;
+    if (source.ReadSecurity(node.security, descriptor, descriptorSize)) {
+        record.security = std::span<const uint8_t>(descriptor, descriptorSize);
+    }
+    if (!writer.BeginKey(record)) return false;
+    frame.cell = cell;
+
+    if (source.GetValueCells(node, cells)) {
+        for (uint32_t valueCell : cells) {
+            HiveValueNode value;
+            if (!source.ReadValueNode(valueCell, value) || !source.ReadValueData(value, data)) continue;
+            std::wstring valueName = HiveReader::DecodeName(value.name, value.nameLength, value.compressedName);
+            if (!writer.AddValue(valueName, value.type, data)) return false;
+        }
+    }
+
+    frame.children.clear();
+    frame.next = 0;
+    if (source.GetSubKeyCells(node, cells)) {
+        HiveKeyNode child;
+        for (uint32_t childCell : cells) {
+            if (!source.ReadKeyNode(childCell, child)) continue;
+            frame.children.emplace_back(HiveReader::DecodeName(child.name, child.nameLength, child.compressedName), childCell);
+        }
+        // Lists of a healthy hive are already sorted; repair anything else
+        if (!std::is_sorted(frame.children.begin(), frame.children.end(), ByName)) {
+            std::stable_sort(frame.children.begin(), frame.children.end(), ByName);
+        }
+        frame.children.erase(std::unique(frame.children.begin(), frame.children.end(),
+            [](const NamedCell& a, const NamedCell& b) { return NamesEqual(a.first, b.first); }), frame.children.end());
+    }
+    return true;
+}
+
+// A damaged subkey list can point back at an ancestor; copying it would
+// never end, so only cells not already on the stack are descended into
+bool OnStack(const std::vector<SourceFrame>& stack, size_t depth, uint32_t cell) {
+    return std::any_of(stack.begin(), stack.begin() + depth,
+        [cell](const SourceFrame& frame) { return frame.cell == cell; });
+}
+
+bool WriteCompacted(const HiveReader& source, HiveWriter& writer, std::stop_token stopToken, HiveCompactReport& report) {
+    std::vector<SourceFrame> stack(1);
+    std::vector<uint32_t> cells;
+    std::vector<uint8_t> data;
+    if (!CopySourceKey(source, source.RootCell(), writer, stack[0], cells, data)) return false;
+
+    size_t depth = 1;
+    while (depth > 0) {
+        if (stopToken.stop_requested()) {
+            report.cancelled = true;
+            return false;
+        }
+        SourceFrame& frame = stack[depth - 1];
+        if (frame.next == frame.children.size()) {
+            if (!writer.EndKey()) return false;
+            depth--;
+            continue;
+        }
+
+        uint32_t cell = frame.children[frame.next++].second;
+        if (depth > MAX_KEY_DEPTH || OnStack(stack, depth, cell)) {
+            report.skippedKeys++;
+            continue;
+        }
+        if (stack.size() == depth) stack.emplace_back();
+        if (!CopySourceKey(source, cell, writer, stack[depth], cells, data)) return false;
+        depth++;
+    }
+    return writer.Finish();
+}
+
+bool BeginExportKey(const RegistryKey& key, std::wstring_view name, HiveWriter& writer, ExportFrame& frame,
+                    std::vector<RegValue>& values) {
+    KeyInfo info;
+    HiveKeyRecord record;
+    record.name = name;
+    if (key.QueryInfo(info)) record.lastWriteTime = info.lastWriteTime;
+    if (!writer.BeginKey(record)) return false;
+
+    key.GetValues(values);
+    for (const RegValue& value : values) {
+        if (!writer.AddValue(value.name, value.type, value.data)) return false;
+    }
+
+    key.GetSubKeyNames(frame.children);
+    std::sort(frame.children.begin(), frame.children.end(),
+        [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; });
+    frame.next = 0;
+    return true;
+}
+
+bool WriteExport(const RegistryKey& root, std::wstring_view rootName, HiveWriter& writer, std::stop_token stopToken,
+                 std::wstring& error) {
+    std::vector<ExportFrame> stack(1);
+    std::vector<RegValue> values;
+    if (!BeginExportKey(root, rootName, writer, stack[0], values)) return false;
+
+    size_t depth = 1;
+    while (depth > 0) {
+        if (stopToken.stop_requested()) return false;
+        if (stack.size() == depth) stack.emplace_back();
+        ExportFrame& frame = stack[depth - 1];
+        const RegistryKey& key = depth == 1 ? root : *frame.key;
+        if (frame.next == frame.children.size()) {
+            frame.key.reset();
+            if (!writer.EndKey()) return false;
+            depth--;
+            continue;
+        }
+
+        if (depth > MAX_KEY_DEPTH) {
+            error = L"Keys are nested too deeply";
+            return false;
+        }
+        const std::wstring& name = frame.children[frame.next++];
+        KeyPtr child = key.OpenSubKey(name);
+        if (!child) continue;   // Access denied or deleted meanwhile
+        ExportFrame& childFrame = stack[depth];
+        childFrame.key = std::move(child);
+        if (!BeginExportKey(*childFrame.key, name, writer, childFrame, values)) return false;
+        depth++;
+    }
+    return writer.Finish();
+}
+
+} // namespace
+
+HiveFragmentation MeasureFragmentation(const HiveReader& reader) {
+    HiveFragmentation result;
+    result.fileSize = reader.Size();
+    result.hbinsSize = reader.HbinsSize();
+
+    const uint8_t* bins = reader.Data() + BASE_BLOCK_SIZE;
+    uint32_t offset = 0;
+    while (offset + HBIN_HEADER_SIZE <= reader.HbinsSize()) {
+        uint32_t binSize = ReadU32(bins + offset + HBIN_SIZE);
+        if (ReadU32(bins + offset) != HBIN_SIGNATURE || binSize < HBIN_ALIGNMENT ||
+            binSize > reader.HbinsSize() - offset) {
+            break;
+        }
+        result.bins++;
+
+        uint32_t end = offset + binSize;
+        uint32_t cell = offset + HBIN_HEADER_SIZE;
+        while (cell + CELL_HEADER_SIZE <= end) {
+            int32_t rawSize = static_cast<int32_t>(ReadU32(bins + cell));
+            uint32_t size = rawSize < 0 ? static_cast<uint32_t>(-static_cast<int64_t>(rawSize)) : static_cast<uint32_t>(rawSize);
+            if (size < CELL_ALIGNMENT || size > end - cell) break;
+            if (rawSize < 0) {
+                result.allocatedCells++;
+                result.allocatedBytes += size;
+            } else {
+                result.freeCells++;
+                result.freeBytes += size;
+                result.largestFreeCell = std::max<uint64_t>(result.largestFreeCell, size);
+            }
+            cell += size;
+        }
+        offset = end;
+    }
+    return result;
+}
+
+bool CompactHive(const HiveReader& source, const std::filesystem::path& destination,
+                 HiveCompactReport& report, std::stop_token stopToken) {
+    report = {};
+    report.before = MeasureFragmentation(source);
+
+    bool written = false;
+    {
+        HiveWriter writer;
+        written = writer.Create(destination) && WriteCompacted(source, writer, stopToken, report);
+        report.writer = writer.Stats();
+        if (!written && !report.cancelled) report.error = writer.HasError() ? writer.Error() : L"Source hive is damaged";
+    }
+
+    if (written) {
+        MappedFile output;
+        HiveReader result;
+        if (output.Open(destination) && result.Open(output.Data(), output.Size())) {
+            report.after = MeasureFragmentation(result);
+            return true;
+        }
+        report.error = L"Written hive failed to reopen";
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove(destination, ignored);
+    return false;
+}
+
+bool ExportHive(const RegistryKey& key, std::wstring_view rootName, const std::filesystem::path& destination,
+                HiveWriterStats& stats, std::wstring& error, std::stop_token stopToken) {
+    bool written = false;
+    {
+        HiveWriter writer;
+        error.clear();
+        written = writer.Create(destination) && WriteExport(key, rootName, writer, stopToken, error);
+        stats = writer.Stats();
+        if (writer.HasError()) error = writer.Error();
+    }
+    if (written) return true;
+
+    std::error_code ignored;
+    std::filesystem::remove(destination, ignored);
+    return false;
+}
+
+} // namespace core
@@ -0,0 +1,63 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Hive compaction and binary export on top of HiveWriter: rewriting a hive
+ * drops free cells, unreachable cells and duplicate security descriptors.
+ */
+
+#pragma once
+
+#include "HiveReader.h"
+#include "HiveWriter.h"
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+struct HiveFragmentation {
+    uint64_t fileSize = 0;
+    uint64_t hbinsSize = 0;
+    uint64_t bins = 0;
+    uint64_t allocatedCells = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t freeCells = 0;
+    uint64_t freeBytes = 0;
+    uint64_t largestFreeCell = 0;
+
+    // Share of the hbin area that is free space (0..1)
+    double FreeRatio() const { return hbinsSize ? static_cast<double>(freeBytes) / hbinsSize : 0.0; }
+};
+
+struct HiveCompactReport {
+    HiveFragmentation before;
+    HiveFragmentation after;
+    HiveWriterStats writer;
+    uint64_t skippedKeys = 0;       // Subkeys that loop back to an ancestor or nest too deep
+    std::wstring error;
+    bool cancelled = false;
+};
+
+// Walk the hbins of a hive and total allocated and free cells
+HiveFragmentation MeasureFragmentation(const HiveReader& reader);
+
+// Rewrite a hive into a packed copy. Keys, values, class names, security
+// descriptors, flags and timestamps are preserved; a subkey that is one of
+// its own ancestors is left out. The destination is removed again on
+// failure or cancellation.
+bool CompactHive(const HiveReader& source, const std::filesystem::path& destination,
+                 HiveCompactReport& report, std::stop_token stopToken = {});
+
+// Save a key of any backend as a standalone hive whose root is named
+// rootName. Security descriptors are not available through RegistryKey, so
+// every key shares a default descriptor. Keys nested deeper than
+// MAX_KEY_DEPTH fail the export.
+bool ExportHive(const RegistryKey& key, std::wstring_view rootName, const std::filesystem::path& destination,
+                HiveWriterStats& stats, std::wstring& error, std::stop_token stopToken = {});
+
+} // namespace core
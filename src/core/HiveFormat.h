@@ -0,0 +1,177 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * On-disk layout of regf hive files (base block, hbins and cells).
+ * All integers are little-endian; cell offsets are relative to the first
+ * hbin, which starts right after the 4 KB base block.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace core::hive {
+
+// Base block
+constexpr uint32_t BASE_BLOCK_SIZE = 4096;
+constexpr uint32_t REGF_SIGNATURE = 0x66676572;     // "regf"
+constexpr uint32_t BASE_PRIMARY_SEQUENCE = 4;
+constexpr uint32_t BASE_SECONDARY_SEQUENCE = 8;
+constexpr uint32_t BASE_TIMESTAMP = 12;
+constexpr uint32_t BASE_MAJOR_VERSION = 20;
+constexpr uint32_t BASE_MINOR_VERSION = 24;
+constexpr uint32_t BASE_FILE_TYPE = 28;
+constexpr uint32_t BASE_FILE_FORMAT = 32;
+constexpr uint32_t BASE_ROOT_CELL = 36;
+constexpr uint32_t BASE_HBINS_SIZE = 40;
+constexpr uint32_t BASE_CLUSTERING = 44;
+constexpr uint32_t BASE_FILE_NAME = 48;
+constexpr uint32_t BASE_FILE_NAME_SIZE = 64;
+constexpr uint32_t BASE_CHECKSUM = 508;             // XOR of the first 127 dwords
+
+constexpr uint32_t FILE_TYPE_PRIMARY = 0;
+constexpr uint32_t FILE_TYPE_LOG1 = 1;              // Old-format transaction log
+constexpr uint32_t FILE_TYPE_LOG2 = 2;              // Old-format transaction log (alternate)
+constexpr uint32_t FILE_TYPE_LOG6 = 6;              // New-format (Windows 8.1+) transaction log
+
+// Hive bins
+constexpr uint32_t HBIN_SIGNATURE = 0x6E696268;     // "hbin"
+constexpr uint32_t HBIN_HEADER_SIZE = 32;
+constexpr uint32_t HBIN_ALIGNMENT = 4096;
+constexpr uint32_t HBIN_OFFSET = 4;                 // Offset of this bin from the first bin
+constexpr uint32_t HBIN_SIZE = 8;
+constexpr uint32_t HBIN_TIMESTAMP = 20;
+
+// Cells: a signed 32-bit size (negative = allocated) followed by the payload
+constexpr uint32_t CELL_HEADER_SIZE = 4;
+constexpr uint32_t CELL_ALIGNMENT = 8;
+constexpr uint32_t INVALID_CELL = 0xFFFFFFFF;
+
+// Cell signatures (first two payload bytes)
+constexpr uint16_t SIG_NK = 0x6B6E;                 // "nk" key node
+constexpr uint16_t SIG_VK = 0x6B76;                 // "vk" value
+constexpr uint16_t SIG_SK = 0x6B73;                 // "sk" security
+constexpr uint16_t SIG_LF = 0x666C;                 // "lf" leaf with name hints
+constexpr uint16_t SIG_LH = 0x686C;                 // "lh" leaf with name hashes
+constexpr uint16_t SIG_LI = 0x696C;                 // "li" plain leaf
+constexpr uint16_t SIG_RI = 0x6972;                 // "ri" index of leaves
+constexpr uint16_t SIG_DB = 0x6264;                 // "db" big data
+
+// Key node (nk) field offsets within the payload
+constexpr uint32_t NK_FLAGS = 2;
+constexpr uint32_t NK_TIMESTAMP = 4;
+constexpr uint32_t NK_ACCESS_BITS = 12;
+constexpr uint32_t NK_PARENT = 16;
+constexpr uint32_t NK_SUBKEY_COUNT = 20;
+constexpr uint32_t NK_VOLATILE_SUBKEY_COUNT = 24;
+constexpr uint32_t NK_SUBKEY_LIST = 28;
+constexpr uint32_t NK_VOLATILE_SUBKEY_LIST = 32;
+constexpr uint32_t NK_VALUE_COUNT = 36;
+constexpr uint32_t NK_VALUE_LIST = 40;
+constexpr uint32_t NK_SECURITY = 44;
+constexpr uint32_t NK_CLASS_NAME = 48;
+constexpr uint32_t NK_MAX_SUBKEY_NAME = 52;
+constexpr uint32_t NK_MAX_SUBKEY_CLASS = 56;
+constexpr uint32_t NK_MAX_VALUE_NAME = 60;
+constexpr uint32_t NK_MAX_VALUE_DATA = 64;
+constexpr uint32_t NK_WORK_VAR = 68;
+constexpr uint32_t NK_NAME_LENGTH = 72;
+constexpr uint32_t NK_CLASS_LENGTH = 74;
+constexpr uint32_t NK_NAME = 76;
+
+constexpr uint16_t KEY_VOLATILE = 0x0001;
+constexpr uint16_t KEY_HIVE_EXIT = 0x0002;
+constexpr uint16_t KEY_HIVE_ENTRY = 0x0004;         // Root key
+constexpr uint16_t KEY_NO_DELETE = 0x0008;
+constexpr uint16_t KEY_SYM_LINK = 0x0010;
+constexpr uint16_t KEY_COMP_NAME = 0x0020;          // Name stored as Latin-1
+
+// Value (vk) field offsets within the payload
+constexpr uint32_t VK_NAME_LENGTH = 2;
+constexpr uint32_t VK_DATA_SIZE = 4;
+constexpr uint32_t VK_DATA_OFFSET = 8;
+constexpr uint32_t VK_TYPE = 12;
+constexpr uint32_t VK_FLAGS = 16;
+constexpr uint32_t VK_NAME = 20;
+
+constexpr uint16_t VALUE_COMP_NAME = 0x0001;        // Name stored as Latin-1
+constexpr uint32_t DATA_RESIDENT = 0x80000000;      // Data (<= 4 bytes) lives in VK_DATA_OFFSET
+
+// Security (sk) field offsets within the payload
+constexpr uint32_t SK_FLINK = 4;
+constexpr uint32_t SK_BLINK = 8;
+constexpr uint32_t SK_REFERENCE_COUNT = 12;
+constexpr uint32_t SK_DESCRIPTOR_SIZE = 16;
+constexpr uint32_t SK_DESCRIPTOR = 20;
+
+// Subkey lists: signature, count, then 4-byte (li/ri) or 8-byte (lf/lh) entries
+constexpr uint32_t LIST_COUNT = 2;
+constexpr uint32_t LIST_ENTRIES = 4;
+
+// Big data (db): segment count and offset of the segment list
+constexpr uint32_t DB_SEGMENT_COUNT = 2;
+constexpr uint32_t DB_SEGMENT_LIST = 4;
+constexpr uint32_t BIG_DATA_SEGMENT_SIZE = 16344;   // Largest data cell payload
+constexpr uint32_t BIG_DATA_MIN_VERSION = 4;        // Minor version introducing db cells
+
+// Transaction logs (.LOG1/.LOG2) start with the checksummed part of a base
+// block; the rest follows at LOG_DATA
+constexpr uint32_t LOG_BASE_BLOCK_SIZE = 512;
+constexpr uint32_t LOG_DATA = 512;
+constexpr uint32_t LOG_SECTOR_SIZE = 512;
+
+// Old format: "DIRT", then one bit per 512-byte sector of the hbin area,
+// then the dirty sectors in order from the next sector boundary
+constexpr uint32_t DIRT_SIGNATURE = 0x54524944;     // "DIRT"
+constexpr uint32_t DIRT_BITMAP = 4;
+
+// New format: a run of log entries, each a multiple of 512 bytes. Hashes
+// are Marvin32 (seed LOG_HASH_SEED) of the entry from HVLE_PAGES to its
+// end (hash 1) and of its first 32 bytes (hash 2).
+constexpr uint32_t HVLE_SIGNATURE = 0x454C7648;     // "HvLE"
+constexpr uint32_t HVLE_SIZE = 4;
+constexpr uint32_t HVLE_FLAGS = 8;
+constexpr uint32_t HVLE_SEQUENCE = 12;
+constexpr uint32_t HVLE_HBINS_SIZE = 16;
+constexpr uint32_t HVLE_PAGE_COUNT = 20;
+constexpr uint32_t HVLE_HASH1 = 24;
+constexpr uint32_t HVLE_HASH2 = 32;
+constexpr uint32_t HVLE_PAGES = 40;                 // Page table: offset (from the first hbin) and size
+constexpr uint32_t HVLE_PAGE_ENTRY_SIZE = 8;
+constexpr uint32_t LOG_PAGE_SIZE = 4096;            // New-format dirty pages are whole pages
+constexpr uint64_t LOG_HASH_SEED = 0x82EF4D887A4E55C5ull;
+
+inline uint16_t ReadU16(const uint8_t* p) {
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t ReadU32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t ReadU64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline void WriteU16(uint8_t* p, uint16_t value) { std::memcpy(p, &value, sizeof(value)); }
+inline void WriteU32(uint8_t* p, uint32_t value) { std::memcpy(p, &value, sizeof(value)); }
+inline void WriteU64(uint8_t* p, uint64_t value) { std::memcpy(p, &value, sizeof(value)); }
+
+// XOR checksum of the first 508 bytes of a base block (0 and -1 are remapped)
+inline uint32_t BaseBlockChecksum(const uint8_t* base) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < BASE_CHECKSUM; i += 4) sum ^= ReadU32(base + i);
+    if (sum == 0xFFFFFFFF) return 0xFFFFFFFE;
+    if (sum == 0) return 1;
+    return sum;
+}
+
+} // namespace core::hive
@@ -0,0 +1,220 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Bounds-checked reader for regf hive images.
+ */
+
+#include "HiveReader.h"
+#include "RegistryTypes.h"
+
+namespace core {
+
+using namespace hive;
+
+bool HiveReader::Open(const uint8_t* data, size_t size) {
+    m_data = nullptr;
+    m_size = 0;
+    if (!data || size < BASE_BLOCK_SIZE + HBIN_HEADER_SIZE) return false;
+    if (ReadU32(data) != REGF_SIGNATURE) return false;
+    if (ReadU32(data + BASE_MAJOR_VERSION) != 1) return false;
+
+    m_data = data;
+    m_size = size;
+    m_rootCell = ReadU32(data + BASE_ROOT_CELL);
+    m_minorVersion = ReadU32(data + BASE_MINOR_VERSION);
+    m_hbinsSize = ReadU32(data + BASE_HBINS_SIZE);
+    m_lastWriteTime = ReadU64(data + BASE_TIMESTAMP);
+    m_dirty = ReadU32(data + BASE_PRIMARY_SEQUENCE) != ReadU32(data + BASE_SECONDARY_SEQUENCE);
+
+    // Trust the file size over a corrupt hbins size field
+    if (m_hbinsSize == 0 || m_hbinsSize > size - BASE_BLOCK_SIZE) {
+        m_hbinsSize = static_cast<uint32_t>(size - BASE_BLOCK_SIZE);
+    }
+
+    HiveKeyNode root;
+    return ReadKeyNode(m_rootCell, root);
+}
+
+const uint8_t* HiveReader::Cell(uint32_t offset, uint32_t* payloadSize) const {
+    if (offset == INVALID_CELL || (offset & 7) != 0) return nullptr;
+    uint64_t start = static_cast<uint64_t>(BASE_BLOCK_SIZE) + offset;
+    if (start + CELL_HEADER_SIZE > BASE_BLOCK_SIZE + static_cast<uint64_t>(m_hbinsSize)) return nullptr;
+
+    int32_t rawSize = static_cast<int32_t>(ReadU32(m_data + start));
+    uint64_t cellSize = (rawSize < 0) ? static_cast<uint64_t>(-static_cast<int64_t>(rawSize)) : static_cast<uint64_t>(rawSize);
+    if (cellSize < CELL_HEADER_SIZE || start + cellSize > BASE_BLOCK_SIZE + static_cast<uint64_t>(m_hbinsSize)) {
+        return nullptr;
+    }
+    if (payloadSize) *payloadSize = static_cast<uint32_t>(cellSize - CELL_HEADER_SIZE);
+    return m_data + start + CELL_HEADER_SIZE;
+}
+
+bool HiveReader::ReadKeyNode(uint32_t offset, HiveKeyNode& node) const {
+    uint32_t size = 0;
+    const uint8_t* cell = Cell(offset, &size);
+    if (!cell || size < NK_NAME || ReadU16(cell) != SIG_NK) return false;
+
+    node.offset = offset;
+    node.flags = ReadU16(cell + NK_FLAGS);
+    node.lastWriteTime = ReadU64(cell + NK_TIMESTAMP);
+    node.parent = ReadU32(cell + NK_PARENT);
+    node.subKeyCount = ReadU32(cell + NK_SUBKEY_COUNT);
+    node.subKeyList = ReadU32(cell + NK_SUBKEY_LIST);
+    node.valueCount = ReadU32(cell + NK_VALUE_COUNT);
+    node.valueList = ReadU32(cell + NK_VALUE_LIST);
+    node.security = ReadU32(cell + NK_SECURITY);
+    node.className = ReadU32(cell + NK_CLASS_NAME);
+    node.classNameLength = ReadU16(cell + NK_CLASS_LENGTH);
+    node.nameLength = ReadU16(cell + NK_NAME_LENGTH);
+    node.compressedName = (node.flags & KEY_COMP_NAME) != 0;
+    node.name = cell + NK_NAME;
+    if (NK_NAME + static_cast<uint32_t>(node.nameLength) > size) return false;
+    if (node.subKeyCount == 0) node.subKeyList = INVALID_CELL;
+    if (node.valueCount == 0) node.valueList = INVALID_CELL;
+    return true;
+}
+
+bool HiveReader::ReadValueNode(uint32_t offset, HiveValueNode& node) const {
+    uint32_t size = 0;
+    const uint8_t* cell = Cell(offset, &size);
+    if (!cell || size < VK_NAME || ReadU16(cell) != SIG_VK) return false;
+
+    uint32_t rawSize = ReadU32(cell + VK_DATA_SIZE);
+    node.offset = offset;
+    node.resident = (rawSize & DATA_RESIDENT) != 0;
+    node.dataSize = rawSize & ~DATA_RESIDENT;
+    node.dataOffset = ReadU32(cell + VK_DATA_OFFSET);
+    node.residentData = cell + VK_DATA_OFFSET;
+    node.type = ReadU32(cell + VK_TYPE);
+    node.nameLength = ReadU16(cell + VK_NAME_LENGTH);
+    node.compressedName = (ReadU16(cell + VK_FLAGS) & VALUE_COMP_NAME) != 0;
+    node.name = cell + VK_NAME;
+    if (node.resident && node.dataSize > 4) node.dataSize = 4;
+    return VK_NAME + static_cast<uint32_t>(node.nameLength) <= size;
+}
+
+bool HiveReader::AppendLeaf(uint32_t offset, std::vector<uint32_t>& cells) const {
+    uint32_t size = 0;
+    const uint8_t* list = Cell(offset, &size);
+    if (!list || size < LIST_ENTRIES) return false;
+
+    uint16_t signature = ReadU16(list);
+    uint32_t count = ReadU16(list + LIST_COUNT);
+    uint32_t stride = (signature == SIG_LF || signature == SIG_LH) ? 8 : 4;
+    if (signature != SIG_LF && signature != SIG_LH && signature != SIG_LI) return false;
+    if (LIST_ENTRIES + static_cast<uint64_t>(count) * stride > size) return false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        cells.push_back(ReadU32(list + LIST_ENTRIES + i * stride));
+    }
+    return true;
+}
+
+bool HiveReader::GetSubKeyCells(const HiveKeyNode& node, std::vector<uint32_t>& cells) const {
+    cells.clear();
+    if (node.subKeyCount == 0) return true;
+
+    uint32_t size = 0;
+    const uint8_t* list = Cell(node.subKeyList, &size);
+    if (!list || size < LIST_ENTRIES) return false;
+    cells.reserve(node.subKeyCount);
+
+    if (ReadU16(list) != SIG_RI) return AppendLeaf(node.subKeyList, cells);
+
+    // Index root: one level of indirection to lf/lh/li leaves
+    uint32_t count = ReadU16(list + LIST_COUNT);
+    if (LIST_ENTRIES + static_cast<uint64_t>(count) * 4 > size) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!AppendLeaf(ReadU32(list + LIST_ENTRIES + i * 4), cells)) return false;
+    }
+    return true;
+}
+
+bool HiveReader::GetValueCells(const HiveKeyNode& node, std::vector<uint32_t>& cells) const {
+    cells.clear();
+    if (node.valueCount == 0) return true;
+
+    uint32_t size = 0;
+    const uint8_t* list = Cell(node.valueList, &size);
+    if (!list || static_cast<uint64_t>(node.valueCount) * 4 > size) return false;
+
+    cells.resize(node.valueCount);
+    for (uint32_t i = 0; i < node.valueCount; i++) {
+        cells[i] = ReadU32(list + i * 4);
+    }
+    return true;
+}
+
+bool HiveReader::ReadValueData(const HiveValueNode& node, std::vector<uint8_t>& data) const {
+    data.clear();
+    if (node.dataSize == 0) return true;
+    if (node.resident) {
+        data.assign(node.residentData, node.residentData + node.dataSize);
+        return true;
+    }
+
+    uint32_t size = 0;
+    const uint8_t* cell = Cell(node.dataOffset, &size);
+    if (!cell) return false;
+
+    // Big data: a db record pointing at a list of segments
+    bool bigData = m_minorVersion >= BIG_DATA_MIN_VERSION && node.dataSize > BIG_DATA_SEGMENT_SIZE &&
+                   size >= 8 && ReadU16(cell) == SIG_DB;
+    if (!bigData) {
+        if (node.dataSize > size) return false;
+        data.assign(cell, cell + node.dataSize);
+        return true;
+    }
+
+    uint32_t segmentCount = ReadU16(cell + DB_SEGMENT_COUNT);
+    uint32_t listSize = 0;
+    const uint8_t* segments = Cell(ReadU32(cell + DB_SEGMENT_LIST), &listSize);
+    if (!segments || static_cast<uint64_t>(segmentCount) * 4 > listSize) return false;
+
+    data.reserve(node.dataSize);
+    for (uint32_t i = 0; i < segmentCount && data.size() < node.dataSize; i++) {
+        uint32_t segmentSize = 0;
+        const uint8_t* segment = Cell(ReadU32(segments + i * 4), &segmentSize);
+        if (!segment) return false;
+        size_t take = node.dataSize - data.size();
+        if (take > BIG_DATA_SEGMENT_SIZE) take = BIG_DATA_SEGMENT_SIZE;
+        if (take > segmentSize) return false;
+        data.insert(data.end(), segment, segment + take);
+    }
+    return data.size() == node.dataSize;
+}
+
+bool HiveReader::ReadSecurity(uint32_t offset, const uint8_t*& descriptor, uint32_t& size) const {
+    uint32_t cellSize = 0;
+    const uint8_t* cell = Cell(offset, &cellSize);
+    if (!cell || cellSize < SK_DESCRIPTOR || ReadU16(cell) != SIG_SK) return false;
+    size = ReadU32(cell + SK_DESCRIPTOR_SIZE);
+    if (SK_DESCRIPTOR + static_cast<uint64_t>(size) > cellSize) return false;
+    descriptor = cell + SK_DESCRIPTOR;
+    return true;
+}
+
+std::wstring HiveReader::DecodeName(const uint8_t* name, size_t length, bool compressed) {
+    std::wstring text;
+    if (compressed) {
+        text.resize(length);
+        for (size_t i = 0; i < length; i++) text[i] = static_cast<wchar_t>(name[i]);
+    } else {
+        text.resize(length / 2);
+        for (size_t i = 0; i < length / 2; i++) {
+            text[i] = static_cast<wchar_t>(name[i * 2] | (name[i * 2 + 1] << 8));
+        }
+    }
+    return text;
+}
+
+uint32_t HiveReader::NameHash(std::wstring_view name) {
+    uint32_t hash = 0;
+    for (wchar_t c : name) {
+        hash = hash * 37 + static_cast<uint16_t>(FoldChar(c));
+    }
+    return hash;
+}
+
+} // namespace core
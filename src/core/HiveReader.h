@@ -0,0 +1,103 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Bounds-checked reader for regf hive images held in memory (usually a
+ * memory-mapped file). All accessors validate offsets, so corrupt or
+ * hostile hives fail cleanly instead of reading out of range.
+ */
+
+#pragma once
+
+#include "HiveFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+// Decoded key node (nk). name points into the hive image.
+struct HiveKeyNode {
+    uint32_t offset = hive::INVALID_CELL;
+    uint16_t flags = 0;
+    uint64_t lastWriteTime = 0;
+    uint32_t parent = hive::INVALID_CELL;
+    uint32_t subKeyCount = 0;
+    uint32_t subKeyList = hive::INVALID_CELL;
+    uint32_t valueCount = 0;
+    uint32_t valueList = hive::INVALID_CELL;
+    uint32_t security = hive::INVALID_CELL;
+    uint32_t className = hive::INVALID_CELL;
+    uint16_t classNameLength = 0;
+    const uint8_t* name = nullptr;
+    uint16_t nameLength = 0;            // In bytes
+    bool compressedName = false;        // Latin-1 instead of UTF-16LE
+};
+
+// Decoded value (vk). name points into the hive image.
+struct HiveValueNode {
+    uint32_t offset = hive::INVALID_CELL;
+    uint32_t type = 0;
+    uint32_t dataSize = 0;              // Without the resident flag
+    uint32_t dataOffset = hive::INVALID_CELL;
+    bool resident = false;              // Data stored in the dataOffset field
+    const uint8_t* residentData = nullptr;
+    const uint8_t* name = nullptr;
+    uint16_t nameLength = 0;            // In bytes
+    bool compressedName = false;
+};
+
+class HiveReader {
+public:
+    HiveReader() = default;
+
+    // Attach to a hive image and validate its base block. The image must
+    // outlive the reader.
+    bool Open(const uint8_t* data, size_t size);
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+    uint32_t RootCell() const { return m_rootCell; }
+    uint32_t MinorVersion() const { return m_minorVersion; }
+    uint64_t LastWriteTime() const { return m_lastWriteTime; }
+    uint32_t HbinsSize() const { return m_hbinsSize; }
+    bool IsDirty() const { return m_dirty; }    // Primary and secondary sequence differ
+
+    // Cell payload (after the size field) or nullptr if out of range.
+    // payloadSize receives the usable payload size.
+    const uint8_t* Cell(uint32_t offset, uint32_t* payloadSize = nullptr) const;
+
+    bool ReadKeyNode(uint32_t offset, HiveKeyNode& node) const;
+    bool ReadValueNode(uint32_t offset, HiveValueNode& node) const;
+
+    // Flatten a key's subkey list (lf/lh/li and ri of those) into nk offsets
+    bool GetSubKeyCells(const HiveKeyNode& node, std::vector<uint32_t>& cells) const;
+    bool GetValueCells(const HiveKeyNode& node, std::vector<uint32_t>& cells) const;
+
+    // Value data, assembling big-data (db) segments when needed
+    bool ReadValueData(const HiveValueNode& node, std::vector<uint8_t>& data) const;
+
+    // Security descriptor bytes of an sk cell
+    bool ReadSecurity(uint32_t offset, const uint8_t*& descriptor, uint32_t& size) const;
+
+    static std::wstring DecodeName(const uint8_t* name, size_t length, bool compressed);
+
+    // Hash stored in lh leaves: hash * 37 + upper-case code unit
+    static uint32_t NameHash(std::wstring_view name);
+
+private:
+    bool AppendLeaf(uint32_t offset, std::vector<uint32_t>& cells) const;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    uint32_t m_rootCell = hive::INVALID_CELL;
+    uint32_t m_minorVersion = 0;
+    uint32_t m_hbinsSize = 0;
+    uint64_t m_lastWriteTime = 0;
+    bool m_dirty = false;
+};
+
+} // namespace core
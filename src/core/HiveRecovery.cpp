@@ -0,0 +1,341 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Transaction log replay. Logs are scanned into a list of validated
+ * entries (each new-format HvLE entry, or a whole old-format log), which
+ * are sorted by sequence number and replayed from the primary's last
+ * complete flush for as long as the numbers run without a gap. A flush
+ * found in both logs is applied once.
+ */
+
+#include "HiveRecovery.h"
+
+#include "HiveFormat.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+
+namespace core {
+
+using namespace hive;
+
+namespace {
+
+struct LogEntry {
+    uint32_t sequence = 0;
+    uint32_t hbinsSize = 0;
+    size_t log = 0;                     // Index into the log images
+    size_t offset = 0;                  // New format: entry; old format: first dirty sector
+    HiveLogFormat format = HiveLogFormat::Unknown;
+};
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint32_t RotateLeft(uint32_t value, int count) {
+    return (value << count) | (value >> (32 - count));
+}
+
+void MarvinMix(uint32_t& s0, uint32_t& s1, uint32_t value) {
+    s0 += value;
+    s1 ^= s0;
+    s0 = RotateLeft(s0, 20);
+    s0 += s1;
+    s1 = RotateLeft(s1, 9);
+    s1 ^= s0;
+    s0 = RotateLeft(s0, 27);
+    s0 += s1;
+    s1 = RotateLeft(s1, 19);
+}
+
+bool BaseBlockValid(std::span<const uint8_t> image) {
+    return image.size() >= LOG_BASE_BLOCK_SIZE && ReadU32(image.data()) == REGF_SIGNATURE &&
+           ReadU32(image.data() + BASE_CHECKSUM) == BaseBlockChecksum(image.data());
+}
+
+void ScanNewLog(std::span<const uint8_t> log, size_t index, HiveLogStatus& status, std::vector<LogEntry>& entries) {
+    size_t pos = LOG_DATA;
+    while (log.size() - pos >= HVLE_PAGES) {
+        const uint8_t* entry = log.data() + pos;
+        // Anything but an entry signature is the unused end of the log
+        if (ReadU32(entry) != HVLE_SIGNATURE) break;
+
+        std::wstring at = L"Entry at byte " + std::to_wstring(pos);
+        uint32_t size = ReadU32(entry + HVLE_SIZE);
+        if (size < HVLE_PAGES || size % LOG_SECTOR_SIZE != 0 || size > log.size() - pos) {
+            status.error = at + L" has a bad size";
+            break;
+        }
+        if (Marvin32(entry, HVLE_HASH2, LOG_HASH_SEED) != ReadU64(entry + HVLE_HASH2) ||
+            Marvin32(entry + HVLE_PAGES, size - HVLE_PAGES, LOG_HASH_SEED) != ReadU64(entry + HVLE_HASH1)) {
+            status.error = at + L" fails its hash check";
+            break;
+        }
+        uint32_t sequence = ReadU32(entry + HVLE_SEQUENCE);
+        if (status.entries > 0 && sequence != status.lastSequence + 1) {
+            status.error = at + L" is out of sequence";
+            break;
+        }
+
+        // The page table and the pages must fit the entry, and the pages the hbin area
+        uint32_t hbinsSize = ReadU32(entry + HVLE_HBINS_SIZE);
+        uint32_t pageCount = ReadU32(entry + HVLE_PAGE_COUNT);
+        uint64_t dataPos = HVLE_PAGES + uint64_t(pageCount) * HVLE_PAGE_ENTRY_SIZE;
+        bool ok = dataPos <= size && hbinsSize % HBIN_ALIGNMENT == 0;
+        for (uint32_t i = 0; ok && i < pageCount; i++) {
+            const uint8_t* page = entry + HVLE_PAGES + i * HVLE_PAGE_ENTRY_SIZE;
+            uint32_t offset = ReadU32(page);
+            uint32_t pageSize = ReadU32(page + 4);
+            ok = pageSize > 0 && offset % LOG_PAGE_SIZE == 0 && pageSize % LOG_PAGE_SIZE == 0 &&
+                 uint64_t(offset) + pageSize <= hbinsSize && dataPos + pageSize <= size;
+            dataPos += pageSize;
+        }
+        if (!ok) {
+            status.error = at + L" has a bad page list";
+            break;
+        }
+
+        entries.push_back({ sequence, hbinsSize, index, pos, HiveLogFormat::New });
+        if (status.entries++ == 0) status.firstSequence = sequence;
+        status.lastSequence = sequence;
+        pos += size;
+    }
+}
+
+void ScanOldLog(std::span<const uint8_t> log, size_t index, HiveLogStatus& status, std::vector<LogEntry>& entries) {
+    // The log is written in full before the primary, so a torn log is useless
+    const uint8_t* base = log.data();
+    uint32_t sequence = ReadU32(base + BASE_SECONDARY_SEQUENCE);
+    if (ReadU32(base + BASE_PRIMARY_SEQUENCE) != sequence) {
+        status.error = L"Log was not completely written";
+        return;
+    }
+    uint32_t hbinsSize = ReadU32(base + BASE_HBINS_SIZE);
+    size_t bitmapSize = (size_t(hbinsSize / LOG_SECTOR_SIZE) + 7) / 8;
+    size_t dataStart = LOG_DATA + DIRT_BITMAP + bitmapSize;
+    dataStart = (dataStart + LOG_SECTOR_SIZE - 1) / LOG_SECTOR_SIZE * LOG_SECTOR_SIZE;
+    if (hbinsSize % HBIN_ALIGNMENT != 0 || log.size() < dataStart) {
+        status.error = L"Dirty sector bitmap is truncated";
+        return;
+    }
+    const uint8_t* bitmap = base + LOG_DATA + DIRT_BITMAP;
+    size_t dirty = 0;
+    for (size_t i = 0; i < bitmapSize; i++) dirty += std::popcount(bitmap[i]);
+    if (dirty > (log.size() - dataStart) / LOG_SECTOR_SIZE) {
+        status.error = L"Dirty sectors are truncated";
+        return;
+    }
+    entries.push_back({ sequence, hbinsSize, index, dataStart, HiveLogFormat::Old });
+    status.entries = 1;
+    status.firstSequence = status.lastSequence = sequence;
+}
+
+} // namespace
+
+uint64_t Marvin32(const uint8_t* data, size_t size, uint64_t seed) {
+    uint32_t s0 = static_cast<uint32_t>(seed);
+    uint32_t s1 = static_cast<uint32_t>(seed >> 32);
+    for (; size >= 4; data += 4, size -= 4) MarvinMix(s0, s1, ReadU32(data));
+    uint32_t last = 0x80;
+    for (size_t i = size; i-- > 0;) last = (last << 8) | data[i];
+    MarvinMix(s0, s1, last);
+    MarvinMix(s0, s1, 0);
+    return (uint64_t(s1) << 32) | s0;
+}
+
+bool PlanHiveRecovery(std::span<const uint8_t> primary, std::span<const std::span<const uint8_t>> logs,
+                      HiveRecoveryPlan& plan, HiveRecoveryStats& stats, std::wstring& error) {
+    plan = {};
+    plan.imageSize = primary.size();
+    stats = {};
+    stats.logs.resize(logs.size());
+
+    bool primaryValid = BaseBlockValid(primary);
+    const uint8_t* base = primary.data();
+    uint32_t completed = primaryValid ? ReadU32(base + BASE_SECONDARY_SEQUENCE) : 0;
+    stats.dirty = !primaryValid || ReadU32(base + BASE_PRIMARY_SEQUENCE) != completed;
+    stats.sequence = completed;
+    if (!stats.dirty) return true;
+
+    std::vector<LogEntry> entries;
+    const uint8_t* logBase = nullptr;           // Newest valid log base block
+    for (size_t i = 0; i < logs.size(); i++) {
+        HiveLogStatus& status = stats.logs[i];
+        if (logs[i].empty()) {
+            status.error = L"Empty or unreadable";
+            continue;
+        }
+        if (!BaseBlockValid(logs[i])) {
+            status.error = L"Base block is damaged";
+            continue;
+        }
+        const uint8_t* header = logs[i].data();
+        if (!logBase || ReadU32(header + BASE_SECONDARY_SEQUENCE) > ReadU32(logBase + BASE_SECONDARY_SEQUENCE)) {
+            logBase = header;
+        }
+        uint32_t signature = logs[i].size() - LOG_DATA >= 4 ? ReadU32(header + LOG_DATA) : 0;
+        if (signature == DIRT_SIGNATURE) {
+            status.format = HiveLogFormat::Old;
+            ScanOldLog(logs[i], i, status, entries);
+        } else if (signature == HVLE_SIGNATURE || ReadU32(header + BASE_FILE_TYPE) == FILE_TYPE_LOG6) {
+            status.format = HiveLogFormat::New;
+            ScanNewLog(logs[i], i, status, entries);
+        } else {
+            status.error = L"No log data";
+        }
+    }
+
+    if (!primaryValid) {
+        if (!logBase) {
+            error = L"Base block is damaged and no transaction log has a valid copy";
+            return false;
+        }
+        base = logBase;
+        stats.baseBlockFromLog = true;
+    }
+
+    // Replay from the last complete flush (an entry already in the primary
+    // is harmless to apply again) while the sequence numbers run on. Without
+    // a valid primary base block, replay from the oldest entry.
+    std::stable_sort(entries.begin(), entries.end(), [](const LogEntry& a, const LogEntry& b) {
+        return a.sequence < b.sequence;
+    });
+    const LogEntry* lastApplied = nullptr;
+    uint32_t hbinsSize = ReadU32(base + BASE_HBINS_SIZE);
+    for (const LogEntry& entry : entries) {
+        if (primaryValid && entry.sequence < completed) {
+            stats.entriesSkipped++;
+            continue;
+        }
+        if (lastApplied && entry.sequence == lastApplied->sequence) continue;
+        if (!lastApplied && primaryValid && entry.sequence > completed + 1) {
+            stats.warning = L"Logs start at sequence " + std::to_wstring(entry.sequence) +
+                            L" but the hive was last flushed at " + std::to_wstring(completed);
+            break;
+        }
+        if (lastApplied && entry.sequence != lastApplied->sequence + 1) {
+            stats.warning = L"Logs have no entry after sequence " + std::to_wstring(lastApplied->sequence);
+            break;
+        }
+
+        const uint8_t* log = logs[entry.log].data();
+        if (entry.format == HiveLogFormat::New) {
+            const uint8_t* header = log + entry.offset;
+            uint32_t pageCount = ReadU32(header + HVLE_PAGE_COUNT);
+            const uint8_t* data = header + HVLE_PAGES + size_t(pageCount) * HVLE_PAGE_ENTRY_SIZE;
+            for (uint32_t i = 0; i < pageCount; i++) {
+                const uint8_t* page = header + HVLE_PAGES + i * HVLE_PAGE_ENTRY_SIZE;
+                HivePageWrite write{ ReadU32(page), ReadU32(page + 4), data };
+                data += write.size;
+                plan.writes.push_back(write);
+                stats.pagesApplied++;
+                stats.bytesApplied += write.size;
+            }
+        } else {
+            // Runs of set bits become one write each
+            const uint8_t* bitmap = log + LOG_DATA + DIRT_BITMAP;
+            const uint8_t* data = log + entry.offset;
+            uint32_t sectors = entry.hbinsSize / LOG_SECTOR_SIZE;
+            for (uint32_t i = 0; i < sectors;) {
+                if (!(bitmap[i / 8] & (1u << (i % 8)))) {
+                    i++;
+                    continue;
+                }
+                uint32_t first = i;
+                while (i < sectors && (bitmap[i / 8] & (1u << (i % 8)))) i++;
+                HivePageWrite write{ first * LOG_SECTOR_SIZE, (i - first) * LOG_SECTOR_SIZE, data };
+                data += write.size;
+                plan.writes.push_back(write);
+                stats.pagesApplied += i - first;
+                stats.bytesApplied += write.size;
+            }
+        }
+        hbinsSize = entry.hbinsSize;
+        plan.imageSize = std::max<size_t>(plan.imageSize, size_t(BASE_BLOCK_SIZE) + hbinsSize);
+        stats.entriesApplied++;
+        lastApplied = &entry;
+    }
+    if (!lastApplied && stats.warning.empty()) stats.warning = L"No transaction log has entries to replay";
+
+    // The recovered base block records the last flush as complete
+    if (lastApplied || stats.baseBlockFromLog) {
+        const uint8_t* source = (lastApplied && lastApplied->format == HiveLogFormat::Old) ? logs[lastApplied->log].data() : base;
+        plan.baseBlock.assign(source, source + LOG_BASE_BLOCK_SIZE);
+        uint8_t* block = plan.baseBlock.data();
+        if (lastApplied) {
+            WriteU32(block + BASE_PRIMARY_SEQUENCE, lastApplied->sequence);
+            WriteU32(block + BASE_SECONDARY_SEQUENCE, lastApplied->sequence);
+            WriteU32(block + BASE_HBINS_SIZE, hbinsSize);
+            stats.sequence = lastApplied->sequence;
+        }
+        WriteU32(block + BASE_FILE_TYPE, FILE_TYPE_PRIMARY);
+        WriteU32(block + BASE_CHECKSUM, BaseBlockChecksum(block));
+    }
+    return true;
+}
+
+void ApplyHiveRecovery(const HiveRecoveryPlan& plan, uint8_t* image) {
+    for (const HivePageWrite& write : plan.writes) {
+        std::memcpy(image + BASE_BLOCK_SIZE + write.offset, write.data, write.size);
+    }
+    if (!plan.baseBlock.empty()) std::memcpy(image, plan.baseBlock.data(), plan.baseBlock.size());
+}
+
+std::vector<std::filesystem::path> FindHiveLogs(const std::filesystem::path& primary) {
+    std::wstring name = primary.filename().wstring();
+    std::filesystem::path directory = primary.parent_path();
+    if (directory.empty()) directory = ".";
+
+    std::filesystem::path found[3];
+    const wchar_t* suffixes[3] = { L".LOG", L".LOG1", L".LOG2" };
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec); !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::wstring entry = it->path().filename().wstring();
+        for (int i = 0; i < 3; i++) {
+            if (NamesEqual(entry, name + suffixes[i]) && it->is_regular_file(ec)) found[i] = it->path();
+        }
+    }
+
+    std::vector<std::filesystem::path> logs;
+    for (const std::filesystem::path& path : found) {
+        if (!path.empty()) logs.push_back(path);
+    }
+    return logs;
+}
+
+bool RecoverHive(const std::filesystem::path& primary, const std::vector<std::filesystem::path>& logs,
+                 MappedFile& view, HiveRecoveryStats& stats, std::wstring& error) {
+    auto start = std::chrono::steady_clock::now();
+    stats = {};
+    if (!view.OpenCopyOnWrite(primary)) {
+        error = L"Cannot open " + primary.wstring();
+        return false;
+    }
+
+    // Empty logs (the usual state of a clean hive) cannot be mapped and stay empty spans
+    std::vector<MappedFile> logFiles(logs.size());
+    std::vector<std::span<const uint8_t>> images(logs.size());
+    for (size_t i = 0; i < logs.size(); i++) {
+        if (logFiles[i].Open(logs[i])) images[i] = { logFiles[i].Data(), logFiles[i].Size() };
+    }
+
+    HiveRecoveryPlan plan;
+    bool ok = PlanHiveRecovery({ view.Data(), view.Size() }, images, plan, stats, error);
+    for (size_t i = 0; i < logs.size(); i++) stats.logs[i].path = logs[i];
+    if (ok && plan.imageSize > view.Size() && !view.OpenCopyOnWrite(primary, plan.imageSize)) {
+        error = L"Cannot map " + primary.wstring();
+        ok = false;
+    }
+    if (ok) ApplyHiveRecovery(plan, view.MutableData());
+    if (!ok) view.Close();
+    stats.seconds = SecondsSince(start);
+    return ok;
+}
+
+} // namespace core
@@ -0,0 +1,90 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Transaction log replay for dirty hives. A hive is dirty when its base
+ * block sequence numbers differ or its checksum is wrong; the changes of
+ * the last flushes are then only in the .LOG1/.LOG2 files next to it.
+ * Both log formats are read: the old one (a dirty sector bitmap and the
+ * sectors) and the Windows 8.1+ one (a run of HvLE entries, each with a
+ * sequence number, two Marvin32 hashes and a list of dirty pages).
+ *
+ * Planning validates the logs and lists the page writes that bring the
+ * hive up to date without copying any page; applying them only touches
+ * those pages. RecoverHive applies them to a private copy-on-write view
+ * of the primary file, which is never written.
+ */
+
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class HiveLogFormat : uint8_t {
+    Unknown,
+    Old,                                // DIRT bitmap and sectors
+    New                                 // HvLE entries
+};
+
+struct HiveLogStatus {
+    std::filesystem::path path;         // Empty when planning from images
+    HiveLogFormat format = HiveLogFormat::Unknown;
+    uint32_t entries = 0;               // Valid entries (an old-format log counts as one)
+    uint32_t firstSequence = 0;
+    uint32_t lastSequence = 0;
+    std::wstring error;                 // Why the log was rejected or its entries end early
+};
+
+struct HiveRecoveryStats {
+    bool dirty = false;                 // The primary needed the logs
+    bool baseBlockFromLog = false;      // The primary base block was damaged
+    uint32_t entriesApplied = 0;
+    uint32_t entriesSkipped = 0;        // Older than the primary's last complete flush
+    uint64_t pagesApplied = 0;
+    uint64_t bytesApplied = 0;
+    uint32_t sequence = 0;              // Sequence number of the recovered hive
+    std::wstring warning;               // Set when the logs cannot bring the hive fully up to date
+    std::vector<HiveLogStatus> logs;
+    double seconds = 0;
+};
+
+// Bytes to copy into the hive image, at an offset from the first hbin
+struct HivePageWrite {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    const uint8_t* data = nullptr;      // Into a log image
+};
+
+struct HiveRecoveryPlan {
+    std::vector<uint8_t> baseBlock;     // First LOG_BASE_BLOCK_SIZE bytes to write; empty if clean
+    size_t imageSize = 0;               // Size the image needs for the writes
+    std::vector<HivePageWrite> writes;  // In the order to apply
+};
+
+// Marvin32 as used for log entry hashes
+uint64_t Marvin32(const uint8_t* data, size_t size, uint64_t seed);
+
+// Validate logs against the primary image's base block and list the writes
+// that recover it. The log images must outlive the plan. Fails only if the
+// primary base block is damaged and no log has a usable one.
+bool PlanHiveRecovery(std::span<const uint8_t> primary, std::span<const std::span<const uint8_t>> logs,
+                      HiveRecoveryPlan& plan, HiveRecoveryStats& stats, std::wstring& error);
+
+// Apply a plan to an image of at least plan.imageSize bytes
+void ApplyHiveRecovery(const HiveRecoveryPlan& plan, uint8_t* image);
+
+// Logs next to a primary file: <name>.LOG, <name>.LOG1 and <name>.LOG2 (any case) that exist
+std::vector<std::filesystem::path> FindHiveLogs(const std::filesystem::path& primary);
+
+// Map primary copy-on-write into view and replay the logs into it if it is dirty
+bool RecoverHive(const std::filesystem::path& primary, const std::vector<std::filesystem::path>& logs,
+                 MappedFile& view, HiveRecoveryStats& stats, std::wstring& error);
+
+} // namespace core
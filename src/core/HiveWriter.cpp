@@ -0,0 +1,425 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming regf writer.
+ */
+
+#include "HiveWriter.h"
+#include "HiveReader.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+
+namespace core {
+
+using namespace hive;
+
+namespace {
+
+constexpr uint32_t FLUSH_SIZE = 1 << 20;            // Output written in ~1 MB runs
+constexpr uint32_t PATCH_FLUSH_SIZE = 4 << 20;
+constexpr uint32_t LEAF_CAPACITY = 500;             // An lh leaf still fits a 4 KB bin
+constexpr uint32_t HIVE_MINOR_VERSION = 5;
+constexpr uint32_t DB_PAYLOAD_SIZE = 12;
+constexpr uint64_t MAX_HBINS_SIZE = (1ull << 32) - BASE_BLOCK_SIZE;  // Whole file within 4 GB
+
+// Self-relative descriptor with a NULL DACL, used when the root has none
+constexpr uint8_t DEFAULT_SECURITY[20] = { 1, 0, 0x04, 0x80 };
+
+uint64_t AlignCell(uint64_t size) {
+    return (size + CELL_ALIGNMENT - 1) & ~uint64_t{CELL_ALIGNMENT - 1};
+}
+
+// Latin-1 names are stored one byte per character
+bool EncodeName(std::wstring_view name, std::vector<uint8_t>& out) {
+    bool compressed = std::all_of(name.begin(), name.end(), [](wchar_t c) { return c <= 0xFF; });
+    out.clear();
+    if (compressed) {
+        for (wchar_t c : name) out.push_back(static_cast<uint8_t>(c));
+    } else {
+        out = EncodeString(name, false);
+    }
+    return compressed;
+}
+
+uint64_t HashBytes(std::span<const uint8_t> bytes) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (uint8_t b : bytes) {
+        hash ^= b;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+bool HiveWriter::Fail(const wchar_t* message) {
+    if (m_error.empty()) m_error = message;
+    return false;
+}
+
+bool HiveWriter::Create(const std::filesystem::path& path) {
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) return Fail(L"Cannot create hive file");
+
+    // Placeholder base block, rewritten by Finish()
+    std::vector<uint8_t> base(BASE_BLOCK_SIZE);
+    m_file.write(reinterpret_cast<const char*>(base.data()), base.size());
+
+    m_timestamp = CurrentFileTime();
+    m_buffer.reserve(FLUSH_SIZE + HBIN_ALIGNMENT);
+    return StartBin(HBIN_ALIGNMENT) && static_cast<bool>(m_file);
+}
+
+bool HiveWriter::StartBin(uint64_t minimumSize) {
+    uint64_t size = (std::max<uint64_t>(minimumSize, HBIN_ALIGNMENT) + HBIN_ALIGNMENT - 1) & ~uint64_t{HBIN_ALIGNMENT - 1};
+    if (size > MAX_HBINS_SIZE - m_binEnd) return Fail(L"Hive would exceed 4 GB");
+    if (m_binEnd - m_bufferStart >= FLUSH_SIZE) FlushBuffer();
+
+    m_binStart = m_binEnd;
+    m_binEnd = m_binStart + static_cast<uint32_t>(size);
+    m_buffer.resize(m_binEnd - m_bufferStart);
+
+    uint8_t* bin = m_buffer.data() + (m_binStart - m_bufferStart);
+    WriteU32(bin, HBIN_SIGNATURE);
+    WriteU32(bin + HBIN_OFFSET, m_binStart);
+    WriteU32(bin + HBIN_SIZE, static_cast<uint32_t>(size));
+    WriteU64(bin + HBIN_TIMESTAMP, m_timestamp);
+    m_cursor = m_binStart + HBIN_HEADER_SIZE;
+    m_stats.bins++;
+    return true;
+}
+
+// The unused tail of a bin becomes one free cell
+void HiveWriter::CloseBin() {
+    if (m_cursor < m_binEnd) {
+        WriteU32(m_buffer.data() + (m_cursor - m_bufferStart), m_binEnd - m_cursor);
+        m_cursor = m_binEnd;
+    }
+}
+
+// Past the size limit the writer has failed; callers still get a scratch
+// cell to fill, and every later call returns false
+uint8_t* HiveWriter::AllocateCell(uint32_t payloadSize, uint32_t& offset) {
+    uint64_t size = AlignCell(uint64_t{payloadSize} + CELL_HEADER_SIZE);
+    if (m_error.empty() && size > m_binEnd - m_cursor) {
+        CloseBin();
+        StartBin(size + HBIN_HEADER_SIZE);
+    }
+    if (!m_error.empty()) {
+        m_discard.assign(size, 0);
+        offset = INVALID_CELL;
+        return m_discard.data() + CELL_HEADER_SIZE;
+    }
+
+    offset = m_cursor;
+    m_cursor += static_cast<uint32_t>(size);
+    uint8_t* cell = m_buffer.data() + (offset - m_bufferStart);
+    WriteU32(cell, static_cast<uint32_t>(-static_cast<int64_t>(size)));
+    std::fill(cell + CELL_HEADER_SIZE, cell + size, uint8_t{0});
+    return cell + CELL_HEADER_SIZE;
+}
+
+uint32_t HiveWriter::WriteCell(std::span<const uint8_t> payload) {
+    uint32_t offset;
+    uint8_t* cell = AllocateCell(static_cast<uint32_t>(payload.size()), offset);
+    std::copy(payload.begin(), payload.end(), cell);
+    return offset;
+}
+
+void HiveWriter::WriteAt(uint32_t offset, const uint8_t* bytes, size_t size) {
+    if (!m_error.empty()) return;
+    if (offset >= m_bufferStart) {
+        std::copy(bytes, bytes + size, m_buffer.data() + (offset - m_bufferStart));
+        return;
+    }
+    m_patches.push_back({ offset, static_cast<uint32_t>(m_patchBytes.size()), static_cast<uint32_t>(size) });
+    m_patchBytes.insert(m_patchBytes.end(), bytes, bytes + size);
+    m_stats.patches++;
+    if (m_patchBytes.size() >= PATCH_FLUSH_SIZE) FlushPatches();
+}
+
+// Everything before the current bin goes to disk
+bool HiveWriter::FlushBuffer() {
+    uint32_t flushed = m_binEnd - m_bufferStart;
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), flushed);
+    m_buffer.clear();
+    m_bufferStart = m_binEnd;
+    return static_cast<bool>(m_file);
+}
+
+bool HiveWriter::FlushPatches() {
+    if (m_patches.empty()) return true;
+    std::sort(m_patches.begin(), m_patches.end(),
+        [](const Patch& a, const Patch& b) { return a.offset < b.offset; });
+
+    std::streampos end = m_file.tellp();
+    for (const Patch& patch : m_patches) {
+        m_file.seekp(static_cast<std::streamoff>(BASE_BLOCK_SIZE) + patch.offset);
+        m_file.write(reinterpret_cast<const char*>(m_patchBytes.data() + patch.start), patch.size);
+    }
+    m_file.seekp(end);
+
+    m_patches.clear();
+    m_patchBytes.clear();
+    return static_cast<bool>(m_file);
+}
+
+uint32_t HiveWriter::InternSecurity(std::span<const uint8_t> descriptor) {
+    uint64_t hash = HashBytes(descriptor);
+    auto [first, last] = m_securityIndex.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        SecurityCell& existing = m_security[it->second];
+        if (std::equal(descriptor.begin(), descriptor.end(), existing.descriptor.begin(), existing.descriptor.end())) {
+            existing.references++;
+            m_stats.sharedSecurity++;
+            return it->second;
+        }
+    }
+
+    // List links and the reference count are filled in by Finish()
+    uint32_t offset;
+    uint8_t* cell = AllocateCell(SK_DESCRIPTOR + static_cast<uint32_t>(descriptor.size()), offset);
+    WriteU16(cell, SIG_SK);
+    WriteU32(cell + SK_DESCRIPTOR_SIZE, static_cast<uint32_t>(descriptor.size()));
+    std::copy(descriptor.begin(), descriptor.end(), cell + SK_DESCRIPTOR);
+
+    uint32_t index = static_cast<uint32_t>(m_security.size());
+    m_securityIndex.emplace(hash, index);
+    m_security.push_back({ offset, 1, std::vector<uint8_t>(descriptor.begin(), descriptor.end()) });
+    m_stats.securityCells++;
+    return index;
+}
+
+bool HiveWriter::BeginKey(const HiveKeyRecord& key) {
+    if (!m_error.empty()) return false;
+    if (m_depth == 0 && m_rootCell != INVALID_CELL) return Fail(L"Hive already has a root key");
+    if (key.name.empty() || key.name.size() > MAX_KEY_NAME) return Fail(L"Invalid key name");
+
+    if (m_frames.size() == m_depth) m_frames.emplace_back();
+    Frame& frame = m_frames[m_depth];
+    Frame* parent = m_depth ? &m_frames[m_depth - 1] : nullptr;
+    if (parent) {
+        if (!parent->children.empty() && CompareNames(key.name, parent->lastChild) <= 0) {
+            return Fail(L"Subkeys out of order or duplicated");
+        }
+        CloseValues(*parent);
+    }
+
+    frame.values.clear();
+    frame.valueList = INVALID_CELL;
+    frame.valuesClosed = false;
+    frame.children.clear();
+    frame.maxSubKeyName = frame.maxSubKeyClass = frame.maxValueName = frame.maxValueData = 0;
+
+    if (!key.security.empty()) {
+        frame.security = InternSecurity(key.security);
+    } else if (parent) {
+        frame.security = parent->security;
+        m_security[frame.security].references++;
+        m_stats.sharedSecurity++;
+    } else {
+        frame.security = InternSecurity(DEFAULT_SECURITY);
+    }
+
+    uint32_t classCell = INVALID_CELL;
+    uint32_t classBytes = 0;
+    if (!key.className.empty()) {
+        m_scratch = EncodeString(key.className, false);
+        classBytes = static_cast<uint32_t>(m_scratch.size());
+        classCell = WriteCell(m_scratch);
+    }
+
+    bool compressed = EncodeName(key.name, m_scratch);
+    uint32_t nameBytes = static_cast<uint32_t>(m_scratch.size());
+
+    uint16_t flags = key.flags & (KEY_NO_DELETE | KEY_SYM_LINK);
+    if (compressed) flags |= KEY_COMP_NAME;
+    if (!parent) flags |= KEY_HIVE_ENTRY | KEY_NO_DELETE;
+
+    std::vector<uint8_t>& node = frame.node;
+    node.assign(NK_NAME + nameBytes, 0);
+    WriteU16(node.data(), SIG_NK);
+    WriteU16(node.data() + NK_FLAGS, flags);
+    WriteU64(node.data() + NK_TIMESTAMP, key.lastWriteTime);
+    WriteU32(node.data() + NK_PARENT, parent ? parent->cell : INVALID_CELL);
+    WriteU32(node.data() + NK_VOLATILE_SUBKEY_LIST, INVALID_CELL);
+    WriteU32(node.data() + NK_SECURITY, m_security[frame.security].cell);
+    WriteU32(node.data() + NK_CLASS_NAME, classCell);
+    WriteU16(node.data() + NK_NAME_LENGTH, static_cast<uint16_t>(nameBytes));
+    WriteU16(node.data() + NK_CLASS_LENGTH, static_cast<uint16_t>(classBytes));
+    std::copy(m_scratch.begin(), m_scratch.end(), node.data() + NK_NAME);
+
+    // Reserve the nk slot now so subkeys can point at their parent
+    AllocateCell(static_cast<uint32_t>(node.size()), frame.cell);
+
+    if (parent) {
+        parent->children.push_back({ frame.cell, HiveReader::NameHash(key.name) });
+        parent->lastChild.assign(key.name);
+        parent->maxSubKeyName = std::max(parent->maxSubKeyName, static_cast<uint32_t>(key.name.size() * 2));
+        parent->maxSubKeyClass = std::max(parent->maxSubKeyClass, classBytes);
+    } else {
+        m_rootCell = frame.cell;
+    }
+
+    m_depth++;
+    m_stats.keys++;
+    return m_error.empty();
+}
+
+uint32_t HiveWriter::WriteData(std::span<const uint8_t> data) {
+    if (data.size() <= BIG_DATA_SEGMENT_SIZE) return WriteCell(data);
+
+    std::vector<uint32_t> segments;
+    for (size_t pos = 0; pos < data.size(); pos += BIG_DATA_SEGMENT_SIZE) {
+        segments.push_back(WriteCell(data.subspan(pos, std::min<size_t>(BIG_DATA_SEGMENT_SIZE, data.size() - pos))));
+    }
+
+    uint32_t listCell;
+    uint8_t* list = AllocateCell(static_cast<uint32_t>(segments.size() * 4), listCell);
+    for (size_t i = 0; i < segments.size(); i++) WriteU32(list + i * 4, segments[i]);
+
+    uint32_t dbCell;
+    uint8_t* db = AllocateCell(DB_PAYLOAD_SIZE, dbCell);
+    WriteU16(db, SIG_DB);
+    WriteU16(db + DB_SEGMENT_COUNT, static_cast<uint16_t>(segments.size()));
+    WriteU32(db + DB_SEGMENT_LIST, listCell);
+    m_stats.bigDataValues++;
+    return dbCell;
+}
+
+bool HiveWriter::AddValue(std::wstring_view name, uint32_t type, std::span<const uint8_t> data) {
+    if (!m_error.empty()) return false;
+    if (m_depth == 0) return Fail(L"Value outside of a key");
+    Frame& frame = m_frames[m_depth - 1];
+    if (frame.valuesClosed) return Fail(L"Values must precede subkeys");
+    if (data.size() > 0x7FFFFFFF || data.size() / BIG_DATA_SEGMENT_SIZE >= 0xFFFF) return Fail(L"Value data too large");
+
+    uint32_t dataSize = static_cast<uint32_t>(data.size());
+    uint32_t dataCell = 0;
+    if (dataSize <= 4) {
+        // Resident data lives in the offset field itself
+        uint8_t resident[4] = {};
+        std::copy(data.begin(), data.end(), resident);
+        dataCell = ReadU32(resident);
+        dataSize |= DATA_RESIDENT;
+    } else {
+        dataCell = WriteData(data);
+    }
+
+    bool compressed = EncodeName(name, m_scratch);
+    uint32_t offset;
+    uint8_t* vk = AllocateCell(VK_NAME + static_cast<uint32_t>(m_scratch.size()), offset);
+    WriteU16(vk, SIG_VK);
+    WriteU16(vk + VK_NAME_LENGTH, static_cast<uint16_t>(m_scratch.size()));
+    WriteU32(vk + VK_DATA_SIZE, dataSize);
+    WriteU32(vk + VK_DATA_OFFSET, dataCell);
+    WriteU32(vk + VK_TYPE, type);
+    WriteU16(vk + VK_FLAGS, compressed ? VALUE_COMP_NAME : 0);
+    std::copy(m_scratch.begin(), m_scratch.end(), vk + VK_NAME);
+
+    frame.values.push_back(offset);
+    frame.maxValueName = std::max(frame.maxValueName, static_cast<uint32_t>(name.size() * 2));
+    frame.maxValueData = std::max(frame.maxValueData, static_cast<uint32_t>(data.size()));
+    m_stats.values++;
+    return m_error.empty();
+}
+
+void HiveWriter::CloseValues(Frame& frame) {
+    if (frame.valuesClosed) return;
+    frame.valuesClosed = true;
+    if (frame.values.empty()) return;
+
+    uint8_t* list = AllocateCell(static_cast<uint32_t>(frame.values.size() * 4), frame.valueList);
+    for (size_t i = 0; i < frame.values.size(); i++) WriteU32(list + i * 4, frame.values[i]);
+}
+
+// One lh leaf, or an ri index over leaves of LEAF_CAPACITY entries
+uint32_t HiveWriter::WriteSubKeyList(const std::vector<Child>& children) {
+    std::vector<uint32_t> leaves;
+    for (size_t first = 0; first < children.size(); first += LEAF_CAPACITY) {
+        size_t count = std::min<size_t>(LEAF_CAPACITY, children.size() - first);
+        uint32_t offset;
+        uint8_t* leaf = AllocateCell(static_cast<uint32_t>(LIST_ENTRIES + count * 8), offset);
+        WriteU16(leaf, SIG_LH);
+        WriteU16(leaf + LIST_COUNT, static_cast<uint16_t>(count));
+        for (size_t i = 0; i < count; i++) {
+            WriteU32(leaf + LIST_ENTRIES + i * 8, children[first + i].cell);
+            WriteU32(leaf + LIST_ENTRIES + i * 8 + 4, children[first + i].hash);
+        }
+        leaves.push_back(offset);
+    }
+    if (leaves.size() == 1) return leaves[0];
+
+    uint32_t offset;
+    uint8_t* index = AllocateCell(static_cast<uint32_t>(LIST_ENTRIES + leaves.size() * 4), offset);
+    WriteU16(index, SIG_RI);
+    WriteU16(index + LIST_COUNT, static_cast<uint16_t>(leaves.size()));
+    for (size_t i = 0; i < leaves.size(); i++) WriteU32(index + LIST_ENTRIES + i * 4, leaves[i]);
+    return offset;
+}
+
+bool HiveWriter::EndKey() {
+    if (!m_error.empty()) return false;
+    if (m_depth == 0) return Fail(L"EndKey without BeginKey");
+    Frame& frame = m_frames[m_depth - 1];
+    CloseValues(frame);
+
+    if (frame.children.size() > LEAF_CAPACITY * 0xFFFFull) return Fail(L"Too many subkeys");
+    uint32_t subKeyList = frame.children.empty() ? INVALID_CELL : WriteSubKeyList(frame.children);
+
+    uint8_t* node = frame.node.data();
+    WriteU32(node + NK_SUBKEY_COUNT, static_cast<uint32_t>(frame.children.size()));
+    WriteU32(node + NK_SUBKEY_LIST, subKeyList);
+    WriteU32(node + NK_VALUE_COUNT, static_cast<uint32_t>(frame.values.size()));
+    WriteU32(node + NK_VALUE_LIST, frame.valueList);
+    WriteU32(node + NK_MAX_SUBKEY_NAME, frame.maxSubKeyName);
+    WriteU32(node + NK_MAX_SUBKEY_CLASS, frame.maxSubKeyClass);
+    WriteU32(node + NK_MAX_VALUE_NAME, frame.maxValueName);
+    WriteU32(node + NK_MAX_VALUE_DATA, frame.maxValueData);
+    WriteAt(frame.cell + CELL_HEADER_SIZE, node, frame.node.size());
+
+    m_depth--;
+    return m_error.empty();
+}
+
+bool HiveWriter::Finish() {
+    if (!m_error.empty()) return false;
+    if (m_depth != 0 || m_rootCell == INVALID_CELL) return Fail(L"Hive has unfinished keys");
+
+    // sk cells form a circular doubly linked list
+    for (size_t i = 0; i < m_security.size(); i++) {
+        uint8_t links[12];
+        WriteU32(links, m_security[(i + 1) % m_security.size()].cell);
+        WriteU32(links + 4, m_security[(i + m_security.size() - 1) % m_security.size()].cell);
+        WriteU32(links + 8, m_security[i].references);
+        WriteAt(m_security[i].cell + CELL_HEADER_SIZE + SK_FLINK, links, sizeof(links));
+    }
+
+    CloseBin();
+    if (!FlushBuffer() || !FlushPatches()) return Fail(L"Write failed");
+    m_stats.hbinsSize = m_binEnd;
+
+    uint8_t base[BASE_BLOCK_SIZE] = {};
+    WriteU32(base, REGF_SIGNATURE);
+    WriteU32(base + BASE_PRIMARY_SEQUENCE, 1);
+    WriteU32(base + BASE_SECONDARY_SEQUENCE, 1);
+    WriteU64(base + BASE_TIMESTAMP, m_timestamp);
+    WriteU32(base + BASE_MAJOR_VERSION, 1);
+    WriteU32(base + BASE_MINOR_VERSION, HIVE_MINOR_VERSION);
+    WriteU32(base + BASE_FILE_TYPE, FILE_TYPE_PRIMARY);
+    WriteU32(base + BASE_FILE_FORMAT, 1);
+    WriteU32(base + BASE_ROOT_CELL, m_rootCell);
+    WriteU32(base + BASE_HBINS_SIZE, m_binEnd);
+    WriteU32(base + BASE_CLUSTERING, 1);
+    WriteU32(base + BASE_CHECKSUM, BaseBlockChecksum(base));
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(base), sizeof(base));
+    m_file.close();
+    if (!m_file) return Fail(L"Write failed");
+    return true;
+}
+
+} // namespace core
@@ -0,0 +1,141 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming regf writer. Keys are fed depth-first (BeginKey, AddValue...,
+ * child keys, EndKey) and cells are appended to tightly packed hbins as
+ * they become final, so memory use depends on tree depth, not hive size.
+ */
+
+#pragma once
+
+#include "HiveFormat.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+struct HiveKeyRecord {
+    std::wstring_view name;
+    uint64_t lastWriteTime = 0;
+    std::wstring_view className;
+    std::span<const uint8_t> security;  // Self-relative descriptor; empty = inherit the parent's
+    uint16_t flags = 0;                 // KEY_NO_DELETE / KEY_SYM_LINK are kept, the rest is derived
+};
+
+struct HiveWriterStats {
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    uint64_t bins = 0;
+    uint64_t hbinsSize = 0;
+    uint64_t securityCells = 0;         // Distinct descriptors written
+    uint64_t sharedSecurity = 0;        // Keys that reused an existing sk cell
+    uint64_t bigDataValues = 0;
+    uint64_t patches = 0;               // Cells finalised after their bin was flushed
+};
+
+class HiveWriter {
+public:
+    HiveWriter() = default;
+    HiveWriter(const HiveWriter&) = delete;
+    HiveWriter& operator=(const HiveWriter&) = delete;
+
+    bool Create(const std::filesystem::path& path);
+
+    // Values of a key must be added before its first subkey, and subkeys
+    // must arrive in registry order (case-insensitive, see CompareNames).
+    // The first key becomes the root.
+    bool BeginKey(const HiveKeyRecord& key);
+    bool AddValue(std::wstring_view name, uint32_t type, std::span<const uint8_t> data);
+    bool EndKey();
+
+    // Write the base block and close the file once the root has ended.
+    // Offsets are 32-bit, so a hive that would grow past 4 GB fails.
+    bool Finish();
+
+    const HiveWriterStats& Stats() const { return m_stats; }
+    bool HasError() const { return !m_error.empty(); }
+    const std::wstring& Error() const { return m_error; }
+
+private:
+    struct Child {
+        uint32_t cell;
+        uint32_t hash;
+    };
+
+    struct Frame {
+        uint32_t cell = hive::INVALID_CELL;     // Reserved nk slot
+        std::vector<uint8_t> node;              // nk payload, completed in EndKey
+        uint32_t security = 0;                  // Index into m_security
+        std::vector<uint32_t> values;
+        uint32_t valueList = hive::INVALID_CELL;
+        bool valuesClosed = false;
+        std::vector<Child> children;
+        std::wstring lastChild;
+        uint32_t maxSubKeyName = 0;
+        uint32_t maxSubKeyClass = 0;
+        uint32_t maxValueName = 0;
+        uint32_t maxValueData = 0;
+    };
+
+    struct SecurityCell {
+        uint32_t cell;
+        uint32_t references;
+        std::vector<uint8_t> descriptor;
+    };
+
+    uint8_t* AllocateCell(uint32_t payloadSize, uint32_t& offset);
+    uint32_t WriteCell(std::span<const uint8_t> payload);
+    bool StartBin(uint64_t minimumSize);
+    void CloseBin();
+    void WriteAt(uint32_t offset, const uint8_t* bytes, size_t size);
+    bool FlushBuffer();
+    bool FlushPatches();
+
+    void CloseValues(Frame& frame);
+    uint32_t WriteSubKeyList(const std::vector<Child>& children);
+    uint32_t WriteData(std::span<const uint8_t> data);
+    // Index of the sk cell holding this descriptor, writing it if new
+    uint32_t InternSecurity(std::span<const uint8_t> descriptor);
+    bool Fail(const wchar_t* message);
+
+    std::ofstream m_file;
+    uint64_t m_timestamp = 0;
+
+    // Output window: bytes from m_bufferStart (relative to the first hbin)
+    std::vector<uint8_t> m_buffer;
+    uint32_t m_bufferStart = 0;
+    uint32_t m_binStart = 0;
+    uint32_t m_binEnd = 0;
+    uint32_t m_cursor = 0;
+
+    // Writes that landed before m_bufferStart, applied in offset order
+    struct Patch {
+        uint32_t offset;
+        uint32_t start;
+        uint32_t size;
+    };
+    std::vector<Patch> m_patches;
+    std::vector<uint8_t> m_patchBytes;
+
+    std::vector<Frame> m_frames;
+    size_t m_depth = 0;
+    uint32_t m_rootCell = hive::INVALID_CELL;
+
+    std::vector<SecurityCell> m_security;
+    std::unordered_multimap<uint64_t, uint32_t> m_securityIndex;
+
+    std::vector<uint8_t> m_scratch;
+    std::vector<uint8_t> m_discard;         // Stands in for cells past the size limit
+    HiveWriterStats m_stats;
+    std::wstring m_error;
+};
+
+} // namespace core
@@ -0,0 +1,769 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Layered copy-on-write backend.
+ */
+
+#include "LayeredBackend.h"
+#include "SubtreeOps.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+namespace {
+
+struct LayerValue {
+    RegValue value;
+    bool removed = false;                   // Tombstone: deleted in this layer
+};
+
+enum class NodeKind : uint8_t {
+    Overlay,                                // Exists below; values or subkeys change here
+    Created,                                // Made in this layer; nothing below shows through
+    Deleted                                 // Tombstone
+};
+
+struct LayerNode {
+    std::wstring name;
+    NodeKind kind = NodeKind::Overlay;
+    bool replaced = false;                  // Created over a key that existed below
+    bool detached = false;                  // No longer in the layer; handles to it are stale
+    std::vector<LayerValue> values;         // Insertion order
+    std::map<std::wstring, std::shared_ptr<LayerNode>> children;    // By folded name
+    uint64_t lastWriteTime = 0;
+};
+
+using LayerNodePtr = std::shared_ptr<LayerNode>;
+
+constexpr int BASE = -1;                    // Floor of keys the base shows through
+
+} // namespace
+
+struct LayeredBackend::State {
+    explicit State(RegistryBackend& backend) : base(backend) {}
+
+    RegistryBackend& base;
+    mutable std::shared_mutex mutex;
+    std::vector<LayerNodePtr> layers;       // Layer roots, bottom to top
+    uint64_t generation = 0;                // Bumped when the stack changes
+    uint64_t topVersion = 0;                // Bumped when keys are added to or removed from the top layer
+};
+
+namespace {
+
+using StatePtr = std::shared_ptr<LayeredBackend::State>;
+
+std::vector<LayerValue>::iterator FindLayerValue(std::vector<LayerValue>& values, std::wstring_view name) {
+    return std::find_if(values.begin(), values.end(),
+        [&](const LayerValue& entry) { return NamesEqual(entry.value.name, name); });
+}
+
+const LayerValue* FindLayerValue(const LayerNode& node, std::wstring_view name) {
+    for (const LayerValue& entry : node.values) {
+        if (NamesEqual(entry.value.name, name)) return &entry;
+    }
+    return nullptr;
+}
+
+// Mark a node and everything below it as gone from its layer
+void Detach(LayerNode& root) {
+    std::vector<LayerNode*> pending{ &root };
+    while (!pending.empty()) {
+        LayerNode* node = pending.back();
+        pending.pop_back();
+        node->detached = true;
+        for (auto& [folded, child] : node->children) pending.push_back(child.get());
+    }
+}
+
+// A key seen through the layer stack. m_nodes[i] is the key's node in layer
+// i (null if the layer does not touch it); layers below m_floor and, unless
+// m_floor is BASE, the base are hidden by a key created in layer m_floor.
+class LayeredKey : public RegistryKey {
+public:
+    LayeredKey(StatePtr state, uint64_t generation, uint64_t topVersion, KeyPtr base, int floor,
+               std::vector<LayerNodePtr> nodes, std::vector<std::wstring> path, std::vector<std::wstring> folded)
+        : m_state(std::move(state)), m_generation(generation), m_topVersion(topVersion),
+          m_base(std::move(base)), m_floor(floor), m_nodes(std::move(nodes)),
+          m_path(std::move(path)), m_folded(std::move(folded)) {}
+
+    bool QueryInfo(KeyInfo& info) const override {
+        std::shared_lock lock(m_state->mutex);
+        if (!Refresh()) return false;
+
+        info = KeyInfo{};
+        if (m_base) m_base->QueryInfo(info);
+        std::vector<std::wstring> names;
+        std::vector<RegValue> values;
+        CollectSubKeys(names);
+        CollectValues(values);
+        info.subKeyCount = static_cast<uint32_t>(names.size());
+        info.valueCount = static_cast<uint32_t>(values.size());
+        for (size_t i = Low(); i < m_nodes.size(); i++) {
+            if (m_nodes[i]) info.lastWriteTime = std::max(info.lastWriteTime, m_nodes[i]->lastWriteTime);
+        }
+        return true;
+    }
+
+    // Indexed enumeration merges the layers on every call; prefer the bulk calls
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override {
+        std::vector<std::wstring> names;
+        GetSubKeyNames(names);
+        if (index >= names.size()) return false;
+        name = std::move(names[index]);
+        return true;
+    }
+
+    bool EnumValue(uint32_t index, RegValue& value) const override {
+        std::vector<RegValue> values;
+        GetValues(values);
+        if (index >= values.size()) return false;
+        value = std::move(values[index]);
+        return true;
+    }
+
+    bool GetValue(std::wstring_view name, RegValue& value) const override {
+        std::shared_lock lock(m_state->mutex);
+        return Refresh() && FindValue(name, value, m_nodes.size());
+    }
+
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        std::shared_lock lock(m_state->mutex);
+        if (!Refresh()) return nullptr;
+
+        std::vector<std::wstring_view> parts = SplitPath(path);
+        std::unique_ptr<LayeredKey> current;
+        const LayeredKey* at = this;
+        for (size_t i = 0; i < parts.size(); i++) {
+            // Below a key no layer touches, the rest of the path is the base's
+            if (at->IsUntouched()) return at->OpenInBase(std::span(parts).subspan(i));
+            current = at->OpenChild(parts[i], m_nodes.size());
+            if (!current) return nullptr;
+            at = current.get();
+        }
+        if (!current) return Clone();
+        return current;
+    }
+
+    void GetSubKeyNames(std::vector<std::wstring>& names) const override {
+        std::shared_lock lock(m_state->mutex);
+        names.clear();
+        if (Refresh()) CollectSubKeys(names);
+    }
+
+    void GetValues(std::vector<RegValue>& values) const override {
+        std::shared_lock lock(m_state->mutex);
+        values.clear();
+        if (Refresh()) CollectValues(values);
+    }
+
+    void GetValueSummaries(std::vector<ValueSummary>& summaries) const override {
+        std::vector<RegValue> values;
+        GetValues(values);
+        summaries.clear();
+        summaries.reserve(values.size());
+        for (const RegValue& value : values) {
+            summaries.push_back({ value.name, value.type, static_cast<uint32_t>(value.data.size()) });
+        }
+    }
+
+    KeyPtr CreateSubKey(std::wstring_view path) override {
+        std::unique_lock lock(m_state->mutex);
+        if (!Refresh()) return nullptr;
+
+        std::unique_ptr<LayeredKey> current;
+        LayeredKey* at = this;
+        for (std::wstring_view part : SplitPath(path)) {
+            if (part.size() > MAX_KEY_NAME) return nullptr;
+            std::unique_ptr<LayeredKey> next = at->OpenChild(part, m_nodes.size());
+            if (!next) next = at->CreateChild(part);
+            if (!next) return nullptr;
+            current = std::move(next);
+            at = current.get();
+        }
+        if (!current) return Clone();
+        return current;
+    }
+
+    bool SetValue(const RegValue& value) override {
+        return SetValues({ &value, 1 }) == 1;
+    }
+
+    size_t SetValues(std::span<const RegValue> values) override {
+        std::unique_lock lock(m_state->mutex);
+        LayerNodePtr node = TopNode();
+        if (!node) return 0;
+        for (const RegValue& value : values) SetInLayer(*node, value);
+        node->lastWriteTime = CurrentFileTime();
+        return values.size();
+    }
+
+    bool DeleteValue(std::wstring_view name) override {
+        std::unique_lock lock(m_state->mutex);
+        LayerNodePtr node = TopNode();
+        RegValue current;
+        if (!node || !FindValue(name, current, m_nodes.size())) return false;
+
+        RegValue lower;
+        bool hasLower = FindValue(name, lower, m_nodes.size() - 1);
+        auto it = FindLayerValue(node->values, name);
+        if (!hasLower) {
+            node->values.erase(it);
+        } else if (it != node->values.end()) {
+            it->value.data.clear();
+            it->removed = true;
+        } else {
+            node->values.push_back({ RegValue{ lower.name, VALUE_NONE, {} }, true });
+        }
+        node->lastWriteTime = CurrentFileTime();
+        return true;
+    }
+
+    bool DeleteSubKey(std::wstring_view name) override {
+        std::unique_lock lock(m_state->mutex);
+        return DeleteChild(name, true);
+    }
+
+    // Delete a subkey and everything below it with one tombstone
+    bool DeleteTree(std::wstring_view name) {
+        std::unique_lock lock(m_state->mutex);
+        return DeleteChild(name, false);
+    }
+
+private:
+    size_t Low() const { return m_floor == BASE ? 0 : static_cast<size_t>(m_floor); }
+
+    std::unique_ptr<LayeredKey> Clone() const {
+        KeyPtr base = m_base ? m_base->OpenSubKey(L"") : nullptr;
+        return std::make_unique<LayeredKey>(m_state, m_generation, m_topVersion, std::move(base), m_floor,
+                                            m_nodes, m_path, m_folded);
+    }
+
+    // Bring the top layer's node up to date; false if the key was deleted
+    // (or deleted and created again) since it was opened. Lock held.
+    bool Refresh() const {
+        if (m_deleted) return false;
+        if (m_nodes.empty() || m_generation != m_state->generation || m_topVersion == m_state->topVersion) {
+            return true;
+        }
+        m_topVersion = m_state->topVersion;
+
+        LayerNodePtr& slot = m_nodes.back();
+        if (slot) {
+            m_deleted = slot->detached;
+            return !m_deleted;
+        }
+
+        // Untouched by the top layer when opened; see whether it is now
+        LayerNodePtr node = m_state->layers.back();
+        for (const std::wstring& folded : m_folded) {
+            auto it = node->children.find(folded);
+            if (it == node->children.end()) return true;
+            if (it->second->kind != NodeKind::Overlay) {
+                m_deleted = true;
+                return false;
+            }
+            node = it->second;
+        }
+        slot = std::move(node);
+        return true;
+    }
+
+    // Record a value in this key's top-layer node. Unique lock held.
+    void SetInLayer(LayerNode& node, const RegValue& value) {
+        RegValue lower;
+        bool hasLower = FindValue(value.name, lower, m_nodes.size() - 1);
+        auto it = FindLayerValue(node.values, value.name);
+        if (hasLower && lower.type == value.type && lower.data == value.data) {
+            // Back to what the layers below say: nothing left to record
+            if (it != node.values.end()) node.values.erase(it);
+        } else if (it != node.values.end()) {
+            it->value.type = value.type;
+            it->value.data = value.data;
+            it->removed = false;
+        } else {
+            LayerValue entry{ value, false };
+            if (hasLower) entry.value.name = lower.name;
+            node.values.push_back(std::move(entry));
+        }
+    }
+
+    bool IsUntouched() const {
+        if (m_floor != BASE || !m_base) return false;
+        return std::all_of(m_nodes.begin(), m_nodes.end(), [](const LayerNodePtr& node) { return !node; });
+    }
+
+    std::unique_ptr<LayeredKey> OpenInBase(std::span<const std::wstring_view> parts) const {
+        std::wstring relative;
+        std::vector<std::wstring> path = m_path;
+        std::vector<std::wstring> folded = m_folded;
+        for (std::wstring_view part : parts) {
+            if (!relative.empty()) relative += L'\\';
+            relative += part;
+            path.emplace_back(part);
+            folded.push_back(FoldName(part));
+        }
+        KeyPtr base = m_base->OpenSubKey(relative);
+        if (!base) return nullptr;
+        return std::make_unique<LayeredKey>(m_state, m_generation, m_topVersion, std::move(base), BASE,
+                                            std::vector<LayerNodePtr>(m_nodes.size()), std::move(path),
+                                            std::move(folded));
+    }
+
+    // Value as seen through layers [Low(), layerCount) and the base
+    bool FindValue(std::wstring_view name, RegValue& value, size_t layerCount) const {
+        for (size_t i = layerCount; i-- > Low();) {
+            if (!m_nodes[i]) continue;
+            if (const LayerValue* entry = FindLayerValue(*m_nodes[i], name)) {
+                if (entry->removed) return false;
+                value = entry->value;
+                return true;
+            }
+        }
+        return m_floor == BASE && m_base && m_base->GetValue(name, value);
+    }
+
+    void CollectValues(std::vector<RegValue>& values) const {
+        values.clear();
+        if (m_floor == BASE && m_base) m_base->GetValues(values);
+        for (size_t i = Low(); i < m_nodes.size(); i++) {
+            if (!m_nodes[i]) continue;
+            for (const LayerValue& entry : m_nodes[i]->values) {
+                auto it = std::find_if(values.begin(), values.end(),
+                    [&](const RegValue& value) { return NamesEqual(value.name, entry.value.name); });
+                if (entry.removed) {
+                    if (it != values.end()) values.erase(it);
+                } else if (it != values.end()) {
+                    it->type = entry.value.type;
+                    it->data = entry.value.data;
+                } else {
+                    values.push_back(entry.value);
+                }
+            }
+        }
+    }
+
+    void CollectSubKeys(std::vector<std::wstring>& names) const {
+        names.clear();
+        if (m_floor == BASE && m_base) m_base->GetSubKeyNames(names);
+
+        bool layered = false;
+        for (size_t i = Low(); i < m_nodes.size(); i++) {
+            if (m_nodes[i] && !m_nodes[i]->children.empty()) layered = true;
+        }
+        if (!layered) return;
+
+        // Apply the layers bottom-up: tombstones hide names, created keys add them
+        std::unordered_map<std::wstring, size_t> index;
+        for (size_t i = 0; i < names.size(); i++) index.emplace(FoldName(names[i]), i);
+        std::vector<bool> hidden(names.size(), false);
+        for (size_t i = Low(); i < m_nodes.size(); i++) {
+            if (!m_nodes[i]) continue;
+            for (const auto& [folded, child] : m_nodes[i]->children) {
+                auto it = index.find(folded);
+                if (child->kind == NodeKind::Deleted) {
+                    if (it != index.end()) hidden[it->second] = true;
+                } else if (it == index.end()) {
+                    index.emplace(folded, names.size());
+                    names.push_back(child->name);
+                    hidden.push_back(false);
+                } else if (hidden[it->second]) {
+                    names[it->second] = child->name;
+                    hidden[it->second] = false;
+                }
+            }
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < names.size(); i++) {
+            if (hidden[i]) continue;
+            if (kept != i) names[kept] = std::move(names[i]);
+            kept++;
+        }
+        names.resize(kept);
+    }
+
+    // Open name as seen through layers [Low(), layerCount) and the base
+    std::unique_ptr<LayeredKey> OpenChild(std::wstring_view name, size_t layerCount) const {
+        std::wstring folded = FoldName(name);
+        std::vector<LayerNodePtr> nodes(m_nodes.size());
+        int floor = m_floor;
+        bool found = false;
+        std::wstring display(name);
+
+        // The topmost layer that has the key decides whether it exists
+        for (size_t i = layerCount; i-- > Low();) {
+            if (!m_nodes[i]) continue;
+            auto it = m_nodes[i]->children.find(folded);
+            if (it == m_nodes[i]->children.end()) continue;
+            const LayerNodePtr& child = it->second;
+            if (!found) {
+                if (child->kind == NodeKind::Deleted) return nullptr;
+                found = true;
+                display = child->name;
+            }
+            nodes[i] = child;
+            if (child->kind == NodeKind::Created) {
+                floor = static_cast<int>(i);
+                break;
+            }
+        }
+
+        KeyPtr base;
+        if (floor == BASE && m_base) base = m_base->OpenSubKey(name);
+        if (!found && !base) return nullptr;
+
+        std::vector<std::wstring> path = m_path;
+        path.push_back(std::move(display));
+        std::vector<std::wstring> foldedPath = m_folded;
+        foldedPath.push_back(std::move(folded));
+        return std::make_unique<LayeredKey>(m_state, m_generation, m_topVersion, std::move(base), floor,
+                                            std::move(nodes), std::move(path), std::move(foldedPath));
+    }
+
+    // This key's node in the top layer, added (with its parents) if it has
+    // none yet. Null if the key is stale or deleted. Unique lock held.
+    LayerNodePtr TopNode() {
+        if (m_nodes.empty() || m_generation != m_state->generation || !Refresh()) return nullptr;
+
+        LayerNodePtr& slot = m_nodes.back();
+        if (slot) return slot;
+
+        LayerNodePtr node = m_state->layers.back();
+        for (size_t i = 0; i < m_folded.size(); i++) {
+            LayerNodePtr& child = node->children[m_folded[i]];
+            if (!child) {
+                child = std::make_shared<LayerNode>();
+                child->name = m_path[i];
+                m_state->topVersion++;
+            }
+            node = child;
+        }
+        m_topVersion = m_state->topVersion;
+        slot = node;
+        return node;
+    }
+
+    std::unique_ptr<LayeredKey> CreateChild(std::wstring_view name) {
+        LayerNodePtr parent = TopNode();
+        if (!parent) return nullptr;
+
+        LayerNodePtr& slot = parent->children[FoldName(name)];
+        bool replaced = slot && slot->kind == NodeKind::Deleted;
+        if (slot) Detach(*slot);
+        slot = std::make_shared<LayerNode>();
+        slot->name = name;
+        slot->kind = NodeKind::Created;
+        slot->replaced = replaced;
+        slot->lastWriteTime = CurrentFileTime();
+        parent->lastWriteTime = slot->lastWriteTime;
+        m_state->topVersion++;
+        m_topVersion = m_state->topVersion;
+        return OpenChild(name, m_nodes.size());
+    }
+
+    bool DeleteChild(std::wstring_view name, bool requireEmpty) {
+        LayerNodePtr parent = TopNode();
+        if (!parent) return false;
+
+        std::unique_ptr<LayeredKey> child = OpenChild(name, m_nodes.size());
+        if (!child) return false;
+        if (requireEmpty) {
+            // Like RegDeleteKeyW, refuse to delete a key that still has subkeys
+            std::vector<std::wstring> names;
+            child->CollectSubKeys(names);
+            if (!names.empty()) return false;
+        }
+
+        // A tombstone is needed only if the layers below have the key
+        bool below = OpenChild(name, m_nodes.size() - 1) != nullptr;
+        std::wstring folded = FoldName(name);
+        auto it = parent->children.find(folded);
+        if (it != parent->children.end()) Detach(*it->second);
+        if (below) {
+            auto tombstone = std::make_shared<LayerNode>();
+            tombstone->name = child->m_path.back();
+            tombstone->kind = NodeKind::Deleted;
+            parent->children[folded] = std::move(tombstone);
+        } else if (it != parent->children.end()) {
+            parent->children.erase(it);
+        }
+        parent->lastWriteTime = CurrentFileTime();
+        m_state->topVersion++;
+        m_topVersion = m_state->topVersion;
+        return true;
+    }
+
+    StatePtr m_state;
+    uint64_t m_generation;
+    mutable uint64_t m_topVersion;
+    KeyPtr m_base;                          // Null unless m_floor is BASE and the base has the key
+    int m_floor;
+    mutable std::vector<LayerNodePtr> m_nodes;
+    std::vector<std::wstring> m_path;       // Names from the root
+    std::vector<std::wstring> m_folded;
+    mutable bool m_deleted = false;
+};
+
+// Make the changes recorded in node to key, parents before children
+void Replay(const LayerNode& node, RegistryKey& key, LayerApplyStats& stats) {
+    // Names are unique within a node, so the values can all be set in one
+    // write and the deletes done after it
+    std::vector<RegValue> set;
+    for (const LayerValue& entry : node.values) {
+        if (!entry.removed) set.push_back(entry.value);
+    }
+    if (!set.empty()) {
+        size_t written = key.SetValues(set);
+        stats.valuesSet += written;
+        stats.errors += set.size() - written;
+    }
+    for (const LayerValue& entry : node.values) {
+        RegValue existing;
+        if (!entry.removed) continue;
+        if (key.DeleteValue(entry.value.name)) stats.valuesDeleted++;
+        else if (key.GetValue(entry.value.name, existing)) stats.errors++;
+    }
+
+    for (const auto& [folded, child] : node.children) {
+        if (child->kind == NodeKind::Overlay) {
+            KeyPtr subKey = key.OpenSubKey(child->name);
+            if (!subKey) {
+                stats.errors++;
+                continue;
+            }
+            Replay(*child, *subKey, stats);
+            continue;
+        }
+
+        // Deleted, or created from scratch: whatever is there goes first
+        if (key.OpenSubKey(child->name)) {
+            if (auto* layered = dynamic_cast<LayeredKey*>(&key)) {
+                if (layered->DeleteTree(child->name)) stats.keysDeleted++;
+                else stats.errors++;
+            } else {
+                SubtreeStats removed = DeleteSubtree(key, child->name);
+                stats.keysDeleted += removed.keys;
+                stats.errors += removed.errors;
+            }
+        }
+        if (child->kind == NodeKind::Deleted) continue;
+
+        KeyPtr created = key.CreateSubKey(child->name);
+        if (!created) {
+            stats.errors++;
+            continue;
+        }
+        stats.keysCreated++;
+        Replay(*child, *created, stats);
+    }
+}
+
+constexpr wchar_t HEX_DIGITS[] = L"0123456789abcdef";
+constexpr size_t REG_LINE_WIDTH = 76;       // Hex data wraps like regedit's
+
+void AppendQuoted(std::wstring& out, std::wstring_view text) {
+    out += L'"';
+    for (wchar_t c : text) {
+        if (c == L'\\' || c == L'"') out += L'\\';
+        out += c;
+    }
+    out += L'"';
+}
+
+// REG_SZ data that a quoted string reproduces exactly
+bool IsPlainString(const RegValue& value, std::wstring& text) {
+    if (value.type != VALUE_SZ || value.data.size() < 2 || value.data.size() % 2 != 0) return false;
+    text = DecodeString(value.data.data(), value.data.size());
+    return EncodeString(text) == value.data;
+}
+
+void AppendValueLine(std::wstring& out, const LayerValue& entry) {
+    size_t lineStart = out.size();
+    if (entry.value.name.empty()) out += L'@';
+    else AppendQuoted(out, entry.value.name);
+    out += L'=';
+
+    const RegValue& value = entry.value;
+    std::wstring text;
+    if (entry.removed) {
+        out += L'-';
+    } else if (IsPlainString(value, text)) {
+        AppendQuoted(out, text);
+    } else if (value.type == VALUE_DWORD && value.data.size() == 4) {
+        out += L"dword:";
+        for (int i = 3; i >= 0; i--) {
+            out += HEX_DIGITS[value.data[i] >> 4];
+            out += HEX_DIGITS[value.data[i] & 0x0F];
+        }
+    } else {
+        out += L"hex";
+        if (value.type != VALUE_BINARY) {
+            std::wstring type;
+            uint32_t number = value.type;
+            do {
+                type.insert(type.begin(), HEX_DIGITS[number & 0x0F]);
+                number >>= 4;
+            } while (number);
+            out += L'(' + type + L')';
+        }
+        out += L':';
+        size_t column = out.size() - lineStart;
+        for (size_t i = 0; i < value.data.size(); i++) {
+            if (column + 3 > REG_LINE_WIDTH) {
+                out += L"\\\r\n  ";
+                column = 2;
+            }
+            out += HEX_DIGITS[value.data[i] >> 4];
+            out += HEX_DIGITS[value.data[i] & 0x0F];
+            column += 2;
+            if (i + 1 < value.data.size()) {
+                out += L',';
+                column++;
+            }
+        }
+    }
+    out += L"\r\n";
+}
+
+void ExportNode(const LayerNode& node, const std::wstring& path, std::wstring& out) {
+    if (node.kind == NodeKind::Deleted || node.replaced) out += L"\r\n[-" + path + L"]\r\n";
+    if (node.kind == NodeKind::Deleted) return;
+
+    if (node.kind == NodeKind::Created || !node.values.empty()) {
+        out += L"\r\n[" + path + L"]\r\n";
+        for (const LayerValue& entry : node.values) AppendValueLine(out, entry);
+    }
+    for (const auto& [folded, child] : node.children) {
+        ExportNode(*child, path.empty() ? child->name : path + L'\\' + child->name, out);
+    }
+}
+
+} // namespace
+
+LayeredBackend::LayeredBackend(RegistryBackend& base) : m_state(std::make_shared<State>(base)) {}
+
+LayeredBackend::~LayeredBackend() = default;
+
+KeyPtr LayeredBackend::OpenRoot() {
+    std::shared_lock lock(m_state->mutex);
+    KeyPtr base = m_state->base.OpenRoot();
+    return std::make_unique<LayeredKey>(m_state, m_state->generation, m_state->topVersion, std::move(base), BASE,
+                                        m_state->layers, std::vector<std::wstring>{}, std::vector<std::wstring>{});
+}
+
+size_t LayeredBackend::LayerCount() const {
+    std::shared_lock lock(m_state->mutex);
+    return m_state->layers.size();
+}
+
+void LayeredBackend::PushLayer() {
+    std::unique_lock lock(m_state->mutex);
+    m_state->layers.push_back(std::make_shared<LayerNode>());
+    m_state->generation++;
+    m_state->topVersion++;
+}
+
+bool LayeredBackend::DiscardLayer() {
+    std::unique_lock lock(m_state->mutex);
+    if (m_state->layers.empty()) return false;
+    m_state->layers.pop_back();
+    m_state->generation++;
+    m_state->topVersion++;
+    return true;
+}
+
+bool LayeredBackend::ApplyLayer(LayerApplyStats& stats, std::wstring& error) {
+    stats = LayerApplyStats{};
+    LayerNodePtr top;
+    bool toBase;
+    {
+        std::unique_lock lock(m_state->mutex);
+        if (m_state->layers.empty()) {
+            error = L"there is no layer to apply";
+            return false;
+        }
+        toBase = m_state->layers.size() == 1;
+        if (toBase && m_state->base.IsReadOnly()) {
+            error = L"the base registry is read-only";
+            return false;
+        }
+        top = std::move(m_state->layers.back());
+        m_state->layers.pop_back();
+        m_state->generation++;
+        m_state->topVersion++;
+    }
+
+    // Replaying needs the layer off the stack so writes land below it. If
+    // anything fails it goes back on top: it records the final state of
+    // every key it touches, so the view is what it was, and applying can
+    // be retried.
+    KeyPtr root = toBase ? m_state->base.OpenRoot() : OpenRoot();
+    if (root) Replay(*top, *root, stats);
+    if (root && stats.errors == 0) return true;
+
+    error = root ? std::to_wstring(stats.errors) + L" changes could not be applied; the layer was kept"
+                 : L"cannot open the registry root";
+    std::unique_lock lock(m_state->mutex);
+    m_state->layers.push_back(std::move(top));
+    m_state->generation++;
+    m_state->topVersion++;
+    return false;
+}
+
+bool LayeredBackend::ExportLayer(std::ostream& output, std::wstring_view rootPath, std::wstring& error) const {
+    std::wstring text = L"\xFEFFWindows Registry Editor Version 5.00\r\n";
+    {
+        std::shared_lock lock(m_state->mutex);
+        if (m_state->layers.empty()) {
+            error = L"there is no layer to export";
+            return false;
+        }
+        ExportNode(*m_state->layers.back(), std::wstring(rootPath), text);
+    }
+
+    std::string bytes;
+    bytes.reserve(text.size() * 2);
+    for (wchar_t c : text) {
+        bytes += static_cast<char>(c & 0xFF);
+        bytes += static_cast<char>((c >> 8) & 0xFF);
+    }
+    output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!output) {
+        error = L"cannot write the .reg file";
+        return false;
+    }
+    return true;
+}
+
+LayerInfo LayeredBackend::GetLayerInfo() const {
+    LayerInfo info;
+    std::shared_lock lock(m_state->mutex);
+    if (m_state->layers.empty()) return info;
+
+    std::vector<const LayerNode*> pending{ m_state->layers.back().get() };
+    while (!pending.empty()) {
+        const LayerNode* node = pending.back();
+        pending.pop_back();
+        info.keys++;
+        if (node->kind == NodeKind::Created) info.createdKeys++;
+        if (node->kind == NodeKind::Deleted) info.deletedKeys++;
+        for (const LayerValue& entry : node->values) {
+            if (entry.removed) info.deletedValues++;
+            else info.setValues++;
+        }
+        for (const auto& [folded, child] : node->children) pending.push_back(child.get());
+    }
+    info.keys--;                            // Not the layer root
+    return info;
+}
+
+} // namespace core
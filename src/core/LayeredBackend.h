@@ -0,0 +1,83 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Copy-on-write virtual registry for sandbox mode. An immutable base (the
+ * live registry, a hive or any other backend) is seen through a stack of
+ * delta layers. A layer only holds what changed: per-key value overlays,
+ * value and key tombstones, and keys created in it. Writes go to the top
+ * layer; the base and the layers below it are never written.
+ *
+ * Pushing a layer is O(1) and discarding one just drops it. Applying the
+ * top layer replays it onto the layer below, or onto the base if it is the
+ * last one. ExportLayer writes the top layer as a .reg file that makes the
+ * same changes.
+ *
+ * Open keys cache their node in every layer. Lower layers are frozen, so
+ * those never go stale; the top layer's node is looked up again only after
+ * keys were created or deleted in it. Reopen keys after pushing,
+ * discarding or applying a layer: keys opened before keep their old view
+ * and refuse writes.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+struct LayerInfo {
+    uint64_t keys = 0;                  // Nodes in the layer, tombstones included
+    uint64_t createdKeys = 0;
+    uint64_t deletedKeys = 0;
+    uint64_t setValues = 0;
+    uint64_t deletedValues = 0;
+};
+
+struct LayerApplyStats {
+    uint64_t keysCreated = 0;
+    uint64_t keysDeleted = 0;           // Including their subkeys
+    uint64_t valuesSet = 0;
+    uint64_t valuesDeleted = 0;
+    uint64_t errors = 0;
+};
+
+class LayeredBackend : public RegistryBackend {
+public:
+    struct State;
+
+    explicit LayeredBackend(RegistryBackend& base);
+    ~LayeredBackend() override;
+
+    KeyPtr OpenRoot() override;
+    bool IsReadOnly() const override { return LayerCount() == 0; }
+
+    size_t LayerCount() const;
+    void PushLayer();
+    bool DiscardLayer();
+
+    // Fold the top layer into the one below it, or write it to the base if
+    // it is the only layer (the base must be writable). Each key's changes
+    // are written together, parents before children. If any change fails
+    // the layer stays on top, so nothing is lost and applying can be retried.
+    bool ApplyLayer(LayerApplyStats& stats, std::wstring& error);
+
+    // Changes in the top layer as "Windows Registry Editor Version 5.00"
+    // text (UTF-16LE with BOM). rootPath is the .reg path of the base root,
+    // e.g. HKEY_CURRENT_USER. Keys whose only change is in their subkeys
+    // get no section.
+    bool ExportLayer(std::ostream& output, std::wstring_view rootPath, std::wstring& error) const;
+
+    LayerInfo GetLayerInfo() const;
+
+private:
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace core
@@ -0,0 +1,213 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Read-only memory-mapped file (Win32 file mapping or POSIX mmap), or a
+ * private copy-on-write view whose changes never reach the file.
+ */
+
+#include "MappedFile.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!hMapping) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+bool MappedFile::OpenCopyOnWrite(const std::filesystem::path& path, size_t minimumSize) {
+    Close();
+
+    HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(hFile);
+        return false;
+    }
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+
+    if (minimumSize > size) {
+        // A file view cannot grow past the file. A larger section is no way
+        // out: CreateFileMapping only sizes a section past the end of the
+        // file by extending the file, which needs write access and would
+        // change it. So read it into zeroed memory instead.
+        void* memory = VirtualAlloc(nullptr, minimumSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        bool ok = memory != nullptr;
+        for (size_t done = 0; ok && done < size;) {
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - done, 1u << 30));
+            DWORD read = 0;
+            ok = ReadFile(hFile, static_cast<uint8_t*>(memory) + done, chunk, &read, nullptr) && read == chunk;
+            done += read;
+        }
+        CloseHandle(hFile);
+        if (!ok) {
+            if (memory) VirtualFree(memory, 0, MEM_RELEASE);
+            return false;
+        }
+        m_data = static_cast<uint8_t*>(memory);
+        m_size = minimumSize;
+        m_allocated = true;
+        m_writable = true;
+        return true;
+    }
+
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!hMapping) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    void* view = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!view) {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    m_hFile = hFile;
+    m_hMapping = hMapping;
+    m_data = static_cast<uint8_t*>(view);
+    m_size = size;
+    m_writable = true;
+    return true;
+}
+
+void MappedFile::AdviseSequential() {
+    // FILE_FLAG_SEQUENTIAL_SCAN at open time already covers the read-ahead
+}
+
+void MappedFile::Close() {
+    if (m_data && m_allocated) VirtualFree(m_data, 0, MEM_RELEASE);
+    else if (m_data) UnmapViewOfFile(m_data);
+    if (m_hMapping) CloseHandle(m_hMapping);
+    if (m_hFile) CloseHandle(m_hFile);
+    m_data = nullptr;
+    m_size = 0;
+    m_writable = false;
+    m_allocated = false;
+    m_hMapping = nullptr;
+    m_hFile = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+
+    m_data = static_cast<uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+bool MappedFile::OpenCopyOnWrite(const std::filesystem::path& path, size_t minimumSize) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    size_t size = std::max(fileSize, minimumSize);
+
+    void* view;
+    if (size > fileSize) {
+        // Zero pages for the whole view, with the file mapped over the start
+        view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (view != MAP_FAILED &&
+            mmap(view, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            munmap(view, size);
+            view = MAP_FAILED;
+        }
+    } else {
+        view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (view == MAP_FAILED) return false;
+
+    m_data = static_cast<uint8_t*>(view);
+    m_size = size;
+    m_writable = true;
+    return true;
+}
+
+void MappedFile::AdviseSequential() {
+    if (!m_data) return;
+    madvise(m_data, m_size, MADV_SEQUENTIAL);
+    madvise(m_data, m_size, MADV_WILLNEED);
+}
+
+void MappedFile::Close() {
+    if (m_data) munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_writable = false;
+}
+
+#endif
+
+} // namespace core
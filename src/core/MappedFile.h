@@ -0,0 +1,55 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Read-only memory-mapped file (Win32 file mapping or POSIX mmap), or a
+ * private copy-on-write view whose changes never reach the file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace core {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::filesystem::path& path);
+
+    // Writable private view of at least minimumSize bytes; bytes past the
+    // end of the file read as zero. Only pages that are written get copied,
+    // except on Windows when the view is larger than the file: the file is
+    // then read into an allocation, costing one sequential read of it and
+    // memory for all of it. Hive recovery only asks for that when the logs
+    // grew the hive.
+    bool OpenCopyOnWrite(const std::filesystem::path& path, size_t minimumSize = 0);
+    void Close();
+
+    // Hint that the mapping will be read front to back
+    void AdviseSequential();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const uint8_t* Data() const { return m_data; }
+    uint8_t* MutableData() { return m_writable ? m_data : nullptr; }
+    size_t Size() const { return m_size; }
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_writable = false;
+#ifdef _WIN32
+    void* m_hFile = nullptr;
+    void* m_hMapping = nullptr;
+    bool m_allocated = false;           // m_data came from VirtualAlloc
+#endif
+};
+
+} // namespace core
@@ -0,0 +1,216 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * In-memory registry backend.
+ */
+
+#include "MemoryBackend.h"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+namespace core {
+
+// Each node carries its own lock so independent subtrees can be read and
+// written from different threads without contending on a global lock.
+struct MemoryBackend::Node {
+    std::wstring name;
+    std::wstring foldedName;
+    mutable std::shared_mutex lock;
+    std::vector<std::shared_ptr<Node>> children;   // Sorted by foldedName
+    std::vector<RegValue> values;                   // Insertion order
+    uint64_t lastWriteTime = 0;
+};
+
+namespace {
+
+using NodePtr = std::shared_ptr<MemoryBackend::Node>;
+
+// Find the insertion point for a folded name in a sorted child list
+std::vector<NodePtr>::const_iterator LowerBound(const std::vector<NodePtr>& children, const std::wstring& folded) {
+    // Children usually arrive in sorted order, so check the tail first
+    if (children.empty() || children.back()->foldedName < folded) return children.end();
+    return std::lower_bound(children.begin(), children.end(), folded,
+        [](const NodePtr& node, const std::wstring& key) { return node->foldedName < key; });
+}
+
+NodePtr FindChild(const MemoryBackend::Node& parent, std::wstring_view name) {
+    std::wstring folded = FoldName(name);
+    std::shared_lock guard(parent.lock);
+    auto it = LowerBound(parent.children, folded);
+    if (it != parent.children.end() && (*it)->foldedName == folded) return *it;
+    return nullptr;
+}
+
+NodePtr FindOrCreateChild(MemoryBackend::Node& parent, std::wstring_view name) {
+    if (NodePtr existing = FindChild(parent, name)) return existing;
+
+    std::wstring folded = FoldName(name);
+    std::unique_lock guard(parent.lock);
+    auto it = LowerBound(parent.children, folded);
+    if (it != parent.children.end() && (*it)->foldedName == folded) return *it;
+
+    auto node = std::make_shared<MemoryBackend::Node>();
+    node->name = name;
+    node->foldedName = std::move(folded);
+    node->lastWriteTime = CurrentFileTime();
+    parent.children.insert(it, node);
+    parent.lastWriteTime = node->lastWriteTime;
+    return node;
+}
+
+std::vector<RegValue>::iterator FindValue(std::vector<RegValue>& values, std::wstring_view name) {
+    return std::find_if(values.begin(), values.end(),
+        [&](const RegValue& value) { return NamesEqual(value.name, name); });
+}
+
+class MemoryKey : public RegistryKey {
+public:
+    explicit MemoryKey(NodePtr node) : m_node(std::move(node)) {}
+
+    bool QueryInfo(KeyInfo& info) const override {
+        std::shared_lock guard(m_node->lock);
+        info.subKeyCount = static_cast<uint32_t>(m_node->children.size());
+        info.valueCount = static_cast<uint32_t>(m_node->values.size());
+        info.lastWriteTime = m_node->lastWriteTime;
+        return true;
+    }
+
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override {
+        std::shared_lock guard(m_node->lock);
+        if (index >= m_node->children.size()) return false;
+        name = m_node->children[index]->name;
+        return true;
+    }
+
+    bool EnumValue(uint32_t index, RegValue& value) const override {
+        std::shared_lock guard(m_node->lock);
+        if (index >= m_node->values.size()) return false;
+        value = m_node->values[index];
+        return true;
+    }
+
+    bool GetValue(std::wstring_view name, RegValue& value) const override {
+        std::shared_lock guard(m_node->lock);
+        auto it = FindValue(m_node->values, name);
+        if (it == m_node->values.end()) return false;
+        value = *it;
+        return true;
+    }
+
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        NodePtr node = m_node;
+        for (std::wstring_view part : SplitPath(path)) {
+            node = FindChild(*node, part);
+            if (!node) return nullptr;
+        }
+        return std::make_unique<MemoryKey>(std::move(node));
+    }
+
+    void GetSubKeyNames(std::vector<std::wstring>& names) const override {
+        std::shared_lock guard(m_node->lock);
+        names.clear();
+        names.reserve(m_node->children.size());
+        for (const NodePtr& child : m_node->children) {
+            names.push_back(child->name);
+        }
+    }
+
+    void GetValues(std::vector<RegValue>& values) const override {
+        std::shared_lock guard(m_node->lock);
+        values = m_node->values;
+    }
+
+    void GetValueSummaries(std::vector<ValueSummary>& values) const override {
+        std::shared_lock guard(m_node->lock);
+        values.clear();
+        values.reserve(m_node->values.size());
+        for (const RegValue& value : m_node->values) {
+            values.push_back({ value.name, value.type, static_cast<uint32_t>(value.data.size()) });
+        }
+    }
+
+    KeyPtr CreateSubKey(std::wstring_view path) override {
+        NodePtr node = m_node;
+        for (std::wstring_view part : SplitPath(path)) {
+            if (part.size() > MAX_KEY_NAME) return nullptr;
+            node = FindOrCreateChild(*node, part);
+        }
+        return std::make_unique<MemoryKey>(std::move(node));
+    }
+
+    bool SetValue(const RegValue& value) override {
+        return SetValues({ &value, 1 }) == 1;
+    }
+
+    size_t SetValues(std::span<const RegValue> values) override {
+        std::unique_lock guard(m_node->lock);
+        for (const RegValue& value : values) {
+            auto it = FindValue(m_node->values, value.name);
+            if (it != m_node->values.end()) {
+                it->type = value.type;
+                it->data = value.data;
+            } else {
+                m_node->values.push_back(value);
+            }
+        }
+        m_node->lastWriteTime = CurrentFileTime();
+        return values.size();
+    }
+
+    bool DeleteValue(std::wstring_view name) override {
+        std::unique_lock guard(m_node->lock);
+        auto it = FindValue(m_node->values, name);
+        if (it == m_node->values.end()) return false;
+        m_node->values.erase(it);
+        m_node->lastWriteTime = CurrentFileTime();
+        return true;
+    }
+
+    bool DeleteSubKey(std::wstring_view name) override {
+        std::wstring folded = FoldName(name);
+        std::unique_lock guard(m_node->lock);
+        auto it = LowerBound(m_node->children, folded);
+        if (it == m_node->children.end() || (*it)->foldedName != folded) return false;
+
+        // Like RegDeleteKeyW, refuse to delete a key that still has subkeys
+        {
+            std::shared_lock childGuard((*it)->lock);
+            if (!(*it)->children.empty()) return false;
+        }
+        m_node->children.erase(it);
+        m_node->lastWriteTime = CurrentFileTime();
+        return true;
+    }
+
+private:
+    NodePtr m_node;
+};
+
+} // namespace
+
+MemoryBackend::MemoryBackend() : m_root(std::make_shared<Node>()) {
+    m_root->lastWriteTime = CurrentFileTime();
+}
+
+MemoryBackend::~MemoryBackend() {
+    // Tear down iteratively so very deep trees cannot overflow the stack
+    std::vector<std::shared_ptr<Node>> pending;
+    pending.push_back(std::move(m_root));
+    while (!pending.empty()) {
+        std::shared_ptr<Node> node = std::move(pending.back());
+        pending.pop_back();
+        if (node.use_count() == 1) {
+            for (auto& child : node->children) pending.push_back(std::move(child));
+            node->children.clear();
+        }
+    }
+}
+
+KeyPtr MemoryBackend::OpenRoot() {
+    return std::make_unique<MemoryKey>(m_root);
+}
+
+} // namespace core
@@ -0,0 +1,31 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * In-memory registry backend. Used for sandboxes, scratch trees and for
+ * running the core engines without a live registry (e.g. on Linux).
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <memory>
+
+namespace core {
+
+class MemoryBackend : public RegistryBackend {
+public:
+    struct Node;
+
+    MemoryBackend();
+    ~MemoryBackend() override;
+
+    KeyPtr OpenRoot() override;
+    bool IsReadOnly() const override { return false; }
+
+private:
+    std::shared_ptr<Node> m_root;
+};
+
+} // namespace core
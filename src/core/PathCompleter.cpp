@@ -0,0 +1,180 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Address bar completion.
+ */
+
+#include "PathCompleter.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+
+namespace core {
+
+namespace {
+
+constexpr std::wstring_view COMPUTER_PREFIX = L"Computer\\";
+
+bool IsBlank(wchar_t c) {
+    return c == L' ' || c == L'\t' || c == L'"' || c == L'\r' || c == L'\n';
+}
+
+// Root name expanded and trailing separators dropped, so HKLM\Software and
+// HKEY_LOCAL_MACHINE\SOFTWARE\ fold to the same cache key
+std::wstring NormalizePath(std::wstring_view path) {
+    while (!path.empty() && path.back() == L'\\') path.remove_suffix(1);
+    size_t separator = path.find(L'\\');
+    std::wstring normalized(ExpandRootName(path.substr(0, separator)));
+    if (separator != std::wstring_view::npos) normalized += path.substr(separator);
+    return normalized;
+}
+
+} // namespace
+
+std::wstring_view TrimRegistryPath(std::wstring_view text) {
+    while (!text.empty() && IsBlank(text.front())) text.remove_prefix(1);
+    while (!text.empty() && IsBlank(text.back())) text.remove_suffix(1);
+    if (text.size() >= COMPUTER_PREFIX.size() && NamesEqual(text.substr(0, COMPUTER_PREFIX.size()), COMPUTER_PREFIX)) {
+        text.remove_prefix(COMPUTER_PREFIX.size());
+    }
+    while (!text.empty() && text.front() == L'\\') text.remove_prefix(1);
+    return text;
+}
+
+PathCompleter::PathCompleter(RegistryBackend& backend, size_t cacheSize)
+    : m_backend(backend), m_cacheSize(std::max<size_t>(cacheSize, 1)) {}
+
+PathCompleter::~PathCompleter() {
+    if (m_worker.joinable()) {
+        m_worker.request_stop();
+        m_worker.join();
+    }
+}
+
+bool PathCompleter::Complete(std::wstring_view text, size_t maxResults, PathCompletion& completion) {
+    completion = {};
+    std::wstring_view path = TrimRegistryPath(text);
+    size_t separator = path.rfind(L'\\');
+    std::wstring_view parent = (separator == std::wstring_view::npos) ? std::wstring_view() : path.substr(0, separator);
+    std::wstring_view partial = (separator == std::wstring_view::npos) ? path : path.substr(separator + 1);
+
+    std::shared_ptr<const PrefixIndex> index = IndexFor(parent);
+    if (!index) {
+        completion.pending = true;
+        return false;
+    }
+
+    completion.componentStart = static_cast<size_t>(partial.data() - text.data());
+    completion.totalMatches = index->Complete(partial, maxResults, completion.matches);
+    return true;
+}
+
+void PathCompleter::SetReadyCallback(std::function<void()> callback) {
+    std::lock_guard lock(m_mutex);
+    m_onReady = std::move(callback);
+}
+
+std::shared_ptr<const PrefixIndex> PathCompleter::IndexFor(std::wstring_view path) {
+    std::wstring normalized = NormalizePath(path);
+    std::wstring key = FoldName(normalized);
+
+    std::lock_guard lock(m_mutex);
+    // Still typing inside the same key: nothing to check
+    if (m_current && key == m_currentKey) return m_current;
+
+    // A cached index is used at once and checked against the key's
+    // last-write time in the background
+    uint64_t lastWriteTime = 0;
+    m_current.reset();
+    auto it = m_cache.find(key);
+    if (it != m_cache.end()) {
+        it->second.lastUsed = ++m_clock;
+        m_current = it->second.index;
+        lastWriteTime = it->second.lastWriteTime;
+    }
+    m_currentKey = key;
+    Queue({ std::move(normalized), std::move(key), lastWriteTime });
+    return m_current;
+}
+
+void PathCompleter::Store(std::wstring_view path, const std::vector<std::wstring>& names, uint64_t lastWriteTime) {
+    std::wstring key = FoldName(NormalizePath(path));
+    auto index = std::make_shared<const PrefixIndex>(names);
+
+    std::lock_guard lock(m_mutex);
+    if (key == m_currentKey) m_current = index;
+    Insert(std::move(key), std::move(index), lastWriteTime);
+}
+
+void PathCompleter::Insert(std::wstring key, std::shared_ptr<const PrefixIndex> index, uint64_t lastWriteTime) {
+    // Callers hold m_mutex
+    if (m_cache.size() >= m_cacheSize && !m_cache.contains(key)) {
+        auto oldest = std::min_element(m_cache.begin(), m_cache.end(),
+            [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        m_cache.erase(oldest);
+    }
+    CacheEntry& entry = m_cache[std::move(key)];
+    entry.index = std::move(index);
+    entry.lastWriteTime = lastWriteTime;
+    entry.lastUsed = ++m_clock;
+}
+
+void PathCompleter::Invalidate() {
+    std::lock_guard lock(m_mutex);
+    m_cache.clear();
+    m_currentKey.clear();
+    m_current.reset();
+    m_generation++;
+}
+
+void PathCompleter::Queue(Load load) {
+    // Callers hold m_mutex
+    if (!m_pending.insert(load.key).second) return;
+    m_queue.push_back(std::move(load));
+    if (!m_worker.joinable()) {
+        m_worker = std::jthread([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+    }
+    m_wake.notify_one();
+}
+
+void PathCompleter::WorkerLoop(std::stop_token stopToken) {
+    std::vector<std::wstring> names;
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        if (!m_wake.wait(lock, stopToken, [this] { return !m_queue.empty(); })) return;
+
+        // Newest first: that is the key being typed in
+        Load load = std::move(m_queue.back());
+        m_queue.pop_back();
+        uint64_t generation = m_generation;
+        lock.unlock();
+
+        // The registry is only touched here, outside the lock
+        std::shared_ptr<const PrefixIndex> index;
+        KeyInfo info;
+        KeyPtr key = m_backend.OpenKey(load.path);
+        if (key && !key->QueryInfo(info)) info.lastWriteTime = 0;
+        if (key && (load.lastWriteTime == 0 || info.lastWriteTime != load.lastWriteTime)) {
+            key->GetSubKeyNames(names);
+            index = std::make_shared<const PrefixIndex>(names);
+        }
+
+        lock.lock();
+        m_pending.erase(load.key);
+        // Unchanged since it was cached, gone, or read before an Invalidate()
+        if (!index || generation != m_generation) continue;
+        if (load.key == m_currentKey) m_current = index;
+        Insert(std::move(load.key), std::move(index), info.lastWriteTime);
+        if (stopToken.stop_requested()) return;
+
+        std::function<void()> onReady = m_onReady;
+        if (!onReady) continue;
+        lock.unlock();
+        onReady();
+        lock.lock();
+    }
+}
+
+} // namespace core
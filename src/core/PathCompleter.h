@@ -0,0 +1,102 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Address bar completion. Each key whose children are completed gets a
+ * PrefixIndex that is cached by path and revalidated against the key's
+ * last-write time only when the user moves to another key. The registry is
+ * only read on a background thread, so no keystroke waits for a large key
+ * to be enumerated.
+ */
+
+#pragma once
+
+#include "PrefixIndex.h"
+#include "RegistryBackend.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace core {
+
+struct PathCompletion {
+    size_t componentStart = 0;          // Where the last component begins in the text
+    std::vector<std::wstring> matches;  // Subkey names starting with that component
+    size_t totalMatches = 0;
+    bool pending = false;               // Subkeys still being read; complete again once ready
+};
+
+// Strip what users commonly paste around a key path ("Computer\", quotes,
+// surrounding blanks and leading or trailing separators)
+std::wstring_view TrimRegistryPath(std::wstring_view text);
+
+class PathCompleter {
+public:
+    explicit PathCompleter(RegistryBackend& backend, size_t cacheSize = 32);
+    ~PathCompleter();
+
+    PathCompleter(const PathCompleter&) = delete;
+    PathCompleter& operator=(const PathCompleter&) = delete;
+
+    // Complete the last component of a path typed relative to the backend
+    // root; root abbreviations (HKLM) are accepted. A key that is not cached
+    // yet is queued for the background thread and completion.pending is set.
+    bool Complete(std::wstring_view text, size_t maxResults, PathCompletion& completion);
+
+    // Runs on the background thread whenever a queued key has been read
+    void SetReadyCallback(std::function<void()> callback);
+
+    // Hand over names that were enumerated anyway (e.g. when a tree node expands)
+    void Store(std::wstring_view path, const std::vector<std::wstring>& names, uint64_t lastWriteTime);
+
+    // Drop all cached indexes
+    void Invalidate();
+
+private:
+    struct CacheEntry {
+        std::shared_ptr<const PrefixIndex> index;
+        uint64_t lastWriteTime = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    struct Load {
+        std::wstring path;              // Root name expanded
+        std::wstring key;               // Cache key
+        uint64_t lastWriteTime;         // Of the cached index, 0 if there is none
+    };
+
+    std::shared_ptr<const PrefixIndex> IndexFor(std::wstring_view path);
+    void Insert(std::wstring key, std::shared_ptr<const PrefixIndex> index, uint64_t lastWriteTime);
+    void Queue(Load load);
+    void WorkerLoop(std::stop_token stopToken);
+
+    RegistryBackend& m_backend;
+    size_t m_cacheSize;
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    uint64_t m_clock = 0;
+    uint64_t m_generation = 0;                              // Bumped by Invalidate()
+    std::unordered_map<std::wstring, CacheEntry> m_cache;   // Keyed by folded path
+    std::vector<Load> m_queue;
+    std::unordered_set<std::wstring> m_pending;             // Keys queued or being read
+    std::function<void()> m_onReady;
+
+    // Key the last completion ran in
+    std::wstring m_currentKey;
+    std::shared_ptr<const PrefixIndex> m_current;
+
+    std::jthread m_worker;                                  // Started by the first load
+};
+
+} // namespace core
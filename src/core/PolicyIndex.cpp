@@ -0,0 +1,533 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry.pol parsing and indexing. Workers take files in turn and turn
+ * each into a private list of keys and settings (consecutive entries of
+ * the same key reuse it without decoding the key again). The lists are
+ * merged in source order, so settings come out in the order they apply,
+ * then keys and values are sorted and every value is resolved in one pass.
+ */
+
+#include "PolicyIndex.h"
+
+#include "HiveFormat.h"
+#include "MappedFile.h"
+#include "RegistryTypes.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+namespace core {
+
+using hive::ReadU32;
+
+namespace {
+
+constexpr uint32_t PREG_SIGNATURE = 0x67655250;     // "PReg"
+constexpr uint32_t PREG_VERSION = 1;
+constexpr uint32_t PREG_HEADER_SIZE = 8;
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool HasPrefix(std::wstring_view name, std::wstring_view prefix) {
+    return name.size() >= prefix.size() && NamesEqual(name.substr(0, prefix.size()), prefix);
+}
+
+bool IsDelete(PolicyAction action) {
+    return action == PolicyAction::Delete || action == PolicyAction::DeleteAllValues ||
+           action == PolicyAction::DeleteKey;
+}
+
+// Settings that target a key rather than one of its values
+bool IsKeyAction(PolicyAction action) {
+    return action == PolicyAction::DeleteAllValues || action == PolicyAction::DeleteKeys ||
+           action == PolicyAction::SecureKey || action == PolicyAction::CreateKey ||
+           action == PolicyAction::DeleteKey;
+}
+
+// Take one UTF-16 code unit if it is the expected one
+bool Expect(const uint8_t* data, size_t size, size_t& pos, wchar_t expected) {
+    if (size - pos < 2 || data[pos] != static_cast<uint8_t>(expected) || data[pos + 1] != 0) return false;
+    pos += 2;
+    return true;
+}
+
+// Skip a NUL-terminated string; length is in code units, without the NUL
+bool SkipString(const uint8_t* data, size_t size, size_t& pos, uint32_t& length) {
+    size_t end = pos;
+    while (size - end >= 2 && (data[end] | data[end + 1])) end += 2;
+    if (size - end < 2) return false;
+    length = static_cast<uint32_t>((end - pos) / 2);
+    pos = end + 2;
+    return true;
+}
+
+bool ReadDword(const uint8_t* data, size_t size, size_t& pos, uint32_t& value) {
+    if (size - pos < 4) return false;
+    value = ReadU32(data + pos);
+    pos += 4;
+    return true;
+}
+
+struct FileSetting {
+    uint32_t key = 0;                   // Into FileResult::keys
+    std::wstring value;
+    std::wstring folded;                // Folded value name; workers fold so the merge does not
+    PolicyAction action = PolicyAction::Set;
+    uint32_t type = 0;
+    uint32_t dataSize = 0;
+    uint64_t dataOffset = 0;            // Into FileResult::data
+};
+
+struct FileResult {
+    std::vector<std::wstring> keys;     // Full paths, as spelled in the file
+    std::vector<std::wstring> folded;   // Parallel to keys
+    std::vector<FileSetting> settings;
+    std::vector<uint8_t> data;
+    uint64_t bytes = 0;
+};
+
+struct MergedKey {
+    std::wstring path;
+    std::wstring folded;
+    std::unordered_map<std::wstring, uint32_t> values;     // Folded name -> value
+};
+
+struct MergedValue {
+    std::wstring name;
+    uint32_t key = 0;
+};
+
+// Add path\relative to a file's keys (relative may have several parts)
+uint32_t AddKey(FileResult& result, std::unordered_map<std::wstring, uint32_t>& keyIndex,
+                std::wstring path, std::wstring_view relative) {
+    for (std::wstring_view part : SplitPath(relative)) {
+        path += L'\\';
+        path += part;
+    }
+    auto [it, added] = keyIndex.try_emplace(FoldName(path), static_cast<uint32_t>(result.keys.size()));
+    if (added) {
+        result.keys.push_back(std::move(path));
+        result.folded.push_back(it->first);
+    }
+    return it->second;
+}
+
+// Parse one source into its result; errors go to source.error
+void LoadSource(PolicySource& source, FileResult& result, std::vector<PolicyEntry>& entries) {
+    PolicyScope scope = source.scope;
+    std::wstring folder = source.path.parent_path().filename().wstring();
+    if (scope == PolicyScope::Auto) {
+        if (NamesEqual(folder, L"Machine")) scope = PolicyScope::Machine;
+        else if (NamesEqual(folder, L"User")) scope = PolicyScope::User;
+    }
+    if (scope == PolicyScope::Auto) {
+        source.error = L"Not in a Machine or User folder: " + source.path.wstring();
+        return;
+    }
+    source.scope = scope;
+    const wchar_t* root = scope == PolicyScope::Machine ? L"HKEY_LOCAL_MACHINE" : L"HKEY_CURRENT_USER";
+    if (source.gpo.empty()) source.gpo = source.path.parent_path().parent_path().filename().wstring();
+
+    MappedFile file;
+    if (!file.Open(source.path)) {
+        source.error = L"Cannot open " + source.path.wstring();
+        return;
+    }
+    const uint8_t* data = file.Data();
+    result.bytes = file.Size();
+    ParsePolicyFile(data, file.Size(), entries, source.error);
+    source.entries = static_cast<uint32_t>(entries.size());
+
+    std::unordered_map<std::wstring, uint32_t> keyIndex;   // Folded path -> key
+    const uint8_t* lastKey = nullptr;
+    size_t lastKeyBytes = 0;
+    uint32_t key = 0;
+    for (const PolicyEntry& entry : entries) {
+        // Entries of a key are usually adjacent; compare the raw bytes first
+        const uint8_t* keyBytes = data + entry.keyOffset;
+        size_t keyByteCount = size_t(entry.keyLength) * 2;
+        if (!lastKey || keyByteCount != lastKeyBytes || std::memcmp(keyBytes, lastKey, keyByteCount) != 0) {
+            key = AddKey(result, keyIndex, root, PolicyString(data, entry.keyOffset, entry.keyLength));
+            lastKey = keyBytes;
+            lastKeyBytes = keyByteCount;
+        }
+
+        std::wstring valueName = PolicyString(data, entry.valueOffset, entry.valueLength);
+        std::wstring_view target;
+        PolicyAction action = ClassifyPolicyValue(valueName, entry.dataSize, target);
+
+        if (action == PolicyAction::DeleteValues) {
+            // "a;b;c", as REG_SZ
+            std::wstring list = DecodeString(data + entry.dataOffset, entry.dataSize);
+            std::wstring_view rest = list;
+            while (!rest.empty()) {
+                size_t end = std::min(rest.find(L';'), rest.size());
+                if (end > 0) {
+                    std::wstring_view name = rest.substr(0, end);
+                    result.settings.push_back({ key, std::wstring(name), FoldName(name), PolicyAction::Delete, 0, 0, 0 });
+                }
+                rest.remove_prefix(std::min(end + 1, rest.size()));
+            }
+            continue;
+        }
+
+        if (action == PolicyAction::DeleteKeys) {
+            // Kept on the key as written, and one DeleteKey per listed subkey
+            std::wstring list = DecodeString(data + entry.dataOffset, entry.dataSize);
+            std::wstring_view rest = list;
+            while (!rest.empty()) {
+                size_t end = std::min(rest.find(L';'), rest.size());
+                std::wstring_view name = rest.substr(0, end);
+                if (!SplitPath(name).empty()) {
+                    uint32_t subKey = AddKey(result, keyIndex, result.keys[key], name);
+                    result.settings.push_back({ subKey, {}, {}, PolicyAction::DeleteKey, 0, 0, 0 });
+                }
+                rest.remove_prefix(std::min(end + 1, rest.size()));
+            }
+        }
+
+        FileSetting setting{ key, std::wstring(target), {}, action, entry.type, 0, result.data.size() };
+        if (!IsKeyAction(action)) setting.folded = FoldName(target);
+        if (action != PolicyAction::Delete && action != PolicyAction::DeleteAllValues && action != PolicyAction::CreateKey) {
+            setting.dataSize = entry.dataSize;
+            result.data.insert(result.data.end(), data + entry.dataOffset, data + entry.dataOffset + entry.dataSize);
+        }
+        result.settings.push_back(std::move(setting));
+    }
+}
+
+// Same result: both delete, or both set the same type and data
+bool SameOutcome(const PolicyIndex& index, uint32_t a, uint32_t b) {
+    const PolicySetting& first = index.Settings()[a];
+    const PolicySetting& second = index.Settings()[b];
+    if (IsDelete(first.action) || IsDelete(second.action)) return IsDelete(first.action) && IsDelete(second.action);
+    if (first.type != second.type) return false;
+    std::span<const uint8_t> x = index.Data(first);
+    std::span<const uint8_t> y = index.Data(second);
+    return std::equal(x.begin(), x.end(), y.begin(), y.end());
+}
+
+} // namespace
+
+bool ParsePolicyFile(const uint8_t* data, size_t size, std::vector<PolicyEntry>& entries, std::wstring& error) {
+    entries.clear();
+    if (size < PREG_HEADER_SIZE || ReadU32(data) != PREG_SIGNATURE) {
+        error = L"Not a Registry.pol file (no PReg signature)";
+        return false;
+    }
+    if (ReadU32(data + 4) != PREG_VERSION) {
+        error = L"Unsupported Registry.pol version " + std::to_wstring(ReadU32(data + 4));
+        return false;
+    }
+    if (size > UINT32_MAX) {
+        error = L"Registry.pol file is larger than 4 GB";
+        return false;
+    }
+
+    size_t pos = PREG_HEADER_SIZE;
+    while (pos < size) {
+        size_t start = pos;
+        PolicyEntry entry;
+        bool ok = Expect(data, size, pos, L'[');
+        entry.keyOffset = static_cast<uint32_t>(pos);
+        ok = ok && SkipString(data, size, pos, entry.keyLength) && Expect(data, size, pos, L';');
+        entry.valueOffset = static_cast<uint32_t>(pos);
+        ok = ok && SkipString(data, size, pos, entry.valueLength) && Expect(data, size, pos, L';');
+        ok = ok && ReadDword(data, size, pos, entry.type) && Expect(data, size, pos, L';');
+        ok = ok && ReadDword(data, size, pos, entry.dataSize) && Expect(data, size, pos, L';');
+        ok = ok && size - pos >= entry.dataSize;
+        if (ok) {
+            entry.dataOffset = static_cast<uint32_t>(pos);
+            pos += entry.dataSize;
+            ok = Expect(data, size, pos, L']');
+        }
+        if (!ok) {
+            error = L"Malformed entry at byte " + std::to_wstring(start);
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+std::wstring PolicyString(const uint8_t* data, uint32_t offset, uint32_t length) {
+    std::wstring text(length, L'\0');
+    const uint8_t* p = data + offset;
+    for (uint32_t i = 0; i < length; i++) {
+        text[i] = static_cast<wchar_t>(p[2 * i] | (p[2 * i + 1] << 8));
+    }
+    return text;
+}
+
+PolicyAction ClassifyPolicyValue(std::wstring_view valueName, uint32_t dataSize, std::wstring_view& target) {
+    target = {};
+    if (valueName.starts_with(L"**")) {
+        if (NamesEqual(valueName, L"**delvals.")) return PolicyAction::DeleteAllValues;
+        if (NamesEqual(valueName, L"**DeleteValues")) return PolicyAction::DeleteValues;
+        if (NamesEqual(valueName, L"**DeleteKeys")) return PolicyAction::DeleteKeys;
+        if (NamesEqual(valueName, L"**SecureKey")) return PolicyAction::SecureKey;
+        if (HasPrefix(valueName, L"**del.")) {
+            target = valueName.substr(6);
+            return PolicyAction::Delete;
+        }
+        if (HasPrefix(valueName, L"**soft.")) {
+            target = valueName.substr(7);
+            return PolicyAction::SoftSet;
+        }
+    }
+    if (valueName.empty() && dataSize == 0) return PolicyAction::CreateKey;
+    target = valueName;
+    return PolicyAction::Set;
+}
+
+void FindPolicyFiles(const std::filesystem::path& root, std::vector<std::filesystem::path>& files) {
+    files.clear();
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (NamesEqual(it->path().filename().wstring(), L"Registry.pol") && it->is_regular_file(ec)) {
+            files.push_back(it->path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+}
+
+bool PolicyIndex::Build(std::vector<PolicySource> sources, const PolicyIndexOptions& options,
+                        PolicyIndex& index, PolicyIndexStats& stats, std::wstring& error) {
+    auto start = std::chrono::steady_clock::now();
+    index = {};
+    stats = {};
+    stats.files = static_cast<uint32_t>(sources.size());
+
+    std::vector<FileResult> results(sources.size());
+    unsigned threadCount = options.threadCount ? options.threadCount : WorkQueue<int>::DefaultThreadCount();
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(sources.size(), 1)));
+    std::atomic<size_t> nextFile{ 0 };
+    std::atomic<bool> cancelled{ false };
+    auto work = [&] {
+        std::vector<PolicyEntry> entries;
+        size_t i;
+        while ((i = nextFile.fetch_add(1, std::memory_order_relaxed)) < sources.size()) {
+            if (options.stopToken.stop_requested()) {
+                cancelled = true;
+                return;
+            }
+            LoadSource(sources[i], results[i], entries);
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned i = 1; i < threadCount; i++) threads.emplace_back(work);
+        work();
+    }
+    if (cancelled) {
+        stats.cancelled = true;
+        stats.seconds = SecondsSince(start);
+        error = L"Cancelled";
+        return false;
+    }
+
+    // Merge in source order, so settings stay in the order they apply
+    std::vector<MergedKey> keys;
+    std::vector<MergedValue> values;
+    std::unordered_map<std::wstring, uint32_t> keyIndex;       // Folded path -> key
+    std::vector<uint32_t> keyMap;
+    for (uint32_t s = 0; s < sources.size(); s++) {
+        FileResult& result = results[s];
+        stats.bytes += result.bytes;
+        stats.entries += sources[s].entries;
+        if (!sources[s].error.empty()) stats.failedFiles++;
+
+        keyMap.clear();
+        for (size_t k = 0; k < result.keys.size(); k++) {
+            auto [it, added] = keyIndex.try_emplace(result.folded[k], static_cast<uint32_t>(keys.size()));
+            if (added) keys.push_back({ std::move(result.keys[k]), std::move(result.folded[k]), {} });
+            keyMap.push_back(it->second);
+        }
+
+        uint64_t dataBase = index.m_data.size();
+        index.m_data.insert(index.m_data.end(), result.data.begin(), result.data.end());
+        for (FileSetting& fileSetting : result.settings) {
+            PolicySetting setting{ s, keyMap[fileSetting.key], fileSetting.action, fileSetting.type,
+                                   fileSetting.dataSize, dataBase + fileSetting.dataOffset };
+            if (!IsKeyAction(fileSetting.action)) {
+                uint32_t key = setting.target;
+                auto [it, added] = keys[key].values.try_emplace(std::move(fileSetting.folded), static_cast<uint32_t>(values.size()));
+                if (added) values.push_back({ std::move(fileSetting.value), key });
+                setting.target = it->second;
+            }
+            index.m_settings.push_back(setting);
+        }
+        result = {};
+    }
+
+    // Sort keys by folded path and values by key, then name
+    std::vector<uint32_t> keyOrder(keys.size());
+    std::iota(keyOrder.begin(), keyOrder.end(), 0u);
+    std::sort(keyOrder.begin(), keyOrder.end(), [&keys](uint32_t a, uint32_t b) { return keys[a].folded < keys[b].folded; });
+    std::vector<uint32_t> keyRank(keys.size());
+    for (uint32_t i = 0; i < keyOrder.size(); i++) keyRank[keyOrder[i]] = i;
+
+    std::vector<uint32_t> valueOrder(values.size());
+    std::iota(valueOrder.begin(), valueOrder.end(), 0u);
+    std::sort(valueOrder.begin(), valueOrder.end(), [&values, &keyRank](uint32_t a, uint32_t b) {
+        if (values[a].key != values[b].key) return keyRank[values[a].key] < keyRank[values[b].key];
+        return CompareNames(values[a].name, values[b].name) < 0;
+    });
+    std::vector<uint32_t> valueRank(values.size());
+    for (uint32_t i = 0; i < valueOrder.size(); i++) valueRank[valueOrder[i]] = i;
+
+    index.m_keys.resize(keys.size());
+    index.m_foldedKeys.resize(keys.size());
+    for (uint32_t i = 0; i < keyOrder.size(); i++) {
+        index.m_keys[i].path = std::move(keys[keyOrder[i]].path);
+        index.m_foldedKeys[i] = std::move(keys[keyOrder[i]].folded);
+    }
+    index.m_values.resize(values.size());
+    for (uint32_t i = 0; i < valueOrder.size(); i++) {
+        PolicyValue& value = index.m_values[i];
+        value.key = keyRank[values[valueOrder[i]].key];
+        value.name = std::move(values[valueOrder[i]].name);
+        PolicyKey& key = index.m_keys[value.key];
+        if (key.valueCount++ == 0) key.firstValue = i;
+    }
+
+    for (uint32_t s = 0; s < index.m_settings.size(); s++) {
+        PolicySetting& setting = index.m_settings[s];
+        uint32_t key;
+        if (IsKeyAction(setting.action)) {
+            setting.target = keyRank[setting.target];
+            key = setting.target;
+            index.m_keys[key].actions.push_back(s);
+        } else {
+            setting.target = valueRank[setting.target];
+            key = index.m_values[setting.target].key;
+            index.m_values[setting.target].settings.push_back(s);
+        }
+        std::vector<uint32_t>& keySources = index.m_keys[key].sources;
+        if (keySources.empty() || keySources.back() != setting.source) keySources.push_back(setting.source);
+    }
+
+    index.m_sources = std::move(sources);
+    index.Resolve();
+    stats.seconds = SecondsSince(start);
+    return true;
+}
+
+void PolicyIndex::Resolve() {
+    // What removes a key's values: DeleteKey of the key or of a key above
+    // it, and the key's own **delvals. Keys are sorted by path, so a key's
+    // nearest indexed ancestor comes before it and is already done.
+    std::vector<std::vector<uint32_t>> subtreeDeletes(m_keys.size());
+    std::vector<std::vector<uint32_t>> removals(m_keys.size());
+    for (uint32_t k = 0; k < m_keys.size(); k++) {
+        std::wstring_view path = m_foldedKeys[k];
+        uint32_t parent = NONE;
+        for (size_t end = path.rfind(L'\\'); parent == NONE && end != std::wstring_view::npos && end > 0;
+             end = path.rfind(L'\\', end - 1)) {
+            parent = FindKey(path.substr(0, end));
+        }
+
+        std::vector<uint32_t> own;
+        for (uint32_t s : m_keys[k].actions) {
+            if (m_settings[s].action == PolicyAction::DeleteKey) own.push_back(s);
+        }
+        const std::vector<uint32_t>* inherited = parent != NONE ? &subtreeDeletes[parent] : nullptr;
+        if (inherited && !inherited->empty()) {
+            std::merge(own.begin(), own.end(), inherited->begin(), inherited->end(), std::back_inserter(subtreeDeletes[k]));
+        } else {
+            subtreeDeletes[k] = std::move(own);
+        }
+
+        if (m_keys[k].valueCount == 0) continue;
+        own.clear();
+        for (uint32_t s : m_keys[k].actions) {
+            if (m_settings[s].action == PolicyAction::DeleteAllValues) own.push_back(s);
+        }
+        std::merge(own.begin(), own.end(), subtreeDeletes[k].begin(), subtreeDeletes[k].end(), std::back_inserter(removals[k]));
+    }
+
+    // A value's history is its own settings plus what removes its key's
+    // values; both lists are in setting order, so they merge without
+    // sorting. The result follows the whole history, and each source's
+    // last word follows the part of it that came from that source.
+    std::vector<uint32_t> history;
+    std::vector<uint32_t> lastWords;
+    auto apply = [this](uint32_t& state, uint32_t s) {
+        PolicyAction action = m_settings[s].action;
+        if (action == PolicyAction::SoftSet && state != NONE && !IsDelete(m_settings[state].action)) return;
+        state = s;
+    };
+
+    for (uint32_t v = 0; v < m_values.size(); v++) {
+        PolicyValue& value = m_values[v];
+        history.clear();
+        const std::vector<uint32_t>& removed = removals[value.key];
+        std::merge(value.settings.begin(), value.settings.end(), removed.begin(), removed.end(), std::back_inserter(history));
+
+        uint32_t state = NONE;
+        uint32_t sourceState = NONE;
+        lastWords.clear();
+        for (size_t i = 0; i < history.size(); i++) {
+            uint32_t s = history[i];
+            if (i > 0 && m_settings[s].source != m_settings[history[i - 1]].source) {
+                lastWords.push_back(sourceState);
+                sourceState = NONE;
+            }
+            apply(state, s);
+            apply(sourceState, s);
+        }
+        if (sourceState != NONE) lastWords.push_back(sourceState);
+        value.effective = state;
+
+        PolicyConflict conflict{ v, state, {} };
+        for (uint32_t word : lastWords) {
+            if (m_settings[word].source != m_settings[state].source && !SameOutcome(*this, word, state)) {
+                conflict.overridden.push_back(word);
+            }
+        }
+        if (!conflict.overridden.empty()) {
+            value.conflict = true;
+            m_conflicts.push_back(std::move(conflict));
+        }
+    }
+}
+
+uint32_t PolicyIndex::FindKey(std::wstring_view path) const {
+    std::wstring folded = FoldName(path);
+    auto it = std::lower_bound(m_foldedKeys.begin(), m_foldedKeys.end(), folded);
+    if (it == m_foldedKeys.end() || *it != folded) return NONE;
+    return static_cast<uint32_t>(it - m_foldedKeys.begin());
+}
+
+uint32_t PolicyIndex::FindValue(uint32_t key, std::wstring_view name) const {
+    if (key >= m_keys.size()) return NONE;
+    auto first = m_values.begin() + m_keys[key].firstValue;
+    auto last = first + m_keys[key].valueCount;
+    auto it = std::lower_bound(first, last, name, [](const PolicyValue& value, std::wstring_view target) {
+        return CompareNames(value.name, target) < 0;
+    });
+    if (it == last || !NamesEqual(it->name, name)) return NONE;
+    return static_cast<uint32_t>(it - m_values.begin());
+}
+
+bool PolicyIndex::HasPolicyBelow(std::wstring_view path) const {
+    std::wstring prefix = FoldName(path);
+    prefix += L'\\';
+    auto it = std::lower_bound(m_foldedKeys.begin(), m_foldedKeys.end(), prefix);
+    return it != m_foldedKeys.end() && it->starts_with(prefix);
+}
+
+} // namespace core
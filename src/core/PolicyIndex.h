@@ -0,0 +1,172 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Offline Group Policy registry settings. ParsePolicyFile parses a mapped
+ * Registry.pol (PReg) image in place into entries that are byte offsets
+ * into it. PolicyIndex parses a corpus of files on worker threads and
+ * merges them, in precedence order, into a table of keys and values; it
+ * copies key paths, value names and data out of the files, so none stays
+ * mapped. Each value lists the settings that touch it, the one that wins
+ * and whether the files disagree about it.
+ *
+ * Keys are full paths under HKEY_LOCAL_MACHINE or HKEY_CURRENT_USER,
+ * depending on whether a file came from a Machine or a User folder.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+enum class PolicyScope : uint8_t {
+    Auto,                   // From the folder the file is in (Machine or User)
+    Machine,                // HKEY_LOCAL_MACHINE
+    User                    // HKEY_CURRENT_USER
+};
+
+enum class PolicyAction : uint8_t {
+    Set,
+    SoftSet,                // **soft.: only if the value does not exist yet
+    Delete,                 // **del., or named by **DeleteValues
+    DeleteValues,           // **DeleteValues: data lists values (indexed as Delete)
+    DeleteAllValues,        // **delvals.
+    DeleteKeys,             // **DeleteKeys: data lists subkeys (indexed as DeleteKey)
+    SecureKey,              // **SecureKey
+    CreateKey,              // Entry without a value name or data
+    DeleteKey               // A subkey named by **DeleteKeys, with everything below it
+};
+
+// One [key;value;type;size;data] entry. Offsets are in bytes from the
+// start of the file; string lengths are in UTF-16 code units, without the
+// terminating NUL.
+struct PolicyEntry {
+    uint32_t keyOffset = 0;
+    uint32_t keyLength = 0;
+    uint32_t valueOffset = 0;
+    uint32_t valueLength = 0;
+    uint32_t type = 0;
+    uint32_t dataOffset = 0;
+    uint32_t dataSize = 0;
+};
+
+// Parse a mapped Registry.pol image. Fails on a bad header or a
+// truncated or malformed entry; entries parsed up to that point are kept.
+bool ParsePolicyFile(const uint8_t* data, size_t size, std::vector<PolicyEntry>& entries, std::wstring& error);
+
+// Decode a string of a parsed entry
+std::wstring PolicyString(const uint8_t* data, uint32_t offset, uint32_t length);
+
+// The action an entry stands for; target receives the value it applies to
+// (the name itself for Set, the part after the prefix for **del. and
+// **soft.) and is empty for the others
+PolicyAction ClassifyPolicyValue(std::wstring_view valueName, uint32_t dataSize, std::wstring_view& target);
+
+// Registry.pol files below root, sorted by path
+void FindPolicyFiles(const std::filesystem::path& root, std::vector<std::filesystem::path>& files);
+
+struct PolicySource {
+    std::filesystem::path path;
+    PolicyScope scope = PolicyScope::Auto;
+    std::wstring gpo;                   // Name to show; empty = the folder above Machine or User
+    std::wstring error;                 // Set by Build if the file could not be read or parsed
+    uint32_t entries = 0;
+};
+
+struct PolicySetting {
+    uint32_t source = 0;                // Index into Sources(); later sources win
+    uint32_t target = 0;                // Value for value actions, key for key actions
+    PolicyAction action = PolicyAction::Set;
+    uint32_t type = 0;
+    uint32_t dataSize = 0;
+    uint64_t dataOffset = 0;            // See PolicyIndex::Data
+};
+
+struct PolicyValue {
+    uint32_t key = 0;
+    std::wstring name;                  // Empty for the (Default) value
+    std::vector<uint32_t> settings;     // Indexes into Settings(), in the order they apply
+    uint32_t effective = UINT32_MAX;    // Setting that decides the result, if any; may be a **delvals. of
+                                        // the key or a DeleteKey of it or a key above it
+    bool conflict = false;
+};
+
+struct PolicyKey {
+    std::wstring path;
+    uint32_t firstValue = 0;            // Values of a key are adjacent and sorted by name
+    uint32_t valueCount = 0;
+    std::vector<uint32_t> actions;      // Key-level settings, in the order they apply; a DeleteKey is
+                                        // listed on the key it deletes
+    std::vector<uint32_t> sources;      // Sources touching the key or its values, ascending
+};
+
+// Sources disagree about a value: the winner's result differs from the
+// last word of each overridden source
+struct PolicyConflict {
+    uint32_t value = 0;
+    uint32_t winner = 0;                // Setting
+    std::vector<uint32_t> overridden;   // Settings, one per source, in source order
+};
+
+struct PolicyIndexOptions {
+    unsigned threadCount = 0;           // 0 = one per hardware thread
+    std::stop_token stopToken;
+};
+
+struct PolicyIndexStats {
+    uint64_t bytes = 0;
+    uint64_t entries = 0;
+    uint32_t files = 0;
+    uint32_t failedFiles = 0;           // See PolicySource::error
+    double seconds = 0;
+    bool cancelled = false;
+};
+
+class PolicyIndex {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Parse sources, given lowest precedence first (the order in which
+    // Group Policy applies them), and index their settings. Files that
+    // cannot be read or parsed get their error set, and entries before a
+    // parse error are still indexed; only cancelling fails.
+    static bool Build(std::vector<PolicySource> sources, const PolicyIndexOptions& options,
+                      PolicyIndex& index, PolicyIndexStats& stats, std::wstring& error);
+
+    const std::vector<PolicySource>& Sources() const { return m_sources; }
+    const std::vector<PolicyKey>& Keys() const { return m_keys; }                  // Sorted by path, ignoring case
+    const std::vector<PolicyValue>& Values() const { return m_values; }
+    const std::vector<PolicySetting>& Settings() const { return m_settings; }      // By source, then file order
+    const std::vector<PolicyConflict>& Conflicts() const { return m_conflicts; }   // By value
+
+    std::span<const uint8_t> Data(const PolicySetting& setting) const {
+        return { m_data.data() + setting.dataOffset, setting.dataSize };
+    }
+
+    // path is a full key path, e.g. HKEY_LOCAL_MACHINE\Software\Policies
+    uint32_t FindKey(std::wstring_view path) const;
+    uint32_t FindValue(uint32_t key, std::wstring_view name) const;
+
+    // True if policy touches a key strictly below path
+    bool HasPolicyBelow(std::wstring_view path) const;
+
+private:
+    void Resolve();
+
+    std::vector<PolicySource> m_sources;
+    std::vector<PolicyKey> m_keys;
+    std::vector<std::wstring> m_foldedKeys;     // Parallel to m_keys
+    std::vector<PolicyValue> m_values;
+    std::vector<PolicySetting> m_settings;
+    std::vector<PolicyConflict> m_conflicts;
+    std::vector<uint8_t> m_data;
+};
+
+} // namespace core
@@ -0,0 +1,74 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Case-insensitive prefix index.
+ */
+
+#include "PrefixIndex.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+
+namespace core {
+
+void PrefixIndex::Build(const std::vector<std::wstring>& names) {
+    size_t total = 0;
+    for (const std::wstring& name : names) total += name.size();
+
+    m_entries.clear();
+    m_entries.reserve(names.size());
+    m_folded.clear();
+    m_folded.reserve(total);
+    m_original.clear();
+    m_original.reserve(total);
+
+    for (const std::wstring& name : names) {
+        m_entries.push_back({ static_cast<uint32_t>(m_original.size()), static_cast<uint32_t>(name.size()) });
+        m_original += name;
+        for (wchar_t c : name) m_folded.push_back(FoldChar(c));
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(),
+        [this](const Entry& a, const Entry& b) { return Folded(a) < Folded(b); });
+}
+
+std::pair<size_t, size_t> PrefixIndex::Range(std::wstring_view prefix) const {
+    std::wstring folded = FoldName(prefix);
+    std::wstring_view key = folded;
+
+    auto first = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+        [this](const Entry& entry, std::wstring_view value) { return Folded(entry) < value; });
+    // Past the prefix: compare only the first prefix.size() characters
+    auto last = std::upper_bound(first, m_entries.end(), key,
+        [this](std::wstring_view value, const Entry& entry) { return value < Folded(entry).substr(0, value.size()); });
+
+    return { static_cast<size_t>(first - m_entries.begin()), static_cast<size_t>(last - m_entries.begin()) };
+}
+
+std::wstring_view PrefixIndex::Name(size_t position) const {
+    const Entry& entry = m_entries[position];
+    return std::wstring_view(m_original).substr(entry.offset, entry.length);
+}
+
+size_t PrefixIndex::Complete(std::wstring_view prefix, size_t maxResults, std::vector<std::wstring>& matches) const {
+    matches.clear();
+    auto [first, last] = Range(prefix);
+    for (size_t i = first; i < last && matches.size() < maxResults; i++) {
+        matches.emplace_back(Name(i));
+    }
+    return last - first;
+}
+
+bool PrefixIndex::Find(std::wstring_view name, std::wstring& original) const {
+    auto [first, last] = Range(name);
+    for (size_t i = first; i < last; i++) {
+        if (m_entries[i].length == name.size()) {
+            original.assign(Name(i));
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace core
@@ -0,0 +1,57 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Case-insensitive prefix index over the subkey names of one key, used for
+ * address bar completion. Names are folded once at build time and kept
+ * sorted in a single pool, so a lookup is two binary searches.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+class PrefixIndex {
+public:
+    PrefixIndex() = default;
+    explicit PrefixIndex(const std::vector<std::wstring>& names) { Build(names); }
+
+    void Build(const std::vector<std::wstring>& names);
+
+    size_t Size() const { return m_entries.size(); }
+    bool Empty() const { return m_entries.empty(); }
+
+    // Sorted positions [first, last) of the names starting with prefix
+    std::pair<size_t, size_t> Range(std::wstring_view prefix) const;
+
+    // Name at a sorted position, in its original case
+    std::wstring_view Name(size_t position) const;
+
+    // Up to maxResults names starting with prefix, in sorted order.
+    // Returns the total number of matches.
+    size_t Complete(std::wstring_view prefix, size_t maxResults, std::vector<std::wstring>& matches) const;
+
+    // Original spelling of a name (case-insensitive lookup)
+    bool Find(std::wstring_view name, std::wstring& original) const;
+
+private:
+    struct Entry {
+        uint32_t offset;    // Into both m_folded and m_original
+        uint32_t length;
+    };
+
+    std::wstring_view Folded(const Entry& entry) const {
+        return std::wstring_view(m_folded).substr(entry.offset, entry.length);
+    }
+
+    std::vector<Entry> m_entries;   // Sorted by folded name
+    std::wstring m_folded;
+    std::wstring m_original;
+};
+
+} // namespace core
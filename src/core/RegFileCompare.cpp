@@ -0,0 +1,224 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming comparison of a registry backend against a .reg file.
+ */
+
+#include "RegFileCompare.h"
+#include "RegFileReader.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+namespace {
+
+// One open key on the current path of the file. Keys are opened relative
+// to their nearest open ancestor, so a path is never resolved from the root
+// twice. The unseen map holds registry subkeys not (yet) listed in the file.
+struct Frame {
+    std::wstring path;                                  // Relative to the backend root
+    KeyPtr key;                                         // nullptr if missing
+    std::unordered_map<std::wstring, std::wstring> unseen;  // Folded -> original name
+};
+
+// Strict: a path is not its own ancestor, so a repeated section starts afresh
+bool IsAncestor(std::wstring_view ancestor, std::wstring_view path) {
+    if (ancestor.empty()) return !path.empty();
+    return path.size() > ancestor.size() && path[ancestor.size()] == L'\\' &&
+           NamesEqual(path.substr(0, ancestor.size()), ancestor);
+}
+
+// Strip the root prefix; returns false if the path lies outside it
+bool RelativePath(std::wstring_view path, std::wstring_view prefix, std::wstring& relative) {
+    if (prefix.empty()) {
+        relative.assign(path);
+        return true;
+    }
+    if (path.size() < prefix.size() || !NamesEqual(path.substr(0, prefix.size()), prefix)) return false;
+    if (path.size() == prefix.size()) {
+        relative.clear();
+        return true;
+    }
+    if (path[prefix.size()] != L'\\') return false;
+    relative.assign(path.substr(prefix.size() + 1));
+    return true;
+}
+
+class Comparator {
+public:
+    Comparator(RegistryBackend& backend, const RegDiffCallback& onDifference,
+               const RegCompareOptions& options, RegCompareStats& stats)
+        : m_backend(backend), m_onDifference(onDifference), m_options(options), m_stats(stats) {}
+
+    void CompareKey(const RegFileKey& fileKey, const std::wstring& relative) {
+        // Leave subtrees the file has moved past
+        while (!m_frames.empty() && !IsAncestor(m_frames.back().path, relative)) {
+            PopFrame();
+        }
+
+        Frame* parent = m_frames.empty() ? nullptr : &m_frames.back();
+        std::wstring_view remainder = relative;
+        if (parent && !parent->path.empty()) remainder.remove_prefix(parent->path.size() + 1);
+
+        // A direct child listed in the file is no longer "extra"
+        if (parent && remainder.find(L'\\') == std::wstring_view::npos) {
+            parent->unseen.erase(FoldName(remainder));
+        }
+
+        KeyPtr key;
+        if (!parent) {
+            key = m_backend.OpenKey(relative);
+        } else if (parent->key) {
+            key = remainder.empty() ? nullptr : parent->key->OpenSubKey(remainder);
+        }
+
+        if (fileKey.remove) {
+            if (key) Report(RegDiffKind::UnexpectedKey, fileKey.path, {}, nullptr, nullptr);
+            return;
+        }
+        if (!key) {
+            Report(RegDiffKind::MissingKey, fileKey.path, {}, nullptr, nullptr);
+        } else {
+            CompareValues(fileKey, *key);
+        }
+
+        Frame& frame = m_frames.emplace_back();
+        frame.path = relative;
+        frame.key = std::move(key);
+        if (frame.key && m_options.reportExtraKeys) {
+            frame.key->GetSubKeyNames(m_names);
+            for (std::wstring& name : m_names) {
+                frame.unseen.emplace(FoldName(name), std::move(name));
+            }
+        }
+    }
+
+    void Finish() {
+        while (!m_frames.empty()) PopFrame();
+    }
+
+private:
+    void CompareValues(const RegFileKey& fileKey, const RegistryKey& key) {
+        key.GetValues(m_actual);
+
+        // Index the registry values by folded name
+        m_index.clear();
+        for (size_t i = 0; i < m_actual.size(); i++) {
+            m_index.emplace_back(FoldName(m_actual[i].name), i);
+        }
+        std::sort(m_index.begin(), m_index.end());
+        m_matched.assign(m_actual.size(), false);
+
+        for (const RegFileValue& entry : fileKey.values) {
+            m_stats.values++;
+            const RegValue& expected = entry.value;
+            std::wstring folded = FoldName(expected.name);
+            auto it = std::lower_bound(m_index.begin(), m_index.end(), std::make_pair(folded, size_t{0}));
+            const RegValue* actual = nullptr;
+            if (it != m_index.end() && it->first == folded) {
+                actual = &m_actual[it->second];
+                m_matched[it->second] = true;
+            }
+
+            if (entry.remove) {
+                if (actual) Report(RegDiffKind::UnexpectedValue, fileKey.path, expected.name, nullptr, actual);
+            } else if (!actual) {
+                Report(RegDiffKind::MissingValue, fileKey.path, expected.name, &expected, nullptr);
+            } else if (actual->type != expected.type || actual->data != expected.data) {
+                Report(RegDiffKind::ChangedValue, fileKey.path, expected.name, &expected, actual);
+            }
+        }
+
+        if (m_options.reportExtraValues) {
+            for (size_t i = 0; i < m_actual.size(); i++) {
+                if (!m_matched[i]) {
+                    Report(RegDiffKind::ExtraValue, fileKey.path, m_actual[i].name, nullptr, &m_actual[i]);
+                }
+            }
+        }
+    }
+
+    void PopFrame() {
+        Frame& frame = m_frames.back();
+        if (!frame.unseen.empty()) {
+            // Report in name order for stable output
+            m_names.clear();
+            for (auto& [folded, name] : frame.unseen) m_names.push_back(std::move(name));
+            std::sort(m_names.begin(), m_names.end(),
+                [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; });
+
+            std::wstring basePath = FilePathOf(frame.path);
+            for (const std::wstring& name : m_names) {
+                Report(RegDiffKind::ExtraKey, basePath + L"\\" + name, {}, nullptr, nullptr);
+            }
+        }
+        m_frames.pop_back();
+    }
+
+    // Reconstruct the .reg-style path of a frame for reporting
+    std::wstring FilePathOf(const std::wstring& relative) const {
+        if (m_options.rootPrefix.empty()) return relative;
+        return relative.empty() ? m_options.rootPrefix : m_options.rootPrefix + L"\\" + relative;
+    }
+
+    void Report(RegDiffKind kind, std::wstring_view path, std::wstring_view valueName,
+                const RegValue* expected, const RegValue* actual) {
+        m_stats.differences++;
+        if (!m_onDifference) return;
+        RegDifference difference{ kind, path, valueName, expected, actual };
+        m_onDifference(difference);
+    }
+
+    RegistryBackend& m_backend;
+    const RegDiffCallback& m_onDifference;
+    const RegCompareOptions& m_options;
+    RegCompareStats& m_stats;
+    std::vector<Frame> m_frames;
+
+    // Scratch buffers reused across keys
+    std::vector<RegValue> m_actual;
+    std::vector<std::pair<std::wstring, size_t>> m_index;
+    std::vector<bool> m_matched;
+    std::vector<std::wstring> m_names;
+};
+
+} // namespace
+
+RegCompareStats CompareWithRegFile(std::istream& input, RegistryBackend& backend,
+                                   const RegDiffCallback& onDifference, const RegCompareOptions& options) {
+    RegCompareStats stats;
+    RegFileReader reader(input);
+    Comparator comparator(backend, onDifference, options, stats);
+
+    if (reader.ReadHeader()) {
+        RegFileKey fileKey;
+        std::wstring relative;
+        while (reader.NextKey(fileKey)) {
+            if (options.stopToken.stop_requested()) {
+                stats.cancelled = true;
+                break;
+            }
+            if (!RelativePath(fileKey.path, options.rootPrefix, relative)) {
+                stats.skippedKeys++;
+                continue;
+            }
+            stats.keys++;
+            comparator.CompareKey(fileKey, relative);
+        }
+    }
+    if (!stats.cancelled) comparator.Finish();
+
+    if (reader.HasError()) {
+        stats.parseError = true;
+        stats.errorLine = reader.LineNumber();
+        stats.errorMessage = reader.Error();
+    }
+    stats.bytesRead = reader.BytesRead();
+    return stats;
+}
+
+} // namespace core
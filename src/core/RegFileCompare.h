@@ -0,0 +1,71 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming comparison of a registry backend against a .reg file. The file
+ * is read key by key and each key is looked up as it arrives; differences
+ * are reported through a callback as soon as they are found.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+enum class RegDiffKind {
+    MissingKey,         // Key in the file, absent from the registry
+    UnexpectedKey,      // [-key] in the file, but the key exists
+    ExtraKey,           // Subkey in the registry, absent from the file
+    MissingValue,       // Value in the file, absent from the registry
+    UnexpectedValue,    // "name"=- in the file, but the value exists
+    ExtraValue,         // Value in the registry, absent from the file
+    ChangedValue        // Value present in both with a different type or data
+};
+
+struct RegDifference {
+    RegDiffKind kind;
+    std::wstring_view keyPath;          // Path as written in the .reg file
+    std::wstring_view valueName;        // Empty for key differences and (Default)
+    const RegValue* expected = nullptr; // From the .reg file
+    const RegValue* actual = nullptr;   // From the registry
+};
+
+using RegDiffCallback = std::function<void(const RegDifference&)>;
+
+struct RegCompareOptions {
+    // .reg path prefix that corresponds to the backend root, e.g.
+    // "HKEY_LOCAL_MACHINE\SOFTWARE" for an offline SOFTWARE hive. Keys
+    // outside the prefix are skipped. Empty: paths are used as written.
+    std::wstring rootPrefix;
+    bool reportExtraValues = true;
+    // Extra subkeys are detected while the parent's subtree is open in the
+    // file, which assumes regedit's export order (parents before children)
+    bool reportExtraKeys = true;
+    std::stop_token stopToken;
+};
+
+struct RegCompareStats {
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    uint64_t differences = 0;
+    uint64_t skippedKeys = 0;           // Outside rootPrefix
+    uint64_t bytesRead = 0;             // For throughput (MB/s) reporting
+    bool parseError = false;
+    uint64_t errorLine = 0;
+    std::wstring errorMessage;
+    bool cancelled = false;
+};
+
+RegCompareStats CompareWithRegFile(std::istream& input, RegistryBackend& backend,
+                                   const RegDiffCallback& onDifference,
+                                   const RegCompareOptions& options = {});
+
+} // namespace core
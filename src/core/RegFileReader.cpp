@@ -0,0 +1,376 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming .reg file reader.
+ */
+
+#include "RegFileReader.h"
+
+#include <cstring>
+
+namespace core {
+
+namespace {
+
+constexpr size_t READ_CHUNK_SIZE = 256 * 1024;
+
+// Hex digit lookup: value 0-15, or 0xFF for non-hex characters
+struct HexTable {
+    uint8_t digits[128];
+    constexpr HexTable() : digits() {
+        for (int i = 0; i < 128; i++) digits[i] = 0xFF;
+        for (int i = 0; i < 10; i++) digits['0' + i] = static_cast<uint8_t>(i);
+        for (int i = 0; i < 6; i++) {
+            digits['a' + i] = static_cast<uint8_t>(10 + i);
+            digits['A' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+};
+constexpr HexTable HEX_TABLE;
+
+uint8_t HexDigit(wchar_t c) {
+    return (c >= 0 && c < 128) ? HEX_TABLE.digits[c] : 0xFF;
+}
+
+// Parse "01,02,ab" (whitespace allowed) into bytes
+bool ParseHexBytes(std::wstring_view text, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(text.size() / 3 + 1);
+    size_t i = 0;
+    while (i < text.size()) {
+        wchar_t c = text[i];
+        if (c == L',' || c == L' ' || c == L'\t') {
+            i++;
+            continue;
+        }
+        if (i + 1 >= text.size()) return false;
+        uint8_t high = HexDigit(c);
+        uint8_t low = HexDigit(text[i + 1]);
+        if (high == 0xFF || low == 0xFF) return false;
+        out.push_back(static_cast<uint8_t>((high << 4) | low));
+        i += 2;
+    }
+    return true;
+}
+
+// Parse a quoted string starting at text[pos] == '"'. On success pos is
+// just past the closing quote.
+bool ParseQuoted(std::wstring_view text, size_t& pos, std::wstring& out) {
+    out.clear();
+    for (size_t i = pos + 1; i < text.size(); i++) {
+        wchar_t c = text[i];
+        if (c == L'\\' && i + 1 < text.size()) {
+            out.push_back(text[++i]);
+        } else if (c == L'"') {
+            pos = i + 1;
+            return true;
+        } else {
+            out.push_back(c);
+        }
+    }
+    return false;
+}
+
+std::wstring_view TrimLeft(std::wstring_view text) {
+    size_t start = 0;
+    while (start < text.size() && (text[start] == L' ' || text[start] == L'\t')) start++;
+    return text.substr(start);
+}
+
+std::wstring_view TrimRight(std::wstring_view text) {
+    size_t end = text.size();
+    while (end > 0 && (text[end - 1] == L' ' || text[end - 1] == L'\t')) end--;
+    return text.substr(0, end);
+}
+
+} // namespace
+
+RegFileReader::RegFileReader(std::istream& input) : m_input(input), m_buffer(READ_CHUNK_SIZE) {}
+
+bool RegFileReader::FillBuffer() {
+    // Move the unconsumed tail (a partial line) to the front, growing the
+    // buffer when a single line does not fit
+    size_t leftover = m_end - m_pos;
+    if (leftover > 0) std::memmove(m_buffer.data(), m_buffer.data() + m_pos, leftover);
+    m_pos = 0;
+    m_end = leftover;
+    if (m_end == m_buffer.size()) m_buffer.resize(m_buffer.size() * 2);
+
+    m_input.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+    size_t count = static_cast<size_t>(m_input.gcount());
+    m_end += count;
+    m_bytesRead += count;
+    return count > 0;
+}
+
+// Offset of the next newline in the buffer, or npos if none is buffered
+size_t RegFileReader::FindNewline() const {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    if (m_encoding == Encoding::Utf16) {
+        for (size_t i = m_pos; i + 1 < m_end; i += 2) {
+            if (bytes[i] == '\n' && bytes[i + 1] == 0) return i;
+        }
+        return std::string::npos;
+    }
+    const void* newline = std::memchr(bytes + m_pos, '\n', m_end - m_pos);
+    return newline ? static_cast<size_t>(static_cast<const unsigned char*>(newline) - bytes) : std::string::npos;
+}
+
+bool RegFileReader::ReadPhysicalLine(std::wstring& line) {
+    line.clear();
+
+    size_t lineEnd = FindNewline();
+    while (lineEnd == std::string::npos && FillBuffer()) {
+        lineEnd = FindNewline();
+    }
+
+    size_t next;
+    if (lineEnd == std::string::npos) {
+        if (m_pos >= m_end) return false;  // End of file
+        lineEnd = m_end;
+        next = m_end;
+    } else {
+        next = lineEnd + ((m_encoding == Encoding::Utf16) ? 2 : 1);
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    if (m_encoding == Encoding::Utf16) {
+        for (size_t i = m_pos; i + 2 <= lineEnd; i += 2) {
+            line.push_back(static_cast<wchar_t>(bytes[i] | (bytes[i + 1] << 8)));
+        }
+    } else {
+        DecodeUtf8(bytes + m_pos, lineEnd - m_pos, line);
+    }
+    if (!line.empty() && line.back() == L'\r') line.pop_back();
+
+    m_pos = next;
+    m_lineNumber++;
+    return true;
+}
+
+// Decode UTF-8 into UTF-16 code units. Invalid bytes are taken as Latin-1
+// (the code page REGEDIT4 files are usually written in).
+void RegFileReader::DecodeUtf8(const unsigned char* bytes, size_t size, std::wstring& out) {
+    size_t i = 0;
+    while (i < size) {
+        unsigned char b = bytes[i];
+        if (b < 0x80) {
+            out.push_back(static_cast<wchar_t>(b));
+            i++;
+            continue;
+        }
+
+        size_t extra = (b >= 0xF0 && b < 0xF8) ? 3 : (b >= 0xE0) ? 2 : (b >= 0xC0) ? 1 : 0;
+        bool valid = extra > 0;
+        uint32_t codePoint = b & (0x3F >> extra);
+        for (size_t k = 1; valid && k <= extra; k++) {
+            if (i + k >= size || (bytes[i + k] & 0xC0) != 0x80) {
+                valid = false;
+                break;
+            }
+            codePoint = (codePoint << 6) | (bytes[i + k] & 0x3F);
+        }
+        if (!valid) {
+            out.push_back(static_cast<wchar_t>(b));
+            i++;
+            continue;
+        }
+
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            out.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+        } else {
+            out.push_back(static_cast<wchar_t>(codePoint));
+        }
+        i += extra + 1;
+    }
+}
+
+bool RegFileReader::ReadLogicalLine(std::wstring& line) {
+    if (!ReadPhysicalLine(line)) return false;
+
+    // Hex data is wrapped with a trailing backslash
+    while (!line.empty() && TrimRight(line).ends_with(L'\\')) {
+        line.resize(TrimRight(line).size() - 1);
+        if (!ReadPhysicalLine(m_continuation)) break;
+        line.append(TrimLeft(m_continuation));
+    }
+    return true;
+}
+
+bool RegFileReader::ReadHeader() {
+    // Detect encoding from the byte order mark
+    if (!FillBuffer()) {
+        SetError(L"Empty file");
+        return false;
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    if (m_end >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+        m_encoding = Encoding::Utf16;
+        m_pos = 2;
+    } else if (m_end >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+        m_pos = 3;
+    }
+
+    std::wstring header;
+    while (ReadPhysicalLine(header)) {
+        std::wstring_view text = TrimRight(header);
+        if (text.empty()) continue;
+        if (text == L"Windows Registry Editor Version 5.00" || text == L"REGEDIT4") return true;
+        break;
+    }
+    SetError(L"Missing .reg file header");
+    return false;
+}
+
+bool RegFileReader::NextKey(RegFileKey& key) {
+    key.path.clear();
+    key.remove = false;
+    key.values.clear();
+
+    // Find the key header (it may already have been read by the previous call)
+    if (m_nextKeyLine.empty()) {
+        while (true) {
+            if (!ReadLogicalLine(m_line)) return false;
+            std::wstring_view text = TrimLeft(m_line);
+            if (text.empty() || text.front() == L';') continue;
+            if (text.front() != L'[') {
+                SetError(L"Value outside of a key");
+                return false;
+            }
+            m_nextKeyLine.assign(TrimRight(text));
+            break;
+        }
+    }
+
+    std::wstring_view header = m_nextKeyLine;
+    if (header.size() < 2 || header.back() != L']') {
+        SetError(L"Malformed key header");
+        return false;
+    }
+    header = header.substr(1, header.size() - 2);
+    if (!header.empty() && header.front() == L'-') {
+        key.remove = true;
+        header.remove_prefix(1);
+    }
+    key.path.assign(header);
+    m_nextKeyLine.clear();
+
+    // Values follow until the next key header
+    while (ReadLogicalLine(m_line)) {
+        std::wstring_view text = TrimLeft(m_line);
+        if (text.empty() || text.front() == L';') continue;
+        if (text.front() == L'[') {
+            m_nextKeyLine.assign(TrimRight(text));
+            break;
+        }
+        RegFileValue& entry = key.values.emplace_back();
+        if (!ParseValueLine(m_line, entry)) return false;
+    }
+    return true;
+}
+
+bool RegFileReader::ParseValueLine(const std::wstring& line, RegFileValue& entry) {
+    std::wstring_view text = TrimRight(TrimLeft(line));
+    size_t pos = 0;
+
+    if (text.starts_with(L"@")) {
+        entry.value.name.clear();
+        pos = 1;
+    } else if (text.starts_with(L"\"")) {
+        if (!ParseQuoted(text, pos, entry.value.name)) {
+            SetError(L"Unterminated value name");
+            return false;
+        }
+    } else {
+        SetError(L"Malformed value line");
+        return false;
+    }
+
+    text = TrimLeft(text.substr(pos));
+    if (!text.starts_with(L"=")) {
+        SetError(L"Missing '=' after value name");
+        return false;
+    }
+    text = TrimLeft(text.substr(1));
+
+    RegValue& value = entry.value;
+    if (text == L"-") {
+        entry.remove = true;
+        value.type = VALUE_NONE;
+        value.data.clear();
+        return true;
+    }
+
+    if (text.starts_with(L"\"")) {
+        std::wstring data;
+        pos = 0;
+        if (!ParseQuoted(text, pos, data)) {
+            SetError(L"Unterminated string data");
+            return false;
+        }
+        value.type = VALUE_SZ;
+        value.data = EncodeString(data);
+        return true;
+    }
+
+    if (text.starts_with(L"dword:")) {
+        std::wstring_view digits = text.substr(6);
+        if (digits.empty() || digits.size() > 8) {
+            SetError(L"Malformed dword");
+            return false;
+        }
+        uint32_t number = 0;
+        for (wchar_t c : digits) {
+            uint8_t digit = HexDigit(c);
+            if (digit == 0xFF) {
+                SetError(L"Malformed dword");
+                return false;
+            }
+            number = (number << 4) | digit;
+        }
+        value.type = VALUE_DWORD;
+        value.data = { static_cast<uint8_t>(number), static_cast<uint8_t>(number >> 8),
+                       static_cast<uint8_t>(number >> 16), static_cast<uint8_t>(number >> 24) };
+        return true;
+    }
+
+    if (text.starts_with(L"hex")) {
+        text.remove_prefix(3);
+        value.type = VALUE_BINARY;
+        if (text.starts_with(L"(")) {
+            size_t close = text.find(L')');
+            if (close == std::wstring_view::npos || close == 1) {
+                SetError(L"Malformed hex type");
+                return false;
+            }
+            uint32_t type = 0;
+            for (wchar_t c : text.substr(1, close - 1)) {
+                uint8_t digit = HexDigit(c);
+                if (digit == 0xFF) {
+                    SetError(L"Malformed hex type");
+                    return false;
+                }
+                type = (type << 4) | digit;
+            }
+            value.type = type;
+            text.remove_prefix(close + 1);
+        }
+        if (!text.starts_with(L":") || !ParseHexBytes(text.substr(1), value.data)) {
+            SetError(L"Malformed hex data");
+            return false;
+        }
+        return true;
+    }
+
+    SetError(L"Unknown value data format");
+    return false;
+}
+
+void RegFileReader::SetError(const wchar_t* message) {
+    m_error = message;
+}
+
+} // namespace core
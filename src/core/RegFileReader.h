@@ -0,0 +1,72 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Streaming .reg file reader. Keys are returned one at a time, so memory
+ * use is bounded by the largest single key rather than the file size.
+ */
+
+#pragma once
+
+#include "RegistryTypes.h"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace core {
+
+struct RegFileValue {
+    RegValue value;
+    bool remove = false;            // "name"=- (delete the value)
+};
+
+struct RegFileKey {
+    std::wstring path;              // Full path as written, e.g. HKEY_LOCAL_MACHINE\Software
+    bool remove = false;            // [-path] (delete the key)
+    std::vector<RegFileValue> values;
+};
+
+class RegFileReader {
+public:
+    explicit RegFileReader(std::istream& input);
+
+    // Read and validate the "Windows Registry Editor Version 5.00" or
+    // "REGEDIT4" header. Must be called before NextKey().
+    bool ReadHeader();
+
+    // Read the next key with all of its values. Returns false at end of
+    // file or on a parse error (see HasError()).
+    bool NextKey(RegFileKey& key);
+
+    bool HasError() const { return !m_error.empty(); }
+    const std::wstring& Error() const { return m_error; }
+    uint64_t LineNumber() const { return m_lineNumber; }
+    uint64_t BytesRead() const { return m_bytesRead; }
+
+private:
+    enum class Encoding { Utf8, Utf16 };
+
+    bool FillBuffer();
+    size_t FindNewline() const;
+    static void DecodeUtf8(const unsigned char* bytes, size_t size, std::wstring& out);
+    bool ReadPhysicalLine(std::wstring& line);
+    bool ReadLogicalLine(std::wstring& line);
+    bool ParseValueLine(const std::wstring& line, RegFileValue& entry);
+    void SetError(const wchar_t* message);
+
+    std::istream& m_input;
+    std::vector<char> m_buffer;
+    size_t m_pos = 0;
+    size_t m_end = 0;
+    Encoding m_encoding = Encoding::Utf8;
+    std::wstring m_line;            // Scratch line buffers reused across keys
+    std::wstring m_continuation;
+    std::wstring m_nextKeyLine;     // Header of the next key, already read
+    std::wstring m_error;
+    uint64_t m_lineNumber = 0;
+    uint64_t m_bytesRead = 0;
+};
+
+} // namespace core
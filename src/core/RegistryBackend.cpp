@@ -0,0 +1,66 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Abstract registry backend (default implementations).
+ */
+
+#include "RegistryBackend.h"
+
+namespace core {
+
+void RegistryKey::GetSubKeyNames(std::vector<std::wstring>& names) const {
+    names.clear();
+    std::wstring name;
+    for (uint32_t index = 0; EnumSubKey(index, name); index++) {
+        names.push_back(name);
+    }
+}
+
+void RegistryKey::GetValues(std::vector<RegValue>& values) const {
+    values.clear();
+    RegValue value;
+    for (uint32_t index = 0; EnumValue(index, value); index++) {
+        values.push_back(value);
+    }
+}
+
+void RegistryKey::GetValueSummaries(std::vector<ValueSummary>& values) const {
+    values.clear();
+    RegValue value;
+    for (uint32_t index = 0; EnumValue(index, value); index++) {
+        values.push_back({ value.name, value.type, static_cast<uint32_t>(value.data.size()) });
+    }
+}
+
+std::unique_ptr<RegistryKey> RegistryKey::CreateSubKey([[maybe_unused]] std::wstring_view path) {
+    return nullptr;
+}
+
+bool RegistryKey::SetValue([[maybe_unused]] const RegValue& value) {
+    return false;
+}
+
+size_t RegistryKey::SetValues(std::span<const RegValue> values) {
+    size_t set = 0;
+    for (const RegValue& value : values) {
+        if (SetValue(value)) set++;
+    }
+    return set;
+}
+
+bool RegistryKey::DeleteValue([[maybe_unused]] std::wstring_view name) {
+    return false;
+}
+
+bool RegistryKey::DeleteSubKey([[maybe_unused]] std::wstring_view name) {
+    return false;
+}
+
+KeyPtr RegistryBackend::OpenKey(std::wstring_view path) {
+    KeyPtr root = OpenRoot();
+    if (!root || SplitPath(path).empty()) return root;
+    return root->OpenSubKey(path);
+}
+
+} // namespace core
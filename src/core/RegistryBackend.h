@@ -0,0 +1,61 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Abstract registry backend. Engines in src/core are written against this
+ * interface so they run on the live registry, offline hives or in memory.
+ */
+
+#pragma once
+
+#include "RegistryTypes.h"
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+// An open registry key. Closing happens in the destructor (RAII).
+// Implementations must allow concurrent calls on different keys.
+class RegistryKey {
+public:
+    virtual ~RegistryKey() = default;
+
+    // Read operations
+    virtual bool QueryInfo(KeyInfo& info) const = 0;
+    virtual bool EnumSubKey(uint32_t index, std::wstring& name) const = 0;
+    virtual bool EnumValue(uint32_t index, RegValue& value) const = 0;
+    virtual bool GetValue(std::wstring_view name, RegValue& value) const = 0;
+    virtual std::unique_ptr<RegistryKey> OpenSubKey(std::wstring_view path) const = 0;
+
+    // Bulk enumeration (defaults loop over the indexed calls above)
+    virtual void GetSubKeyNames(std::vector<std::wstring>& names) const;
+    virtual void GetValues(std::vector<RegValue>& values) const;
+    virtual void GetValueSummaries(std::vector<ValueSummary>& values) const;
+
+    // Write operations (read-only backends return false/nullptr)
+    virtual std::unique_ptr<RegistryKey> CreateSubKey(std::wstring_view path);
+    virtual bool SetValue(const RegValue& value);
+    virtual size_t SetValues(std::span<const RegValue> values);    // Bulk; returns how many were set
+    virtual bool DeleteValue(std::wstring_view name);
+    virtual bool DeleteSubKey(std::wstring_view name);  // Fails if the subkey has children
+};
+
+using KeyPtr = std::unique_ptr<RegistryKey>;
+
+// A registry namespace with a single root key
+class RegistryBackend {
+public:
+    virtual ~RegistryBackend() = default;
+
+    virtual KeyPtr OpenRoot() = 0;
+    virtual bool IsReadOnly() const { return true; }
+
+    // Open a key by its path relative to the root (empty path = root)
+    KeyPtr OpenKey(std::wstring_view path);
+};
+
+} // namespace core
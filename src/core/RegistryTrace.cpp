@@ -0,0 +1,815 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Process Monitor trace parsing. Rows are handled as UTF-8 byte views into
+ * the mapped file; a path is decoded and split only the first time a
+ * worker sees its exact spelling, after which a byte-keyed cache maps it
+ * straight to the worker's node.
+ */
+
+#include "RegistryTrace.h"
+
+#include "MappedFile.h"
+#include "RegistryTypes.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace core {
+
+namespace {
+
+constexpr uint32_t NONE = UINT32_MAX;
+
+enum class OperationKind : uint8_t {
+    Read,
+    Write,
+    Create,
+    Delete,
+    Ignore
+};
+
+struct OperationEntry {
+    std::string_view name;
+    OperationKind kind;
+    bool value;                     // The path ends in a value name
+};
+
+constexpr OperationEntry OPERATIONS[] = {
+    { "RegOpenKey", OperationKind::Read, false },
+    { "RegQueryKey", OperationKind::Read, false },
+    { "RegEnumKey", OperationKind::Read, false },
+    { "RegEnumValue", OperationKind::Read, false },
+    { "RegQueryValue", OperationKind::Read, true },
+    { "RegQueryMultipleValueKey", OperationKind::Read, false },
+    { "RegQueryKeySecurity", OperationKind::Read, false },
+    { "RegCreateKey", OperationKind::Create, false },
+    { "RegSetValue", OperationKind::Write, true },
+    { "RegSetInfoKey", OperationKind::Write, false },
+    { "RegSetKeySecurity", OperationKind::Write, false },
+    { "RegRenameKey", OperationKind::Write, false },
+    { "RegLoadKey", OperationKind::Write, false },
+    { "RegUnloadKey", OperationKind::Write, false },
+    { "RegDeleteValue", OperationKind::Delete, true },
+    { "RegDeleteKey", OperationKind::Delete, false },
+    { "RegCloseKey", OperationKind::Ignore, false },
+    { "RegFlushKey", OperationKind::Ignore, false },
+};
+
+// Results that are part of normal operation rather than failures
+constexpr std::string_view BENIGN_RESULTS[] = {
+    "SUCCESS", "BUFFER OVERFLOW", "BUFFER TOO SMALL", "NO MORE ENTRIES", "REPARSE"
+};
+
+// Event fields, as CSV columns and XML elements
+enum Column { PROCESS, PID, OPERATION, PATH, RESULT, DETAIL, COLUMN_COUNT };
+
+constexpr std::string_view CSV_HEADERS[COLUMN_COUNT] = {
+    "Process Name", "PID", "Operation", "Path", "Result", "Detail"
+};
+
+constexpr std::string_view XML_ELEMENTS[COLUMN_COUNT] = {
+    "Process_Name", "PID", "Operation", "Path", "Result", "Detail"
+};
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+};
+
+using StringMap = std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>;
+
+// Raw path bytes -> node. Open addressing with the full hash kept in the
+// slot and the bytes in one arena, so a hit costs about two cache misses
+// instead of the bucket, node and string chain of a node-based map.
+class PathCache {
+public:
+    PathCache() : m_slots(1024) {}
+
+    bool Find(std::string_view path, size_t hash, uint32_t& node) const {
+        for (size_t i = hash & (m_slots.size() - 1);; i = (i + 1) & (m_slots.size() - 1)) {
+            const Slot& slot = m_slots[i];
+            if (slot.length == EMPTY) return false;
+            if (slot.hash == hash && slot.length == path.size() &&
+                std::memcmp(m_arena.data() + slot.offset, path.data(), path.size()) == 0) {
+                node = slot.node;
+                return true;
+            }
+        }
+    }
+
+    void Insert(std::string_view path, size_t hash, uint32_t node) {
+        if ((m_count + 1) * 2 > m_slots.size()) Grow();
+        Place({ hash, m_arena.size(), static_cast<uint32_t>(path.size()), node });
+        m_arena.insert(m_arena.end(), path.begin(), path.end());
+        m_count++;
+    }
+
+private:
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct Slot {
+        size_t hash = 0;
+        size_t offset = 0;
+        uint32_t length = EMPTY;
+        uint32_t node = 0;
+    };
+
+    void Place(const Slot& entry) {
+        size_t i = entry.hash & (m_slots.size() - 1);
+        while (m_slots[i].length != EMPTY) i = (i + 1) & (m_slots.size() - 1);
+        m_slots[i] = entry;
+    }
+
+    void Grow() {
+        std::vector<Slot> old(m_slots.size() * 2);
+        old.swap(m_slots);
+        for (const Slot& slot : old) {
+            if (slot.length != EMPTY) Place(slot);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<char> m_arena;
+    size_t m_count = 0;
+};
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// UTF-8 to UTF-16 code units; invalid bytes are taken as Latin-1
+void AppendUtf8(std::string_view bytes, std::wstring& out) {
+    size_t i = 0;
+    while (i < bytes.size()) {
+        unsigned char b = static_cast<unsigned char>(bytes[i]);
+        if (b < 0x80) {
+            out.push_back(static_cast<wchar_t>(b));
+            i++;
+            continue;
+        }
+        size_t extra = (b >= 0xF0 && b < 0xF8) ? 3 : (b >= 0xE0) ? 2 : (b >= 0xC0) ? 1 : 0;
+        bool valid = extra > 0 && i + extra < bytes.size();
+        uint32_t codePoint = b & (0x3F >> extra);
+        for (size_t k = 1; valid && k <= extra; k++) {
+            unsigned char next = static_cast<unsigned char>(bytes[i + k]);
+            if ((next & 0xC0) != 0x80) valid = false;
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+        if (!valid) {
+            out.push_back(static_cast<wchar_t>(b));
+            i++;
+            continue;
+        }
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            out.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+        } else {
+            out.push_back(static_cast<wchar_t>(codePoint));
+        }
+        i += extra + 1;
+    }
+}
+
+void AppendCodePointUtf8(uint32_t codePoint, std::string& out) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | codePoint >> 6));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | codePoint >> 12));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 6 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x110000) {
+        out.push_back(static_cast<char>(0xF0 | codePoint >> 18));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 12 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint >> 6 & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+// Replace XML character and entity references
+void UnescapeXml(std::string_view text, std::string& out) {
+    static constexpr std::pair<std::string_view, char> ENTITIES[] = {
+        { "amp;", '&' }, { "lt;", '<' }, { "gt;", '>' }, { "quot;", '"' }, { "apos;", '\'' }
+    };
+    out.clear();
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t amp = text.find('&', i);
+        if (amp == std::string_view::npos) amp = text.size();
+        out.append(text, i, amp - i);
+        if (amp == text.size()) break;
+        i = amp + 1;
+
+        std::string_view rest = text.substr(i);
+        bool replaced = false;
+        for (const auto& [name, c] : ENTITIES) {
+            if (rest.starts_with(name)) {
+                out.push_back(c);
+                i += name.size();
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced && rest.starts_with('#')) {
+            bool hex = rest.size() > 1 && (rest[1] == 'x' || rest[1] == 'X');
+            size_t k = hex ? 2 : 1;
+            uint32_t codePoint = 0;
+            size_t digits = 0;
+            for (; k < rest.size() && rest[k] != ';' && digits < 8; k++, digits++) {
+                char d = rest[k];
+                int digit = (d >= '0' && d <= '9') ? d - '0'
+                          : (hex && d >= 'a' && d <= 'f') ? d - 'a' + 10
+                          : (hex && d >= 'A' && d <= 'F') ? d - 'A' + 10 : -1;
+                if (digit < 0) break;
+                codePoint = codePoint * (hex ? 16 : 10) + digit;
+            }
+            if (digits > 0 && k < rest.size() && rest[k] == ';') {
+                AppendCodePointUtf8(codePoint, out);
+                i += k + 1;
+                replaced = true;
+            }
+        }
+        if (!replaced) out.push_back('&');     // Stray ampersand, kept as is
+    }
+}
+
+// Split one CSV row into at most limit fields. Quoted fields with doubled
+// quotes are unescaped into scratch (one string per field; a deque, so
+// growing it leaves earlier fields in place).
+bool SplitCsv(std::string_view line, size_t limit, std::vector<std::string_view>& fields,
+              std::deque<std::string>& scratch) {
+    fields.clear();
+    size_t i = 0;
+    while (fields.size() < limit && i <= line.size()) {
+        if (i < line.size() && line[i] == '"') {
+            size_t start = ++i;
+            bool escaped = false;
+            while (true) {
+                size_t quote = line.find('"', i);
+                if (quote == std::string_view::npos) return false;
+                if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                    escaped = true;
+                    i = quote + 2;
+                    continue;
+                }
+                i = quote;
+                break;
+            }
+            std::string_view raw = line.substr(start, i - start);
+            if (escaped) {
+                if (scratch.size() <= fields.size()) scratch.resize(fields.size() + 1);
+                std::string& text = scratch[fields.size()];
+                text.clear();
+                for (size_t k = 0; k < raw.size(); k++) {
+                    text.push_back(raw[k]);
+                    if (raw[k] == '"') k++;
+                }
+                fields.push_back(text);
+            } else {
+                fields.push_back(raw);
+            }
+            i++;
+            if (i < line.size() && line[i] != ',') return false;
+            i++;
+        } else {
+            size_t comma = line.find(',', i);
+            if (comma == std::string_view::npos) comma = line.size();
+            fields.push_back(line.substr(i, comma - i));
+            i = comma + 1;
+        }
+    }
+    return fields.size() == limit;
+}
+
+// Interned key and value paths as a tree; node 0 is the root above the hives
+class PathTable {
+public:
+    struct Node {
+        uint32_t parent;
+        std::wstring name;
+        bool isValue;
+    };
+
+    PathTable() { m_nodes.push_back({ TraceProfile::ROOT, {}, false }); }
+
+    uint32_t Intern(uint32_t parent, std::wstring_view name, bool isValue) {
+        m_key.clear();
+        m_key.push_back(static_cast<wchar_t>(parent & 0xFFFF));
+        m_key.push_back(static_cast<wchar_t>(parent >> 16));
+        m_key.push_back(isValue ? L'v' : L'k');
+        for (wchar_t c : name) m_key.push_back(FoldChar(c));
+        auto [it, added] = m_lookup.try_emplace(m_key, static_cast<uint32_t>(m_nodes.size()));
+        if (added) m_nodes.push_back({ parent, std::wstring(name), isValue });
+        return it->second;
+    }
+
+    // Normalize the root and intern every component; NONE if the path is unusable
+    uint32_t InternPath(std::wstring_view path, bool isValue) {
+        std::vector<std::wstring_view> parts = SplitPath(path);
+        if (parts.empty()) return NONE;
+
+        std::wstring_view root = parts[0];
+        size_t first = 1;
+        if (NamesEqual(root, L"REGISTRY") && parts.size() > 1) {
+            // Native paths, e.g. \REGISTRY\MACHINE\SOFTWARE
+            if (NamesEqual(parts[1], L"MACHINE")) {
+                root = L"HKEY_LOCAL_MACHINE";
+                first = 2;
+            } else if (NamesEqual(parts[1], L"USER")) {
+                root = L"HKEY_USERS";
+                first = 2;
+            }
+        } else {
+            root = ExpandRootName(root);
+        }
+        if (isValue && parts.size() <= first) return NONE;
+
+        uint32_t node = Intern(TraceProfile::ROOT, root, false);
+        size_t keyParts = isValue ? parts.size() - 1 : parts.size();
+        for (size_t i = first; i < keyParts; i++) node = Intern(node, parts[i], false);
+        if (isValue) {
+            std::wstring_view name = parts.back();
+            if (name == L"(Default)") name = {};
+            node = Intern(node, name, true);
+        }
+        return node;
+    }
+
+    const std::vector<Node>& Nodes() const { return m_nodes; }
+
+private:
+    std::vector<Node> m_nodes;
+    std::unordered_map<std::wstring, uint32_t> m_lookup;    // Parent, kind and folded name -> node
+    std::wstring m_key;
+};
+
+// Counters per process and node. Few processes touch any one node, so each
+// node has a short chain of entries instead of a hash table slot.
+class AccessTable {
+public:
+    struct Entry {
+        uint32_t process;
+        uint32_t node;
+        uint32_t next;
+        TraceCounters counters;
+    };
+
+    TraceCounters& Get(uint32_t process, uint32_t node) {
+        if (node >= m_heads.size()) m_heads.resize(node + 1, NONE);
+        for (uint32_t i = m_heads[node]; i != NONE; i = m_entries[i].next) {
+            if (m_entries[i].process == process) return m_entries[i].counters;
+        }
+        m_entries.push_back({ process, node, m_heads[node], {} });
+        m_heads[node] = static_cast<uint32_t>(m_entries.size() - 1);
+        return m_entries.back().counters;
+    }
+
+    const std::vector<Entry>& Entries() const { return m_entries; }
+
+private:
+    std::vector<uint32_t> m_heads;          // First entry of each node
+    std::vector<Entry> m_entries;
+};
+
+struct TraceLayout {
+    TraceFormat format;
+    size_t columns[COLUMN_COUNT];       // CSV column of each field, or NONE
+    size_t columnLimit;                 // Fields to split per row
+};
+
+// Per-thread aggregation state, merged after all chunks are parsed
+class TraceWorker {
+public:
+    TraceWorker(const TraceLayout& layout, const std::unordered_set<std::wstring>& filter)
+        : m_layout(layout), m_filter(filter) {}
+
+    void ParseCsv(std::string_view text) {
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos) end = text.size();
+            std::string_view line = text.substr(pos, end - pos);
+            pos = end + 1;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty()) continue;
+
+            events++;
+            if (!SplitCsv(line, m_layout.columnLimit, m_fields, m_scratch)) {
+                malformed++;
+                continue;
+            }
+            std::string_view values[COLUMN_COUNT];
+            for (size_t c = 0; c < COLUMN_COUNT; c++) {
+                if (m_layout.columns[c] != NONE) values[c] = m_fields[m_layout.columns[c]];
+            }
+            Add(values);
+        }
+    }
+
+    // Events that start in the first limit bytes of text
+    void ParseXml(std::string_view text, size_t limit) {
+        size_t pos = 0;
+        while (true) {
+            size_t start = text.find("<event>", pos);
+            if (start == std::string_view::npos || start >= limit) break;
+            size_t end = text.find("</event>", start);
+            events++;
+            if (end == std::string_view::npos) {
+                malformed++;                // Truncated export
+                break;
+            }
+            ParseEvent(text.substr(start + 7, end - start - 7));
+            pos = end + 8;
+        }
+    }
+
+    PathTable paths;
+    std::vector<TraceProcess> processes;
+    AccessTable accesses;
+    uint64_t events = 0;
+    uint64_t registryEvents = 0;
+    uint64_t filteredEvents = 0;
+    uint64_t malformed = 0;
+
+private:
+    void ParseEvent(std::string_view body) {
+        std::string_view values[COLUMN_COUNT];
+        size_t i = 0;
+        while ((i = body.find('<', i)) != std::string_view::npos) {
+            size_t close = body.find('>', i);
+            if (close == std::string_view::npos) break;
+            std::string_view tag = body.substr(i + 1, close - i - 1);
+            i = close + 1;
+            if (tag.empty() || tag.front() == '/' || tag.back() == '/') continue;
+
+            auto field = std::find(std::begin(XML_ELEMENTS), std::end(XML_ELEMENTS), tag);
+            if (field == std::end(XML_ELEMENTS)) continue;
+            size_t end = body.find('<', i);
+            if (end == std::string_view::npos) break;
+            size_t column = field - std::begin(XML_ELEMENTS);
+            std::string_view content = body.substr(i, end - i);
+            if (content.find('&') != std::string_view::npos) {
+                if (m_scratch.size() <= column) m_scratch.resize(COLUMN_COUNT);
+                UnescapeXml(content, m_scratch[column]);
+                content = m_scratch[column];
+            }
+            values[column] = content;
+            i = end;
+        }
+        Add(values);
+    }
+
+    void Add(const std::string_view (&values)[COLUMN_COUNT]) {
+        std::string_view operation = values[OPERATION];
+        if (!operation.starts_with("Reg")) {
+            if (operation.empty()) malformed++;
+            return;                         // File, network and process events
+        }
+        const OperationEntry* entry = nullptr;
+        for (const OperationEntry& candidate : OPERATIONS) {
+            if (candidate.name == operation) {
+                entry = &candidate;
+                break;
+            }
+        }
+        if (!entry || entry->kind == OperationKind::Ignore) return;
+        if (values[PATH].empty()) {
+            malformed++;
+            return;
+        }
+
+        uint32_t process = Process(values[PROCESS], values[PID]);
+        if (process == NONE) {
+            filteredEvents++;
+            return;
+        }
+        uint32_t node = Node(values[PATH], entry->value);
+        if (node == NONE) {
+            malformed++;
+            return;
+        }
+        registryEvents++;
+
+        TraceCounters& counters = accesses.Get(process, node);
+        std::string_view result = values[RESULT];
+        bool succeeded = result.empty() || std::find(std::begin(BENIGN_RESULTS), std::end(BENIGN_RESULTS), result) != std::end(BENIGN_RESULTS);
+        if (!succeeded) {
+            counters.failures++;
+            return;
+        }
+        switch (entry->kind) {
+            case OperationKind::Read: counters.reads++; break;
+            case OperationKind::Write: counters.writes++; break;
+            case OperationKind::Delete: counters.deletes++; break;
+            case OperationKind::Create:
+                // Detail carries "Disposition: REG_OPENED_EXISTING_KEY" or "REG_CREATED_NEW_KEY"
+                if (values[DETAIL].find("REG_OPENED_EXISTING_KEY") != std::string_view::npos) counters.reads++;
+                else counters.creates++;
+                break;
+            case OperationKind::Ignore: break;
+        }
+    }
+
+    // Rows of one process usually come in runs, so the last one is remembered
+    uint32_t Process(std::string_view name, std::string_view pid) {
+        if (m_hasLast && name == m_lastName && pid == m_lastPid) return m_lastProcess;
+
+        m_processKey.assign(name);
+        m_processKey.push_back('\n');
+        m_processKey.append(pid);
+        uint32_t index;
+        auto it = m_processIndex.find(m_processKey);
+        if (it != m_processIndex.end()) {
+            index = it->second;
+        } else {
+            std::wstring wide;
+            AppendUtf8(name, wide);
+            index = NONE;
+            if (m_filter.empty() || m_filter.contains(FoldName(wide))) {
+                TraceProcess process;
+                process.name = std::move(wide);
+                for (char c : pid) {
+                    if (c >= '0' && c <= '9') process.pid = process.pid * 10 + (c - '0');
+                }
+                processes.push_back(std::move(process));
+                index = static_cast<uint32_t>(processes.size() - 1);
+            }
+            m_processIndex.emplace(m_processKey, index);
+        }
+        m_lastName.assign(name);
+        m_lastPid.assign(pid);
+        m_lastProcess = index;
+        m_hasLast = true;
+        return index;
+    }
+
+    uint32_t Node(std::string_view path, bool isValue) {
+        PathCache& cache = isValue ? m_valuePaths : m_keyPaths;
+        size_t hash = std::hash<std::string_view>{}(path);
+        uint32_t node;
+        if (cache.Find(path, hash, node)) return node;
+        m_wide.clear();
+        AppendUtf8(path, m_wide);
+        node = paths.InternPath(m_wide, isValue);
+        cache.Insert(path, hash, node);
+        return node;
+    }
+
+    const TraceLayout& m_layout;
+    const std::unordered_set<std::wstring>& m_filter;     // Folded process names
+
+    std::vector<std::string_view> m_fields;
+    std::deque<std::string> m_scratch;      // Unescaped fields
+    std::wstring m_wide;
+
+    PathCache m_keyPaths;                   // Path as written -> node
+    PathCache m_valuePaths;
+    StringMap m_processIndex;               // "name\npid" -> process or NONE
+    std::string m_processKey;
+    std::string m_lastName;
+    std::string m_lastPid;
+    uint32_t m_lastProcess = NONE;
+    bool m_hasLast = false;
+};
+
+// Chunk starts: CSV rows start after a newline, XML chunks at an <event>
+std::vector<size_t> ChunkBounds(std::string_view text, size_t begin, size_t chunkSize, TraceFormat format) {
+    std::vector<size_t> bounds{ begin };
+    size_t size = std::max<size_t>(chunkSize, 4096);
+    while (bounds.back() + size < text.size()) {
+        size_t next = format == TraceFormat::Xml ? text.find("<event>", bounds.back() + size)
+                                                 : text.find('\n', bounds.back() + size);
+        if (next == std::string_view::npos) break;
+        if (format != TraceFormat::Xml) next++;
+        bounds.push_back(next);
+    }
+    bounds.push_back(text.size());
+    return bounds;
+}
+
+} // namespace
+
+std::wstring TraceProfile::Path(uint32_t node) const {
+    std::vector<uint32_t> chain;
+    for (uint32_t n = node; n != ROOT && n < nodes.size(); n = nodes[n].parent) chain.push_back(n);
+    std::wstring path;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        if (!path.empty()) path += L'\\';
+        path += nodes[*it].name;
+    }
+    return path;
+}
+
+void TraceProfile::ChangedRoots(std::vector<uint32_t>& roots) const {
+    roots.clear();
+    // Parents come before children, so one forward pass marks created subtrees
+    std::vector<uint8_t> insideCreated(nodes.size(), 0);
+    for (uint32_t n = 1; n < nodes.size(); n++) {
+        const TraceNode& node = nodes[n];
+        bool covered = insideCreated[node.parent] != 0;
+        if (!node.isValue && node.counters.creates > 0) {
+            if (!covered) roots.push_back(n);
+            insideCreated[n] = 1;
+        } else {
+            if (node.isValue && node.counters.writes > 0 && !covered) roots.push_back(n);
+            insideCreated[n] = covered;
+        }
+    }
+}
+
+bool LoadRegistryTrace(const std::filesystem::path& path, const TraceOptions& options,
+                       TraceProfile& profile, TraceStats& stats, std::wstring& error) {
+    auto start = std::chrono::steady_clock::now();
+    profile = {};
+    stats = {};
+
+    MappedFile file;
+    if (!file.Open(path)) {
+        error = L"Cannot open " + path.wstring();
+        return false;
+    }
+    file.AdviseSequential();
+    std::string_view text(reinterpret_cast<const char*>(file.Data()), file.Size());
+    stats.bytes = text.size();
+
+    size_t begin = text.starts_with("\xEF\xBB\xBF") ? 3 : 0;
+    size_t firstChar = text.find_first_not_of(" \t\r\n", begin);
+    TraceLayout layout{};
+    layout.format = options.format;
+    if (layout.format == TraceFormat::Auto) {
+        layout.format = (firstChar != std::string_view::npos && text[firstChar] == '<') ? TraceFormat::Xml : TraceFormat::Csv;
+    }
+
+    if (layout.format == TraceFormat::Xml) {
+        size_t events = text.find("<eventlist");
+        if (events == std::string_view::npos) {
+            error = L"Not a Process Monitor XML export (no event list)";
+            return false;
+        }
+        begin = events;
+    } else {
+        // Columns are located by their header names, so any column selection works
+        size_t end = text.find('\n', begin);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view header = text.substr(begin, end - begin);
+        if (header.ends_with('\r')) header.remove_suffix(1);
+        std::vector<std::string_view> names;
+        std::deque<std::string> scratch;
+        SplitCsv(header, SIZE_MAX, names, scratch);
+        layout.columnLimit = 0;
+        for (size_t c = 0; c < COLUMN_COUNT; c++) {
+            auto found = std::find(names.begin(), names.end(), CSV_HEADERS[c]);
+            layout.columns[c] = found == names.end() ? NONE : static_cast<size_t>(found - names.begin());
+            if (found != names.end()) layout.columnLimit = std::max(layout.columnLimit, layout.columns[c] + 1);
+        }
+        if (layout.columns[OPERATION] == NONE || layout.columns[PATH] == NONE) {
+            error = L"Not a Process Monitor CSV export (no Operation and Path columns)";
+            return false;
+        }
+        begin = std::min(end + 1, text.size());
+    }
+
+    std::unordered_set<std::wstring> filter;
+    for (const std::wstring& name : options.processes) filter.insert(FoldName(name));
+
+    std::vector<size_t> bounds = ChunkBounds(text, begin, options.chunkSize, layout.format);
+    size_t chunkCount = bounds.size() - 1;
+    stats.chunks = static_cast<uint32_t>(chunkCount);
+    unsigned threadCount = options.threadCount ? options.threadCount : WorkQueue<int>::DefaultThreadCount();
+    threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(chunkCount, 1)));
+
+    // Workers take chunks in turn and never share state until the merge
+    std::vector<std::unique_ptr<TraceWorker>> workers;
+    for (unsigned i = 0; i < threadCount; i++) workers.push_back(std::make_unique<TraceWorker>(layout, filter));
+    std::atomic<size_t> nextChunk{ 0 };
+    std::atomic<bool> cancelled{ false };
+    auto work = [&](unsigned index) {
+        TraceWorker& worker = *workers[index];
+        size_t chunk;
+        while ((chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunkCount) {
+            if (options.stopToken.stop_requested()) {
+                cancelled = true;
+                return;
+            }
+            if (layout.format == TraceFormat::Xml) {
+                worker.ParseXml(text.substr(bounds[chunk]), bounds[chunk + 1] - bounds[chunk]);
+            } else {
+                worker.ParseCsv(text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]));
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned i = 1; i < threadCount; i++) threads.emplace_back(work, i);
+        work(0);
+    }
+    if (cancelled) {
+        stats.cancelled = true;
+        stats.seconds = SecondsSince(start);
+        error = L"Cancelled";
+        return false;
+    }
+
+    // Merge: re-intern each worker's nodes (parents first) and processes
+    PathTable table;
+    std::unordered_map<std::wstring, uint32_t> processIndex;   // "name\npid"
+    AccessTable accesses;
+    for (const auto& worker : workers) {
+        const std::vector<PathTable::Node>& nodes = worker->paths.Nodes();
+        std::vector<uint32_t> nodeMap(nodes.size(), TraceProfile::ROOT);
+        for (size_t n = 1; n < nodes.size(); n++) {
+            nodeMap[n] = table.Intern(nodeMap[nodes[n].parent], nodes[n].name, nodes[n].isValue);
+        }
+
+        std::vector<uint32_t> processMap;
+        for (const TraceProcess& process : worker->processes) {
+            std::wstring key = process.name + L'\n' + std::to_wstring(process.pid);
+            auto [it, added] = processIndex.try_emplace(key, static_cast<uint32_t>(profile.processes.size()));
+            if (added) profile.processes.push_back({ process.name, process.pid, {} });
+            processMap.push_back(it->second);
+        }
+
+        for (const AccessTable::Entry& entry : worker->accesses.Entries()) {
+            accesses.Get(processMap[entry.process], nodeMap[entry.node]).Add(entry.counters);
+        }
+
+        stats.events += worker->events;
+        stats.registryEvents += worker->registryEvents;
+        stats.filteredEvents += worker->filteredEvents;
+        stats.malformedEvents += worker->malformed;
+    }
+
+    // Which worker saw a path first is arbitrary, so nodes are renumbered in
+    // depth-first order with sorted children (keys before values), and
+    // processes by name and PID. The result is the same for any thread count.
+    const std::vector<PathTable::Node>& nodes = table.Nodes();
+    std::vector<std::vector<uint32_t>> children(nodes.size());
+    for (uint32_t n = 1; n < nodes.size(); n++) children[nodes[n].parent].push_back(n);
+    std::vector<uint32_t> nodeOrder(nodes.size());
+    std::vector<uint32_t> stack{ TraceProfile::ROOT };
+    uint32_t position = 0;
+    while (!stack.empty()) {
+        uint32_t n = stack.back();
+        stack.pop_back();
+        nodeOrder[n] = position++;
+        std::vector<uint32_t>& list = children[n];
+        std::sort(list.begin(), list.end(), [&nodes](uint32_t a, uint32_t b) {
+            if (nodes[a].isValue != nodes[b].isValue) return !nodes[a].isValue;
+            return CompareNames(nodes[a].name, nodes[b].name) < 0;
+        });
+        stack.insert(stack.end(), list.rbegin(), list.rend());
+    }
+    profile.nodes.resize(nodes.size());
+    for (size_t n = 0; n < nodes.size(); n++) {
+        TraceNode& node = profile.nodes[nodeOrder[n]];
+        node.parent = nodeOrder[nodes[n].parent];
+        node.name = nodes[n].name;
+        node.isValue = nodes[n].isValue;
+    }
+
+    std::vector<uint32_t> byName(profile.processes.size());
+    for (uint32_t p = 0; p < byName.size(); p++) byName[p] = p;
+    std::sort(byName.begin(), byName.end(), [&profile](uint32_t a, uint32_t b) {
+        const TraceProcess& x = profile.processes[a];
+        const TraceProcess& y = profile.processes[b];
+        int order = CompareNames(x.name, y.name);
+        return order != 0 ? order < 0 : x.pid < y.pid;
+    });
+    std::vector<uint32_t> processOrder(byName.size());
+    std::vector<TraceProcess> processes(byName.size());
+    for (uint32_t p = 0; p < byName.size(); p++) {
+        processOrder[byName[p]] = p;
+        processes[p] = std::move(profile.processes[byName[p]]);
+    }
+    profile.processes = std::move(processes);
+
+    profile.accesses.reserve(accesses.Entries().size());
+    for (const AccessTable::Entry& entry : accesses.Entries()) {
+        uint32_t process = processOrder[entry.process];
+        uint32_t node = nodeOrder[entry.node];
+        profile.nodes[node].counters.Add(entry.counters);
+        profile.processes[process].counters.Add(entry.counters);
+        profile.accesses.push_back({ process, node, entry.counters });
+    }
+    std::sort(profile.accesses.begin(), profile.accesses.end(), [](const TraceAccess& a, const TraceAccess& b) {
+        return a.node != b.node ? a.node < b.node : a.process < b.process;
+    });
+
+    stats.seconds = SecondsSince(start);
+    return true;
+}
+
+} // namespace core
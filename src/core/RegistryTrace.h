@@ -0,0 +1,116 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry activity traces from Process Monitor CSV or XML exports. The
+ * file is mapped and split into chunks at row (CSV) or <event> (XML)
+ * boundaries; workers take chunks in turn and aggregate them into private
+ * path tables and counters, which are merged once at the end. Paths are
+ * normalized (HKLM -> HKEY_LOCAL_MACHINE, \REGISTRY\MACHINE -> ...,
+ * case-insensitive) and interned as a tree of key and value nodes, which
+ * is the application's registry footprint.
+ *
+ * Only registry operations (Reg*) are counted; file, network and process
+ * events are skipped. Exports are read as UTF-8, as Process Monitor writes
+ * them; CSV rows must not span lines.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class TraceFormat {
+    Auto,                           // XML if the file starts with '<', else CSV
+    Csv,
+    Xml
+};
+
+// Successful operations are counted by kind, failed ones only as failures.
+// RegCreateKey counts as a read when it opened an existing key.
+struct TraceCounters {
+    uint64_t reads = 0;             // Open, query and enumerate
+    uint64_t writes = 0;            // Set value, key information or security; rename
+    uint64_t creates = 0;
+    uint64_t deletes = 0;
+    uint64_t failures = 0;
+
+    void Add(const TraceCounters& other) {
+        reads += other.reads;
+        writes += other.writes;
+        creates += other.creates;
+        deletes += other.deletes;
+        failures += other.failures;
+    }
+
+    uint64_t Total() const { return reads + writes + creates + deletes + failures; }
+};
+
+struct TraceNode {
+    uint32_t parent = 0;            // TraceProfile::ROOT for the hive roots
+    std::wstring name;              // As first seen; empty for the (Default) value
+    bool isValue = false;
+    TraceCounters counters;         // Operations on this node only, all processes
+};
+
+struct TraceProcess {
+    std::wstring name;              // e.g. "msiexec.exe"
+    uint32_t pid = 0;
+    TraceCounters counters;
+};
+
+struct TraceAccess {
+    uint32_t process;               // Index into TraceProfile::processes
+    uint32_t node;                  // Index into TraceProfile::nodes
+    TraceCounters counters;
+};
+
+struct TraceProfile {
+    static constexpr uint32_t ROOT = 0;
+
+    // Depth-first, children sorted by name with keys before values;
+    // nodes[ROOT] is an unnamed node above the hives
+    std::vector<TraceNode> nodes;
+    std::vector<TraceProcess> processes;    // Sorted by name, then PID
+    std::vector<TraceAccess> accesses;      // Per process and node, sorted by node then process
+
+    // Full key path; for a value node, its key's path followed by the value name
+    std::wstring Path(uint32_t node) const;
+
+    // The smallest set of nodes covering what the trace left behind: keys it
+    // created (below no other created key) and values it wrote in keys it did
+    // not create. Deleting these undoes an install, as far as the trace shows.
+    void ChangedRoots(std::vector<uint32_t>& roots) const;
+};
+
+struct TraceOptions {
+    TraceFormat format = TraceFormat::Auto;
+    std::vector<std::wstring> processes;    // Only these process names (any case); empty = all
+    unsigned threadCount = 0;               // 0 = one per hardware thread
+    size_t chunkSize = 4u << 20;            // Bytes per work item
+    std::stop_token stopToken;
+};
+
+struct TraceStats {
+    uint64_t bytes = 0;
+    uint64_t events = 0;                    // Rows or <event> elements
+    uint64_t registryEvents = 0;            // Counted in the profile
+    uint64_t filteredEvents = 0;            // Registry events of other processes
+    uint64_t malformedEvents = 0;           // Rows without an operation or path
+    uint32_t chunks = 0;
+    double seconds = 0;
+    bool cancelled = false;
+
+    double MegabytesPerSecond() const { return seconds > 0 ? bytes / seconds / 1e6 : 0.0; }
+};
+
+// Parse a Process Monitor export into profile
+bool LoadRegistryTrace(const std::filesystem::path& path, const TraceOptions& options,
+                       TraceProfile& profile, TraceStats& stats, std::wstring& error);
+
+} // namespace core
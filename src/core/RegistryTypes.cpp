@@ -0,0 +1,166 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Portable registry value/key types shared by all core engines.
+ */
+
+#include "RegistryTypes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace core {
+
+// Seconds between 1601-01-01 (FILETIME epoch) and 1970-01-01 (Unix epoch)
+constexpr uint64_t FILETIME_UNIX_EPOCH_SECONDS = 11644473600ULL;
+
+namespace {
+
+// Lower-case runs and the offset to their upper case. With step 2 only
+// every other code unit (first, first + 2, ...) is lower case. Fixed data
+// rather than towupper, whose answer depends on the C library and locale,
+// so names sort the same everywhere, and as hives sort their subkey lists.
+struct FoldRange {
+    uint16_t first;
+    uint16_t last;
+    int16_t delta;
+    uint8_t step;
+};
+
+constexpr FoldRange FOLD_RANGES[] = {
+    { 0x00E0, 0x00F6, -32, 1 },     // Latin-1
+    { 0x00F8, 0x00FE, -32, 1 },
+    { 0x00FF, 0x00FF, 0x0178 - 0x00FF, 1 },
+    { 0x0101, 0x012F, -1, 2 },      // Latin Extended-A
+    { 0x0133, 0x0137, -1, 2 },
+    { 0x013A, 0x0148, -1, 2 },
+    { 0x014B, 0x0177, -1, 2 },
+    { 0x017A, 0x017E, -1, 2 },
+    { 0x01CE, 0x01DC, -1, 2 },      // Latin Extended-B
+    { 0x01DF, 0x01EF, -1, 2 },
+    { 0x01F9, 0x021F, -1, 2 },
+    { 0x0223, 0x0233, -1, 2 },
+    { 0x03AC, 0x03AC, 0x0386 - 0x03AC, 1 },    // Greek
+    { 0x03AD, 0x03AF, -37, 1 },
+    { 0x03B1, 0x03C1, -32, 1 },
+    { 0x03C2, 0x03C2, 0x03A3 - 0x03C2, 1 },
+    { 0x03C3, 0x03CB, -32, 1 },
+    { 0x03CC, 0x03CC, 0x038C - 0x03CC, 1 },
+    { 0x03CD, 0x03CE, -63, 1 },
+    { 0x0430, 0x044F, -32, 1 },     // Cyrillic
+    { 0x0450, 0x045F, -80, 1 },
+    { 0x0461, 0x0481, -1, 2 },
+    { 0x048B, 0x04BF, -1, 2 },
+    { 0x04C2, 0x04CE, -1, 2 },
+    { 0x04D1, 0x052F, -1, 2 },
+    { 0x0561, 0x0586, -48, 1 },     // Armenian
+    { 0x1E01, 0x1E95, -1, 2 },      // Latin Extended Additional
+    { 0x1EA1, 0x1EFF, -1, 2 },
+    { 0x2170, 0x217F, -16, 1 },     // Roman numerals
+    { 0x24D0, 0x24E9, -26, 1 },     // Circled letters
+    { 0x2C30, 0x2C5E, -48, 1 },     // Glagolitic
+    { 0xFF41, 0xFF5A, -32, 1 },     // Fullwidth Latin
+};
+
+} // namespace
+
+wchar_t FoldChar(wchar_t c) {
+    // ASCII fast path; otherwise the last range starting at or before c
+    if (c < 0x80) {
+        return (c >= L'a' && c <= L'z') ? static_cast<wchar_t>(c - (L'a' - L'A')) : c;
+    }
+    auto it = std::upper_bound(std::begin(FOLD_RANGES), std::end(FOLD_RANGES), c,
+        [](wchar_t value, const FoldRange& range) { return value < range.first; });
+    if (it == std::begin(FOLD_RANGES)) return c;
+    --it;
+    if (c <= it->last && (c - it->first) % it->step == 0) return static_cast<wchar_t>(c + it->delta);
+    return c;
+}
+
+std::wstring FoldName(std::wstring_view name) {
+    std::wstring folded(name.size(), L'\0');
+    for (size_t i = 0; i < name.size(); i++) {
+        folded[i] = FoldChar(name[i]);
+    }
+    return folded;
+}
+
+int CompareNames(std::wstring_view a, std::wstring_view b) {
+    size_t count = (a.size() < b.size()) ? a.size() : b.size();
+    for (size_t i = 0; i < count; i++) {
+        wchar_t ca = FoldChar(a[i]);
+        wchar_t cb = FoldChar(b[i]);
+        if (ca != cb) return (ca < cb) ? -1 : 1;
+    }
+    if (a.size() == b.size()) return 0;
+    return (a.size() < b.size()) ? -1 : 1;
+}
+
+bool NamesEqual(std::wstring_view a, std::wstring_view b) {
+    return a.size() == b.size() && CompareNames(a, b) == 0;
+}
+
+std::vector<std::wstring_view> SplitPath(std::wstring_view path) {
+    std::vector<std::wstring_view> parts;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find(L'\\', start);
+        if (end == std::wstring_view::npos) end = path.size();
+        if (end > start) parts.push_back(path.substr(start, end - start));
+        start = end + 1;
+    }
+    return parts;
+}
+
+std::wstring_view ExpandRootName(std::wstring_view name) {
+    struct RootAlias {
+        std::wstring_view alias;
+        std::wstring_view name;
+    };
+    static constexpr RootAlias ROOT_ALIASES[] = {
+        { L"HKLM", L"HKEY_LOCAL_MACHINE" },
+        { L"HKCU", L"HKEY_CURRENT_USER" },
+        { L"HKCR", L"HKEY_CLASSES_ROOT" },
+        { L"HKU", L"HKEY_USERS" },
+        { L"HKCC", L"HKEY_CURRENT_CONFIG" },
+    };
+    for (const RootAlias& root : ROOT_ALIASES) {
+        if (NamesEqual(name, root.alias) || NamesEqual(name, root.name)) return root.name;
+    }
+    return name;
+}
+
+std::vector<uint8_t> EncodeString(std::wstring_view text, bool terminate) {
+    std::vector<uint8_t> data;
+    data.reserve((text.size() + 1) * 2);
+    for (wchar_t c : text) {
+        data.push_back(static_cast<uint8_t>(c & 0xFF));
+        data.push_back(static_cast<uint8_t>((c >> 8) & 0xFF));
+    }
+    if (terminate) {
+        data.push_back(0);
+        data.push_back(0);
+    }
+    return data;
+}
+
+std::wstring DecodeString(const uint8_t* data, size_t size) {
+    std::wstring text;
+    text.reserve(size / 2);
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        wchar_t c = static_cast<wchar_t>(data[i] | (data[i + 1] << 8));
+        if (c == L'\0') break;
+        text.push_back(c);
+    }
+    return text;
+}
+
+uint64_t CurrentFileTime() {
+    auto sinceUnix = std::chrono::system_clock::now().time_since_epoch();
+    auto ticks = std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(sinceUnix);
+    return static_cast<uint64_t>(ticks.count()) + FILETIME_UNIX_EPOCH_SECONDS * 10000000ULL;
+}
+
+} // namespace core
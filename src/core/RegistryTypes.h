@@ -0,0 +1,82 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Portable registry value/key types shared by all core engines.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+// Registry value types (same numbering as the REG_* constants in winnt.h)
+constexpr uint32_t VALUE_NONE = 0;
+constexpr uint32_t VALUE_SZ = 1;
+constexpr uint32_t VALUE_EXPAND_SZ = 2;
+constexpr uint32_t VALUE_BINARY = 3;
+constexpr uint32_t VALUE_DWORD = 4;
+constexpr uint32_t VALUE_DWORD_BIG_ENDIAN = 5;
+constexpr uint32_t VALUE_LINK = 6;
+constexpr uint32_t VALUE_MULTI_SZ = 7;
+constexpr uint32_t VALUE_RESOURCE_LIST = 8;
+constexpr uint32_t VALUE_FULL_RESOURCE_DESCRIPTOR = 9;
+constexpr uint32_t VALUE_RESOURCE_REQUIREMENTS_LIST = 10;
+constexpr uint32_t VALUE_QWORD = 11;
+
+// Maximum key name length in characters (as enforced by the registry)
+constexpr size_t MAX_KEY_NAME = 255;
+
+// Maximum key nesting depth (as enforced by the registry)
+constexpr size_t MAX_KEY_DEPTH = 512;
+
+// Strings in core hold UTF-16 code units on every platform (one code unit
+// per wchar_t, also where wchar_t is 32 bits), so names and string data
+// round-trip exactly, including unpaired surrogates and embedded NULs.
+
+// A single registry value: name, type and raw data bytes
+struct RegValue {
+    std::wstring name;              // Empty name is the (Default) value
+    uint32_t type = VALUE_NONE;
+    std::vector<uint8_t> data;
+};
+
+// Value metadata without the data bytes
+struct ValueSummary {
+    std::wstring name;
+    uint32_t type = VALUE_NONE;
+    uint32_t dataSize = 0;
+};
+
+// Summary information about an open key
+struct KeyInfo {
+    uint32_t subKeyCount = 0;
+    uint32_t valueCount = 0;
+    uint64_t lastWriteTime = 0;     // FILETIME (100ns ticks since 1601-01-01 UTC)
+};
+
+// Registry name comparison is case-insensitive (upper-case folding)
+wchar_t FoldChar(wchar_t c);
+std::wstring FoldName(std::wstring_view name);
+int CompareNames(std::wstring_view a, std::wstring_view b);
+bool NamesEqual(std::wstring_view a, std::wstring_view b);
+
+// Split a backslash-separated key path into components (empty parts are skipped)
+std::vector<std::wstring_view> SplitPath(std::wstring_view path);
+
+// Full name of a predefined root key, given its abbreviation (HKLM) or its
+// name in any case; other names are returned unchanged
+std::wstring_view ExpandRootName(std::wstring_view name);
+
+// Convert between strings and REG_SZ-style UTF-16LE data bytes
+std::vector<uint8_t> EncodeString(std::wstring_view text, bool terminate = true);
+std::wstring DecodeString(const uint8_t* data, size_t size);   // Stops at the first NUL
+
+// Current time as a FILETIME tick count
+uint64_t CurrentFileTime();
+
+} // namespace core
@@ -0,0 +1,777 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Script VM: a register machine over a flat instruction array. Values are
+ * a small variant; keys carry their open handle and path, and value loop
+ * variables point into the loop's shared enumeration buffer.
+ */
+
+#include "Script.h"
+
+#include "SubtreeOps.h"
+
+#include <chrono>
+#include <cwctype>
+#include <memory>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace core {
+
+namespace {
+
+using namespace script;
+
+struct KeyObject {
+    KeyPtr key;
+    std::wstring path;                  // Relative to the backend root
+    std::wstring name;
+    std::wstring folded;                // FoldName(path), set once the key has queued writes
+    bool hasFolded = false;
+};
+
+using KeyRef = std::shared_ptr<KeyObject>;
+using ValueRef = std::shared_ptr<const RegValue>;
+
+struct KeyIterator {
+    struct Frame {
+        KeyRef key;
+        std::vector<std::wstring> names;
+        size_t next = 0;
+        bool loaded = false;
+    };
+
+    std::vector<Frame> stack;           // Pre-order walk; one frame when not recursive
+    bool recursive = false;
+};
+
+struct ValueIterator {
+    std::shared_ptr<std::vector<RegValue>> values;
+    size_t next = 0;
+};
+
+using Value = std::variant<std::monostate, int64_t, std::wstring, KeyRef, ValueRef,
+                           std::shared_ptr<KeyIterator>, std::shared_ptr<ValueIterator>>;
+
+constexpr uint32_t STOP_CHECK_MASK = 0x3FFF;    // Instructions between cancellation checks
+
+const wchar_t* const FIELD_NAMES[] = {
+    L"name", L"path", L"type", L"data", L"size", L"subkeys", L"values", L"lastwrite"
+};
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::wstring ChildPath(const std::wstring& parent, std::wstring_view name) {
+    std::wstring path;
+    path.reserve(parent.size() + name.size() + 1);
+    path = parent;
+    if (!path.empty()) path += L'\\';
+    path += name;
+    return path;
+}
+
+const wchar_t* TypeName(const Value& value) {
+    switch (value.index()) {
+        case 0: return L"null";
+        case 1: return L"integer";
+        case 2: return L"string";
+        case 3: return L"key";
+        case 4: return L"value";
+        default: return L"iterator";
+    }
+}
+
+std::wstring HexString(const std::vector<uint8_t>& data) {
+    static constexpr wchar_t DIGITS[] = L"0123456789abcdef";
+    std::wstring text(data.size() * 2, L'0');
+    for (size_t i = 0; i < data.size(); i++) {
+        text[i * 2] = DIGITS[data[i] >> 4];
+        text[i * 2 + 1] = DIGITS[data[i] & 0xF];
+    }
+    return text;
+}
+
+// Value data as a script value: strings, integers, or hex for anything else
+Value DataOf(const RegValue& value) {
+    const std::vector<uint8_t>& data = value.data;
+    switch (value.type) {
+        case VALUE_SZ:
+        case VALUE_EXPAND_SZ:
+        case VALUE_LINK:
+            return DecodeString(data.data(), data.size());
+        case VALUE_DWORD:
+            if (data.size() == 4) return static_cast<int64_t>(data[0] | data[1] << 8 | data[2] << 16 | uint32_t{ data[3] } << 24);
+            break;
+        case VALUE_DWORD_BIG_ENDIAN:
+            if (data.size() == 4) return static_cast<int64_t>(uint32_t{ data[0] } << 24 | data[1] << 16 | data[2] << 8 | data[3]);
+            break;
+        case VALUE_QWORD:
+            if (data.size() == 8) {
+                uint64_t number = 0;
+                for (size_t i = 8; i > 0; i--) number = number << 8 | data[i - 1];
+                return static_cast<int64_t>(number);
+            }
+            break;
+        case VALUE_MULTI_SZ: {
+            // Strings joined with newlines; the terminating empty string is dropped
+            std::wstring text;
+            for (size_t i = 0; i + 1 < data.size(); i += 2) {
+                text.push_back(static_cast<wchar_t>(data[i] | data[i + 1] << 8));
+            }
+            while (!text.empty() && text.back() == L'\0') text.pop_back();
+            for (wchar_t& c : text) {
+                if (c == L'\0') c = L'\n';
+            }
+            return text;
+        }
+    }
+    return HexString(data);
+}
+
+std::wstring ToString(const Value& value) {
+    switch (value.index()) {
+        case 0: return L"null";
+        case 1: return std::to_wstring(std::get<int64_t>(value));
+        case 2: return std::get<std::wstring>(value);
+        case 3: return std::get<KeyRef>(value)->path;
+        case 4: return ToString(DataOf(*std::get<ValueRef>(value)));
+        default: return L"<iterator>";
+    }
+}
+
+bool Truthy(const Value& value) {
+    switch (value.index()) {
+        case 0: return false;
+        case 1: return std::get<int64_t>(value) != 0;
+        case 2: return !std::get<std::wstring>(value).empty();
+        default: return true;
+    }
+}
+
+// Decimal or 0x hexadecimal, with an optional sign
+bool ParseInteger(std::wstring_view text, int64_t& result) {
+    bool negative = !text.empty() && text[0] == L'-';
+    if (negative || (!text.empty() && text[0] == L'+')) text.remove_prefix(1);
+    int base = 10;
+    if (text.size() > 2 && text[0] == L'0' && (text[1] == L'x' || text[1] == L'X')) {
+        base = 16;
+        text.remove_prefix(2);
+    }
+    if (text.empty()) return false;
+    uint64_t value = 0;
+    for (wchar_t c : text) {
+        int digit = (c >= L'0' && c <= L'9') ? c - L'0'
+                  : (base == 16 && c >= L'a' && c <= L'f') ? c - L'a' + 10
+                  : (base == 16 && c >= L'A' && c <= L'F') ? c - L'A' + 10 : -1;
+        if (digit < 0 || value > (UINT64_MAX - digit) / base) return false;
+        value = value * base + digit;
+    }
+    result = static_cast<int64_t>(negative ? 0 - value : value);
+    return true;
+}
+
+std::wstring Folded(const std::wstring& text) {
+    std::wstring folded(text);
+    for (wchar_t& c : folded) c = FoldChar(c);
+    return folded;
+}
+
+class Machine {
+public:
+    Machine(const Program& program, RegistryBackend& backend, const ScriptOptions& options, ScriptStats& stats)
+        : m_program(program), m_backend(backend), m_options(options), m_stats(stats) {}
+
+    bool Run() {
+        m_registers.resize(m_program.registerCount);
+        m_constants.reserve(m_program.constants.size());
+        for (const Constant& constant : m_program.constants) {
+            if (const int64_t* number = std::get_if<int64_t>(&constant)) m_constants.emplace_back(*number);
+            else m_constants.emplace_back(std::get<std::wstring>(constant));
+        }
+        m_batchSize = m_options.writeBatchSize ? m_options.writeBatchSize : 1;
+
+        bool ok = Execute();
+        // Writes queued before a failure still go out; the first error is kept
+        if (!Flush()) ok = false;
+        return ok;
+    }
+
+    const std::wstring& Error() const { return m_error; }
+
+private:
+    struct PendingWrite {
+        KeyRef key;
+        RegValue value;
+        bool remove;
+    };
+
+    bool Execute() {
+        const Instruction* code = m_program.code.data();
+        Value* r = m_registers.data();
+        uint32_t pc = 0;
+        uint64_t executed = 0;
+
+        while (true) {
+            const Instruction& in = code[pc];
+            m_pc = pc++;
+            if ((++executed & STOP_CHECK_MASK) == 0 && m_options.stopToken.stop_requested()) {
+                m_stats.instructions += executed;
+                m_stats.cancelled = true;
+                return Fail(L"cancelled");
+            }
+
+            switch (in.op) {
+                case Op::LoadConst:
+                    r[in.a] = m_constants[in.x];
+                    break;
+                case Op::LoadNull:
+                    r[in.a] = std::monostate{};
+                    break;
+                case Op::Move:
+                    r[in.a] = r[in.b];
+                    break;
+                case Op::Add:
+                case Op::Sub:
+                case Op::Mul:
+                case Op::Div:
+                case Op::Mod: {
+                    const int64_t* left = std::get_if<int64_t>(&r[in.b]);
+                    const int64_t* right = std::get_if<int64_t>(&r[in.c]);
+                    if (left && right) {
+                        int64_t result = 0;
+                        if (!Arithmetic(in.op, *left, *right, result)) return Stop(executed);
+                        r[in.a] = result;
+                    } else if (in.op == Op::Add && (std::holds_alternative<std::wstring>(r[in.b]) ||
+                                                    std::holds_alternative<std::wstring>(r[in.c]))) {
+                        r[in.a] = ToString(r[in.b]) + ToString(r[in.c]);
+                    } else {
+                        Fail(std::wstring(L"cannot do arithmetic on ") + TypeName(r[in.b]) + L" and " + TypeName(r[in.c]));
+                        return Stop(executed);
+                    }
+                    break;
+                }
+                case Op::Equal:
+                    r[in.a] = int64_t{ Equal(r[in.b], r[in.c]) };
+                    break;
+                case Op::NotEqual:
+                    r[in.a] = int64_t{ !Equal(r[in.b], r[in.c]) };
+                    break;
+                case Op::Less:
+                case Op::LessEqual:
+                case Op::Greater:
+                case Op::GreaterEqual: {
+                    int order = 0;
+                    if (!Order(r[in.b], r[in.c], order)) return Stop(executed);
+                    bool result = in.op == Op::Less ? order < 0
+                                : in.op == Op::LessEqual ? order <= 0
+                                : in.op == Op::Greater ? order > 0 : order >= 0;
+                    r[in.a] = int64_t{ result };
+                    break;
+                }
+                case Op::Not:
+                    r[in.a] = int64_t{ !Truthy(r[in.b]) };
+                    break;
+                case Op::Negate:
+                    if (const int64_t* number = std::get_if<int64_t>(&r[in.b])) {
+                        r[in.a] = static_cast<int64_t>(0 - static_cast<uint64_t>(*number));
+                    } else {
+                        Fail(std::wstring(L"cannot negate ") + TypeName(r[in.b]));
+                        return Stop(executed);
+                    }
+                    break;
+                case Op::Jump:
+                    pc = in.x;
+                    break;
+                case Op::JumpIfFalse:
+                    if (!Truthy(r[in.a])) pc = in.x;
+                    break;
+                case Op::JumpIfTrue:
+                    if (Truthy(r[in.a])) pc = in.x;
+                    break;
+                case Op::GetField: {
+                    Value result;
+                    if (!GetField(r[in.b], static_cast<Field>(in.x), result)) return Stop(executed);
+                    r[in.a] = std::move(result);
+                    break;
+                }
+                case Op::Call: {
+                    Value result;
+                    if (!Call(static_cast<Builtin>(in.x), r + in.b, in.c, result)) return Stop(executed);
+                    r[in.a] = std::move(result);
+                    break;
+                }
+                case Op::KeyIterBegin: {
+                    auto iterator = std::make_shared<KeyIterator>();
+                    iterator->recursive = in.c != 0;
+                    KeyRef key;
+                    if (!KeyArgument(r[in.b], key)) return Stop(executed);
+                    if (key) iterator->stack.emplace_back().key = key;    // Missing keys loop zero times
+                    r[in.a] = std::move(iterator);
+                    break;
+                }
+                case Op::KeyIterNext:
+                    if (!NextKey(*std::get<std::shared_ptr<KeyIterator>>(r[in.a]), r[in.b])) pc = in.x;
+                    break;
+                case Op::ValueIterBegin: {
+                    auto iterator = std::make_shared<ValueIterator>();
+                    iterator->values = std::make_shared<std::vector<RegValue>>();
+                    KeyRef key;
+                    if (!KeyArgument(r[in.b], key)) return Stop(executed);
+                    if (key) {
+                        if (!FlushFor(*key)) return Stop(executed);
+                        key->key->GetValues(*iterator->values);
+                    }
+                    r[in.a] = std::move(iterator);
+                    break;
+                }
+                case Op::ValueIterNext: {
+                    ValueIterator& iterator = *std::get<std::shared_ptr<ValueIterator>>(r[in.a]);
+                    if (iterator.next == iterator.values->size()) {
+                        pc = in.x;
+                        break;
+                    }
+                    // Shares ownership of the buffer instead of copying the value
+                    r[in.b] = ValueRef(iterator.values, &(*iterator.values)[iterator.next++]);
+                    m_stats.values++;
+                    break;
+                }
+                case Op::Return:
+                    m_stats.instructions += executed;
+                    return true;
+            }
+        }
+    }
+
+    bool Stop(uint64_t executed) {
+        m_stats.instructions += executed;
+        return false;
+    }
+
+    bool Fail(std::wstring message) {
+        if (m_error.empty()) {
+            uint32_t line = m_pc < m_program.lines.size() ? m_program.lines[m_pc] : 0;
+            m_error = L"line " + std::to_wstring(line) + L": " + message;
+        }
+        return false;
+    }
+
+    bool Arithmetic(Op op, int64_t left, int64_t right, int64_t& result) {
+        // Unsigned arithmetic wraps instead of overflowing
+        uint64_t a = static_cast<uint64_t>(left), b = static_cast<uint64_t>(right);
+        switch (op) {
+            case Op::Add: result = static_cast<int64_t>(a + b); return true;
+            case Op::Sub: result = static_cast<int64_t>(a - b); return true;
+            case Op::Mul: result = static_cast<int64_t>(a * b); return true;
+            default: break;
+        }
+        if (right == 0) return Fail(L"division by zero");
+        if (right == -1) {
+            result = op == Op::Div ? static_cast<int64_t>(0 - a) : 0;
+            return true;
+        }
+        result = op == Op::Div ? left / right : left % right;
+        return true;
+    }
+
+    static bool Equal(const Value& left, const Value& right) {
+        if (left.index() != right.index()) return false;
+        switch (left.index()) {
+            case 0: return true;
+            case 1: return std::get<int64_t>(left) == std::get<int64_t>(right);
+            case 2: return NamesEqual(std::get<std::wstring>(left), std::get<std::wstring>(right));
+            case 3: return NamesEqual(std::get<KeyRef>(left)->path, std::get<KeyRef>(right)->path);
+            case 4: return std::get<ValueRef>(left) == std::get<ValueRef>(right);
+            default: return false;
+        }
+    }
+
+    bool Order(const Value& left, const Value& right, int& order) {
+        const int64_t* a = std::get_if<int64_t>(&left);
+        const int64_t* b = std::get_if<int64_t>(&right);
+        if (a && b) {
+            order = *a < *b ? -1 : *a > *b ? 1 : 0;
+            return true;
+        }
+        const std::wstring* s = std::get_if<std::wstring>(&left);
+        const std::wstring* t = std::get_if<std::wstring>(&right);
+        if (s && t) {
+            order = CompareNames(*s, *t);
+            return true;
+        }
+        return Fail(std::wstring(L"cannot compare ") + TypeName(left) + L" and " + TypeName(right));
+    }
+
+    bool NextKey(KeyIterator& iterator, Value& result) {
+        while (!iterator.stack.empty()) {
+            KeyIterator::Frame& frame = iterator.stack.back();
+            if (!frame.loaded) {
+                frame.key->key->GetSubKeyNames(frame.names);
+                frame.loaded = true;
+            }
+            if (frame.next == frame.names.size()) {
+                iterator.stack.pop_back();
+                continue;
+            }
+
+            std::wstring& name = frame.names[frame.next++];
+            KeyPtr child = frame.key->key->OpenSubKey(name);
+            if (!child) continue;       // Deleted since the names were read
+            auto key = std::make_shared<KeyObject>();
+            key->key = std::move(child);
+            key->path = ChildPath(frame.key->path, name);
+            key->name = std::move(name);
+            if (iterator.recursive) iterator.stack.emplace_back().key = key;      // frame is invalid from here
+            result = std::move(key);
+            m_stats.keys++;
+            return true;
+        }
+        return false;
+    }
+
+    // A key object, or a path opened from the root; key is null if it does not exist
+    bool KeyArgument(const Value& value, KeyRef& key) {
+        if (const KeyRef* object = std::get_if<KeyRef>(&value)) {
+            key = *object;
+            return true;
+        }
+        if (std::holds_alternative<std::monostate>(value)) {
+            key = nullptr;
+            return true;
+        }
+        const std::wstring* path = std::get_if<std::wstring>(&value);
+        if (!path) return Fail(std::wstring(L"expected a key or path, got ") + TypeName(value));
+        return OpenPath(*path, key);
+    }
+
+    bool OpenPath(const std::wstring& path, KeyRef& key) {
+        key = nullptr;
+        KeyPtr handle = m_backend.OpenKey(path);
+        if (!handle) return true;
+        key = std::make_shared<KeyObject>();
+        key->key = std::move(handle);
+        for (std::wstring_view part : SplitPath(path)) {
+            if (!key->path.empty()) key->path += L'\\';
+            key->path += part;
+            key->name = part;
+        }
+        return true;
+    }
+
+    // A key that must exist, for writes
+    bool TargetKey(const Value& value, KeyRef& key) {
+        if (!KeyArgument(value, key)) return false;
+        if (!key) return Fail(L"key not found: " + ToString(value));
+        return true;
+    }
+
+    bool StringArgument(const Value& value, const std::wstring*& text) {
+        text = std::get_if<std::wstring>(&value);
+        if (!text) return Fail(std::wstring(L"expected a string, got ") + TypeName(value));
+        return true;
+    }
+
+    bool IntegerArgument(const Value& value, int64_t& number) {
+        if (const int64_t* integer = std::get_if<int64_t>(&value)) {
+            number = *integer;
+            return true;
+        }
+        return Fail(std::wstring(L"expected an integer, got ") + TypeName(value));
+    }
+
+    bool GetField(const Value& object, Field field, Value& result) {
+        const wchar_t* fieldName = FIELD_NAMES[static_cast<size_t>(field)];
+        if (const KeyRef* keyRef = std::get_if<KeyRef>(&object)) {
+            KeyObject& key = **keyRef;
+            switch (field) {
+                case Field::Name: result = key.name; return true;
+                case Field::Path: result = key.path; return true;
+                case Field::SubKeys:
+                case Field::Values:
+                case Field::LastWrite: {
+                    if (!FlushFor(key)) return false;
+                    KeyInfo info;
+                    if (!key.key->QueryInfo(info)) return Fail(L"cannot query key: " + key.path);
+                    result = static_cast<int64_t>(field == Field::SubKeys ? info.subKeyCount
+                                                : field == Field::Values ? info.valueCount : info.lastWriteTime);
+                    return true;
+                }
+                default: break;
+            }
+        } else if (const ValueRef* valueRef = std::get_if<ValueRef>(&object)) {
+            const RegValue& value = **valueRef;
+            switch (field) {
+                case Field::Name: result = value.name; return true;
+                case Field::Type: result = int64_t{ value.type }; return true;
+                case Field::Data: result = DataOf(value); return true;
+                case Field::Size: result = static_cast<int64_t>(value.data.size()); return true;
+                default: break;
+            }
+        }
+        return Fail(std::wstring(L"no field '") + fieldName + L"' on " + TypeName(object));
+    }
+
+    // Writes
+
+    bool Queue(const KeyRef& key, RegValue value, bool remove) {
+        if (m_backend.IsReadOnly()) return Fail(L"the registry is open read-only");
+        if (!key->hasFolded) {
+            key->folded = FoldName(key->path);
+            key->hasFolded = true;
+        }
+        if (m_pending.empty() || m_pending.back().key != key) m_pendingKeys.insert(key->folded);
+        m_pending.push_back({ key, std::move(value), remove });
+        m_stats.writes++;
+        return m_pending.size() < m_batchSize || Flush();
+    }
+
+    bool FlushFor(KeyObject& key) {
+        if (m_pending.empty()) return true;
+        if (!key.hasFolded) {
+            key.folded = FoldName(key.path);
+            key.hasFolded = true;
+        }
+        return !m_pendingKeys.contains(key.folded) || Flush();
+    }
+
+    bool Flush() {
+        if (m_pending.empty()) return true;
+        bool ok = true;
+        for (PendingWrite& write : m_pending) {
+            RegistryKey& key = *write.key->key;
+            if (write.remove) {
+                // Deleting a value that is already gone is not an error
+                RegValue existing;
+                if (!key.DeleteValue(write.value.name) && key.GetValue(write.value.name, existing)) {
+                    ok = Fail(L"cannot delete value '" + write.value.name + L"' in " + write.key->path);
+                }
+            } else if (!key.SetValue(write.value)) {
+                ok = Fail(L"cannot set value '" + write.value.name + L"' in " + write.key->path);
+            }
+        }
+        m_pending.clear();
+        m_pendingKeys.clear();
+        m_stats.flushes++;
+        return ok;
+    }
+
+    bool SetTyped(const Value* args, uint32_t type, std::vector<uint8_t> data) {
+        KeyRef key;
+        const std::wstring* name;
+        if (!TargetKey(args[0], key) || !StringArgument(args[1], name)) return false;
+        return Queue(key, { *name, type, std::move(data) }, false);
+    }
+
+    // Builtins
+
+    bool Call(Builtin builtin, const Value* args, uint8_t count, Value& result) {
+        result = int64_t{ 1 };
+        switch (builtin) {
+            case Builtin::Print: {
+                std::wstring line;
+                for (uint8_t i = 0; i < count; i++) {
+                    if (i) line += L' ';
+                    line += ToString(args[i]);
+                }
+                if (m_options.output) m_options.output(line);
+                result = std::monostate{};
+                return true;
+            }
+            case Builtin::Open: {
+                KeyRef key;
+                if (!KeyArgument(args[0], key)) return false;
+                if (key) result = std::move(key);
+                else result = std::monostate{};
+                return true;
+            }
+            case Builtin::Exists: {
+                KeyRef key;
+                if (!KeyArgument(args[0], key)) return false;
+                result = int64_t{ key != nullptr };
+                return true;
+            }
+            case Builtin::GetValue: {
+                KeyRef key;
+                const std::wstring* name;
+                if (!KeyArgument(args[0], key) || !StringArgument(args[1], name)) return false;
+                result = std::monostate{};
+                if (!key) return true;
+                if (!FlushFor(*key)) return false;
+                auto value = std::make_shared<RegValue>();
+                if (key->key->GetValue(*name, *value)) result = ValueRef(std::move(value));
+                return true;
+            }
+            case Builtin::SetString:
+            case Builtin::SetExpandString: {
+                const std::wstring* text;
+                if (!StringArgument(args[2], text)) return false;
+                return SetTyped(args, builtin == Builtin::SetString ? VALUE_SZ : VALUE_EXPAND_SZ, EncodeString(*text));
+            }
+            case Builtin::SetDword:
+            case Builtin::SetQword: {
+                int64_t number = 0;
+                if (!IntegerArgument(args[2], number)) return false;
+                size_t size = builtin == Builtin::SetDword ? 4 : 8;
+                std::vector<uint8_t> data(size);
+                for (size_t i = 0; i < size; i++) data[i] = static_cast<uint8_t>(static_cast<uint64_t>(number) >> (i * 8));
+                return SetTyped(args, builtin == Builtin::SetDword ? VALUE_DWORD : VALUE_QWORD, std::move(data));
+            }
+            case Builtin::SetValue: {
+                KeyRef key;
+                if (!TargetKey(args[0], key)) return false;
+                const ValueRef* source = std::get_if<ValueRef>(&args[1]);
+                if (!source) return Fail(std::wstring(L"expected a value, got ") + TypeName(args[1]));
+                RegValue value = **source;
+                if (count == 3) {
+                    const std::wstring* name;
+                    if (!StringArgument(args[2], name)) return false;
+                    value.name = *name;
+                }
+                return Queue(key, std::move(value), false);
+            }
+            case Builtin::DeleteValue: {
+                KeyRef key;
+                const std::wstring* name;
+                if (!TargetKey(args[0], key) || !StringArgument(args[1], name)) return false;
+                return Queue(key, { *name, VALUE_NONE, {} }, true);
+            }
+            case Builtin::CreateKey: {
+                KeyRef parent;
+                const std::wstring* path;
+                if (!TargetKey(args[0], parent) || !StringArgument(args[1], path) || !Flush()) return false;
+                if (m_backend.IsReadOnly()) return Fail(L"the registry is open read-only");
+                KeyPtr handle = parent->key->CreateSubKey(*path);
+                if (!handle) return Fail(L"cannot create key " + ChildPath(parent->path, *path));
+                auto key = std::make_shared<KeyObject>();
+                key->key = std::move(handle);
+                key->path = parent->path;
+                for (std::wstring_view part : SplitPath(*path)) {
+                    if (!key->path.empty()) key->path += L'\\';
+                    key->path += part;
+                    key->name = part;
+                }
+                result = std::move(key);
+                return true;
+            }
+            case Builtin::DeleteKey: {
+                KeyRef parent;
+                const std::wstring* name;
+                if (!TargetKey(args[0], parent) || !StringArgument(args[1], name) || !Flush()) return false;
+                if (m_backend.IsReadOnly()) return Fail(L"the registry is open read-only");
+                if (!parent->key->OpenSubKey(*name)) {
+                    result = int64_t{ 0 };
+                    return true;
+                }
+                SubtreeOptions options;
+                options.stopToken = m_options.stopToken;
+                SubtreeStats deleted = DeleteSubtree(*parent->key, *name, options);
+                if (deleted.errors || deleted.cancelled) return Fail(L"cannot delete key " + ChildPath(parent->path, *name));
+                return true;
+            }
+            case Builtin::Contains:
+            case Builtin::StartsWith:
+            case Builtin::EndsWith: {
+                const std::wstring *text, *part;
+                if (!StringArgument(args[0], text) || !StringArgument(args[1], part)) return false;
+                std::wstring a = Folded(*text), b = Folded(*part);
+                bool found = builtin == Builtin::Contains ? a.find(b) != std::wstring::npos
+                           : builtin == Builtin::StartsWith ? a.starts_with(b) : a.ends_with(b);
+                result = int64_t{ found };
+                return true;
+            }
+            case Builtin::Replace: {
+                const std::wstring *text, *from, *to;
+                if (!StringArgument(args[0], text) || !StringArgument(args[1], from) || !StringArgument(args[2], to)) return false;
+                if (from->empty()) {
+                    result = *text;
+                    return true;
+                }
+                // Folding maps one character to one, so positions carry over
+                std::wstring folded = Folded(*text), pattern = Folded(*from), replaced;
+                size_t start = 0, found;
+                while ((found = folded.find(pattern, start)) != std::wstring::npos) {
+                    replaced.append(*text, start, found - start);
+                    replaced += *to;
+                    start = found + pattern.size();
+                }
+                replaced.append(*text, start);
+                result = std::move(replaced);
+                return true;
+            }
+            case Builtin::Lower:
+            case Builtin::Upper: {
+                const std::wstring* text;
+                if (!StringArgument(args[0], text)) return false;
+                std::wstring converted(*text);
+                for (wchar_t& c : converted) {
+                    c = builtin == Builtin::Upper ? FoldChar(c) : static_cast<wchar_t>(std::towlower(c));
+                }
+                result = std::move(converted);
+                return true;
+            }
+            case Builtin::Length:
+                if (const std::wstring* text = std::get_if<std::wstring>(&args[0])) {
+                    result = static_cast<int64_t>(text->size());
+                } else if (const ValueRef* value = std::get_if<ValueRef>(&args[0])) {
+                    result = static_cast<int64_t>((*value)->data.size());
+                } else {
+                    return Fail(std::wstring(L"no length for ") + TypeName(args[0]));
+                }
+                return true;
+            case Builtin::Str:
+                result = ToString(args[0]);
+                return true;
+            case Builtin::Int: {
+                Value source = args[0];
+                if (const ValueRef* value = std::get_if<ValueRef>(&source)) source = DataOf(**value);
+                int64_t number = 0;
+                if (std::holds_alternative<int64_t>(source)) result = std::move(source);
+                else if (const std::wstring* text = std::get_if<std::wstring>(&source); text && ParseInteger(*text, number)) result = number;
+                else result = std::monostate{};
+                return true;
+            }
+        }
+        return Fail(L"unknown builtin");
+    }
+
+    const Program& m_program;
+    RegistryBackend& m_backend;
+    const ScriptOptions& m_options;
+    ScriptStats& m_stats;
+
+    std::vector<Value> m_registers;
+    std::vector<Value> m_constants;
+    uint32_t m_pc = 0;
+    std::wstring m_error;
+
+    std::vector<PendingWrite> m_pending;
+    std::unordered_set<std::wstring> m_pendingKeys;     // Folded paths of keys in m_pending
+    size_t m_batchSize = 1;
+};
+
+} // namespace
+
+bool Script::Compile(std::wstring_view source) {
+    m_error.clear();
+    m_compiled = script::Compile(source, m_program, m_error);
+    return m_compiled;
+}
+
+bool Script::Run(RegistryBackend& backend, ScriptStats& stats, const ScriptOptions& options) {
+    stats = {};
+    if (!m_compiled) {
+        m_error = L"no compiled script";
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    Machine machine(m_program, backend, options, stats);
+    bool ok = machine.Run();
+    m_error = ok ? std::wstring() : machine.Error();
+    stats.seconds = SecondsSince(start);
+    return ok;
+}
+
+} // namespace core
@@ -0,0 +1,72 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Batch scripting engine. Scripts are compiled to register bytecode (see
+ * ScriptBytecode.h) and run by a small VM against any backend, so they work
+ * headless on the in-memory and hive backends as well as the live registry.
+ *
+ *   for key k in open('Software\\Vendor') recursive {
+ *       let v = getvalue(k, "Retries")
+ *       if v != null and v.type == REG_DWORD and v.data > 100 {
+ *           setdword(k, "Retries", 100)
+ *       }
+ *   }
+ *
+ * Loops hold their key handles and enumeration buffers until they end.
+ * Writes are queued and applied in batches: when the queue is full, at the
+ * end of the script, and before anything reads a key with queued writes or
+ * changes the key structure, so a script always sees its own writes.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+#include "ScriptBytecode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+struct ScriptOptions {
+    std::function<void(std::wstring_view)> output;     // Receives print() lines; unset = discard
+    size_t writeBatchSize = 4096;                       // Queued writes before a flush
+    std::stop_token stopToken;
+};
+
+struct ScriptStats {
+    uint64_t instructions = 0;
+    uint64_t keys = 0;                  // Keys visited by key loops
+    uint64_t values = 0;                // Values visited by value loops
+    uint64_t writes = 0;                // Values set or deleted
+    uint64_t flushes = 0;
+    double seconds = 0;
+    bool cancelled = false;
+};
+
+class Script {
+public:
+    // Compile source text; on failure Error() is "line N: message"
+    bool Compile(std::wstring_view source);
+
+    // Run the compiled program. Writes queued before a runtime error are
+    // still applied, as they would have been by a sequence of commands.
+    bool Run(RegistryBackend& backend, ScriptStats& stats, const ScriptOptions& options = {});
+
+    bool IsCompiled() const { return m_compiled; }
+    const script::Program& GetProgram() const { return m_program; }
+    std::wstring Disassemble() const { return script::Disassemble(m_program); }
+    const std::wstring& Error() const { return m_error; }
+
+private:
+    script::Program m_program;
+    bool m_compiled = false;
+    std::wstring m_error;
+};
+
+} // namespace core
@@ -0,0 +1,110 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Bytecode shared by the script compiler and VM. Instructions are 8 bytes:
+ * an opcode, three register operands and a 32-bit operand (constant index,
+ * jump target, field or builtin number). Registers hold locals first, then
+ * temporaries, and are allocated by the compiler.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace core::script {
+
+enum class Op : uint8_t {
+    LoadConst,      // a = constants[x]
+    LoadNull,       // a = null
+    Move,           // a = b
+    Add,            // a = b + c (integers, or concatenation if either is a string)
+    Sub,            // a = b - c
+    Mul,            // a = b * c
+    Div,            // a = b / c
+    Mod,            // a = b % c
+    Equal,          // a = b == c (strings compare like registry names, ignoring case)
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Not,            // a = !b
+    Negate,         // a = -b
+    Jump,           // goto x
+    JumpIfFalse,    // if !a goto x
+    JumpIfTrue,     // if a goto x
+    GetField,       // a = b.field[x]
+    Call,           // a = builtin[x](b .. b + c - 1)
+    KeyIterBegin,   // a = iterator over subkeys of key or path b; c = 1 for recursive
+    KeyIterNext,    // b = next key of iterator a, or goto x when done
+    ValueIterBegin, // a = iterator over the values of key or path b
+    ValueIterNext,  // b = next value of iterator a, or goto x when done
+    Return
+};
+
+enum class Field : uint32_t {
+    Name,           // Key or value name
+    Path,           // Key path
+    Type,           // Value type
+    Data,           // Value data as string or integer
+    Size,           // Value data size in bytes
+    SubKeys,        // Subkey count
+    Values,         // Value count
+    LastWrite       // Key last-write time (FILETIME)
+};
+
+enum class Builtin : uint32_t {
+    Print,
+    Open,
+    Exists,
+    GetValue,
+    SetString,
+    SetExpandString,
+    SetDword,
+    SetQword,
+    SetValue,       // Copy a value object, optionally under a new name
+    DeleteValue,
+    CreateKey,
+    DeleteKey,
+    Contains,
+    StartsWith,
+    EndsWith,
+    Replace,
+    Lower,
+    Upper,
+    Length,
+    Str,
+    Int
+};
+
+struct Instruction {
+    Op op;
+    uint8_t a = 0;
+    uint8_t b = 0;
+    uint8_t c = 0;
+    uint32_t x = 0;
+};
+
+using Constant = std::variant<int64_t, std::wstring>;
+
+struct Program {
+    std::vector<Instruction> code;
+    std::vector<uint32_t> lines;        // Source line of each instruction
+    std::vector<Constant> constants;
+    uint32_t registerCount = 0;
+};
+
+constexpr uint32_t MAX_REGISTERS = 256;
+
+// Compile source text. On failure error holds "line N: message".
+bool Compile(std::wstring_view source, Program& program, std::wstring& error);
+
+// Human-readable listing, one instruction per line
+std::wstring Disassemble(const Program& program);
+
+} // namespace core::script
@@ -0,0 +1,833 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Script compiler: lexer, recursive-descent parser and register
+ * allocation. Statements are emitted as they are parsed; expressions are
+ * parsed into a small tree first so operands can use locals in place.
+ *
+ *   let x = expr              x = expr
+ *   if expr { ... } else if expr { ... } else { ... }
+ *   while expr { ... }
+ *   for key k in expr [recursive] { ... }
+ *   for value v in expr { ... }
+ *   break   continue   builtin(args)
+ *
+ * Strings are "..." with \\ \" \n \t escapes, or '...' taken literally
+ * (handy for paths). # starts a comment.
+ */
+
+#include "RegistryTypes.h"
+#include "ScriptBytecode.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cwctype>
+#include <memory>
+
+namespace core::script {
+
+namespace {
+
+struct FieldEntry {
+    const wchar_t* name;
+    Field field;
+};
+
+constexpr FieldEntry FIELDS[] = {
+    { L"name", Field::Name },
+    { L"path", Field::Path },
+    { L"type", Field::Type },
+    { L"data", Field::Data },
+    { L"size", Field::Size },
+    { L"subkeys", Field::SubKeys },
+    { L"values", Field::Values },
+    { L"lastwrite", Field::LastWrite },
+};
+
+struct BuiltinEntry {
+    const wchar_t* name;
+    Builtin builtin;
+    uint8_t minArgs;
+    uint8_t maxArgs;
+};
+
+constexpr BuiltinEntry BUILTINS[] = {
+    { L"print", Builtin::Print, 0, 32 },
+    { L"open", Builtin::Open, 1, 1 },
+    { L"exists", Builtin::Exists, 1, 1 },
+    { L"getvalue", Builtin::GetValue, 2, 2 },
+    { L"setstring", Builtin::SetString, 3, 3 },
+    { L"setexpandstring", Builtin::SetExpandString, 3, 3 },
+    { L"setdword", Builtin::SetDword, 3, 3 },
+    { L"setqword", Builtin::SetQword, 3, 3 },
+    { L"setvalue", Builtin::SetValue, 2, 3 },
+    { L"deletevalue", Builtin::DeleteValue, 2, 2 },
+    { L"createkey", Builtin::CreateKey, 2, 2 },
+    { L"deletekey", Builtin::DeleteKey, 2, 2 },
+    { L"contains", Builtin::Contains, 2, 2 },
+    { L"startswith", Builtin::StartsWith, 2, 2 },
+    { L"endswith", Builtin::EndsWith, 2, 2 },
+    { L"replace", Builtin::Replace, 3, 3 },
+    { L"lower", Builtin::Lower, 1, 1 },
+    { L"upper", Builtin::Upper, 1, 1 },
+    { L"len", Builtin::Length, 1, 1 },
+    { L"str", Builtin::Str, 1, 1 },
+    { L"int", Builtin::Int, 1, 1 },
+};
+
+struct NamedConstant {
+    const wchar_t* name;
+    int64_t value;
+};
+
+constexpr NamedConstant CONSTANTS[] = {
+    { L"REG_NONE", VALUE_NONE },
+    { L"REG_SZ", VALUE_SZ },
+    { L"REG_EXPAND_SZ", VALUE_EXPAND_SZ },
+    { L"REG_BINARY", VALUE_BINARY },
+    { L"REG_DWORD", VALUE_DWORD },
+    { L"REG_DWORD_BIG_ENDIAN", VALUE_DWORD_BIG_ENDIAN },
+    { L"REG_LINK", VALUE_LINK },
+    { L"REG_MULTI_SZ", VALUE_MULTI_SZ },
+    { L"REG_QWORD", VALUE_QWORD },
+    { L"true", 1 },
+    { L"false", 0 },
+};
+
+const wchar_t* const OP_NAMES[] = {
+    L"LOADK", L"LOADNULL", L"MOVE", L"ADD", L"SUB", L"MUL", L"DIV", L"MOD",
+    L"EQ", L"NE", L"LT", L"LE", L"GT", L"GE", L"NOT", L"NEG",
+    L"JMP", L"JMPF", L"JMPT", L"GETFIELD", L"CALL",
+    L"KITER", L"KNEXT", L"VITER", L"VNEXT", L"RET"
+};
+
+enum class TokenKind {
+    End,
+    Identifier,
+    Integer,
+    String,
+    Symbol
+};
+
+struct Token {
+    TokenKind kind = TokenKind::End;
+    std::wstring text;                  // Identifier, string contents or symbol
+    int64_t number = 0;
+    uint32_t line = 1;
+};
+
+bool Tokenize(std::wstring_view source, std::vector<Token>& tokens, std::wstring& error) {
+    uint32_t line = 1;
+    size_t i = 0;
+    auto fail = [&](const wchar_t* message) {
+        error = L"line " + std::to_wstring(line) + L": " + message;
+        return false;
+    };
+
+    while (i < source.size()) {
+        wchar_t c = source[i];
+        if (c == L'\n') {
+            line++;
+            i++;
+            continue;
+        }
+        if (c == L' ' || c == L'\t' || c == L'\r' || c == L';') {
+            i++;
+            continue;
+        }
+        if (c == L'#') {
+            while (i < source.size() && source[i] != L'\n') i++;
+            continue;
+        }
+
+        Token token;
+        token.line = line;
+        if (std::iswalpha(c) || c == L'_') {
+            size_t start = i;
+            while (i < source.size() && (std::iswalnum(source[i]) || source[i] == L'_')) i++;
+            token.kind = TokenKind::Identifier;
+            token.text = source.substr(start, i - start);
+        } else if (c >= L'0' && c <= L'9') {
+            int base = 10;
+            if (c == L'0' && i + 1 < source.size() && (source[i + 1] == L'x' || source[i + 1] == L'X')) {
+                base = 16;
+                i += 2;
+            }
+            uint64_t value = 0;
+            size_t digits = 0;
+            while (i < source.size()) {
+                wchar_t d = source[i];
+                int digit = (d >= L'0' && d <= L'9') ? d - L'0'
+                          : (base == 16 && d >= L'a' && d <= L'f') ? d - L'a' + 10
+                          : (base == 16 && d >= L'A' && d <= L'F') ? d - L'A' + 10 : -1;
+                if (digit < 0) break;
+                if (value > (UINT64_MAX - digit) / base) return fail(L"number too large");
+                value = value * base + digit;
+                digits++;
+                i++;
+            }
+            if (digits == 0) return fail(L"malformed number");
+            token.kind = TokenKind::Integer;
+            token.number = static_cast<int64_t>(value);     // Hex may fill all 64 bits
+        } else if (c == L'"' || c == L'\'') {
+            token.kind = TokenKind::String;
+            bool raw = c == L'\'';
+            i++;
+            while (true) {
+                if (i >= source.size() || source[i] == L'\n') return fail(L"unterminated string");
+                wchar_t s = source[i++];
+                if (s == c) break;
+                if (s != L'\\' || raw) {
+                    token.text.push_back(s);
+                    continue;
+                }
+                if (i >= source.size()) return fail(L"unterminated string");
+                switch (source[i++]) {
+                    case L'\\': token.text.push_back(L'\\'); break;
+                    case L'"': token.text.push_back(L'"'); break;
+                    case L'n': token.text.push_back(L'\n'); break;
+                    case L't': token.text.push_back(L'\t'); break;
+                    case L'0': token.text.push_back(L'\0'); break;
+                    default: return fail(L"unknown escape");
+                }
+            }
+        } else {
+            static constexpr const wchar_t* SYMBOLS[] = {
+                L"==", L"!=", L"<=", L">=", L"<", L">", L"=", L"+", L"-", L"*", L"/", L"%",
+                L"(", L")", L"{", L"}", L",", L"."
+            };
+            token.kind = TokenKind::Symbol;
+            for (const wchar_t* symbol : SYMBOLS) {
+                if (source.substr(i).starts_with(symbol)) {
+                    token.text = symbol;
+                    break;
+                }
+            }
+            if (token.text.empty()) return fail(L"unexpected character");
+            i += token.text.size();
+        }
+        tokens.push_back(std::move(token));
+    }
+
+    Token end;
+    end.line = line;
+    tokens.push_back(end);
+    return true;
+}
+
+struct Expr {
+    enum class Kind { Integer, String, Null, Variable, Unary, Binary, And, Or, Field, Call };
+
+    Kind kind;
+    uint32_t line = 0;
+    int64_t number = 0;
+    std::wstring text;
+    uint8_t reg = 0;                    // Variable register
+    Op op = Op::Add;                    // Unary and binary operators
+    uint32_t id = 0;                    // Field or builtin
+    std::vector<std::unique_ptr<Expr>> children;
+};
+
+using ExprPtr = std::unique_ptr<Expr>;
+
+class Compiler {
+public:
+    Compiler(std::vector<Token> tokens, Program& program) : m_tokens(std::move(tokens)), m_program(program) {}
+
+    bool Run(std::wstring& error) {
+        m_scopes.emplace_back();
+        while (m_ok && Peek().kind != TokenKind::End) Statement();
+        Emit(Op::Return);
+        m_program.registerCount = m_maxRegister;
+        if (!m_ok) error = m_error;
+        return m_ok;
+    }
+
+private:
+    struct Local {
+        std::wstring name;
+        uint8_t reg = 0;
+    };
+
+    struct Scope {
+        std::vector<Local> locals;
+        uint32_t firstRegister = 0;
+    };
+
+    struct Loop {
+        uint32_t continueTarget;
+        std::vector<size_t> breaks;
+    };
+
+    // Tokens
+
+    const Token& Peek(size_t ahead = 0) const {
+        size_t index = m_pos + ahead;
+        return m_tokens[index < m_tokens.size() ? index : m_tokens.size() - 1];
+    }
+
+    const Token& Next() {
+        const Token& token = Peek();
+        if (m_pos < m_tokens.size() - 1) m_pos++;
+        return token;
+    }
+
+    bool IsSymbol(const wchar_t* symbol, size_t ahead = 0) const {
+        return Peek(ahead).kind == TokenKind::Symbol && Peek(ahead).text == symbol;
+    }
+
+    bool IsWord(const wchar_t* word, size_t ahead = 0) const {
+        return Peek(ahead).kind == TokenKind::Identifier && Peek(ahead).text == word;
+    }
+
+    bool Accept(const wchar_t* symbol) {
+        if (!IsSymbol(symbol)) return false;
+        Next();
+        return true;
+    }
+
+    bool Expect(const wchar_t* symbol) {
+        if (Accept(symbol)) return true;
+        return Fail(std::wstring(L"expected '") + symbol + L"'");
+    }
+
+    bool Fail(const std::wstring& message) {
+        if (m_ok) m_error = L"line " + std::to_wstring(Peek().line) + L": " + message;
+        m_ok = false;
+        return false;
+    }
+
+    // Emission
+
+    size_t Emit(Op op, uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint32_t x = 0) {
+        m_program.code.push_back({ op, a, b, c, x });
+        m_program.lines.push_back(m_line);
+        return m_program.code.size() - 1;
+    }
+
+    uint32_t Here() const { return static_cast<uint32_t>(m_program.code.size()); }
+    void Patch(size_t instruction, uint32_t target) { m_program.code[instruction].x = target; }
+
+    uint32_t Constant(const script::Constant& value) {
+        for (size_t i = 0; i < m_program.constants.size(); i++) {
+            if (m_program.constants[i] == value) return static_cast<uint32_t>(i);
+        }
+        m_program.constants.push_back(value);
+        return static_cast<uint32_t>(m_program.constants.size() - 1);
+    }
+
+    // Registers: locals and temporaries share one stack
+
+    bool Allocate(uint8_t& reg) {
+        if (m_nextRegister >= MAX_REGISTERS) return Fail(L"expression or nesting too complex");
+        reg = static_cast<uint8_t>(m_nextRegister++);
+        if (m_nextRegister > m_maxRegister) m_maxRegister = m_nextRegister;
+        return true;
+    }
+
+    void Release(uint8_t reg) {
+        if (reg + 1u == m_nextRegister) m_nextRegister--;
+    }
+
+    void OpenScope() { m_scopes.push_back({ {}, m_nextRegister }); }
+
+    void CloseScope() {
+        m_nextRegister = m_scopes.back().firstRegister;
+        m_scopes.pop_back();
+    }
+
+    bool Declare(const std::wstring& name, uint8_t& reg) {
+        if (!Allocate(reg)) return false;
+        m_scopes.back().locals.push_back({ name, reg });
+        return true;
+    }
+
+    const Local* Lookup(std::wstring_view name) const {
+        for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope) {
+            for (auto local = scope->locals.rbegin(); local != scope->locals.rend(); ++local) {
+                if (local->name == name) return &*local;
+            }
+        }
+        return nullptr;
+    }
+
+    // Statements
+
+    void Statement() {
+        m_line = Peek().line;
+        if (IsWord(L"let")) return Let();
+        if (IsWord(L"if")) return If();
+        if (IsWord(L"while")) return While();
+        if (IsWord(L"for")) return For();
+        if (IsWord(L"break") || IsWord(L"continue")) return BreakContinue();
+        if (Peek().kind == TokenKind::Identifier && IsSymbol(L"=", 1)) return Assign();
+        if (Peek().kind == TokenKind::Identifier && IsSymbol(L"(", 1)) {
+            ExprPtr call = Expression();
+            if (!call) return;
+            uint8_t reg = 0;
+            if (!Allocate(reg)) return;
+            CompileExpr(*call, reg);
+            Release(reg);
+            return;
+        }
+        Fail(L"expected a statement");
+    }
+
+    void Block() {
+        if (!Expect(L"{")) return;
+        OpenScope();
+        while (m_ok && !IsSymbol(L"}")) {
+            if (Peek().kind == TokenKind::End) {
+                Fail(L"expected '}'");
+                break;
+            }
+            Statement();
+        }
+        CloseScope();
+        Accept(L"}");
+    }
+
+    bool Identifier(std::wstring& name) {
+        if (Peek().kind != TokenKind::Identifier) return Fail(L"expected a name");
+        name = Next().text;
+        return true;
+    }
+
+    void Let() {
+        Next();
+        std::wstring name;
+        if (!Identifier(name) || !Expect(L"=")) return;
+        ExprPtr value = Expression();
+        if (!value) return;
+        // Compile before declaring, so the expression still sees any outer variable of that name
+        uint8_t reg = 0;
+        if (!Allocate(reg)) return;
+        CompileExpr(*value, reg);
+        m_scopes.back().locals.push_back({ name, reg });
+    }
+
+    void Assign() {
+        std::wstring name = Next().text;
+        Next();
+        const Local* local = Lookup(name);
+        if (!local) {
+            Fail(L"unknown variable '" + name + L"'");
+            return;
+        }
+        uint8_t target = local->reg;
+        ExprPtr value = Expression();
+        if (!value) return;
+
+        // and/or write their target before reading the right side, which may use it
+        if (value->kind == Expr::Kind::And || value->kind == Expr::Kind::Or) {
+            uint8_t temp = 0;
+            if (!Allocate(temp)) return;
+            CompileExpr(*value, temp);
+            Emit(Op::Move, target, temp);
+            Release(temp);
+        } else {
+            CompileExpr(*value, target);
+        }
+    }
+
+    // Condition into a register, then a jump to be patched
+    bool Condition(size_t& jump) {
+        ExprPtr condition = Expression();
+        if (!condition) return false;
+        bool temporary = false;
+        uint8_t reg = 0;
+        if (!Operand(*condition, reg, temporary)) return false;
+        jump = Emit(Op::JumpIfFalse, reg);
+        if (temporary) Release(reg);
+        return true;
+    }
+
+    void If() {
+        Next();
+        size_t skip;
+        if (!Condition(skip)) return;
+        Block();
+        if (!IsWord(L"else")) {
+            Patch(skip, Here());
+            return;
+        }
+        Next();
+        size_t end = Emit(Op::Jump);
+        Patch(skip, Here());
+        if (IsWord(L"if")) {
+            m_line = Peek().line;
+            If();
+        } else {
+            Block();
+        }
+        Patch(end, Here());
+    }
+
+    void While() {
+        Next();
+        uint32_t top = Here();
+        size_t exit;
+        if (!Condition(exit)) return;
+        m_loops.push_back({ top, {} });
+        Block();
+        Emit(Op::Jump, 0, 0, 0, top);
+        Patch(exit, Here());
+        for (size_t jump : m_loops.back().breaks) Patch(jump, Here());
+        m_loops.pop_back();
+    }
+
+    void For() {
+        Next();
+        bool keys = IsWord(L"key");
+        if (!keys && !IsWord(L"value")) {
+            Fail(L"expected 'key' or 'value'");
+            return;
+        }
+        Next();
+        std::wstring name;
+        if (!Identifier(name)) return;
+        if (!IsWord(L"in")) {
+            Fail(L"expected 'in'");
+            return;
+        }
+        Next();
+        ExprPtr source = Expression();
+        if (!source) return;
+        bool recursive = keys && IsWord(L"recursive");
+        if (recursive) Next();
+
+        // The iterator lives in a hidden local for the whole loop
+        OpenScope();
+        uint8_t iterator, reg, variable;
+        bool temporary = false;
+        if (!Declare(L"", iterator) || !Operand(*source, reg, temporary)) return;
+        Emit(keys ? Op::KeyIterBegin : Op::ValueIterBegin, iterator, reg, recursive ? 1 : 0);
+        if (temporary) Release(reg);
+        if (!Declare(name, variable)) return;
+
+        uint32_t top = Here();
+        size_t next = Emit(keys ? Op::KeyIterNext : Op::ValueIterNext, iterator, variable);
+        m_loops.push_back({ top, {} });
+        Block();
+        Emit(Op::Jump, 0, 0, 0, top);
+        Patch(next, Here());
+        for (size_t jump : m_loops.back().breaks) Patch(jump, Here());
+        m_loops.pop_back();
+        Emit(Op::LoadNull, iterator);   // Release the key handles
+        CloseScope();
+    }
+
+    void BreakContinue() {
+        bool isBreak = Next().text == L"break";
+        if (m_loops.empty()) {
+            Fail(L"break or continue outside a loop");
+            return;
+        }
+        if (isBreak) m_loops.back().breaks.push_back(Emit(Op::Jump));
+        else Emit(Op::Jump, 0, 0, 0, m_loops.back().continueTarget);
+    }
+
+    // Expressions
+
+    ExprPtr Make(Expr::Kind kind) {
+        auto expr = std::make_unique<Expr>();
+        expr->kind = kind;
+        expr->line = Peek().line;
+        return expr;
+    }
+
+    ExprPtr Expression() { return OrExpression(); }
+
+    ExprPtr OrExpression() {
+        ExprPtr left = AndExpression();
+        while (left && IsWord(L"or")) {
+            Next();
+            ExprPtr node = Make(Expr::Kind::Or);
+            ExprPtr right = AndExpression();
+            if (!right) return nullptr;
+            node->children.push_back(std::move(left));
+            node->children.push_back(std::move(right));
+            left = std::move(node);
+        }
+        return left;
+    }
+
+    ExprPtr AndExpression() {
+        ExprPtr left = Comparison();
+        while (left && IsWord(L"and")) {
+            Next();
+            ExprPtr node = Make(Expr::Kind::And);
+            ExprPtr right = Comparison();
+            if (!right) return nullptr;
+            node->children.push_back(std::move(left));
+            node->children.push_back(std::move(right));
+            left = std::move(node);
+        }
+        return left;
+    }
+
+    ExprPtr Binary(ExprPtr left, Op op, ExprPtr (Compiler::*operand)()) {
+        ExprPtr node = Make(Expr::Kind::Binary);
+        node->op = op;
+        ExprPtr right = (this->*operand)();
+        if (!right) return nullptr;
+        node->children.push_back(std::move(left));
+        node->children.push_back(std::move(right));
+        return node;
+    }
+
+    ExprPtr Comparison() {
+        ExprPtr left = Additive();
+        static constexpr std::pair<const wchar_t*, Op> OPERATORS[] = {
+            { L"==", Op::Equal }, { L"!=", Op::NotEqual }, { L"<", Op::Less },
+            { L"<=", Op::LessEqual }, { L">", Op::Greater }, { L">=", Op::GreaterEqual }
+        };
+        for (const auto& [symbol, op] : OPERATORS) {
+            if (left && IsSymbol(symbol)) {
+                Next();
+                return Binary(std::move(left), op, &Compiler::Additive);
+            }
+        }
+        return left;
+    }
+
+    ExprPtr Additive() {
+        ExprPtr left = Multiplicative();
+        while (left && (IsSymbol(L"+") || IsSymbol(L"-"))) {
+            Op op = Next().text == L"+" ? Op::Add : Op::Sub;
+            left = Binary(std::move(left), op, &Compiler::Multiplicative);
+        }
+        return left;
+    }
+
+    ExprPtr Multiplicative() {
+        ExprPtr left = Unary();
+        while (left && (IsSymbol(L"*") || IsSymbol(L"/") || IsSymbol(L"%"))) {
+            const std::wstring& symbol = Next().text;
+            Op op = symbol == L"*" ? Op::Mul : symbol == L"/" ? Op::Div : Op::Mod;
+            left = Binary(std::move(left), op, &Compiler::Unary);
+        }
+        return left;
+    }
+
+    ExprPtr Unary() {
+        if (IsWord(L"not") || IsSymbol(L"-")) {
+            ExprPtr node = Make(Expr::Kind::Unary);
+            node->op = Next().text == L"not" ? Op::Not : Op::Negate;
+            ExprPtr operand = Unary();
+            if (!operand) return nullptr;
+            node->children.push_back(std::move(operand));
+            return node;
+        }
+        return Postfix();
+    }
+
+    ExprPtr Postfix() {
+        ExprPtr expr = Primary();
+        while (expr && Accept(L".")) {
+            std::wstring name;
+            if (!Identifier(name)) return nullptr;
+            auto field = std::find_if(std::begin(FIELDS), std::end(FIELDS),
+                                      [&name](const FieldEntry& entry) { return name == entry.name; });
+            if (field == std::end(FIELDS)) {
+                Fail(L"unknown field '" + name + L"'");
+                return nullptr;
+            }
+            ExprPtr node = Make(Expr::Kind::Field);
+            node->id = static_cast<uint32_t>(field->field);
+            node->children.push_back(std::move(expr));
+            expr = std::move(node);
+        }
+        return expr;
+    }
+
+    ExprPtr Primary() {
+        const Token& token = Peek();
+        if (token.kind == TokenKind::Integer) {
+            ExprPtr node = Make(Expr::Kind::Integer);
+            node->number = Next().number;
+            return node;
+        }
+        if (token.kind == TokenKind::String) {
+            ExprPtr node = Make(Expr::Kind::String);
+            node->text = Next().text;
+            return node;
+        }
+        if (Accept(L"(")) {
+            ExprPtr inner = Expression();
+            if (!inner || !Expect(L")")) return nullptr;
+            return inner;
+        }
+        if (token.kind != TokenKind::Identifier) {
+            Fail(L"expected an expression");
+            return nullptr;
+        }
+
+        std::wstring name = Next().text;
+        if (IsSymbol(L"(")) return Call(name);
+        if (name == L"null") return Make(Expr::Kind::Null);
+        if (const Local* local = Lookup(name)) {
+            ExprPtr node = Make(Expr::Kind::Variable);
+            node->reg = local->reg;
+            return node;
+        }
+        for (const NamedConstant& constant : CONSTANTS) {
+            if (name == constant.name) {
+                ExprPtr node = Make(Expr::Kind::Integer);
+                node->number = constant.value;
+                return node;
+            }
+        }
+        Fail(L"unknown variable '" + name + L"'");
+        return nullptr;
+    }
+
+    ExprPtr Call(const std::wstring& name) {
+        auto builtin = std::find_if(std::begin(BUILTINS), std::end(BUILTINS),
+                                    [&name](const BuiltinEntry& entry) { return name == entry.name; });
+        if (builtin == std::end(BUILTINS)) {
+            Fail(L"unknown function '" + name + L"'");
+            return nullptr;
+        }
+        ExprPtr node = Make(Expr::Kind::Call);
+        node->id = static_cast<uint32_t>(builtin->builtin);
+        Expect(L"(");
+        if (!IsSymbol(L")")) {
+            do {
+                ExprPtr argument = Expression();
+                if (!argument) return nullptr;
+                node->children.push_back(std::move(argument));
+            } while (Accept(L","));
+        }
+        if (!Expect(L")")) return nullptr;
+        if (node->children.size() < builtin->minArgs || node->children.size() > builtin->maxArgs) {
+            Fail(L"wrong number of arguments to '" + name + L"'");
+            return nullptr;
+        }
+        return node;
+    }
+
+    // A register holding the expression's value: a local as is, or a new temporary
+    bool Operand(const Expr& expr, uint8_t& reg, bool& temporary) {
+        if (expr.kind == Expr::Kind::Variable) {
+            reg = expr.reg;
+            temporary = false;
+            return true;
+        }
+        temporary = true;
+        if (!Allocate(reg)) return false;
+        CompileExpr(expr, reg);
+        return m_ok;
+    }
+
+    void CompileExpr(const Expr& expr, uint8_t dest) {
+        if (!m_ok) return;
+        uint32_t savedLine = m_line;
+        m_line = expr.line;
+        switch (expr.kind) {
+            case Expr::Kind::Integer:
+                Emit(Op::LoadConst, dest, 0, 0, Constant(expr.number));
+                break;
+            case Expr::Kind::String:
+                Emit(Op::LoadConst, dest, 0, 0, Constant(expr.text));
+                break;
+            case Expr::Kind::Null:
+                Emit(Op::LoadNull, dest);
+                break;
+            case Expr::Kind::Variable:
+                if (expr.reg != dest) Emit(Op::Move, dest, expr.reg);
+                break;
+            case Expr::Kind::Unary: {
+                uint8_t reg = 0;
+                bool temporary = false;
+                if (!Operand(*expr.children[0], reg, temporary)) break;
+                Emit(expr.op, dest, reg);
+                if (temporary) Release(reg);
+                break;
+            }
+            case Expr::Kind::Binary: {
+                uint8_t left, right;
+                bool leftTemporary, rightTemporary;
+                if (!Operand(*expr.children[0], left, leftTemporary)) break;
+                if (!Operand(*expr.children[1], right, rightTemporary)) break;
+                Emit(expr.op, dest, left, right);
+                if (rightTemporary) Release(right);
+                if (leftTemporary) Release(left);
+                break;
+            }
+            case Expr::Kind::And:
+            case Expr::Kind::Or: {
+                CompileExpr(*expr.children[0], dest);
+                size_t jump = Emit(expr.kind == Expr::Kind::And ? Op::JumpIfFalse : Op::JumpIfTrue, dest);
+                CompileExpr(*expr.children[1], dest);
+                Patch(jump, Here());
+                break;
+            }
+            case Expr::Kind::Field: {
+                uint8_t reg = 0;
+                bool temporary = false;
+                if (!Operand(*expr.children[0], reg, temporary)) break;
+                Emit(Op::GetField, dest, reg, 0, expr.id);
+                if (temporary) Release(reg);
+                break;
+            }
+            case Expr::Kind::Call: {
+                // Arguments go to consecutive registers
+                uint8_t first = 0;
+                for (size_t i = 0; i < expr.children.size(); i++) {
+                    uint8_t reg = 0;
+                    if (!Allocate(reg)) break;
+                    if (i == 0) first = reg;
+                    CompileExpr(*expr.children[i], reg);
+                }
+                Emit(Op::Call, dest, first, static_cast<uint8_t>(expr.children.size()), expr.id);
+                for (size_t i = expr.children.size(); i > 0; i--) Release(static_cast<uint8_t>(first + i - 1));
+                break;
+            }
+        }
+        m_line = savedLine;
+    }
+
+    std::vector<Token> m_tokens;
+    size_t m_pos = 0;
+    Program& m_program;
+    std::vector<Scope> m_scopes;
+    std::vector<Loop> m_loops;
+    uint32_t m_nextRegister = 0;
+    uint32_t m_maxRegister = 0;
+    uint32_t m_line = 1;
+    bool m_ok = true;
+    std::wstring m_error;
+};
+
+} // namespace
+
+bool Compile(std::wstring_view source, Program& program, std::wstring& error) {
+    program = {};
+    std::vector<Token> tokens;
+    if (!Tokenize(source, tokens, error)) return false;
+    Compiler compiler(std::move(tokens), program);
+    return compiler.Run(error);
+}
+
+std::wstring Disassemble(const Program& program) {
+    std::wstring text;
+    for (size_t i = 0; i < program.code.size(); i++) {
+        const Instruction& instruction = program.code[i];
+        wchar_t line[128];
+        std::swprintf(line, 128, L"%5zu  %-9ls r%-3u r%-3u r%-3u %u", i, OP_NAMES[static_cast<size_t>(instruction.op)],
+                      instruction.a, instruction.b, instruction.c, instruction.x);
+        text += line;
+        if (instruction.op == Op::LoadConst) {
+            const Constant& constant = program.constants[instruction.x];
+            text += L"    ; ";
+            if (const int64_t* number = std::get_if<int64_t>(&constant)) text += std::to_wstring(*number);
+            else text += L'"' + std::get<std::wstring>(constant) + L'"';
+        }
+        text += L'\n';
+    }
+    return text;
+}
+
+} // namespace core::script
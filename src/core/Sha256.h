@@ -0,0 +1,40 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * SHA-256 (FIPS 180-4), used to name content-addressed objects.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+class Sha256 {
+public:
+    Sha256() { Reset(); }
+
+    void Reset();
+    void Update(const void* data, size_t size);
+    Sha256Digest Finish();
+
+    static Sha256Digest Hash(const void* data, size_t size) {
+        Sha256 sha;
+        sha.Update(data, size);
+        return sha.Finish();
+    }
+
+private:
+    void Compress(const uint8_t* block);
+
+    uint32_t m_state[8];
+    uint8_t m_buffer[64];
+    uint64_t m_length = 0;      // Bytes hashed so far
+};
+
+} // namespace core
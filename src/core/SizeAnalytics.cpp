@@ -0,0 +1,466 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry size analytics.
+ */
+
+#include "SizeAnalytics.h"
+#include "WorkQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+namespace core {
+
+namespace {
+
+// Rows are first written to per-worker shards; a row id packs the shard
+// number above the row's index within the shard
+constexpr int SHARD_SHIFT = 40;
+constexpr uint64_t SHARD_MASK = (uint64_t{1} << SHARD_SHIFT) - 1;
+constexpr uint64_t NO_PARENT = UINT64_MAX;
+
+struct Shard {
+    KeySizeTable rows;                  // parent column unused; see parentIds
+    std::vector<uint64_t> parentIds;
+    std::vector<LargeValueInfo> largest;    // Min-heap by size
+    std::vector<uint64_t> largestIds;       // Row id of each heap entry (parallel)
+    std::vector<uint64_t> reusedIds;        // Rows whose values came from the previous table
+};
+
+struct ScanItem {
+    std::shared_ptr<const RegistryKey> parentKey;
+    std::shared_ptr<const RegistryKey> key;     // Set for the scan root only
+    std::wstring name;
+    uint64_t parentId = NO_PARENT;
+    uint32_t depth = 0;
+    uint32_t previousParent = INVALID_ROW;
+};
+
+// Lookup of (parent row, name) -> row over a previous table
+class ChildIndex {
+public:
+    explicit ChildIndex(const KeySizeTable& table) : m_table(table), m_rows(table.Size()) {
+        for (uint32_t row = 0; row < m_rows.size(); row++) m_rows[row] = row;
+        std::sort(m_rows.begin(), m_rows.end(), [this](uint32_t a, uint32_t b) {
+            if (m_table.parent[a] != m_table.parent[b]) return m_table.parent[a] < m_table.parent[b];
+            return CompareNames(m_table.Name(a), m_table.Name(b)) < 0;
+        });
+    }
+
+    uint32_t Find(uint32_t parent, std::wstring_view name) const {
+        auto it = std::lower_bound(m_rows.begin(), m_rows.end(), std::pair(parent, name),
+            [this](uint32_t row, const std::pair<uint32_t, std::wstring_view>& key) {
+                if (m_table.parent[row] != key.first) return m_table.parent[row] < key.first;
+                return CompareNames(m_table.Name(row), key.second) < 0;
+            });
+        if (it == m_rows.end() || m_table.parent[*it] != parent || !NamesEqual(m_table.Name(*it), name)) {
+            return INVALID_ROW;
+        }
+        return *it;
+    }
+
+    // Children of a row (rows are sorted by parent first)
+    std::span<const uint32_t> Children(uint32_t parent) const {
+        auto first = std::lower_bound(m_rows.begin(), m_rows.end(), parent,
+            [this](uint32_t row, uint32_t value) { return m_table.parent[row] < value; });
+        auto last = std::upper_bound(first, m_rows.end(), parent,
+            [this](uint32_t value, uint32_t row) { return value < m_table.parent[row]; });
+        return { m_rows.data() + (first - m_rows.begin()), static_cast<size_t>(last - first) };
+    }
+
+private:
+    const KeySizeTable& m_table;
+    std::vector<uint32_t> m_rows;
+};
+
+void AppendRow(KeySizeTable& rows, std::wstring_view name, uint32_t depth, uint64_t lastWriteTime,
+               uint32_t subKeys, uint32_t values, uint64_t nameBytes, uint64_t dataBytes, uint32_t largest) {
+    rows.depth.push_back(depth);
+    rows.nameOffset.push_back(static_cast<uint32_t>(rows.names.size()));
+    rows.nameLength.push_back(static_cast<uint16_t>(name.size()));
+    rows.names.append(name);
+    rows.lastWriteTime.push_back(lastWriteTime);
+    rows.subKeyCount.push_back(subKeys);
+    rows.valueCount.push_back(values);
+    rows.nameBytes.push_back(nameBytes);
+    rows.dataBytes.push_back(dataBytes);
+    rows.largestValue.push_back(largest);
+}
+
+bool HeapCompare(const LargeValueInfo& a, const LargeValueInfo& b) {
+    return a.size > b.size;  // Min-heap: smallest on top
+}
+
+void OfferLargest(Shard& shard, size_t limit, uint64_t rowId, std::wstring_view name, uint32_t type, uint32_t size) {
+    if (limit == 0) return;
+    if (shard.largest.size() >= limit && shard.largest.front().size >= size) return;
+
+    // The row field temporarily carries the heap slot's id index
+    LargeValueInfo info;
+    info.name.assign(name);
+    info.type = type;
+    info.size = size;
+
+    if (shard.largest.size() >= limit) {
+        std::pop_heap(shard.largest.begin(), shard.largest.end(), HeapCompare);
+        uint32_t slot = shard.largest.back().row;
+        shard.largest.pop_back();
+        shard.largestIds[slot] = rowId;
+        info.row = slot;
+    } else {
+        info.row = static_cast<uint32_t>(shard.largestIds.size());
+        shard.largestIds.push_back(rowId);
+    }
+    shard.largest.push_back(std::move(info));
+    std::push_heap(shard.largest.begin(), shard.largest.end(), HeapCompare);
+}
+
+class SizeScanner {
+public:
+    SizeScanner(const SizeScanOptions& options, unsigned shardCount)
+        : m_options(options), m_shards(shardCount) {
+        if (options.previous) {
+            m_previousIndex = std::make_unique<ChildIndex>(*options.previous);
+            for (uint32_t i = 0; i < options.previous->largestValues.size(); i++) {
+                m_previousLargest.emplace(options.previous->largestValues[i].row, i);
+            }
+        }
+    }
+
+    void Process(ScanItem& item, std::vector<ScanItem>& out, unsigned worker) {
+        // Deeper than the registry allows: a loop (e.g. through a link)
+        if (item.depth > MAX_KEY_DEPTH) {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::shared_ptr<const RegistryKey> key = item.key;
+        if (!key) key = item.parentKey->OpenSubKey(item.name);
+        KeyInfo info;
+        if (!key || !key->QueryInfo(info)) {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Shard& shard = m_shards[worker];
+        uint64_t rowId = (static_cast<uint64_t>(worker) << SHARD_SHIFT) | shard.rows.depth.size();
+        uint64_t keyNameBytes = item.name.size() * 2;
+
+        // Match against the previous scan
+        const KeySizeTable* previous = m_options.previous;
+        uint32_t previousRow = INVALID_ROW;
+        if (previous) {
+            previousRow = (item.parentId == NO_PARENT)
+                ? FindPreviousRoot()
+                : (item.previousParent == INVALID_ROW ? INVALID_ROW : m_previousIndex->Find(item.previousParent, item.name));
+        }
+        bool unchanged = previousRow != INVALID_ROW &&
+                         previous->lastWriteTime[previousRow] == info.lastWriteTime &&
+                         previous->subKeyCount[previousRow] == info.subKeyCount &&
+                         previous->valueCount[previousRow] == info.valueCount;
+
+        if (unchanged && m_options.skipUnchangedSubtrees && item.parentId != NO_PARENT) {
+            CopyPreviousSubtree(shard, worker, previousRow, item.depth, item.parentId);
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        shard.parentIds.push_back(item.parentId);
+        if (unchanged) {
+            AppendRow(shard.rows, item.name, item.depth, info.lastWriteTime, info.subKeyCount,
+                      previous->valueCount[previousRow], previous->nameBytes[previousRow],
+                      previous->dataBytes[previousRow], previous->largestValue[previousRow]);
+            CarryLargest(shard, previousRow, rowId);
+            shard.reusedIds.push_back(rowId);
+            m_reused.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            thread_local std::vector<ValueSummary> values;
+            key->GetValueSummaries(values);
+            uint64_t nameBytes = keyNameBytes;
+            uint64_t dataBytes = 0;
+            uint32_t largest = 0;
+            for (const ValueSummary& value : values) {
+                nameBytes += value.name.size() * 2;
+                dataBytes += value.dataSize;
+                if (value.dataSize > largest) largest = value.dataSize;
+                OfferLargest(shard, m_options.largestValueCount, rowId, value.name, value.type, value.dataSize);
+            }
+            AppendRow(shard.rows, item.name, item.depth, info.lastWriteTime, info.subKeyCount,
+                      static_cast<uint32_t>(values.size()), nameBytes, dataBytes, largest);
+        }
+
+        // Queue subkeys
+        thread_local std::vector<std::wstring> names;
+        key->GetSubKeyNames(names);
+        for (std::wstring& name : names) {
+            ScanItem child;
+            child.parentKey = key;
+            child.name = std::move(name);
+            child.parentId = rowId;
+            child.depth = item.depth + 1;
+            child.previousParent = previousRow;
+            out.push_back(std::move(child));
+        }
+    }
+
+    void Merge(KeySizeTable& table) {
+        table.Clear();
+
+        std::vector<uint64_t> shardBase(m_shards.size());
+        uint64_t total = 0;
+        for (size_t i = 0; i < m_shards.size(); i++) {
+            shardBase[i] = total;
+            total += m_shards[i].rows.depth.size();
+        }
+        auto globalRow = [&](uint64_t id) {
+            return (id == NO_PARENT) ? INVALID_ROW : static_cast<uint32_t>(shardBase[id >> SHARD_SHIFT] + (id & SHARD_MASK));
+        };
+
+        for (Shard& shard : m_shards) {
+            KeySizeTable& rows = shard.rows;
+            uint32_t nameBase = static_cast<uint32_t>(table.names.size());
+            for (uint64_t id : shard.parentIds) table.parent.push_back(globalRow(id));
+            for (uint32_t offset : rows.nameOffset) table.nameOffset.push_back(nameBase + offset);
+            table.names += rows.names;
+            auto append = [](auto& to, const auto& from) { to.insert(to.end(), from.begin(), from.end()); };
+            append(table.depth, rows.depth);
+            append(table.nameLength, rows.nameLength);
+            append(table.lastWriteTime, rows.lastWriteTime);
+            append(table.subKeyCount, rows.subKeyCount);
+            append(table.valueCount, rows.valueCount);
+            append(table.nameBytes, rows.nameBytes);
+            append(table.dataBytes, rows.dataBytes);
+            append(table.largestValue, rows.largestValue);
+            rows.Clear();
+
+            for (LargeValueInfo& info : shard.largest) {
+                info.row = globalRow(shard.largestIds[info.row]);
+                table.largestValues.push_back(std::move(info));
+            }
+            for (uint64_t id : shard.reusedIds) m_reusedRows.push_back(globalRow(id));
+        }
+
+        ComputeRollups(table);
+        TrimLargest(table);
+    }
+
+    // Reused keys only carry the values that made the previous table's
+    // list. When rescanned keys lost large values the cutoff drops below
+    // the previous one, and values of reused keys that were left out of
+    // that list may now qualify: enumerate those keys again, replacing
+    // their carried entries.
+    void CompleteLargest(const RegistryKey& root, KeySizeTable& table) const {
+        const KeySizeTable* previous = m_options.previous;
+        size_t limit = m_options.largestValueCount;
+        if (!previous || previous->largestValues.empty() || limit == 0) return;
+
+        uint32_t previousCutoff = previous->largestValues.back().size;
+        uint32_t cutoff = table.largestValues.size() >= limit ? table.largestValues.back().size : 0;
+        if (cutoff >= previousCutoff) return;
+
+        std::vector<uint32_t> rows;
+        for (uint32_t row : m_reusedRows) {
+            if (table.largestValue[row] > cutoff) rows.push_back(row);
+        }
+        if (rows.empty()) return;
+        std::sort(rows.begin(), rows.end());
+
+        std::erase_if(table.largestValues, [&rows](const LargeValueInfo& info) {
+            return std::binary_search(rows.begin(), rows.end(), info.row);
+        });
+        std::vector<ValueSummary> values;
+        for (uint32_t row : rows) {
+            KeyPtr opened;
+            const RegistryKey* key = &root;
+            if (table.parent[row] != INVALID_ROW) {
+                opened = root.OpenSubKey(table.Path(row));
+                if (!opened) continue;
+                key = opened.get();
+            }
+            key->GetValueSummaries(values);
+            for (ValueSummary& value : values) {
+                if (value.dataSize > cutoff) table.largestValues.push_back({ row, std::move(value.name), value.type, value.dataSize });
+            }
+        }
+        TrimLargest(table);
+    }
+
+    SizeScanStats Stats(const KeySizeTable& table, bool cancelled) const {
+        SizeScanStats stats;
+        stats.keys = table.Size();
+        stats.reusedKeys = m_reused.load();
+        stats.skippedSubtrees = m_skipped.load();
+        stats.errors = m_errors.load();
+        stats.cancelled = cancelled;
+        return stats;
+    }
+
+private:
+    void TrimLargest(KeySizeTable& table) const {
+        std::sort(table.largestValues.begin(), table.largestValues.end(),
+            [](const LargeValueInfo& a, const LargeValueInfo& b) { return a.size > b.size; });
+        if (table.largestValues.size() > m_options.largestValueCount) {
+            table.largestValues.resize(m_options.largestValueCount);
+        }
+    }
+
+    uint32_t FindPreviousRoot() const {
+        const KeySizeTable& previous = *m_options.previous;
+        for (uint32_t row = 0; row < previous.Size(); row++) {
+            if (previous.parent[row] == INVALID_ROW) return row;
+        }
+        return INVALID_ROW;
+    }
+
+    void CarryLargest(Shard& shard, uint32_t previousRow, uint64_t rowId) {
+        auto range = m_previousLargest.equal_range(previousRow);
+        for (auto it = range.first; it != range.second; ++it) {
+            const LargeValueInfo& info = m_options.previous->largestValues[it->second];
+            OfferLargest(shard, m_options.largestValueCount, rowId, info.name, info.type, info.size);
+        }
+    }
+
+    // Copy a previous row and all of its descendants into the shard
+    void CopyPreviousSubtree(Shard& shard, unsigned worker, uint32_t previousRoot, uint32_t depth, uint64_t parentId) {
+        const KeySizeTable& previous = *m_options.previous;
+        struct Pending { uint32_t row; uint64_t parentId; uint32_t depth; };
+        std::vector<Pending> stack{ { previousRoot, parentId, depth } };
+
+        while (!stack.empty()) {
+            Pending next = stack.back();
+            stack.pop_back();
+            uint32_t row = next.row;
+            uint64_t rowId = (static_cast<uint64_t>(worker) << SHARD_SHIFT) | shard.rows.depth.size();
+
+            shard.parentIds.push_back(next.parentId);
+            AppendRow(shard.rows, previous.Name(row), next.depth, previous.lastWriteTime[row],
+                      previous.subKeyCount[row], previous.valueCount[row], previous.nameBytes[row],
+                      previous.dataBytes[row], previous.largestValue[row]);
+            CarryLargest(shard, row, rowId);
+            shard.reusedIds.push_back(rowId);
+
+            for (uint32_t child : m_previousIndex->Children(row)) {
+                stack.push_back({ child, rowId, next.depth + 1 });
+            }
+        }
+    }
+
+    // Subtree sums, deepest level first so every child is final before
+    // being added to its parent
+    static void ComputeRollups(KeySizeTable& table) {
+        size_t count = table.Size();
+        table.subtreeKeys.assign(count, 1);
+        table.subtreeValues.assign(table.valueCount.begin(), table.valueCount.end());
+        table.subtreeNameBytes = table.nameBytes;
+        table.subtreeDataBytes = table.dataBytes;
+
+        uint32_t maxDepth = 0;
+        for (uint32_t depth : table.depth) maxDepth = std::max(maxDepth, depth);
+
+        // Counting sort of rows by depth
+        std::vector<uint32_t> start(static_cast<size_t>(maxDepth) + 2, 0);
+        for (uint32_t depth : table.depth) start[depth + 1]++;
+        for (size_t i = 1; i < start.size(); i++) start[i] += start[i - 1];
+        std::vector<uint32_t> byDepth(count);
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        for (uint32_t row = 0; row < count; row++) byDepth[fill[table.depth[row]]++] = row;
+
+        for (size_t i = count; i-- > 0;) {
+            uint32_t row = byDepth[i];
+            uint32_t parent = table.parent[row];
+            if (parent == INVALID_ROW) continue;
+            table.subtreeKeys[parent] += table.subtreeKeys[row];
+            table.subtreeValues[parent] += table.subtreeValues[row];
+            table.subtreeNameBytes[parent] += table.subtreeNameBytes[row];
+            table.subtreeDataBytes[parent] += table.subtreeDataBytes[row];
+        }
+    }
+
+    const SizeScanOptions& m_options;
+    std::vector<Shard> m_shards;
+    std::unique_ptr<ChildIndex> m_previousIndex;
+    std::unordered_multimap<uint32_t, uint32_t> m_previousLargest;  // Previous row -> largestValues index
+    std::vector<uint32_t> m_reusedRows;                             // Rows in the merged table
+    std::atomic<uint64_t> m_reused{0};
+    std::atomic<uint64_t> m_skipped{0};
+    std::atomic<uint64_t> m_errors{0};
+};
+
+} // namespace
+
+void KeySizeTable::Clear() {
+    *this = KeySizeTable();
+}
+
+std::wstring_view KeySizeTable::Name(uint32_t row) const {
+    return std::wstring_view(names).substr(nameOffset[row], nameLength[row]);
+}
+
+std::wstring KeySizeTable::Path(uint32_t row) const {
+    std::vector<uint32_t> chain;
+    for (uint32_t current = row; current != INVALID_ROW && parent[current] != INVALID_ROW; current = parent[current]) {
+        chain.push_back(current);
+    }
+    std::wstring path;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        if (!path.empty()) path += L'\\';
+        path += Name(*it);
+    }
+    return path;
+}
+
+uint64_t KeySizeTable::Get(Column column, uint32_t row) const {
+    switch (column) {
+        case Column::SubtreeKeys: return subtreeKeys[row];
+        case Column::SubtreeValues: return subtreeValues[row];
+        case Column::SubtreeNameBytes: return subtreeNameBytes[row];
+        case Column::SubtreeDataBytes: return subtreeDataBytes[row];
+        case Column::SubtreeTotalBytes: return subtreeNameBytes[row] + subtreeDataBytes[row];
+        case Column::OwnValues: return valueCount[row];
+        case Column::OwnDataBytes: return dataBytes[row];
+        case Column::SubKeys: return subKeyCount[row];
+        case Column::LargestValue: return largestValue[row];
+    }
+    return 0;
+}
+
+std::vector<uint32_t> KeySizeTable::TopN(Column column, size_t count, uint32_t maxDepth) const {
+    // Extract the column once so the selection works on a flat array
+    std::vector<std::pair<uint64_t, uint32_t>> keys;
+    keys.reserve(Size());
+    for (uint32_t row = 0; row < Size(); row++) {
+        if (depth[row] <= maxDepth) keys.emplace_back(Get(column, row), row);
+    }
+
+    count = std::min(count, keys.size());
+    auto larger = [](const auto& a, const auto& b) { return a.first > b.first || (a.first == b.first && a.second < b.second); };
+    std::nth_element(keys.begin(), keys.begin() + count, keys.end(), larger);
+    std::sort(keys.begin(), keys.begin() + count, larger);
+
+    std::vector<uint32_t> rows(count);
+    for (size_t i = 0; i < count; i++) rows[i] = keys[i].second;
+    return rows;
+}
+
+SizeScanStats ScanKeySizes(const RegistryKey& root, KeySizeTable& table, const SizeScanOptions& options) {
+    WorkQueue<ScanItem> queue(options.threadCount, options.stopToken);
+    SizeScanner scanner(options, queue.ThreadCount());
+
+    ScanItem rootItem;
+    rootItem.key = std::shared_ptr<const RegistryKey>(&root, [](const RegistryKey*) {});
+    queue.Push(std::move(rootItem));
+
+    queue.Run([&scanner](ScanItem& item, std::vector<ScanItem>& out, unsigned worker) {
+        scanner.Process(item, out, worker);
+    });
+
+    scanner.Merge(table);
+    if (!queue.Cancelled()) scanner.CompleteLargest(root, table);
+    return scanner.Stats(table, queue.Cancelled());
+}
+
+} // namespace core
@@ -0,0 +1,109 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry size analytics: a parallel single-pass scan that produces a
+ * columnar per-key table with subtree rollups, used for "size by hive" and
+ * "what is bloating this hive" top-N views.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+constexpr uint32_t INVALID_ROW = 0xFFFFFFFF;
+
+// A large value found during the scan
+struct LargeValueInfo {
+    uint32_t row = INVALID_ROW;         // Key that holds the value
+    std::wstring name;
+    uint32_t type = VALUE_NONE;
+    uint32_t size = 0;
+};
+
+// One row per key, stored column by column. Row order is unspecified; use
+// parent/depth to walk the tree.
+struct KeySizeTable {
+    enum class Column {
+        SubtreeKeys,
+        SubtreeValues,
+        SubtreeNameBytes,
+        SubtreeDataBytes,
+        SubtreeTotalBytes,              // Name + data bytes
+        OwnValues,
+        OwnDataBytes,
+        SubKeys,
+        LargestValue
+    };
+
+    // Identity
+    std::vector<uint32_t> parent;       // INVALID_ROW for the scan root
+    std::vector<uint32_t> depth;
+    std::vector<uint32_t> nameOffset;   // Into names
+    std::vector<uint16_t> nameLength;
+    std::vector<uint64_t> lastWriteTime;
+
+    // The key itself
+    std::vector<uint32_t> subKeyCount;
+    std::vector<uint32_t> valueCount;
+    std::vector<uint64_t> nameBytes;    // Key name plus value names (UTF-16 bytes)
+    std::vector<uint64_t> dataBytes;
+    std::vector<uint32_t> largestValue; // Size of the largest value
+
+    // The key and all of its descendants
+    std::vector<uint64_t> subtreeKeys;
+    std::vector<uint64_t> subtreeValues;
+    std::vector<uint64_t> subtreeNameBytes;
+    std::vector<uint64_t> subtreeDataBytes;
+
+    std::wstring names;                 // Name pool
+    std::vector<LargeValueInfo> largestValues;  // Largest values overall, biggest first
+
+    size_t Size() const { return parent.size(); }
+    void Clear();
+
+    std::wstring_view Name(uint32_t row) const;
+    std::wstring Path(uint32_t row) const;     // Relative to the scan root
+    uint64_t Get(Column column, uint32_t row) const;
+
+    // Rows with the largest values in a column, biggest first. Restricted
+    // to rows at or below maxDepth when given (e.g. 1 for direct children).
+    std::vector<uint32_t> TopN(Column column, size_t count, uint32_t maxDepth = UINT32_MAX) const;
+};
+
+struct SizeScanOptions {
+    unsigned threadCount = 0;           // 0 = one per hardware thread
+    std::stop_token stopToken;
+    size_t largestValueCount = 100;     // Entries kept in largestValues
+
+    // Incremental rescan: keys whose last-write time and counts match the
+    // previous table reuse its per-key figures instead of enumerating
+    // their values. Subkeys are still visited, because a key's last-write
+    // time does not change when only a descendant changes.
+    const KeySizeTable* previous = nullptr;
+
+    // Also skip whole subtrees whose root is unchanged, copying the previous
+    // rows. Only safe when every writer touches the ancestors of what it
+    // changes (e.g. comparing snapshots made by our own tools).
+    bool skipUnchangedSubtrees = false;
+};
+
+struct SizeScanStats {
+    uint64_t keys = 0;
+    uint64_t reusedKeys = 0;            // Values taken from the previous table
+    uint64_t skippedSubtrees = 0;
+    uint64_t errors = 0;
+    bool cancelled = false;
+};
+
+SizeScanStats ScanKeySizes(const RegistryKey& root, KeySizeTable& table, const SizeScanOptions& options = {});
+
+} // namespace core
@@ -0,0 +1,382 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * String sources and the display resolution cache.
+ */
+
+#include "StringResolver.h"
+#include "RegistryTypes.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <userenv.h>
+#else
+#include <cstdlib>
+#include <filesystem>
+#endif
+
+namespace core {
+
+#ifdef _WIN32
+
+NativeStringSource::~NativeStringSource() {
+    for (auto& [path, module] : m_modules) {
+        if (module) FreeLibrary(static_cast<HMODULE>(module));
+    }
+}
+
+bool NativeStringSource::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_reloaded) {
+            auto it = m_environment.find(FoldName(name));
+            if (it == m_environment.end()) return false;
+            value = it->second;
+            return true;
+        }
+    }
+
+    std::wstring key(name);
+    DWORD size = GetEnvironmentVariableW(key.c_str(), nullptr, 0);
+    if (size == 0) return false;
+
+    value.resize(size);
+    DWORD length = GetEnvironmentVariableW(key.c_str(), value.data(), size);
+    if (length == 0 || length >= size) return false;
+    value.resize(length);
+    return true;
+}
+
+bool NativeStringSource::LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) {
+    HMODULE handle;
+    {
+        std::lock_guard lock(m_mutex);
+        auto [it, inserted] = m_modules.try_emplace(FoldName(module), nullptr);
+        if (inserted) {
+            // Resources only: no DllMain, no imports; MUI satellites are still found
+            it->second = LoadLibraryExW(module.c_str(), nullptr,
+                                        LOAD_LIBRARY_AS_DATAFILE | LOAD_LIBRARY_AS_IMAGE_RESOURCE);
+        }
+        handle = static_cast<HMODULE>(it->second);
+    }
+    if (!handle) return false;
+
+    // A zero buffer size returns a pointer into the resource itself
+    const wchar_t* resource = nullptr;
+    int length = LoadStringW(handle, id, reinterpret_cast<LPWSTR>(&resource), 0);
+    if (length <= 0 || !resource) return false;
+    text.assign(resource, static_cast<size_t>(length));
+    return true;
+}
+
+bool NativeStringSource::ReloadEnvironment() {
+    // The block a new process of this user gets, expanded from the registry now
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY | TOKEN_DUPLICATE | TOKEN_IMPERSONATE, &token)) {
+        return false;
+    }
+    void* block = nullptr;
+    BOOL created = CreateEnvironmentBlock(&block, token, FALSE);
+    CloseHandle(token);
+    if (!created) return false;
+
+    std::unordered_map<std::wstring, std::wstring> environment;
+    for (const wchar_t* entry = static_cast<const wchar_t*>(block); *entry;) {
+        std::wstring_view text(entry);
+        entry += text.size() + 1;
+        size_t equals = text.find(L'=', 1);     // Hidden "=C:=C:\..." entries start with '='
+        if (equals == std::wstring_view::npos) continue;
+        environment[FoldName(text.substr(0, equals))] = std::wstring(text.substr(equals + 1));
+    }
+    DestroyEnvironmentBlock(block);
+
+    std::lock_guard lock(m_mutex);
+    m_environment.swap(environment);
+    m_reloaded = true;
+    return true;
+}
+
+#else
+
+NativeStringSource::~NativeStringSource() = default;
+
+bool NativeStringSource::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    std::string key = std::filesystem::path(std::wstring(name)).string();
+    const char* text = std::getenv(key.c_str());
+    if (!text) return false;
+    value = std::filesystem::path(text).wstring();
+    return true;
+}
+
+bool NativeStringSource::LoadModuleString(const std::wstring&, uint32_t, std::wstring&) {
+    return false;
+}
+
+bool NativeStringSource::ReloadEnvironment() {
+    return true;
+}
+
+#endif
+
+static std::wstring StringKey(std::wstring_view module, uint32_t id) {
+    std::wstring key = FoldName(module);
+    key += L'\n';
+    key += std::to_wstring(id);
+    return key;
+}
+
+void MemoryStringSource::SetEnvironment(std::wstring_view name, std::wstring_view value) {
+    std::lock_guard lock(m_mutex);
+    m_environment[FoldName(name)] = std::wstring(value);
+}
+
+void MemoryStringSource::AddModuleString(std::wstring_view module, uint32_t id, std::wstring_view text) {
+    std::lock_guard lock(m_mutex);
+    m_strings[StringKey(module, id)] = std::wstring(text);
+}
+
+bool MemoryStringSource::GetEnvironment(std::wstring_view name, std::wstring& value) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_environment.find(FoldName(name));
+    if (it == m_environment.end()) return false;
+    value = it->second;
+    return true;
+}
+
+bool MemoryStringSource::LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_strings.find(StringKey(module, id));
+    if (it == m_strings.end()) return false;
+    text = it->second;
+    return true;
+}
+
+StringResolution ResolutionFor(uint32_t type, std::wstring_view text) {
+    if (type != VALUE_SZ && type != VALUE_EXPAND_SZ) return StringResolution::None;
+    if (text.size() > 1 && text[0] == L'@') return StringResolution::Indirect;
+    if (type == VALUE_EXPAND_SZ && text.find(L'%') != std::wstring_view::npos) {
+        return StringResolution::Expand;
+    }
+    return StringResolution::None;
+}
+
+std::wstring ExpandEnvironmentText(std::wstring_view text, StringSource& source) {
+    std::wstring result;
+    result.reserve(text.size());
+    std::wstring value;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t open = text.find(L'%', pos);
+        if (open == std::wstring_view::npos) break;
+        result.append(text, pos, open - pos);
+
+        size_t close = text.find(L'%', open + 1);
+        if (close == std::wstring_view::npos) {
+            pos = open;
+            break;
+        }
+
+        std::wstring_view name = text.substr(open + 1, close - open - 1);
+        if (!name.empty() && source.GetEnvironment(name, value)) {
+            result += value;
+            pos = close + 1;
+        } else {
+            // Keep "%NAME" and let the closing '%' start the next reference
+            result.append(text, open, close - open);
+            pos = close;
+        }
+    }
+    result.append(text, pos);
+    return result;
+}
+
+bool ParseIndirectString(std::wstring_view text, std::wstring& module, uint32_t& id) {
+    if (text.empty() || text[0] != L'@') return false;
+    text.remove_prefix(1);
+
+    size_t comment = text.find(L';');
+    if (comment != std::wstring_view::npos) text = text.substr(0, comment);
+
+    size_t comma = text.rfind(L",-");
+    if (comma == std::wstring_view::npos || comma == 0 || comma + 2 == text.size()) return false;
+
+    uint64_t number = 0;
+    for (wchar_t c : text.substr(comma + 2)) {
+        if (c < L'0' || c > L'9') return false;
+        number = number * 10 + static_cast<uint64_t>(c - L'0');
+        if (number > UINT32_MAX) return false;
+    }
+
+    module.assign(text.substr(0, comma));
+    id = static_cast<uint32_t>(number);
+    return true;
+}
+
+StringResolveCache::~StringResolveCache() {
+    if (m_worker.joinable()) {
+        m_worker.request_stop();
+        m_worker.join();
+    }
+}
+
+std::wstring StringResolveCache::CacheKey(StringResolution resolution, std::wstring_view text) {
+    std::wstring key;
+    key.reserve(text.size() + 1);
+    key += static_cast<wchar_t>(resolution);
+    key += text;
+    return key;
+}
+
+std::wstring StringResolveCache::Compute(StringResolution resolution, std::wstring_view text, bool& ok) {
+    ok = false;
+    if (resolution == StringResolution::Expand) {
+        ok = true;
+        return ExpandEnvironmentText(text, m_source);
+    }
+
+    std::wstring module;
+    uint32_t id = 0;
+    std::wstring resolved;
+    if (resolution == StringResolution::Indirect && ParseIndirectString(text, module, id) &&
+        m_source.LoadModuleString(ExpandEnvironmentText(module, m_source), id, resolved)) {
+        ok = true;
+        return resolved;
+    }
+    return std::wstring(text);
+}
+
+void StringResolveCache::Store(std::wstring key, uint64_t generation, std::wstring text) {
+    // Callers hold m_mutex. A full table starts over rather than tracking use.
+    if (m_entries.size() >= m_maxEntries) m_entries.clear();
+    m_entries.insert_or_assign(std::move(key), Entry{generation, std::move(text)});
+}
+
+bool StringResolveCache::Lookup(uint32_t type, std::wstring_view text, std::wstring& resolved) {
+    StringResolution resolution = ResolutionFor(type, text);
+    if (resolution == StringResolution::None) return false;
+    std::wstring key = CacheKey(resolution, text);
+
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.generation != m_generation) {
+        m_stats.misses++;
+        return false;
+    }
+    m_stats.hits++;
+    resolved = it->second.text;
+    return true;
+}
+
+void StringResolveCache::Request(std::span<const StringRequest> requests) {
+    std::lock_guard lock(m_mutex);
+    size_t queued = m_queue.size();
+    for (const StringRequest& request : requests) {
+        StringResolution resolution = ResolutionFor(request.type, request.text);
+        if (resolution == StringResolution::None) continue;
+
+        std::wstring key = CacheKey(resolution, request.text);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second.generation == m_generation) continue;
+        if (!m_pending.insert(key).second) continue;
+        m_queue.push_back(std::move(key));
+    }
+    if (m_queue.size() == queued) return;
+
+    if (!m_worker.joinable()) {
+        m_worker = std::jthread([this](std::stop_token stopToken) { WorkerLoop(stopToken); });
+    }
+    m_wake.notify_one();
+}
+
+void StringResolveCache::SetReadyCallback(std::function<void()> callback) {
+    std::lock_guard lock(m_mutex);
+    m_onReady = std::move(callback);
+}
+
+std::wstring StringResolveCache::Resolve(uint32_t type, std::wstring_view text) {
+    StringResolution resolution = ResolutionFor(type, text);
+    if (resolution == StringResolution::None) return std::wstring(text);
+    std::wstring key = CacheKey(resolution, text);
+
+    uint64_t generation;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second.generation == m_generation) {
+            m_stats.hits++;
+            return it->second.text;
+        }
+        m_stats.misses++;
+        generation = m_generation;
+    }
+
+    bool ok;
+    std::wstring resolved = Compute(resolution, text, ok);
+
+    std::lock_guard lock(m_mutex);
+    m_stats.resolved++;
+    if (!ok) m_stats.failed++;
+    Store(std::move(key), generation, resolved);
+    return resolved;
+}
+
+void StringResolveCache::InvalidateEnvironment() {
+    std::lock_guard lock(m_mutex);
+    m_generation++;
+}
+
+uint64_t StringResolveCache::Generation() const {
+    std::lock_guard lock(m_mutex);
+    return m_generation;
+}
+
+StringCacheStats StringResolveCache::GetStats() const {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+void StringResolveCache::WorkerLoop(std::stop_token stopToken) {
+    std::vector<std::wstring> batch;
+    std::vector<std::pair<std::wstring, bool>> results;
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        if (!m_wake.wait(lock, stopToken, [this] { return !m_queue.empty(); })) return;
+
+        batch.swap(m_queue);
+        uint64_t generation = m_generation;
+        lock.unlock();
+
+        // The source is only touched here, outside the lock
+        results.clear();
+        for (const std::wstring& key : batch) {
+            bool ok;
+            std::wstring text = Compute(static_cast<StringResolution>(key[0]),
+                                        std::wstring_view(key).substr(1), ok);
+            results.emplace_back(std::move(text), ok);
+            if (stopToken.stop_requested()) break;
+        }
+
+        lock.lock();
+        for (size_t i = 0; i < results.size(); i++) {
+            m_stats.resolved++;
+            if (!results[i].second) m_stats.failed++;
+            // Results computed against an older environment are not kept
+            if (generation == m_generation) Store(batch[i], generation, std::move(results[i].first));
+        }
+        for (const std::wstring& key : batch) m_pending.erase(key);
+        batch.clear();
+        m_stats.batches++;
+        if (stopToken.stop_requested()) return;
+
+        std::function<void()> onReady = m_onReady;
+        if (!onReady) continue;
+        lock.unlock();
+        onReady();
+        lock.lock();
+    }
+}
+
+} // namespace core
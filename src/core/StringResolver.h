@@ -0,0 +1,165 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Display resolution of REG_EXPAND_SZ text (%NAME% references) and
+ * indirect strings ("@%SystemRoot%\system32\shell32.dll,-21787"). Results
+ * are memoized per raw string and environment generation, and resolved in
+ * batches on a background thread, so painting never touches the
+ * environment block or loads a resource DLL.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace core {
+
+// Where environment variables and string resources come from
+class StringSource {
+public:
+    virtual ~StringSource() = default;
+
+    virtual bool GetEnvironment(std::wstring_view name, std::wstring& value) = 0;
+
+    // String resource id of a module (an expanded path or a bare DLL name)
+    virtual bool LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) = 0;
+};
+
+// The process environment and real resource DLLs. Modules are loaded once
+// as data files and kept in a table shared by all callers until the source
+// is destroyed. Off Windows no module strings are available.
+//
+// The process environment is fixed at startup; after ReloadEnvironment the
+// variables come from a block built from the registry instead, as Explorer
+// does when it is told the environment changed.
+class NativeStringSource : public StringSource {
+public:
+    NativeStringSource() = default;
+    ~NativeStringSource() override;
+
+    NativeStringSource(const NativeStringSource&) = delete;
+    NativeStringSource& operator=(const NativeStringSource&) = delete;
+
+    bool GetEnvironment(std::wstring_view name, std::wstring& value) override;
+    bool LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) override;
+
+    // Re-read the system and user variables (HKLM Session Manager\Environment
+    // and HKCU\Environment). A no-op off Windows.
+    bool ReloadEnvironment();
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::wstring, void*> m_modules;     // Folded path -> module, null if it failed to load
+    std::unordered_map<std::wstring, std::wstring> m_environment;  // Folded name -> value, once reloaded
+    bool m_reloaded = false;
+};
+
+// Fixed environment and string tables, for running without Windows
+class MemoryStringSource : public StringSource {
+public:
+    void SetEnvironment(std::wstring_view name, std::wstring_view value);
+    void AddModuleString(std::wstring_view module, uint32_t id, std::wstring_view text);
+
+    bool GetEnvironment(std::wstring_view name, std::wstring& value) override;
+    bool LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) override;
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<std::wstring, std::wstring> m_environment;  // Folded name -> value
+    std::unordered_map<std::wstring, std::wstring> m_strings;      // Folded module + '\n' + id -> text
+};
+
+enum class StringResolution : uint8_t {
+    None,               // Shown as is
+    Expand,             // REG_EXPAND_SZ with at least one %NAME%
+    Indirect            // "@module,-id[;comment]"
+};
+
+// What display resolution a string value of the given type needs
+StringResolution ResolutionFor(uint32_t type, std::wstring_view text);
+
+// Expand %NAME% references; unknown names are left as written, like
+// ExpandEnvironmentStrings
+std::wstring ExpandEnvironmentText(std::wstring_view text, StringSource& source);
+
+// Split "@module,-id;comment" into module and id
+bool ParseIndirectString(std::wstring_view text, std::wstring& module, uint32_t& id);
+
+struct StringRequest {
+    uint32_t type;
+    std::wstring text;
+};
+
+struct StringCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t resolved = 0;              // Strings resolved by the source
+    uint64_t failed = 0;                // Of those, left as raw text
+    uint64_t batches = 0;
+};
+
+class StringResolveCache {
+public:
+    explicit StringResolveCache(StringSource& source, size_t maxEntries = 65536)
+        : m_source(source), m_maxEntries(maxEntries) {}
+    ~StringResolveCache();
+
+    StringResolveCache(const StringResolveCache&) = delete;
+    StringResolveCache& operator=(const StringResolveCache&) = delete;
+
+    // Resolved text if it is cached for the current environment. Never blocks
+    // on the source; on a miss, show the raw text and Request() it.
+    bool Lookup(uint32_t type, std::wstring_view text, std::wstring& resolved);
+
+    // Queue strings (e.g. the visible rows) for the background thread. The
+    // ready callback runs on that thread after each batch.
+    void Request(std::span<const StringRequest> requests);
+    void SetReadyCallback(std::function<void()> callback);
+
+    // Resolve on the calling thread, through the cache
+    std::wstring Resolve(uint32_t type, std::wstring_view text);
+
+    // The environment changed: cached expansions are stale from now on
+    void InvalidateEnvironment();
+    uint64_t Generation() const;
+
+    StringCacheStats GetStats() const;
+
+private:
+    struct Entry {
+        uint64_t generation;
+        std::wstring text;
+    };
+
+    static std::wstring CacheKey(StringResolution resolution, std::wstring_view text);
+    std::wstring Compute(StringResolution resolution, std::wstring_view text, bool& ok);
+    void Store(std::wstring key, uint64_t generation, std::wstring text);
+    void WorkerLoop(std::stop_token stopToken);
+
+    StringSource& m_source;
+    size_t m_maxEntries;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::unordered_map<std::wstring, Entry> m_entries;     // Kind + raw text -> result
+    std::unordered_set<std::wstring> m_pending;             // Keys queued or being resolved
+    std::vector<std::wstring> m_queue;
+    std::function<void()> m_onReady;
+    uint64_t m_generation = 0;
+    StringCacheStats m_stats;
+    std::jthread m_worker;                                  // Started by the first Request()
+};
+
+} // namespace core
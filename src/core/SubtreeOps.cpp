@@ -0,0 +1,231 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Recursive key operations (copy and delete of whole subtrees).
+ */
+
+#include "SubtreeOps.h"
+#include "WorkQueue.h"
+
+#include <atomic>
+#include <memory>
+
+namespace core {
+
+namespace {
+
+// Shared counters plus throttled progress reporting
+class StatsCollector {
+public:
+    explicit StatsCollector(const SubtreeOptions& options) : m_options(options) {}
+
+    void AddKey(uint64_t values) {
+        uint64_t totalValues = m_values.fetch_add(values, std::memory_order_relaxed) + values;
+        uint64_t keys = m_keys.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (m_options.onProgress && m_options.progressInterval &&
+            keys % m_options.progressInterval == 0) {
+            m_options.onProgress(keys, totalValues);
+        }
+    }
+
+    void AddError() { m_errors.fetch_add(1, std::memory_order_relaxed); }
+
+    SubtreeStats Finish(bool cancelled) const {
+        SubtreeStats stats;
+        stats.keys = m_keys.load();
+        stats.values = m_values.load();
+        stats.errors = m_errors.load();
+        stats.cancelled = cancelled;
+        if (m_options.onProgress) m_options.onProgress(stats.keys, stats.values);
+        return stats;
+    }
+
+private:
+    const SubtreeOptions& m_options;
+    std::atomic<uint64_t> m_keys{0};
+    std::atomic<uint64_t> m_values{0};
+    std::atomic<uint64_t> m_errors{0};
+};
+
+// Non-owning shared_ptr for keys owned by the caller
+template <typename Key>
+std::shared_ptr<Key> Borrow(Key& key) {
+    return std::shared_ptr<Key>(&key, [](Key*) {});
+}
+
+// ---------------------------------------------------------------------------
+// Copy: every item names a child still to be copied. Children are opened
+// lazily so wide keys do not hold thousands of handles on the stack.
+// ---------------------------------------------------------------------------
+
+struct CopyItem {
+    std::shared_ptr<const RegistryKey> sourceParent;
+    std::shared_ptr<RegistryKey> destinationParent;
+    std::wstring name;
+    size_t depth;                               // Levels below the copied root
+};
+
+// Copy values of one key and queue its children
+void CopyKey(const std::shared_ptr<const RegistryKey>& source, const std::shared_ptr<RegistryKey>& destination,
+             size_t depth, std::vector<CopyItem>& out, StatsCollector& stats) {
+    // Per-thread enumeration buffers are reused across keys
+    thread_local std::vector<RegValue> values;
+    thread_local std::vector<std::wstring> names;
+
+    source->GetValues(values);
+    for (const RegValue& value : values) {
+        if (!destination->SetValue(value)) stats.AddError();
+    }
+
+    source->GetSubKeyNames(names);
+    for (std::wstring& name : names) {
+        out.push_back({ source, destination, std::move(name), depth + 1 });
+    }
+    stats.AddKey(values.size());
+}
+
+// ---------------------------------------------------------------------------
+// Delete: a node is removed from its parent once all of its children are
+// gone. Leaf children are deleted in one batch straight from the parent's
+// enumeration; only children with subkeys become separate work items.
+// ---------------------------------------------------------------------------
+
+struct DeleteNode {
+    std::shared_ptr<DeleteNode> parent;
+    std::shared_ptr<RegistryKey> key;           // Open while children remain
+    std::wstring name;                          // Name within parent->key
+    std::atomic<size_t> remaining{0};           // Children still to delete
+
+    ~DeleteNode() {
+        // Unlink the parent chain iteratively; a cancelled delete of a very
+        // deep tree would otherwise release it recursively
+        std::shared_ptr<DeleteNode> next = std::move(parent);
+        while (next && next.use_count() == 1) {
+            next = std::move(next->parent);
+        }
+    }
+};
+
+using DeleteItem = std::shared_ptr<DeleteNode>;
+
+// Called when one child of node is gone; removes finished ancestors
+void FinishChild(DeleteItem node, StatsCollector& stats) {
+    while (node && node->remaining.fetch_sub(1) == 1) {
+        DeleteItem parent = node->parent;
+        node->key.reset();
+        if (!parent) break;  // Sentinel holding the caller's parent key
+
+        if (parent->key->DeleteSubKey(node->name)) {
+            stats.AddKey(0);
+        } else {
+            stats.AddError();
+            break;  // Leave ancestors in place
+        }
+        node = std::move(parent);
+    }
+}
+
+void DeleteKey(DeleteItem& node, std::vector<DeleteItem>& out, StatsCollector& stats) {
+    thread_local std::vector<std::wstring> names;
+
+    KeyPtr opened = node->parent->key->OpenSubKey(node->name);
+    if (!opened) {
+        stats.AddError();
+        return;  // Parent keeps a pending child and is left intact
+    }
+    node->key = std::move(opened);
+    node->key->GetSubKeyNames(names);
+
+    // One extra count guards against finishing while children are queued
+    node->remaining.store(names.size() + 1);
+    for (std::wstring& name : names) {
+        if (node->key->DeleteSubKey(name)) {
+            stats.AddKey(0);
+            node->remaining.fetch_sub(1);
+        } else {
+            auto child = std::make_shared<DeleteNode>();
+            child->parent = node;
+            child->name = std::move(name);
+            out.push_back(std::move(child));
+        }
+    }
+    FinishChild(node, stats);
+}
+
+} // namespace
+
+SubtreeStats CopySubtree(const RegistryKey& source, RegistryKey& destination, const SubtreeOptions& options) {
+    StatsCollector stats(options);
+    WorkQueue<CopyItem> queue(options.threadCount, options.stopToken);
+
+    // The root is handled up front; its children seed the shared stack
+    std::vector<CopyItem> roots;
+    CopyKey(Borrow(source), Borrow(destination), 0, roots, stats);
+    for (CopyItem& item : roots) queue.Push(std::move(item));
+
+    queue.Run([&stats](CopyItem& item, std::vector<CopyItem>& out, unsigned) {
+        if (item.depth > MAX_KEY_DEPTH) {
+            stats.AddError();
+            return;
+        }
+        std::shared_ptr<const RegistryKey> source = item.sourceParent->OpenSubKey(item.name);
+        std::shared_ptr<RegistryKey> destination = source ? item.destinationParent->CreateSubKey(item.name) : nullptr;
+        if (!source || !destination) {
+            stats.AddError();
+            return;
+        }
+        CopyKey(source, destination, item.depth, out, stats);
+    });
+
+    return stats.Finish(queue.Cancelled());
+}
+
+SubtreeStats CopySubtree(RegistryBackend& backend, std::wstring_view sourcePath,
+                         std::wstring_view destinationPath, const SubtreeOptions& options) {
+    SubtreeStats stats;
+    if (IsSameOrBelow(sourcePath, destinationPath)) {
+        stats.rejected = true;
+        return stats;
+    }
+    KeyPtr source = backend.OpenKey(sourcePath);
+    KeyPtr destination = source ? backend.OpenRoot() : nullptr;
+    if (destination && !SplitPath(destinationPath).empty()) destination = destination->CreateSubKey(destinationPath);
+    if (!destination) {
+        stats.errors = 1;
+        return stats;
+    }
+    return CopySubtree(*source, *destination, options);
+}
+
+bool IsSameOrBelow(std::wstring_view ancestor, std::wstring_view path) {
+    std::vector<std::wstring_view> ancestorParts = SplitPath(ancestor);
+    std::vector<std::wstring_view> pathParts = SplitPath(path);
+    if (ancestorParts.size() > pathParts.size()) return false;
+    for (size_t i = 0; i < ancestorParts.size(); i++) {
+        if (!NamesEqual(ancestorParts[i], pathParts[i])) return false;
+    }
+    return true;
+}
+
+SubtreeStats DeleteSubtree(RegistryKey& parent, std::wstring_view name, const SubtreeOptions& options) {
+    StatsCollector stats(options);
+    WorkQueue<DeleteItem> queue(options.threadCount, options.stopToken);
+
+    auto sentinel = std::make_shared<DeleteNode>();
+    sentinel->key = Borrow(parent);
+    sentinel->remaining.store(1);
+
+    auto root = std::make_shared<DeleteNode>();
+    root->parent = sentinel;
+    root->name = name;
+    queue.Push(std::move(root));
+
+    queue.Run([&stats](DeleteItem& node, std::vector<DeleteItem>& out, unsigned) {
+        DeleteKey(node, out, stats);
+    });
+
+    return stats.Finish(queue.Cancelled());
+}
+
+} // namespace core
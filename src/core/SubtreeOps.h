@@ -0,0 +1,60 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Recursive key operations (copy and delete of whole subtrees) implemented
+ * with explicit stacks and run in parallel across sibling subtrees.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string_view>
+
+namespace core {
+
+// Progress callback: keys and values processed so far. Called from worker
+// threads, so it must be thread-safe (e.g. post a message to the UI).
+using SubtreeProgressCallback = std::function<void(uint64_t keys, uint64_t values)>;
+
+struct SubtreeOptions {
+    unsigned threadCount = 0;               // 0 = one per hardware thread
+    std::stop_token stopToken;              // Cancellation
+    SubtreeProgressCallback onProgress;
+    uint32_t progressInterval = 4096;       // Keys between progress callbacks
+};
+
+struct SubtreeStats {
+    uint64_t keys = 0;                      // Keys copied / deleted
+    uint64_t values = 0;                    // Values copied
+    uint64_t errors = 0;                    // Keys that could not be opened, created or deleted
+    bool cancelled = false;
+    bool rejected = false;                  // Copy into its own subtree; nothing was written
+};
+
+// Copy all values and subkeys of source into destination (which must exist).
+// Destination must not lie inside the source subtree; keys have no identity
+// to check that here, so within one backend use the path overload below.
+// Keys deeper than MAX_KEY_DEPTH below source are not copied (errors).
+SubtreeStats CopySubtree(const RegistryKey& source, RegistryKey& destination,
+                         const SubtreeOptions& options = {});
+
+// Copy the key at sourcePath to destinationPath (created if missing) in the
+// same backend. Refused up front (rejected) if destination is source or
+// lies inside it, which would keep copying the copy.
+SubtreeStats CopySubtree(RegistryBackend& backend, std::wstring_view sourcePath,
+                         std::wstring_view destinationPath, const SubtreeOptions& options = {});
+
+// True if path names ancestor itself or a key below it (case-insensitive)
+bool IsSameOrBelow(std::wstring_view ancestor, std::wstring_view path);
+
+// Delete parent\name together with all of its subkeys, bottom-up. On
+// cancellation the remaining keys are left intact and still reachable.
+SubtreeStats DeleteSubtree(RegistryKey& parent, std::wstring_view name,
+                           const SubtreeOptions& options = {});
+
+} // namespace core
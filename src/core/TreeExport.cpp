@@ -0,0 +1,799 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * XML and JSON tree export.
+ */
+
+#include "TreeExport.h"
+#include "RegistryTypes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define REGSTUDIO_HAVE_SSE2 1
+#endif
+
+namespace core {
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 256 * 1024;           // Worker output is handed over in chunks of this size
+constexpr size_t SUBTREE_BUFFER_LIMIT = 4 * CHUNK_SIZE;  // Queued bytes per subtree before its worker waits
+constexpr size_t SUBTREES_PER_THREAD = 8;
+constexpr uint32_t MAX_SPLIT_DEPTH = 6;             // Levels the planner may open to find subtrees
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+const char* TypeName(uint32_t type) {
+    switch (type) {
+        case VALUE_NONE: return "REG_NONE";
+        case VALUE_SZ: return "REG_SZ";
+        case VALUE_EXPAND_SZ: return "REG_EXPAND_SZ";
+        case VALUE_BINARY: return "REG_BINARY";
+        case VALUE_DWORD: return "REG_DWORD";
+        case VALUE_DWORD_BIG_ENDIAN: return "REG_DWORD_BIG_ENDIAN";
+        case VALUE_LINK: return "REG_LINK";
+        case VALUE_MULTI_SZ: return "REG_MULTI_SZ";
+        case VALUE_RESOURCE_LIST: return "REG_RESOURCE_LIST";
+        case VALUE_FULL_RESOURCE_DESCRIPTOR: return "REG_FULL_RESOURCE_DESCRIPTOR";
+        case VALUE_RESOURCE_REQUIREMENTS_LIST: return "REG_RESOURCE_REQUIREMENTS_LIST";
+        case VALUE_QWORD: return "REG_QWORD";
+        default: return nullptr;
+    }
+}
+
+void AppendHex(std::string& out, const uint8_t* data, size_t size) {
+    size_t start = out.size();
+    out.resize(start + size * 2);
+    char* p = out.data() + start;
+    for (size_t i = 0; i < size; i++) {
+        *p++ = HEX_DIGITS[data[i] >> 4];
+        *p++ = HEX_DIGITS[data[i] & 0x0F];
+    }
+}
+
+void AppendIndent(std::string& out, uint32_t depth) {
+    out.append(depth * 2, ' ');
+}
+
+void AppendTimestamp(std::string& out, uint64_t fileTime) {
+    using namespace std::chrono;
+    constexpr int64_t UNIX_EPOCH_SECONDS = 11644473600;     // 1601-01-01 to 1970-01-01
+    sys_seconds time{ seconds(static_cast<int64_t>(fileTime / 10000000) - UNIX_EPOCH_SECONDS) };
+    sys_days day = floor<days>(time);
+    year_month_day date{ day };
+    hh_mm_ss clock{ time - day };
+
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "%04d-%02u-%02uT%02d:%02d:%02dZ",
+                               static_cast<int>(date.year()), static_cast<unsigned>(date.month()),
+                               static_cast<unsigned>(date.day()), static_cast<int>(clock.hours().count()),
+                               static_cast<int>(clock.minutes().count()), static_cast<int>(clock.seconds().count()));
+    out.append(text, static_cast<size_t>(length));
+}
+
+// Escape UTF-16 into UTF-8 for the given format. XML 1.0 has no way to
+// write most control characters or unpaired surrogates, so the XML escaper
+// reports failure and the caller falls back to hex; JSON escapes them.
+class Escaper {
+public:
+    explicit Escaper(TreeExportFormat format) : m_json(format == TreeExportFormat::Json) {}
+
+    bool Append(std::string& out, std::wstring_view text) const {
+        return AppendUnits(out, text.size(), [&text](size_t i) { return static_cast<uint16_t>(text[i]); }, nullptr);
+    }
+
+    // UTF-16LE bytes, as stored in value data
+    bool Append(std::string& out, const uint8_t* data, size_t units) const {
+        return AppendUnits(out, units, [data](size_t i) { return static_cast<uint16_t>(data[i * 2] | (data[i * 2 + 1] << 8)); }, data);
+    }
+
+private:
+    template <typename Unit>
+    bool AppendUnits(std::string& out, size_t count, Unit unit, const uint8_t* raw) const {
+        size_t i = 0;
+        while (i < count) {
+#ifdef REGSTUDIO_HAVE_SSE2
+            // Eight units at a time while they are plain printable ASCII
+            if (raw) {
+                const __m128i space = _mm_set1_epi16(0x20);
+                const __m128i tilde = _mm_set1_epi16(0x7E);
+                const __m128i quote = _mm_set1_epi16('"');
+                const __m128i special1 = _mm_set1_epi16(m_json ? '\\' : '&');
+                const __m128i special2 = _mm_set1_epi16(m_json ? '\\' : '<');
+                const __m128i special3 = _mm_set1_epi16(m_json ? '\\' : '>');
+                while (i + 8 <= count) {
+                    __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i * 2));
+                    // Signed compare: units >= 0x8000 are negative and count as below space
+                    __m128i bad = _mm_or_si128(_mm_cmplt_epi16(units, space), _mm_cmpgt_epi16(units, tilde));
+                    bad = _mm_or_si128(bad, _mm_cmpeq_epi16(units, quote));
+                    bad = _mm_or_si128(bad, _mm_cmpeq_epi16(units, special1));
+                    bad = _mm_or_si128(bad, _mm_cmpeq_epi16(units, special2));
+                    bad = _mm_or_si128(bad, _mm_cmpeq_epi16(units, special3));
+                    if (_mm_movemask_epi8(bad) != 0) break;
+
+                    char packed[16];
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(packed), _mm_packus_epi16(units, units));
+                    out.append(packed, 8);
+                    i += 8;
+                }
+                if (i == count) break;
+            }
+#endif
+            uint32_t c = unit(i++);
+            if (c >= 0x20 && c < 0x7F) {
+                if (!AppendAscii(out, static_cast<char>(c))) out.push_back(static_cast<char>(c));
+                continue;
+            }
+
+            // Combine surrogate pairs; a lone surrogate stays as is
+            if (c >= 0xD800 && c <= 0xDBFF && i < count) {
+                uint32_t low = unit(i);
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                    i++;
+                }
+            }
+            if (!AppendSpecial(out, c)) return false;
+        }
+        return true;
+    }
+
+    // Printable ASCII that needs escaping
+    bool AppendAscii(std::string& out, char c) const {
+        if (m_json) {
+            if (c == '"') out += "\\\"";
+            else if (c == '\\') out += "\\\\";
+            else return false;
+            return true;
+        }
+        switch (c) {
+            case '&': out += "&amp;"; return true;
+            case '<': out += "&lt;"; return true;
+            case '>': out += "&gt;"; return true;
+            case '"': out += "&quot;"; return true;
+            default: return false;
+        }
+    }
+
+    bool AppendSpecial(std::string& out, uint32_t c) const {
+        bool lone = c >= 0xD800 && c <= 0xDFFF;
+        if (c < 0x20 || lone) {
+            if (m_json) {
+                char escape[8];
+                switch (c) {
+                    case '\b': out += "\\b"; break;
+                    case '\f': out += "\\f"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                        out += escape;
+                }
+                return true;
+            }
+            // Character references keep tabs and line breaks exact through attribute normalization
+            if (c == '\t') out += "&#9;";
+            else if (c == '\n') out += "&#10;";
+            else if (c == '\r') out += "&#13;";
+            else return false;
+            return true;
+        }
+        if (!m_json && (c == 0xFFFE || c == 0xFFFF)) return false;
+
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+        return true;
+    }
+
+    bool m_json;
+};
+
+// Number of UTF-16 units in a well-formed REG_SZ (one optional trailing NUL,
+// none inside), or -1
+int64_t StringUnits(const std::vector<uint8_t>& data) {
+    if (data.size() % 2) return -1;
+    size_t units = data.size() / 2;
+    if (units > 0 && data[units * 2 - 2] == 0 && data[units * 2 - 1] == 0) units--;
+    for (size_t i = 0; i < units; i++) {
+        if (data[i * 2] == 0 && data[i * 2 + 1] == 0) return -1;
+    }
+    return static_cast<int64_t>(units);
+}
+
+// Element boundaries of a well-formed REG_MULTI_SZ: each string ends with a
+// NUL and the list with an extra NUL (tolerated if missing)
+bool SplitMultiString(const std::vector<uint8_t>& data, std::vector<std::pair<size_t, size_t>>& strings) {
+    strings.clear();
+    if (data.size() % 2) return false;
+    size_t units = data.size() / 2;
+    size_t start = 0;
+    for (size_t i = 0; i < units; i++) {
+        if (data[i * 2] != 0 || data[i * 2 + 1] != 0) continue;
+        if (i == start) return i == units - 1;      // Terminating empty string must be last
+        strings.emplace_back(start, i - start);
+        start = i + 1;
+    }
+    if (start < units) strings.emplace_back(start, units - start);
+    return true;
+}
+
+// Format-specific layout. Every key starts on its own line; the caller
+// tracks whether a key wrote values or children so both the planner and
+// the workers produce the same bytes.
+class Serializer {
+public:
+    explicit Serializer(const TreeExportOptions& options)
+        : m_json(options.format == TreeExportFormat::Json), m_timestamps(options.timestamps), m_escaper(options.format) {}
+
+    void Header(std::string& out, std::wstring_view rootPath) const {
+        if (m_json) {
+            out += "{\"path\":\"";
+            m_escaper.Append(out, rootPath);
+            out += "\",\"key\":";
+        } else {
+            out += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<registry";
+            AppendXmlName(out, rootPath, "path");
+            out += '>';
+        }
+    }
+
+    void Separator(std::string& out) const {
+        if (m_json) out += ',';
+    }
+
+    void Footer(std::string& out) const {
+        out += m_json ? "\n}\n" : "\n</registry>\n";
+    }
+
+    // Returns true if the key has values
+    bool KeyStart(std::string& out, const RegistryKey& key, std::wstring_view name, uint32_t depth, bool first,
+                  std::vector<RegValue>& values) const {
+        KeyInfo info{};
+        if (m_timestamps) key.QueryInfo(info);
+        key.GetValues(values);
+
+        if (m_json) {
+            if (!first) out += ',';
+            out += '\n';
+            AppendIndent(out, depth);
+            out += "{\"name\":\"";
+            m_escaper.Append(out, name);
+            out += '"';
+            if (m_timestamps) {
+                out += ",\"lastWrite\":\"";
+                AppendTimestamp(out, info.lastWriteTime);
+                out += '"';
+            }
+            out += ",\"values\":[";
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i) out += ',';
+                AppendJsonValue(out, values[i]);
+            }
+            out += "],\"keys\":[";
+        } else {
+            out += '\n';
+            AppendIndent(out, depth);
+            out += "<key";
+            AppendXmlName(out, name, "name");
+            if (m_timestamps) {
+                out += " lastWrite=\"";
+                AppendTimestamp(out, info.lastWriteTime);
+                out += '"';
+            }
+            out += '>';
+            for (const RegValue& value : values) {
+                out += '\n';
+                AppendIndent(out, depth + 1);
+                AppendXmlValue(out, value);
+            }
+        }
+        return !values.empty();
+    }
+
+    void KeyEnd(std::string& out, uint32_t depth, bool hasValues, bool hasChildren) const {
+        if (m_json) {
+            if (hasChildren) {
+                out += '\n';
+                AppendIndent(out, depth);
+            }
+            out += "]}";
+            return;
+        }
+        if (hasValues || hasChildren) {
+            out += '\n';
+            AppendIndent(out, depth);
+        }
+        out += "</key>";
+    }
+
+private:
+    // ' name="..."', or ' nameHex="..."' (UTF-16LE) when XML cannot carry it
+    void AppendXmlName(std::string& out, std::wstring_view name, const char* attribute) const {
+        size_t start = out.size();
+        out += ' ';
+        out += attribute;
+        out += "=\"";
+        if (!m_escaper.Append(out, name)) {
+            out.resize(start);
+            out += ' ';
+            out += attribute;
+            out += "Hex=\"";
+            std::vector<uint8_t> bytes = EncodeString(name, false);
+            AppendHex(out, bytes.data(), bytes.size());
+        }
+        out += '"';
+    }
+
+    void AppendXmlValue(std::string& out, const RegValue& value) const {
+        out += "<value";
+        AppendXmlName(out, value.name, "name");
+        AppendType(out, value.type, " type=\"", "\"");
+
+        size_t start = out.size();
+        if (AppendXmlData(out, value)) return;
+        out.resize(start);
+        out += " encoding=\"hex\">";
+        AppendHex(out, value.data.data(), value.data.size());
+        out += "</value>";
+    }
+
+    // Typed data; false if the value has to be written as hex
+    bool AppendXmlData(std::string& out, const RegValue& value) const {
+        switch (value.type) {
+            case VALUE_SZ:
+            case VALUE_EXPAND_SZ:
+            case VALUE_LINK: {
+                int64_t units = StringUnits(value.data);
+                if (units < 0) return false;
+                out += '>';
+                if (!m_escaper.Append(out, value.data.data(), static_cast<size_t>(units))) return false;
+                out += "</value>";
+                return true;
+            }
+            case VALUE_MULTI_SZ: {
+                thread_local std::vector<std::pair<size_t, size_t>> strings;
+                if (!SplitMultiString(value.data, strings)) return false;
+                out += '>';
+                for (auto [first, count] : strings) {
+                    out += "<string>";
+                    if (!m_escaper.Append(out, value.data.data() + first * 2, count)) return false;
+                    out += "</string>";
+                }
+                out += "</value>";
+                return true;
+            }
+            case VALUE_DWORD:
+            case VALUE_DWORD_BIG_ENDIAN:
+            case VALUE_QWORD:
+                if (!AppendNumber(out, value, ">")) return false;
+                out += "</value>";
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void AppendJsonValue(std::string& out, const RegValue& value) const {
+        out += "{\"name\":\"";
+        m_escaper.Append(out, value.name);
+        out += '"';
+        AppendType(out, value.type, ",\"type\":\"", "\"");
+
+        switch (value.type) {
+            case VALUE_SZ:
+            case VALUE_EXPAND_SZ:
+            case VALUE_LINK: {
+                int64_t units = StringUnits(value.data);
+                if (units < 0) break;
+                out += ",\"data\":\"";
+                m_escaper.Append(out, value.data.data(), static_cast<size_t>(units));
+                out += "\"}";
+                return;
+            }
+            case VALUE_MULTI_SZ: {
+                thread_local std::vector<std::pair<size_t, size_t>> strings;
+                if (!SplitMultiString(value.data, strings)) break;
+                out += ",\"data\":[";
+                for (size_t i = 0; i < strings.size(); i++) {
+                    if (i) out += ',';
+                    out += '"';
+                    m_escaper.Append(out, value.data.data() + strings[i].first * 2, strings[i].second);
+                    out += '"';
+                }
+                out += "]}";
+                return;
+            }
+            case VALUE_DWORD:
+            case VALUE_DWORD_BIG_ENDIAN:
+            case VALUE_QWORD:
+                if (!AppendNumber(out, value, ",\"data\":")) break;
+                out += '}';
+                return;
+        }
+        out += ",\"hex\":\"";
+        AppendHex(out, value.data.data(), value.data.size());
+        out += "\"}";
+    }
+
+    // Unknown types are written by number
+    void AppendType(std::string& out, uint32_t type, const char* prefix, const char* suffix) const {
+        out += prefix;
+        if (const char* name = TypeName(type)) {
+            out += name;
+        } else {
+            char number[16];
+            std::snprintf(number, sizeof(number), "%u", type);
+            out += number;
+        }
+        out += suffix;
+    }
+
+    // Decimal, for values of exactly the type's size
+    static bool AppendNumber(std::string& out, const RegValue& value, const char* prefix) {
+        const std::vector<uint8_t>& d = value.data;
+        uint64_t number = 0;
+        if (value.type == VALUE_QWORD) {
+            if (d.size() != 8) return false;
+            for (int i = 7; i >= 0; i--) number = (number << 8) | d[i];
+        } else {
+            if (d.size() != 4) return false;
+            number = value.type == VALUE_DWORD
+                ? (uint32_t(d[0]) | uint32_t(d[1]) << 8 | uint32_t(d[2]) << 16 | uint32_t(d[3]) << 24)
+                : (uint32_t(d[3]) | uint32_t(d[2]) << 8 | uint32_t(d[1]) << 16 | uint32_t(d[0]) << 24);
+        }
+        char text[24];
+        int length = std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(number));
+        out += prefix;
+        out.append(text, static_cast<size_t>(length));
+        return true;
+    }
+
+    bool m_json;
+    bool m_timestamps;
+    Escaper m_escaper;
+};
+
+class TreeExporter {
+public:
+    TreeExporter(const TreeExportOptions& options, std::ostream& output)
+        : m_options(options), m_serializer(options), m_output(output),
+          m_stopForward(options.stopToken, [this] { m_abort.request_stop(); }) {}
+
+    bool Run(const RegistryKey& root, std::wstring_view rootPath, TreeExportStats& stats, std::wstring& error) {
+        auto start = std::chrono::steady_clock::now();
+        unsigned threads = m_options.threadCount ? m_options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+        std::wstring_view rootName = rootPath.substr(rootPath.find_last_of(L'\\') + 1);
+        Plan(root, rootName, threads * SUBTREES_PER_THREAD);
+
+        bool written = false;
+        {
+            std::vector<std::jthread> workers;
+            for (unsigned i = 0; i < std::min<size_t>(threads, m_subtrees.size()); i++) {
+                workers.emplace_back([this] { WorkerLoop(); });
+            }
+            std::string out;
+            m_serializer.Header(out, rootPath);
+            written = !m_abort.stop_requested() && WriteNode(0, true, out) && Flush(out, true);
+            if (written) {
+                m_serializer.Footer(out);
+                written = Flush(out, true);
+            }
+            if (!written) m_abort.request_stop();      // Release workers waiting on full queues
+        }
+
+        stats.keys = m_keys.load();
+        stats.values = m_values.load();
+        stats.bytes = m_bytes;
+        stats.subtrees = static_cast<uint32_t>(m_subtrees.size());
+        stats.cancelled = m_options.stopToken.stop_requested();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!written && !stats.cancelled) error = L"Failed to write the export";
+        return written;
+    }
+
+private:
+    // A key above the split level. Keys on the last planned level keep only
+    // their subkey names, which are divided into subtrees.
+    struct PlanNode {
+        std::shared_ptr<const RegistryKey> key;
+        std::wstring name;
+        uint32_t depth = 0;
+        std::vector<uint32_t> children;     // Planned subkeys, or
+        std::vector<std::wstring> names;    // subkeys left to the workers
+        std::vector<uint32_t> subtrees;     // Ranges of names, in order
+    };
+
+    // A run of sibling subtrees written by one worker and consumed by the
+    // writer in document order
+    struct Subtree {
+        uint32_t node = 0;
+        size_t begin = 0;
+        size_t end = 0;
+        std::mutex mutex;
+        std::condition_variable_any changed;
+        std::deque<std::string> chunks;
+        size_t queued = 0;
+        bool done = false;
+    };
+
+    struct Frame {
+        KeyPtr key;
+        std::vector<std::wstring> children;
+        size_t next = 0;
+        bool hasValues = false;
+        bool hasChildren = false;
+    };
+
+    // Open the top levels breadth-first until a level has enough keys to
+    // keep the workers busy, then split that level into sibling ranges
+    void Plan(const RegistryKey& root, std::wstring_view rootName, size_t target) {
+        PlanNode rootNode;
+        rootNode.key = std::shared_ptr<const RegistryKey>(&root, [](const RegistryKey*) {});
+        rootNode.name = rootName;
+        rootNode.depth = 1;
+        m_plan.push_back(std::move(rootNode));
+
+        std::vector<uint32_t> level{ 0 };
+        for (uint32_t depth = 1; !level.empty() && !m_abort.stop_requested(); depth++) {
+            size_t names = 0;
+            for (uint32_t node : level) {
+                SortedSubKeyNames(*m_plan[node].key, m_plan[node].names);
+                names += m_plan[node].names.size();
+            }
+            if (names >= target || depth == MAX_SPLIT_DEPTH) {
+                SplitLevel(level, names, target);
+                return;
+            }
+
+            std::vector<uint32_t> next;
+            for (uint32_t node : level) {
+                std::vector<std::wstring> childNames = std::move(m_plan[node].names);
+                m_plan[node].names.clear();
+                for (std::wstring& name : childNames) {
+                    KeyPtr child = m_plan[node].key->OpenSubKey(name);
+                    if (!child) continue;
+                    PlanNode childNode;
+                    childNode.key = std::move(child);
+                    childNode.name = std::move(name);
+                    childNode.depth = m_plan[node].depth + 1;
+                    m_plan[node].children.push_back(static_cast<uint32_t>(m_plan.size()));
+                    next.push_back(static_cast<uint32_t>(m_plan.size()));
+                    m_plan.push_back(std::move(childNode));
+                }
+            }
+            level = std::move(next);
+        }
+    }
+
+    void SplitLevel(const std::vector<uint32_t>& level, size_t names, size_t target) {
+        size_t rangeSize = std::max<size_t>(1, (names + target - 1) / target);
+        for (uint32_t node : level) {
+            size_t count = m_plan[node].names.size();
+            for (size_t begin = 0; begin < count; begin += rangeSize) {
+                auto subtree = std::make_unique<Subtree>();
+                subtree->node = node;
+                subtree->begin = begin;
+                subtree->end = std::min(count, begin + rangeSize);
+                m_plan[node].subtrees.push_back(static_cast<uint32_t>(m_subtrees.size()));
+                m_subtrees.push_back(std::move(subtree));
+            }
+        }
+    }
+
+    static void SortedSubKeyNames(const RegistryKey& key, std::vector<std::wstring>& names) {
+        key.GetSubKeyNames(names);
+        std::sort(names.begin(), names.end(),
+            [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; });
+    }
+
+    void WorkerLoop() {
+        size_t index;
+        while ((index = m_nextSubtree.fetch_add(1)) < m_subtrees.size()) {
+            WriteSubtree(*m_subtrees[index]);
+        }
+    }
+
+    // Depth-first serialization of a sibling range into its chunk queue.
+    // Separators between ranges are left to the writer.
+    void WriteSubtree(Subtree& subtree) {
+        const PlanNode& parent = m_plan[subtree.node];
+        std::stop_token stop = m_abort.get_token();
+        std::vector<RegValue> values;
+        std::vector<Frame> stack(1);
+        std::string out;
+        uint64_t keys = 0;
+        uint64_t valueCount = 0;
+
+        Frame& top = stack[0];
+        top.children.assign(parent.names.begin() + subtree.begin, parent.names.begin() + subtree.end);
+        size_t depth = 1;
+        while (depth > 0 && !stop.stop_requested()) {
+            if (stack.size() == depth) stack.emplace_back();
+            Frame& frame = stack[depth - 1];
+            uint32_t keyDepth = parent.depth + static_cast<uint32_t>(depth) - 1;
+            if (frame.next == frame.children.size()) {
+                if (depth > 1) m_serializer.KeyEnd(out, keyDepth, frame.hasValues, frame.hasChildren);
+                frame.key.reset();
+                depth--;
+                continue;
+            }
+
+            const RegistryKey& key = depth == 1 ? *parent.key : *frame.key;
+            const std::wstring& name = frame.children[frame.next++];
+            KeyPtr child = key.OpenSubKey(name);
+            if (!child) continue;
+
+            Frame& childFrame = stack[depth];
+            childFrame.key = std::move(child);
+            childFrame.next = 0;
+            childFrame.hasChildren = false;
+            childFrame.hasValues = m_serializer.KeyStart(out, *childFrame.key, name, keyDepth + 1, !frame.hasChildren, values);
+            frame.hasChildren = true;
+            SortedSubKeyNames(*childFrame.key, childFrame.children);
+            keys++;
+            valueCount += values.size();
+            depth++;
+
+            if (out.size() >= CHUNK_SIZE) Publish(subtree, out, stop);
+        }
+        Publish(subtree, out, stop);
+
+        m_keys.fetch_add(keys, std::memory_order_relaxed);
+        m_values.fetch_add(valueCount, std::memory_order_relaxed);
+        std::lock_guard lock(subtree.mutex);
+        subtree.done = true;
+        subtree.changed.notify_all();
+    }
+
+    // Hand a chunk to the writer, waiting while this subtree already has a full queue
+    void Publish(Subtree& subtree, std::string& out, std::stop_token stop) {
+        if (out.empty()) return;
+        std::unique_lock lock(subtree.mutex);
+        if (!subtree.changed.wait(lock, stop, [&] { return subtree.queued < SUBTREE_BUFFER_LIMIT; })) return;
+        subtree.queued += out.size();
+        subtree.chunks.push_back(std::move(out));
+        subtree.changed.notify_all();
+        out = std::string();
+        out.reserve(CHUNK_SIZE + CHUNK_SIZE / 4);
+    }
+
+    // Writer: the planned levels, with each subtree's chunks spliced in turn
+    bool WriteNode(uint32_t index, bool first, std::string& out) {
+        const PlanNode& node = m_plan[index];
+        thread_local std::vector<RegValue> values;
+        bool hasValues = m_serializer.KeyStart(out, *node.key, node.name, node.depth, first, values);
+        m_keys.fetch_add(1, std::memory_order_relaxed);
+        m_values.fetch_add(values.size(), std::memory_order_relaxed);
+
+        bool hasChildren = false;
+        for (uint32_t child : node.children) {
+            if (!WriteNode(child, !hasChildren, out)) return false;
+            hasChildren = true;
+        }
+        for (uint32_t subtree : node.subtrees) {
+            if (!Flush(out, true) || !Drain(*m_subtrees[subtree], hasChildren)) return false;
+        }
+        m_serializer.KeyEnd(out, node.depth, hasValues, hasChildren);
+        return Flush(out, false);
+    }
+
+    bool Drain(Subtree& subtree, bool& hasChildren) {
+        std::stop_token stop = m_abort.get_token();
+        bool started = false;
+        while (true) {
+            std::string chunk;
+            {
+                std::unique_lock lock(subtree.mutex);
+                if (!subtree.changed.wait(lock, stop, [&] { return !subtree.chunks.empty() || subtree.done; })) return false;
+                if (subtree.chunks.empty()) return !stop.stop_requested();
+                chunk = std::move(subtree.chunks.front());
+                subtree.chunks.pop_front();
+                subtree.queued -= chunk.size();
+                subtree.changed.notify_all();
+            }
+            // The worker wrote its first key without a separator
+            if (!started) {
+                started = true;
+                if (hasChildren && !WriteSeparator()) return false;
+                hasChildren = true;
+            }
+            if (!Write(chunk)) return false;
+        }
+    }
+
+    bool WriteSeparator() {
+        std::string separator;
+        m_serializer.Separator(separator);
+        return separator.empty() || Write(separator);
+    }
+
+    bool Flush(std::string& out, bool force) {
+        if (out.empty() || (!force && out.size() < CHUNK_SIZE)) return true;
+        bool ok = Write(out);
+        out.clear();
+        return ok;
+    }
+
+    bool Write(const std::string& bytes) {
+        if (m_abort.stop_requested()) return false;
+        m_output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        m_bytes += bytes.size();
+        return m_output.good();
+    }
+
+    const TreeExportOptions& m_options;
+    Serializer m_serializer;
+    std::ostream& m_output;
+    std::stop_source m_abort;
+    std::stop_callback<std::function<void()>> m_stopForward;
+
+    std::vector<PlanNode> m_plan;
+    std::vector<std::unique_ptr<Subtree>> m_subtrees;
+    std::atomic<size_t> m_nextSubtree{0};
+
+    std::atomic<uint64_t> m_keys{0};
+    std::atomic<uint64_t> m_values{0};
+    uint64_t m_bytes = 0;
+};
+
+} // namespace
+
+bool ExportTree(const RegistryKey& key, std::wstring_view rootPath, std::ostream& output,
+                const TreeExportOptions& options, TreeExportStats& stats, std::wstring& error) {
+    stats = {};
+    error.clear();
+    TreeExporter exporter(options, output);
+    return exporter.Run(key, rootPath, stats, error);
+}
+
+bool ExportTree(const RegistryKey& key, std::wstring_view rootPath, const std::filesystem::path& destination,
+                const TreeExportOptions& options, TreeExportStats& stats, std::wstring& error) {
+    bool written = false;
+    {
+        std::ofstream file(destination, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            error = L"Cannot create the export file";
+            return false;
+        }
+        written = ExportTree(key, rootPath, file, options, stats, error);
+        file.close();
+        written = written && !file.fail();
+    }
+    if (written) return true;
+
+    std::error_code ignored;
+    std::filesystem::remove(destination, ignored);
+    return false;
+}
+
+} // namespace core
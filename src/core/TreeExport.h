@@ -0,0 +1,57 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * XML and JSON export of a key tree, with value types and last-write
+ * times. Disjoint subtrees are serialized by worker threads into bounded
+ * chunk queues and written in canonical order (subkeys sorted, values in
+ * backend order), so the output is byte-identical for any thread count.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace core {
+
+enum class TreeExportFormat {
+    Xml,
+    Json
+};
+
+struct TreeExportOptions {
+    TreeExportFormat format = TreeExportFormat::Xml;
+    bool timestamps = true;         // Write each key's last-write time
+    unsigned threadCount = 0;       // 0 = one per hardware thread
+    std::stop_token stopToken;
+};
+
+struct TreeExportStats {
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    uint64_t bytes = 0;
+    uint32_t subtrees = 0;          // Subtrees handed to workers
+    double seconds = 0;
+    bool cancelled = false;
+};
+
+// Write key and everything below it as UTF-8 XML or JSON. rootPath (e.g.
+// "HKEY_LOCAL_MACHINE\SOFTWARE") is recorded in the document and its last
+// component names the root key. Strings that the format cannot carry
+// (odd-sized data, embedded NULs, control characters in XML) are written
+// as hex. Keys that cannot be opened are left out.
+bool ExportTree(const RegistryKey& key, std::wstring_view rootPath, std::ostream& output,
+                const TreeExportOptions& options, TreeExportStats& stats, std::wstring& error);
+
+// As above, into a file that is removed again on failure or cancellation
+bool ExportTree(const RegistryKey& key, std::wstring_view rootPath, const std::filesystem::path& destination,
+                const TreeExportOptions& options, TreeExportStats& stats, std::wstring& error);
+
+} // namespace core
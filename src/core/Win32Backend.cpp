@@ -0,0 +1,249 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Live registry backend on top of the Win32 registry API.
+ */
+
+#ifdef _WIN32
+
+#include "Win32Backend.h"
+
+#include <iterator>
+#include <utility>
+
+namespace core {
+
+namespace {
+
+struct HiveName {
+    const wchar_t* name;
+    const wchar_t* abbreviation;
+    HKEY hKey;
+};
+
+const HiveName HIVES[] = {
+    { L"HKEY_CLASSES_ROOT", L"HKCR", HKEY_CLASSES_ROOT },
+    { L"HKEY_CURRENT_USER", L"HKCU", HKEY_CURRENT_USER },
+    { L"HKEY_LOCAL_MACHINE", L"HKLM", HKEY_LOCAL_MACHINE },
+    { L"HKEY_USERS", L"HKU", HKEY_USERS },
+    { L"HKEY_CURRENT_CONFIG", L"HKCC", HKEY_CURRENT_CONFIG }
+};
+
+constexpr DWORD MAX_VALUE_NAME = 16383;
+
+class Win32Key : public RegistryKey {
+public:
+    Win32Key(HKEY hKey, bool owned, REGSAM access) : m_hKey(hKey), m_owned(owned), m_access(access) {}
+
+    ~Win32Key() override {
+        if (m_owned) RegCloseKey(m_hKey);
+    }
+
+    bool QueryInfo(KeyInfo& info) const override {
+        DWORD subKeys = 0;
+        DWORD values = 0;
+        FILETIME lastWrite{};
+        if (RegQueryInfoKeyW(m_hKey, nullptr, nullptr, nullptr, &subKeys, nullptr, nullptr,
+                             &values, nullptr, nullptr, nullptr, &lastWrite) != ERROR_SUCCESS) {
+            return false;
+        }
+        info.subKeyCount = subKeys;
+        info.valueCount = values;
+        info.lastWriteTime = (static_cast<uint64_t>(lastWrite.dwHighDateTime) << 32) | lastWrite.dwLowDateTime;
+        return true;
+    }
+
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override {
+        wchar_t keyName[MAX_KEY_NAME + 1];
+        DWORD keyNameLen = MAX_KEY_NAME + 1;
+        if (RegEnumKeyExW(m_hKey, index, keyName, &keyNameLen, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS) {
+            return false;
+        }
+        name.assign(keyName, keyNameLen);
+        return true;
+    }
+
+    bool EnumValue(uint32_t index, RegValue& value) const override {
+        std::wstring valueName(MAX_VALUE_NAME + 1, L'\0');
+        DWORD dataSize = static_cast<DWORD>(value.data.capacity());
+        value.data.resize(dataSize);
+
+        while (true) {
+            DWORD valueNameLen = MAX_VALUE_NAME + 1;
+            DWORD dwType = REG_NONE;
+            LONG result = RegEnumValueW(m_hKey, index, valueName.data(), &valueNameLen, nullptr, &dwType,
+                                        value.data.empty() ? nullptr : value.data.data(), &dataSize);
+            if (result == ERROR_MORE_DATA || (result == ERROR_SUCCESS && value.data.empty() && dataSize > 0)) {
+                value.data.resize(dataSize);
+                continue;
+            }
+            if (result != ERROR_SUCCESS) return false;
+
+            valueName.resize(valueNameLen);
+            value.name = std::move(valueName);
+            value.type = dwType;
+            value.data.resize(dataSize);
+            return true;
+        }
+    }
+
+    bool GetValue(std::wstring_view name, RegValue& value) const override {
+        std::wstring valueName(name);
+        DWORD dwType = REG_NONE;
+        DWORD dataSize = 0;
+        LONG result = RegQueryValueExW(m_hKey, valueName.c_str(), nullptr, &dwType, nullptr, &dataSize);
+        while (result == ERROR_SUCCESS || result == ERROR_MORE_DATA) {
+            value.data.resize(dataSize);
+            result = RegQueryValueExW(m_hKey, valueName.c_str(), nullptr, &dwType,
+                                      value.data.empty() ? nullptr : value.data.data(), &dataSize);
+            if (result == ERROR_SUCCESS) {
+                value.data.resize(dataSize);
+                value.name = std::move(valueName);
+                value.type = dwType;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void GetValueSummaries(std::vector<ValueSummary>& values) const override {
+        // Sizes only: passing no data buffer avoids copying the data
+        values.clear();
+        std::wstring valueName(MAX_VALUE_NAME + 1, L'\0');
+        for (DWORD index = 0;; index++) {
+            DWORD valueNameLen = MAX_VALUE_NAME + 1;
+            DWORD dwType = REG_NONE;
+            DWORD dataSize = 0;
+            if (RegEnumValueW(m_hKey, index, valueName.data(), &valueNameLen, nullptr, &dwType,
+                              nullptr, &dataSize) != ERROR_SUCCESS) {
+                break;
+            }
+            values.push_back({ valueName.substr(0, valueNameLen), dwType, dataSize });
+        }
+    }
+
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        std::wstring subKeyPath(path);
+        HKEY hSubKey = nullptr;
+        if (RegOpenKeyExW(m_hKey, subKeyPath.c_str(), 0, m_access, &hSubKey) != ERROR_SUCCESS) {
+            return nullptr;
+        }
+        return std::make_unique<Win32Key>(hSubKey, true, m_access);
+    }
+
+    KeyPtr CreateSubKey(std::wstring_view path) override {
+        std::wstring subKeyPath(path);
+        HKEY hSubKey = nullptr;
+        if (RegCreateKeyExW(m_hKey, subKeyPath.c_str(), 0, nullptr, REG_OPTION_NON_VOLATILE,
+                            m_access, nullptr, &hSubKey, nullptr) != ERROR_SUCCESS) {
+            return nullptr;
+        }
+        return std::make_unique<Win32Key>(hSubKey, true, m_access);
+    }
+
+    bool SetValue(const RegValue& value) override {
+        return RegSetValueExW(m_hKey, value.name.c_str(), 0, value.type,
+                              value.data.empty() ? nullptr : value.data.data(),
+                              static_cast<DWORD>(value.data.size())) == ERROR_SUCCESS;
+    }
+
+    bool DeleteValue(std::wstring_view name) override {
+        std::wstring valueName(name);
+        return RegDeleteValueW(m_hKey, valueName.c_str()) == ERROR_SUCCESS;
+    }
+
+    bool DeleteSubKey(std::wstring_view name) override {
+        // RegDeleteKeyW refuses keys that still have subkeys
+        std::wstring subKeyName(name);
+        return RegDeleteKeyW(m_hKey, subKeyName.c_str()) == ERROR_SUCCESS;
+    }
+
+private:
+    HKEY m_hKey;
+    bool m_owned;
+    REGSAM m_access;
+};
+
+// Virtual root listing the predefined hives
+class Win32RootKey : public RegistryKey {
+public:
+    explicit Win32RootKey(Win32Backend& backend) : m_backend(backend) {}
+
+    bool QueryInfo(KeyInfo& info) const override {
+        info.subKeyCount = static_cast<uint32_t>(std::size(HIVES));
+        info.valueCount = 0;
+        info.lastWriteTime = 0;
+        return true;
+    }
+
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override {
+        if (index >= std::size(HIVES)) return false;
+        name = HIVES[index].name;
+        return true;
+    }
+
+    bool EnumValue([[maybe_unused]] uint32_t index, [[maybe_unused]] RegValue& value) const override {
+        return false;
+    }
+
+    bool GetValue([[maybe_unused]] std::wstring_view name, [[maybe_unused]] RegValue& value) const override {
+        return false;
+    }
+
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        auto [hive, rest] = SplitHive(path);
+        return hive ? m_backend.OpenKey(hive, rest) : nullptr;
+    }
+
+    KeyPtr CreateSubKey(std::wstring_view path) override {
+        auto [hive, rest] = SplitHive(path);
+        if (!hive) return nullptr;
+        KeyPtr hiveKey = m_backend.OpenKey(hive, L"");
+        return rest.empty() ? std::move(hiveKey) : hiveKey->CreateSubKey(rest);
+    }
+
+private:
+    static std::pair<HKEY, std::wstring_view> SplitHive(std::wstring_view path) {
+        while (!path.empty() && path.front() == L'\\') path.remove_prefix(1);
+        size_t separator = path.find(L'\\');
+        std::wstring_view hiveName = path.substr(0, separator);
+        std::wstring_view rest = (separator == std::wstring_view::npos) ? std::wstring_view() : path.substr(separator + 1);
+        return { Win32Backend::ParseHiveName(hiveName), rest };
+    }
+
+    Win32Backend& m_backend;
+};
+
+} // namespace
+
+Win32Backend::Win32Backend(bool writable) : m_writable(writable) {}
+
+KeyPtr Win32Backend::OpenRoot() {
+    return std::make_unique<Win32RootKey>(*this);
+}
+
+KeyPtr Win32Backend::OpenKey(HKEY hRootKey, std::wstring_view subKeyPath) {
+    REGSAM access = KEY_READ | (m_writable ? (KEY_WRITE | DELETE) : 0);
+    if (SplitPath(subKeyPath).empty()) {
+        return std::make_unique<Win32Key>(hRootKey, false, access);
+    }
+
+    std::wstring path(subKeyPath);
+    HKEY hKey = nullptr;
+    if (RegOpenKeyExW(hRootKey, path.c_str(), 0, access, &hKey) != ERROR_SUCCESS) {
+        return nullptr;
+    }
+    return std::make_unique<Win32Key>(hKey, true, access);
+}
+
+HKEY Win32Backend::ParseHiveName(std::wstring_view name) {
+    for (const HiveName& hive : HIVES) {
+        if (NamesEqual(name, hive.name) || NamesEqual(name, hive.abbreviation)) return hive.hKey;
+    }
+    return nullptr;
+}
+
+} // namespace core
+
+#endif // _WIN32
@@ -0,0 +1,39 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Live registry backend on top of the Win32 registry API.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+
+#include "RegistryBackend.h"
+
+#include <windows.h>
+
+namespace core {
+
+class Win32Backend : public RegistryBackend {
+public:
+    explicit Win32Backend(bool writable = false);
+
+    // Virtual root whose subkeys are the predefined hives (HKEY_LOCAL_MACHINE,
+    // ...). Abbreviations such as HKLM are accepted when opening paths.
+    KeyPtr OpenRoot() override;
+    bool IsReadOnly() const override { return !m_writable; }
+
+    using RegistryBackend::OpenKey;
+    KeyPtr OpenKey(HKEY hRootKey, std::wstring_view subKeyPath);
+
+    // Map a hive name or abbreviation to its predefined handle (nullptr if unknown)
+    static HKEY ParseHiveName(std::wstring_view name);
+
+private:
+    bool m_writable;
+};
+
+} // namespace core
+
+#endif // _WIN32
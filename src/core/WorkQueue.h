@@ -0,0 +1,130 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Parallel explicit-stack work queue for tree traversals. Each worker keeps
+ * a private LIFO stack (depth-first, cache friendly) and only hands the
+ * oldest, shallowest items to the shared stack when another worker is idle.
+ * No recursion is involved, so tree depth is bounded only by memory.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+template <typename Item>
+class WorkQueue {
+public:
+    WorkQueue(unsigned threadCount, std::stop_token stopToken)
+        : m_threadCount(threadCount ? threadCount : DefaultThreadCount()),
+          m_stopToken(std::move(stopToken)) {}
+
+    static unsigned DefaultThreadCount() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count ? count : 1;
+    }
+
+    // Seed the queue before calling Run()
+    void Push(Item item) {
+        m_shared.push_back(std::move(item));
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Run until all items (and the items they spawn) are processed or the
+    // stop token fires. process(Item&, std::vector<Item>& out, unsigned worker)
+    // appends child items to out; worker is in [0, ThreadCount()). The
+    // calling thread acts as worker 0.
+    template <typename Process>
+    void Run(Process process) {
+        if (m_pending.load() == 0) return;
+
+        std::vector<std::jthread> workers;
+        for (unsigned i = 1; i < m_threadCount; i++) {
+            workers.emplace_back([this, &process, i] { WorkerLoop(process, i); });
+        }
+        WorkerLoop(process, 0);
+    }
+
+    unsigned ThreadCount() const { return m_threadCount; }
+    bool Cancelled() const { return m_stopToken.stop_requested(); }
+
+private:
+    template <typename Process>
+    void WorkerLoop(Process& process, unsigned worker) {
+        std::vector<Item> local;
+        while (true) {
+            if (local.empty() && !TakeShared(local)) return;
+
+            Item item = std::move(local.back());
+            local.pop_back();
+
+            if (m_stopToken.stop_requested()) {
+                // Drop everything we hold; the queue drains without processing
+                Complete(local.size() + 1);
+                local.clear();
+                continue;
+            }
+
+            size_t before = local.size();
+            process(item, local, worker);
+            size_t spawned = local.size() - before;
+            if (spawned) m_pending.fetch_add(spawned, std::memory_order_relaxed);
+            Complete(1);
+
+            if (local.size() > 1 && m_idle.load(std::memory_order_relaxed) > 0) {
+                ShareHalf(local);
+            }
+        }
+    }
+
+    bool TakeShared(std::vector<Item>& local) {
+        std::unique_lock lock(m_mutex);
+        m_idle.fetch_add(1, std::memory_order_relaxed);
+        m_wakeup.wait(lock, [this] { return !m_shared.empty() || m_pending.load() == 0; });
+        m_idle.fetch_sub(1, std::memory_order_relaxed);
+        if (m_shared.empty()) return false;
+        local.push_back(std::move(m_shared.back()));
+        m_shared.pop_back();
+        return true;
+    }
+
+    // Move the bottom half of a local stack (the largest remaining subtrees)
+    void ShareHalf(std::vector<Item>& local) {
+        size_t count = local.size() / 2;
+        {
+            std::lock_guard lock(m_mutex);
+            for (size_t i = 0; i < count; i++) {
+                m_shared.push_back(std::move(local[i]));
+            }
+        }
+        local.erase(local.begin(), local.begin() + count);
+        m_wakeup.notify_all();
+    }
+
+    void Complete(size_t count) {
+        if (m_pending.fetch_sub(count) == count) {
+            // Last item done: wake idle workers so they can exit. Taking the
+            // lock orders this against a worker about to start waiting.
+            std::lock_guard lock(m_mutex);
+            m_wakeup.notify_all();
+        }
+    }
+
+    unsigned m_threadCount;
+    std::stop_token m_stopToken;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::vector<Item> m_shared;
+    std::atomic<size_t> m_pending{0};     // Items queued or being processed
+    std::atomic<unsigned> m_idle{0};      // Workers waiting on m_wakeup
+};
+
+} // namespace core
@@ -10,9 +10,23 @@
 #include <dwmapi.h>
 #include <shellapi.h>
 #include <uxtheme.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "core/ComIndex.h"
+#include "core/HexDocument.h"
+#include "core/PathCompleter.h"
+#include "core/StringResolver.h"
+#include "core/SubtreeOps.h"
+#include "core/Win32Backend.h"
+
 // Forward declarations
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 void ApplyDarkTitleBar(HWND hwnd);
@@ -25,6 +39,7 @@ void PopulateSubKeys(HWND hwndTree, HTREEITEM hParent, HKEY hParentKey, const st
 void PopulateValues(HKEY hKey, const std::wstring& subKeyPath);
 std::wstring GetRegistryTypeName(DWORD dwType);
 std::wstring FormatRegistryData(DWORD dwType, const BYTE* data, DWORD dataSize);
+std::wstring GetResolvableText(DWORD dwType, const BYTE* data, DWORD dataSize);
 void InitializeImageLists();
 void ReinitializeImageLists(int dpi);
 int GetValueTypeIconIndex(DWORD dwType);
@@ -33,6 +48,15 @@ std::wstring GetItemPath(HWND hwndTree, HTREEITEM hItem, HKEY& hRootKey);
 void RefreshCurrentView();
 void ShowTreeViewContextMenu(HWND hwnd, int x, int y);
 void ShowListViewContextMenu(HWND hwnd, int x, int y);
+void DeleteSelectedKey(HWND hwnd);
+std::wstring GetItemFullPath(HWND hwndTree, HTREEITEM hItem);
+void SetAddressBarText(const std::wstring& text);
+void OnAddressBarChanged();
+void CompleteAddressBar();
+void NavigateToPath(HWND hwnd, const std::wstring& text);
+LRESULT CALLBACK AddressBarProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam, UINT_PTR idSubclass, DWORD_PTR refData);
+void StartComIndexLoad(HWND hwnd);
+std::wstring DescribeGuid(std::wstring_view text);
 
 // Application constants
 constexpr const wchar_t* APP_CLASS_NAME = L"RegStudioMainWindow";
@@ -44,6 +68,7 @@ constexpr int DEFAULT_HEIGHT = 768;
 constexpr int SPLITTER_WIDTH = 4;           // Width of the splitter bar
 constexpr int MIN_PANE_WIDTH = 100;         // Minimum width for each pane
 constexpr double DEFAULT_SPLIT_RATIO = 0.3; // 30% left pane by default
+constexpr int ADDRESS_BAR_HEIGHT = 24;      // Height of the address bar above the panes
 
 // Menu IDs
 constexpr UINT IDM_FILE_EXIT = 1001;
@@ -51,6 +76,7 @@ constexpr UINT IDM_EDIT_FIND = 2001;
 constexpr UINT IDM_EDIT_COPY = 2002;
 constexpr UINT IDM_EDIT_PASTE = 2003;
 constexpr UINT IDM_VIEW_REFRESH = 3001;
+constexpr UINT IDM_VIEW_ADDRESS_BAR = 3002;
 constexpr UINT IDM_HELP_ABOUT = 4001;
 
 // Context Menu IDs - TreeView (Keys)
@@ -74,6 +100,12 @@ constexpr UINT IDM_VALUE_COPY_DATA = 6008;
 constexpr UINT IDC_LEFT_PANE = 101;
 constexpr UINT IDC_RIGHT_PANE = 102;
 constexpr UINT IDC_STATUS_BAR = 103;
+constexpr UINT IDC_ADDRESS_BAR = 104;
+
+// Application messages
+constexpr UINT WM_APP_COM_INDEX_READY = WM_APP + 1;
+constexpr UINT WM_APP_STRINGS_RESOLVED = WM_APP + 2;
+constexpr UINT WM_APP_PATHS_READY = WM_APP + 3;
 
 // Icon resource IDs (from resource.rc)
 constexpr UINT IDI_STRING = 2;
@@ -92,6 +124,7 @@ struct RegistryValueInfo {
     std::wstring name;
     std::wstring typeName;
     std::wstring data;
+    std::wstring rawText;   // String data shown resolved once g_stringCache has it; empty if none
     DWORD type;
     int iconIndex;
 };
@@ -103,6 +136,16 @@ HWND g_hwndRightPane = nullptr;  // Right pane (ListView)
 HIMAGELIST g_hTreeImageList = nullptr;  // TreeView icons
 HIMAGELIST g_hListImageList = nullptr;  // ListView icons
 HWND g_hwndStatusBar = nullptr;         // Status bar
+HWND g_hwndAddressBar = nullptr;        // Address bar (path entry)
+bool g_addressUpdating = false;         // Address bar text is being set programmatically
+bool g_addressErased = false;           // Last edit removed text: don't auto-complete
+bool g_addressPending = false;          // Completion waits for subkeys read in the background
+core::Win32Backend g_registry;          // Read-only registry access for navigation
+core::PathCompleter g_pathCompleter(g_registry);  // Address bar completion cache
+std::atomic<std::shared_ptr<const core::ComIndex>> g_comIndex;  // GUID names, published once loaded
+std::jthread g_comIndexThread;          // Loads or builds g_comIndex
+core::NativeStringSource g_stringSource;  // Environment and resource DLLs for display strings
+core::StringResolveCache g_stringCache(g_stringSource);  // Expanded and indirect string values
 double g_splitRatio = DEFAULT_SPLIT_RATIO;  // Stored pane ratio
 bool g_isDragging = false;       // Splitter drag state
 std::vector<RegistryValueInfo> g_valueCache;  // Virtual ListView cache
@@ -164,6 +207,9 @@ int WINAPI wWinMain(
     ApplyDarkTitleBar(hwnd);
     CreateMainMenu(hwnd);
     CreateChildPanes(hwnd);
+    StartComIndexLoad(hwnd);
+    g_stringCache.SetReadyCallback([hwnd]() { PostMessageW(hwnd, WM_APP_STRINGS_RESOLVED, 0, 0); });
+    g_pathCompleter.SetReadyCallback([hwnd]() { PostMessageW(hwnd, WM_APP_PATHS_READY, 0, 0); });
 
     // Show the window
     ShowWindow(hwnd, nCmdShow);
@@ -172,7 +218,8 @@ int WINAPI wWinMain(
     // Create keyboard accelerator table
     ACCEL accels[] = {
         { FVIRTKEY, VK_F5, IDM_VIEW_REFRESH },
-        { FVIRTKEY | FCONTROL, 'F', IDM_EDIT_FIND }
+        { FVIRTKEY | FCONTROL, 'F', IDM_EDIT_FIND },
+        { FVIRTKEY | FCONTROL, 'L', IDM_VIEW_ADDRESS_BAR }
     };
     HACCEL hAccel = CreateAcceleratorTableW(accels, sizeof(accels) / sizeof(accels[0]));
 
@@ -214,6 +261,7 @@ void CreateMainMenu(HWND hwnd) {
     
     // View menu
     HMENU hViewMenu = CreatePopupMenu();
+    AppendMenuW(hViewMenu, MF_STRING, IDM_VIEW_ADDRESS_BAR, L"Go to &Address\tCtrl+L");
     AppendMenuW(hViewMenu, MF_STRING, IDM_VIEW_REFRESH, L"&Refresh\tF5");
     AppendMenuW(hMenuBar, MF_POPUP, reinterpret_cast<UINT_PTR>(hViewMenu), L"&View");
     
@@ -229,6 +277,22 @@ void CreateChildPanes(HWND hwnd) {
     // Initialize icon ImageLists
     InitializeImageLists();
 
+    // Create address bar - Edit control for direct path entry
+    g_hwndAddressBar = CreateWindowExW(
+        WS_EX_CLIENTEDGE,
+        WC_EDITW,
+        nullptr,
+        WS_CHILD | WS_VISIBLE | WS_TABSTOP | ES_AUTOHSCROLL,
+        0, 0, 100, ADDRESS_BAR_HEIGHT,
+        hwnd,
+        reinterpret_cast<HMENU>(IDC_ADDRESS_BAR),
+        g_hInstance,
+        nullptr
+    );
+    SendMessageW(g_hwndAddressBar, WM_SETFONT, reinterpret_cast<WPARAM>(GetStockObject(DEFAULT_GUI_FONT)), FALSE);
+    SendMessageW(g_hwndAddressBar, EM_SETCUEBANNER, FALSE, reinterpret_cast<LPARAM>(L"Type or paste a key path"));
+    SetWindowSubclass(g_hwndAddressBar, AddressBarProc, 0, 0);
+
     // Create left pane - TreeView for registry keys
     g_hwndLeftPane = CreateWindowExW(
         WS_EX_CLIENTEDGE,
@@ -457,6 +521,9 @@ void RefreshCurrentView() {
     
     HTREEITEM hSelected = TreeView_GetSelection(g_hwndLeftPane);
     if (!hSelected) return;
+
+    // Completion lists may be stale after external changes
+    g_pathCompleter.Invalidate();
     
     // Get the current key path
     HKEY hRootKey = nullptr;
@@ -533,6 +600,105 @@ void ShowListViewContextMenu(HWND hwnd, int x, int y) {
     DestroyMenu(hMenu);
 }
 
+// A key deletion running on a worker thread, watched by its progress dialog
+struct DeleteProgress {
+    std::stop_source stop;
+    std::atomic<uint64_t> keys{0};
+    std::future<core::SubtreeStats> result;
+};
+
+HRESULT CALLBACK DeleteProgressCallback(HWND hwnd, UINT notification, WPARAM wParam, LPARAM, LONG_PTR data) {
+    DeleteProgress& progress = *reinterpret_cast<DeleteProgress*>(data);
+    switch (notification) {
+        case TDN_CREATED:
+            SendMessageW(hwnd, TDM_SET_PROGRESS_BAR_MARQUEE, TRUE, 0);
+            break;
+        case TDN_TIMER:
+            if (progress.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                SendMessageW(hwnd, TDM_CLICK_BUTTON, IDCANCEL, 0);
+            } else {
+                std::wstring text = std::to_wstring(progress.keys.load()) + L" keys deleted";
+                SendMessageW(hwnd, TDM_SET_ELEMENT_TEXT, TDE_CONTENT, reinterpret_cast<LPARAM>(text.c_str()));
+            }
+            break;
+        case TDN_BUTTON_CLICKED:
+            // Also sent when the timer closes the dialog; stopping a finished deletion is harmless
+            if (wParam == IDCANCEL) progress.stop.request_stop();
+            break;
+    }
+    return S_OK;
+}
+
+// Delete the selected key and all of its subkeys (after confirmation). The
+// deletion runs on a worker thread; a dialog with a Cancel button shows its
+// progress if it takes more than a moment.
+void DeleteSelectedKey(HWND hwnd) {
+    HTREEITEM hSelected = TreeView_GetSelection(g_hwndLeftPane);
+    if (!hSelected) return;
+
+    HTREEITEM hParentItem = TreeView_GetParent(g_hwndLeftPane, hSelected);
+    if (!hParentItem) {
+        MessageBoxW(hwnd, L"Root hives cannot be deleted.", APP_TITLE, MB_OK | MB_ICONWARNING);
+        return;
+    }
+
+    HKEY hRootKey = nullptr;
+    std::wstring subKeyPath = GetItemPath(g_hwndLeftPane, hSelected, hRootKey);
+    size_t separator = subKeyPath.rfind(L'\\');
+    std::wstring parentPath = (separator == std::wstring::npos) ? L"" : subKeyPath.substr(0, separator);
+    std::wstring keyName = (separator == std::wstring::npos) ? subKeyPath : subKeyPath.substr(separator + 1);
+
+    std::wstring prompt = L"Are you sure you want to permanently delete this key and all of its subkeys?\n\n" + keyName;
+    if (MessageBoxW(hwnd, prompt.c_str(), L"Confirm Key Delete", MB_YESNO | MB_ICONWARNING | MB_DEFBUTTON2) != IDYES) {
+        return;
+    }
+
+    core::Win32Backend backend(true);
+    core::KeyPtr parentKey = backend.OpenKey(hRootKey, parentPath);
+    if (!parentKey) {
+        MessageBoxW(hwnd, L"Unable to open the parent key for writing.", APP_TITLE, MB_OK | MB_ICONERROR);
+        return;
+    }
+
+    DeleteProgress progress;
+    core::SubtreeOptions options;
+    options.stopToken = progress.stop.get_token();
+    options.onProgress = [&progress](uint64_t keys, uint64_t) { progress.keys.store(keys); };
+    options.progressInterval = 256;
+    progress.result = std::async(std::launch::async, [&parentKey, &keyName, &options] {
+        return core::DeleteSubtree(*parentKey, keyName, options);
+    });
+
+    if (progress.result.wait_for(std::chrono::milliseconds(300)) != std::future_status::ready) {
+        std::wstring title = L"Deleting " + keyName;
+        TASKDIALOGCONFIG config{};
+        config.cbSize = sizeof(config);
+        config.hwndParent = hwnd;
+        config.dwFlags = TDF_SHOW_MARQUEE_PROGRESS_BAR | TDF_CALLBACK_TIMER | TDF_ALLOW_DIALOG_CANCELLATION;
+        config.dwCommonButtons = TDCBF_CANCEL_BUTTON;
+        config.pszWindowTitle = APP_TITLE;
+        config.pszMainInstruction = title.c_str();
+        config.pszContent = L"0 keys deleted";
+        config.pfCallback = DeleteProgressCallback;
+        config.lpCallbackData = reinterpret_cast<LONG_PTR>(&progress);
+        TaskDialogIndirect(&config, nullptr, nullptr, nullptr);
+    }
+    core::SubtreeStats stats = progress.result.get();
+
+    // A deletion cancelled at the last moment may still have finished
+    bool deleted = stats.errors == 0 && (!stats.cancelled || !parentKey->OpenSubKey(keyName));
+    if (!deleted) {
+        // Partially deleted: drop the stale children so they reload on expand
+        TreeView_Expand(g_hwndLeftPane, hSelected, TVE_COLLAPSE | TVE_COLLAPSERESET);
+        if (stats.errors > 0) {
+            MessageBoxW(hwnd, L"Some subkeys could not be deleted.", APP_TITLE, MB_OK | MB_ICONERROR);
+        }
+        return;
+    }
+
+    TreeView_SelectItem(g_hwndLeftPane, hParentItem);
+    TreeView_DeleteItem(g_hwndLeftPane, hSelected);
+}
 
 // Get the full registry path for a TreeView item
 std::wstring GetItemPath(HWND hwndTree, HTREEITEM hItem, HKEY& hRootKey) {
@@ -567,6 +733,179 @@ std::wstring GetItemPath(HWND hwndTree, HTREEITEM hItem, HKEY& hRootKey) {
     return path;
 }
 
+// Get the full display path for a TreeView item (hive name included)
+std::wstring GetItemFullPath(HWND hwndTree, HTREEITEM hItem) {
+    HKEY hRootKey = nullptr;
+    std::wstring subKeyPath = GetItemPath(hwndTree, hItem, hRootKey);
+
+    wchar_t rootName[64]{};
+    HTREEITEM hRoot = hItem;
+    HTREEITEM hParent;
+    while ((hParent = TreeView_GetParent(hwndTree, hRoot)) != nullptr) {
+        hRoot = hParent;
+    }
+    TVITEMW tvi{};
+    tvi.mask = TVIF_TEXT;
+    tvi.hItem = hRoot;
+    tvi.pszText = rootName;
+    tvi.cchTextMax = 64;
+    TreeView_GetItem(hwndTree, &tvi);
+
+    std::wstring fullPath = rootName;
+    if (!subKeyPath.empty()) {
+        fullPath += L"\\" + subKeyPath;
+    }
+    return fullPath;
+}
+
+// Replace the address bar text without triggering auto-complete
+void SetAddressBarText(const std::wstring& text) {
+    if (!g_hwndAddressBar) return;
+    g_addressUpdating = true;
+    SetWindowTextW(g_hwndAddressBar, text.c_str());
+    g_addressUpdating = false;
+}
+
+// Handle EN_CHANGE - append the first matching subkey name and select the
+// appended part, so typing on simply replaces it
+void OnAddressBarChanged() {
+    if (g_addressUpdating) return;
+    g_addressPending = false;
+    if (g_addressErased) {
+        g_addressErased = false;
+        return;
+    }
+    CompleteAddressBar();
+}
+
+// Complete the address bar text, unless the caret has left its end
+void CompleteAddressBar() {
+    int length = GetWindowTextLengthW(g_hwndAddressBar);
+    std::wstring text(length, L'\0');
+    GetWindowTextW(g_hwndAddressBar, text.data(), length + 1);
+
+    // Only complete while the caret sits at the end of the text
+    DWORD selStart = 0;
+    DWORD selEnd = 0;
+    SendMessageW(g_hwndAddressBar, EM_GETSEL, reinterpret_cast<WPARAM>(&selStart), reinterpret_cast<LPARAM>(&selEnd));
+    if (selEnd != static_cast<DWORD>(length) || text.empty() || text.back() == L'\\') return;
+
+    core::PathCompletion completion;
+    bool found = g_pathCompleter.Complete(text, 1, completion);
+    g_addressPending = completion.pending;
+    if (!found || completion.matches.empty()) return;
+
+    const std::wstring& match = completion.matches.front();
+    size_t typed = text.size() - completion.componentStart;
+    if (match.size() <= typed) return;
+
+    std::wstring completed = text.substr(0, completion.componentStart) + match;
+    SetAddressBarText(completed);
+    SendMessageW(g_hwndAddressBar, EM_SETSEL, text.size(), completed.size());
+}
+
+// Address bar subclass: Enter navigates, Escape restores the current path
+LRESULT CALLBACK AddressBarProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                [[maybe_unused]] UINT_PTR idSubclass, [[maybe_unused]] DWORD_PTR refData) {
+    switch (uMsg) {
+        case WM_KEYDOWN:
+            if (wParam == VK_RETURN) {
+                int length = GetWindowTextLengthW(hwnd);
+                std::wstring text(length, L'\0');
+                GetWindowTextW(hwnd, text.data(), length + 1);
+                NavigateToPath(GetParent(hwnd), text);
+                return 0;
+            }
+            if (wParam == VK_ESCAPE) {
+                HTREEITEM hSelected = TreeView_GetSelection(g_hwndLeftPane);
+                SetAddressBarText(hSelected ? GetItemFullPath(g_hwndLeftPane, hSelected) : L"");
+                SetFocus(g_hwndLeftPane);
+                return 0;
+            }
+            g_addressErased = (wParam == VK_BACK || wParam == VK_DELETE);
+            break;
+
+        case WM_CHAR:
+            // Swallow Enter/Escape so the edit control does not beep
+            if (wParam == L'\r' || wParam == 0x1B) return 0;
+            break;
+
+        case WM_NCDESTROY:
+            RemoveWindowSubclass(hwnd, AddressBarProc, 0);
+            break;
+    }
+    return DefSubclassProc(hwnd, uMsg, wParam, lParam);
+}
+
+// Find a direct child item by key name (case-insensitive)
+HTREEITEM FindChildItem(HWND hwndTree, HTREEITEM hParent, std::wstring_view name) {
+    wchar_t buffer[256];
+    for (HTREEITEM hChild = TreeView_GetChild(hwndTree, hParent); hChild;
+         hChild = TreeView_GetNextSibling(hwndTree, hChild)) {
+        TVITEMW tvi{};
+        tvi.mask = TVIF_TEXT;
+        tvi.hItem = hChild;
+        tvi.pszText = buffer;
+        tvi.cchTextMax = 256;
+        TreeView_GetItem(hwndTree, &tvi);
+        if (core::NamesEqual(buffer, name)) return hChild;
+    }
+    return nullptr;
+}
+
+// Go to a typed or pasted key path. The path is resolved with one chain of
+// relative opens first; then only the tree nodes along it are expanded.
+void NavigateToPath(HWND hwnd, const std::wstring& text) {
+    std::vector<std::wstring_view> parts = core::SplitPath(core::TrimRegistryPath(text));
+    if (parts.empty()) return;
+
+    HKEY hHive = core::Win32Backend::ParseHiveName(parts[0]);
+    if (!hHive) {
+        MessageBoxW(hwnd, L"The path does not start with a registry hive name.", APP_TITLE, MB_OK | MB_ICONWARNING);
+        return;
+    }
+
+    size_t resolved = 1;
+    core::KeyPtr key = g_registry.OpenKey(hHive, L"");
+    while (key && resolved < parts.size()) {
+        core::KeyPtr child = key->OpenSubKey(parts[resolved]);
+        if (!child) break;
+        key = std::move(child);
+        resolved++;
+    }
+
+    HTREEITEM hItem = TreeView_GetRoot(g_hwndLeftPane);
+    while (hItem) {
+        TVITEMW tvi{};
+        tvi.mask = TVIF_PARAM;
+        tvi.hItem = hItem;
+        TreeView_GetItem(g_hwndLeftPane, &tvi);
+        if (reinterpret_cast<HKEY>(tvi.lParam) == hHive) break;
+        hItem = TreeView_GetNextSibling(g_hwndLeftPane, hItem);
+    }
+    if (!hItem) return;
+
+    SendMessageW(g_hwndLeftPane, WM_SETREDRAW, FALSE, 0);
+    for (size_t i = 1; i < resolved; i++) {
+        TreeView_Expand(g_hwndLeftPane, hItem, TVE_EXPAND);
+        HTREEITEM hChild = FindChildItem(g_hwndLeftPane, hItem, parts[i]);
+        if (!hChild) break;
+        hItem = hChild;
+    }
+    SendMessageW(g_hwndLeftPane, WM_SETREDRAW, TRUE, 0);
+    InvalidateRect(g_hwndLeftPane, nullptr, TRUE);
+
+    TreeView_SelectItem(g_hwndLeftPane, hItem);
+    TreeView_EnsureVisible(g_hwndLeftPane, hItem);
+    SetFocus(g_hwndLeftPane);
+
+    if (resolved < parts.size()) {
+        std::wstring message = L"The key could not be found:\n\n" + std::wstring(parts[resolved]) +
+                               L"\n\nShowing the closest existing parent instead.";
+        MessageBoxW(hwnd, message.c_str(), APP_TITLE, MB_OK | MB_ICONWARNING);
+    }
+}
+
 // Handle TVN_ITEMEXPANDING - enumerate subkeys
 void OnTreeItemExpanding(HWND hwndTree, NMTREEVIEWW* pnmtv) {
     if (pnmtv->action != TVE_EXPAND) return;
@@ -612,11 +951,13 @@ void PopulateSubKeys(HWND hwndTree, HTREEITEM hParent, HKEY hRootKey, const std:
     wchar_t keyName[256];
     DWORD keyNameLen;
     DWORD index = 0;
+    std::vector<std::wstring> names;  // Handed to the address bar completion cache
     
     while (true) {
         keyNameLen = 256;
         result = RegEnumKeyExW(hKey, index++, keyName, &keyNameLen, nullptr, nullptr, nullptr, nullptr);
         if (result != ERROR_SUCCESS) break;
+        names.emplace_back(keyName, keyNameLen);
         
         // Check if this subkey has children
         HKEY hSubKey = nullptr;
@@ -642,6 +983,12 @@ void PopulateSubKeys(HWND hwndTree, HTREEITEM hParent, HKEY hRootKey, const std:
         tvis.item.iSelectedImage = ICON_FOLDER_OPEN;
         TreeView_InsertItem(hwndTree, &tvis);
     }
+
+    FILETIME lastWrite{};
+    RegQueryInfoKeyW(hKey, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                     nullptr, nullptr, nullptr, nullptr, &lastWrite);
+    g_pathCompleter.Store(GetItemFullPath(hwndTree, hParent), names,
+                          (static_cast<uint64_t>(lastWrite.dwHighDateTime) << 32) | lastWrite.dwLowDateTime);
     
     if (hKey != hRootKey) {
         RegCloseKey(hKey);
@@ -680,6 +1027,7 @@ void OnTreeSelectionChanged(HWND hwndTree, NMTREEVIEWW* pnmtv) {
     
     int valueCount = ListView_GetItemCount(g_hwndRightPane);
     UpdateStatusBar(fullPath, valueCount);
+    SetAddressBarText(fullPath);
 }
 
 // Populate ListView with registry values (virtual mode - populates cache)
@@ -713,6 +1061,7 @@ void PopulateValues(HKEY hRootKey, const std::wstring& subKeyPath) {
         RegQueryValueExW(hKey, nullptr, nullptr, &dwType, data.data(), &dataSize);
         defaultValue.typeName = GetRegistryTypeName(dwType);
         defaultValue.data = FormatRegistryData(dwType, data.data(), dataSize);
+        defaultValue.rawText = GetResolvableText(dwType, data.data(), dataSize);
     } else {
         defaultValue.typeName = L"REG_SZ";
         defaultValue.data = L"(value not set)";
@@ -745,6 +1094,7 @@ void PopulateValues(HKEY hRootKey, const std::wstring& subKeyPath) {
         valueInfo.type = dwType;
         valueInfo.typeName = GetRegistryTypeName(dwType);
         valueInfo.data = FormatRegistryData(dwType, data.data(), dataSize);
+        valueInfo.rawText = GetResolvableText(dwType, data.data(), dataSize);
         valueInfo.iconIndex = GetValueTypeIconIndex(dwType);
         g_valueCache.push_back(std::move(valueInfo));
     }
@@ -782,8 +1132,12 @@ std::wstring FormatRegistryData(DWORD dwType, const BYTE* data, DWORD dataSize)
     
     switch (dwType) {
         case REG_SZ:
-        case REG_EXPAND_SZ:
-            return std::wstring(reinterpret_cast<const wchar_t*>(data));
+        case REG_EXPAND_SZ: {
+            std::wstring text(reinterpret_cast<const wchar_t*>(data));
+            std::wstring description = DescribeGuid(text);
+            if (!description.empty()) text += L"  (" + description + L")";
+            return text;
+        }
             
         case REG_DWORD:
             if (dataSize >= 4) {
@@ -816,20 +1170,58 @@ std::wstring FormatRegistryData(DWORD dwType, const BYTE* data, DWORD dataSize)
             
         case REG_BINARY:
         default: {
-            std::wstring result;
-            DWORD displayBytes = (dataSize > 16) ? 16 : dataSize;
-            for (DWORD i = 0; i < displayBytes; i++) {
-                wchar_t buf[4];
-                swprintf_s(buf, L"%02X ", data[i]);
-                result += buf;
-            }
-            if (dataSize > 16) result += L"...";
+            std::string hex;
+            core::FormatHexBytes(data, (dataSize > 16) ? 16 : dataSize, hex);
+            std::wstring result(hex.begin(), hex.end());
+            if (dataSize > 16) result += L" ...";
             return result;
         }
     }
     return L"";
 }
 
+// String data that displays expanded or as its indirect string, or empty
+std::wstring GetResolvableText(DWORD dwType, const BYTE* data, DWORD dataSize) {
+    if (!data || (dwType != REG_SZ && dwType != REG_EXPAND_SZ)) return L"";
+
+    std::wstring text(reinterpret_cast<const wchar_t*>(data), dataSize / sizeof(wchar_t));
+    size_t end = text.find(L'\0');
+    if (end != std::wstring::npos) text.resize(end);
+    if (core::ResolutionFor(dwType, text) == core::StringResolution::None) return L"";
+    return text;
+}
+
+// Load the COM index from the cache (or build it) without blocking the UI
+void StartComIndexLoad(HWND hwnd) {
+    g_comIndexThread = std::jthread([hwnd](std::stop_token stopToken) {
+        wchar_t localAppData[MAX_PATH];
+        DWORD length = GetEnvironmentVariableW(L"LOCALAPPDATA", localAppData, MAX_PATH);
+        if (length == 0 || length >= MAX_PATH) return;
+
+        core::KeyPtr classesRoot = g_registry.OpenKey(HKEY_CLASSES_ROOT, L"");
+        if (!classesRoot) return;
+
+        auto index = std::make_shared<core::ComIndex>();
+        core::ComIndexOptions options;
+        options.stopToken = stopToken;
+        std::filesystem::path cachePath = std::filesystem::path(localAppData) / L"RegStudio" / L"ComIndex.bin";
+        if (!core::ComIndex::LoadOrBuild(*classesRoot, cachePath, *index, options)) return;
+
+        g_comIndex.store(std::move(index));
+        PostMessageW(hwnd, WM_APP_COM_INDEX_READY, 0, 0);
+    });
+}
+
+// Registered name of the first GUID in text, or empty
+std::wstring DescribeGuid(std::wstring_view text) {
+    std::shared_ptr<const core::ComIndex> index = g_comIndex.load();
+    if (!index) return L"";
+
+    core::Guid guid;
+    std::wstring name;
+    if (core::FindGuid(text, guid) == std::wstring_view::npos || !index->FindName(guid, name)) return L"";
+    return name;
+}
 
 // Update status bar with current path and value count
 void UpdateStatusBar(const std::wstring& keyPath, int valueCount) {
@@ -842,6 +1234,10 @@ void UpdateStatusBar(const std::wstring& keyPath, int valueCount) {
         wchar_t countStr[32];
         swprintf_s(countStr, L" (%d value%s)", valueCount, valueCount == 1 ? L"" : L"s");
         statusText = keyPath + countStr;
+
+        // Keys named after a GUID (HKCR\CLSID\{...} and friends) get their registered name
+        std::wstring description = DescribeGuid(keyPath.substr(keyPath.find_last_of(L'\\') + 1));
+        if (!description.empty()) statusText += L" - " + description;
     }
     
     SendMessageW(g_hwndStatusBar, SB_SETTEXTW, 0, reinterpret_cast<LPARAM>(statusText.c_str()));
@@ -860,8 +1256,14 @@ void ResizePanes(HWND hwnd, int width, int height) {
         SendMessageW(g_hwndStatusBar, WM_SIZE, 0, 0);
     }
     
-    // Adjust height for status bar
-    int paneHeight = height - statusBarHeight;
+    // Address bar spans the full width above the panes
+    if (g_hwndAddressBar) {
+        SetWindowPos(g_hwndAddressBar, nullptr, 0, 0, width, ADDRESS_BAR_HEIGHT, SWP_NOZORDER);
+    }
+    int paneTop = g_hwndAddressBar ? ADDRESS_BAR_HEIGHT : 0;
+
+    // Adjust height for status bar and address bar
+    int paneHeight = height - statusBarHeight - paneTop;
 
     // Calculate left pane width based on stored ratio
     int leftWidth = static_cast<int>(width * g_splitRatio);
@@ -874,7 +1276,7 @@ void ResizePanes(HWND hwnd, int width, int height) {
 
     // Position left pane
     SetWindowPos(g_hwndLeftPane, nullptr,
-        0, 0,
+        0, paneTop,
         leftWidth, paneHeight,
         SWP_NOZORDER);
 
@@ -882,12 +1284,12 @@ void ResizePanes(HWND hwnd, int width, int height) {
     int rightX = leftWidth + SPLITTER_WIDTH;
     int rightWidth = width - rightX;
     SetWindowPos(g_hwndRightPane, nullptr,
-        rightX, 0,
+        rightX, paneTop,
         rightWidth, paneHeight,
         SWP_NOZORDER);
 
     // Invalidate splitter area to redraw
-    RECT splitterRect = { leftWidth, 0, rightX, paneHeight };
+    RECT splitterRect = { leftWidth, paneTop, rightX, paneTop + paneHeight };
     InvalidateRect(hwnd, &splitterRect, TRUE);
 }
 
@@ -902,6 +1304,10 @@ bool IsOnSplitter(HWND hwnd, int x) {
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     switch (uMsg) {
         case WM_COMMAND:
+            if (reinterpret_cast<HWND>(lParam) == g_hwndAddressBar && g_hwndAddressBar) {
+                if (HIWORD(wParam) == EN_CHANGE) OnAddressBarChanged();
+                return 0;
+            }
             switch (LOWORD(wParam)) {
                 case IDM_FILE_EXIT:
                     PostMessageW(hwnd, WM_CLOSE, 0, 0);
@@ -919,6 +1325,15 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 case IDM_VIEW_REFRESH:
                     RefreshCurrentView();
                     return 0;
+
+                case IDM_VIEW_ADDRESS_BAR:
+                    SetFocus(g_hwndAddressBar);
+                    SendMessageW(g_hwndAddressBar, EM_SETSEL, 0, -1);
+                    return 0;
+
+                case IDM_KEY_DELETE:
+                    DeleteSelectedKey(hwnd);
+                    return 0;
             }
             break;
 
@@ -958,10 +1373,22 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                                         wcsncpy_s(plvdi->item.pszText, plvdi->item.cchTextMax, 
                                                   info.typeName.c_str(), _TRUNCATE);
                                         break;
-                                    case 2:  // Data
+                                    case 2: {  // Data
+                                        // Resolved text when cached, else raw until the worker has it
+                                        std::wstring resolved;
+                                        const std::wstring* text = &info.data;
+                                        if (!info.rawText.empty()) {
+                                            if (g_stringCache.Lookup(info.type, info.rawText, resolved)) {
+                                                text = &resolved;
+                                            } else {
+                                                core::StringRequest request{static_cast<uint32_t>(info.type), info.rawText};
+                                                g_stringCache.Request({&request, 1});
+                                            }
+                                        }
                                         wcsncpy_s(plvdi->item.pszText, plvdi->item.cchTextMax, 
-                                                  info.data.c_str(), _TRUNCATE);
+                                                  text->c_str(), _TRUNCATE);
                                         break;
+                                    }
                                 }
                             }
                             if (plvdi->item.mask & LVIF_IMAGE) {
@@ -970,6 +1397,18 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                         }
                         return 0;
                     }
+                    case LVN_ODCACHEHINT: {
+                        // Resolve the rows about to be shown in one batch
+                        NMLVCACHEHINT* hint = reinterpret_cast<NMLVCACHEHINT*>(lParam);
+                        int last = std::min(hint->iTo, static_cast<int>(g_valueCache.size()) - 1);
+                        std::vector<core::StringRequest> requests;
+                        for (int i = std::max(hint->iFrom, 0); i <= last; i++) {
+                            const RegistryValueInfo& info = g_valueCache[i];
+                            if (!info.rawText.empty()) requests.push_back({static_cast<uint32_t>(info.type), info.rawText});
+                        }
+                        if (!requests.empty()) g_stringCache.Request(requests);
+                        return 0;
+                    }
                     case NM_RCLICK: {
                         POINT pt;
                         GetCursorPos(&pt);
@@ -1058,7 +1497,32 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             return 0;
         }
 
+        case WM_APP_COM_INDEX_READY:
+            // Show names for GUIDs in the current key now that they are known
+            RefreshCurrentView();
+            return 0;
+
+        case WM_APP_STRINGS_RESOLVED:
+            // Visible rows pick up their resolved text on repaint
+            InvalidateRect(g_hwndRightPane, nullptr, FALSE);
+            return 0;
+
+        case WM_APP_PATHS_READY:
+            // Finish a completion that was waiting for a key's subkeys
+            if (g_addressPending && GetFocus() == g_hwndAddressBar) CompleteAddressBar();
+            return 0;
+
+        case WM_SETTINGCHANGE:
+            if (lParam && wcscmp(reinterpret_cast<LPCWSTR>(lParam), L"Environment") == 0) {
+                // Our own environment block never changes; rebuild it from the registry
+                g_stringSource.ReloadEnvironment();
+                g_stringCache.InvalidateEnvironment();
+                InvalidateRect(g_hwndRightPane, nullptr, FALSE);
+            }
+            break;
+
         case WM_DESTROY:
+            g_stringCache.SetReadyCallback(nullptr);
             // Cleanup ImageLists
             if (g_hTreeImageList) ImageList_Destroy(g_hTreeImageList);
             if (g_hListImageList) ImageList_Destroy(g_hListImageList);
@@ -0,0 +1,154 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the automation server's request gates: cross-origin requests,
+ * foreign Host names, missing or wrong bearer tokens and oversized
+ * requests are refused before any operation runs.
+ */
+
+#include "HttpClient.h"
+#include "Test.h"
+
+#include "AutomationServer.h"
+#include "MemoryBackend.h"
+
+#include <string>
+
+using namespace core;
+
+namespace {
+
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+class Server {
+public:
+    Server() : m_server(m_backend) {
+        KeyPtr key = m_backend.OpenRoot()->CreateSubKey(L"Software\\Test");
+        if (key) key->SetValue({ L"Answer", VALUE_DWORD, { 42, 0, 0, 0 } });
+        AutomationServerOptions options;
+        options.workerCount = 2;
+        options.maxRequestBytes = MAX_REQUEST_BYTES;
+        m_started = m_server.Start(options);
+    }
+
+    bool Started() const { return m_started; }
+    std::string Host() const { return "127.0.0.1:" + std::to_string(m_server.Port()); }
+    std::string Token() const { return m_server.Token(); }
+    AutomationServer& Get() { return m_server; }
+
+    // Status of the one response to request; -1 if none came back
+    int Status(const std::string& request, std::string* body = nullptr) {
+        test::HttpClient client;
+        test::HttpResponse response;
+        if (!client.Connect(m_server.Port()) || !client.Send(request) || !client.Receive(response)) return -1;
+        if (body) *body = response.body;
+        return response.status;
+    }
+
+private:
+    MemoryBackend m_backend;
+    AutomationServer m_server;
+    bool m_started = false;
+};
+
+} // namespace
+
+TEST(AutomationServer, AcceptsLoopbackWithToken) {
+    Server server;
+    REQUIRE(server.Started());
+    std::string body;
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/query?path=Software%5CTest&name=Answer", server.Host(),
+                                          server.Token()), &body) == 200);
+    CHECK(body.find("\"id\":0") != std::string::npos);
+    CHECK(body.find("\"error\"") == std::string::npos);
+
+    std::string localhost = "LocalHost:" + std::to_string(server.Get().Port());
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", localhost, server.Token())) == 200);
+    CHECK(server.Status(test::HttpRequest("POST", "/v1/batch", server.Host(), server.Token(), "{\"op\":\"ping\"}\n",
+                                          "Content-Type: application/json; charset=utf-8\r\n")) == 200);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), {}, {},
+                                          "Authorization: bearer  " + server.Token() + "\r\n")) == 200);
+}
+
+TEST(AutomationServer, RefusesOrigin) {
+    Server server;
+    REQUIRE(server.Started());
+    for (const char* origin : { "http://example.com", "null", "http://127.0.0.1" }) {
+        std::string extra = std::string("Origin: ") + origin + "\r\n";
+        CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), server.Token(), {}, extra)) == 403);
+    }
+    // Checked before the token, so a page learns nothing about it
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), {}, {}, "origin: http://a\r\n")) == 403);
+}
+
+TEST(AutomationServer, RefusesForeignHost) {
+    Server server;
+    REQUIRE(server.Started());
+    std::string port = std::to_string(server.Get().Port());
+    std::string otherPort = std::to_string(server.Get().Port() == 1 ? 2 : server.Get().Port() - 1);
+    for (std::string host : { "evil.example:" + port, "127.0.0.1.evil.example:" + port, "127.0.0.1:" + otherPort,
+                              std::string("127.0.0.1"), std::string("localhost") }) {
+        CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", host, server.Token())) == 403);
+    }
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", {}, server.Token())) == 403);
+}
+
+TEST(AutomationServer, RequiresBearerToken) {
+    Server server;
+    REQUIRE(server.Started());
+    std::string token = server.Token();
+    CHECK(token.size() == 64);
+    std::string wrong = token;
+    wrong.back() = wrong.back() == '0' ? '1' : '0';
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), {})) == 401);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), wrong)) == 401);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), token.substr(0, 63))) == 401);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), token + "0")) == 401);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), {}, {},
+                                          "Authorization: Basic " + token + "\r\n")) == 401);
+    CHECK(server.Status(test::HttpRequest("GET", "/v1/ping", server.Host(), {}, {}, "Authorization: Bearer \r\n")) == 401);
+
+    // A refused request ends the connection, so nothing after it runs
+    test::HttpClient client;
+    REQUIRE(client.Connect(server.Get().Port()));
+    REQUIRE(client.Send(test::HttpRequest("GET", "/v1/ping", server.Host(), wrong) +
+                        test::HttpRequest("GET", "/v1/ping", server.Host(), token)));
+    test::HttpResponse response;
+    REQUIRE(client.Receive(response));
+    CHECK(response.status == 401);
+    CHECK(test::HttpClient::HeaderValue(response.headers, "Connection") == "close");
+    CHECK(client.Closed());
+    CHECK(server.Get().GetStats().operations == 0);
+}
+
+TEST(AutomationServer, RefusesOversizedRequests) {
+    Server server;
+    REQUIRE(server.Started());
+    std::string line = "{\"op\":\"ping\"}\n";
+    std::string fits;
+    while (fits.size() + line.size() <= MAX_REQUEST_BYTES) fits += line;
+    const char* json = "Content-Type: application/json\r\n";
+    CHECK(server.Status(test::HttpRequest("POST", "/v1/batch", server.Host(), server.Token(), fits, json)) == 200);
+
+    // Refused on the declared length, before the body is read
+    test::HttpClient client;
+    REQUIRE(client.Connect(server.Get().Port()));
+    std::string headers = "POST /v1/batch HTTP/1.1\r\nHost: " + server.Host() + "\r\nAuthorization: Bearer " +
+                          server.Token() + "\r\n" + json + "Content-Length: " +
+                          std::to_string(MAX_REQUEST_BYTES + 1) + "\r\n\r\n";
+    REQUIRE(client.Send(headers));
+    test::HttpResponse response;
+    REQUIRE(client.Receive(response));
+    CHECK(response.status == 413);
+    CHECK(client.Closed());
+
+    // Headers that never end are cut off at a fixed limit
+    std::string flood = "GET /v1/ping HTTP/1.1\r\nX-Padding: " + std::string(80 * 1024, 'a');
+    CHECK(server.Status(flood) == 431);
+
+    // Wrong body type
+    CHECK(server.Status(test::HttpRequest("POST", "/v1/batch", server.Host(), server.Token(), line,
+                                          "Content-Type: text/plain\r\n")) == 415);
+    CHECK(server.Get().GetStats().operations == fits.size() / line.size());
+}
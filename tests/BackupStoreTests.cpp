@@ -0,0 +1,201 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the backup store: restores give back the tree that was backed
+ * up, expired backups are collected without touching live ones, and the
+ * incremental pass only reuses value sets that cannot have changed.
+ */
+
+#include "Fixtures.h"
+#include "Test.h"
+
+#include "BackupStore.h"
+#include "MemoryBackend.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace core;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Key whose last-write time never moves, as on backends that do not track
+// every change
+class FrozenKey : public RegistryKey {
+public:
+    explicit FrozenKey(KeyPtr key) : m_key(std::move(key)) {}
+
+    bool QueryInfo(KeyInfo& info) const override {
+        if (!m_key->QueryInfo(info)) return false;
+        info.lastWriteTime = 1;
+        return true;
+    }
+    bool EnumSubKey(uint32_t index, std::wstring& name) const override { return m_key->EnumSubKey(index, name); }
+    bool EnumValue(uint32_t index, RegValue& value) const override { return m_key->EnumValue(index, value); }
+    bool GetValue(std::wstring_view name, RegValue& value) const override { return m_key->GetValue(name, value); }
+    KeyPtr OpenSubKey(std::wstring_view path) const override {
+        KeyPtr key = m_key->OpenSubKey(path);
+        return key ? std::make_unique<FrozenKey>(std::move(key)) : nullptr;
+    }
+
+private:
+    KeyPtr m_key;
+};
+
+bool Backup(BackupStore& store, const RegistryKey& key, uint64_t created, BackupInfo& info, BackupStats& stats) {
+    BackupSource source{ L"HKEY_CURRENT_USER", &key };
+    BackupOptions options;
+    options.created = created;
+    return store.CreateBackup({ &source, 1 }, options, info, stats);
+}
+
+std::wstring RestoredDump(BackupStore& store, const std::wstring& id) {
+    MemoryBackend target;
+    KeyPtr root = target.OpenRoot();
+    RestoreStats stats;
+    if (!store.Restore(id, 0, *root, stats) || stats.errors) return L"restore failed";
+    return test::DumpTree(*root);
+}
+
+} // namespace
+
+TEST(BackupStore, RestoreRoundTrip) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    // Values go in in name order, as restores write them
+    root->SetValue({ L"", VALUE_SZ, EncodeString(L"default") });
+    root->SetValue({ L"Big", VALUE_BINARY, std::vector<uint8_t>(100000, 0x5A) });
+    uint64_t keys = test::FillTree(*root, 4, 3, 5) + 1;
+    std::wstring expected = test::DumpTree(*root);
+
+    std::filesystem::path directory = test::TempDirectory() / "store";
+    BackupInfo info;
+    {
+        BackupStore store;
+        REQUIRE(store.Open(directory));
+        BackupStats stats;
+        REQUIRE(Backup(store, *root, 0, info, stats));
+        CHECK(stats.keys == keys);
+        CHECK(stats.errors == 0);
+        CHECK(RestoredDump(store, info.id) == expected);
+    }
+
+    // Read back from the sealed packs after reopening
+    BackupStore store;
+    REQUIRE(store.Open(directory));
+    std::vector<BackupInfo> backups;
+    REQUIRE(store.ListBackups(backups));
+    REQUIRE(backups.size() == 1);
+    CHECK(backups[0].id == info.id);
+    CHECK(backups[0].roots[0].keys == keys);
+    CHECK(RestoredDump(store, info.id) == expected);
+}
+
+TEST(BackupStore, ExpiredBackupsAreCollected) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    test::FillTree(*root, 3, 3, 3);
+
+    std::filesystem::path directory = test::TempDirectory() / "store";
+    BackupStore store;
+    REQUIRE(store.Open(directory));
+    BackupInfo info;
+    BackupStats stats;
+    for (uint64_t created : { 1000, 2000, 3000 }) {
+        KeyPtr key = root->CreateSubKey(L"Key1\\Key2");
+        REQUIRE(key);
+        key->SetValue({ L"Version", VALUE_BINARY, std::vector<uint8_t>(5000, uint8_t(created / 1000)) });
+        REQUIRE(Backup(store, *root, created, info, stats));
+    }
+    std::wstring expected = test::DumpTree(*root);
+    StoreStats before = store.GetStats();
+    CHECK(before.backups == 3);
+
+    // The newest is kept even though it is old enough too
+    CHECK(store.ExpireBackups(2500, 1) == 2);
+    CHECK(store.ExpireBackups(5000, 1) == 0);
+    GarbageStats garbage;
+    REQUIRE(store.CollectGarbage(garbage));
+    CHECK(garbage.deadObjects > 0);
+    CHECK(garbage.freedBytes >= 2 * 5000);
+    CHECK(garbage.liveObjects > 0);
+    CHECK(store.GetStats().objects == garbage.liveObjects);
+    CHECK(store.GetStats().bytes < before.bytes);
+
+    // Nothing left to collect, and what is left still restores
+    REQUIRE(store.CollectGarbage(garbage));
+    CHECK(garbage.deadObjects == 0);
+    store.Close();
+    REQUIRE(store.Open(directory));
+    std::vector<BackupInfo> backups;
+    REQUIRE(store.ListBackups(backups));
+    REQUIRE(backups.size() == 1);
+    CHECK(backups[0].id == info.id);
+    CHECK(RestoredDump(store, info.id) == expected);
+}
+
+TEST(BackupStore, IncrementalReuseGuard) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 3, 2, 3) + 1;
+
+    BackupStore store;
+    REQUIRE(store.Open(test::TempDirectory() / "store"));
+    BackupInfo info;
+    BackupStats stats;
+    uint64_t created = 1000;
+    REQUIRE(Backup(store, *root, created++, info, stats));
+    CHECK(stats.reusedKeys == 0);
+
+    // Unchanged: every value set is reused and nothing new is stored
+    REQUIRE(Backup(store, *root, created++, info, stats));
+    CHECK(stats.keys == keys);
+    CHECK(stats.reusedKeys == keys);
+    CHECK(stats.newObjects == 0);
+
+    // Same-size data under a moved last-write time is read again
+    std::this_thread::sleep_for(2ms);
+    KeyPtr key = root->OpenSubKey(L"Key1");
+    REQUIRE(key);
+    RegValue value;
+    REQUIRE(key->GetValue(L"Value1", value));
+    value.data[0] ^= 0xFF;
+    REQUIRE(key->SetValue(value));
+    REQUIRE(Backup(store, *root, created++, info, stats));
+    CHECK(stats.reusedKeys == keys - 1);
+    CHECK(RestoredDump(store, info.id) == test::DumpTree(*root));
+
+    // With the time frozen, size, type and name changes are still caught
+    FrozenKey frozen(backend.OpenRoot());
+    REQUIRE(Backup(store, frozen, created++, info, stats));
+    REQUIRE(key->GetValue(L"Value0", value));
+    value.data.insert(value.data.end(), { 'x', 0 });
+    REQUIRE(key->SetValue(value));
+    REQUIRE(Backup(store, frozen, created++, info, stats));
+    CHECK(stats.reusedKeys == keys - 1);
+    CHECK(RestoredDump(store, info.id) == test::DumpTree(*root));
+
+    REQUIRE(key->GetValue(L"Value1", value));
+    value.type = VALUE_BINARY;
+    REQUIRE(key->SetValue(value));
+    REQUIRE(Backup(store, frozen, created++, info, stats));
+    CHECK(stats.reusedKeys == keys - 1);
+    CHECK(RestoredDump(store, info.id) == test::DumpTree(*root));
+
+    REQUIRE(key->DeleteValue(L"Value1"));
+    value.name = L"Value9";
+    REQUIRE(key->SetValue(value));
+    REQUIRE(Backup(store, frozen, created++, info, stats));
+    CHECK(stats.reusedKeys == keys - 1);
+    CHECK(RestoredDump(store, info.id) == test::DumpTree(*root));
+
+    // Without the incremental pass nothing is reused
+    BackupSource source{ L"HKEY_CURRENT_USER", root.get() };
+    BackupOptions options;
+    options.created = created++;
+    options.incremental = false;
+    REQUIRE(store.CreateBackup({ &source, 1 }, options, info, stats));
+    CHECK(stats.reusedKeys == 0);
+}
@@ -0,0 +1,145 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the COM index image: a saved index maps back with the same
+ * lookups, and a truncated or corrupt image is refused rather than read.
+ */
+
+#include "HiveFixtures.h"
+#include "Test.h"
+
+#include "ComIndex.h"
+#include "MemoryBackend.h"
+
+using namespace core;
+
+namespace {
+
+// Image header fields, as laid out by ComIndex
+constexpr size_t MAGIC = 0;
+constexpr size_t VERSION = 4;
+constexpr size_t SLOT_COUNT = 8;
+constexpr size_t ENTRY_COUNT = 12;
+constexpr size_t POOL_SIZE = 20;
+
+void SetDefault(RegistryKey& root, const std::wstring& path, const std::wstring& text) {
+    KeyPtr key = root.CreateSubKey(path);
+    if (key) key->SetValue({ L"", VALUE_SZ, EncodeString(text) });
+}
+
+void FillClassesRoot(RegistryKey& root) {
+    for (int i = 0; i < 40; i++) {
+        wchar_t clsid[48];
+        std::swprintf(clsid, 48, L"CLSID\\{%08X-0000-0000-C000-000000000046}", 0x21400 + i);
+        SetDefault(root, clsid, L"Class " + std::to_wstring(i));
+        SetDefault(root, std::wstring(clsid) + L"\\InprocServer32", L"server" + std::to_wstring(i) + L".dll");
+        SetDefault(root, std::wstring(clsid) + L"\\ProgID", L"Test.Class" + std::to_wstring(i) + L".1");
+    }
+    SetDefault(root, L"Interface\\{00000000-0000-0000-C000-000000000046}", L"IUnknown");
+}
+
+std::vector<uint8_t> SavedImage(RegistryKey& root) {
+    ComIndex index;
+    std::filesystem::path path = test::TempDirectory() / "index";
+    if (!ComIndex::Build(root, index) || !index.Save(path)) return {};
+    return test::LoadFile(path);
+}
+
+bool Opens(const std::vector<uint8_t>& image) {
+    std::filesystem::path path = test::TempDirectory() / "damaged";
+    test::SaveFile(path, image);
+    ComIndex index;
+    bool opened = index.Open(path);
+    CHECK(opened == index.IsLoaded());
+    return opened;
+}
+
+void Put(std::vector<uint8_t>& image, size_t offset, uint32_t value) {
+    hive::WriteU32(image.data() + offset, value);
+}
+
+} // namespace
+
+TEST(ComIndex, SavedImageReopens) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    FillClassesRoot(*root);
+    std::vector<uint8_t> image = SavedImage(*root);
+    REQUIRE(!image.empty());
+
+    ComIndex index;
+    REQUIRE(index.Open(test::TempDirectory() / "index"));
+    CHECK(index.Size() == 41);
+    CHECK(index.IsCurrent(*root));
+
+    Guid guid;
+    REQUIRE(ParseGuid(L"{00021405-0000-0000-C000-000000000046}", guid));
+    ComEntry entry;
+    REQUIRE(index.Find(guid, entry));
+    CHECK(entry.kinds == COM_CLASS);
+    CHECK(entry.name == L"Class 5");
+    CHECK(entry.server == L"server5.dll");
+    CHECK(entry.progId == L"Test.Class5.1");
+
+    Guid found;
+    REQUIRE(index.FindProgId(L"test.class5.1", found));
+    CHECK(found == guid);
+    REQUIRE(ParseGuid(L"{00000000-0000-0000-C000-000000000046}", guid));
+    std::wstring name;
+    CHECK(index.FindName(guid, name) && name == L"IUnknown");
+}
+
+TEST(ComIndex, TruncatedImageIsRefused) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    FillClassesRoot(*root);
+    std::vector<uint8_t> image = SavedImage(*root);
+    REQUIRE(image.size() > 64);
+    CHECK(Opens(image));
+
+    for (size_t size : { size_t{0}, size_t{4}, size_t{63}, size_t{64}, image.size() / 2, image.size() - 1 }) {
+        CHECK(!Opens(std::vector<uint8_t>(image.begin(), image.begin() + size)));
+    }
+    std::vector<uint8_t> longer = image;
+    longer.push_back(0);
+    CHECK(!Opens(longer));
+}
+
+TEST(ComIndex, CorruptHeaderIsRefused) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    FillClassesRoot(*root);
+    std::vector<uint8_t> image = SavedImage(*root);
+    REQUIRE(image.size() > 64);
+    uint32_t slots = hive::ReadU32(image.data() + SLOT_COUNT);
+    uint32_t pool = hive::ReadU32(image.data() + POOL_SIZE);
+
+    std::vector<uint8_t> damaged = image;
+    Put(damaged, MAGIC, 0x46464646);
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, VERSION, 99);
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, SLOT_COUNT, slots - 1);            // Not a power of two
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, SLOT_COUNT, slots * 2);            // Larger than the file
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, ENTRY_COUNT, slots);               // Full table: probes would never stop
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, POOL_SIZE, pool + 1);
+    CHECK(!Opens(damaged));
+
+    damaged = image;
+    Put(damaged, POOL_SIZE, 0xFFFFFFFF);
+    CHECK(!Opens(damaged));
+}
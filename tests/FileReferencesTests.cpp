@@ -0,0 +1,136 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the file reference finder: path extraction from command lines
+ * and resource strings, normalization, expansion and a scan over a
+ * MemoryFileSystem.
+ */
+
+#include "Test.h"
+
+#include "FileReferences.h"
+#include "MemoryBackend.h"
+
+#include <algorithm>
+
+using namespace core;
+
+namespace {
+
+std::vector<std::wstring> Extract(std::wstring_view text) {
+    std::vector<std::wstring_view> views;
+    ExtractFilePaths(text, views);
+    return { views.begin(), views.end() };
+}
+
+using Paths = std::vector<std::wstring>;
+
+} // namespace
+
+TEST(FileReferences, QuotedCommandLines) {
+    CHECK(Extract(L"\"C:\\Program Files\\App\\app.exe\" -open \"%1\"") == Paths{ L"C:\\Program Files\\App\\app.exe" });
+    CHECK(Extract(L"\"C:\\Program Files\\App\\app.exe\" \"D:\\Data Files\\in.txt\"") ==
+          (Paths{ L"C:\\Program Files\\App\\app.exe", L"D:\\Data Files\\in.txt" }));
+    CHECK(Extract(L"C:\\Windows\\system32\\rundll32.exe shell32.dll,Control_RunDLL") ==
+          Paths{ L"C:\\Windows\\system32\\rundll32.exe" });
+    // A value that is only a path keeps its blanks
+    CHECK(Extract(L"C:\\Program Files\\App\\readme") == Paths{ L"C:\\Program Files\\App\\readme" });
+    CHECK(Extract(L"\"C:\\unterminated\\app.exe") == Paths{ L"C:\\unterminated\\app.exe" });
+    CHECK(Extract(L"\"relative\\app.exe\" C:\\") == Paths{});
+    CHECK(Extract(L"no paths here, 50% of C:") == Paths{});
+}
+
+TEST(FileReferences, ResourceStrings) {
+    CHECK(Extract(L"@%SystemRoot%\\system32\\shell32.dll,-21787") == Paths{ L"%SystemRoot%\\system32\\shell32.dll" });
+    CHECK(Extract(L"@C:\\Windows\\res.dll,-5;Fallback text") == Paths{ L"C:\\Windows\\res.dll" });
+    CHECK(Extract(L"@%ProgramFiles%\\App\\app.exe,-100") == Paths{ L"%ProgramFiles%\\App\\app.exe" });
+    CHECK(Extract(L"@shell32.dll,-21787") == Paths{});
+}
+
+TEST(FileReferences, KernelPrefixes) {
+    CHECK(Extract(L"\\SystemRoot\\System32\\drivers\\acpi.sys") == Paths{ L"\\SystemRoot\\System32\\drivers\\acpi.sys" });
+    CHECK(Extract(L"\\??\\C:\\Windows\\System32\\drivers\\x.sys") == Paths{ L"\\??\\C:\\Windows\\System32\\drivers\\x.sys" });
+    CHECK(Extract(L"\\\\?\\C:\\long\\path.dll") == Paths{ L"\\\\?\\C:\\long\\path.dll" });
+    CHECK(Extract(L"\\??\\Volume{1234}\\x") == Paths{});
+}
+
+TEST(FileReferences, Normalize) {
+    CHECK(NormalizeFilePath(L"c:/Windows//System32/./drivers/../cmd.exe") == L"C:\\Windows\\System32\\cmd.exe");
+    CHECK(NormalizeFilePath(L"\\??\\C:\\a\\b") == L"C:\\a\\b");
+    CHECK(NormalizeFilePath(L"\\\\?\\C:\\a") == L"C:\\a");
+    CHECK(NormalizeFilePath(L"C:\\..\\..") == L"C:\\");
+    CHECK(NormalizeFilePath(L"C:\\a\\..\\..\\b") == L"C:\\b");
+    CHECK(NormalizeFilePath(L"C:\\dir.\\file. ") == L"C:\\dir\\file");
+    CHECK(NormalizeFilePath(L"C:\\") == L"C:\\");
+    CHECK(NormalizeFilePath(L"relative\\file") == L"");
+    CHECK(NormalizeFilePath(L"C:relative") == L"");
+    CHECK(NormalizeFilePath(L"\\SystemRoot\\x") == L"");
+}
+
+TEST(FileReferences, Expand) {
+    MemoryFileSystem fileSystem;
+    fileSystem.SetEnvironment(L"SystemRoot", L"C:\\Windows");
+    fileSystem.SetEnvironment(L"ProgramFiles", L"C:\\Program Files");
+
+    std::wstring expanded;
+    CHECK(ExpandFilePath(L"\\SystemRoot\\System32\\x.sys", fileSystem, expanded));
+    CHECK(expanded == L"C:\\Windows\\System32\\x.sys");
+    CHECK(ExpandFilePath(L"\\systemroot\\x.sys", fileSystem, expanded));
+    CHECK(expanded == L"C:\\Windows\\x.sys");
+    CHECK(ExpandFilePath(L"%programfiles%\\App\\%SystemRoot%.txt", fileSystem, expanded));
+    CHECK(expanded == L"C:\\Program Files\\App\\C:\\Windows.txt");
+    CHECK(ExpandFilePath(L"C:\\100%\\done", fileSystem, expanded));
+    CHECK(expanded == L"C:\\100%\\done");
+    CHECK(!ExpandFilePath(L"%Undefined%\\x.dll", fileSystem, expanded));
+}
+
+TEST(FileReferences, ScanMarksMissingFiles) {
+    MemoryFileSystem fileSystem;
+    fileSystem.SetEnvironment(L"SystemRoot", L"C:\\Windows");
+    fileSystem.AddPath(L"C:\\Windows\\System32\\drivers\\acpi.sys");
+    fileSystem.AddPath(L"C:\\Windows\\System32\\shell32.dll");
+    fileSystem.AddPath(L"C:\\Program Files\\App\\app.exe");
+
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    auto set = [&](const wchar_t* path, const wchar_t* name, uint32_t type, const wchar_t* text) {
+        KeyPtr key = root->CreateSubKey(path);
+        if (key) key->SetValue({ name, type, EncodeString(text) });
+    };
+    set(L"Services\\acpi", L"ImagePath", VALUE_EXPAND_SZ, L"\\SystemRoot\\System32\\drivers\\ACPI.sys");
+    set(L"Services\\gone", L"ImagePath", VALUE_EXPAND_SZ, L"\\SystemRoot\\System32\\drivers\\gone.sys");
+    set(L"Services\\gone", L"Description", VALUE_SZ, L"@%SystemRoot%\\system32\\shell32.dll,-1");
+    set(L"Classes\\app\\shell\\open\\command", L"", VALUE_SZ, L"\"C:\\Program Files\\App\\app.exe\" \"%1\"");
+    set(L"Classes\\other", L"", VALUE_SZ, L"\"c:\\program files\\app\\..\\App\\APP.EXE\"");
+    set(L"Odd", L"Path", VALUE_SZ, L"%NoSuchVariable%\\x.dll");
+
+    FileReferenceFinder finder(fileSystem);
+    FileReferenceReport report;
+    REQUIRE(finder.Scan(*root, report));
+    CHECK(report.stats.references == 6);
+    CHECK(report.stats.uniquePaths == 5);
+    CHECK(report.stats.missingReferences == 1);
+    CHECK(report.stats.errors == 0);
+    CHECK(report.stats.directoryReads == report.stats.directories);
+
+    size_t broken = 0;
+    for (const FileReference& reference : report.references) {
+        FileStatus status = report.status[reference.path];
+        if (reference.text.find(L"gone.sys") != std::wstring::npos) CHECK(status == FileStatus::Missing);
+        else if (reference.text.find(L"NoSuchVariable") != std::wstring::npos) CHECK(status == FileStatus::Unresolved);
+        else CHECK(status == FileStatus::Exists);
+        if (report.IsBroken(reference)) {
+            broken++;
+            CHECK(report.keys[reference.key] == L"Services\\gone");
+        }
+    }
+    CHECK(broken == 1);
+
+    // A second scan is served from the directory cache
+    REQUIRE(finder.Scan(*root, report));
+    CHECK(report.stats.directoryReads == 0);
+    finder.ClearCache();
+    REQUIRE(finder.Scan(*root, report));
+    CHECK(report.stats.directoryReads == report.stats.directories);
+}
@@ -0,0 +1,185 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Synthetic registry trees shared by the tests and benchmarks.
+ */
+
+#pragma once
+
+#include "RegistryBackend.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace test {
+
+// Give key fanout children per level, depth levels deep, each with
+// valuesPerKey values of mixed types. Returns the number of keys created
+// (key itself not included). The same arguments give the same tree.
+inline uint64_t FillTree(core::RegistryKey& key, unsigned fanout, unsigned depth, unsigned valuesPerKey) {
+    struct Item {
+        core::KeyPtr key;
+        unsigned depth;
+    };
+    std::vector<Item> stack;
+    std::vector<core::RegValue> values(valuesPerKey);
+    uint64_t created = 0;
+    uint32_t serial = 0;
+
+    auto fillValues = [&](core::RegistryKey& target) {
+        for (unsigned i = 0; i < valuesPerKey; i++) {
+            core::RegValue& value = values[i];
+            value.name = L"Value" + std::to_wstring(i);
+            serial = serial * 1103515245u + 12345u;
+            switch (i % 3) {
+            case 0:
+                value.type = core::VALUE_SZ;
+                value.data = core::EncodeString(L"String data " + std::to_wstring(serial));
+                break;
+            case 1:
+                value.type = core::VALUE_DWORD;
+                value.data = { uint8_t(serial), uint8_t(serial >> 8), uint8_t(serial >> 16), uint8_t(serial >> 24) };
+                break;
+            default:
+                value.type = core::VALUE_BINARY;
+                value.data.assign(serial % 64, uint8_t(serial >> 24));
+                break;
+            }
+        }
+        target.SetValues(values);
+    };
+
+    fillValues(key);
+    if (depth > 0) {
+        for (unsigned i = 0; i < fanout; i++) {
+            core::KeyPtr child = key.CreateSubKey(L"Key" + std::to_wstring(i));
+            if (!child) continue;
+            created++;
+            fillValues(*child);
+            stack.push_back({ std::move(child), depth - 1 });
+        }
+    }
+    while (!stack.empty()) {
+        Item item = std::move(stack.back());
+        stack.pop_back();
+        if (item.depth == 0) continue;
+        for (unsigned i = 0; i < fanout; i++) {
+            core::KeyPtr child = item.key->CreateSubKey(L"Key" + std::to_wstring(i));
+            if (!child) continue;
+            created++;
+            fillValues(*child);
+            stack.push_back({ std::move(child), item.depth - 1 });
+        }
+    }
+    return created;
+}
+
+// One line per key path and per value (type and data in hex), in
+// enumeration order; equal listings mean equal trees
+inline std::wstring DumpTree(const core::RegistryKey& key, const std::wstring& path = {}) {
+    static const wchar_t digits[] = L"0123456789ABCDEF";
+    std::wstring text = L"[" + path + L"]\n";
+    std::vector<core::RegValue> values;
+    key.GetValues(values);
+    for (const core::RegValue& value : values) {
+        text += value.name + L"=" + std::to_wstring(value.type) + L":";
+        for (uint8_t byte : value.data) {
+            text += digits[byte >> 4];
+            text += digits[byte & 15];
+        }
+        text += L"\n";
+    }
+    std::vector<std::wstring> names;
+    key.GetSubKeyNames(names);
+    for (const std::wstring& name : names) {
+        core::KeyPtr child = key.OpenSubKey(name);
+        text += child ? DumpTree(*child, path + L"\\" + name) : L"[" + path + L"\\" + name + L" unreadable]\n";
+    }
+    return text;
+}
+
+// UTF-8 for the narrow streams the readers take
+inline void AppendUtf8(std::string& out, std::wstring_view text) {
+    for (wchar_t wide : text) {
+        uint32_t c = static_cast<uint32_t>(wide) & 0xFFFF;
+        if (c < 0x80) {
+            out += char(c);
+        } else if (c < 0x800) {
+            out += char(0xC0 | (c >> 6));
+            out += char(0x80 | (c & 0x3F));
+        } else {
+            out += char(0xE0 | (c >> 12));
+            out += char(0x80 | ((c >> 6) & 0x3F));
+            out += char(0x80 | (c & 0x3F));
+        }
+    }
+}
+
+// Export key as a version 5 .reg file (UTF-8), keys under rootPath,
+// parents before children as regedit writes them
+inline std::string ExportRegFile(const core::RegistryKey& key, const std::wstring& rootPath) {
+    std::string text = "Windows Registry Editor Version 5.00\r\n";
+    struct Item {
+        core::KeyPtr owned;
+        const core::RegistryKey* key;
+        std::wstring path;
+    };
+    std::vector<Item> stack;
+    stack.push_back({ nullptr, &key, rootPath });
+    std::vector<core::RegValue> values;
+    std::vector<std::wstring> names;
+    char hex[8];
+    while (!stack.empty()) {
+        Item item = std::move(stack.back());
+        stack.pop_back();
+        text += "\r\n[";
+        AppendUtf8(text, item.path);
+        text += "]\r\n";
+        item.key->GetValues(values);
+        for (const core::RegValue& value : values) {
+            if (value.name.empty()) {
+                text += "@";
+            } else {
+                text += "\"";
+                AppendUtf8(text, value.name);
+                text += "\"";
+            }
+            std::wstring decoded = core::DecodeString(value.data.data(), value.data.size());
+            if (value.type == core::VALUE_SZ && core::EncodeString(decoded) == value.data &&
+                decoded.find_first_of(L"\"\\\r\n") == std::wstring::npos) {
+                text += "=\"";
+                AppendUtf8(text, decoded);
+                text += "\"\r\n";
+            } else if (value.type == core::VALUE_DWORD && value.data.size() == 4) {
+                std::snprintf(hex, sizeof(hex), "%02x", value.data[3]);
+                text += std::string("=dword:") + hex;
+                for (int i = 2; i >= 0; i--) {
+                    std::snprintf(hex, sizeof(hex), "%02x", value.data[i]);
+                    text += hex;
+                }
+                text += "\r\n";
+            } else {
+                std::snprintf(hex, sizeof(hex), "%x", value.type);
+                text += value.type == core::VALUE_BINARY ? std::string("=hex:") : std::string("=hex(") + hex + "):";
+                for (size_t i = 0; i < value.data.size(); i++) {
+                    std::snprintf(hex, sizeof(hex), i ? ",%02x" : "%02x", value.data[i]);
+                    text += hex;
+                }
+                text += "\r\n";
+            }
+        }
+        item.key->GetSubKeyNames(names);
+        for (size_t i = names.size(); i-- > 0;) {
+            core::KeyPtr child = item.key->OpenSubKey(names[i]);
+            if (!child) continue;
+            const core::RegistryKey* raw = child.get();
+            stack.push_back({ std::move(child), raw, item.path + L"\\" + names[i] });
+        }
+    }
+    return text;
+}
+
+} // namespace test
@@ -0,0 +1,88 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for GUID parsing: the SSE2 digit kernel against the scalar one over
+ * every byte value in every position, and the text forms ParseGuid takes.
+ */
+
+#include "Test.h"
+
+#include "Guid.h"
+
+#include <cstring>
+
+using namespace core;
+
+#ifdef REGSTUDIO_HAVE_SSE2
+namespace {
+
+// Both kernels agree on the verdict and, when it is a pass, on the bytes
+bool KernelsAgree(const uint8_t* digits) {
+    uint8_t scalar[8] = {};
+    uint8_t simd[8] = {};
+    bool scalarOk = HexToBytesScalar(digits, scalar);
+    bool simdOk = HexToBytesSse2(digits, simd);
+    return scalarOk == simdOk && (!scalarOk || std::memcmp(scalar, simd, sizeof(scalar)) == 0);
+}
+
+} // namespace
+#endif
+
+TEST(Guid, ScalarKernel) {
+    const char* text = "0123456789abcDEF";
+    uint8_t bytes[8];
+    REQUIRE(HexToBytesScalar(reinterpret_cast<const uint8_t*>(text), bytes));
+    const uint8_t expected[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF };
+    CHECK(std::memcmp(bytes, expected, sizeof(bytes)) == 0);
+    CHECK(!HexToBytesScalar(reinterpret_cast<const uint8_t*>("0123456789abcdeg"), bytes));
+}
+
+#ifdef REGSTUDIO_HAVE_SSE2
+TEST(Guid, Sse2KernelMatchesScalar) {
+    // Every byte value in every position of an otherwise valid run
+    uint8_t digits[16];
+    for (int position = 0; position < 16; position++) {
+        for (int value = 0; value < 256; value++) {
+            std::memcpy(digits, "0f1E2d3C4b5A6978", 16);
+            digits[position] = static_cast<uint8_t>(value);
+            CHECK(KernelsAgree(digits));
+        }
+    }
+
+    // Random runs, mostly of valid digits in either case
+    static const char POOL[] = "0123456789abcdefABCDEF/:@G`g\x80\xff";
+    uint32_t seed = 12345;
+    for (int run = 0; run < 20000; run++) {
+        for (uint8_t& digit : digits) {
+            seed = seed * 1103515245u + 12345u;
+            digit = static_cast<uint8_t>(POOL[(seed >> 16) % (run % 4 ? 22 : sizeof(POOL) - 1)]);
+        }
+        CHECK(KernelsAgree(digits));
+    }
+}
+#endif
+
+TEST(Guid, ParseAndFormat) {
+    Guid guid;
+    REQUIRE(ParseGuid(L"{00021401-0000-0000-c000-000000000046}", guid));
+    CHECK(guid.hi == 0x0002140100000000ull);
+    CHECK(guid.lo == 0xC000000000000046ull);
+    CHECK(FormatGuid(guid) == L"{00021401-0000-0000-C000-000000000046}");
+
+    Guid bare;
+    CHECK(ParseGuid(L"00021401-0000-0000-C000-000000000046", bare));
+    CHECK(bare == guid);
+
+    CHECK(!ParseGuid(L"{00021401-0000-0000-C000-000000000046", guid));
+    CHECK(!ParseGuid(L"{00021401-0000-0000-C000+000000000046}", guid));
+    CHECK(!ParseGuid(L"{0002140G-0000-0000-C000-000000000046}", guid));
+    // Digits beyond ASCII must not narrow onto valid ones
+    CHECK(!ParseGuid(L"{0002140\x0131-0000-0000-C000-000000000046}", guid));
+    CHECK(!ParseGuid(L"{0002140\xFF11-0000-0000-C000-000000000046}", guid));
+    CHECK(!ParseGuid(L"{0002140\x0141-0000-0000-C000-000000000046}", guid));
+
+    std::wstring text = L"CLSID {00021401-0000-0000-C000-000000000046} here";
+    CHECK(FindGuid(text, guid) == 6);
+    CHECK(FindGuid(L"{nothing}", guid) == std::wstring_view::npos);
+}
@@ -0,0 +1,138 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * HexDocument edits and undo history against a plain vector, and the row
+ * formatter.
+ */
+
+#include "Test.h"
+
+#include "HexDocument.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace core;
+
+TEST(HexDocument, EditsAndUndo) {
+    HexDocument document(std::vector<uint8_t>{ 1, 2, 3, 4 });
+    const uint8_t inserted[] = { 9, 9 };
+    REQUIRE(document.Insert(2, inserted));
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 1, 2, 9, 9, 3, 4 }));
+    REQUIRE(document.Erase(0, 1));
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 2, 9, 9, 3, 4 }));
+
+    // Overwrite may run past the end and extends the data
+    const uint8_t tail[] = { 7, 7, 7 };
+    REQUIRE(document.Overwrite(4, tail));
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 2, 9, 9, 3, 7, 7, 7 }));
+
+    CHECK(!document.Insert(document.Size() + 1, inserted));
+    CHECK(!document.Erase(document.Size(), 1));
+
+    CHECK(document.Undo());
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 2, 9, 9, 3, 4 }));
+    CHECK(document.Undo());
+    CHECK(document.Undo());
+    CHECK(!document.Undo());
+    CHECK(!document.IsModified());
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 1, 2, 3, 4 }));
+    CHECK(document.Redo());
+    CHECK((document.Bytes() == std::vector<uint8_t>{ 1, 2, 9, 9, 3, 4 }));
+
+    // A new edit drops the redo history
+    REQUIRE(document.Erase(0, 6));
+    CHECK(!document.CanRedo());
+    CHECK(document.Size() == 0);
+}
+
+// Random edits, undos and redos checked against a copy of every state
+TEST(HexDocument, RandomEditsMatchReference) {
+    std::mt19937 random(1);
+    std::vector<uint8_t> original(5000);
+    for (uint8_t& byte : original) byte = static_cast<uint8_t>(random());
+
+    HexDocument document(original);
+    std::vector<std::vector<uint8_t>> states{ original };
+    size_t current = 0;
+    for (int step = 0; step < 5000; step++) {
+        const std::vector<uint8_t>& state = states[current];
+        std::vector<uint8_t> bytes(random() % 5 + 1);
+        for (uint8_t& byte : bytes) byte = static_cast<uint8_t>(random());
+        size_t pos = random() % (state.size() + 1);
+        std::vector<uint8_t> next = state;
+
+        switch (random() % 6) {
+            case 0:
+            case 1:
+                next.insert(next.begin() + pos, bytes.begin(), bytes.end());
+                REQUIRE(document.Insert(pos, bytes));
+                break;
+            case 2: {
+                size_t count = std::min<size_t>(random() % 7 + 1, state.size() - pos);
+                if (count == 0) continue;
+                next.erase(next.begin() + pos, next.begin() + pos + count);
+                REQUIRE(document.Erase(pos, count));
+                break;
+            }
+            case 3:
+                if (next.size() < pos + bytes.size()) next.resize(pos + bytes.size());
+                std::copy(bytes.begin(), bytes.end(), next.begin() + pos);
+                REQUIRE(document.Overwrite(pos, bytes));
+                break;
+            case 4:
+                REQUIRE(document.Undo() == (current > 0));
+                if (current > 0) current--;
+                continue;
+            default:
+                REQUIRE(document.Redo() == (current + 1 < states.size()));
+                if (current + 1 < states.size()) current++;
+                continue;
+        }
+        states.resize(current + 1);
+        states.push_back(std::move(next));
+        current++;
+
+        const std::vector<uint8_t>& expected = states[current];
+        REQUIRE(document.Size() == expected.size());
+        if (step % 97 == 0) CHECK(document.Bytes() == expected);
+        size_t readPos = expected.empty() ? 0 : random() % expected.size();
+        uint8_t buffer[40];
+        size_t read = document.Read(readPos, sizeof(buffer), buffer);
+        REQUIRE(read == std::min(sizeof(buffer), expected.size() - readPos));
+        CHECK(std::equal(buffer, buffer + read, expected.begin() + readPos));
+    }
+
+    while (document.Undo()) {}
+    CHECK(document.Bytes() == original);
+}
+
+TEST(HexDocument, FormatRows) {
+    const uint8_t data[] = { 'H', 'e', 'l', 'l', 'o', 0, 1, 0x7F, 0x80, 0xFF, ' ', '~', 'A', 'B', 'C', 'D', 'E', 'F', 9 };
+    std::string out;
+    FormatHexRows(data, sizeof(data), 0x10, {}, out);
+    CHECK(out ==
+          "00000010  48 65 6C 6C 6F 00 01 7F  80 FF 20 7E 41 42 43 44  |Hello..... ~ABCD|\n"
+          "00000020  45 46 09                                          |EF.             |\n");
+    CHECK(HexRowWidth({}) == 78);
+
+    HexLayout narrow;
+    narrow.bytesPerRow = 4;
+    narrow.groupSize = 0;
+    narrow.ascii = false;
+    out.clear();
+    FormatHexRows(data, 6, 0, narrow, out);
+    CHECK(out == "00000000  48 65 6C 6C\n00000004  6F 00      \n");
+    CHECK(HexRowWidth(narrow) == 21);
+
+    out.clear();
+    FormatHexBytes(data, 3, out);
+    CHECK(out == "48 65 6C");
+
+    // Rows from the document match rows formatted from its bytes
+    HexDocument document(std::vector<uint8_t>(data, data + sizeof(data)));
+    out.clear();
+    document.FormatRows(1, 5, {}, out);
+    CHECK(out == "00000010  45 46 09                                          |EF.             |\n");
+}
@@ -0,0 +1,110 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the offline hive backend: name folding and hostile subkey lists.
+ */
+
+#include "Fixtures.h"
+#include "HiveFixtures.h"
+#include "Test.h"
+
+#include "HiveBackend.h"
+#include "MemoryBackend.h"
+
+using namespace core;
+
+namespace {
+
+// ROOT\A\B\C, one value each
+std::vector<uint8_t> ChainHive() {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr c = root->CreateSubKey(L"A\\B\\C");
+    if (!c) return {};
+    for (const wchar_t* path : { L"A", L"A\\B", L"A\\B\\C" }) {
+        root->OpenSubKey(path)->SetValue({ L"v", VALUE_SZ, EncodeString(path) });
+    }
+    return test::HiveImage(*root);
+}
+
+} // namespace
+
+// Hives sort subkeys by upper-case code unit; lookups must fold the same
+// way whatever the C library locale is
+TEST(HiveBackend, NonAsciiNamesFoldLikeTheHive) {
+    CHECK(FoldChar(L'é') == L'É');        // e acute
+    CHECK(FoldChar(L'ÿ') == L'Ÿ');        // y diaeresis
+    CHECK(FoldChar(L'÷') == L'÷');        // division sign
+    CHECK(FoldChar(L'ā') == L'Ā');
+    CHECK(FoldChar(L'Ā') == L'Ā');
+    CHECK(FoldChar(L'ς') == L'Σ');        // final sigma
+    CHECK(FoldChar(L'я') == L'Я');        // Cyrillic ya
+    CHECK(FoldChar(L'ё') == L'Ё');
+    CHECK(FoldChar(L'ａ') == L'Ａ');
+    CHECK(NamesEqual(L"éclair", L"ÉCLAIR"));
+    CHECK(CompareNames(L"é", L"Ê") < 0);  // Folded: U+00C9 before U+00CA
+
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    const wchar_t* names[] = { L"éclair", L"Être", L"Zulu", L"ярлык",
+                               L"ÿes", L"Ärger", L"plain" };
+    for (const wchar_t* name : names) REQUIRE(root->CreateSubKey(name));
+    std::vector<uint8_t> image = test::HiveImage(*root);
+    HiveBackend hive;
+    REQUIRE(hive.Attach(image.data(), image.size()));
+    KeyPtr hiveRoot = hive.OpenRoot();
+    REQUIRE(hiveRoot);
+
+    for (const wchar_t* name : names) {
+        CHECK(hiveRoot->OpenSubKey(name));
+        CHECK(hiveRoot->OpenSubKey(FoldName(name)));
+    }
+    CHECK(hiveRoot->OpenSubKey(L"ÉCLAIR"));
+    CHECK(hiveRoot->OpenSubKey(L"ЯРЛЫК"));
+    CHECK(!hiveRoot->OpenSubKey(L"eclair"));
+}
+
+TEST(HiveBackend, SubKeyLoopIsRefused) {
+    std::vector<uint8_t> image = ChainHive();
+    REQUIRE(!image.empty());
+    uint32_t a = test::KeyCell(image, L"A");
+    uint32_t b = test::KeyCell(image, L"A\\B");
+    REQUIRE(a != hive::INVALID_CELL && b != hive::INVALID_CELL);
+    REQUIRE(test::PointFirstSubKeyAt(image, b, a));    // B now lists A
+
+    HiveBackend hive;
+    REQUIRE(hive.Attach(image.data(), image.size()));
+    KeyPtr root = hive.OpenRoot();
+    REQUIRE(root);
+    KeyPtr keyB = root->OpenSubKey(L"A\\B");
+    REQUIRE(keyB);
+    std::vector<std::wstring> names;
+    keyB->GetSubKeyNames(names);
+    REQUIRE(names.size() == 1);
+    CHECK(names[0] == L"A");
+    CHECK(!keyB->OpenSubKey(L"A"));
+    CHECK(!root->OpenSubKey(L"A\\B\\A"));
+    CHECK(!root->OpenSubKey(L"A\\B\\A\\B"));
+
+    // A key opened by cell starts a new path
+    KeyPtr fromB = hive.OpenCell(b);
+    REQUIRE(fromB);
+    KeyPtr loopA = fromB->OpenSubKey(L"A");
+    REQUIRE(loopA);
+    CHECK(!loopA->OpenSubKey(L"B"));
+}
+
+TEST(HiveBackend, SelfLoopIsRefused) {
+    std::vector<uint8_t> image = ChainHive();
+    uint32_t a = test::KeyCell(image, L"A");
+    REQUIRE(test::PointFirstSubKeyAt(image, a, a));
+
+    HiveBackend hive;
+    REQUIRE(hive.Attach(image.data(), image.size()));
+    KeyPtr keyA = hive.OpenRoot()->OpenSubKey(L"A");
+    REQUIRE(keyA);
+    CHECK(!keyA->OpenSubKey(L"A"));
+    RegValue value;
+    CHECK(keyA->GetValue(L"v", value));
+}
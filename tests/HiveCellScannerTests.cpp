@@ -0,0 +1,224 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for the raw cell scanner on hives with deleted and unlinked
+ * records and names the Win32 API cannot show.
+ */
+
+#include "Fixtures.h"
+#include "HiveFixtures.h"
+#include "Test.h"
+
+#include "HiveCellScanner.h"
+#include "MemoryBackend.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace core;
+using namespace core::hive;
+
+namespace {
+
+// Drop the first entry of a key's (lf/lh/li) subkey list, as deleting or
+// unlinking that subkey would
+bool UnlinkFirstSubKey(std::vector<uint8_t>& image, uint32_t parent) {
+    uint8_t* node = test::MutableCell(image, parent);
+    uint32_t count = node ? ReadU32(node + NK_SUBKEY_COUNT) : 0;
+    uint8_t* list = count ? test::MutableCell(image, ReadU32(node + NK_SUBKEY_LIST)) : nullptr;
+    if (!list || ReadU16(list) == SIG_RI) return false;
+    size_t entry = ReadU16(list) == SIG_LI ? 4 : 8;
+    std::memmove(list + LIST_ENTRIES, list + LIST_ENTRIES + entry, entry * (count - 1));
+    WriteU16(list + LIST_COUNT, static_cast<uint16_t>(count - 1));
+    WriteU32(node + NK_SUBKEY_COUNT, count - 1);
+    return true;
+}
+
+// Mark an allocated cell free, keeping its contents
+void FreeCell(std::vector<uint8_t>& image, uint32_t offset) {
+    uint8_t* header = image.data() + BASE_BLOCK_SIZE + offset;
+    int32_t size = static_cast<int32_t>(ReadU32(header));
+    if (size < 0) WriteU32(header, static_cast<uint32_t>(-size));
+}
+
+const CellFinding* Find(const std::vector<CellFinding>& findings, CellFindingKind kind, const std::wstring& name) {
+    for (const CellFinding& finding : findings) {
+        if (finding.kind == kind && finding.name == name) return &finding;
+    }
+    return nullptr;
+}
+
+size_t Count(const std::vector<CellFinding>& findings, CellFindingKind kind) {
+    size_t count = 0;
+    for (const CellFinding& finding : findings) count += finding.kind == kind;
+    return count;
+}
+
+// Parent\Deleted (with a value), Parent\Kept, Parent\Unlinked
+std::vector<uint8_t> Fixture() {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr deleted = root->CreateSubKey(L"Parent\\Deleted");
+    KeyPtr kept = root->CreateSubKey(L"Parent\\Kept");
+    if (!deleted || !kept) return {};
+    deleted->SetValue({ L"Secret", VALUE_SZ, EncodeString(L"recover me, please") });
+    kept->SetValue({ L"Visible", VALUE_DWORD, { 1, 0, 0, 0 } });
+    return test::HiveImage(*root);
+}
+
+} // namespace
+
+TEST(HiveCellScanner, CleanHiveHasNoFindings) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    test::FillTree(*root, 6, 3, 3);
+    std::vector<uint8_t> image = test::HiveImage(*root);
+    HiveReader reader;
+    REQUIRE(reader.Open(image.data(), image.size()));
+
+    std::vector<CellFinding> findings;
+    CellScanStats stats = ScanHiveCells(reader, findings);
+    CHECK(findings.empty());
+    CHECK(stats.bins > 0);
+    CHECK(stats.allocatedCells > 259);
+    CHECK(!stats.cancelled);
+}
+
+TEST(HiveCellScanner, DeletedRecords) {
+    std::vector<uint8_t> image = Fixture();
+    uint32_t parent = test::KeyCell(image, L"Parent");
+    uint32_t deleted = test::KeyCell(image, L"Parent\\Deleted");
+    REQUIRE(parent != INVALID_CELL && deleted != INVALID_CELL);
+
+    HiveReader reader;
+    REQUIRE(reader.Open(image.data(), image.size()));
+    HiveKeyNode node;
+    std::vector<uint32_t> values;
+    REQUIRE(reader.ReadKeyNode(deleted, node) && reader.GetValueCells(node, values) && values.size() == 1);
+    HiveValueNode value;
+    REQUIRE(reader.ReadValueNode(values[0], value));
+
+    // Delete the key the way the registry does: unlink it, free its cells
+    REQUIRE(UnlinkFirstSubKey(image, parent));
+    FreeCell(image, deleted);
+    FreeCell(image, node.valueList);
+    FreeCell(image, values[0]);
+    FreeCell(image, value.dataOffset);
+    REQUIRE(reader.Open(image.data(), image.size()));
+
+    for (unsigned threads : { 1u, 3u }) {
+        std::vector<CellFinding> findings;
+        CellScanOptions options;
+        options.threadCount = threads;
+        ScanHiveCells(reader, findings, options);
+
+        const CellFinding* key = Find(findings, CellFindingKind::DeletedKey, L"Deleted");
+        REQUIRE(key);
+        CHECK(key->offset == deleted);
+        CHECK(key->path.ends_with(L"Parent\\Deleted"));
+        CHECK(key->lastWriteTime == node.lastWriteTime);
+
+        const CellFinding* secret = Find(findings, CellFindingKind::DeletedValue, L"Secret");
+        REQUIRE(secret);
+        CHECK(secret->valueType == VALUE_SZ);
+        CHECK(secret->dataSize == value.dataSize);
+        CHECK(secret->dataRecoverable);
+
+        CHECK(Count(findings, CellFindingKind::OrphanedKey) == 0);
+        CHECK(Count(findings, CellFindingKind::OrphanedCell) == 0);
+        for (size_t i = 1; i < findings.size(); i++) CHECK(findings[i - 1].offset <= findings[i].offset);
+    }
+
+    std::vector<CellFinding> findings;
+    CellScanOptions options;
+    options.scanFreeCells = false;
+    ScanHiveCells(reader, findings, options);
+    CHECK(findings.empty());
+}
+
+TEST(HiveCellScanner, UnlinkedKeyIsOrphaned) {
+    std::vector<uint8_t> image = Fixture();
+    uint32_t parent = test::KeyCell(image, L"Parent");
+    uint32_t deleted = test::KeyCell(image, L"Parent\\Deleted");
+    REQUIRE(UnlinkFirstSubKey(image, parent));      // Cells stay allocated
+
+    HiveReader reader;
+    REQUIRE(reader.Open(image.data(), image.size()));
+    std::vector<CellFinding> findings;
+    ScanHiveCells(reader, findings);
+    const CellFinding* key = Find(findings, CellFindingKind::OrphanedKey, L"Deleted");
+    REQUIRE(key);
+    CHECK(key->offset == deleted);
+    CHECK(Find(findings, CellFindingKind::OrphanedValue, L"Secret"));
+    CHECK(Count(findings, CellFindingKind::OrphanedCell) == 2);     // Value list and string data
+    CHECK(!Find(findings, CellFindingKind::OrphanedKey, L"Kept"));
+}
+
+TEST(HiveCellScanner, HiddenNames) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    std::wstring nulName(L"Run\0Hidden", 10);
+    KeyPtr hidden = root->CreateSubKey(nulName);
+    KeyPtr plain = root->CreateSubKey(L"Plain");
+    REQUIRE(hidden && plain);
+    std::wstring surrogate = L"Value";
+    surrogate += static_cast<wchar_t>(0xD800);
+    plain->SetValue({ surrogate, VALUE_SZ, EncodeString(L"x") });
+    plain->SetValue({ std::wstring(L"A\0B", 3), VALUE_DWORD, { 0, 0, 0, 0 } });
+    plain->SetValue({ L"Normal", VALUE_DWORD, { 0, 0, 0, 0 } });
+    std::vector<uint8_t> image = test::HiveImage(*root);
+
+    HiveReader reader;
+    REQUIRE(reader.Open(image.data(), image.size()));
+    std::vector<CellFinding> findings;
+    ScanHiveCells(reader, findings);
+    CHECK(findings.size() == 3);
+    const CellFinding* key = Find(findings, CellFindingKind::NameWithNul, nulName);
+    REQUIRE(key);
+    CHECK(key->offset == test::KeyCell(image, nulName));
+    CHECK(Find(findings, CellFindingKind::InvalidUtf16Name, surrogate));
+    const CellFinding* value = Find(findings, CellFindingKind::NameWithNul, std::wstring(L"A\0B", 3));
+    REQUIRE(value);
+    CHECK(value->path.ends_with(L"Plain"));
+
+    CellScanOptions options;
+    options.checkNames = false;
+    findings.clear();
+    ScanHiveCells(reader, findings, options);
+    CHECK(findings.empty());
+}
+
+// A cancelled scan must not report the cells it never reached as orphans
+TEST(HiveCellScanner, CancelledScanReportsNothing) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    test::FillTree(*root, 30, 3, 2);
+    std::vector<uint8_t> image = test::HiveImage(*root);
+    HiveReader reader;
+    REQUIRE(reader.Open(image.data(), image.size()));
+
+    std::stop_source stopped;
+    stopped.request_stop();
+    std::vector<CellFinding> findings;
+    CellScanOptions options;
+    options.stopToken = stopped.get_token();
+    CHECK(ScanHiveCells(reader, findings, options).cancelled);
+    CHECK(findings.empty());
+
+    // Stop at varying points; the hive is clean, so any finding is spurious
+    for (int delay = 0; delay < 40; delay++) {
+        std::stop_source stop;
+        options.stopToken = stop.get_token();
+        options.threadCount = 2;
+        std::jthread canceller([&stop, delay] {
+            std::this_thread::sleep_for(std::chrono::microseconds(delay * 250));
+            stop.request_stop();
+        });
+        findings.clear();
+        ScanHiveCells(reader, findings, options);
+        canceller.join();
+        CHECK(findings.empty());
+    }
+}
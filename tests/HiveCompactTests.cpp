@@ -0,0 +1,280 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for hive export and compaction: written hives are read back both
+ * through HiveBackend and through a minimal regf walker kept here, so a
+ * mistake shared by HiveWriter and HiveReader cannot hide itself.
+ */
+
+#include "Fixtures.h"
+#include "HiveFixtures.h"
+#include "Test.h"
+
+#include "HiveBackend.h"
+#include "HiveCompact.h"
+#include "MemoryBackend.h"
+
+#include <filesystem>
+
+using namespace core;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Independent reader: offsets straight from the regf layout, no HiveFormat
+// constants, producing the same listing as test::DumpTree
+// ---------------------------------------------------------------------------
+
+class RawHive {
+public:
+    explicit RawHive(const std::vector<uint8_t>& image) : m_image(image) {}
+
+    std::wstring Dump() {
+        if (m_image.size() < 4096 + 32 || U32(0) != 0x66676572) return L"no regf signature";
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < 508; i += 4) checksum ^= U32(i);
+        if (checksum != U32(508)) return L"bad base block checksum";
+        if (U32(0x28) != m_image.size() - 4096) return L"hbins size does not match the file";
+        for (size_t bin = 4096; bin < m_image.size(); bin += U32(bin + 8)) {
+            if (U32(bin) != 0x6E696268 || U32(bin + 4) != bin - 4096 || U32(bin + 8) % 4096 != 0 || U32(bin + 8) == 0) {
+                return L"bad hbin at " + std::to_wstring(bin);
+            }
+        }
+        std::wstring text;
+        DumpKey(U32(0x24), L"", text);
+        return m_failed ? L"damaged: " + text : text;
+    }
+
+private:
+    uint32_t U32(size_t at) const {
+        if (at + 4 > m_image.size()) return 0;
+        return m_image[at] | (m_image[at + 1] << 8) | (m_image[at + 2] << 16) | (uint32_t(m_image[at + 3]) << 24);
+    }
+
+    uint16_t U16(size_t at) const {
+        if (at + 2 > m_image.size()) return 0;
+        return static_cast<uint16_t>(m_image[at] | (m_image[at + 1] << 8));
+    }
+
+    // File position of an allocated cell's payload, 0 if it is not one
+    size_t Cell(uint32_t offset, const char* signature = nullptr) {
+        size_t at = size_t{4096} + offset;
+        int32_t size = static_cast<int32_t>(U32(at));
+        if (offset % 8 != 0 || at + 8 > m_image.size() || size >= 0 || at - size > m_image.size() ||
+            (signature && (m_image[at + 4] != signature[0] || m_image[at + 5] != signature[1]))) {
+            m_failed = true;
+            return 0;
+        }
+        return at + 4;
+    }
+
+    std::wstring Name(size_t at, size_t length, bool latin1) const {
+        std::wstring name;
+        if (latin1) {
+            for (size_t i = 0; i < length; i++) name += static_cast<wchar_t>(m_image[at + i]);
+        } else {
+            for (size_t i = 0; i + 1 < length; i += 2) name += static_cast<wchar_t>(U16(at + i));
+        }
+        return name;
+    }
+
+    void SubKeys(uint32_t list, std::vector<uint32_t>& cells) {
+        size_t at = Cell(list);
+        if (!at) return;
+        uint16_t count = U16(at + 2);
+        std::string signature(reinterpret_cast<const char*>(&m_image[at]), 2);
+        for (uint16_t i = 0; i < count; i++) {
+            if (signature == "lf" || signature == "lh") cells.push_back(U32(at + 4 + i * 8));
+            else if (signature == "li") cells.push_back(U32(at + 4 + i * 4));
+            else if (signature == "ri") SubKeys(U32(at + 4 + i * 4), cells);
+            else m_failed = true;
+        }
+    }
+
+    std::vector<uint8_t> Data(uint32_t size, uint32_t offset, size_t field) {
+        if (size & 0x80000000) {
+            size &= 0x7FFFFFFF;
+            return { m_image.begin() + field, m_image.begin() + field + std::min<uint32_t>(size, 4) };
+        }
+        std::vector<uint8_t> data;
+        size_t at = Cell(offset);
+        if (!at) return data;
+        if (size > 16344 && m_image[at] == 'd' && m_image[at + 1] == 'b') {
+            size_t segments = Cell(U32(at + 4));
+            for (uint16_t i = 0; segments && i < U16(at + 2) && data.size() < size; i++) {
+                size_t segment = Cell(U32(segments + i * 4));
+                if (!segment) return data;
+                size_t take = std::min<size_t>(16344, size - data.size());
+                data.insert(data.end(), m_image.begin() + segment, m_image.begin() + segment + take);
+            }
+        } else {
+            data.assign(m_image.begin() + at, m_image.begin() + at + size);
+        }
+        if (data.size() != size) m_failed = true;
+        return data;
+    }
+
+    void DumpKey(uint32_t cell, const std::wstring& path, std::wstring& text) {
+        static const wchar_t digits[] = L"0123456789ABCDEF";
+        size_t nk = Cell(cell, "nk");
+        if (!nk) return;
+        text += L"[" + path + L"]\n";
+
+        uint32_t valueCount = U32(nk + 0x24);
+        size_t valueList = valueCount ? Cell(U32(nk + 0x28)) : 0;
+        for (uint32_t i = 0; valueList && i < valueCount; i++) {
+            size_t vk = Cell(U32(valueList + i * 4), "vk");
+            if (!vk) return;
+            text += Name(vk + 0x14, U16(vk + 2), U16(vk + 0x10) & 1) + L"=" + std::to_wstring(U32(vk + 0x0C)) + L":";
+            for (uint8_t byte : Data(U32(vk + 4), U32(vk + 8), vk + 8)) {
+                text += digits[byte >> 4];
+                text += digits[byte & 15];
+            }
+            text += L"\n";
+        }
+
+        std::vector<uint32_t> children;
+        if (U32(nk + 0x14)) SubKeys(U32(nk + 0x1C), children);
+        if (children.size() != U32(nk + 0x14)) m_failed = true;
+        for (uint32_t child : children) {
+            size_t childNk = Cell(child, "nk");
+            if (!childNk || U32(childNk + 0x10) != cell) {
+                m_failed = true;            // Parent link must lead back here
+                return;
+            }
+            DumpKey(child, path + L"\\" + Name(childNk + 0x4C, U16(childNk + 0x48), U16(childNk + 2) & 0x20), text);
+        }
+    }
+
+    const std::vector<uint8_t>& m_image;
+    bool m_failed = false;
+};
+
+// A tree that reaches every writer path: ri indexes, big data, resident
+// data, the default value and names that are not Latin-1
+void FillMixedTree(RegistryKey& root) {
+    test::FillTree(root, 4, 3, 4);
+    root.SetValue({ L"", VALUE_SZ, EncodeString(L"default") });
+    for (uint8_t size = 0; size <= 5; size++) {
+        root.SetValue({ L"Small" + std::to_wstring(size), VALUE_BINARY, std::vector<uint8_t>(size, uint8_t(0xA0 + size)) });
+    }
+    std::vector<uint8_t> big(40000);
+    for (size_t i = 0; i < big.size(); i++) big[i] = static_cast<uint8_t>(i * 7);
+    root.SetValue({ L"Big", VALUE_BINARY, big });
+
+    KeyPtr wide = root.CreateSubKey(L"Wide");
+    for (int i = 0; wide && i < 1200; i++) wide->CreateSubKey(L"Child" + std::to_wstring(i));
+    KeyPtr named = root.CreateSubKey(L"Ω Омега");
+    if (named) named->SetValue({ L"имя", VALUE_DWORD, { 1, 2, 3, 4 } });
+    root.CreateSubKey(L"café");
+}
+
+// Key1\Key2\Loop\Child, each with one value
+std::vector<uint8_t> LoopSource(MemoryBackend& backend) {
+    KeyPtr root = backend.OpenRoot();
+    for (const wchar_t* path : { L"Key1", L"Key1\\Key2", L"Key1\\Key2\\Loop", L"Key1\\Key2\\Loop\\Child" }) {
+        KeyPtr key = root->CreateSubKey(path);
+        if (key) key->SetValue({ L"v", VALUE_DWORD, { 7, 0, 0, 0 } });
+    }
+    return test::HiveImage(*root, "source");
+}
+
+bool Compact(const std::vector<uint8_t>& image, std::vector<uint8_t>& output, HiveCompactReport& report) {
+    HiveReader reader;
+    std::filesystem::path path = test::TempDirectory() / "compacted";
+    if (!reader.Open(image.data(), image.size()) || !CompactHive(reader, path, report)) return false;
+    output = test::LoadFile(path);
+    return true;
+}
+
+std::wstring BackendDump(const std::vector<uint8_t>& image) {
+    HiveBackend hive;
+    KeyPtr root = hive.Attach(image.data(), image.size()) ? hive.OpenRoot() : nullptr;
+    return root ? test::DumpTree(*root) : L"unreadable";
+}
+
+} // namespace
+
+TEST(HiveCompact, ExportRoundTrip) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    FillMixedTree(*root);
+    std::wstring expected = test::DumpTree(*root);
+
+    std::vector<uint8_t> image = test::HiveImage(*root);
+    REQUIRE(!image.empty());
+    CHECK(BackendDump(image) == expected);
+    CHECK(RawHive(image).Dump() == expected);
+}
+
+TEST(HiveCompact, CompactRoundTrip) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    FillMixedTree(*root);
+    std::wstring expected = test::DumpTree(*root);
+
+    std::vector<uint8_t> compacted;
+    HiveCompactReport report;
+    REQUIRE(Compact(test::HiveImage(*root), compacted, report));
+    CHECK(report.error.empty());
+    CHECK(report.skippedKeys == 0);
+    CHECK(report.after.freeBytes <= report.before.freeBytes);
+    CHECK(BackendDump(compacted) == expected);
+    CHECK(RawHive(compacted).Dump() == expected);
+
+    // A second pass has nothing left to pack
+    std::vector<uint8_t> again;
+    REQUIRE(Compact(compacted, again, report));
+    CHECK(again.size() == compacted.size());
+    CHECK(RawHive(again).Dump() == expected);
+}
+
+TEST(HiveCompact, SubKeyLoopIsLeftOut) {
+    MemoryBackend backend;
+    std::vector<uint8_t> image = LoopSource(backend);
+    REQUIRE(!image.empty());
+    uint32_t key1 = test::KeyCell(image, L"Key1");
+    uint32_t loop = test::KeyCell(image, L"Key1\\Key2\\Loop");
+    REQUIRE(key1 != hive::INVALID_CELL && loop != hive::INVALID_CELL);
+
+    // Loop lists Key1 instead of Child, then itself
+    MemoryBackend expectedBackend;
+    KeyPtr expectedRoot = expectedBackend.OpenRoot();
+    for (const wchar_t* path : { L"Key1", L"Key1\\Key2", L"Key1\\Key2\\Loop" }) {
+        KeyPtr key = expectedRoot->CreateSubKey(path);
+        REQUIRE(key);
+        key->SetValue({ L"v", VALUE_DWORD, { 7, 0, 0, 0 } });
+    }
+    std::wstring expected = test::DumpTree(*expectedRoot);
+
+    for (uint32_t target : { key1, loop }) {
+        std::vector<uint8_t> damaged = image;
+        REQUIRE(test::PointFirstSubKeyAt(damaged, loop, target));
+        std::vector<uint8_t> compacted;
+        HiveCompactReport report;
+        REQUIRE(Compact(damaged, compacted, report));
+        CHECK(report.skippedKeys == 1);
+        CHECK(report.writer.keys == 4);
+        CHECK(RawHive(compacted).Dump() == expected);
+    }
+}
+
+TEST(HiveCompact, ExportRefusesTooDeepKeys) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr key = root->CreateSubKey(L"K");
+    for (size_t depth = 1; key && depth < MAX_KEY_DEPTH; depth++) key = key->CreateSubKey(L"K");
+    REQUIRE(key);
+
+    std::filesystem::path path = test::TempDirectory() / "deep";
+    HiveWriterStats stats;
+    std::wstring error;
+    CHECK(ExportHive(*root, L"ROOT", path, stats, error));
+    CHECK(stats.keys == MAX_KEY_DEPTH + 1);
+
+    REQUIRE(key->CreateSubKey(L"K"));
+    CHECK(!ExportHive(*root, L"ROOT", path, stats, error));
+    CHECK(!error.empty());
+    CHECK(!std::filesystem::exists(path));
+}
@@ -0,0 +1,87 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Hive images for the tests: written from any key with ExportHive, then
+ * patched in memory to build damaged or hostile hives.
+ */
+
+#pragma once
+
+#include "Test.h"
+
+#include "HiveCompact.h"
+#include "HiveFormat.h"
+#include "HiveReader.h"
+#include "RegistryTypes.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace test {
+
+inline std::vector<uint8_t> LoadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), {} };
+}
+
+inline void SaveFile(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        .write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Save key as a hive in the case's temp directory and return the image
+inline std::vector<uint8_t> HiveImage(const core::RegistryKey& key, const std::string& fileName = "hive") {
+    std::filesystem::path path = TempDirectory() / fileName;
+    core::HiveWriterStats stats;
+    std::wstring error;
+    if (!core::ExportHive(key, L"ROOT", path, stats, error)) return {};
+    return LoadFile(path);
+}
+
+// nk cell of the key at path (relative to the root), or INVALID_CELL
+inline uint32_t KeyCell(const std::vector<uint8_t>& image, std::wstring_view path) {
+    core::HiveReader reader;
+    if (!reader.Open(image.data(), image.size())) return core::hive::INVALID_CELL;
+    uint32_t cell = reader.RootCell();
+    std::vector<uint32_t> cells;
+    for (std::wstring_view part : core::SplitPath(path)) {
+        core::HiveKeyNode node;
+        if (!reader.ReadKeyNode(cell, node) || !reader.GetSubKeyCells(node, cells)) return core::hive::INVALID_CELL;
+        cell = core::hive::INVALID_CELL;
+        for (uint32_t child : cells) {
+            core::HiveKeyNode childNode;
+            if (reader.ReadKeyNode(child, childNode) &&
+                core::NamesEqual(core::HiveReader::DecodeName(childNode.name, childNode.nameLength,
+                                                              childNode.compressedName), part)) {
+                cell = child;
+                break;
+            }
+        }
+        if (cell == core::hive::INVALID_CELL) break;
+    }
+    return cell;
+}
+
+// Writable payload of a cell
+inline uint8_t* MutableCell(std::vector<uint8_t>& image, uint32_t offset) {
+    core::HiveReader reader;
+    if (!reader.Open(image.data(), image.size())) return nullptr;
+    const uint8_t* cell = reader.Cell(offset);
+    return cell ? image.data() + (cell - image.data()) : nullptr;
+}
+
+// Make the first entry of parent's (lf/lh/li) subkey list point at target
+inline bool PointFirstSubKeyAt(std::vector<uint8_t>& image, uint32_t parent, uint32_t target) {
+    uint8_t* node = MutableCell(image, parent);
+    if (!node || core::hive::ReadU32(node + core::hive::NK_SUBKEY_COUNT) == 0) return false;
+    uint8_t* list = MutableCell(image, core::hive::ReadU32(node + core::hive::NK_SUBKEY_LIST));
+    if (!list || core::hive::ReadU16(list) == core::hive::SIG_RI) return false;
+    core::hive::WriteU32(list + core::hive::LIST_ENTRIES, target);
+    return true;
+}
+
+} // namespace test
@@ -0,0 +1,116 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Transaction logs for the tests and benchmarks: hives written with
+ * HiveWriter in a few variants, and new-format (HvLE) logs that carry the
+ * pages one variant needs to become another.
+ */
+
+#pragma once
+
+#include "HiveFormat.h"
+#include "HiveRecovery.h"
+#include "HiveWriter.h"
+#include "RegistryTypes.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace test {
+
+// A hive of keyCount keys with two values each, written to path. Variant 1
+// changes a few values; variant 2 also adds keys, so the hive grows.
+inline std::vector<uint8_t> MakeHive(const std::filesystem::path& path, int keyCount, int variant) {
+    core::HiveWriter writer;
+    if (!writer.Create(path) || !writer.BeginKey({ L"ROOT" })) return {};
+    for (int i = 0; i < keyCount; i++) {
+        std::wstring name = L"Key" + std::to_wstring(1000000 + i);
+        writer.BeginKey({ name });
+        uint32_t number = (variant && i % 97 == 0) ? i + variant : i;
+        writer.AddValue(L"v", core::VALUE_DWORD, { reinterpret_cast<const uint8_t*>(&number), 4 });
+        writer.AddValue(L"s", core::VALUE_SZ, core::EncodeString(std::wstring(20 + i % 13, L'a')));
+        writer.EndKey();
+    }
+    for (int i = 0; variant > 1 && i < 500; i++) {
+        writer.BeginKey({ L"New" + std::to_wstring(10000 + i) });
+        writer.AddValue(L"x", core::VALUE_DWORD, { reinterpret_cast<const uint8_t*>(&i), 4 });
+        writer.EndKey();
+    }
+    if (!writer.EndKey() || !writer.Finish()) return {};
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), {} };
+}
+
+inline void SetSequences(uint8_t* base, uint32_t primary, uint32_t secondary, uint32_t fileType) {
+    using namespace core::hive;
+    WriteU32(base + BASE_PRIMARY_SEQUENCE, primary);
+    WriteU32(base + BASE_SECONDARY_SEQUENCE, secondary);
+    WriteU32(base + BASE_FILE_TYPE, fileType);
+    WriteU32(base + BASE_CHECKSUM, BaseBlockChecksum(base));
+}
+
+inline uint32_t HbinsSize(const std::vector<uint8_t>& hive) {
+    return core::hive::ReadU32(hive.data() + core::hive::BASE_HBINS_SIZE);
+}
+
+// Offsets (from the first hbin) of the pages of to that differ from from
+inline std::vector<uint32_t> ChangedPages(const std::vector<uint8_t>& from, const std::vector<uint8_t>& to) {
+    using namespace core::hive;
+    std::vector<uint32_t> pages;
+    for (uint32_t offset = 0; offset < HbinsSize(to); offset += LOG_PAGE_SIZE) {
+        size_t start = BASE_BLOCK_SIZE + offset;
+        if (start + LOG_PAGE_SIZE > from.size() ||
+            std::memcmp(from.data() + start, to.data() + start, LOG_PAGE_SIZE) != 0) {
+            pages.push_back(offset);
+        }
+    }
+    return pages;
+}
+
+// Log header: the hive's base block as of sequence, marked as a log
+inline std::vector<uint8_t> LogHeader(const std::vector<uint8_t>& hive, uint32_t sequence, uint32_t fileType) {
+    std::vector<uint8_t> log(hive.begin(), hive.begin() + core::hive::LOG_BASE_BLOCK_SIZE);
+    SetSequences(log.data(), sequence, sequence, fileType);
+    return log;
+}
+
+// Append an HvLE entry carrying pages of target
+inline void AppendEntry(std::vector<uint8_t>& log, uint32_t sequence, const std::vector<uint32_t>& pages,
+                        const std::vector<uint8_t>& target) {
+    using namespace core::hive;
+    std::vector<uint8_t> entry(HVLE_PAGES + HVLE_PAGE_ENTRY_SIZE * pages.size());
+    WriteU32(entry.data(), HVLE_SIGNATURE);
+    WriteU32(entry.data() + HVLE_SEQUENCE, sequence);
+    WriteU32(entry.data() + HVLE_HBINS_SIZE, HbinsSize(target));
+    WriteU32(entry.data() + HVLE_PAGE_COUNT, static_cast<uint32_t>(pages.size()));
+    for (size_t i = 0; i < pages.size(); i++) {
+        WriteU32(entry.data() + HVLE_PAGES + HVLE_PAGE_ENTRY_SIZE * i, pages[i]);
+        WriteU32(entry.data() + HVLE_PAGES + HVLE_PAGE_ENTRY_SIZE * i + 4, LOG_PAGE_SIZE);
+    }
+    for (uint32_t page : pages) {
+        auto start = target.begin() + BASE_BLOCK_SIZE + page;
+        entry.insert(entry.end(), start, start + LOG_PAGE_SIZE);
+    }
+    entry.resize((entry.size() + LOG_SECTOR_SIZE - 1) / LOG_SECTOR_SIZE * LOG_SECTOR_SIZE);
+    WriteU32(entry.data() + HVLE_SIZE, static_cast<uint32_t>(entry.size()));
+    WriteU64(entry.data() + HVLE_HASH1, core::Marvin32(entry.data() + HVLE_PAGES, entry.size() - HVLE_PAGES, LOG_HASH_SEED));
+    WriteU64(entry.data() + HVLE_HASH2, core::Marvin32(entry.data(), HVLE_HASH2, LOG_HASH_SEED));
+    log.insert(log.end(), entry.begin(), entry.end());
+}
+
+// Same hbin area as target, and a consistent base block
+inline bool Matches(const uint8_t* image, size_t size, const std::vector<uint8_t>& target) {
+    using namespace core::hive;
+    uint32_t hbins = HbinsSize(target);
+    return size >= BASE_BLOCK_SIZE + hbins && ReadU32(image + BASE_HBINS_SIZE) == hbins &&
+           std::memcmp(image + BASE_BLOCK_SIZE, target.data() + BASE_BLOCK_SIZE, hbins) == 0 &&
+           ReadU32(image + BASE_PRIMARY_SEQUENCE) == ReadU32(image + BASE_SECONDARY_SEQUENCE) &&
+           ReadU32(image + BASE_CHECKSUM) == BaseBlockChecksum(image);
+}
+
+} // namespace test
@@ -0,0 +1,234 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Transaction log replay. Hives come from HiveWriter; a log brings an
+ * older hive up to a newer one by carrying the pages that differ.
+ */
+
+#include "HiveFixtures.h"
+#include "HiveLogFixtures.h"
+#include "Test.h"
+
+#include "HiveBackend.h"
+#include "HiveRecovery.h"
+
+#include <cstring>
+
+using namespace core;
+using namespace core::hive;
+namespace fs = std::filesystem;
+
+namespace {
+
+using test::AppendEntry;
+using test::ChangedPages;
+using test::HbinsSize;
+using test::LoadFile;
+using test::LogHeader;
+using test::Matches;
+using test::SaveFile;
+using test::SetSequences;
+
+std::vector<uint8_t> MakeHive(int keyCount, int variant) {
+    return test::MakeHive(test::TempDirectory() / ("hive" + std::to_string(variant)), keyCount, variant);
+}
+
+// Plan and apply in memory
+bool Replay(const std::vector<uint8_t>& primary, const std::vector<std::vector<uint8_t>>& logs,
+            std::vector<uint8_t>& image, HiveRecoveryStats& stats) {
+    std::vector<std::span<const uint8_t>> logSpans(logs.begin(), logs.end());
+    HiveRecoveryPlan plan;
+    std::wstring error;
+    if (!PlanHiveRecovery(primary, logSpans, plan, stats, error)) return false;
+    image = primary;
+    if (image.size() < plan.imageSize) image.resize(plan.imageSize);
+    ApplyHiveRecovery(plan, image.data());
+    return true;
+}
+
+struct Hives {
+    std::vector<uint8_t> base = MakeHive(3000, 0);
+    std::vector<uint8_t> changed = MakeHive(3000, 1);
+    std::vector<uint8_t> grown = MakeHive(3000, 2);
+    std::vector<uint8_t> dirty;         // base, with a flush started but not completed
+    uint32_t sequence = 0;              // Last complete flush of base
+
+    Hives() {
+        sequence = ReadU32(base.data() + BASE_SECONDARY_SEQUENCE);
+        dirty = base;
+        SetSequences(dirty.data(), sequence + 1, sequence, FILE_TYPE_PRIMARY);
+    }
+};
+
+} // namespace
+
+TEST(HiveRecovery, Marvin32) {
+    const uint64_t seed = 0x004FB61A001BDBCCull;
+    const uint8_t byte = 0xAF;
+    CHECK(Marvin32(nullptr, 0, seed) == 0x30ED35C100CD3C7Dull);
+    CHECK(Marvin32(&byte, 1, seed) == 0x48E73FC77D75DDC1ull);
+}
+
+TEST(HiveRecovery, CleanHiveIsUntouched) {
+    Hives hives;
+    REQUIRE(!hives.base.empty());
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(hives.base, {}, image, stats));
+    CHECK(!stats.dirty);
+    CHECK(image == hives.base);
+}
+
+// Three entries in one log, the last of which grows the hive
+TEST(HiveRecovery, NewFormatEntries) {
+    Hives hives;
+    std::vector<uint32_t> pages = ChangedPages(hives.base, hives.grown);
+    REQUIRE(pages.size() >= 3);
+    size_t third = pages.size() / 3;
+    std::vector<uint8_t> log = LogHeader(hives.base, hives.sequence, FILE_TYPE_LOG6);
+    AppendEntry(log, hives.sequence, { pages.begin(), pages.begin() + third }, hives.grown);
+    AppendEntry(log, hives.sequence + 1, { pages.begin() + third, pages.begin() + 2 * third }, hives.grown);
+    AppendEntry(log, hives.sequence + 2, { pages.begin() + 2 * third, pages.end() }, hives.grown);
+    log.resize(log.size() + LOG_PAGE_SIZE);    // Unused tail
+
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(hives.dirty, { log }, image, stats));
+    CHECK(stats.dirty);
+    CHECK(stats.entriesApplied == 3);
+    CHECK(stats.sequence == hives.sequence + 2);
+    CHECK(stats.warning.empty());
+    CHECK(Matches(image.data(), image.size(), hives.grown));
+}
+
+// Entries stop at the first one whose hash does not match
+TEST(HiveRecovery, CorruptEntryEndsTheLog) {
+    Hives hives;
+    std::vector<uint32_t> pages = ChangedPages(hives.base, hives.changed);
+    REQUIRE(pages.size() >= 2);
+    size_t half = pages.size() / 2;
+    std::vector<uint8_t> log = LogHeader(hives.base, hives.sequence, FILE_TYPE_LOG6);
+    AppendEntry(log, hives.sequence, { pages.begin(), pages.begin() + half }, hives.changed);
+    size_t second = log.size();
+    AppendEntry(log, hives.sequence + 1, { pages.begin() + half, pages.end() }, hives.changed);
+    log[second + 600] ^= 1;
+
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(hives.dirty, { log }, image, stats));
+    CHECK(stats.entriesApplied == 1);
+    REQUIRE(stats.logs.size() == 1);
+    CHECK(!stats.logs[0].error.empty());
+    CHECK(!Matches(image.data(), image.size(), hives.changed));
+}
+
+// LOG1 and LOG2 overlap by one entry; a log that starts after a gap is not used
+TEST(HiveRecovery, TwoLogsAndGaps) {
+    Hives hives;
+    std::vector<uint32_t> pages = ChangedPages(hives.base, hives.changed);
+    REQUIRE(pages.size() >= 4);
+    std::vector<std::vector<uint32_t>> parts(4);
+    for (size_t i = 0; i < pages.size(); i++) parts[i * 4 / pages.size()].push_back(pages[i]);
+
+    std::vector<uint8_t> log1 = LogHeader(hives.base, hives.sequence, FILE_TYPE_LOG6);
+    AppendEntry(log1, hives.sequence, parts[0], hives.changed);
+    AppendEntry(log1, hives.sequence + 1, parts[1], hives.changed);
+    std::vector<uint8_t> log2 = LogHeader(hives.base, hives.sequence + 1, FILE_TYPE_LOG6);
+    AppendEntry(log2, hives.sequence + 1, parts[1], hives.changed);
+    AppendEntry(log2, hives.sequence + 2, parts[2], hives.changed);
+    AppendEntry(log2, hives.sequence + 3, parts[3], hives.changed);
+
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(hives.dirty, { log1, log2 }, image, stats));
+    CHECK(stats.entriesApplied == 4);
+    CHECK(stats.sequence == hives.sequence + 3);
+    CHECK(Matches(image.data(), image.size(), hives.changed));
+
+    std::vector<uint8_t> late = LogHeader(hives.base, hives.sequence + 2, FILE_TYPE_LOG6);
+    AppendEntry(late, hives.sequence + 2, parts[2], hives.changed);
+    REQUIRE(Replay(hives.dirty, { {}, late }, image, stats));
+    CHECK(stats.entriesApplied == 0);
+    CHECK(!stats.warning.empty());
+    CHECK(std::memcmp(image.data(), hives.dirty.data(), hives.dirty.size()) == 0);
+}
+
+// Old format: a DIRT bitmap of 512-byte sectors, then the dirty sectors
+TEST(HiveRecovery, OldFormatLog) {
+    Hives hives;
+    uint32_t sectors = HbinsSize(hives.changed) / LOG_SECTOR_SIZE;
+    std::vector<uint8_t> log = LogHeader(hives.changed, hives.sequence, FILE_TYPE_LOG1);
+    std::vector<uint8_t> bitmap(DIRT_BITMAP + (sectors + 7) / 8);
+    WriteU32(bitmap.data(), DIRT_SIGNATURE);
+    std::vector<uint8_t> data;
+    for (uint32_t sector = 0; sector < sectors; sector++) {
+        size_t start = BASE_BLOCK_SIZE + static_cast<size_t>(sector) * LOG_SECTOR_SIZE;
+        if (start + LOG_SECTOR_SIZE <= hives.base.size() &&
+            std::memcmp(hives.base.data() + start, hives.changed.data() + start, LOG_SECTOR_SIZE) == 0) {
+            continue;
+        }
+        bitmap[DIRT_BITMAP + sector / 8] |= static_cast<uint8_t>(1 << (sector % 8));
+        data.insert(data.end(), hives.changed.begin() + start, hives.changed.begin() + start + LOG_SECTOR_SIZE);
+    }
+    log.insert(log.end(), bitmap.begin(), bitmap.end());
+    log.resize((log.size() + LOG_SECTOR_SIZE - 1) / LOG_SECTOR_SIZE * LOG_SECTOR_SIZE);
+    log.insert(log.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(hives.dirty, { log }, image, stats));
+    CHECK(stats.entriesApplied == 1);
+    REQUIRE(stats.logs.size() == 1);
+    CHECK(stats.logs[0].format == HiveLogFormat::Old);
+    CHECK(Matches(image.data(), image.size(), hives.changed));
+}
+
+// A damaged primary base block is taken from the log, if there is one
+TEST(HiveRecovery, DamagedBaseBlock) {
+    Hives hives;
+    std::vector<uint8_t> damaged = hives.dirty;
+    damaged[100] ^= 0xFF;
+    std::vector<uint8_t> log = LogHeader(hives.base, hives.sequence, FILE_TYPE_LOG6);
+    AppendEntry(log, hives.sequence, ChangedPages(hives.base, hives.changed), hives.changed);
+
+    std::vector<uint8_t> image;
+    HiveRecoveryStats stats;
+    REQUIRE(Replay(damaged, { log }, image, stats));
+    CHECK(stats.baseBlockFromLog);
+    CHECK(Matches(image.data(), image.size(), hives.changed));
+    CHECK(!Replay(damaged, {}, image, stats));
+}
+
+// Files on disk: logs are found next to the primary, which is never written
+TEST(HiveRecovery, RecoverFromFiles) {
+    Hives hives;
+    fs::path directory = test::TempDirectory() / "config";
+    fs::create_directories(directory);
+    fs::path primary = directory / "SYSTEM";
+    SaveFile(primary, hives.dirty);
+    std::vector<uint8_t> log = LogHeader(hives.base, hives.sequence, FILE_TYPE_LOG6);
+    AppendEntry(log, hives.sequence, ChangedPages(hives.base, hives.grown), hives.grown);
+    SaveFile(directory / "system.LOG1", log);
+    SaveFile(directory / "SYSTEM.LOG2", {});
+
+    std::vector<fs::path> logs = FindHiveLogs(primary);
+    CHECK(logs.size() == 2);
+    MappedFile view;
+    HiveRecoveryStats stats;
+    std::wstring error;
+    REQUIRE(RecoverHive(primary, logs, view, stats, error));
+    CHECK(stats.entriesApplied == 1);
+    CHECK(Matches(view.Data(), view.Size(), hives.grown));
+    view.Close();
+    CHECK(LoadFile(primary) == hives.dirty);
+
+    // The recovered tree reads like the target hive
+    HiveBackend recovered;
+    REQUIRE(recovered.OpenRecovered(primary, stats, error));
+    KeyPtr key = recovered.OpenRoot()->OpenSubKey(L"New10499");
+    REQUIRE(key);
+    RegValue value;
+    REQUIRE(key->GetValue(L"x", value));
+    CHECK((value.data == std::vector<uint8_t>{ 243, 1, 0, 0 }));
+}
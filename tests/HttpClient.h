@@ -0,0 +1,188 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Minimal blocking HTTP/1.1 client for talking to the automation server
+ * from the tests and benchmarks. Reads Content-Length and chunked bodies
+ * and keeps whatever follows a response for the next one, so pipelined
+ * requests can be sent in one go.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace test {
+
+struct HttpResponse {
+    int status = 0;
+    std::string headers;            // Raw, without the status line
+    std::string body;               // De-chunked
+};
+
+// Request text; Host, Authorization and Content-Length are added unless
+// empty, so each can be left out or replaced by extra
+inline std::string HttpRequest(std::string_view method, std::string_view target, std::string_view host,
+                               std::string_view token, std::string_view body = {}, std::string_view extra = {}) {
+    std::string text = std::string(method) + " " + std::string(target) + " HTTP/1.1\r\n";
+    if (!host.empty()) text += "Host: " + std::string(host) + "\r\n";
+    if (!token.empty()) text += "Authorization: Bearer " + std::string(token) + "\r\n";
+    if (!body.empty()) text += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    text += extra;
+    text += "\r\n";
+    text += body;
+    return text;
+}
+
+class HttpClient {
+public:
+#ifdef _WIN32
+    using Socket = SOCKET;
+    static constexpr Socket NO_SOCKET = INVALID_SOCKET;
+#else
+    using Socket = int;
+    static constexpr Socket NO_SOCKET = -1;
+#endif
+
+    HttpClient() = default;
+    ~HttpClient() { Close(); }
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    bool Connect(uint16_t port) {
+        Close();
+        m_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (m_socket == NO_SOCKET) return false;
+        int on = 1;
+        setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return connect(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    }
+
+    void Close() {
+        if (m_socket == NO_SOCKET) return;
+#ifdef _WIN32
+        closesocket(m_socket);
+#else
+        close(m_socket);
+#endif
+        m_socket = NO_SOCKET;
+        m_input.clear();
+    }
+
+    bool Send(std::string_view bytes) {
+        while (!bytes.empty()) {
+            int sent = send(m_socket, bytes.data(), static_cast<int>(bytes.size()), SEND_FLAGS);
+            if (sent <= 0) return false;
+            bytes.remove_prefix(static_cast<size_t>(sent));
+        }
+        return true;
+    }
+
+    bool Receive(HttpResponse& response) {
+        response = {};
+        size_t headerEnd;
+        while ((headerEnd = m_input.find("\r\n\r\n")) == std::string::npos) {
+            if (!Fill()) return false;
+        }
+        size_t lineEnd = m_input.find("\r\n");
+        if (m_input.compare(0, 5, "HTTP/") != 0 || m_input.find(' ') > lineEnd) return false;
+        response.status = std::atoi(m_input.c_str() + m_input.find(' ') + 1);
+        response.headers = m_input.substr(lineEnd + 2, headerEnd - lineEnd);
+        m_input.erase(0, headerEnd + 4);
+
+        if (HeaderValue(response.headers, "Transfer-Encoding") == "chunked") {
+            for (;;) {
+                size_t sizeEnd;
+                while ((sizeEnd = m_input.find("\r\n")) == std::string::npos) {
+                    if (!Fill()) return false;
+                }
+                size_t size = std::strtoul(m_input.c_str(), nullptr, 16);
+                while (m_input.size() < sizeEnd + 2 + size + 2) {
+                    if (!Fill()) return false;
+                }
+                response.body.append(m_input, sizeEnd + 2, size);
+                m_input.erase(0, sizeEnd + 2 + size + 2);
+                if (size == 0) return true;
+            }
+        }
+        size_t length = std::strtoul(HeaderValue(response.headers, "Content-Length").c_str(), nullptr, 10);
+        while (m_input.size() < length) {
+            if (!Fill()) return false;
+        }
+        response.body = m_input.substr(0, length);
+        m_input.erase(0, length);
+        return true;
+    }
+
+    // True once the server has closed the connection and nothing is left
+    bool Closed() {
+        char byte;
+        return m_input.empty() && recv(m_socket, &byte, 1, 0) <= 0;
+    }
+
+    static std::string HeaderValue(const std::string& headers, std::string_view name) {
+        size_t at = 0;
+        while (at < headers.size()) {
+            size_t end = headers.find("\r\n", at);
+            if (end == std::string::npos) end = headers.size();
+            std::string_view line(headers.data() + at, end - at);
+            size_t colon = line.find(':');
+            if (colon == name.size() && EqualsIgnoreCase(line.substr(0, colon), name)) {
+                line.remove_prefix(colon + 1);
+                while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+                return std::string(line);
+            }
+            at = end + 2;
+        }
+        return {};
+    }
+
+private:
+#if !defined(_WIN32) && defined(MSG_NOSIGNAL)
+    static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    static constexpr int SEND_FLAGS = 0;
+#endif
+
+    static bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            char x = a[i] >= 'A' && a[i] <= 'Z' ? char(a[i] + 32) : a[i];
+            char y = b[i] >= 'A' && b[i] <= 'Z' ? char(b[i] + 32) : b[i];
+            if (x != y) return false;
+        }
+        return true;
+    }
+
+    bool Fill() {
+        char buffer[16384];
+        int received = recv(m_socket, buffer, sizeof(buffer), 0);
+        if (received <= 0) return false;
+        m_input.append(buffer, static_cast<size_t>(received));
+        return true;
+    }
+
+    Socket m_socket = NO_SOCKET;
+    std::string m_input;
+};
+
+} // namespace test
@@ -0,0 +1,237 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Differential tests for the layered backend: random edits go both to a
+ * stack of layers over a base tree and to a plain MemoryBackend copy of
+ * it, and the two must answer every call the same way. Pushing, applying
+ * and discarding layers must not change what is seen, except that
+ * discarding drops the top layer's edits.
+ */
+
+#include "Fixtures.h"
+#include "Test.h"
+
+#include "LayeredBackend.h"
+#include "MemoryBackend.h"
+#include "SubtreeOps.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+constexpr unsigned FANOUT = 3;
+constexpr unsigned DEPTH = 3;
+constexpr unsigned VALUES = 3;
+
+// Listing with values and subkeys in name order and names folded, as
+// enumeration order and the spelling a layer keeps from below are not
+// part of the contract
+std::wstring SortedDump(const RegistryKey& key, const std::wstring& path = {}) {
+    static const wchar_t digits[] = L"0123456789ABCDEF";
+    std::wstring text = L"[" + path + L"]\n";
+    KeyInfo info;
+    if (key.QueryInfo(info)) {
+        text += L"#" + std::to_wstring(info.subKeyCount) + L"/" + std::to_wstring(info.valueCount) + L"\n";
+    }
+    std::vector<RegValue> values;
+    key.GetValues(values);
+    std::sort(values.begin(), values.end(),
+              [](const RegValue& a, const RegValue& b) { return CompareNames(a.name, b.name) < 0; });
+    for (const RegValue& value : values) {
+        text += FoldName(value.name) + L"=" + std::to_wstring(value.type) + L":";
+        for (uint8_t byte : value.data) {
+            text += digits[byte >> 4];
+            text += digits[byte & 15];
+        }
+        text += L"\n";
+    }
+    std::vector<std::wstring> names;
+    key.GetSubKeyNames(names);
+    std::sort(names.begin(), names.end(),
+              [](const std::wstring& a, const std::wstring& b) { return CompareNames(a, b) < 0; });
+    for (const std::wstring& name : names) {
+        KeyPtr child = key.OpenSubKey(name);
+        std::wstring childPath = path + L"\\" + FoldName(name);
+        text += child ? SortedDump(*child, childPath) : L"[" + childPath + L" unreadable]\n";
+    }
+    return text;
+}
+
+class Random {
+public:
+    explicit Random(uint32_t seed) : m_state(seed) {}
+
+    uint32_t Next(uint32_t bound) {
+        m_state = m_state * 1103515245u + 12345u;
+        return (m_state >> 8) % bound;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+// A path into the expected tree: each step stops with one chance in three
+std::wstring PickPath(RegistryKey& root, Random& random) {
+    std::wstring path;
+    KeyPtr key = root.OpenSubKey(L"");
+    std::vector<std::wstring> names;
+    while (key && random.Next(3) != 0) {
+        key->GetSubKeyNames(names);
+        if (names.empty()) break;
+        const std::wstring& name = names[random.Next(static_cast<uint32_t>(names.size()))];
+        path += path.empty() ? name : L"\\" + name;
+        key = key->OpenSubKey(name);
+    }
+    return path;
+}
+
+// Names that collide with the base tree's, in both cases
+std::wstring PickName(Random& random, const wchar_t* prefix) {
+    std::wstring name = prefix + std::to_wstring(random.Next(5));
+    if (random.Next(4) == 0) std::transform(name.begin(), name.end(), name.begin(), [](wchar_t c) { return FoldChar(c); });
+    return name;
+}
+
+struct Differential {
+    MemoryBackend base;
+    MemoryBackend expected;
+    LayeredBackend layered{ base };
+    int mismatches = 0;
+
+    Differential() {
+        test::FillTree(*base.OpenRoot(), FANOUT, DEPTH, VALUES);
+        test::FillTree(*expected.OpenRoot(), FANOUT, DEPTH, VALUES);
+    }
+
+    bool Same() {
+        return SortedDump(*layered.OpenRoot()) == SortedDump(*expected.OpenRoot());
+    }
+
+    // One random call, made on both trees; false if they answered differently
+    bool Step(Random& random) {
+        KeyPtr expectedRoot = expected.OpenRoot();
+        std::wstring path = PickPath(*expectedRoot, random);
+        KeyPtr want = expectedRoot->OpenSubKey(path);
+        KeyPtr got = layered.OpenRoot()->OpenSubKey(path);
+        if (!want || !got) return !want && !got;
+
+        switch (random.Next(20)) {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+        case 5: {
+            RegValue value{ PickName(random, L"Value"), random.Next(2) ? VALUE_DWORD : VALUE_BINARY, {} };
+            value.data.assign(random.Next(3) * 4, static_cast<uint8_t>(random.Next(3)));
+            return want->SetValue(value) == got->SetValue(value);
+        }
+        case 6:
+        case 7: {
+            std::wstring name = PickName(random, L"Value");
+            return want->DeleteValue(name) == got->DeleteValue(name);
+        }
+        case 8:
+        case 9:
+        case 10:
+        case 11: {
+            std::wstring name = PickName(random, L"Key");
+            if (random.Next(3) == 0) name += L"\\" + PickName(random, L"Key");
+            KeyPtr wantChild = want->CreateSubKey(name);
+            KeyPtr gotChild = got->CreateSubKey(name);
+            return !wantChild == !gotChild;
+        }
+        case 12:
+        case 13: {
+            std::wstring name = PickName(random, L"Key");
+            return want->DeleteSubKey(name) == got->DeleteSubKey(name);
+        }
+        case 14: {
+            if (path.empty()) return true;      // Keep the tree from emptying out
+            std::wstring name = PickName(random, L"Key");
+            SubtreeStats wantStats = DeleteSubtree(*want, name);
+            SubtreeStats gotStats = DeleteSubtree(*got, name);
+            return wantStats.keys == gotStats.keys && wantStats.errors == gotStats.errors;
+        }
+        default: {
+            std::wstring name = PickName(random, L"Value");
+            RegValue wantValue, gotValue;
+            bool found = want->GetValue(name, wantValue);
+            if (found != got->GetValue(name, gotValue)) return false;
+            if (found && (wantValue.type != gotValue.type || wantValue.data != gotValue.data)) return false;
+            std::wstring child = PickName(random, L"Key");
+            return !want->OpenSubKey(child) == !got->OpenSubKey(child);
+        }
+        }
+    }
+};
+
+} // namespace
+
+TEST(LayeredBackend, MatchesMemoryBackend) {
+    for (uint32_t seed : { 1u, 2u, 3u, 4u }) {
+        Differential run;
+        Random random(seed);
+        std::wstring original = SortedDump(*run.base.OpenRoot());
+        run.layered.PushLayer();
+        for (int step = 1; step <= 1500; step++) {
+            if (!run.Step(random)) {
+                run.mismatches++;
+                if (run.mismatches == 1) std::printf("seed %u: first mismatch at step %d\n", seed, step);
+            }
+            if (step % 100 == 0) {
+                CHECK(run.Same());
+                // More layers, and now and then one folded into the layer below
+                if (step % 300 == 0) run.layered.PushLayer();
+                if (step % 500 == 0 && run.layered.LayerCount() > 1) {
+                    LayerApplyStats stats;
+                    std::wstring error;
+                    CHECK(run.layered.ApplyLayer(stats, error));
+                    CHECK(stats.errors == 0);
+                    CHECK(run.Same());
+                }
+            }
+        }
+        CHECK(run.mismatches == 0);
+        CHECK(run.Same());
+        CHECK(SortedDump(*run.base.OpenRoot()) == original);
+
+        // Writing every layer down leaves the base equal to the expected tree
+        while (run.layered.LayerCount() > 0) {
+            LayerApplyStats stats;
+            std::wstring error;
+            REQUIRE(run.layered.ApplyLayer(stats, error));
+            CHECK(stats.errors == 0);
+        }
+        CHECK(SortedDump(*run.base.OpenRoot()) == SortedDump(*run.expected.OpenRoot()));
+    }
+}
+
+TEST(LayeredBackend, DiscardRestoresTheLayerBelow) {
+    Differential run;
+    Random random(7);
+    run.layered.PushLayer();
+    for (int step = 0; step < 300; step++) run.Step(random);
+    REQUIRE(run.Same());
+    std::wstring below = SortedDump(*run.layered.OpenRoot());
+
+    run.layered.PushLayer();
+    for (int step = 0; step < 300; step++) {
+        KeyPtr root = run.layered.OpenRoot();
+        std::wstring path = PickPath(*root, random);
+        KeyPtr key = root->OpenSubKey(path);
+        REQUIRE(key);
+        if (random.Next(2)) key->SetValue({ PickName(random, L"Value"), VALUE_DWORD, { 1, 2, 3, 4 } });
+        else DeleteSubtree(*key, PickName(random, L"Key"));
+    }
+    CHECK(SortedDump(*run.layered.OpenRoot()) != below);
+    REQUIRE(run.layered.DiscardLayer());
+    CHECK(SortedDump(*run.layered.OpenRoot()) == below);
+    CHECK(run.layered.LayerCount() == 1);
+}
@@ -0,0 +1,156 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for address bar completion: root abbreviations share the cached
+ * index of the full name, and keys are only read on the background thread.
+ */
+
+#include "Test.h"
+
+#include "MemoryBackend.h"
+#include "PathCompleter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace core;
+using namespace std::chrono_literals;
+
+namespace {
+
+// MemoryBackend that notes which threads open it
+class RecordingBackend : public RegistryBackend {
+public:
+    KeyPtr OpenRoot() override {
+        std::lock_guard lock(m_mutex);
+        m_threads.push_back(std::this_thread::get_id());
+        return m_base.OpenRoot();
+    }
+
+    bool OpenedOn(std::thread::id thread) {
+        std::lock_guard lock(m_mutex);
+        return std::find(m_threads.begin(), m_threads.end(), thread) != m_threads.end();
+    }
+
+    MemoryBackend& Base() { return m_base; }
+
+private:
+    MemoryBackend m_base;
+    std::mutex m_mutex;
+    std::vector<std::thread::id> m_threads;
+};
+
+// Counts ready callbacks from the completer's thread
+class ReadyCounter {
+public:
+    explicit ReadyCounter(PathCompleter& completer) : m_completer(completer) {
+        completer.SetReadyCallback([this] {
+            std::lock_guard lock(m_mutex);
+            m_count++;
+            m_changed.notify_all();
+        });
+    }
+
+    ~ReadyCounter() { m_completer.SetReadyCallback(nullptr); }
+
+    int Count() {
+        std::lock_guard lock(m_mutex);
+        return m_count;
+    }
+
+    bool WaitFor(int count) {
+        std::unique_lock lock(m_mutex);
+        return m_changed.wait_for(lock, 10s, [&] { return m_count >= count; });
+    }
+
+private:
+    PathCompleter& m_completer;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    int m_count = 0;
+};
+
+void AddKeys(RegistryBackend& backend, std::initializer_list<const wchar_t*> paths) {
+    KeyPtr root = backend.OpenRoot();
+    for (const wchar_t* path : paths) root->CreateSubKey(path);
+}
+
+} // namespace
+
+TEST(PathCompleter, RootAbbreviationsShareTheCache) {
+    MemoryBackend backend;
+    PathCompleter completer(backend);
+    completer.Store(L"HKEY_LOCAL_MACHINE\\SOFTWARE\\", { L"Alpha", L"Beta", L"Alps" }, 1);
+
+    // Already cached under the full name, so no read is needed
+    PathCompletion completion;
+    for (const wchar_t* text : { L"HKLM\\Software\\Al", L"hklm\\SOFTWARE\\al", L"Computer\\HKEY_LOCAL_MACHINE\\Software\\Al" }) {
+        REQUIRE(completer.Complete(text, 10, completion));
+        CHECK(!completion.pending);
+        CHECK(completion.totalMatches == 2);
+        REQUIRE(completion.matches.size() == 2);
+        CHECK(completion.matches[0] == L"Alpha");
+        CHECK(completion.matches[1] == L"Alps");
+    }
+    CHECK(completion.componentStart == std::wstring_view(L"Computer\\HKEY_LOCAL_MACHINE\\Software\\").size());
+}
+
+TEST(PathCompleter, MissIsReadInTheBackground) {
+    RecordingBackend backend;
+    AddKeys(backend.Base(), { L"HKEY_CURRENT_USER\\Console\\Alpha", L"HKEY_CURRENT_USER\\Console\\Beta" });
+    PathCompleter completer(backend);
+    ReadyCounter ready(completer);
+
+    PathCompletion completion;
+    CHECK(!completer.Complete(L"HKCU\\Console\\B", 10, completion));
+    CHECK(completion.pending);
+    REQUIRE(ready.WaitFor(1));
+
+    REQUIRE(completer.Complete(L"HKCU\\Console\\B", 10, completion));
+    REQUIRE(completion.matches.size() == 1);
+    CHECK(completion.matches[0] == L"Beta");
+    CHECK(!backend.OpenedOn(std::this_thread::get_id()));
+}
+
+TEST(PathCompleter, ChangedKeyIsReread) {
+    MemoryBackend backend;
+    AddKeys(backend, { L"HKEY_USERS\\A\\One", L"HKEY_USERS\\B\\Two" });
+    PathCompleter completer(backend);
+    ReadyCounter ready(completer);
+
+    PathCompletion completion;
+    completer.Complete(L"HKU\\A\\", 10, completion);
+    REQUIRE(ready.WaitFor(1));
+    completer.Complete(L"HKU\\B\\", 10, completion);
+    REQUIRE(ready.WaitFor(2));
+
+    // Back in A after it changed: the cached list is shown until the reread lands
+    std::this_thread::sleep_for(2ms);
+    AddKeys(backend, { L"HKEY_USERS\\A\\Other" });
+    REQUIRE(completer.Complete(L"HKU\\A\\O", 10, completion));
+    CHECK(completion.totalMatches == 1);
+    REQUIRE(ready.WaitFor(3));
+    REQUIRE(completer.Complete(L"HKU\\A\\O", 10, completion));
+    CHECK(completion.totalMatches == 2);
+
+    // An unchanged key is checked but not read again
+    completer.Complete(L"HKU\\B\\", 10, completion);
+    completer.Complete(L"HKU\\A\\", 10, completion);
+    std::this_thread::sleep_for(50ms);
+    CHECK(ready.Count() == 3);
+}
+
+TEST(PathCompleter, InvalidateDropsEverything) {
+    MemoryBackend backend;
+    PathCompleter completer(backend);
+    completer.Store(L"HKEY_CLASSES_ROOT", { L".txt" }, 1);
+    PathCompletion completion;
+    REQUIRE(completer.Complete(L"HKCR\\.t", 10, completion));
+    completer.Invalidate();
+    CHECK(!completer.Complete(L"HKCR\\.t", 10, completion));
+    CHECK(completion.pending);
+}
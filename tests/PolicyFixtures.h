@@ -0,0 +1,77 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry.pol images for the tests and benchmarks: the PReg header, then
+ * [key;value;type;size;data] entries in UTF-16.
+ */
+
+#pragma once
+
+#include "RegistryTypes.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace test {
+
+class PolicyFileWriter {
+public:
+    PolicyFileWriter() : m_bytes{ 'P', 'R', 'e', 'g', 1, 0, 0, 0 } {}
+
+    void Entry(std::wstring_view key, std::wstring_view value, uint32_t type, const std::vector<uint8_t>& data) {
+        Char(L'[');
+        String(key);
+        Char(L';');
+        String(value);
+        Char(L';');
+        U32(type);
+        Char(L';');
+        U32(static_cast<uint32_t>(data.size()));
+        Char(L';');
+        m_bytes.insert(m_bytes.end(), data.begin(), data.end());
+        Char(L']');
+    }
+
+    void Dword(std::wstring_view key, std::wstring_view value, uint32_t number) {
+        Entry(key, value, core::VALUE_DWORD,
+              { static_cast<uint8_t>(number), static_cast<uint8_t>(number >> 8), static_cast<uint8_t>(number >> 16),
+                static_cast<uint8_t>(number >> 24) });
+    }
+
+    // A REG_SZ directive such as **DeleteValues with its ';'-separated list
+    void Text(std::wstring_view key, std::wstring_view value, std::wstring_view text) {
+        Entry(key, value, core::VALUE_SZ, core::EncodeString(text));
+    }
+
+    void Truncate(size_t bytes) { m_bytes.resize(m_bytes.size() - bytes); }
+
+    size_t Size() const { return m_bytes.size(); }
+
+    void Save(const std::filesystem::path& path) const {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size());
+    }
+
+private:
+    void Char(wchar_t c) {
+        m_bytes.push_back(static_cast<uint8_t>(c & 0xFF));
+        m_bytes.push_back(static_cast<uint8_t>(c >> 8));
+    }
+
+    void String(std::wstring_view text) {
+        for (wchar_t c : text) Char(c);
+        Char(0);
+    }
+
+    void U32(uint32_t number) {
+        for (int i = 0; i < 4; i++) m_bytes.push_back(static_cast<uint8_t>(number >> (8 * i)));
+    }
+
+    std::vector<uint8_t> m_bytes;
+};
+
+} // namespace test
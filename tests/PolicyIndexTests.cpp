@@ -0,0 +1,175 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Registry.pol parsing and precedence: later GPOs win, deletions and soft
+ * sets, and **DeleteKeys removing whole subtrees.
+ */
+
+#include "PolicyFixtures.h"
+#include "Test.h"
+
+#include "PolicyIndex.h"
+
+using namespace core;
+namespace fs = std::filesystem;
+
+namespace {
+
+using test::PolicyFileWriter;
+
+bool BuildIndex(const fs::path& root, PolicyIndex& index, PolicyIndexStats& stats) {
+    std::vector<fs::path> files;
+    FindPolicyFiles(root, files);
+    std::vector<PolicySource> sources;
+    for (const fs::path& file : files) sources.push_back({ file });
+    std::wstring error;
+    return PolicyIndex::Build(sources, {}, index, stats, error);
+}
+
+const PolicyValue* FindValue(const PolicyIndex& index, std::wstring_view key, std::wstring_view name) {
+    uint32_t value = index.FindValue(index.FindKey(key), name);
+    return value == PolicyIndex::NONE ? nullptr : &index.Values()[value];
+}
+
+const PolicySetting& Effective(const PolicyIndex& index, const PolicyValue& value) {
+    return index.Settings()[value.effective];
+}
+
+} // namespace
+
+TEST(PolicyIndex, ClassifyValueNames) {
+    std::wstring_view target;
+    CHECK(ClassifyPolicyValue(L"Name", 4, target) == PolicyAction::Set);
+    CHECK(ClassifyPolicyValue(L"**del.Name", 2, target) == PolicyAction::Delete);
+    CHECK(target == L"Name");
+    CHECK(ClassifyPolicyValue(L"**soft.Name", 4, target) == PolicyAction::SoftSet);
+    CHECK(ClassifyPolicyValue(L"**delvals.", 2, target) == PolicyAction::DeleteAllValues);
+    CHECK(ClassifyPolicyValue(L"**DeleteValues", 6, target) == PolicyAction::DeleteValues);
+    CHECK(ClassifyPolicyValue(L"**DeleteKeys", 6, target) == PolicyAction::DeleteKeys);
+    CHECK(ClassifyPolicyValue(L"", 0, target) == PolicyAction::CreateKey);
+}
+
+TEST(PolicyIndex, Precedence) {
+    fs::path root = test::TempDirectory();
+    PolicyFileWriter a;
+    a.Dword(L"Software\\Policies\\X", L"A", 1);
+    a.Dword(L"Software\\Policies\\X", L"B", 2);
+    a.Dword(L"Software\\Policies\\X", L"C", 3);
+    a.Entry(L"Software\\Policies\\Y", L"", 0, {});
+    a.Save(root / "{A}" / "Machine" / "Registry.pol");
+
+    // Same values in another case, a changed one, a deletion and a soft set
+    PolicyFileWriter b;
+    b.Dword(L"software\\policies\\x", L"a", 1);
+    b.Dword(L"Software\\Policies\\X", L"B", 5);
+    b.Text(L"Software\\Policies\\X", L"**del.C", L" ");
+    b.Dword(L"Software\\Policies\\X", L"**soft.D", 7);
+    b.Save(root / "{B}" / "Machine" / "Registry.pol");
+
+    PolicyFileWriter c;
+    c.Dword(L"Software\\Policies\\X", L"**soft.D", 8);
+    c.Text(L"Software\\Policies\\Z", L"**delvals.", L" ");
+    c.Dword(L"Software\\Policies\\Z", L"Q", 1);
+    c.Text(L"Software\\Policies\\X", L"**DeleteValues", L"B;E");
+    c.Save(root / "{C}" / "User" / "Registry.pol");
+
+    PolicyFileWriter broken;
+    broken.Dword(L"K", L"V", 1);
+    broken.Truncate(3);
+    broken.Save(root / "{D}" / "Machine" / "Registry.pol");
+
+    PolicyIndex index;
+    PolicyIndexStats stats;
+    REQUIRE(BuildIndex(root, index, stats));
+    REQUIRE(index.Sources().size() == 4);
+    CHECK(stats.failedFiles == 1);
+    CHECK(index.Sources()[0].gpo == L"{A}");
+    CHECK(index.Sources()[3].entries == 0);
+    CHECK(!index.Sources()[3].error.empty());
+
+    const wchar_t* machineX = L"HKEY_LOCAL_MACHINE\\Software\\Policies\\X";
+    CHECK(index.FindKey(L"hkey_local_machine\\SOFTWARE\\Policies\\X") != PolicyIndex::NONE);
+    CHECK(index.FindKey(L"HKEY_LOCAL_MACHINE\\Software\\Policies\\Y") != PolicyIndex::NONE);
+    CHECK(index.HasPolicyBelow(L"HKEY_LOCAL_MACHINE\\Software"));
+    CHECK(!index.HasPolicyBelow(machineX));
+
+    // The same data twice is not a conflict; the later source still wins
+    const PolicyValue* valueA = FindValue(index, machineX, L"A");
+    REQUIRE(valueA);
+    CHECK(!valueA->conflict);
+    CHECK(Effective(index, *valueA).source == 1);
+
+    const PolicyValue* valueB = FindValue(index, machineX, L"b");
+    REQUIRE(valueB);
+    CHECK(valueB->conflict);
+    CHECK(index.Data(Effective(index, *valueB))[0] == 5);
+
+    const PolicyValue* valueC = FindValue(index, machineX, L"C");
+    REQUIRE(valueC);
+    CHECK(valueC->conflict);
+    CHECK(Effective(index, *valueC).action == PolicyAction::Delete);
+
+    const PolicyValue* valueD = FindValue(index, machineX, L"D");
+    REQUIRE(valueD);
+    CHECK(index.Data(Effective(index, *valueD))[0] == 7);
+
+    // User policies are a separate tree
+    const wchar_t* userX = L"HKEY_CURRENT_USER\\Software\\Policies\\X";
+    const PolicyValue* userD = FindValue(index, userX, L"D");
+    const PolicyValue* userE = FindValue(index, userX, L"E");
+    REQUIRE(userD && userE);
+    CHECK(index.Data(Effective(index, *userD))[0] == 8);
+    CHECK(Effective(index, *userE).action == PolicyAction::Delete);
+
+    // **delvals. then a set in the same file: the set comes later and wins
+    const PolicyValue* valueQ = FindValue(index, L"HKEY_CURRENT_USER\\Software\\Policies\\Z", L"Q");
+    REQUIRE(valueQ);
+    CHECK(Effective(index, *valueQ).action == PolicyAction::Set);
+
+    CHECK(index.Conflicts().size() == 2);
+}
+
+TEST(PolicyIndex, DeleteKeysRemovesSubtrees) {
+    fs::path root = test::TempDirectory();
+    PolicyFileWriter a;
+    a.Dword(L"Software\\Policies\\X\\Sub", L"A", 1);
+    a.Dword(L"Software\\Policies\\X", L"B", 2);
+    a.Dword(L"Software\\Policies\\Y", L"C", 3);
+    a.Save(root / "{A}" / "Machine" / "Registry.pol");
+
+    PolicyFileWriter b;
+    b.Text(L"Software\\Policies", L"**DeleteKeys", L"X;Q\\R");
+    b.Dword(L"Software\\Policies\\X", L"B", 9);
+    b.Save(root / "{B}" / "Machine" / "Registry.pol");
+
+    PolicyIndex index;
+    PolicyIndexStats stats;
+    REQUIRE(BuildIndex(root, index, stats));
+
+    // Deleted with X, two levels up
+    const PolicyValue* valueA = FindValue(index, L"HKEY_LOCAL_MACHINE\\Software\\Policies\\X\\Sub", L"A");
+    REQUIRE(valueA);
+    CHECK(valueA->conflict);
+    CHECK(Effective(index, *valueA).action == PolicyAction::DeleteKey);
+
+    // Set again after the deletion
+    const PolicyValue* valueB = FindValue(index, L"HKEY_LOCAL_MACHINE\\Software\\Policies\\X", L"B");
+    REQUIRE(valueB);
+    CHECK(Effective(index, *valueB).action == PolicyAction::Set);
+    CHECK(index.Data(Effective(index, *valueB))[0] == 9);
+
+    const PolicyValue* valueC = FindValue(index, L"HKEY_LOCAL_MACHINE\\Software\\Policies\\Y", L"C");
+    REQUIRE(valueC);
+    CHECK(Effective(index, *valueC).action == PolicyAction::Set);
+
+    uint32_t deleted = index.FindKey(L"HKEY_LOCAL_MACHINE\\Software\\Policies\\Q\\R");
+    REQUIRE(deleted != PolicyIndex::NONE);
+    REQUIRE(!index.Keys()[deleted].actions.empty());
+    CHECK(index.Settings()[index.Keys()[deleted].actions[0]].action == PolicyAction::DeleteKey);
+
+    uint32_t parent = index.FindKey(L"HKEY_LOCAL_MACHINE\\Software\\Policies");
+    REQUIRE(parent != PolicyIndex::NONE);
+    REQUIRE(!index.Keys()[parent].actions.empty());
+    CHECK(index.Settings()[index.Keys()[parent].actions[0]].action == PolicyAction::DeleteKeys);
+}
@@ -0,0 +1,150 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for comparing a backend against a .reg file.
+ */
+
+#include "Fixtures.h"
+#include "Test.h"
+
+#include "MemoryBackend.h"
+#include "RegFileCompare.h"
+
+#include <sstream>
+
+using namespace core;
+
+namespace {
+
+struct Found {
+    RegDiffKind kind;
+    std::wstring path;
+    std::wstring valueName;
+};
+
+RegCompareStats Compare(const std::string& file, RegistryBackend& backend, std::vector<Found>& found,
+                        const std::wstring& rootPrefix = {}) {
+    std::istringstream input(file);
+    RegCompareOptions options;
+    options.rootPrefix = rootPrefix;
+    found.clear();
+    return CompareWithRegFile(input, backend, [&](const RegDifference& difference) {
+        found.push_back({ difference.kind, std::wstring(difference.keyPath), std::wstring(difference.valueName) });
+    }, options);
+}
+
+bool Has(const std::vector<Found>& found, RegDiffKind kind, const std::wstring& path, const std::wstring& valueName = {}) {
+    for (const Found& item : found) {
+        if (item.kind == kind && item.path == path && item.valueName == valueName) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(RegFileCompare, ExportMatchesItsSource) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 4, 3, 3);
+    std::string file = test::ExportRegFile(*root, L"HKEY_LOCAL_MACHINE\\SOFTWARE");
+
+    std::vector<Found> found;
+    RegCompareStats stats = Compare(file, backend, found, L"HKEY_LOCAL_MACHINE\\SOFTWARE");
+    CHECK(found.empty());
+    CHECK(stats.differences == 0);
+    CHECK(stats.keys == keys + 1);
+    CHECK(stats.values == (keys + 1) * 3);
+    CHECK(stats.bytesRead == file.size());
+    CHECK(!stats.parseError);
+}
+
+TEST(RegFileCompare, ReportsEachKind) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr app = root->CreateSubKey(L"App");
+    REQUIRE(app);
+    app->SetValue({ L"Same", VALUE_SZ, EncodeString(L"x") });
+    app->SetValue({ L"Changed", VALUE_DWORD, { 1, 0, 0, 0 } });
+    app->SetValue({ L"Removed", VALUE_SZ, EncodeString(L"y") });
+    app->SetValue({ L"Extra", VALUE_SZ, EncodeString(L"z") });
+    REQUIRE(app->CreateSubKey(L"Listed"));
+    REQUIRE(app->CreateSubKey(L"Unlisted"));
+    REQUIRE(app->CreateSubKey(L"Deleted"));
+
+    std::string file =
+        "Windows Registry Editor Version 5.00\r\n\r\n"
+        "[App]\r\n"
+        "\"Same\"=\"x\"\r\n"
+        "\"changed\"=dword:00000002\r\n"
+        "\"Removed\"=-\r\n"
+        "\"Missing\"=hex:01,02\r\n\r\n"
+        "[app\\LISTED]\r\n\r\n"
+        "[-App\\Deleted]\r\n\r\n"
+        "[App\\Absent]\r\n";
+    std::vector<Found> found;
+    RegCompareStats stats = Compare(file, backend, found);
+    CHECK(Has(found, RegDiffKind::ChangedValue, L"App", L"changed"));
+    CHECK(Has(found, RegDiffKind::UnexpectedValue, L"App", L"Removed"));
+    CHECK(Has(found, RegDiffKind::MissingValue, L"App", L"Missing"));
+    CHECK(Has(found, RegDiffKind::ExtraValue, L"App", L"Extra"));
+    CHECK(Has(found, RegDiffKind::UnexpectedKey, L"App\\Deleted"));
+    CHECK(Has(found, RegDiffKind::MissingKey, L"App\\Absent"));
+    CHECK(Has(found, RegDiffKind::ExtraKey, L"App\\Unlisted"));
+    CHECK(found.size() == 7);
+    CHECK(stats.differences == 7);
+}
+
+TEST(RegFileCompare, RootPrefixSkipsOtherKeys) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    REQUIRE(root->CreateSubKey(L"Policies"));
+    std::string file =
+        "Windows Registry Editor Version 5.00\r\n\r\n"
+        "[HKEY_CURRENT_USER\\Software]\r\n\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE]\r\n\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE\\Policies]\r\n\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWAREX]\r\n";
+    std::vector<Found> found;
+    RegCompareStats stats = Compare(file, backend, found, L"HKEY_LOCAL_MACHINE\\SOFTWARE");
+    CHECK(found.empty());
+    CHECK(stats.keys == 2);
+    CHECK(stats.skippedKeys == 2);
+}
+
+// A second section for the root itself is not a missing key
+TEST(RegFileCompare, RepeatedRootSection) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    root->SetValue({ L"A", VALUE_SZ, EncodeString(L"1") });
+    root->SetValue({ L"B", VALUE_SZ, EncodeString(L"2") });
+    std::string file =
+        "Windows Registry Editor Version 5.00\r\n\r\n"
+        "[HKEY_USERS\\S-1-5-18]\r\n"
+        "\"A\"=\"1\"\r\n"
+        "\"B\"=\"2\"\r\n\r\n"
+        "[HKEY_USERS\\S-1-5-18]\r\n"
+        "\"A\"=\"1\"\r\n"
+        "\"B\"=\"2\"\r\n";
+    std::vector<Found> found;
+    RegCompareStats stats = Compare(file, backend, found, L"HKEY_USERS\\S-1-5-18");
+    CHECK(found.empty());
+    CHECK(stats.keys == 2);
+}
+
+TEST(RegFileCompare, ParseErrorReportsLine) {
+    MemoryBackend backend;
+    std::string file =
+        "Windows Registry Editor Version 5.00\r\n\r\n"
+        "[Key]\r\n"
+        "\"Value\"=dword:xyz\r\n";
+    std::vector<Found> found;
+    RegCompareStats stats = Compare(file, backend, found);
+    CHECK(stats.parseError);
+    CHECK(stats.errorLine == 4);
+    CHECK(!stats.errorMessage.empty());
+
+    stats = Compare("not a registry file\r\n", backend, found);
+    CHECK(stats.parseError);
+    CHECK(stats.keys == 0);
+}
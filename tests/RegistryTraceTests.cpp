@@ -0,0 +1,241 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for Process Monitor trace ingestion: root spellings and native
+ * paths land on one node, counters add up per process and per key, and
+ * CSV and XML exports of the same events give the same profile for any
+ * thread count.
+ */
+
+#include "HiveFixtures.h"
+#include "TraceFixtures.h"
+#include "Test.h"
+
+#include "RegistryTrace.h"
+#include "RegistryTypes.h"
+
+using namespace core;
+
+namespace {
+
+constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+bool Load(const std::string& text, TraceProfile& profile, TraceStats& stats, const TraceOptions& options = {}) {
+    std::filesystem::path path = test::TempDirectory() / "trace";
+    test::SaveFile(path, { text.begin(), text.end() });
+    std::wstring error;
+    return LoadRegistryTrace(path, options, profile, stats, error);
+}
+
+uint32_t FindNode(const TraceProfile& profile, std::wstring_view path, bool isValue = false) {
+    for (uint32_t n = 1; n < profile.nodes.size(); n++) {
+        if (profile.nodes[n].isValue == isValue && NamesEqual(profile.Path(n), path)) return n;
+    }
+    return NOT_FOUND;
+}
+
+uint32_t FindProcess(const TraceProfile& profile, std::wstring_view name, uint32_t pid) {
+    for (uint32_t p = 0; p < profile.processes.size(); p++) {
+        if (profile.processes[p].pid == pid && NamesEqual(profile.processes[p].name, name)) return p;
+    }
+    return NOT_FOUND;
+}
+
+TraceCounters Access(const TraceProfile& profile, uint32_t process, uint32_t node) {
+    for (const TraceAccess& access : profile.accesses) {
+        if (access.process == process && access.node == node) return access.counters;
+    }
+    return {};
+}
+
+bool SameCounters(const TraceCounters& a, const TraceCounters& b) {
+    return a.reads == b.reads && a.writes == b.writes && a.creates == b.creates && a.deletes == b.deletes &&
+           a.failures == b.failures;
+}
+
+// Every node with its path and counters, every process and every access
+std::wstring Describe(const TraceProfile& profile) {
+    auto counters = [](const TraceCounters& c) {
+        return L" " + std::to_wstring(c.reads) + L"/" + std::to_wstring(c.writes) + L"/" + std::to_wstring(c.creates) +
+               L"/" + std::to_wstring(c.deletes) + L"/" + std::to_wstring(c.failures) + L"\n";
+    };
+    std::wstring text;
+    for (uint32_t n = 1; n < profile.nodes.size(); n++) {
+        text += (profile.nodes[n].isValue ? L"V " : L"K ") + profile.Path(n) + counters(profile.nodes[n].counters);
+    }
+    for (const TraceProcess& process : profile.processes) {
+        text += process.name + L":" + std::to_wstring(process.pid) + counters(process.counters);
+    }
+    for (const TraceAccess& access : profile.accesses) {
+        text += std::to_wstring(access.process) + L"@" + std::to_wstring(access.node) + counters(access.counters);
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(RegistryTrace, RootSpellingsShareOneNode) {
+    std::vector<test::TraceEvent> events = {
+        { "a.exe", 1, "RegOpenKey", "HKLM\\Software\\App" },
+        { "a.exe", 1, "RegOpenKey", "HKEY_LOCAL_MACHINE\\SOFTWARE\\App" },
+        { "a.exe", 1, "RegOpenKey", "\\REGISTRY\\MACHINE\\software\\APP" },
+        { "a.exe", 1, "RegOpenKey", "hklm\\Software\\App\\" },
+        { "a.exe", 1, "RegOpenKey", "HKCU\\Console" },
+        { "a.exe", 1, "RegOpenKey", "HKEY_CURRENT_USER\\Console" },
+        { "a.exe", 1, "RegOpenKey", "\\REGISTRY\\USER\\S-1-5-21-1\\Console" },
+        { "a.exe", 1, "RegOpenKey", "HKU\\S-1-5-21-1\\Console" },
+        { "a.exe", 1, "RegOpenKey", "HKCR\\.txt" },
+        { "a.exe", 1, "RegQueryValue", "HKLM\\Software\\App\\(Default)" },
+        { "a.exe", 1, "RegQueryValue", "\\Registry\\Machine\\Software\\App\\Version" },
+        { "a.exe", 1, "RegQueryValue", "HKLM" },                  // A value needs a key
+    };
+    TraceProfile profile;
+    TraceStats stats;
+    REQUIRE(Load(test::CsvTrace(events), profile, stats));
+    CHECK(stats.events == events.size());
+    CHECK(stats.registryEvents == events.size() - 1);
+    CHECK(stats.malformedEvents == 1);
+
+    uint32_t app = FindNode(profile, L"HKEY_LOCAL_MACHINE\\SOFTWARE\\App");
+    REQUIRE(app != NOT_FOUND);
+    CHECK(profile.nodes[app].counters.reads == 4);
+    CHECK(profile.nodes[app].name == L"App");        // As first seen
+    uint32_t console = FindNode(profile, L"HKEY_CURRENT_USER\\Console");
+    REQUIRE(console != NOT_FOUND);
+    CHECK(profile.nodes[console].counters.reads == 2);
+    uint32_t userConsole = FindNode(profile, L"HKEY_USERS\\S-1-5-21-1\\Console");
+    REQUIRE(userConsole != NOT_FOUND);
+    CHECK(profile.nodes[userConsole].counters.reads == 2);
+    CHECK(FindNode(profile, L"HKEY_CLASSES_ROOT\\.txt") != NOT_FOUND);
+
+    uint32_t defaultValue = FindNode(profile, L"HKEY_LOCAL_MACHINE\\SOFTWARE\\App\\", true);
+    REQUIRE(defaultValue != NOT_FOUND);
+    CHECK(profile.nodes[defaultValue].name.empty());
+    CHECK(profile.nodes[defaultValue].parent == app);
+    CHECK(FindNode(profile, L"HKEY_LOCAL_MACHINE\\SOFTWARE\\App\\Version", true) != NOT_FOUND);
+    CHECK(FindNode(profile, L"REGISTRY\\MACHINE") == NOT_FOUND);
+    CHECK(FindNode(profile, L"HKLM") == NOT_FOUND);
+
+    // Four hives, SOFTWARE, App, Console, the user SID and its Console, .txt
+    // and the two values
+    CHECK(profile.nodes.size() == 1 + 4 + 2 + 1 + 2 + 1 + 2);
+}
+
+TEST(RegistryTrace, CountersPerProcessAndKey) {
+    const std::string key = "HKLM\\Software\\Vendor\\App";
+    std::vector<test::TraceEvent> events = {
+        { "setup.exe", 10, "RegCreateKey", key, "SUCCESS", "Desired Access: All Access, Disposition: REG_CREATED_NEW_KEY" },
+        { "setup.exe", 10, "RegSetValue", key + "\\Path", "SUCCESS", "Type: REG_SZ, Length: 8, Data: C:\\" },
+        { "setup.exe", 10, "RegSetValue", key + "\\Path" },
+        { "setup.exe", 10, "RegCloseKey", key },
+        { "setup.exe", 10, "CreateFile", "C:\\Program Files\\App" },
+        { "setup.exe", 10, "RegCreateKey", "HKLM\\Software\\Vendor", "SUCCESS", "Disposition: REG_OPENED_EXISTING_KEY" },
+        { "setup.exe", 10, "RegSetValue", "HKLM\\Software\\Vendor\\Installed" },
+        { "app.exe", 20, "RegOpenKey", key },
+        { "app.exe", 20, "RegQueryValue", key + "\\Path", "BUFFER OVERFLOW", "Length: 12" },
+        { "app.exe", 20, "RegQueryValue", key + "\\Missing", "NAME NOT FOUND" },
+        { "app.exe", 21, "RegOpenKey", key },
+        { "app.exe", 21, "RegDeleteValue", key + "\\Path" },
+        { "app.exe", 21, "RegDeleteKey", key, "ACCESS DENIED" },
+        { "app.exe", 21, "RegDeleteKey", key },
+        { "Other, \"quoted\".exe", 30, "RegEnumKey", "HKLM\\Software\\Vendor" },
+    };
+    TraceProfile profile;
+    TraceStats stats;
+    REQUIRE(Load(test::CsvTrace(events), profile, stats));
+    CHECK(stats.events == events.size());
+    CHECK(stats.registryEvents == events.size() - 2);
+    CHECK(stats.malformedEvents == 0);
+
+    // Processes are told apart by name and PID, sorted by name
+    REQUIRE(profile.processes.size() == 4);
+    CHECK(profile.processes[0].name == L"app.exe");
+    CHECK(profile.processes[0].pid == 20);
+    uint32_t setup = FindProcess(profile, L"setup.exe", 10);
+    uint32_t app20 = FindProcess(profile, L"app.exe", 20);
+    uint32_t app21 = FindProcess(profile, L"app.exe", 21);
+    uint32_t other = FindProcess(profile, L"Other, \"quoted\".exe", 30);
+    REQUIRE(setup != NOT_FOUND && app20 != NOT_FOUND && app21 != NOT_FOUND && other != NOT_FOUND);
+    CHECK(SameCounters(profile.processes[setup].counters, { 1, 3, 1, 0, 0 }));
+    CHECK(SameCounters(profile.processes[app20].counters, { 2, 0, 0, 0, 1 }));
+    CHECK(SameCounters(profile.processes[app21].counters, { 1, 0, 0, 2, 1 }));
+    CHECK(SameCounters(profile.processes[other].counters, { 1, 0, 0, 0, 0 }));
+
+    // Per key, over all processes, and per process and key
+    uint32_t appKey = FindNode(profile, L"HKEY_LOCAL_MACHINE\\Software\\Vendor\\App");
+    uint32_t vendor = FindNode(profile, L"HKEY_LOCAL_MACHINE\\Software\\Vendor");
+    uint32_t pathValue = FindNode(profile, L"HKEY_LOCAL_MACHINE\\Software\\Vendor\\App\\Path", true);
+    uint32_t installed = FindNode(profile, L"HKEY_LOCAL_MACHINE\\Software\\Vendor\\Installed", true);
+    REQUIRE(appKey != NOT_FOUND && vendor != NOT_FOUND && pathValue != NOT_FOUND && installed != NOT_FOUND);
+    CHECK(SameCounters(profile.nodes[appKey].counters, { 2, 0, 1, 1, 1 }));
+    CHECK(SameCounters(profile.nodes[vendor].counters, { 2, 0, 0, 0, 0 }));
+    CHECK(SameCounters(profile.nodes[pathValue].counters, { 1, 2, 0, 1, 0 }));
+    CHECK(SameCounters(Access(profile, setup, appKey), { 0, 0, 1, 0, 0 }));
+    CHECK(SameCounters(Access(profile, app20, appKey), { 1, 0, 0, 0, 0 }));
+    CHECK(SameCounters(Access(profile, app21, appKey), { 1, 0, 0, 1, 1 }));
+    CHECK(SameCounters(Access(profile, setup, pathValue), { 0, 2, 0, 0, 0 }));
+    CHECK(SameCounters(Access(profile, app20, pathValue), { 1, 0, 0, 0, 0 }));
+
+    // The sums agree whichever way they are cut
+    TraceCounters byProcess, byNode, byAccess;
+    for (const TraceProcess& process : profile.processes) byProcess.Add(process.counters);
+    for (const TraceNode& node : profile.nodes) byNode.Add(node.counters);
+    for (const TraceAccess& access : profile.accesses) byAccess.Add(access.counters);
+    CHECK(byProcess.Total() == stats.registryEvents);
+    CHECK(SameCounters(byProcess, byNode));
+    CHECK(SameCounters(byProcess, byAccess));
+
+    // The install left the App key and the value written into Vendor
+    std::vector<uint32_t> roots;
+    profile.ChangedRoots(roots);
+    REQUIRE(roots.size() == 2);
+    CHECK(roots[0] == appKey);
+    CHECK(roots[1] == installed);
+
+    // Only the named processes, in any case
+    TraceOptions options;
+    options.processes = { L"APP.EXE" };
+    REQUIRE(Load(test::CsvTrace(events), profile, stats, options));
+    CHECK(profile.processes.size() == 2);
+    CHECK(stats.filteredEvents == 6);
+    CHECK(FindNode(profile, L"HKEY_LOCAL_MACHINE\\Software\\Vendor\\Installed", true) == NOT_FOUND);
+}
+
+TEST(RegistryTrace, XmlMatchesCsvForAnyThreadCount) {
+    // Enough rows for several chunks, with characters XML has to escape
+    std::vector<test::TraceEvent> events;
+    const char* operations[] = { "RegOpenKey", "RegQueryValue", "RegSetValue", "RegCreateKey", "RegDeleteKey" };
+    for (uint32_t i = 0; i < 3000; i++) {
+        test::TraceEvent event;
+        event.process = i % 3 ? "a&b.exe" : "<c>.exe";
+        event.pid = 100 + i % 5;
+        event.operation = operations[i % 5];
+        event.path = "HKLM\\Software\\K" + std::to_string(i % 37) + "\\Sub&" + std::to_string(i % 11);
+        if (i % 5 == 1 || i % 5 == 2) event.path += "\\Value" + std::to_string(i % 7);
+        if (i % 13 == 0) event.result = "ACCESS DENIED";
+        events.push_back(event);
+    }
+
+    TraceProfile csv;
+    TraceStats stats;
+    TraceOptions options;
+    options.threadCount = 1;
+    REQUIRE(Load(test::CsvTrace(events), csv, stats, options));
+    CHECK(stats.registryEvents == events.size());
+    std::wstring expected = Describe(csv);
+    CHECK(FindNode(csv, L"HKEY_LOCAL_MACHINE\\Software\\K1\\Sub&1") != NOT_FOUND);
+
+    options.chunkSize = 4096;
+    for (unsigned threads : { 1u, 2u, 4u }) {
+        options.threadCount = threads;
+        TraceProfile profile;
+        REQUIRE(Load(test::CsvTrace(events), profile, stats, options));
+        CHECK(stats.chunks > 1);
+        CHECK(Describe(profile) == expected);
+        REQUIRE(Load(test::XmlTrace(events), profile, stats, options));
+        CHECK(stats.events == events.size());
+        CHECK(stats.malformedEvents == 0);
+        CHECK(Describe(profile) == expected);
+    }
+}
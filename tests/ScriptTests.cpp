@@ -0,0 +1,160 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Script compiler and VM against the in-memory backend.
+ */
+
+#include "Test.h"
+
+#include "MemoryBackend.h"
+#include "RegistryTypes.h"
+#include "Script.h"
+
+using namespace core;
+
+namespace {
+
+struct RunResult {
+    bool compiled = false;
+    bool ran = false;
+    std::wstring output;                // print() lines, each ending in '\n'
+    std::wstring error;
+    ScriptStats stats;
+};
+
+RunResult RunScript(RegistryBackend& backend, std::wstring_view source, size_t writeBatchSize = 4096) {
+    RunResult result;
+    Script script;
+    result.compiled = script.Compile(source);
+    if (result.compiled) {
+        ScriptOptions options;
+        options.output = [&result](std::wstring_view line) {
+            result.output += line;
+            result.output += L'\n';
+        };
+        options.writeBatchSize = writeBatchSize;
+        result.ran = script.Run(backend, result.stats, options);
+    }
+    result.error = script.Error();
+    return result;
+}
+
+uint32_t ReadDword(RegistryKey& key, std::wstring_view name) {
+    RegValue value;
+    if (!key.GetValue(name, value) || value.type != VALUE_DWORD || value.data.size() != 4) return 0;
+    return value.data[0] | value.data[1] << 8 | value.data[2] << 16 | static_cast<uint32_t>(value.data[3]) << 24;
+}
+
+} // namespace
+
+TEST(Script, CompileErrors) {
+    MemoryBackend backend;
+    CHECK(RunScript(backend, L"print(1 +)").error == L"line 1: expected an expression");
+    CHECK(RunScript(backend, L"let a = \"unterminated").error == L"line 1: unterminated string");
+    CHECK(RunScript(backend, L"let a = 1\nfoo(a)").error == L"line 2: unknown function 'foo'");
+}
+
+TEST(Script, RuntimeErrors) {
+    MemoryBackend backend;
+    RunResult division = RunScript(backend, L"let a = 1\nprint(a / 0)");
+    CHECK(division.compiled && !division.ran);
+    CHECK(division.error == L"line 2: division by zero");
+    CHECK(RunScript(backend, L"setdword('nope', \"x\", 1)").error == L"line 1: key not found: nope");
+
+    // A loop over a missing key runs zero times
+    RunResult missing = RunScript(backend, L"for key k in open('nope') { print(k) }\nprint(\"done\")");
+    CHECK(missing.ran);
+    CHECK(missing.output == L"done\n");
+}
+
+TEST(Script, ExpressionsAndControlFlow) {
+    MemoryBackend backend;
+    RunResult result = RunScript(backend, LR"(
+let i = 0
+while true {
+    i = i + 1
+    if i % 2 == 0 { continue } else if i > 7 { break }
+    print("i", i)
+}
+print(replace("Hello HELLO", "hello", "bye"), upper("abc"), lower("ABC"), len("four"), int("0x10"), int("zz"))
+print("x" == "X", "a" < "B", 1 and 2, 0 or "y", not null, -(3) * 2 % 4, 7 / 2)
+)");
+    CHECK(result.ran);
+    CHECK(result.output ==
+          L"i 1\ni 3\ni 5\ni 7\n"
+          L"bye bye ABC abc 4 16 null\n"
+          L"1 1 2 y 1 -2 3\n");
+}
+
+TEST(Script, KeysAndValues) {
+    MemoryBackend backend;
+    RunResult result = RunScript(backend, LR"(
+let k = createkey('', 'A\B')
+setstring(k, "s", "hello")
+setdword('A\B', "d", 0xFFFFFFFF)
+setqword(k, "q", -5)
+print(getvalue(k, "s").data, getvalue('a\b', "D").data, getvalue(k, "q").data, k.values)
+for value v in k { print(v.name, v.type, v.size) }
+createkey(k, 'C\D')
+for key c in k recursive { print(c.path, c.subkeys) }
+deletevalue(k, "s")
+print(getvalue(k, "s"), deletekey(k, "C"), exists('A\B\C'))
+)", 2);
+    CHECK(result.ran);
+    CHECK(result.output ==
+          L"hello 4294967295 -5 3\n"
+          L"s 1 12\nd 4 4\nq 11 8\n"
+          L"A\\B\\C 1\nA\\B\\C\\D 0\n"
+          L"null 1 0\n");
+    CHECK(result.stats.writes == 4);
+
+    KeyPtr key = backend.OpenKey(L"A\\B");
+    REQUIRE(key);
+    CHECK(ReadDword(*key, L"d") == 0xFFFFFFFF);
+    RegValue value;
+    CHECK(!key->GetValue(L"s", value));
+}
+
+// The example from Script.h over a generated tree, checked against the same
+// change made directly
+TEST(Script, RecursiveUpdate) {
+    MemoryBackend backend;
+    KeyPtr software = backend.OpenRoot()->CreateSubKey(L"SOFTWARE");
+    REQUIRE(software);
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < 2000; i++) {
+        KeyPtr key = software->CreateSubKey(L"Vendor" + std::to_wstring(i % 37) + L"\\Product" + std::to_wstring(i));
+        REQUIRE(key);
+        uint32_t retries = (i * 7919) % 200;
+        key->SetValue(RegValue{ L"Retries", VALUE_DWORD, { static_cast<uint8_t>(retries), 0, 0, 0 } });
+        expected += retries > 100 ? 100 : retries;
+    }
+
+    RunResult result = RunScript(backend, LR"(
+let changed = 0
+for key k in open('SOFTWARE') recursive {
+    let v = getvalue(k, "Retries")
+    if v != null and v.type == REG_DWORD and v.data > 100 {
+        setdword(k, "Retries", 100)
+        changed = changed + 1
+    }
+}
+print(changed)
+)", 64);
+    REQUIRE(result.ran);
+    CHECK(result.stats.keys == 2000 + 37);
+    CHECK(result.output == std::to_wstring(result.stats.writes) + L"\n");
+    CHECK(result.stats.flushes > 1);
+
+    uint32_t total = 0;
+    std::vector<std::wstring> vendors;
+    software->GetSubKeyNames(vendors);
+    for (const std::wstring& vendorName : vendors) {
+        KeyPtr vendor = software->OpenSubKey(vendorName);
+        std::vector<std::wstring> products;
+        vendor->GetSubKeyNames(products);
+        for (const std::wstring& productName : products) total += ReadDword(*vendor->OpenSubKey(productName), L"Retries");
+    }
+    CHECK(total == expected);
+}
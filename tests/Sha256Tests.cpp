@@ -0,0 +1,70 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Sha256 against the FIPS 180-4 example vectors.
+ */
+
+#include "Test.h"
+
+#include "Sha256.h"
+
+#include <cstring>
+#include <string>
+
+using namespace core;
+
+namespace {
+
+std::string Hex(const Sha256Digest& digest) {
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string text;
+    for (uint8_t byte : digest) {
+        text += DIGITS[byte >> 4];
+        text += DIGITS[byte & 0x0F];
+    }
+    return text;
+}
+
+std::string HashText(const char* text) {
+    return Hex(Sha256::Hash(text, std::strlen(text)));
+}
+
+} // namespace
+
+TEST(Sha256, KnownVectors) {
+    CHECK(HashText("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(HashText("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(HashText("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(Sha256, MillionA) {
+    std::string message(1000000, 'a');
+    CHECK(Hex(Sha256::Hash(message.data(), message.size())) ==
+          "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+// Every split of the input around the block and padding boundaries
+TEST(Sha256, IncrementalMatchesOneShot) {
+    std::string message;
+    for (int i = 0; i < 200; i++) message += static_cast<char>('0' + i % 75);
+
+    for (size_t size : { 55, 56, 63, 64, 65, 119, 120, 128, 200 }) {
+        Sha256Digest expected = Sha256::Hash(message.data(), size);
+        for (size_t split = 0; split <= size; split++) {
+            Sha256 sha;
+            sha.Update(message.data(), split);
+            sha.Update(message.data() + split, size - split);
+            CHECK(sha.Finish() == expected);
+        }
+    }
+}
+
+TEST(Sha256, ResetStartsOver) {
+    Sha256 sha;
+    sha.Update("garbage", 7);
+    sha.Reset();
+    sha.Update("abc", 3);
+    CHECK(Hex(sha.Finish()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
@@ -0,0 +1,178 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for per-key size analytics: rollups, incremental rescans and
+ * hives whose subkey lists loop.
+ */
+
+#include "Fixtures.h"
+#include "HiveFixtures.h"
+#include "Test.h"
+
+#include "HiveBackend.h"
+#include "MemoryBackend.h"
+#include "SizeAnalytics.h"
+
+#include <map>
+
+using namespace core;
+
+namespace {
+
+using Column = KeySizeTable::Column;
+
+RegValue Bytes(const wchar_t* name, size_t size) {
+    return { name, VALUE_BINARY, std::vector<uint8_t>(size, 0x5A) };
+}
+
+uint32_t RowOf(const KeySizeTable& table, const std::wstring& path) {
+    for (uint32_t row = 0; row < table.Size(); row++) {
+        if (table.Path(row) == path) return row;
+    }
+    return INVALID_ROW;
+}
+
+// Every column of every row, by path
+std::map<std::wstring, std::vector<uint64_t>> Figures(const KeySizeTable& table) {
+    std::map<std::wstring, std::vector<uint64_t>> figures;
+    for (uint32_t row = 0; row < table.Size(); row++) {
+        std::vector<uint64_t>& columns = figures[table.Path(row)];
+        for (int column = 0; column <= static_cast<int>(Column::LargestValue); column++) {
+            columns.push_back(table.Get(static_cast<Column>(column), row));
+        }
+    }
+    return figures;
+}
+
+} // namespace
+
+TEST(SizeAnalytics, SubtreeRollups) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    root->SetValue(Bytes(L"r", 10));
+    KeyPtr a = root->CreateSubKey(L"A");
+    KeyPtr x = root->CreateSubKey(L"A\\X");
+    REQUIRE(a && x && root->CreateSubKey(L"B"));
+    a->SetValue(Bytes(L"a", 100));
+    a->SetValue(Bytes(L"bb", 4));
+    x->SetValue(Bytes(L"x", 1000));
+
+    for (unsigned threads : { 1u, 3u }) {
+        KeySizeTable table;
+        SizeScanOptions options;
+        options.threadCount = threads;
+        SizeScanStats stats = ScanKeySizes(*root, table, options);
+        CHECK(stats.keys == 4);
+        CHECK(stats.errors == 0);
+        REQUIRE(table.Size() == 4);
+
+        uint32_t rootRow = RowOf(table, L"");
+        uint32_t aRow = RowOf(table, L"A");
+        uint32_t xRow = RowOf(table, L"A\\X");
+        REQUIRE(rootRow != INVALID_ROW && aRow != INVALID_ROW && xRow != INVALID_ROW);
+        CHECK(table.parent[xRow] == aRow);
+        CHECK(table.depth[xRow] == 2);
+
+        CHECK(table.Get(Column::SubtreeKeys, rootRow) == 4);
+        CHECK(table.Get(Column::SubtreeValues, rootRow) == 4);
+        CHECK(table.Get(Column::SubtreeDataBytes, rootRow) == 1114);
+        CHECK(table.Get(Column::SubtreeKeys, aRow) == 2);
+        CHECK(table.Get(Column::SubtreeDataBytes, aRow) == 1104);
+        CHECK(table.Get(Column::OwnDataBytes, aRow) == 104);
+        CHECK(table.Get(Column::OwnValues, aRow) == 2);
+        CHECK(table.Get(Column::SubKeys, aRow) == 1);
+        CHECK(table.Get(Column::LargestValue, aRow) == 100);
+        // Key name "A" plus value names "a" and "bb", in UTF-16 bytes
+        CHECK(table.nameBytes[aRow] == 8);
+        CHECK(table.Get(Column::SubtreeTotalBytes, aRow) ==
+              table.Get(Column::SubtreeNameBytes, aRow) + table.Get(Column::SubtreeDataBytes, aRow));
+
+        std::vector<uint32_t> top = table.TopN(Column::SubtreeDataBytes, 2, 1);
+        REQUIRE(top.size() == 2);
+        CHECK(top[0] == rootRow);
+        CHECK(top[1] == aRow);
+
+        REQUIRE(table.largestValues.size() == 4);
+        CHECK(table.largestValues[0].name == L"x");
+        CHECK(table.largestValues[0].row == xRow);
+        CHECK(table.largestValues[3].size == 4);
+    }
+}
+
+TEST(SizeAnalytics, IncrementalRescanMatchesFullScan) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 5, 3, 3) + 1;
+    KeyPtr big = root->OpenSubKey(L"Key4\\Key4");
+    REQUIRE(big);
+    big->SetValue(Bytes(L"Huge", 1 << 20));
+
+    KeySizeTable first;
+    SizeScanOptions options;
+    options.threadCount = 2;
+    options.largestValueCount = 5;
+    REQUIRE(ScanKeySizes(*root, first, options).keys == keys);
+
+    // Change two keys: one gains a value, one loses its huge value
+    root->OpenSubKey(L"Key1\\Key2")->SetValue(Bytes(L"Added", 300));
+    REQUIRE(big->DeleteValue(L"Huge"));
+
+    KeySizeTable rescan;
+    options.previous = &first;
+    SizeScanStats stats = ScanKeySizes(*root, rescan, options);
+    CHECK(stats.keys == keys);
+    CHECK(stats.reusedKeys == keys - 2);
+
+    KeySizeTable full;
+    options.previous = nullptr;
+    ScanKeySizes(*root, full, options);
+    CHECK(Figures(rescan) == Figures(full));
+    REQUIRE(rescan.largestValues.size() == full.largestValues.size());
+    for (size_t i = 0; i < full.largestValues.size(); i++) {
+        // Equal sizes may come in either order; each entry must be real
+        const LargeValueInfo& entry = rescan.largestValues[i];
+        CHECK(entry.size == full.largestValues[i].size);
+        KeyPtr holder = root->OpenSubKey(rescan.Path(entry.row));
+        RegValue value;
+        CHECK(holder && holder->GetValue(entry.name, value) && value.data.size() == entry.size);
+    }
+    CHECK(rescan.largestValues[0].name != L"Huge");
+
+    // Unchanged subtrees can be copied whole
+    KeySizeTable skipped;
+    options.previous = &rescan;
+    options.skipUnchangedSubtrees = true;
+    stats = ScanKeySizes(*root, skipped, options);
+    CHECK(stats.skippedSubtrees > 0);
+    CHECK(Figures(skipped) == Figures(full));
+}
+
+// A subkey list pointing back at an ancestor ends the scan of that branch
+TEST(SizeAnalytics, CyclicHiveEnds) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    test::FillTree(*root, 3, 3, 1);
+    REQUIRE(root->CreateSubKey(L"Key1\\Key2\\Loop\\Child"));
+    std::vector<uint8_t> image = test::HiveImage(*root);
+    uint32_t ancestor = test::KeyCell(image, L"Key1");
+    uint32_t loop = test::KeyCell(image, L"Key1\\Key2\\Loop");
+    REQUIRE(ancestor != hive::INVALID_CELL && loop != hive::INVALID_CELL);
+    REQUIRE(test::PointFirstSubKeyAt(image, loop, ancestor));   // Loop\Key1 is Key1 again
+
+    HiveBackend hive;
+    REQUIRE(hive.Attach(image.data(), image.size()));
+    KeyPtr hiveRoot = hive.OpenRoot();
+    REQUIRE(hiveRoot);
+
+    for (unsigned threads : { 1u, 4u }) {
+        KeySizeTable table;
+        SizeScanOptions options;
+        options.threadCount = threads;
+        SizeScanStats stats = ScanKeySizes(*hiveRoot, table, options);
+        CHECK(stats.errors == 1);
+        CHECK(!stats.cancelled);
+        // Root, 39 generated keys and Loop; Child was replaced by the loop
+        CHECK(table.Size() == 41);
+    }
+}
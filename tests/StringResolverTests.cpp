@@ -0,0 +1,270 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for REG_EXPAND_SZ and indirect string resolution: expansion keeps
+ * unknown names as written, indirect strings parse like SHLoadIndirectString
+ * expects them, and the cache counts hits and misses, goes stale with the
+ * environment and batches background requests.
+ */
+
+#include "Test.h"
+
+#include "RegistryTypes.h"
+#include "StringResolver.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace core;
+using namespace std::chrono_literals;
+
+namespace {
+
+// MemoryStringSource that can hold the resolving thread and notes which
+// threads it was called on
+class GatedSource : public StringSource {
+public:
+    bool GetEnvironment(std::wstring_view name, std::wstring& value) override {
+        Enter();
+        return base.GetEnvironment(name, value);
+    }
+
+    bool LoadModuleString(const std::wstring& module, uint32_t id, std::wstring& text) override {
+        Enter();
+        return base.LoadModuleString(module, id, text);
+    }
+
+    void Close() {
+        std::lock_guard lock(m_mutex);
+        m_open = false;
+    }
+
+    void Open() {
+        std::lock_guard lock(m_mutex);
+        m_open = true;
+        m_changed.notify_all();
+    }
+
+    // Wait until a caller is held at the gate
+    bool WaitForWaiter() {
+        std::unique_lock lock(m_mutex);
+        return m_changed.wait_for(lock, 10s, [&] { return m_waiting > 0; });
+    }
+
+    bool CalledOn(std::thread::id thread) {
+        std::lock_guard lock(m_mutex);
+        for (std::thread::id caller : m_callers) {
+            if (caller == thread) return true;
+        }
+        return false;
+    }
+
+    MemoryStringSource base;
+
+private:
+    void Enter() {
+        std::unique_lock lock(m_mutex);
+        m_callers.push_back(std::this_thread::get_id());
+        m_waiting++;
+        m_changed.notify_all();
+        m_changed.wait(lock, [&] { return m_open; });
+        m_waiting--;
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<std::thread::id> m_callers;
+    int m_waiting = 0;
+    bool m_open = true;
+};
+
+// Counts ready callbacks from the cache's thread
+class ReadyCounter {
+public:
+    explicit ReadyCounter(StringResolveCache& cache) : m_cache(cache) {
+        cache.SetReadyCallback([this] {
+            std::lock_guard lock(m_mutex);
+            m_count++;
+            m_changed.notify_all();
+        });
+    }
+
+    ~ReadyCounter() { m_cache.SetReadyCallback(nullptr); }
+
+    bool WaitFor(int count) {
+        std::unique_lock lock(m_mutex);
+        return m_changed.wait_for(lock, 10s, [&] { return m_count >= count; });
+    }
+
+private:
+    StringResolveCache& m_cache;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    int m_count = 0;
+};
+
+} // namespace
+
+TEST(StringResolver, ExpandEnvironmentText) {
+    MemoryStringSource source;
+    source.SetEnvironment(L"SystemRoot", L"C:\\Windows");
+    source.SetEnvironment(L"A", L"1");
+    source.SetEnvironment(L"B", L"2");
+
+    CHECK(ExpandEnvironmentText(L"%SystemRoot%\\system32", source) == L"C:\\Windows\\system32");
+    CHECK(ExpandEnvironmentText(L"%systemroot%\\x", source) == L"C:\\Windows\\x");
+    CHECK(ExpandEnvironmentText(L"%A%%B%", source) == L"12");
+    CHECK(ExpandEnvironmentText(L"no references", source) == L"no references");
+    CHECK(ExpandEnvironmentText(L"", source).empty());
+
+    // Unknown, empty and unterminated references stay as written
+    CHECK(ExpandEnvironmentText(L"%Unknown%\\x", source) == L"%Unknown%\\x");
+    CHECK(ExpandEnvironmentText(L"%Unknown%%A%", source) == L"%Unknown%1");
+    CHECK(ExpandEnvironmentText(L"%%A%", source) == L"%1");
+    CHECK(ExpandEnvironmentText(L"%A", source) == L"%A");
+    CHECK(ExpandEnvironmentText(L"100%", source) == L"100%");
+
+    // A stray '%' does not swallow the reference after it
+    CHECK(ExpandEnvironmentText(L"50% of %A%", source) == L"50% of 1");
+}
+
+TEST(StringResolver, ParseIndirectString) {
+    std::wstring module;
+    uint32_t id = 0;
+    REQUIRE(ParseIndirectString(L"@%SystemRoot%\\system32\\shell32.dll,-21787", module, id));
+    CHECK(module == L"%SystemRoot%\\system32\\shell32.dll");
+    CHECK(id == 21787);
+    REQUIRE(ParseIndirectString(L"@C:\\a,-b\\x.dll,-7;v1,-2", module, id));
+    CHECK(module == L"C:\\a,-b\\x.dll");
+    CHECK(id == 7);
+    REQUIRE(ParseIndirectString(L"@x.dll,-4294967295", module, id));
+    CHECK(id == 4294967295u);
+
+    for (const wchar_t* text : { L"x.dll,-1", L"@x.dll", L"@,-5", L"@x.dll,-", L"@x.dll,-12a", L"@x.dll,-4294967296",
+                                 L"@x.dll,5", L"@", L"" }) {
+        CHECK(!ParseIndirectString(text, module, id));
+    }
+
+    CHECK(ResolutionFor(VALUE_EXPAND_SZ, L"%A%") == StringResolution::Expand);
+    CHECK(ResolutionFor(VALUE_SZ, L"%A%") == StringResolution::None);
+    CHECK(ResolutionFor(VALUE_SZ, L"@x.dll,-1") == StringResolution::Indirect);
+    CHECK(ResolutionFor(VALUE_EXPAND_SZ, L"@x.dll,-1") == StringResolution::Indirect);
+    CHECK(ResolutionFor(VALUE_BINARY, L"@x.dll,-1") == StringResolution::None);
+    CHECK(ResolutionFor(VALUE_SZ, L"@") == StringResolution::None);
+}
+
+TEST(StringResolver, CacheHitsAndMisses) {
+    MemoryStringSource source;
+    source.SetEnvironment(L"SystemRoot", L"C:\\Windows");
+    source.AddModuleString(L"C:\\Windows\\system32\\shell32.dll", 21787, L"Desktop");
+    StringResolveCache cache(source);
+
+    const std::wstring indirect = L"@%SystemRoot%\\system32\\shell32.dll,-21787";
+    std::wstring resolved;
+    CHECK(!cache.Lookup(VALUE_SZ, indirect, resolved));
+    CHECK(cache.Resolve(VALUE_SZ, indirect) == L"Desktop");
+    REQUIRE(cache.Lookup(VALUE_SZ, indirect, resolved));
+    CHECK(resolved == L"Desktop");
+    CHECK(cache.Resolve(VALUE_SZ, indirect) == L"Desktop");
+
+    // Expansion and indirection are cached apart even for the same text
+    CHECK(cache.Resolve(VALUE_EXPAND_SZ, L"%SystemRoot%") == L"C:\\Windows");
+    CHECK(!cache.Lookup(VALUE_SZ, L"%SystemRoot%", resolved));
+
+    // A string that cannot be resolved shows as written and is cached too
+    CHECK(cache.Resolve(VALUE_SZ, L"@missing.dll,-1") == L"@missing.dll,-1");
+    REQUIRE(cache.Lookup(VALUE_SZ, L"@missing.dll,-1", resolved));
+    CHECK(resolved == L"@missing.dll,-1");
+
+    StringCacheStats stats = cache.GetStats();
+    CHECK(stats.misses == 4);
+    CHECK(stats.hits == 3);
+    CHECK(stats.resolved == 3);
+    CHECK(stats.failed == 1);
+    CHECK(stats.batches == 0);
+}
+
+TEST(StringResolver, InvalidateEnvironmentMakesExpansionsStale) {
+    GatedSource source;
+    source.base.SetEnvironment(L"AppData", L"C:\\Old");
+    StringResolveCache cache(source);
+    const std::wstring text = L"%AppData%\\App";
+
+    CHECK(cache.Resolve(VALUE_EXPAND_SZ, text) == L"C:\\Old\\App");
+    source.base.SetEnvironment(L"AppData", L"C:\\New");
+    std::wstring resolved;
+    REQUIRE(cache.Lookup(VALUE_EXPAND_SZ, text, resolved));
+    CHECK(resolved == L"C:\\Old\\App");                // Until told otherwise
+
+    uint64_t generation = cache.Generation();
+    cache.InvalidateEnvironment();
+    CHECK(cache.Generation() == generation + 1);
+    CHECK(!cache.Lookup(VALUE_EXPAND_SZ, text, resolved));
+    CHECK(cache.Resolve(VALUE_EXPAND_SZ, text) == L"C:\\New\\App");
+
+    // A background result computed before a change is not kept
+    ReadyCounter ready(cache);
+    source.Close();
+    StringRequest request{ VALUE_EXPAND_SZ, L"%AppData%\\Other" };
+    cache.Request({ &request, 1 });
+    REQUIRE(source.WaitForWaiter());
+    cache.InvalidateEnvironment();
+    source.base.SetEnvironment(L"AppData", L"C:\\Newer");
+    source.Open();
+    REQUIRE(ready.WaitFor(1));
+    CHECK(!cache.Lookup(VALUE_EXPAND_SZ, request.text, resolved));
+
+    cache.Request({ &request, 1 });
+    REQUIRE(ready.WaitFor(2));
+    REQUIRE(cache.Lookup(VALUE_EXPAND_SZ, request.text, resolved));
+    CHECK(resolved == L"C:\\Newer\\Other");
+}
+
+TEST(StringResolver, RequestsAreBatchedInTheBackground) {
+    GatedSource source;
+    source.base.SetEnvironment(L"A", L"1");
+    source.base.SetEnvironment(L"B", L"2");
+    source.base.AddModuleString(L"res.dll", 5, L"Five");
+    StringResolveCache cache(source);
+    ReadyCounter ready(cache);
+
+    // Hold the first batch while more requests arrive
+    source.Close();
+    StringRequest first{ VALUE_EXPAND_SZ, L"%A%" };
+    cache.Request({ &first, 1 });
+    REQUIRE(source.WaitForWaiter());
+
+    std::vector<StringRequest> rows = {
+        { VALUE_EXPAND_SZ, L"%B%" },
+        { VALUE_SZ, L"@res.dll,-5" },
+        { VALUE_EXPAND_SZ, L"%B%" },        // Queued once
+        { VALUE_EXPAND_SZ, L"%A%" },        // Already being resolved
+        { VALUE_SZ, L"plain" },             // Needs no resolution
+        { VALUE_DWORD, L"@res.dll,-5" },
+    };
+    cache.Request(rows);
+    source.Open();
+    REQUIRE(ready.WaitFor(2));
+
+    StringCacheStats stats = cache.GetStats();
+    CHECK(stats.batches == 2);
+    CHECK(stats.resolved == 3);
+    CHECK(stats.failed == 0);
+    std::wstring resolved;
+    REQUIRE(cache.Lookup(VALUE_EXPAND_SZ, L"%A%", resolved));
+    CHECK(resolved == L"1");
+    REQUIRE(cache.Lookup(VALUE_EXPAND_SZ, L"%B%", resolved));
+    CHECK(resolved == L"2");
+    REQUIRE(cache.Lookup(VALUE_SZ, L"@res.dll,-5", resolved));
+    CHECK(resolved == L"Five");
+    CHECK(!source.CalledOn(std::this_thread::get_id()));
+
+    // Everything cached: nothing is queued and no batch runs
+    cache.Request(rows);
+    std::this_thread::sleep_for(50ms);
+    CHECK(cache.GetStats().batches == 2);
+}
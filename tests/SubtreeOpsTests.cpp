@@ -0,0 +1,124 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for subtree copy and delete on the in-memory backend.
+ */
+
+#include "Fixtures.h"
+#include "Test.h"
+
+#include "MemoryBackend.h"
+#include "SubtreeOps.h"
+
+#include <atomic>
+
+using namespace core;
+
+TEST(SubtreeOps, CopyMatchesSource) {
+    MemoryBackend source;
+    KeyPtr sourceRoot = source.OpenRoot();
+    uint64_t keys = test::FillTree(*sourceRoot, 6, 3, 4);
+    std::wstring expected = test::DumpTree(*sourceRoot);
+
+    for (unsigned threads : { 1u, 4u }) {
+        MemoryBackend destination;
+        KeyPtr destinationRoot = destination.OpenRoot();
+        std::atomic<uint64_t> reported{0};
+        SubtreeOptions options;
+        options.threadCount = threads;
+        options.progressInterval = 16;
+        options.onProgress = [&](uint64_t copied, uint64_t) { reported = copied; };
+
+        SubtreeStats stats = CopySubtree(*sourceRoot, *destinationRoot, options);
+        CHECK(stats.keys == keys + 1);
+        CHECK(stats.values == (keys + 1) * 4);
+        CHECK(stats.errors == 0);
+        CHECK(!stats.cancelled);
+        CHECK(reported == stats.keys);
+        CHECK(test::DumpTree(*destinationRoot) == expected);
+    }
+}
+
+TEST(SubtreeOps, DeleteRemovesSubtree) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr doomed = root->CreateSubKey(L"Doomed");
+    KeyPtr kept = root->CreateSubKey(L"Kept");
+    REQUIRE(doomed && kept);
+    uint64_t keys = test::FillTree(*doomed, 5, 4, 1);
+    test::FillTree(*kept, 2, 2, 1);
+
+    SubtreeOptions options;
+    options.threadCount = 4;
+    SubtreeStats stats = DeleteSubtree(*root, L"Doomed", options);
+    CHECK(stats.keys == keys + 1);
+    CHECK(stats.errors == 0);
+    CHECK(!root->OpenSubKey(L"Doomed"));
+    CHECK(root->OpenSubKey(L"Kept\\Key1\\Key1"));
+}
+
+TEST(SubtreeOps, CancelledDeleteKeepsKey) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr doomed = root->CreateSubKey(L"Doomed");
+    REQUIRE(doomed);
+    test::FillTree(*doomed, 4, 3, 0);
+
+    std::stop_source stop;
+    stop.request_stop();
+    SubtreeOptions options;
+    options.stopToken = stop.get_token();
+    SubtreeStats stats = DeleteSubtree(*root, L"Doomed", options);
+    CHECK(stats.cancelled);
+    CHECK(root->OpenSubKey(L"Doomed"));
+
+    SubtreeStats missing = DeleteSubtree(*root, L"Missing");
+    CHECK(missing.errors == 1);
+    CHECK(missing.keys == 0);
+}
+
+TEST(SubtreeOps, CopyIntoOwnSubtreeIsRejected) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr source = root->CreateSubKey(L"Source");
+    REQUIRE(source);
+    test::FillTree(*source, 3, 2, 1);
+    std::wstring before = test::DumpTree(*root);
+
+    CHECK(IsSameOrBelow(L"Source", L"source\\Key1"));
+    CHECK(IsSameOrBelow(L"\\Source\\", L"Source"));
+    CHECK(!IsSameOrBelow(L"Source", L"SourceCopy"));
+    CHECK(!IsSameOrBelow(L"Source\\Key1", L"Source"));
+
+    for (const wchar_t* destination : { L"Source", L"SOURCE\\Key1\\New", L"" }) {
+        SubtreeStats stats = CopySubtree(backend, destination[0] ? L"Source" : L"", destination);
+        CHECK(stats.rejected);
+        CHECK(stats.keys == 0);
+    }
+    CHECK(test::DumpTree(*root) == before);
+
+    SubtreeStats stats = CopySubtree(backend, L"Source", L"Copies\\One");
+    CHECK(!stats.rejected);
+    CHECK(stats.errors == 0);
+    KeyPtr copy = root->OpenSubKey(L"Copies\\One");
+    REQUIRE(copy);
+    CHECK(test::DumpTree(*copy) == test::DumpTree(*source));
+    CHECK(CopySubtree(backend, L"Missing", L"Elsewhere").errors == 1);
+}
+
+// Without paths the copy cannot see the overlap, but the depth limit ends it
+TEST(SubtreeOps, KeyCopyIntoOwnSubtreeEnds) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr source = root->CreateSubKey(L"Source");
+    REQUIRE(source);
+    KeyPtr child = source->CreateSubKey(L"A");
+    REQUIRE(child);
+
+    SubtreeOptions options;
+    options.threadCount = 1;
+    SubtreeStats stats = CopySubtree(*source, *child, options);
+    CHECK(stats.errors > 0);
+    CHECK(stats.keys <= MAX_KEY_DEPTH + 1);
+}
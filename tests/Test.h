@@ -0,0 +1,49 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Minimal test harness for the core library. TEST(Suite, Name) defines a
+ * case; CHECK records a failure and carries on, REQUIRE also ends the case.
+ * The runner takes suite names on the command line (all suites if none).
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+namespace test {
+
+using CaseFunction = void (*)();
+
+struct Registrar {
+    Registrar(const char* suite, const char* name, CaseFunction function);
+};
+
+// Thrown by REQUIRE to end the current case
+struct Abort {};
+
+void Fail(const char* file, int line, const char* expression);
+
+// Empty scratch directory for the current case, removed when it ends
+std::filesystem::path TempDirectory();
+
+} // namespace test
+
+#define TEST(suite, name)                                                        \
+    static void suite##_##name();                                                \
+    static const test::Registrar suite##_##name##_registrar(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(expression)                                                        \
+    do {                                                                         \
+        if (!(expression)) test::Fail(__FILE__, __LINE__, #expression);          \
+    } while (0)
+
+#define REQUIRE(expression)                                                      \
+    do {                                                                         \
+        if (!(expression)) {                                                     \
+            test::Fail(__FILE__, __LINE__, #expression);                         \
+            throw test::Abort{};                                                 \
+        }                                                                        \
+    } while (0)
@@ -0,0 +1,86 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Test runner: runs the registered cases of the named suites.
+ */
+
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace test {
+
+namespace {
+
+struct Case {
+    const char* suite;
+    const char* name;
+    CaseFunction function;
+};
+
+std::vector<Case>& Cases() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+int g_failures = 0;                     // In the current case
+std::filesystem::path g_tempDirectory;
+
+} // namespace
+
+Registrar::Registrar(const char* suite, const char* name, CaseFunction function) {
+    Cases().push_back({ suite, name, function });
+}
+
+void Fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    g_failures++;
+}
+
+std::filesystem::path TempDirectory() {
+    if (g_tempDirectory.empty()) {
+        g_tempDirectory = std::filesystem::temp_directory_path() /
+                          ("RegStudioTests-" + std::to_string(std::random_device{}()));
+        std::filesystem::create_directories(g_tempDirectory);
+    }
+    return g_tempDirectory;
+}
+
+} // namespace test
+
+int main(int argc, char** argv) {
+    int failed = 0;
+    int run = 0;
+    for (const test::Case& testCase : test::Cases()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; i++) selected = std::strcmp(argv[i], testCase.suite) == 0;
+        if (!selected) continue;
+
+        test::g_failures = 0;
+        try {
+            testCase.function();
+        } catch (const test::Abort&) {
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "unexpected exception: %s\n", e.what());
+            test::g_failures++;
+        }
+        if (!test::g_tempDirectory.empty()) {
+            std::error_code ec;
+            std::filesystem::remove_all(test::g_tempDirectory, ec);
+            test::g_tempDirectory.clear();
+        }
+
+        run++;
+        if (test::g_failures) failed++;
+        std::printf("%s %s.%s\n", test::g_failures ? "FAIL" : "ok  ", testCase.suite, testCase.name);
+    }
+    std::printf("%d of %d cases passed\n", run - failed, run);
+    return (failed || run == 0) ? 1 : 0;
+}
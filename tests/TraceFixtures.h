@@ -0,0 +1,89 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Process Monitor exports for the tests and benchmarks: the same events
+ * written as a CSV or an XML export, laid out the way Process Monitor
+ * saves them.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace test {
+
+struct TraceEvent {
+    std::string process;
+    uint32_t pid = 0;
+    std::string operation;
+    std::string path;
+    std::string result = "SUCCESS";
+    std::string detail;
+};
+
+inline void AppendCsvField(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+inline std::string CsvTrace(const std::vector<TraceEvent>& events) {
+    std::string text = "\xEF\xBB\xBF\"Time of Day\",\"Process Name\",\"PID\",\"Operation\",\"Path\",\"Result\",\"Detail\"\r\n";
+    for (const TraceEvent& event : events) {
+        text += "\"10:15:42.1234567 AM\",";
+        AppendCsvField(text, event.process);
+        text += ",\"" + std::to_string(event.pid) + "\",";
+        AppendCsvField(text, event.operation);
+        text += ',';
+        AppendCsvField(text, event.path);
+        text += ',';
+        AppendCsvField(text, event.result);
+        text += ',';
+        AppendCsvField(text, event.detail);
+        text += "\r\n";
+    }
+    return text;
+}
+
+inline void AppendXmlText(std::string& out, const std::string& text) {
+    for (char c : text) {
+        if (c == '&') out += "&amp;";
+        else if (c == '<') out += "&lt;";
+        else if (c == '>') out += "&gt;";
+        else out += c;
+    }
+}
+
+inline std::string XmlTrace(const std::vector<TraceEvent>& events) {
+    std::string text = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n<procmon>\r\n<processlist>\r\n"
+                       "<process><ProcessIndex>1</ProcessIndex></process>\r\n</processlist>\r\n<eventlist>\r\n";
+    for (const TraceEvent& event : events) {
+        text += "<event>\r\n<ProcessIndex>1</ProcessIndex>\r\n<Time_of_Day>10:15:42.1234567 AM</Time_of_Day>\r\n"
+                "<Process_Name>";
+        AppendXmlText(text, event.process);
+        text += "</Process_Name>\r\n<PID>" + std::to_string(event.pid) + "</PID>\r\n<Operation>";
+        AppendXmlText(text, event.operation);
+        text += "</Operation>\r\n<Path>";
+        AppendXmlText(text, event.path);
+        text += "</Path>\r\n<Result>";
+        AppendXmlText(text, event.result);
+        text += "</Result>\r\n";
+        if (event.detail.empty()) {
+            text += "<Detail/>\r\n";
+        } else {
+            text += "<Detail>";
+            AppendXmlText(text, event.detail);
+            text += "</Detail>\r\n";
+        }
+        text += "</event>\r\n";
+    }
+    return text + "</eventlist>\r\n</procmon>\r\n";
+}
+
+} // namespace test
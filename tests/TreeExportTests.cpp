@@ -0,0 +1,112 @@
+/**
+ * RegStudio - Modern Windows Registry Editor
+ * Copyright (c) 2026 Rizonesoft
+ *
+ * Tests for XML and JSON tree export: the same tree gives the same bytes at
+ * any thread count, names and strings are escaped per format, and a
+ * cancelled export leaves no file behind.
+ */
+
+#include "Fixtures.h"
+#include "Test.h"
+
+#include "MemoryBackend.h"
+#include "TreeExport.h"
+
+#include <filesystem>
+#include <sstream>
+
+using namespace core;
+
+namespace {
+
+std::string Export(const RegistryKey& key, TreeExportFormat format, unsigned threads, TreeExportStats& stats) {
+    std::ostringstream output;
+    TreeExportOptions options;
+    options.format = format;
+    options.threadCount = threads;
+    std::wstring error;
+    if (!ExportTree(key, L"HKEY_LOCAL_MACHINE\\SOFTWARE", output, options, stats, error)) return "failed";
+    return output.str();
+}
+
+bool Contains(const std::string& text, const char* part) {
+    return text.find(part) != std::string::npos;
+}
+
+} // namespace
+
+TEST(TreeExport, SameBytesForAnyThreadCount) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    uint64_t keys = test::FillTree(*root, 6, 4, 5) + 1;
+    KeyPtr odd = root->CreateSubKey(L"Key3\\Odd <&> \"names\"");
+    REQUIRE(odd);
+    odd->SetValue({ L"text", VALUE_SZ, EncodeString(L"tab\tquote\"back\\slash\x01") });
+    odd->SetValue({ L"odd", VALUE_SZ, { 0x41, 0x00, 0x42 } });
+    odd->SetValue({ L"pair", VALUE_SZ, EncodeString(L"\xD83D\xDE00 and a lone \xD800") });
+    keys++;
+
+    for (TreeExportFormat format : { TreeExportFormat::Xml, TreeExportFormat::Json }) {
+        TreeExportStats single;
+        std::string expected = Export(*root, format, 1, single);
+        REQUIRE(expected != "failed");
+        CHECK(single.keys == keys);
+        CHECK(single.bytes == expected.size());
+
+        for (unsigned threads : { 2u, 3u, 8u }) {
+            TreeExportStats stats;
+            std::string output = Export(*root, format, threads, stats);
+            CHECK(output == expected);
+            CHECK(stats.keys == single.keys);
+            CHECK(stats.values == single.values);
+        }
+    }
+}
+
+TEST(TreeExport, EscapesPerFormat) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    KeyPtr key = root->CreateSubKey(L"A<&>\"'");
+    REQUIRE(key);
+    key->SetValue({ L"s", VALUE_SZ, EncodeString(L"q\"\\<&>\x01\n") });
+    key->SetValue({ L"odd", VALUE_SZ, { 0x41, 0x00, 0x42 } });
+    key->SetValue({ L"d", VALUE_DWORD, { 1, 0, 0, 0 } });
+
+    TreeExportStats stats;
+    std::string xml = Export(*root, TreeExportFormat::Xml, 1, stats);
+    CHECK(Contains(xml, "<registry path=\"HKEY_LOCAL_MACHINE\\SOFTWARE\">"));
+    CHECK(Contains(xml, "<key name=\"A&lt;&amp;&gt;&quot;'\""));
+    // A control character cannot be carried by XML 1.0, so the string goes as hex
+    CHECK(Contains(xml, "<value name=\"s\" type=\"REG_SZ\" encoding=\"hex\">710022005c003c0026003e0001000a000000</value>"));
+    CHECK(Contains(xml, "<value name=\"odd\" type=\"REG_SZ\" encoding=\"hex\">410042</value>"));
+    CHECK(Contains(xml, "<value name=\"d\" type=\"REG_DWORD\">1</value>"));
+
+    std::string json = Export(*root, TreeExportFormat::Json, 1, stats);
+    CHECK(Contains(json, "{\"path\":\"HKEY_LOCAL_MACHINE\\\\SOFTWARE\""));
+    CHECK(Contains(json, "{\"name\":\"A<&>\\\"'\""));
+    CHECK(Contains(json, "{\"name\":\"s\",\"type\":\"REG_SZ\",\"data\":\"q\\\"\\\\<&>\\u0001\\n\"}"));
+    CHECK(Contains(json, "{\"name\":\"odd\",\"type\":\"REG_SZ\",\"hex\":\"410042\"}"));
+    CHECK(Contains(json, "{\"name\":\"d\",\"type\":\"REG_DWORD\",\"data\":1}"));
+}
+
+TEST(TreeExport, CancelledExportRemovesFile) {
+    MemoryBackend backend;
+    KeyPtr root = backend.OpenRoot();
+    test::FillTree(*root, 4, 3, 2);
+
+    std::stop_source stop;
+    stop.request_stop();
+    TreeExportOptions options;
+    options.stopToken = stop.get_token();
+    TreeExportStats stats;
+    std::wstring error;
+    std::filesystem::path path = test::TempDirectory() / "tree.xml";
+    CHECK(!ExportTree(*root, L"HKEY_CURRENT_USER", path, options, stats, error));
+    CHECK(stats.cancelled);
+    CHECK(!std::filesystem::exists(path));
+
+    options.stopToken = {};
+    CHECK(ExportTree(*root, L"HKEY_CURRENT_USER", path, options, stats, error));
+    CHECK(std::filesystem::file_size(path) == stats.bytes);
+}